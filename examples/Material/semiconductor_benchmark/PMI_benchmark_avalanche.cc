@@ -77,7 +77,7 @@ void PMI_Benchmark_ImpactIonization::set_mole(double mole_x, double mole_y)
  */
 double  PMI_Benchmark_ImpactIonization::ElecGenRate (const double Tl,const double Ep,const double Eg) const
 {
-  return agen->ElecGenRate(Tl*K, Ep*V/cm, Eg*eV)*cm;
+  return agen->ElecGenRate(PMI_Context(), Tl*K, Ep*V/cm, Eg*eV)*cm;
 }
 
 /**
@@ -85,7 +85,7 @@ double  PMI_Benchmark_ImpactIonization::ElecGenRate (const double Tl,const doubl
  */
 double PMI_Benchmark_ImpactIonization::HoleGenRate (const double Tl,const double Ep,const double Eg) const
 {
-  return agen->HoleGenRate(Tl*K, Ep*V/cm, Eg*eV)*cm;
+  return agen->HoleGenRate(PMI_Context(), Tl*K, Ep*V/cm, Eg*eV)*cm;
 }
 
 
@@ -73,38 +73,38 @@ void PMI_Benchmark_Band::set_mole(double mole_x, double mole_y)
  * @return band gap of semiconductor
  */
 double   PMI_Benchmark_Band::Eg(const double Tl)
-{ return band->Eg(Tl*K)/eV; }
+{ return band->Eg(PMI_Context(), Tl*K)/eV; }
 
 /**
  * @return band gap narrowing due to heavy doping
  */
 double PMI_Benchmark_Band::EgNarrow(const double p, const double n, const double Tl)
-{ return band->EgNarrow(p*pow(cm,-3), n*pow(cm,-3), Tl*K)/eV; }
+{ return band->EgNarrow(PMI_Context(), p*pow(cm,-3), n*pow(cm,-3), Tl*K)/eV; }
 
 /**
  * @return effective density of states in the conduction band
  */
 double PMI_Benchmark_Band::Nc(const double Tl)
-{ return band->Nc(Tl*K)/pow(cm,-3); }
+{ return band->Nc(PMI_Context(), Tl*K)/pow(cm,-3); }
 
 /**
  * @return effective density of states in the valence band
  */
 double PMI_Benchmark_Band::Nv(const double Tl)
-{ return band->Nv(Tl*K)/pow(cm,-3); }
+{ return band->Nv(PMI_Context(), Tl*K)/pow(cm,-3); }
 
 
 /**
  * @return intrinsic carrier concentration
  */
 double PMI_Benchmark_Band::ni(const double Tl)
-{ return band->ni(Tl*K)/pow(cm,-3); }
+{ return band->ni(PMI_Context(), Tl*K)/pow(cm,-3); }
 
 /**
  * @return effective intrinsic carrier concentration
  */
 double PMI_Benchmark_Band::nie(const double p, const double n, const double Tl)
-{ return band->nie(p*pow(cm,-3), n*pow(cm,-3), Tl*K)/pow(cm,-3); }
+{ return band->nie(PMI_Context(), p*pow(cm,-3), n*pow(cm,-3), Tl*K)/pow(cm,-3); }
 
 
 /**
@@ -112,7 +112,7 @@ double PMI_Benchmark_Band::nie(const double p, const double n, const double Tl)
  */
 double PMI_Benchmark_Band::CDIR           (const double Tl)
 {
-  return band->CDIR(Tl*K)/(pow(cm,3)/s);
+  return band->CDIR(PMI_Context(), Tl*K)/(pow(cm,3)/s);
 }
 
 
@@ -120,13 +120,13 @@ double PMI_Benchmark_Band::CDIR           (const double Tl)
  * @return electron lift time in SHR Recombination
  */
 double PMI_Benchmark_Band::TAUN(const double Tl)
-{ return band->TAUN(Tl*K)/s; }
+{ return band->TAUN(PMI_Context(), Tl*K)/s; }
 
 /**
  * @return hole lift time in SHR Recombination
  */
 double PMI_Benchmark_Band::TAUP(const double Tl)
-{ return band->TAUP(Tl*K)/s; }
+{ return band->TAUP(PMI_Context(), Tl*K)/s; }
 
 
 /**
@@ -134,7 +134,7 @@ double PMI_Benchmark_Band::TAUP(const double Tl)
  */
 double PMI_Benchmark_Band::AUGERN(const double p, const double n, const double Tl)
 {
-  return band->AUGERN(p*pow(cm,-3), n*pow(cm,-3), Tl*K)/(pow(cm,6)/s);
+  return band->AUGERN(PMI_Context(), p*pow(cm,-3), n*pow(cm,-3), Tl*K)/(pow(cm,6)/s);
 }
 
 /**
@@ -142,6 +142,6 @@ double PMI_Benchmark_Band::AUGERN(const double p, const double n, const double T
  */
 double PMI_Benchmark_Band::AUGERP(const double p, const double n, const double Tl)
 {
-  return band->AUGERP(p*pow(cm,-3), n*pow(cm,-3), Tl*K)/(pow(cm,6)/s);
+  return band->AUGERP(PMI_Context(), p*pow(cm,-3), n*pow(cm,-3), Tl*K)/(pow(cm,6)/s);
 }
 
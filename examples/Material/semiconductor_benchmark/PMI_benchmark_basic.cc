@@ -77,26 +77,26 @@ void PMI_Benchmark_Basic::set_mole(double mole_x, double mole_y)
  * @return the mass density [g cm^-3] of material
  */
 double PMI_Benchmark_Basic::Density       (const double Tl) const
-{ return basic->Density(Tl*K)/(g/(cm*cm*cm)); }
+{ return basic->Density(PMI_Context(), Tl*K)/(g/(cm*cm*cm)); }
 
 
 /**
  * @return the \p relative \p permittivity of material
  */
 double PMI_Benchmark_Basic::Permittivity  () const
-{ return basic->Permittivity(); }
+{ return basic->Permittivity(PMI_Context()); }
 
 /**
  * @return the \p relative \p permeability of material
  */
 double PMI_Benchmark_Basic::Permeability  () const
-{ return basic->Permeability(); }
+{ return basic->Permeability(PMI_Context()); }
 
 /**
  * @return the affinity energy [eV] of material
  */
 double PMI_Benchmark_Basic::Affinity      (const double Tl) const
-{ return basic->Affinity(Tl*K)/eV; }
+{ return basic->Affinity(PMI_Context(), Tl*K)/eV; }
 
 
 
@@ -78,13 +78,13 @@ void PMI_Benchmark_Mob::set_dmin(double d)
 
 double PMI_Benchmark_Mob::mob_electron(double p, double n, double Ep, double Et, double T)
 {
-  return mob->ElecMob(p*pow(cm,-3), n*pow(cm,-3), T*K, Ep*(V/cm), Et*(V/cm), T*K)/(cm*cm/V/s);
+  return mob->ElecMob(PMI_Context(), p*pow(cm,-3), n*pow(cm,-3), T*K, Ep*(V/cm), Et*(V/cm), T*K)/(cm*cm/V/s);
 }
 
 
 double PMI_Benchmark_Mob::mob_hole(double p, double n, double Ep, double Et, double T)
 {
-  return mob->HoleMob(p*pow(cm,-3), n*pow(cm,-3), T*K, Ep*(V/cm), Et*(V/cm), T*K)/(cm*cm/V/s);
+  return mob->HoleMob(PMI_Context(), p*pow(cm,-3), n*pow(cm,-3), T*K, Ep*(V/cm), Et*(V/cm), T*K)/(cm*cm/V/s);
 }
 
 
@@ -59,19 +59,19 @@ void PMI_Benchmark_Optical::set_mole(double mole_x, double mole_y)
 
 double PMI_Benchmark_Optical::n(double lambda, double T)
 {
-  return optical->RefractionIndex(lambda*um, T*K).real();
+  return optical->RefractionIndex(PMI_Context(), lambda*um, T*K).real();
 }
 
 
 double PMI_Benchmark_Optical::k(double lambda, double T)
 {
-  return optical->RefractionIndex(lambda*um, T*K).imag();
+  return optical->RefractionIndex(PMI_Context(), lambda*um, T*K).imag();
 }
 
 
 double PMI_Benchmark_Optical::alpha(double lambda, double T)
 {
-  double k= optical->RefractionIndex(lambda*um, T*K).imag();
+  double k= optical->RefractionIndex(PMI_Context(), lambda*um, T*K).imag();
   double alpha = 12.5663706144*k/(lambda*um)*cm;
   return alpha;
 }
@@ -77,7 +77,7 @@ void PMI_Benchmark_Thermal::set_mole(double mole_x, double mole_y)
  */
 double PMI_Benchmark_Thermal::HeatCapacity  (const double Tl) const
 {
-  return thermal->HeatCapacity(Tl*K)/(J/g/K);
+  return thermal->HeatCapacity(PMI_Context(), Tl*K)/(J/g/K);
 }
 
 /**
@@ -85,7 +85,7 @@ double PMI_Benchmark_Thermal::HeatCapacity  (const double Tl) const
  */
 double PMI_Benchmark_Thermal::HeatConduction(const double Tl) const
 {
-  return thermal->HeatConduction(Tl*K)/(J/s/cm/K);
+  return thermal->HeatConduction(PMI_Context(), Tl*K)/(J/s/cm/K);
 }
 
 
@@ -17,6 +17,7 @@ private:
   std::map<std::string, std::ostream*> _streams;  // output streams.
   std::map<std::string, std::filebuf*> _bufs;  // file buffers opened in genius.
   std::ostringstream _sstream;
+  std::string * _capture;  // messages go here instead of the streams when not NULL
 
 public:
   /**
@@ -55,6 +56,12 @@ public:
    * flush the buffer
    */
   void record();
+
+  /**
+   * append the following messages to \p buf instead of writing them to the streams,
+   * NULL to restore the streams
+   */
+  void capture(std::string * buf) { _capture = buf; }
 };
 
 extern GENIUS_LOG_STREAM genius_log;
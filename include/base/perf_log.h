@@ -36,6 +36,7 @@
 #include <string>
 #include <stack>
 #include <map>
+#include <vector>
 
 #ifdef WINDOWS
   #include <time.h>
@@ -74,7 +75,8 @@ class PerfData
     tot_time(0.),
     count(0),
     open(false),
-    called_recursively(0)
+    called_recursively(0),
+    trace_id(-1)
     {}
 
 
@@ -113,6 +115,39 @@ class PerfData
 
   int called_recursively;
 
+  /**
+   * index of this event in the name table of trace buffer,
+   * -1 before the event is traced
+   */
+  int trace_id;
+
+};
+
+
+
+/**
+ * The \p TraceEvent is the fixed size record of the trace buffer.
+ * A span event ('X') records the begin time and duration of a
+ * START_LOG/STOP_LOG pair, a counter event ('C') records a value.
+ */
+struct TraceEvent
+{
+  /// begin time in us since the log was cleared
+  double ts;
+
+  /// duration in us for span event, the value for counter event
+  double value;
+
+  /// index of (header, label) in the name table
+  unsigned int name;
+
+  /// nesting level of span event
+  unsigned short depth;
+
+  /// 'X' for span event and 'C' for counter event
+  char phase;
+
+  char reserved;
 };
 
 
@@ -168,6 +203,37 @@ class PerfLog
    */
   void enable_logging() { log_events = true; }
 
+  /**
+   * Enables the trace of nested events. Each finished event is recorded
+   * with its begin time and duration into a ring buffer of \p capacity
+   * records, the oldest ones are overwritten when the buffer is full.
+   */
+  void enable_trace(unsigned int capacity);
+
+  /**
+   * @returns true if events are traced
+   */
+  bool tracing() const { return log_events && trace_events; }
+
+  /**
+   * Record the \p value of counter \p label at current time to the trace buffer.
+   */
+  void trace_counter(const std::string &label,
+                     double value,
+                     const std::string &header="");
+
+  /**
+   * Write the trace buffer as Chrome trace event JSON, which can be
+   * loaded by chrome://tracing or Perfetto UI.
+   */
+  void write_trace_json(const std::string &filename) const;
+
+  /**
+   * Write the trace buffer in binary format: the magic "GTRC",
+   * the name table and the TraceEvent records in time order.
+   */
+  void write_trace_binary(const std::string &filename) const;
+
 
   /**
    * Push the event \p label onto the stack, pausing any active event.
@@ -273,6 +339,54 @@ class PerfLog
    */
   std::stack<PerfData*> log_stack;
 
+  /**
+   * Flag to trace the nested events.
+   */
+  bool trace_events;
+
+  /**
+   * The ring buffer of traced events.
+   */
+  std::vector<TraceEvent> trace_buffer;
+
+  /**
+   * Total number of events recorded, the latest one is
+   * trace_buffer[(trace_total-1)%trace_buffer.size()]
+   */
+  unsigned long trace_total;
+
+  /**
+   * The (header, label) of traced events.
+   */
+  std::vector<std::pair<std::string, std::string> > trace_names;
+
+  /**
+   * Index of counter events in trace_names.
+   */
+  std::map<std::pair<std::string, std::string>, unsigned int> trace_counter_ids;
+
+  /**
+   * The begin time of events in log_stack.
+   */
+  std::vector<double> trace_stack;
+
+  /**
+   * @returns the time in us since the log was cleared
+   */
+  double _trace_time() const;
+
+  /**
+   * Record the event on top of log_stack to trace buffer.
+   */
+  void _trace_span(PerfData *perf_data,
+                   const std::string &label,
+                   const std::string &header);
+
+  /**
+   * Put an event into the ring buffer.
+   */
+  void _trace_record(const TraceEvent &event);
+
   /**
    * Flag indicating if print_log() has been called.
    * This is used to print a header with machine-specific
@@ -313,6 +427,9 @@ void PerfLog::push (const std::string &label,
 	total_time +=
 	  log_stack.top()->pause();
 
+      if (trace_events)
+        trace_stack.push_back(this->_trace_time());
+
       perf_data->start();
       log_stack.push(perf_data);
     }
@@ -335,6 +452,9 @@ void PerfLog::pop (const std::string &label,
 
       total_time += log_stack.top()->stopit();
 
+      if (trace_events)
+        this->_trace_span(log_stack.top(), label, header);
+
       log_stack.pop();
 
       if (!log_stack.empty())
@@ -35,6 +35,7 @@
 #include "elem.h"
 #include "fvm_node_info.h"
 #include "external_circuit.h"
+#include "checkpoint_file.h"
 #include "petscvec.h"
 #include "petscmat.h"
 #include "sparse_matrix.h"
@@ -540,6 +541,17 @@ public:
    */
   bool has_flag(const std::string & ) const;
 
+  /**
+   * write the state of this boundary, i.e. real parameters, current flow
+   * and external circuit, to checkpoint file
+   */
+  virtual void checkpoint(CheckpointWriter & out) const;
+
+  /**
+   * read the state of this boundary from checkpoint file
+   */
+  virtual void restart(CheckpointReader & in);
+
 
 private:
 
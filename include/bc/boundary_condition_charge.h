@@ -71,6 +71,18 @@ public:
   virtual PetscScalar & psi()
   {return _psi;}
 
+  /**
+   * write the state of this boundary to checkpoint file
+   */
+  virtual void checkpoint(CheckpointWriter & out) const
+  { BoundaryCondition::checkpoint(out); out.write_value(_psi); }
+
+  /**
+   * read the state of this boundary from checkpoint file
+   */
+  virtual void restart(CheckpointReader & in)
+  { BoundaryCondition::restart(in); _psi = in.read_value<PetscScalar>(); }
+
   /**
    * @return the current flow of this boundary.
    */
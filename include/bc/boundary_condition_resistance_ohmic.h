@@ -82,6 +82,18 @@ public:
   virtual PetscScalar & psi()
   {return _average_psi;}
 
+  /**
+   * write the state of this boundary to checkpoint file
+   */
+  virtual void checkpoint(CheckpointWriter & out) const
+  { BoundaryCondition::checkpoint(out); out.write_value(_average_psi); }
+
+  /**
+   * read the state of this boundary from checkpoint file
+   */
+  virtual void restart(CheckpointReader & in)
+  { BoundaryCondition::restart(in); _average_psi = in.read_value<PetscScalar>(); }
+
 
   /**
    * @return the current flow of this boundary.
@@ -0,0 +1,47 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+#ifndef __enum_mesh_reorder_h__
+#define __enum_mesh_reorder_h__
+
+// ------------------------------------------------------------
+// enum MeshReorderType definition
+namespace MeshEnums {
+
+  /**
+   * \enum MeshEnums::MeshReorderType defines an \p enum for the
+   * node/elem reordering methods of the mesh. the order of nodes
+   * determines the order of unknowns in the (serial) dof map
+   */
+  enum MeshReorderType {
+    Reorder_NONE = 0,
+    Reorder_RCM,                // Reverse Cuthill-McKee, small bandwidth
+    Reorder_HILBERT,            // Hilbert space filling curve
+    Reorder_MORTON,             // Morton (Z-order) space filling curve
+    Reorder_NESTED_DISSECTION,  // METIS nested dissection, small fill-in
+    INVALID_Reorder};
+}
+
+using namespace MeshEnums;
+
+#endif // #ifndef __enum_mesh_reorder_h__
@@ -75,6 +75,7 @@ namespace SolverSpecify
                          MUMPS,
                          SuperLU_DIST,
                          GSS,
+                         KLU,
                          INVALID_LINEAR_SOLVER};
 
  /**
@@ -27,18 +27,23 @@
 
 
 #include "hook.h"
+#include "record_stream.h"
 #include <time.h>
 
 /**
- * write electrode IV into spice raw file (Ascii format).
- * then user can view the IV curve by some other program.
- * ( can we do real time display here? )
+ * write gate capacitance of DC sweep into text file.
+ * the capacitance is the derivative of gate charge by 3 point difference,
+ * each row is written as soon as the next sweep point is solved, and the file is
+ * synced to disk periodically, so it can be tailed while the simulation is running.
+ *
+ * parameters:
+ *   sync   = <real>           max seconds between two disk syncs, default 10
  */
 class CVHook : public Hook
 {
 
 public:
-  CVHook(SolverBase & solver, const std::string & name, void * file);
+  CVHook(SolverBase & solver, const std::string & name, void * param);
 
   virtual ~CVHook();
 
@@ -74,11 +79,6 @@ private:
   */
  time_t          _time;
 
- /**
-  * the input file name
-  */
- std::string     _input_file;
-
  /**
   * the raw file name
   */
@@ -87,7 +87,7 @@ private:
  /**
   * file stream
   */
- std::ofstream   _out;
+ RecordStream    _out;
 
  /**
   * the variable name buffer
@@ -96,7 +96,7 @@ private:
  std::vector<std::string>  _gate_electrodes;
 
  /**
-  * the variable value buffer
+  * the variable value of the last (at most 3) sweep points
   */
  std::vector<double> _vsweep;
  std::vector< std::vector<double> > _gate_charge;
@@ -106,6 +106,12 @@ private:
   */
  unsigned int _n_values;
 
+ /**
+  * write capacitance row of point \p i in the window, by the derivative of gate charge
+  * between point \p l and \p r
+  */
+ void _write_row(unsigned int i, unsigned int l, unsigned int r);
+
 };
 
 #endif
@@ -91,6 +91,17 @@ public:
    */
   virtual void on_close() {}
 
+  /**
+   * @return the state of this hook saved to checkpoint file, i.e. the position of output file
+   */
+  virtual std::string checkpoint() { return std::string(); }
+
+  /**
+   * resume this hook by the \p state saved in checkpoint file.
+   * it is called after on_init() when transient simulation restarts.
+   */
+  virtual void restart(const std::string & /*state*/) {}
+
   /**
    * @return the name of the hook
    */
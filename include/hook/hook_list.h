@@ -26,8 +26,10 @@
 #define __hook_list_h__
 
 #include <map>
+#include <vector>
 
 #include "hook.h"
+#include "perf_log.h"
 
 
 /**
@@ -60,7 +62,11 @@ public:
   {
     std::deque<Hook *>::iterator it;
     for (it=_hook_list.begin(); it!=_hook_list.end(); ++it)
+    {
+      START_LOG((*it)->name(), "Hook::on_init");
       (*it)->on_init();
+      STOP_LOG((*it)->name(), "Hook::on_init");
+    }
   }
 
   /**
@@ -70,7 +76,11 @@ public:
   {
     std::deque<Hook *>::iterator it;
     for (it=_hook_list.begin(); it!=_hook_list.end(); ++it)
+    {
+      START_LOG((*it)->name(), "Hook::pre_solve");
       (*it)->pre_solve();
+      STOP_LOG((*it)->name(), "Hook::pre_solve");
+    }
   }
 
   /**
@@ -80,7 +90,11 @@ public:
   {
     std::deque<Hook *>::iterator it;
     for (it=_hook_list.begin(); it!=_hook_list.end(); ++it)
+    {
+      START_LOG((*it)->name(), "Hook::post_solve");
       (*it)->post_solve();
+      STOP_LOG((*it)->name(), "Hook::post_solve");
+    }
   }
 
 
@@ -92,7 +106,11 @@ public:
   {
     std::deque<Hook *>::iterator it;
     for (it=_hook_list.begin(); it!=_hook_list.end(); ++it)
+    {
+      START_LOG((*it)->name(), "Hook::pre_iteration");
       (*it)->pre_iteration();
+      STOP_LOG((*it)->name(), "Hook::pre_iteration");
+    }
   }
 
   /**
@@ -103,7 +121,11 @@ public:
   {
     std::deque<Hook *>::iterator it;
     for (it=_hook_list.begin(); it!=_hook_list.end(); ++it)
+    {
+      START_LOG((*it)->name(), "Hook::post_iteration");
       (*it)->post_iteration();
+      STOP_LOG((*it)->name(), "Hook::post_iteration");
+    }
   }
 
   /**
@@ -114,7 +136,36 @@ public:
   {
     std::deque<Hook *>::iterator it;
     for (it=_hook_list.begin(); it!=_hook_list.end(); ++it)
+    {
+      START_LOG((*it)->name(), "Hook::post_check");
       (*it)->post_check(f, x, y, w, change_y, change_w);
+      STOP_LOG((*it)->name(), "Hook::post_check");
+    }
+  }
+
+  /**
+   * collect the states of hooks for checkpoint file, stored as \< hook name, state \>
+   */
+  void checkpoint(std::vector< std::pair<std::string, std::string> > & states)
+  {
+    std::deque<Hook *>::iterator it;
+    for (it=_hook_list.begin(); it!=_hook_list.end(); ++it)
+      states.push_back( std::make_pair((*it)->name(), (*it)->checkpoint()) );
+  }
+
+  /**
+   * resume the hooks by states in checkpoint file, matched by hook name
+   */
+  void restart(const std::vector< std::pair<std::string, std::string> > & states)
+  {
+    std::deque<Hook *>::iterator it;
+    for (it=_hook_list.begin(); it!=_hook_list.end(); ++it)
+      for(unsigned int n=0; n<states.size(); ++n)
+        if( states[n].first == (*it)->name() )
+        {
+          (*it)->restart(states[n].second);
+          break;
+        }
   }
 
   /**
@@ -124,11 +175,21 @@ public:
   {
     std::deque<Hook *>::iterator it;
     for (it=_hook_list.begin(); it!=_hook_list.end(); ++it)
+    {
+      START_LOG((*it)->name(), "Hook::on_close");
       (*it)->on_close();
+      STOP_LOG((*it)->name(), "Hook::on_close");
+    }
 
     this->clear();
   }
 
+  /**
+   * exchange the hooks with \p other, i.e. to run solves without calling the hooks
+   */
+  void swap(HookList & other)
+  { _hook_list.swap(other._hook_list); }
+
   /**
    * clear all the hooks
    */
@@ -0,0 +1,90 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+
+#ifndef __matrix_profile_hook_h__
+#define __matrix_profile_hook_h__
+
+#include <string>
+
+#include "config.h"
+#include "hook.h"
+
+
+
+/**
+ * report the profile of jacobian matrix: bandwidth, envelope, nonzeros and the
+ * fill-in of ILU(k) factorization, as well as the time of jacobian assembly.
+ * it benchmarks the node ordering, see the REORDER parameter of GLOBAL command
+ */
+class MatrixProfileHook : public Hook
+{
+
+public:
+
+  MatrixProfileHook(SolverBase & solver, const std::string & name, void *);
+
+  virtual ~MatrixProfileHook();
+
+  /**
+   *   This is executed before the initialization of the solver
+   */
+  virtual void on_init();
+
+  /**
+   *   This is executed previously to each solution step.
+   */
+  virtual void pre_solve();
+
+  /**
+   *  This is executed after each solution step.
+   */
+  virtual void post_solve();
+
+  /**
+   *  This is executed before each (nonlinear) iteration
+   */
+  virtual void pre_iteration();
+
+  /**
+   *  This is executed after each (nonlinear) iteration
+   *  the profile of the first jacobian matrix is reported
+   */
+  virtual void post_iteration();
+
+  /**
+   * This is executed after the finalization of the solver
+   * the time of jacobian assembly is reported
+   */
+  virtual void on_close();
+
+private:
+
+  /**
+   * the matrix profile has been reported
+   */
+  bool _reported;
+
+};
+
+#endif
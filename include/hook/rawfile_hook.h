@@ -27,18 +27,27 @@
 
 
 #include "hook.h"
+#include "record_stream.h"
 #include <time.h>
 
 /**
- * write electrode IV into spice raw file (Ascii format).
- * then user can view the IV curve by some other program.
- * ( can we do real time display here? )
+ * write electrode IV into spice raw file (Ascii or Binary format).
+ * the file head is written at the beginning and each solution step is
+ * appended as one record, the number of points in file head is updated
+ * with the records. the file is synced to disk periodically, so it can be
+ * tailed and plotted while the simulation is running.
+ * a transient simulation restarted from checkpoint continues the raw file
+ * from the position saved by the checkpoint.
+ *
+ * parameters:
+ *   format = ascii | binary   binary format has fixed size records of native double
+ *   sync   = <real>           max seconds between two disk syncs, default 10
  */
 class RawFileHook : public Hook
 {
 
 public:
-  RawFileHook(SolverBase & solver, const std::string & name, void * rawfile);
+  RawFileHook(SolverBase & solver, const std::string & name, void * param);
 
   virtual ~RawFileHook();
 
@@ -67,17 +76,27 @@ public:
    */
   virtual void on_close();
 
+  /**
+   * @return the position of raw file for checkpoint
+   */
+  virtual std::string checkpoint();
+
+  /**
+   * resume the raw file at the position saved by checkpoint
+   */
+  virtual void restart(const std::string & state);
+
 private:
 
  /**
-  * current time
+  * open the raw file and write the head
   */
- time_t          _time;
+ void _write_head();
 
  /**
-  * the input file name
+  * current time
   */
- std::string     _input_file;
+ time_t          _time;
 
  /**
   * the raw file name
@@ -87,7 +106,22 @@ private:
  /**
   * file stream
   */
- std::ofstream   _out;
+ RecordStream    _out;
+
+ /**
+  * write values in binary format
+  */
+ bool            _binary;
+
+ /**
+  * max seconds between two disk syncs
+  */
+ double          _sync_interval;
+
+ /**
+  * file offset of "No. Points" field
+  */
+ long            _n_values_offset;
 
  /**
   * if we are in mixA mode
@@ -99,11 +133,6 @@ private:
   */
  std::vector<std::pair<std::string, std::string> >  _variables;
 
- /**
-  * the variable value buffer
-  */
- std::vector< std::vector<double> > _values;
-
  /**
   * the total number of values
   */
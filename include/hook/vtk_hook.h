@@ -29,8 +29,10 @@
 #include <vector>
 #include <string>
 
+class XDMFTimeSeries;
+
 /**
- * write vtk file
+ * write vtk file, or a time series of HDF5 + XDMF format when format=xdmf
  */
 class VTKHook : public Hook
 {
@@ -65,6 +67,16 @@ public:
    */
   virtual void on_close();
 
+  /**
+   * @return the file counter and last saved time for checkpoint
+   */
+  virtual std::string checkpoint();
+
+  /**
+   * resume the file counter and time sequence saved by checkpoint
+   */
+  virtual void restart(const std::string & state);
+
 private:
 
   /**
@@ -124,6 +136,16 @@ private:
    * if we are in ddmac mode
    */
   bool            _ddm_ac;
+
+  /**
+   * the time series writer, only for xdmf format
+   */
+  XDMFTimeSeries * _xdmf;
+
+  /**
+   * write solution as a vtu file, or a step of xdmf time series at \p value
+   */
+  void _export ( const std::string & vtk_filename, double value );
 };
 
 #endif
@@ -4,8 +4,10 @@
 #include <cassert>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "point.h"
+#include "node.h"
 
 /**
  * this class offers an unique interface to various interpolation method
@@ -51,6 +53,13 @@ public:
    */
   virtual void add_scatter_data(const Point & point, int group, double value)=0;
 
+  /**
+   * add the data of mesh node with GROUP_ID group. scattered data interpolators
+   * only use the location of node, mesh based ones also use the node id
+   */
+  virtual void add_node_data(const Node * node, int group, double value)
+  { this->add_scatter_data(*node, group, value); }
+
   /**
    * build internal data structure
    */
@@ -67,6 +76,16 @@ public:
    */
   virtual double get_interpolated_value(const Point & point, int group)const=0;
 
+  /**
+   * get interpolated values of a batch of points with GROUP_ID group
+   */
+  virtual void get_interpolated_values(const std::vector<Point> & points, int group, std::vector<double> & values) const
+  {
+    values.resize(points.size());
+    for(unsigned int n=0; n<points.size(); ++n)
+      values[n] = this->get_interpolated_value(points[n], group);
+  }
+
   /**
    * InterpolationType, should support linear (for potential, etc) and asinh (doping concentration and carrier density)
    */
@@ -0,0 +1,135 @@
+#ifndef __interpolation_mesh_h__
+#define __interpolation_mesh_h__
+
+#include <vector>
+#include <map>
+
+#include "interpolation_base.h"
+
+class MeshBase;
+class SerialMesh;
+class TreeBase;
+class Elem;
+
+
+/**
+ * transfer node data from an old (donor) mesh to new points by the shape functions
+ * of the donor element which contains the point.
+ *
+ * unlike the scattered data interpolators, the topology of the old mesh is kept,
+ * thus the field is reproduced exactly at the old nodes and sharp junctions are
+ * not smeared across element boundaries.
+ * a serial copy of the active elements of old mesh is held on every processor,
+ * points are located by an element tree. the batch version checks the last found
+ * element of each thread first, so a batch of nearby points is located cheaply.
+ * points not found by the tree (on the boundary with round off error, or out of
+ * the old mesh) are searched in the elements around the nearest donor node with
+ * a tolerance, and take the value of the nearest node at last.
+ *
+ * the node data should be given by add_node_data(), which records the node id.
+ */
+class InterpolationMesh : public InterpolationBase
+{
+public:
+
+  InterpolationMesh();
+
+  ~InterpolationMesh();
+
+  /**
+   * clear internal interpolation data
+   */
+  void clear();
+
+  /**
+   * keep a copy of active elements of \p mesh as donor mesh.
+   * should be called on all the processors before adding data
+   */
+  void set_mesh(const MeshBase & mesh);
+
+  /**
+   * build internal data structure
+   */
+  void setup(int group);
+
+  /**
+   * broadcast data to all the processor
+   */
+  virtual void broadcast(unsigned int root=0);
+
+  /**
+   * scattered data without node id is not supported
+   */
+  void add_scatter_data(const Point & point, int group, double value);
+
+  /**
+   * add the data of donor mesh node \p node with GROUP_ID group
+   */
+  virtual void add_node_data(const Node * node, int group, double value);
+
+  /**
+   * get interpolated value with GROUP_ID group in location point
+   */
+  double get_interpolated_value(const Point & point, int group) const;
+
+  /**
+   * get interpolated values of a batch of points, nearby points should be adjacent in \p points.
+   * the batch is split into Genius::n_threads() contiguous ranges evaluated in parallel
+   */
+  virtual void get_interpolated_values(const std::vector<Point> & points, int group, std::vector<double> & values) const;
+
+private:
+
+  friend class InterpolationMeshLoop;
+
+  /**
+   * serial copy of the active elements of old mesh, node id is kept
+   */
+  SerialMesh * _donor;
+
+  /**
+   * element tree of donor mesh, for locating points
+   */
+  TreeBase * _tree;
+
+  /**
+   * donor elements which have the node, indexed by node id
+   */
+  std::vector< std::vector<const Elem *> > _node_elems;
+
+  /**
+   * scaled node value of each group, indexed by node id
+   */
+  std::map<int, std::vector<double> > _field;
+
+  /**
+   * flag of node value exist, indexed by node id
+   */
+  std::map<int, std::vector<int> > _field_valid;
+
+  /**
+   * interpolate the scaled value in \p elem by shape functions, nodes without value are skipped
+   * @return false if no node of \p elem has value
+   */
+  bool _interpolate(const Elem * elem, const Point & point, int group, double & value) const;
+
+  /**
+   * the scaled value of nearest donor node which has value, used when point is out of donor mesh
+   */
+  double _nearest(const Point & point, int group) const;
+
+  /**
+   * find the donor element contains \p point, element \p hint is checked first.
+   * @return NULL if point is out of donor mesh
+   */
+  const Elem * _locate(const Point & point, const Elem * hint) const;
+
+  /**
+   * evaluate the points [begin, end) of a batch, the element found last time is used as hint
+   */
+  void _interpolate_range(const std::vector<Point> & points, int group, std::vector<double> & values,
+                          unsigned int begin, unsigned int end) const;
+};
+
+
+#endif
@@ -57,30 +57,43 @@ class FVM_NodeData;
 // re-implemented virtual functions.
 
 /**
- * PMI_Environment, this structure will be passed to PMI class when initializing.
- * It contains interface information for linking main genius code to each PMI class
+ * PMI_Context, the evaluation context of PMI, which holds the node
+ * (and its data) to be evaluated and the current time.
+ * the context is built by MaterialBase::mapping() and owned by the caller,
+ * which passes it to each PMIS evaluation. PMI itself keeps no node state,
+ * as a result, PMI can be evaluated by different threads at the same time.
+ * a default constructed context has no node, PMI falls back to the fake environment
  */
-struct PMI_Environment
+struct PMI_Context
 {
   /**
-   * the location of current Point, use "pointer to pointer" method
-   * here pp_point point to p_point in the material class which point to
-   * current Point as a buffer.
+   * current Point
    */
-  const Point         **    pp_point;
+  const Point         *  point;
 
   /**
-   * the location of current node_data, use "pointer to pointer" method
-   * here pp_node_data point to pnode_data in the material class which point to
-   * current FVM_NodeData as a buffer.
+   * data of current Point
    */
-  const FVM_NodeData **    pp_node_data;
+  const FVM_NodeData  *  node_data;
 
   /**
-   * the pointer to current time
+   * current time
    */
-  const PetscScalar  *     p_clock;
+  PetscScalar            clock;
 
+  PMI_Context() : point(0), node_data(0), clock(0.0) {}
+
+  PMI_Context(const Point *p, const FVM_NodeData *data, PetscScalar time)
+  : point(p), node_data(data), clock(time) {}
+};
+
+
+/**
+ * PMI_Environment, this structure will be passed to PMI class when initializing.
+ * It contains interface information for linking main genius code to each PMI class
+ */
+struct PMI_Environment
+{
   /**
    * const pointer to region variables
    */
@@ -114,17 +127,16 @@ struct PMI_Environment
   /**
    * constructor
    */
-  PMI_Environment(const Point** point, const FVM_NodeData **node_data, const PetscScalar *time,
-                  const std::map<std::string, SimulationVariable> ** variables,
+  PMI_Environment(const std::map<std::string, SimulationVariable> ** variables,
                   double _m_, double _s_, double _V_, double _C_, double _K_)
-  : pp_point(point), pp_node_data(node_data), p_clock(time), pp_variables(variables), m(_m_), s(_s_), V(_V_), C(_C_), K(_K_)
+  : pp_variables(variables), m(_m_), s(_s_), V(_V_), C(_C_), K(_K_)
   {}
 
   /**
    * constructor
    */
   PMI_Environment(double _m_, double _s_, double _V_, double _C_, double _K_)
-  : pp_point(0), pp_node_data(0), p_clock(0), pp_variables(0), m(_m_), s(_s_), V(_V_), C(_C_), K(_K_)
+  : pp_variables(0), m(_m_), s(_s_), V(_V_), C(_C_), K(_K_)
   {}
 
 };
@@ -283,25 +295,6 @@ protected:
    */
   const std::map<std::string, SimulationVariable>  ** pp_variables;
 
-  /**
-   * the location of current point, use "pointer to pointer" method
-   * here pp_point point to p_point in the material class which point to
-   * current Point as a buffer.
-   */
-  const Point            **pp_point;
-
-  /**
-   * the location of current node_data, use "pointer to pointer" method
-   * here pp_node_data point to pnode_data in the material class which point to
-   * current FVM_NodeData as a buffer.
-   */
-  const FVM_NodeData    **pp_node_data;
-
-  /**
-   * the pointer to current time
-   */
-  const PetscScalar     *p_clock;
-
 protected:
   /**
    * this map links variable \p name to its \p address
@@ -322,14 +315,14 @@ protected:
 
 public:
   /**
-   * aux function return node coordinate.
+   * aux function return coordinate of the node in \p ctx.
    */
-  void   ReadCoordinate (PetscScalar& x, PetscScalar& y, PetscScalar& z) const;
+  void   ReadCoordinate (const PMI_Context &ctx, PetscScalar& x, PetscScalar& y, PetscScalar& z) const;
 
   /**
-   * aux function return current time.
+   * aux function return time of \p ctx.
    */
-  PetscScalar ReadTime () const;
+  PetscScalar ReadTime (const PMI_Context &ctx) const;
 
   /**
    * check iff given variable eixst
@@ -344,23 +337,23 @@ public:
   /**
    * aux function return scalar value of given variable.
    */
-  PetscScalar ReadRealVariable (const unsigned int) const;
+  PetscScalar ReadRealVariable (const PMI_Context &ctx, const unsigned int) const;
 
   /**
    * aux function return scalar value of given variable.
    */
-  PetscScalar ReadRealVariable (const std::string &) const;
+  PetscScalar ReadRealVariable (const PMI_Context &ctx, const std::string &) const;
 
   /**
    * initialize node_data and node-specific PMI data
    */
-  virtual void init_node() {}
+  virtual void init_node(const PMI_Context &) {}
 
   /**
    * initialize node_data and node-specific PMI data for boundary node
    * @param bc_label  node with which label should be initialized
    */
-  virtual void init_bc_node(const std::string & ) {}
+  virtual void init_bc_node(const PMI_Context &, const std::string & ) {}
 
   /**
    * set numeric parameter value by its name.
@@ -469,44 +462,44 @@ public:
   void SetFakeStrainEnvironment(const TensorValue<PetscScalar> &T);
 
   /**
-   * aux function return first mole function of current node.
+   * aux function return first mole function of the node in \p ctx.
    */
-  PetscScalar ReadxMoleFraction () const;
+  PetscScalar ReadxMoleFraction (const PMI_Context &ctx) const;
 
   /**
-   * aux function return first mole function with upper and lower bind of current node.
+   * aux function return first mole function with upper and lower bind of the node in \p ctx.
    */
-  PetscScalar ReadxMoleFraction (const PetscScalar mole_xmin, const PetscScalar mole_xmax) const;
+  PetscScalar ReadxMoleFraction (const PMI_Context &ctx, const PetscScalar mole_xmin, const PetscScalar mole_xmax) const;
 
   /**
-   * aux function return second mole function of current node.
+   * aux function return second mole function of the node in \p ctx.
    */
-  PetscScalar ReadyMoleFraction () const;
+  PetscScalar ReadyMoleFraction (const PMI_Context &ctx) const;
 
   /**
-   * aux function return second mole function with upper and lower bind of current node.
+   * aux function return second mole function with upper and lower bind of the node in \p ctx.
    */
-  PetscScalar ReadyMoleFraction (const PetscScalar mole_ymin, const PetscScalar mole_ymax) const;
+  PetscScalar ReadyMoleFraction (const PMI_Context &ctx, const PetscScalar mole_ymin, const PetscScalar mole_ymax) const;
 
   /**
-   * aux function return total Acceptor concentration of current node
+   * aux function return total Acceptor concentration of the node in \p ctx
    */
-  PetscScalar ReadDopingNa () const;
+  PetscScalar ReadDopingNa (const PMI_Context &ctx) const;
 
   /**
-   * aux function return total Donor concentration of current node
+   * aux function return total Donor concentration of the node in \p ctx
    */
-  PetscScalar ReadDopingNd () const;
+  PetscScalar ReadDopingNd (const PMI_Context &ctx) const;
 
   /**
-   * aux function return minimal distance to surface
+   * aux function return minimal distance to surface of the node in \p ctx
    */
-  PetscScalar ReadDmin () const;
+  PetscScalar ReadDmin (const PMI_Context &ctx) const;
 
   /**
-   * aux function return strain tensor
+   * aux function return strain tensor of the node in \p ctx
    */
-  TensorValue<PetscScalar> ReadStrain() const;
+  TensorValue<PetscScalar> ReadStrain(const PMI_Context &ctx) const;
 };
 
 
@@ -531,27 +524,27 @@ public:
   /**
    * @return the mass density [g cm^-3] of material
    */
-  virtual PetscScalar Density       (const PetscScalar &Tl) const=0;
+  virtual PetscScalar Density       (const PMI_Context &ctx, const PetscScalar &Tl) const=0;
 
   /**
    * @return the \p relative \p permittivity of material
    */
-  virtual PetscScalar Permittivity  ()                      const  { return 1.0; }
+  virtual PetscScalar Permittivity  (const PMI_Context &ctx)                      const  { return 1.0; }
 
   /**
    * @return the \p relative \p permeability of material
    */
-  virtual PetscScalar Permeability  ()                      const  { return 1.0; }
+  virtual PetscScalar Permeability  (const PMI_Context &ctx)                      const  { return 1.0; }
 
   /**
    * @return strain tensor by stress tensor
    */
-  virtual TensorValue<PetscScalar> Strain(const TensorValue<PetscScalar> & stress) const  { return TensorValue<PetscScalar>(); }
+  virtual TensorValue<PetscScalar> Strain(const PMI_Context &ctx, const TensorValue<PetscScalar> & stress) const  { return TensorValue<PetscScalar>(); }
 
   /**
    * @return the affinity energy [eV] of material
    */
-  virtual PetscScalar Affinity      (const PetscScalar &Tl) const=0;
+  virtual PetscScalar Affinity      (const PMI_Context &ctx, const PetscScalar &Tl) const=0;
 
   /**
    * get the atom fraction of this material.
@@ -581,118 +574,118 @@ public:
   /**
    * @return band gap of semiconductor
    */
-  virtual PetscScalar Eg             (const PetscScalar &Tl) =0;
+  virtual PetscScalar Eg             (const PMI_Context &ctx, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of band gap to lattice temperature by Automatic Differentiation
    */
-  virtual AutoDScalar Eg             (const AutoDScalar &Tl) =0;
+  virtual AutoDScalar Eg             (const PMI_Context &ctx, const AutoDScalar &Tl) =0;
 
   /**
    * @return band gap narrowing due to heavy doping
    */
-  virtual PetscScalar EgNarrow       (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar EgNarrow       (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of band gap narrowing to lattice temperature by Automatic Differentiation
    */
-  virtual AutoDScalar EgNarrow       (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar EgNarrow       (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
 
   /**
    * @return conduction band shift due to band gap narrowing
    */
-  virtual PetscScalar EgNarrowToEc   (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar EgNarrowToEc   (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return valence band shift due to band gap narrowing
    */
-  virtual PetscScalar EgNarrowToEv   (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar EgNarrowToEv   (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of conduction band shift due to band gap narrowing
    * to lattice temperature by Automatic Differentiation
    */
-  virtual AutoDScalar EgNarrowToEc   (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar EgNarrowToEc   (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
 
   /**
    * @return partial derivatives of valence band shift due to band gap narrowing
    * to lattice temperature by Automatic Differentiation
    */
-  virtual AutoDScalar EgNarrowToEv   (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar EgNarrowToEv   (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
 
   /**
    * @return conduction band shift due to strain
    */
-  virtual PetscScalar dEcStrain   () { return 0.0; }
+  virtual PetscScalar dEcStrain   (const PMI_Context &ctx) { return 0.0; }
 
   /**
    * @return valence band shift due to strain
    */
-  virtual PetscScalar dEvStrain   () { return 0.0; }
+  virtual PetscScalar dEvStrain   (const PMI_Context &ctx) { return 0.0; }
 
   /**
    * @return effective electron mass
    */
-  virtual PetscScalar EffecElecMass  (const PetscScalar &Tl) =0;
+  virtual PetscScalar EffecElecMass  (const PMI_Context &ctx, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of effective electron mass
    */
-  virtual AutoDScalar EffecElecMass  (const AutoDScalar &Tl) =0;
+  virtual AutoDScalar EffecElecMass  (const PMI_Context &ctx, const AutoDScalar &Tl) =0;
 
   /**
    * @return effective hole mass
    */
-  virtual PetscScalar EffecHoleMass  (const PetscScalar &Tl) =0;
+  virtual PetscScalar EffecHoleMass  (const PMI_Context &ctx, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of effective hole mass
    */
-  virtual AutoDScalar EffecHoleMass  (const AutoDScalar &Tl) =0;
+  virtual AutoDScalar EffecHoleMass  (const PMI_Context &ctx, const AutoDScalar &Tl) =0;
 
   /**
    * @return effective density of states in the conduction band
    */
-  virtual PetscScalar Nc             (const PetscScalar &Tl) =0;
+  virtual PetscScalar Nc             (const PMI_Context &ctx, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of effective density of states in the conduction band
    * to lattice temperature by Automatic Differentiation
    */
-  virtual AutoDScalar Nc             (const AutoDScalar &Tl) =0;
+  virtual AutoDScalar Nc             (const PMI_Context &ctx, const AutoDScalar &Tl) =0;
 
   /**
    * @return effective density of states in the valence band
    */
-  virtual PetscScalar Nv             (const PetscScalar &Tl) =0;
+  virtual PetscScalar Nv             (const PMI_Context &ctx, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of effective density of states in the valence band
    * to lattice temperature by Automatic Differentiation
    */
-  virtual AutoDScalar Nv             (const AutoDScalar &Tl) =0;
+  virtual AutoDScalar Nv             (const PMI_Context &ctx, const AutoDScalar &Tl) =0;
 
   /**
    * @return intrinsic carrier concentration
    */
-  virtual PetscScalar ni            ( const PetscScalar &Tl) =0;
+  virtual PetscScalar ni            (const PMI_Context &ctx, const PetscScalar &Tl) =0;
 
   /**
    * @return effective intrinsic carrier concentration
    */
-  virtual PetscScalar nie            (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar nie            (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of effective intrinsic carrier concentration
    * to lattice temperature by Automatic Differentiation
    */
-  virtual AutoDScalar nie            (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar nie            (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
 
   /**
    * @return particle energy to elec-hole pare generation rate
    * @ref Meier, Dirk. CVD diamond sensors for particle detection and tracking. Diss. CERN, 1999.
    */
-  virtual PetscScalar ParticleQuantumEffect(const PetscScalar &Tl) {return 1.76*eV + 1.84*Eg(Tl);}
+  virtual PetscScalar ParticleQuantumEffect(const PMI_Context &ctx, const PetscScalar &Tl) {return 1.76*eV + 1.84*Eg(ctx, Tl);}
 
   /**
    * @return the ion type by given species, the return value is defined as P-type < 0 and N-type >0
@@ -703,174 +696,174 @@ public:
   /**
    * @return concentration of Na with incomplete ionization
    */
-  virtual PetscScalar Na_II          (const PetscScalar &p, const PetscScalar &Tl, bool fermi) { return ReadDopingNa (); }
+  virtual PetscScalar Na_II          (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &Tl, bool fermi) { return ReadDopingNa (ctx); }
 
   /**
    * @return concentration of Na with incomplete ionization
    */
-  virtual AutoDScalar Na_II          (const AutoDScalar &p, const AutoDScalar &Tl, bool fermi) { return ReadDopingNa (); }
+  virtual AutoDScalar Na_II          (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &Tl, bool fermi) { return ReadDopingNa (ctx); }
 
 
   /**
    * @return concentration of Nd with incomplete ionization
    */
-  virtual PetscScalar Nd_II          (const PetscScalar &n, const PetscScalar &Tl, bool fermi) { return ReadDopingNd (); }
+  virtual PetscScalar Nd_II          (const PMI_Context &ctx, const PetscScalar &n, const PetscScalar &Tl, bool fermi) { return ReadDopingNd (ctx); }
 
   /**
    * @return concentration of Nd with incomplete ionization
    */
-  virtual AutoDScalar Nd_II          (const AutoDScalar &n, const AutoDScalar &Tl, bool fermi) { return ReadDopingNd (); }
+  virtual AutoDScalar Nd_II          (const PMI_Context &ctx, const AutoDScalar &n, const AutoDScalar &Tl, bool fermi) { return ReadDopingNd (ctx); }
 
   /**
    * @return direct Recombination rate
    */
-  virtual PetscScalar CDIR           (const PetscScalar &Tl) =0;
+  virtual PetscScalar CDIR           (const PMI_Context &ctx, const PetscScalar &Tl) =0;
 
   /**
    * @return electron lift time in SHR Recombination
    */
-  virtual PetscScalar TAUN           (const PetscScalar &Tl) =0;
+  virtual PetscScalar TAUN           (const PMI_Context &ctx, const PetscScalar &Tl) =0;
 
   /**
    * @return hole lift time in SHR Recombination
    */
-  virtual PetscScalar TAUP           (const PetscScalar &Tl) =0;
+  virtual PetscScalar TAUP           (const PMI_Context &ctx, const PetscScalar &Tl) =0;
 
 
   /**
    * @return electron Auger Recombination rate
    */
-  virtual PetscScalar AUGERN           (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar AUGERN           (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return hole Auger Recombination rate
    */
-  virtual PetscScalar AUGERP           (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar AUGERP           (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
 
   /**
    * @return electron fit parameter of Density Gradient solver
    */
-  virtual PetscScalar Gamman         () {return 1.0;}
+  virtual PetscScalar Gamman         (const PMI_Context &ctx) {return 1.0;}
 
   /**
    * @return hole fit parameter of Density Gradient solver
    */
-  virtual PetscScalar Gammap         () {return 1.0;}
+  virtual PetscScalar Gammap         (const PMI_Context &ctx) {return 1.0;}
 
 
   /**
    * @return direct recombination rate
    */
-  virtual PetscScalar R_Direct     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar R_Direct     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of direct recombination rate
    */
-  virtual AutoDScalar R_Direct     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar R_Direct     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
 
   /**
    * @return Auger recombination rate
    */
-  virtual PetscScalar R_Auger      (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
-  virtual PetscScalar R_Auger_N    (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
-  virtual PetscScalar R_Auger_P    (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar R_Auger      (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar R_Auger_N    (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar R_Auger_P    (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of Auger recombination rate
    */
-  virtual AutoDScalar R_Auger      (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
-  virtual AutoDScalar R_Auger_N    (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
-  virtual AutoDScalar R_Auger_P    (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar R_Auger      (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar R_Auger_N    (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar R_Auger_P    (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
 
   /**
    * @return SHR recombination rate
    */
-  virtual PetscScalar R_SHR        (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar R_SHR        (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of SHR recombination rate
    */
-  virtual AutoDScalar R_SHR        (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar R_SHR        (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
 
   /**
    * @return SHR recombination rate at surface
    */
-  virtual PetscScalar R_Surf       (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar R_Surf       (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of SHR recombination rate at surface
    */
-  virtual AutoDScalar R_Surf       (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar R_Surf       (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
 
   /**
    * @return bulk recombination rate
    */
-  virtual PetscScalar Recomb       (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
+  virtual PetscScalar Recomb       (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of bulk recombination rate
    */
-  virtual AutoDScalar Recomb       (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar Recomb       (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl) =0;
 
 
 
   /**
    * @return electron energy relaxation time for EBM simulation
    */
-  virtual PetscScalar ElecEnergyRelaxTime(const PetscScalar &Tn, const PetscScalar &Tl) =0;
+  virtual PetscScalar ElecEnergyRelaxTime(const PMI_Context &ctx, const PetscScalar &Tn, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of electron energy relaxation time for EBM simulation
    */
-  virtual AutoDScalar ElecEnergyRelaxTime(const AutoDScalar &Tn, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar ElecEnergyRelaxTime(const PMI_Context &ctx, const AutoDScalar &Tn, const AutoDScalar &Tl) =0;
 
   /**
    * @return hole energy relaxation time for EBM simulation
    */
-  virtual PetscScalar HoleEnergyRelaxTime(const PetscScalar &Tp, const PetscScalar &Tl) =0;
+  virtual PetscScalar HoleEnergyRelaxTime(const PMI_Context &ctx, const PetscScalar &Tp, const PetscScalar &Tl) =0;
 
   /**
    * @return partial derivatives of hole energy relaxation time for EBM simulation
    */
-  virtual AutoDScalar HoleEnergyRelaxTime(const AutoDScalar &Tp, const AutoDScalar &Tl) =0;
+  virtual AutoDScalar HoleEnergyRelaxTime(const PMI_Context &ctx, const AutoDScalar &Tp, const AutoDScalar &Tl) =0;
 
 
 
   /**
    * @return electron current at Schottky contact
    */
-  virtual PetscScalar SchottyJsn (PetscScalar n,PetscScalar Tl,PetscScalar Vb)=0;
+  virtual PetscScalar SchottyJsn (const PMI_Context &ctx, PetscScalar n,PetscScalar Tl,PetscScalar Vb)=0;
 
   /**
    * @return partial derivatives of electron current at Schottky contact
    */
-  virtual AutoDScalar SchottyJsn (AutoDScalar n,AutoDScalar Tl,AutoDScalar Vb)=0;
+  virtual AutoDScalar SchottyJsn (const PMI_Context &ctx, AutoDScalar n,AutoDScalar Tl,AutoDScalar Vb)=0;
 
   /**
    * @return hole current at Schottky contact
    */
-  virtual PetscScalar SchottyJsp (PetscScalar p,PetscScalar Tl,PetscScalar Vb)=0;
+  virtual PetscScalar SchottyJsp (const PMI_Context &ctx, PetscScalar p,PetscScalar Tl,PetscScalar Vb)=0;
 
   /**
    * @return partial derivatives of hole current at Schottky contact
    */
-  virtual AutoDScalar SchottyJsp (AutoDScalar p,AutoDScalar Tl,AutoDScalar Vb)=0;
+  virtual AutoDScalar SchottyJsp (const PMI_Context &ctx, AutoDScalar p,AutoDScalar Tl,AutoDScalar Vb)=0;
 
   /**
    * @return electron Richardson constant
    */
-  virtual PetscScalar ARichN()=0;
+  virtual PetscScalar ARichN(const PMI_Context &ctx)=0;
 
   /**
    * @return hole Richardson constant
    */
-  virtual PetscScalar ARichP()=0;
+  virtual PetscScalar ARichP(const PMI_Context &ctx)=0;
 
   /**
    * @return Schottky barrier lowerring due to local electrical field
    */
-  virtual PetscScalar SchottyBarrierLowerring (PetscScalar eps, PetscScalar E)=0;
+  virtual PetscScalar SchottyBarrierLowerring (const PMI_Context &ctx, PetscScalar eps, PetscScalar E)=0;
 
 
 
@@ -878,23 +871,23 @@ public:
    * @return electron thermal emit velocity at hetero-junction
    * @note   D.Schroeder, Modelling of Interface Carrier Transport for Device Simulation, Springer, 1994.
    */
-  virtual PetscScalar ThermalVn (PetscScalar Tl)=0;
+  virtual PetscScalar ThermalVn (const PMI_Context &ctx, PetscScalar Tl)=0;
 
   /**
    * @return partial derivatives of electron thermal emit velocity at hetero-junction
    */
-  virtual AutoDScalar ThermalVn (AutoDScalar Tl)=0;
+  virtual AutoDScalar ThermalVn (const PMI_Context &ctx, AutoDScalar Tl)=0;
 
   /**
    * @return hole thermal emit velocity at hetero-junction
    * @note   D.Schroeder, Modelling of Interface Carrier Transport for Device Simulation, Springer, 1994.
    */
-  virtual PetscScalar ThermalVp (PetscScalar Tl)=0;
+  virtual PetscScalar ThermalVp (const PMI_Context &ctx, PetscScalar Tl)=0;
 
   /**
    * @return partial derivatives of hole thermal emit velocity at hetero-junction
    */
-  virtual AutoDScalar ThermalVp (AutoDScalar Tl)=0;
+  virtual AutoDScalar ThermalVp (const PMI_Context &ctx, AutoDScalar Tl)=0;
 
 
 
@@ -903,52 +896,52 @@ public:
    * Hot Carrier Injection: probability that an electron will not be scattered in the semiconductor before reaching the interface
    * @param dis distance from the point to the interface.
    */
-  virtual PetscScalar HCI_Probability_Semiconductor_n(const PetscScalar &dis) { return 0.0; }
+  virtual PetscScalar HCI_Probability_Semiconductor_n(const PMI_Context &ctx, const PetscScalar &dis) { return 0.0; }
 
   /**
    * Hot Carrier Injection: probability that a hole will not be scattered in the semiconductor before reaching the interface
    * @param dis distance from the point to the interface.
    */
-  virtual PetscScalar HCI_Probability_Semiconductor_p(const PetscScalar &dis) { return 0.0; }
+  virtual PetscScalar HCI_Probability_Semiconductor_p(const PMI_Context &ctx, const PetscScalar &dis) { return 0.0; }
 
   /**
    * Hot Carrier Injection: Fiegna integral over electron energy distribution
    * @param phin semiconductor-insulator potential barrier to electron
    * @param Eeff electric field in the direction of electron current flow
    */
-  virtual PetscScalar HCI_Integral_Fiegna_n(const PetscScalar &phin, const PetscScalar &Eeff) { return 0.0; }
+  virtual PetscScalar HCI_Integral_Fiegna_n(const PMI_Context &ctx, const PetscScalar &phin, const PetscScalar &Eeff) { return 0.0; }
 
   /**
    * Hot Carrier Injection: Fiegna integral over hole energy distribution
    * @param phip semiconductor-insulator potential barrier to hole
    * @param Eeff electric field in the direction of hole current flow
    */
-  virtual PetscScalar HCI_Integral_Fiegna_p(const PetscScalar &phip, const PetscScalar &Eeff) { return 0.0; }
+  virtual PetscScalar HCI_Integral_Fiegna_p(const PMI_Context &ctx, const PetscScalar &phip, const PetscScalar &Eeff) { return 0.0; }
 
   /**
    * Hot Carrier Injection: Classical integral over electron energy distribution
    * @param phin semiconductor-insulator potential barrier to electron
    * @param Eeff electric field in the direction of electron current flow
    */
-  virtual PetscScalar HCI_Integral_Classical_n(const PetscScalar &phin, const PetscScalar &Eeff) { return 0.0; }
+  virtual PetscScalar HCI_Integral_Classical_n(const PMI_Context &ctx, const PetscScalar &phin, const PetscScalar &Eeff) { return 0.0; }
 
   /**
    * Hot Carrier Injection: Classical integral over hole energy distribution
    * @param phip semiconductor-insulator potential barrier to hole
    * @param Eeff electric field in the direction of hole current flow
    */
-  virtual PetscScalar HCI_Integral_Classical_p(const PetscScalar &phip, const PetscScalar &Eeff) { return 0.0; }
+  virtual PetscScalar HCI_Integral_Classical_p(const PMI_Context &ctx, const PetscScalar &phip, const PetscScalar &Eeff) { return 0.0; }
 
 
   /**
    * @return band to band tunneling rate
    */
-  virtual PetscScalar BB_Tunneling(const PetscScalar &Tl, const PetscScalar &E) =0;
+  virtual PetscScalar BB_Tunneling(const PMI_Context &ctx, const PetscScalar &Tl, const PetscScalar &E) =0;
 
   /**
    * @return partial derivatives of band to band tunneling rate
    */
-  virtual AutoDScalar BB_Tunneling(const AutoDScalar &Tl, const AutoDScalar &E) =0;
+  virtual AutoDScalar BB_Tunneling(const PMI_Context &ctx, const AutoDScalar &Tl, const AutoDScalar &E) =0;
 
 
 };
@@ -976,58 +969,58 @@ public:
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  virtual PetscScalar ZETAN() { return 0.0; }
+  virtual PetscScalar ZETAN(const PMI_Context &ctx) { return 0.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  virtual PetscScalar ETAN()  { return 0.0; }
+  virtual PetscScalar ETAN(const PMI_Context &ctx)  { return 0.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  virtual PetscScalar ZETAP() { return 0.0; }
+  virtual PetscScalar ZETAP(const PMI_Context &ctx) { return 0.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  virtual PetscScalar ETAP()  { return 0.0; }
+  virtual PetscScalar ETAP(const PMI_Context &ctx)  { return 0.0; }
 
   /**
    * Hall mobility factor  for electrons
    */
-  virtual PetscScalar RH_ELEC()  { return 1.0; }
+  virtual PetscScalar RH_ELEC(const PMI_Context &ctx)  { return 1.0; }
 
   /**
    * Hall mobility factor  for holes
    */
-  virtual PetscScalar RH_HOLE()  { return 1.0; }
+  virtual PetscScalar RH_HOLE(const PMI_Context &ctx)  { return 1.0; }
 
   /**
    * @return the electron mobility
    */
-  virtual PetscScalar ElecMob (const PetscScalar &p,  const PetscScalar &n,  const PetscScalar &Tl,
+  virtual PetscScalar ElecMob (const PMI_Context &ctx, const PetscScalar &p,  const PetscScalar &n,  const PetscScalar &Tl,
                                const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const=0;
 
   /**
    * @return the hole mobility
    */
-  virtual PetscScalar HoleMob (const PetscScalar &p,  const PetscScalar &n,  const PetscScalar &Tl,
+  virtual PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p,  const PetscScalar &n,  const PetscScalar &Tl,
                                const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const=0;
 
   /**
    * @return the partial derivatives of electron mobility by Automatic Differentiation
    */
-  virtual AutoDScalar ElecMob (const AutoDScalar &p,  const AutoDScalar &n,  const AutoDScalar &Tl,
+  virtual AutoDScalar ElecMob (const PMI_Context &ctx, const AutoDScalar &p,  const AutoDScalar &n,  const AutoDScalar &Tl,
                                const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const=0;
 
   /**
    * @return the partial derivatives of hole mobility by Automatic Differentiation
    */
-  virtual AutoDScalar HoleMob (const AutoDScalar &p,  const AutoDScalar &n,  const AutoDScalar &Tl,
+  virtual AutoDScalar HoleMob (const PMI_Context &ctx, const AutoDScalar &p,  const AutoDScalar &n,  const AutoDScalar &Tl,
                                const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const=0;
 
 };
@@ -1054,46 +1047,46 @@ public:
   /**
    * @return the electron generation rate for DDM simulation
    */
-  virtual PetscScalar ElecGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const=0;
+  virtual PetscScalar ElecGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const=0;
 
   /**
    * @return the hole generation rate for DDM simulation
    */
-  virtual PetscScalar HoleGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const=0;
+  virtual PetscScalar HoleGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const=0;
 
   //Automatic Differentiation version for DDM
 
   /**
    * @return the partial derivatives of electron generation rate for DDM simulation by Automatic Differentiation
    */
-  virtual AutoDScalar ElecGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const=0;
+  virtual AutoDScalar ElecGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const=0;
 
   /**
    * @return the partial derivatives of hole generation rate for DDM simulation by Automatic Differentiation
    */
-  virtual AutoDScalar HoleGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const=0;
+  virtual AutoDScalar HoleGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const=0;
 
   /**
    * @return the electron generation rate for EBM simulation
    */
-  virtual PetscScalar ElecGenRateEBM (const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const=0;
+  virtual PetscScalar ElecGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const=0;
 
   /**
    * @return the hole generation rate for EBM simulation
    */
-  virtual PetscScalar HoleGenRateEBM (const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const=0;
+  virtual PetscScalar HoleGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const=0;
 
   //Automatic Differentiation version for EBM
 
   /**
    * @return the partial derivatives of electron generation rate for EBM simulation by Automatic Differentiation
    */
-  virtual AutoDScalar ElecGenRateEBM (const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const=0;
+  virtual AutoDScalar ElecGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const=0;
 
   /**
    * @return the partial derivatives of hole generation rate for EBM simulation by Automatic Differentiation
    */
-  virtual AutoDScalar HoleGenRateEBM (const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const=0;
+  virtual AutoDScalar HoleGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const=0;
 
 
 };
@@ -1154,67 +1147,80 @@ public:
    * returns the electric charge density due to trapped charge at this node
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  virtual PetscScalar Charge(const bool flag_bulk) = 0;
+  virtual PetscScalar Charge(const PMI_Context &ctx, const bool flag_bulk) = 0;
 
   /**
    * returns the partial derivatives of electric charge density
    * w.r.t. the local V,n,p
    * one should call CalculateAD() to calculate the electron occupancy before calling this function
    */
-  virtual AutoDScalar ChargeAD(const bool flag_bulk) = 0;
+  virtual AutoDScalar ChargeAD(const PMI_Context &ctx, const bool flag_bulk) = 0;
 
   /**
    * Calculates the electron trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  virtual PetscScalar ElectronTrapRate(const bool flag_bulk, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl) = 0;
+  virtual PetscScalar ElectronTrapRate(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl) = 0;
 
   /**
    * Calculates the hole trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  virtual PetscScalar HoleTrapRate(const bool flag_bulk, const PetscScalar &p, const PetscScalar &ni, const PetscScalar &Tl) = 0;
+  virtual PetscScalar HoleTrapRate(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &ni, const PetscScalar &Tl) = 0;
 
   /**
    * Calculates the partial derivatives of electron trapping rate
    * one should call CalculateAD() to calculate the electron occupancy before calling this function
    */
-  virtual AutoDScalar ElectronTrapRate(const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl) = 0;
+  virtual AutoDScalar ElectronTrapRate(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl) = 0;
 
   /**
    * Calculates the partial derivatives of hole trapping rate
    * one should call CalculateAD() to calculate the electron occupancy before calling this function
    */
-  virtual AutoDScalar HoleTrapRate(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &ni, const AutoDScalar &Tl) = 0;
+  virtual AutoDScalar HoleTrapRate(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &ni, const AutoDScalar &Tl) = 0;
 
   /**
    * Calculate the heat transferred to lattice in trapping
    * one should call Calculate() to calculate the electron occupancy before calling this function
    * @EcEi   Energy difference between Conduction band and Intrinsic level
    */
-  virtual PetscScalar TrapHeat(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tp, const PetscScalar &Tn, const PetscScalar &Tl, const PetscScalar &EcEi, const PetscScalar &EiEv) = 0;
+  virtual PetscScalar TrapHeat(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tp, const PetscScalar &Tn, const PetscScalar &Tl, const PetscScalar &EcEi, const PetscScalar &EiEv) = 0;
 
   /**
    * Calculate the partial derivatives of heat transferred to lattice in trapping
    * one should call CalculateAD() to calculate the electron occupancy before calling this function
    * @EcEi   Energy difference between Conduction band and Intrinsic level
    */
-  virtual AutoDScalar TrapHeat(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tp, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi, const AutoDScalar &EiEv) = 0;
+  virtual AutoDScalar TrapHeat(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tp, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi, const AutoDScalar &EiEv) = 0;
 
   /**
    * Calculate trap occupancy.
    */
-  virtual void Calculate(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl) = 0;
+  virtual void Calculate(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl) = 0;
 
   /**
    * partial derivatives of trap occupancy w.r.t. local V,n,p,
    */
-  virtual void Calculate(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl) = 0;
+  virtual void Calculate(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl) = 0;
 
   /**
    * process the parameters of the PMI command
    */
-  virtual void Update(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl) = 0;
+  virtual void Update(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl) = 0;
+
+  /**
+   * append the trap state which depends on time step history (occupancy of the last
+   * two time steps used by BDF2) to \p state, for checkpoint of transient simulation.
+   * model without such state does nothing
+   */
+  virtual void Checkpoint(std::vector<PetscScalar> &state) const {}
+
+  /**
+   * restore the trap state from \p state written by Checkpoint()
+   * @return false if \p state does not match the traps
+   */
+  virtual bool Restart(const std::vector<PetscScalar> &state) { return state.empty(); }
 
 };
 
@@ -1239,22 +1245,22 @@ public:
   /**
    * @return the heat capacity [J/(K*cm^3)] of the material
    */
-  virtual PetscScalar HeatCapacity  (const PetscScalar &Tl) const=0;
+  virtual PetscScalar HeatCapacity  (const PMI_Context &ctx, const PetscScalar &Tl) const=0;
 
   /**
    * @return the partial derivatives of heat capacity by AD
    */
-  virtual AutoDScalar HeatCapacity  (const AutoDScalar &Tl) const=0;
+  virtual AutoDScalar HeatCapacity  (const PMI_Context &ctx, const AutoDScalar &Tl) const=0;
 
   /**
    * @return the heat conduction [W/cm/K] of the material
    */
-  virtual PetscScalar HeatConduction(const PetscScalar &Tl) const=0;
+  virtual PetscScalar HeatConduction(const PMI_Context &ctx, const PetscScalar &Tl) const=0;
 
   /**
    * @return the partial derivatives of heat conduction by AD
    */
-  virtual AutoDScalar HeatConduction(const AutoDScalar &Tl) const=0;
+  virtual AutoDScalar HeatConduction(const PMI_Context &ctx, const AutoDScalar &Tl) const=0;
 
 };
 
@@ -1304,12 +1310,12 @@ public:
   /**
    * @return the complex refraction index of material
    */
-  virtual std::complex<PetscScalar> RefractionIndex(PetscScalar lamda, PetscScalar Tl, PetscScalar Eg=0) const=0;
+  virtual std::complex<PetscScalar> RefractionIndex(const PMI_Context &ctx, PetscScalar lamda, PetscScalar Tl, PetscScalar Eg=0) const=0;
 
   /**
    * @return the free carrier absorption coefficient
    */
-  virtual PetscScalar FreeCarrierAbsorption(PetscScalar lamda, PetscScalar n, PetscScalar p, PetscScalar Tl) const { return 0.0; }
+  virtual PetscScalar FreeCarrierAbsorption(const PMI_Context &ctx, PetscScalar lamda, PetscScalar n, PetscScalar p, PetscScalar Tl) const { return 0.0; }
 };
 
 
@@ -71,16 +71,13 @@ public:
   virtual ~MaterialBase();
 
   /**
-   * mapping Point, its Data and current time to internal image.
-   * the PMI has second order pointer to these internal image.
-   * so PMI can read information
+   * mapping Point, its Data and current time to the evaluation context of PMI.
+   * the context is owned by the caller and should be passed to each PMIS evaluation
+   * of this node. the material class keeps no state of the node, so mapping and
+   * PMI evaluations can be made concurrently from any thread.
    */
-  void mapping(const Point* point, const FVM_NodeData* node_data, PetscScalar time)
-  {
-    p_point = point;
-    p_node_data = node_data;
-    clock = time;
-  }
+  PMI_Context mapping(const Point* point, const FVM_NodeData* node_data, PetscScalar time) const
+  { return PMI_Context(point, node_data, time); }
 
   /**
    * @return PMI_Environment
@@ -126,32 +123,29 @@ public:
    */
   virtual std::string get_pmi_info(const std::string& type, const int verbosity = 0) = 0;
 
-protected:
-
   /**
-   * const pointer to region
+   * append the state of PMI models which depends on time step history to \p state,
+   * for checkpoint of transient simulation
    */
-  const SimulationRegion * region;
+  virtual void checkpoint(std::vector<PetscScalar> & ) const {}
 
   /**
-   * the material name
+   * restore the state of PMI models from \p state written by checkpoint()
+   * @return false if \p state does not match the models
    */
-  const std::string          material;
+  virtual bool restart(const std::vector<PetscScalar> & state) { return state.empty(); }
 
-  /**
-   * pointer to current point, which is updated by mapping function
-   */
-  const Point                *p_point;
+protected:
 
   /**
-   * pointer to data of current node, which is updated by mapping function
+   * const pointer to region
    */
-  const FVM_NodeData         *p_node_data;
+  const SimulationRegion * region;
 
   /**
-   * current time, which is updated by mapping function
+   * the material name
    */
-  PetscScalar                clock;
+  const std::string          material;
 
   /**
    * region point based variables
@@ -249,6 +243,18 @@ public:
    */
   std::string get_pmi_info(const std::string& type, const int verbosity = 0) ;
 
+  /**
+   * the trap occupancy of the last two time steps is saved
+   */
+  void checkpoint(std::vector<PetscScalar> & state) const
+  { trap->Checkpoint(state); }
+
+  /**
+   * restore the trap occupancy of the last two time steps
+   */
+  bool restart(const std::vector<PetscScalar> & state)
+  { return trap->Restart(state); }
+
 };
 
 
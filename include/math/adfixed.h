@@ -0,0 +1,280 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+#ifndef __adfixed_h__
+#define __adfixed_h__
+
+#include <cmath>
+
+#include "adolc.h"
+
+
+namespace adtl
+{
+
+  /**
+   * forward mode AD scalar with compile time number of directions.
+   *
+   * AutoDScalar always carries ADTL_NUMBER_DIRECTIONS derivatives and clears
+   * all of them on construction, which dominates the cost of small kernels
+   * such as the S-G flux of an edge. FixedDScalar only holds N derivatives on
+   * the stack and every loop has a constant trip count, so the compiler is
+   * free to unroll and vectorize them.
+   *
+   * It is used inside such kernels only; the result is converted back to
+   * AutoDScalar by to_auto() or chain() before it meets the material models.
+   */
+  template <unsigned int N>
+  class FixedDScalar
+  {
+  public:
+    /**
+     * constant, all the derivatives are zero
+     */
+    FixedDScalar(const PetscScalar v=0.0) : val(v)
+    {
+      for(unsigned int i=0; i<N; ++i) adval[i] = 0.0;
+    }
+
+    /**
+     * independent variable, with unit derivative at direction \p p
+     */
+    FixedDScalar(const PetscScalar v, const unsigned int p) : val(v)
+    {
+      for(unsigned int i=0; i<N; ++i) adval[i] = 0.0;
+      adval[p] = 1.0;
+    }
+
+    /**
+     * copy the first \p n directions of AutoDScalar \p a to
+     * directions [offset, offset+n) of this variable
+     */
+    FixedDScalar(const AutoDScalar &a, const unsigned int offset, const unsigned int n) : val(a.getValue())
+    {
+      for(unsigned int i=0; i<N; ++i) adval[i] = 0.0;
+      const PetscScalar * ad = a.getADValue();
+      for(unsigned int i=0; i<n; ++i) adval[offset+i] = ad[i];
+    }
+
+    /*******************  getter / setter  ********************************/
+    PetscScalar getValue() const { return val; }
+    void setValue(const PetscScalar v) { val = v; }
+    const PetscScalar * getADValue() const { return adval; }
+    PetscScalar getADValue(const unsigned int p) const { return adval[p]; }
+    void setADValue(const unsigned int p, const PetscScalar v) { adval[p] = v; }
+
+    /**
+     * convert to AutoDScalar, the ith direction goes to direction order[i]
+     */
+    AutoDScalar to_auto(const unsigned int *order) const
+    {
+      AutoDScalar tmp(val);
+      for(unsigned int i=0; i<N; ++i)
+        tmp.setADValue(order[i], adval[i]);
+      return tmp;
+    }
+
+    /*******************  arithmetic assignment  **************************/
+    FixedDScalar & operator += (const FixedDScalar &a)
+    { val += a.val; for(unsigned int i=0; i<N; ++i) adval[i] += a.adval[i]; return *this; }
+
+    FixedDScalar & operator -= (const FixedDScalar &a)
+    { val -= a.val; for(unsigned int i=0; i<N; ++i) adval[i] -= a.adval[i]; return *this; }
+
+    FixedDScalar & operator *= (const FixedDScalar &a)
+    {
+      for(unsigned int i=0; i<N; ++i) adval[i] = adval[i]*a.val + val*a.adval[i];
+      val *= a.val;
+      return *this;
+    }
+
+    FixedDScalar & operator /= (const FixedDScalar &a)
+    {
+      const PetscScalar r = 1.0/a.val;
+      val *= r;
+      for(unsigned int i=0; i<N; ++i) adval[i] = (adval[i] - val*a.adval[i])*r;
+      return *this;
+    }
+
+    FixedDScalar & operator += (const PetscScalar v) { val += v; return *this; }
+    FixedDScalar & operator -= (const PetscScalar v) { val -= v; return *this; }
+    FixedDScalar & operator *= (const PetscScalar v)
+    { val *= v; for(unsigned int i=0; i<N; ++i) adval[i] *= v; return *this; }
+    FixedDScalar & operator /= (const PetscScalar v) { return (*this) *= 1.0/v; }
+
+    PetscScalar val;
+    PetscScalar adval[N];
+  };
+
+
+  /**
+   * chain rule: \p a is a kernel result whose ith direction is the derivative with respect to
+   * kernel argument \p arg[i], return the same result with respect to the directions of AutoDScalar
+   */
+  template <unsigned int N>
+  inline AutoDScalar chain(const FixedDScalar<N> &a, const AutoDScalar * const arg[N])
+  {
+    PetscScalar ad[ADTL_NUMBER_DIRECTIONS];
+    const unsigned int numdir = AutoDScalar::numdir;
+    for(unsigned int _i=0; _i<numdir; ++_i) ad[_i] = 0.0;
+    for(unsigned int k=0; k<N; ++k)
+    {
+      const PetscScalar d = a.adval[k];
+      if(d == 0.0) continue;
+      const PetscScalar * arg_ad = arg[k]->getADValue();
+      for(unsigned int _i=0; _i<numdir; ++_i)
+        ad[_i] += d*arg_ad[_i];
+    }
+    return AutoDScalar(a.val, ad, numdir);
+  }
+
+
+  /*************************  temporary results  ******************************/
+  template <unsigned int N>
+  inline FixedDScalar<N> operator - (const FixedDScalar<N> &a)
+  { FixedDScalar<N> tmp(a); tmp *= -1.0; return tmp; }
+
+  template <unsigned int N>
+  inline const FixedDScalar<N> & operator + (const FixedDScalar<N> &a)
+  { return a; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator + (const FixedDScalar<N> &a, const FixedDScalar<N> &b)
+  { FixedDScalar<N> tmp(a); tmp += b; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator + (const FixedDScalar<N> &a, const PetscScalar v)
+  { FixedDScalar<N> tmp(a); tmp.val += v; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator + (const PetscScalar v, const FixedDScalar<N> &a)
+  { FixedDScalar<N> tmp(a); tmp.val += v; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator - (const FixedDScalar<N> &a, const FixedDScalar<N> &b)
+  { FixedDScalar<N> tmp(a); tmp -= b; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator - (const FixedDScalar<N> &a, const PetscScalar v)
+  { FixedDScalar<N> tmp(a); tmp.val -= v; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator - (const PetscScalar v, const FixedDScalar<N> &a)
+  { FixedDScalar<N> tmp(a); tmp *= -1.0; tmp.val += v; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator * (const FixedDScalar<N> &a, const FixedDScalar<N> &b)
+  { FixedDScalar<N> tmp(a); tmp *= b; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator * (const FixedDScalar<N> &a, const PetscScalar v)
+  { FixedDScalar<N> tmp(a); tmp *= v; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator * (const PetscScalar v, const FixedDScalar<N> &a)
+  { FixedDScalar<N> tmp(a); tmp *= v; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator / (const FixedDScalar<N> &a, const FixedDScalar<N> &b)
+  { FixedDScalar<N> tmp(a); tmp /= b; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator / (const FixedDScalar<N> &a, const PetscScalar v)
+  { FixedDScalar<N> tmp(a); tmp *= 1.0/v; return tmp; }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> operator / (const PetscScalar v, const FixedDScalar<N> &a)
+  {
+    FixedDScalar<N> tmp;
+    tmp.val = v/a.val;
+    const PetscScalar d = -tmp.val/a.val;
+    for(unsigned int i=0; i<N; ++i) tmp.adval[i] = d*a.adval[i];
+    return tmp;
+  }
+
+
+  /**
+   * helper for unary functions: value \p f and derivative \p df of the outer function
+   */
+  template <unsigned int N>
+  inline FixedDScalar<N> chain_unary(const FixedDScalar<N> &a, const PetscScalar f, const PetscScalar df)
+  {
+    FixedDScalar<N> tmp;
+    tmp.val = f;
+    for(unsigned int i=0; i<N; ++i) tmp.adval[i] = df*a.adval[i];
+    return tmp;
+  }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> exp(const FixedDScalar<N> &a)
+  { const PetscScalar f = ::exp(a.val); return chain_unary(a, f, f); }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> log(const FixedDScalar<N> &a)
+  { return chain_unary(a, ::log(a.val), 1.0/a.val); }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> sqrt(const FixedDScalar<N> &a)
+  { const PetscScalar f = ::sqrt(a.val); return chain_unary(a, f, 0.5/f); }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> pow(const FixedDScalar<N> &a, const PetscScalar v)
+  { return chain_unary(a, std::pow(a.val, v), v == 0.0 ? 0.0 : v*std::pow(a.val, v-1)); }
+
+  template <unsigned int N>
+  inline FixedDScalar<N> fabs(const FixedDScalar<N> &a)
+  {
+    if(a.val > 0) return a;
+    if(a.val < 0) return -a;
+    // the same as AutoDScalar, take the one sided derivative
+    FixedDScalar<N> tmp;
+    for(unsigned int i=0; i<N; ++i) tmp.adval[i] = ::fabs(a.adval[i]);
+    return tmp;
+  }
+
+
+  /*******************  comparison, only value is compared  *******************/
+  template <unsigned int N>
+  inline bool operator <  (const FixedDScalar<N> &a, const FixedDScalar<N> &b) { return a.val <  b.val; }
+  template <unsigned int N>
+  inline bool operator >  (const FixedDScalar<N> &a, const FixedDScalar<N> &b) { return a.val >  b.val; }
+  template <unsigned int N>
+  inline bool operator <= (const FixedDScalar<N> &a, const FixedDScalar<N> &b) { return a.val <= b.val; }
+  template <unsigned int N>
+  inline bool operator >= (const FixedDScalar<N> &a, const FixedDScalar<N> &b) { return a.val >= b.val; }
+
+  template <unsigned int N>
+  inline bool operator <  (const FixedDScalar<N> &a, const PetscScalar v) { return a.val <  v; }
+  template <unsigned int N>
+  inline bool operator >  (const FixedDScalar<N> &a, const PetscScalar v) { return a.val >  v; }
+  template <unsigned int N>
+  inline bool operator <= (const FixedDScalar<N> &a, const PetscScalar v) { return a.val <= v; }
+  template <unsigned int N>
+  inline bool operator >= (const FixedDScalar<N> &a, const PetscScalar v) { return a.val >= v; }
+
+  template <unsigned int N>
+  inline bool operator <  (const PetscScalar v, const FixedDScalar<N> &a) { return v <  a.val; }
+  template <unsigned int N>
+  inline bool operator >  (const PetscScalar v, const FixedDScalar<N> &a) { return v >  a.val; }
+
+}
+
+#endif
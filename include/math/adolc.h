@@ -65,11 +65,19 @@
 // However, using std::vector (or even new adval array) instead of fxied length array makes system performance greatly slow done.
 #define ADTL_NUMBER_DIRECTIONS 56
 
+// the number of active directions is kept per thread, so that
+// threads assembling different kinds of stencils do not disturb each other
+#if defined(_MSC_VER)
+  #define ADTL_THREAD_LOCAL __declspec(thread)
+#else
+  #define ADTL_THREAD_LOCAL __thread
+#endif
+
 
 extern "C"
 {
   /**
-   * function for set the static adtl::AutoDScalar::numdir
+   * function for set the static adtl::AutoDScalar::numdir of calling thread
    */
   DLL_EXPORT_DECLARE  void  set_ad_number(const unsigned int p);
 }
@@ -235,7 +243,7 @@ namespace adtl
     inline friend std::ostream& operator << ( std::ostream&, const AutoDScalar& );
     inline friend std::istream& operator >> ( std::istream&, AutoDScalar& );
 
-    static unsigned int numdir;
+    static ADTL_THREAD_LOCAL unsigned int numdir;
     static void setNumDir(const unsigned int p)
     {
       if (p>ADTL_NUMBER_DIRECTIONS) numdir=ADTL_NUMBER_DIRECTIONS;
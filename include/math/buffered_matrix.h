@@ -0,0 +1,215 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#ifndef __buffered_matrix_h__
+#define __buffered_matrix_h__
+
+#include <vector>
+
+#include "genius_common.h"
+#include "sparse_matrix.h"
+
+
+/**
+ * A matrix which only records the set/add operations and replays them
+ * into a real matrix later. It is used as thread private storage when
+ * several threads assemble the jacobian matrix concurrently.
+ * The operations are replayed in the same order as they were recorded,
+ * so the result is deterministic.
+ */
+template <typename T>
+class BufferedMatrix : public SparseMatrix<T>
+{
+public:
+  /**
+   * Constructor, the matrix has the same layout as \p layout
+   */
+  BufferedMatrix (const SparseMatrix<T> * layout);
+
+  /**
+   * Destructor
+   */
+  ~BufferedMatrix () {}
+
+  /**
+   * nothing to do
+   */
+  void init () { this->_is_initialized = true; }
+
+  /**
+   * drop all the buffered operations and release the memory
+   */
+  void clear ();
+
+  /**
+   * drop all the buffered operations
+   */
+  void zero ();
+
+  /**
+   * nothing to do
+   */
+  void close (bool ) {}
+
+  /**
+   * record a set operation
+   */
+  void set (const unsigned int i, const unsigned int j, const T value);
+
+  /**
+   * record an add operation
+   */
+  void add (const unsigned int i, const unsigned int j, const T value);
+
+  /**
+   * record a row add operation
+   */
+  void add_row (unsigned int row, const std::vector<unsigned int> &cols, const T* dm);
+
+  /**
+   * record a row add operation
+   */
+  void add_row (unsigned int row, unsigned int n, const unsigned int * cols, const T* dm);
+
+  /**
+   * record a row add operation
+   */
+  void add_row (unsigned int row, int n, const int * cols, const T* dm);
+
+  /**
+   * record a row add operation with the slots of entries,
+   * the slots are handed to the real matrix at replay
+   */
+  void add_row (unsigned int row, int n, const int * cols, const int * slots, const T* dm);
+
+  /**
+   * record the add operation of a full matrix
+   */
+  void add_matrix (const std::vector<unsigned int> &rows, const std::vector<unsigned int> &cols, const T* dm);
+
+  /**
+   * record the add operation of a full matrix
+   */
+  void add_matrix (unsigned int m, unsigned int * rows, unsigned int n, unsigned int * cols, const T* dm);
+
+  /**
+   * not supported
+   */
+  void add_row_to_row(const std::vector<int> &, const std::vector<int> &) { genius_error(); }
+
+  /**
+   * not supported
+   */
+  void clear_row(int , const T ) { genius_error(); }
+
+  /**
+   * not supported
+   */
+  void clear_row(const std::vector<int> &, const T ) { genius_error(); }
+
+  /**
+   * not supported
+   */
+  void get_row (unsigned int , int , const int * , T* ) { genius_error(); }
+
+  /**
+   * not supported
+   */
+  T operator () (const unsigned int , const unsigned int ) const { genius_error(); return T(0); }
+
+  /**
+   * @return true when no operation is buffered
+   */
+  bool closed() const { return _blocks.empty(); }
+
+  /**
+   * print the buffer size
+   */
+  void print_personal(std::ostream& os=std::cout) const;
+
+  /**
+   * replay the buffered operations into \p mat, and clear the buffer
+   */
+  void flush(SparseMatrix<T> * mat);
+
+  /**
+   * @return the number of buffered entries
+   */
+  unsigned int n_entries() const { return _values.size(); }
+
+private:
+
+  /**
+   * a buffered operation on (part of) one row
+   */
+  struct Block
+  {
+    /// the row index
+    unsigned int row;
+    /// the first entry of this block in _cols and _values
+    unsigned int offset;
+    /// the number of entries
+    unsigned int n;
+    /// insert instead of add
+    bool insert;
+    /// the first slot of this block in _slots, -1 when recorded without slots
+    int slot_offset;
+  };
+
+  /**
+   * buffered operations, in the order they were recorded
+   */
+  std::vector<Block> _blocks;
+
+  /**
+   * column indices of buffered entries
+   */
+  std::vector<int> _cols;
+
+  /**
+   * values of buffered entries
+   */
+  std::vector<T> _values;
+
+  /**
+   * slots of buffered entries, only for the blocks recorded with slots
+   */
+  std::vector<int> _slots;
+
+  /**
+   * begin a new block
+   */
+  void _new_block(unsigned int row, unsigned int n, bool insert)
+  {
+    Block b;
+    b.row = row;
+    b.offset = _values.size();
+    b.n = n;
+    b.insert = insert;
+    b.slot_offset = -1;
+    _blocks.push_back(b);
+  }
+
+};
+
+
+#endif
@@ -26,6 +26,7 @@
 
 
 
+#include <algorithm>
 #include "mathfunc.h"
 
 
@@ -162,16 +163,123 @@ inline PetscScalar dVIp_dd(PetscScalar Vt,PetscScalar dVv,PetscScalar p1,PetscSc
   return (-p1*pd1bern(-dVv/Vt)-p2*pd1bern(dVv/Vt))/h;
 }
 
-inline AutoDScalar In_dd(PetscScalar Vt,const AutoDScalar &dVc,const AutoDScalar &n1,const AutoDScalar &n2, PetscScalar h)
+template <unsigned int N>
+inline FixedDScalar<N> In_dd(PetscScalar Vt,const FixedDScalar<N> &dVc,const FixedDScalar<N> &n1,const FixedDScalar<N> &n2, PetscScalar h)
 {
   return Vt*(n2*bern(-dVc/Vt)-n1*bern(dVc/Vt))/h;
 }
 
-inline AutoDScalar Ip_dd(PetscScalar Vt,const AutoDScalar &dVv,const AutoDScalar &p1,const AutoDScalar &p2, PetscScalar h)
+template <unsigned int N>
+inline FixedDScalar<N> Ip_dd(PetscScalar Vt,const FixedDScalar<N> &dVv,const FixedDScalar<N> &p1,const FixedDScalar<N> &p2, PetscScalar h)
 {
   return Vt*(p1*bern(-dVv/Vt)-p2*bern(dVv/Vt))/h;
 }
 
+// the AD version evaluates the flux with respect to its 3 arguments by FixedDScalar,
+// and then applies the chain rule once, which is much cheaper than doing every
+// operation over all the directions of AutoDScalar
+inline AutoDScalar In_dd(PetscScalar Vt,const AutoDScalar &dVc,const AutoDScalar &n1,const AutoDScalar &n2, PetscScalar h)
+{
+  const AutoDScalar * arg[3] = {&dVc, &n1, &n2};
+  FixedDScalar<3> J = In_dd(Vt, FixedDScalar<3>(dVc.getValue(), 0), FixedDScalar<3>(n1.getValue(), 1), FixedDScalar<3>(n2.getValue(), 2), h);
+  return chain(J, arg);
+}
+
+inline AutoDScalar Ip_dd(PetscScalar Vt,const AutoDScalar &dVv,const AutoDScalar &p1,const AutoDScalar &p2, PetscScalar h)
+{
+  const AutoDScalar * arg[3] = {&dVv, &p1, &p2};
+  FixedDScalar<3> J = Ip_dd(Vt, FixedDScalar<3>(dVv.getValue(), 0), FixedDScalar<3>(p1.getValue(), 1), FixedDScalar<3>(p2.getValue(), 2), h);
+  return chain(J, arg);
+}
+
+
+// batched S-G current of n edges, the edge arguments are given as arrays.
+// the Bernoulli functions of B(x) and B(-x) share one exponential, and
+// are evaluated by the branch free bern_pair_batch() in chunks
+inline void In_dd_batch(PetscScalar Vt, unsigned int n, const PetscScalar *dVc, const PetscScalar *n1, const PetscScalar *n2, const PetscScalar *h, PetscScalar *J)
+{
+  const unsigned int chunk = 64;
+  PetscScalar x[chunk], bp[chunk], bm[chunk];
+  for(unsigned int b=0; b<n; b+=chunk, dVc+=chunk, n1+=chunk, n2+=chunk, h+=chunk, J+=chunk)
+  {
+    const unsigned int m = std::min(chunk, n-b);
+#pragma omp simd
+    for(unsigned int i=0; i<m; ++i)
+      x[i] = dVc[i]/Vt;
+    bern_pair_batch(m, x, bp, bm);
+#pragma omp simd
+    for(unsigned int i=0; i<m; ++i)
+      J[i] = Vt*(n2[i]*bm[i]-n1[i]*bp[i])/h[i];
+  }
+}
+
+inline void Ip_dd_batch(PetscScalar Vt, unsigned int n, const PetscScalar *dVv, const PetscScalar *p1, const PetscScalar *p2, const PetscScalar *h, PetscScalar *J)
+{
+  const unsigned int chunk = 64;
+  PetscScalar x[chunk], bp[chunk], bm[chunk];
+  for(unsigned int b=0; b<n; b+=chunk, dVv+=chunk, p1+=chunk, p2+=chunk, h+=chunk, J+=chunk)
+  {
+    const unsigned int m = std::min(chunk, n-b);
+#pragma omp simd
+    for(unsigned int i=0; i<m; ++i)
+      x[i] = dVv[i]/Vt;
+    bern_pair_batch(m, x, bp, bm);
+#pragma omp simd
+    for(unsigned int i=0; i<m; ++i)
+      J[i] = Vt*(p1[i]*bm[i]-p2[i]*bp[i])/h[i];
+  }
+}
+
+// batched S-G current of n edges with derivatives, for the AD Jacobian kernel.
+// the partial derivatives to dVc, n1 and n2 (dVIn_dd, -Vt*B(x)/h and Vt*B(-x)/h)
+// are evaluated in batch, then the chain rule is applied to the arguments.
+// the value part is the same as the PetscScalar version
+template <unsigned int N>
+inline void In_dd_batch(PetscScalar Vt, unsigned int n, const FixedDScalar<N> *dVc, const FixedDScalar<N> *n1, const FixedDScalar<N> *n2, const PetscScalar *h, FixedDScalar<N> *J)
+{
+  const unsigned int chunk = 64;
+  PetscScalar x[chunk], bp[chunk], bm[chunk], dbp[chunk], dbm[chunk];
+  for(unsigned int b=0; b<n; b+=chunk, dVc+=chunk, n1+=chunk, n2+=chunk, h+=chunk, J+=chunk)
+  {
+    const unsigned int m = std::min(chunk, n-b);
+    for(unsigned int i=0; i<m; ++i)
+      x[i] = dVc[i].val/Vt;
+    bern_pd1bern_pair_batch(m, x, bp, bm, dbp, dbm);
+    for(unsigned int i=0; i<m; ++i)
+    {
+      const PetscScalar dJ_dV  = (-n2[i].val*dbm[i]-n1[i].val*dbp[i])/h[i];
+      const PetscScalar dJ_dn1 = -Vt*bp[i]/h[i];
+      const PetscScalar dJ_dn2 =  Vt*bm[i]/h[i];
+      J[i].val = Vt*(n2[i].val*bm[i]-n1[i].val*bp[i])/h[i];
+      for(unsigned int k=0; k<N; ++k)
+        J[i].adval[k] = dJ_dV*dVc[i].adval[k] + dJ_dn1*n1[i].adval[k] + dJ_dn2*n2[i].adval[k];
+    }
+  }
+}
+
+template <unsigned int N>
+inline void Ip_dd_batch(PetscScalar Vt, unsigned int n, const FixedDScalar<N> *dVv, const FixedDScalar<N> *p1, const FixedDScalar<N> *p2, const PetscScalar *h, FixedDScalar<N> *J)
+{
+  const unsigned int chunk = 64;
+  PetscScalar x[chunk], bp[chunk], bm[chunk], dbp[chunk], dbm[chunk];
+  for(unsigned int b=0; b<n; b+=chunk, dVv+=chunk, p1+=chunk, p2+=chunk, h+=chunk, J+=chunk)
+  {
+    const unsigned int m = std::min(chunk, n-b);
+    for(unsigned int i=0; i<m; ++i)
+      x[i] = dVv[i].val/Vt;
+    bern_pd1bern_pair_batch(m, x, bp, bm, dbp, dbm);
+    for(unsigned int i=0; i<m; ++i)
+    {
+      const PetscScalar dJ_dV  = (-p1[i].val*dbm[i]-p2[i].val*dbp[i])/h[i];
+      const PetscScalar dJ_dp1 =  Vt*bm[i]/h[i];
+      const PetscScalar dJ_dp2 = -Vt*bp[i]/h[i];
+      J[i].val = Vt*(p1[i].val*bm[i]-p2[i].val*bp[i])/h[i];
+      for(unsigned int k=0; k<N; ++k)
+        J[i].adval[k] = dJ_dV*dVv[i].adval[k] + dJ_dp1*p1[i].adval[k] + dJ_dp2*p2[i].adval[k];
+    }
+  }
+}
+
 
 inline PetscScalar In_uw(PetscScalar ,PetscScalar dVc,PetscScalar n1,PetscScalar n2,PetscScalar h)
 {
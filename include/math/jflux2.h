@@ -76,15 +76,26 @@ inline Real In_lt(Real kb,Real e,Real dV,Real n1,Real n2,Real T, Real dT,Real h)
   return (E*n + Vt*dndx + kb*n/e*dT/h);
 }
 
+template <unsigned int N>
+inline FixedDScalar<N> In_lt(Real kb,Real e, const FixedDScalar<N> &dV, const FixedDScalar<N> &n1, const FixedDScalar<N> &n2,
+                             const FixedDScalar<N> &T, const FixedDScalar<N> &dT, Real h)
+{
+  FixedDScalar<N> E  = -dV/h;
+  FixedDScalar<N> Vt = kb*T/e;
+  FixedDScalar<N> alpha = -dV/(2*Vt)+ dT/(2*T);
+  FixedDScalar<N> n  = n1*aux2(alpha) + n2*aux2(-alpha);
+  FixedDScalar<N> dndx = aux1(alpha)*(n2-n1)/h;
+  return (E*n + Vt*dndx + kb*n/e*dT/h);
+}
+
+// evaluate with respect to the 5 arguments by FixedDScalar, then apply the chain rule
 inline AutoDScalar In_lt(Real kb,Real e, const AutoDScalar &dV, const AutoDScalar &n1, const AutoDScalar &n2,
                       const AutoDScalar &T, const AutoDScalar &dT, Real h)
 {
-  AutoDScalar E  = -dV/h;
-  AutoDScalar Vt = kb*T/e;
-  AutoDScalar alpha = -dV/(2*Vt)+ dT/(2*T);
-  AutoDScalar n  = n1*aux2(alpha) + n2*aux2(-alpha);
-  AutoDScalar dndx = aux1(alpha)*(n2-n1)/h;
-  return (E*n + Vt*dndx + kb*n/e*dT/h);
+  const AutoDScalar * arg[5] = {&dV, &n1, &n2, &T, &dT};
+  FixedDScalar<5> J = In_lt(kb, e, FixedDScalar<5>(dV.getValue(), 0), FixedDScalar<5>(n1.getValue(), 1), FixedDScalar<5>(n2.getValue(), 2),
+                            FixedDScalar<5>(T.getValue(), 3), FixedDScalar<5>(dT.getValue(), 4), h);
+  return chain(J, arg);
 }
 
 
@@ -101,15 +112,26 @@ inline Real Ip_lt(Real kb,Real e,Real dV,Real p1,Real p2,Real T, Real dT,Real h)
   return (E*p-Vt*dpdx - kb*p/e*dT/h);
 }
 
+template <unsigned int N>
+inline FixedDScalar<N> Ip_lt(Real kb,Real e, const FixedDScalar<N> &dV, const FixedDScalar<N> &p1, const FixedDScalar<N> &p2,
+                             const FixedDScalar<N> &T, const FixedDScalar<N> &dT,Real h)
+{
+  FixedDScalar<N> E  = -dV/h;
+  FixedDScalar<N> Vt = kb*T/e;
+  FixedDScalar<N> alpha = -dV/(2*Vt)- dT/(2*T);
+  FixedDScalar<N> p  = p1*aux2(-alpha) + p2*aux2(alpha);
+  FixedDScalar<N> dpdx = aux1(alpha)*(p2-p1)/h;
+  return (E*p-Vt*dpdx - kb*p/e*dT/h);
+}
+
+// evaluate with respect to the 5 arguments by FixedDScalar, then apply the chain rule
 inline AutoDScalar Ip_lt(Real kb,Real e, const AutoDScalar &dV, const AutoDScalar &p1, const AutoDScalar &p2,
                       const AutoDScalar &T, const AutoDScalar &dT,Real h)
 {
-  AutoDScalar E  = -dV/h;
-  AutoDScalar Vt = kb*T/e;
-  AutoDScalar alpha = -dV/(2*Vt)- dT/(2*T);
-  AutoDScalar p  = p1*aux2(-alpha) + p2*aux2(alpha);
-  AutoDScalar dpdx = aux1(alpha)*(p2-p1)/h;
-  return (E*p-Vt*dpdx - kb*p/e*dT/h);
+  const AutoDScalar * arg[5] = {&dV, &p1, &p2, &T, &dT};
+  FixedDScalar<5> J = Ip_lt(kb, e, FixedDScalar<5>(dV.getValue(), 0), FixedDScalar<5>(p1.getValue(), 1), FixedDScalar<5>(p2.getValue(), 2),
+                            FixedDScalar<5>(T.getValue(), 3), FixedDScalar<5>(dT.getValue(), 4), h);
+  return chain(J, arg);
 }
 
 
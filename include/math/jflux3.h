@@ -52,6 +52,15 @@ inline AutoDScalar Theta(const AutoDScalar &T1, const AutoDScalar &T2)
         else
                 return T1/(1-0.5*x);
 }
+template <unsigned int N>
+inline FixedDScalar<N> Theta(const FixedDScalar<N> &T1, const FixedDScalar<N> &T2)
+{
+        FixedDScalar<N> x = T2/T1-1;
+        if(fabs(x)>1e-6)
+                return (T2-T1)/log(fabs(T2/T1));
+        else
+                return T1/(1-0.5*x);
+}
 
 //-----------------------------------------------------------------------------
 // FIXME I am very afraid about float exception of exp operator here.
@@ -118,12 +127,24 @@ inline Real In_eb(Real kb, Real e,  Real V1,  Real V2,
   return kb*0.5*(Tn1+Tn2)*theta*(bern(alpha)*n2/Tn2 - bern(-alpha)*n1/Tn1)/h;
 }
 
+template <unsigned int N>
+inline FixedDScalar<N> In_eb(Real kb, Real e, const FixedDScalar<N> &V1, const FixedDScalar<N> &V2,
+                         const FixedDScalar<N> &n1,const FixedDScalar<N> &n2, const FixedDScalar<N> &Tn1,const FixedDScalar<N> &Tn2, Real h)
+{
+  FixedDScalar<N> theta = Theta(Tn1,Tn2);
+  FixedDScalar<N> alpha = (e/kb*(V2-V1)-2*(Tn2-Tn1))/theta;
+  return kb*0.5*(Tn1+Tn2)*theta*(bern(alpha)*n2/Tn2 - bern(-alpha)*n1/Tn1)/h;
+}
+
+// evaluate with respect to the 6 arguments by FixedDScalar, then apply the chain rule
 inline AutoDScalar In_eb(Real kb, Real e, const AutoDScalar &V1, const AutoDScalar &V2,
                          const AutoDScalar &n1,const AutoDScalar &n2, const AutoDScalar &Tn1,const AutoDScalar &Tn2, Real h)
 {
-  AutoDScalar theta = Theta(Tn1,Tn2);
-  AutoDScalar alpha = (e/kb*(V2-V1)-2*(Tn2-Tn1))/theta;
-  return kb*0.5*(Tn1+Tn2)*theta*(bern(alpha)*n2/Tn2 - bern(-alpha)*n1/Tn1)/h;
+  const AutoDScalar * arg[6] = {&V1, &V2, &n1, &n2, &Tn1, &Tn2};
+  FixedDScalar<6> J = In_eb(kb, e, FixedDScalar<6>(V1.getValue(), 0), FixedDScalar<6>(V2.getValue(), 1),
+                            FixedDScalar<6>(n1.getValue(), 2), FixedDScalar<6>(n2.getValue(), 3),
+                            FixedDScalar<6>(Tn1.getValue(), 4), FixedDScalar<6>(Tn2.getValue(), 5), h);
+  return chain(J, arg);
 }
 
 
@@ -138,12 +159,24 @@ inline Real Ip_eb(Real kb, Real e,  Real V1,  Real V2,
   return kb*0.5*(Tp1+Tp2)*theta*(bern(alpha)*p1/Tp1 - bern(-alpha)*p2/Tp2)/h;
 }
 
+template <unsigned int N>
+inline FixedDScalar<N> Ip_eb(Real kb, Real e, const FixedDScalar<N> &V1, const FixedDScalar<N> &V2,
+                         const FixedDScalar<N> &p1,const FixedDScalar<N> &p2, const FixedDScalar<N> &Tp1,const FixedDScalar<N> &Tp2, Real h)
+{
+  FixedDScalar<N> theta = Theta(Tp1,Tp2);
+  FixedDScalar<N> alpha = (e/kb*(V2-V1)+2*(Tp2-Tp1))/theta;
+  return kb*0.5*(Tp1+Tp2)*theta*(bern(alpha)*p1/Tp1 - bern(-alpha)*p2/Tp2)/h;
+}
+
+// evaluate with respect to the 6 arguments by FixedDScalar, then apply the chain rule
 inline AutoDScalar Ip_eb(Real kb, Real e, const AutoDScalar &V1, const AutoDScalar &V2,
                          const AutoDScalar &p1,const AutoDScalar &p2, const AutoDScalar &Tp1,const AutoDScalar &Tp2, Real h)
 {
-  AutoDScalar theta = Theta(Tp1,Tp2);
-  AutoDScalar alpha = (e/kb*(V2-V1)+2*(Tp2-Tp1))/theta;
-  return kb*0.5*(Tp1+Tp2)*theta*(bern(alpha)*p1/Tp1 - bern(-alpha)*p2/Tp2)/h;
+  const AutoDScalar * arg[6] = {&V1, &V2, &p1, &p2, &Tp1, &Tp2};
+  FixedDScalar<6> J = Ip_eb(kb, e, FixedDScalar<6>(V1.getValue(), 0), FixedDScalar<6>(V2.getValue(), 1),
+                            FixedDScalar<6>(p1.getValue(), 2), FixedDScalar<6>(p2.getValue(), 3),
+                            FixedDScalar<6>(Tp1.getValue(), 4), FixedDScalar<6>(Tp2.getValue(), 5), h);
+  return chain(J, arg);
 }
 
 
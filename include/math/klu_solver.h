@@ -0,0 +1,110 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#ifndef __klu_solver_h__
+#define __klu_solver_h__
+
+#include <vector>
+
+#include "genius_petsc.h"
+#include "petscpc.h"
+#include "klu.h"
+
+
+/**
+ * sparse direct solver built on the KLU library shipped in contrib.
+ * it is hooked into PETSc as a shell preconditioner, together with KSPPREONLY
+ * it acts as a direct solver on any PETSc build without external packages.
+ *
+ * the fill reducing ordering (symbolic analysis) is kept as long as the
+ * nonzero pattern of the matrix does not change, then only the numerical
+ * refactorization is done, which reuses the pivot sequence of last factorization.
+ *
+ * the matrix should be a sequential one, i.e. serial run only.
+ */
+class KLUSolver
+{
+public:
+
+  KLUSolver();
+
+  ~KLUSolver();
+
+  /**
+   * set \p pc to be a shell preconditioner which calls this solver
+   */
+  void attach(PC pc);
+
+  /**
+   * factorize matrix \p A, the symbolic analysis is reused when possible
+   */
+  PetscErrorCode setup(Mat A);
+
+  /**
+   * solve A x = b with the factorization
+   */
+  PetscErrorCode solve(Vec b, Vec x);
+
+  /**
+   * free symbolic and numeric factorization
+   */
+  void clear();
+
+private:
+
+  /**
+   * KLU control parameters and statistics
+   */
+  klu_common _common;
+
+  /**
+   * the ordering of the matrix, computed by klu_analyze
+   */
+  klu_symbolic * _symbolic;
+
+  /**
+   * LU factors
+   */
+  klu_numeric * _numeric;
+
+  /**
+   * CSR structure of the matrix. KLU takes compressed column format,
+   * we factorize A^T and call klu_tsolve in solve()
+   */
+  std::vector<int> _row_ptr;
+  std::vector<int> _col_idx;
+  std::vector<double> _values;
+
+  /**
+   * fetch CSR of matrix \p A, return true if the nonzero pattern is the same as before
+   */
+  bool _extract(Mat A);
+
+  /**
+   * the minimal min(|diag(U)|)/max(|diag(U)|) accepted after klu_refactor,
+   * below it the old pivot sequence is dropped and a full factorization is done
+   */
+  static const double _rcond_tol;
+};
+
+
+#endif
@@ -13,6 +13,7 @@
 #endif
 
 #include "adolc.h"
+#include "adfixed.h"
 using namespace adtl;
 
 /* define the constant */
@@ -143,6 +144,13 @@ inline double pd1bern ( double x )
 } /* pd1bern */
 
 
+template <unsigned int N>
+inline FixedDScalar<N> bern ( const FixedDScalar<N> &x )
+{
+  return chain_unary(x, bern(x.getValue()), pd1bern(x.getValue()));
+} /* bern */
+
+
 /* ----------------------------------------------------------------------------
  * aux1:  This function returns the aux1 function.  To avoid under and over-
  * flows this function is defined by equivalent or approximate functions
@@ -211,6 +219,13 @@ inline AutoDScalar aux1 ( const AutoDScalar &x )
 } /* aux1 */
 
 
+template <unsigned int N>
+inline FixedDScalar<N> aux1 ( const FixedDScalar<N> &x )
+{
+  return chain_unary(x, aux1(x.getValue()), pd1aux1(x.getValue()));
+} /* aux1 */
+
+
 
 /* ----------------------------------------------------------------------------
  * aux2:  This function returns the aux2 function.  To avoid under and over-
@@ -271,6 +286,159 @@ inline AutoDScalar aux2 ( const AutoDScalar &x )
 } /* aux2 */
 
 
+template <unsigned int N>
+inline FixedDScalar<N> aux2 ( const FixedDScalar<N> &x )
+{
+  return chain_unary(x, aux2(x.getValue()), pd1aux2(x.getValue()));
+} /* aux2 */
+
+
+/* ----------------------------------------------------------------------------
+ * batched evaluation of the Bernoulli function and its derivative.
+ * the range limits and formulas are the same as the scalar version above, but
+ * the range is selected by conditional assignment instead of branches, and both
+ * B(x) and B(-x) are built from one exp(-|x|), which never overflows. exp(-|x|)
+ * is evaluated by exp_neg_abs() instead of libm, so the whole batch is an explicit
+ * "omp simd" loop (enabled by -fopenmp-simd, see wscript).
+ * exp_neg_abs() is within 1 ulp of libm exp(), thus the results are not bitwise
+ * identical to bern() and pd1bern(), but have the same error bound against the
+ * exact value, which is dominated by the cancellation of 1-exp(-|x|) near the
+ * series range.
+ * --------------------------------------------------------------------------*/
+
+// the candidates of the selection are only used in one arm, gcc sinks them into
+// it and then refuses to if-convert the loop because they may trap. they never
+// raise FE_INVALID, so the kernels are built without trapping math, which does
+// not change the results
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__INTEL_COMPILER)
+#pragma GCC push_options
+#pragma GCC optimize ("no-trapping-math")
+#endif
+
+/**
+ * exp(-|x|) by Cody-Waite range reduction and Taylor polynomial, no libm call,
+ * so a loop of it can be vectorized. within 1 ulp of libm exp(), and within 1
+ * denormal unit when the result is below DBL_MIN
+ */
+inline double exp_neg_abs ( double x )
+{
+  union { double d; long long i; } kbits, scale;
+
+  // exp(-a), a is clamped where the result underflows to 0
+  double a = fabs(x);
+  a = a < 746.0 ? a : 746.0;
+
+  // a = kd*ln2 - r with |r| <= ln2/2, kd is rounded to integer by the magic number 1.5*2^52.
+  // ln2 is split into a high part with trailing zero bits, thus kd*ln2_hi is exact
+  const double magic = 6755399441055744.0;
+  const double kd = a*1.44269504088896340736 + magic - magic;
+  const double r = (kd*6.93147180369123816490e-01 - a) + kd*1.90821492927058770002e-10;
+
+  // exp(r), truncation error of the series to r^13/13! is below 2^-53 for |r| <= ln2/2
+  double p = 1.0/6227020800.0;
+  p = p*r + 1.0/479001600.0;
+  p = p*r + 1.0/39916800.0;
+  p = p*r + 1.0/3628800.0;
+  p = p*r + 1.0/362880.0;
+  p = p*r + 1.0/40320.0;
+  p = p*r + 1.0/5040.0;
+  p = p*r + 1.0/720.0;
+  p = p*r + 1.0/120.0;
+  p = p*r + 1.0/24.0;
+  p = p*r + 1.0/6.0;
+  p = p*r + 0.5;
+  p = p*r + 1.0;
+  p = p*r + 1.0;
+
+  // scale by 2^-kd, the exponent bits are built from the integer in the low mantissa bits of kd+magic.
+  // 2^-kd is not normal for kd > 1022, then scale by 2^(64-kd) and 2^-64
+  const bool tiny = kd > 1000.0;
+  kbits.d = (tiny ? kd - 64.0 : kd) + magic;
+  scale.i = (1023LL - (kbits.i - 0x4338000000000000LL)) << 52;
+  return p*scale.d*(tiny ? 5.42101086242752217004e-20 : 1.0);
+}
+
+/**
+ * branch free bern(x), \p t = exp(-|x|) is given by caller.
+ * all the candidates are computed and then selected, so the loop
+ * has no branch
+ */
+inline double bern_select ( double x, double t )
+{
+  const bool negative = x < 0.0;
+  const bool series = (x >= BP1_BERN) & (x <= BP2_BERN);
+  const double xt = x*t;
+  const double tm = t - 1.0;
+  const double tp = 1.0 - t;
+  const double sv = 1.0 - x/2.0 * (1.0 - x/6.0 * (1.0 - x*x/60.0));
+  const double num = negative ? x : xt;
+  const double den = series ? 1.0 : (negative ? tm : (x < BP3_BERN ? tp : 1.0));
+  const double r = num/den;
+  double y = series ? sv : r;
+  y = x <= BP0_BERN ? -x : y;
+  y = x >= BP4_BERN ? 0.0 : y;
+  return y;
+}
+
+/**
+ * branch free pd1bern(x), \p t = exp(-|x|) is given by caller
+ */
+inline double pd1bern_select ( double x, double t )
+{
+  const bool negative = x < 0.0;
+  const bool series = (x >= BP2_DBERN) & (x <= BP3_DBERN);
+  const double u = (1.0 - x)*t;
+  const double um = u - 1.0;
+  const double ut = u - t*t;
+  const double z = 1.0 - t;
+  const double zz = z*z;
+  const double sv = -0.5 + x/6.0 * (1.0 - x*x/30.0);
+  const double num = negative ? um : ut;
+  const double den = (series | (x <= BP1_DBERN) | (x >= BP4_DBERN)) ? 1.0 : zz;
+  const double r = num/den;
+  double y = series ? sv : r;
+  y = x <= BP0_DBERN ? -1.0 : y;
+  y = x >= BP5_DBERN ? 0.0 : y;
+  return y;
+}
+
+/**
+ * yp[i] = bern(x[i]) and ym[i] = bern(-x[i]), i=0..n-1,
+ * both share the same exponential
+ */
+inline void bern_pair_batch ( unsigned int n, const double * x, double * yp, double * ym )
+{
+#pragma omp simd
+  for(unsigned int i=0; i<n; ++i)
+  {
+    const double t = exp_neg_abs(x[i]);
+    yp[i] = bern_select(x[i], t);
+    ym[i] = bern_select(-x[i], t);
+  }
+}
+
+/**
+ * bern(x[i]), bern(-x[i]) and their derivatives pd1bern(x[i]), pd1bern(-x[i]),
+ * i=0..n-1, all of them share the same exponential
+ */
+inline void bern_pd1bern_pair_batch ( unsigned int n, const double * x, double * yp, double * ym, double * dyp, double * dym )
+{
+#pragma omp simd
+  for(unsigned int i=0; i<n; ++i)
+  {
+    const double t = exp_neg_abs(x[i]);
+    yp[i]  = bern_select(x[i], t);
+    ym[i]  = bern_select(-x[i], t);
+    dyp[i] = pd1bern_select(x[i], t);
+    dym[i] = pd1bern_select(-x[i], t);
+  }
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__INTEL_COMPILER)
+#pragma GCC pop_options
+#endif
+
+
 /* ----------------------------------------------------------------------------
  * pd1erf:  This function returns the derivative of the error function with
  * respect to the first variable.
@@ -168,6 +168,13 @@ public:
                 int n, const int * cols, 
                 const T* dm);
 
+  /**
+   * Add a row to the Sparse matrix, by \p slots in frozen mode
+   */
+  void add_row (unsigned int row,
+                int n, const int * cols, const int * slots,
+                const T* dm);
+
   /**
    * Add the full matrix to the
    * Petsc matrix.  This is useful
@@ -196,6 +203,35 @@ public:
                       const std::vector<int> &dst_rows);
 
                                 
+  /**
+   * when set, the nonzero pattern is frozen after the first assembly.
+   * later assemblies add into a flat CSR value array and hand it to PETSc
+   * without going through the map buffer or per entry MatSetValues
+   */
+  void freeze_nonzero_pattern (bool freeze) { _mat_frozen_enabled = freeze; }
+
+  /**
+   * @return the id of current frozen nonzero pattern, 0 when not in frozen mode
+   */
+  unsigned int pattern_id () const { return _mat_frozen_mode ? _csr_pattern_id : 0; }
+
+  /**
+   * @return the slot of entry (i,j) in frozen CSR pattern, -1 for not found
+   */
+  int slot (const unsigned int i, const unsigned int j) const;
+
+  /**
+   * store the matrix in block sparse (BAIJ) format with block size \p bs.
+   * local rows should be a multiple of \p bs, and it should be called
+   * before the first assembly
+   */
+  void set_block_size (unsigned int bs);
+
+  /**
+   * @return the block size of the matrix
+   */
+  unsigned int block_size () const { return _block_size; }
+
   /**
    * clear the given row and fill diag with given value
    */
@@ -265,11 +301,106 @@ public:
    */
   Mat mat () { return _mat; }
 
-
 private:
   
   bool _mat_buf_mode;
 
+  /**
+   * use frozen CSR storage after first flush_buf
+   */
+  bool _mat_frozen_enabled;
+
+  /**
+   * the matrix is in frozen CSR mode now
+   */
+  bool _mat_frozen_mode;
+
+  /**
+   * CSR row pointer of frozen pattern, in local row index
+   */
+  std::vector<unsigned int> _csr_row_ptr;
+
+  /**
+   * CSR column index (global, sorted in each row) of frozen pattern
+   */
+  std::vector<PetscInt> _csr_cols;
+
+  /**
+   * CSR values of frozen pattern
+   */
+  std::vector<T> _csr_values;
+
+  /**
+   * block size of BAIJ storage, 1 for AIJ
+   */
+  unsigned int _block_size;
+
+  /**
+   * block CSR row pointer of frozen pattern, in local block row index.
+   * only used when _block_size > 1, the scalar CSR pattern is expanded
+   * to full blocks then, so each block row is a dense row major array
+   */
+  std::vector<unsigned int> _bcsr_row_ptr;
+
+  /**
+   * block CSR column index (global block column) of frozen pattern
+   */
+  std::vector<PetscInt> _bcsr_cols;
+
+  /**
+   * number of entries fall out of frozen pattern,
+   * they are buffered in _mat_local and merged into pattern at next flush
+   */
+  unsigned int _csr_n_spill;
+
+  /**
+   * PETSc matrix has exactly the same nonzero pattern as CSR arrays
+   */
+  bool _csr_pattern_synced;
+
+  /**
+   * the SeqAIJ storage of PETSc matrix is verified to match the CSR arrays
+   * after the pattern was synced, so the values can be copied directly
+   */
+  bool _csr_raw_copy;
+
+  /**
+   * id of current frozen pattern, unique among all the matrices
+   */
+  unsigned int _csr_pattern_id;
+
+  /**
+   * counter to generate pattern id
+   */
+  static unsigned int _csr_pattern_counter;
+
+  /**
+   * check the nonzero number and the columns of each row of
+   * PETSc SeqAIJ matrix against the CSR arrays
+   */
+  bool _check_csr_pattern() const;
+
+  /**
+   * get the slot of (local_row, col) in frozen CSR pattern, -1 for not found
+   */
+  int _csr_slot(unsigned int local_row, unsigned int col) const;
+
+  /**
+   * reference to the local buffer entry of (local_row, col)
+   * works in both map buffer and frozen CSR mode
+   */
+  T & _local_entry(unsigned int local_row, unsigned int col);
+
+  /**
+   * build frozen CSR pattern from map buffer _mat_local
+   */
+  void _build_csr_pattern();
+
+  /**
+   * copy frozen CSR values to PETSc matrix
+   */
+  void flush_csr();
+
   /**
    * matrix data type to store local values
    */
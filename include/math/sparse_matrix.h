@@ -107,6 +107,27 @@ public:
    */
   virtual void get_nonzero_pattern (std::vector< std::vector<int> > & nz) {}
 
+
+  /**
+   * freeze the nonzero pattern after the first assembly. When your
+   * \p SparseMatrix<T> implementation does not support this feature simply do
+   * not overload this method.
+   */
+  virtual void freeze_nonzero_pattern (bool ) {}
+
+  /**
+   * @return the id of current frozen nonzero pattern, it changes each time the
+   * pattern is (re)built, and 0 means no frozen pattern. the slots returned by
+   * slot() keep valid as long as the id keeps the same
+   */
+  virtual unsigned int pattern_id () const { return 0; }
+
+  /**
+   * @return the position of entry \p (i,j) in the frozen nonzero pattern,
+   * -1 when the entry is out of the pattern or \p i is not a local row
+   */
+  virtual int slot (const unsigned int , const unsigned int ) const { return -1; }
+
   
   /**
    * Initialize a Sparse matrix
@@ -214,6 +235,16 @@ public:
                         int n, const int * cols, 
                         const T* dm) = 0;
 
+  /**
+   * Add a row to the Sparse matrix. \p slots are the positions of the
+   * entries got from slot(), all of them should be valid. the matrix
+   * may add by slots instead of searching the columns. \p slots can be NULL.
+   */
+  virtual void add_row (unsigned int row,
+                        int n, const int * cols, const int * slots,
+                        const T* dm)
+  { this->add_row(row, n, cols, dm); }
+
   /**
    * Add the full matrix to the
    * Sparse matrix.  This is useful
@@ -321,6 +352,17 @@ public:
 
 protected:
 
+  /**
+   * Constructor; the matrix shares the row/column layout of \p layout.
+   * Unlike the public constructor, no communication is involved,
+   * so it is safe to build such matrix in a thread.
+   */
+  SparseMatrix (const SparseMatrix<T> * layout)
+    :_m_global(layout->_m_global), _n_global(layout->_n_global),
+     _m_local(layout->_m_local), _n_local(layout->_n_local),
+     _global_offset(layout->_global_offset), _is_initialized(false)
+  {}
+
   /**
    * global row size
    */
@@ -40,6 +40,7 @@ class SurfaceLocatorHub;
 // Local Includes -----------------------------------
 #include "genius_common.h"
 #include "enum_elem_type.h"
+#include "enum_mesh_reorder.h"
 #include "variant_filter_iterator.h"
 #include "multi_predicates.h"
 #include "auto_ptr.h"
@@ -405,6 +406,15 @@ public:
   virtual bool reorder_nodes (std::string &) { return true; }
 
 
+  /**
+   * renumber the nodes and elems by given method, the nodes
+   * are renumbered by the method and elems follow the nodes.
+   * should be called before partition. return false with
+   * error message in \p err when failed
+   */
+  virtual bool reorder (MeshReorderType, std::string &) { return true; }
+
+
   /**
    * Locate element face (edge in 2D) neighbors.  This is done with the help
    * of a \p std::map that functions like a hash table.  When this function is
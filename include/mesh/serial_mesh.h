@@ -211,6 +211,12 @@ class SerialMesh : public UnstructuredMesh
    */
   virtual bool reorder_nodes (std::string &err);
 
+  /**
+   * renumber nodes by RCM, space filling curve or nested dissection,
+   * elems are sorted by their smallest new node index
+   */
+  virtual bool reorder (MeshReorderType type, std::string &err);
+
   /**
    * generate all boundary elem-side pair with given boundary id
    */
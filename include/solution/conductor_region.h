@@ -209,6 +209,16 @@ public:
    */
   virtual void DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag);
 
+  /**
+   * build function and its jacobian for L1 DDM in one pass
+   */
+  virtual void DDM1_Function_Jacobian(PetscScalar * x, Vec f, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag);
+
+  /**
+   * electrode region has a single-pass DDM1 function/jacobian kernel
+   */
+  virtual bool DDM1_Fused_Kernel() const { return true; }
+
   /**
    * build time derivative term and its jacobian for L1 DDM, do nothing here
    */
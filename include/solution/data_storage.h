@@ -26,6 +26,7 @@
 #include "enum_data_type.h"
 #include "vector_value.h"
 #include "tensor_value.h"
+#include "checkpoint_file.h"
 
 class DataStorage
 {
@@ -328,6 +329,107 @@ public:
   template <typename T>
   const T & data(const unsigned int , const unsigned int ) const;
 
+  /**
+   * write all the data blocks to checkpoint file
+   */
+  void checkpoint(CheckpointWriter & out) const
+  {
+    out.write_value<unsigned int>(_size);
+
+    out.write_value<unsigned int>(_scalar_fill.size());
+    for(unsigned int n=0; n<_scalar_fill.size(); ++n)
+    {
+      out.write_value<char>(_scalar_fill[n]);
+      if( _scalar_fill[n] ) out.write_vector(_scalar_block[n]);
+    }
+
+    out.write_value<unsigned int>(_complex_fill.size());
+    for(unsigned int n=0; n<_complex_fill.size(); ++n)
+    {
+      out.write_value<char>(_complex_fill[n]);
+      if( _complex_fill[n] ) out.write_vector(_complex_block[n]);
+    }
+
+    // vector and tensor values are written component by component
+    std::vector<PetscScalar> buffer;
+
+    out.write_value<unsigned int>(_vector_fill.size());
+    for(unsigned int n=0; n<_vector_fill.size(); ++n)
+    {
+      out.write_value<char>(_vector_fill[n]);
+      if( !_vector_fill[n] ) continue;
+      buffer.resize(3*_size);
+      for(unsigned int i=0; i<_size; ++i)
+        for(unsigned int d=0; d<3; ++d)
+          buffer[3*i+d] = _vector_block[n][i](d);
+      out.write_vector(buffer);
+    }
+
+    out.write_value<unsigned int>(_tensor_fill.size());
+    for(unsigned int n=0; n<_tensor_fill.size(); ++n)
+    {
+      out.write_value<char>(_tensor_fill[n]);
+      if( !_tensor_fill[n] ) continue;
+      buffer.resize(9*_size);
+      for(unsigned int i=0; i<_size; ++i)
+        for(unsigned int d=0; d<9; ++d)
+          buffer[9*i+d] = _tensor_block[n][i](d/3, d%3);
+      out.write_vector(buffer);
+    }
+  }
+
+  /**
+   * read all the data blocks from checkpoint file.
+   * the size and variables should be the same as the checkpoint
+   * @return false when layout mismatch
+   */
+  bool restart(CheckpointReader & in)
+  {
+    if( in.read_value<unsigned int>() != _size ) return false;
+
+    if( in.read_value<unsigned int>() != _scalar_fill.size() ) return false;
+    for(unsigned int n=0; n<_scalar_fill.size(); ++n)
+    {
+      if( in.read_value<char>() != static_cast<char>(_scalar_fill[n]) ) return false;
+      if( _scalar_fill[n] && !in.read_array(_scalar_block[n]) ) return false;
+    }
+
+    if( in.read_value<unsigned int>() != _complex_fill.size() ) return false;
+    for(unsigned int n=0; n<_complex_fill.size(); ++n)
+    {
+      if( in.read_value<char>() != static_cast<char>(_complex_fill[n]) ) return false;
+      if( _complex_fill[n] && !in.read_array(_complex_block[n]) ) return false;
+    }
+
+    std::vector<PetscScalar> buffer;
+
+    if( in.read_value<unsigned int>() != _vector_fill.size() ) return false;
+    for(unsigned int n=0; n<_vector_fill.size(); ++n)
+    {
+      if( in.read_value<char>() != static_cast<char>(_vector_fill[n]) ) return false;
+      if( !_vector_fill[n] ) continue;
+      buffer.resize(3*_size);
+      if( !in.read_array(buffer) ) return false;
+      for(unsigned int i=0; i<_size; ++i)
+        for(unsigned int d=0; d<3; ++d)
+          _vector_block[n][i](d) = buffer[3*i+d];
+    }
+
+    if( in.read_value<unsigned int>() != _tensor_fill.size() ) return false;
+    for(unsigned int n=0; n<_tensor_fill.size(); ++n)
+    {
+      if( in.read_value<char>() != static_cast<char>(_tensor_fill[n]) ) return false;
+      if( !_tensor_fill[n] ) continue;
+      buffer.resize(9*_size);
+      if( !in.read_array(buffer) ) return false;
+      for(unsigned int i=0; i<_size; ++i)
+        for(unsigned int d=0; d<9; ++d)
+          _tensor_block[n][i](d/3, d%3) = buffer[9*i+d];
+    }
+
+    return in.good();
+  }
+
   /**
    * approx memory usage
    */
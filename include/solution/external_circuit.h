@@ -31,6 +31,8 @@
 
 
 namespace Parser{ class Card; }
+class CheckpointWriter;
+class CheckpointReader;
 
 
 /**
@@ -292,6 +294,16 @@ public:
     _current_old = _current;
   }
 
+  /**
+   * write the state of circuit to checkpoint file
+   */
+  virtual void checkpoint(CheckpointWriter & out) const;
+
+  /**
+   * read the state of circuit from checkpoint file
+   */
+  virtual void restart(CheckpointReader & in);
+
 
 protected:
   /**
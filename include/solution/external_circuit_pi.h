@@ -193,6 +193,16 @@ public:
    */
   virtual void tran_op_init();
 
+  /**
+   * write the state of circuit to checkpoint file
+   */
+  virtual void checkpoint(CheckpointWriter & out) const;
+
+  /**
+   * read the state of circuit from checkpoint file
+   */
+  virtual void restart(CheckpointReader & in);
+
 private:
 
   Real _r_app;
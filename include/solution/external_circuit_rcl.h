@@ -177,6 +177,16 @@ public:
     _cap_current = _cap_current_old = 0.0;
   }
 
+  /**
+   * write the state of circuit to checkpoint file
+   */
+  virtual void checkpoint(CheckpointWriter & out) const;
+
+  /**
+   * read the state of circuit from checkpoint file
+   */
+  virtual void restart(CheckpointReader & in);
+
 private:
 
   Real _res;
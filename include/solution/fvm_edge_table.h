@@ -0,0 +1,142 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#ifndef __fvm_edge_table_h__
+#define __fvm_edge_table_h__
+
+#include <vector>
+#include <cstddef>
+
+
+/**
+ * flat edge table of a region in struct of arrays form, for FVM flux kernels.
+ *
+ * region part is indexed by the edge index of SimulationRegion::edges_begin(),
+ * the two nodes are ordered as id(1) < id(2).
+ * element part is indexed by elem_edge_begin[nelem] + ne, where nelem is the
+ * index of element in region and ne is the local edge index of the element.
+ *
+ * the dof offsets are filled after the dof map of solver is built, the kernels
+ * then read contiguous arrays instead of Elem/FVM_Node pointer chains.
+ */
+struct FVM_EdgeTable
+{
+  //------------------------------------------------------
+  // region edges
+
+  /// local offset of node 1/2 in the local (scattered) solution array
+  std::vector<unsigned int> n1_local_offset;
+  std::vector<unsigned int> n2_local_offset;
+
+  /// global offset of node 1/2 in the petsc vector/matrix
+  std::vector<unsigned int> n1_global_offset;
+  std::vector<unsigned int> n2_global_offset;
+
+  /// node 1/2 is on processor, ghost nodes are not
+  std::vector<char> n1_on_processor;
+  std::vector<char> n2_on_processor;
+
+  /// distance between the two nodes
+  std::vector<double> length;
+
+  /// control volume surface area between the two nodes, summed over all the cells share the edge
+  std::vector<double> cv_area;
+
+  /// control volume associated with the edge, summed over all the cells share the edge
+  std::vector<double> cv_volume;
+
+  //------------------------------------------------------
+  // element edges
+
+  /// the first slot of each element, n_cell()+1 entries
+  std::vector<unsigned int> elem_edge_begin;
+
+  /// index of the region edge
+  std::vector<unsigned int> elem_edge;
+
+  /// node order of element edge is inverse to the region edge
+  std::vector<char> elem_edge_inverse;
+
+  /// partial area/volume of the cell associated with the edge
+  std::vector<double> partial_area;
+  std::vector<double> partial_volume;
+
+  /// truncated partial area/volume, to avoid negative values due to bad mesh element
+  std::vector<double> truncated_partial_area;
+  std::vector<double> truncated_partial_volume;
+
+
+  /**
+   * @return number of region edges
+   */
+  unsigned int n_edges() const { return length.size(); }
+
+  /**
+   * @return the slot of the \p ne-th edge of the \p nelem-th element
+   */
+  unsigned int elem_slot(unsigned int nelem, unsigned int ne) const
+  { return elem_edge_begin[nelem] + ne; }
+
+  /**
+   * free all the memory
+   */
+  void clear()
+  {
+    std::vector<unsigned int>().swap(n1_local_offset);
+    std::vector<unsigned int>().swap(n2_local_offset);
+    std::vector<unsigned int>().swap(n1_global_offset);
+    std::vector<unsigned int>().swap(n2_global_offset);
+    std::vector<char>().swap(n1_on_processor);
+    std::vector<char>().swap(n2_on_processor);
+    std::vector<double>().swap(length);
+    std::vector<double>().swap(cv_area);
+    std::vector<double>().swap(cv_volume);
+
+    std::vector<unsigned int>().swap(elem_edge_begin);
+    std::vector<unsigned int>().swap(elem_edge);
+    std::vector<char>().swap(elem_edge_inverse);
+    std::vector<double>().swap(partial_area);
+    std::vector<double>().swap(partial_volume);
+    std::vector<double>().swap(truncated_partial_area);
+    std::vector<double>().swap(truncated_partial_volume);
+  }
+
+  /**
+   * @return the memory used by the table
+   */
+  size_t memory_size() const
+  {
+    size_t counter = 0;
+    counter += (n1_local_offset.capacity() + n2_local_offset.capacity())*sizeof(unsigned int);
+    counter += (n1_global_offset.capacity() + n2_global_offset.capacity())*sizeof(unsigned int);
+    counter += (n1_on_processor.capacity() + n2_on_processor.capacity())*sizeof(char);
+    counter += (length.capacity() + cv_area.capacity() + cv_volume.capacity())*sizeof(double);
+    counter += (elem_edge_begin.capacity() + elem_edge.capacity())*sizeof(unsigned int);
+    counter += elem_edge_inverse.capacity()*sizeof(char);
+    counter += (partial_area.capacity() + partial_volume.capacity())*sizeof(double);
+    counter += (truncated_partial_area.capacity() + truncated_partial_volume.capacity())*sizeof(double);
+    return counter;
+  }
+};
+
+
+#endif // __fvm_edge_table_h__
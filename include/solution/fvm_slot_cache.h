@@ -0,0 +1,114 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#ifndef __fvm_slot_cache_h__
+#define __fvm_slot_cache_h__
+
+#include <vector>
+
+#include "genius_petsc.h"
+#include "sparse_matrix.h"
+
+
+/**
+ * slots of the jacobian entries added by a region kernel, in the frozen
+ * nonzero pattern of the jacobian matrix. each item (an edge, a cell or a node)
+ * adds a dense block of rows x cols entries, the slots of the block are looked up
+ * at the first assembly after the pattern was (re)built and the kernel adds by
+ * slots later. nothing is stored when the jacobian has no frozen pattern.
+ */
+class FVM_SlotCache
+{
+public:
+  /**
+   * constructor
+   */
+  FVM_SlotCache() : _pattern_id(0) {}
+
+  /**
+   * prepare the cache of \p n items for \p jac, should be called before the
+   * threaded assembly loop. the slots are dropped when the pattern changed
+   */
+  void sync(const SparseMatrix<PetscScalar> *jac, unsigned int n)
+  {
+    const unsigned int id = jac->pattern_id();
+    const unsigned int size = id ? n : 0;
+    if( id == _pattern_id && _slots.size() == size ) return;
+    _pattern_id = id;
+    std::vector< std::vector<int> >(size).swap(_slots);
+  }
+
+  /**
+   * @return the slots of item \p i, row major for the \p nrow rows and \p ncol columns,
+   * NULL when jacobian has no frozen pattern or some entry is out of it.
+   * the slots of rows not on this processor are -1.
+   * the slots of an item are only written by the thread processing it
+   */
+  const int * slots(const SparseMatrix<PetscScalar> *jac, unsigned int i,
+                    unsigned int nrow, const PetscInt *rows, unsigned int ncol, const PetscInt *cols)
+  {
+    if( !_pattern_id ) return 0;
+
+    std::vector<int> & item = _slots[i];
+    if( item.size() != nrow*ncol )
+    {
+      item.resize(nrow*ncol);
+      for(unsigned int r=0; r<nrow; ++r)
+        for(unsigned int c=0; c<ncol; ++c)
+        {
+          // rows of other processor are never added by slots
+          if( !jac->row_on_processor(rows[r]) ) { item[r*ncol+c] = -1; continue; }
+          if( (item[r*ncol+c] = jac->slot(rows[r], cols[c])) < 0 )
+          {
+            // the pattern will be extended by this assembly, look up again after that
+            item.clear();
+            return 0;
+          }
+        }
+    }
+    return &item[0];
+  }
+
+  /**
+   * free the memory
+   */
+  void clear()
+  {
+    std::vector< std::vector<int> >().swap(_slots);
+    _pattern_id = 0;
+  }
+
+private:
+
+  /**
+   * the pattern id of jacobian the slots belong to
+   */
+  unsigned int _pattern_id;
+
+  /**
+   * slots of each item
+   */
+  std::vector< std::vector<int> > _slots;
+};
+
+
+#endif
@@ -33,12 +33,14 @@
 #include "fvm_node_info.h"
 #include "material.h"
 #include "simulation_region.h"
+#include "fvm_slot_cache.h"
 
 class Elem;
 class GateContactBC;
 class SimpleGateContactBC;
 class ResistanceInsulatorBC;
 class InsulatorSemiconductorInterfaceBC;
+class FVM_ThreadFillValue;
 
 
 
@@ -116,6 +118,11 @@ public:
    */
   virtual Real fvm_cell_quality() const;
 
+  /**
+   * build the flat edge table, fill truncated partial area of this region
+   */
+  virtual void build_edge_table();
+
   /**
    * @return the pointer to material data
    */
@@ -129,11 +136,12 @@ public:
   { return (Material::MaterialBase *)mt; }
 
   /**
-   * @return the optical refraction index of the region
+   * @return the optical refraction index of the region,
+   * region level values are evaluated with an empty PMI_Context
    */
   virtual Complex get_optical_refraction(double lamda) const
   {
-    std::complex<PetscScalar> r = material()->optical->RefractionIndex(lamda, T_external());
+    std::complex<PetscScalar> r = material()->optical->RefractionIndex(PMI_Context(), lamda, T_external());
     return Complex(r.real(), r.imag());
   }
 
@@ -141,7 +149,7 @@ public:
    * @return the energy bandgap for optical simulation
    */
   virtual double get_optical_Eg() const
-  { return material()->band->Eg(T_external()); }
+  { return material()->band->Eg(PMI_Context(), T_external()); }
 
 
   /**
@@ -160,19 +168,19 @@ public:
    * @return relative permittivity of material
    */
   virtual double get_eps() const
-    { return mt->basic->Permittivity(); }
+    { return mt->basic->Permittivity(PMI_Context()); }
 
   /**
    * @return maretial density [g cm^-3]
    */
   virtual double get_density() const
-    { return mt->basic->Density(T_external()); }
+    { return mt->basic->Density(PMI_Context(), T_external()); }
 
   /**
    * @return affinity of material
    */
   virtual double get_affinity() const
-  { return mt->basic->Affinity(T_external()); }
+  { return mt->basic->Affinity(PMI_Context(), T_external()); }
 
   /**
    * virtual function for set different model, calibrate parameters to PMI
@@ -330,6 +338,70 @@ private:
   void DDM1_Gummel_Carrier_Electron(PetscScalar * x, Mat A, Vec r, InsertMode &add_value_flag);
 
   void DDM1_Gummel_Carrier_Hole(PetscScalar * x, Mat A, Vec r, InsertMode &add_value_flag);
+
+  /**
+   * data shared by the threads of region assembly,
+   * defined together with the assembly routines
+   */
+  struct DDM1_Function_Data;
+  struct DDM1_Jacobian_Data;
+  struct DDM2_Function_Data;
+  struct DDM2_Jacobian_Data;
+  struct EBM3_Function_Data;
+  struct EBM3_Jacobian_Data;
+
+  /**
+   * threaded parts of DDM1 function and jacobian evaluation,
+   * process edges/elements/on processor nodes in range [begin, end)
+   */
+  void DDM1_Function_Edge(DDM1_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM1_Function_Cell(DDM1_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM1_Function_Node(DDM1_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM1_Jacobian_Edge(DDM1_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM1_Jacobian_Cell(DDM1_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM1_Jacobian_Node(DDM1_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+
+  /**
+   * run the threaded DDM1 jacobian loops, also collect function value when data is in fused mode
+   */
+  void DDM1_Jacobian_Assemble(DDM1_Jacobian_Data &data);
+
+  /**
+   * jacobian slots of DDM1 poisson flux of each edge, S-G current of each element
+   * and node terms of each on processor node
+   */
+  FVM_SlotCache _ddm1_edge_slots;
+  FVM_SlotCache _ddm1_cell_slots;
+  FVM_SlotCache _ddm1_node_slots;
+
+  /**
+   * threaded parts of DDM2 function and jacobian evaluation,
+   * process elements/on processor nodes in range [begin, end)
+   */
+  void DDM2_Function_Cell(DDM2_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM2_Function_Node(DDM2_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM2_Jacobian_Cell(DDM2_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM2_Jacobian_Node(DDM2_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+
+  /**
+   * threaded parts of EBM3 function and jacobian evaluation,
+   * process elements/on processor nodes in range [begin, end)
+   */
+  void EBM3_Function_Cell(EBM3_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void EBM3_Function_Node(EBM3_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void EBM3_Jacobian_Cell(EBM3_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void EBM3_Jacobian_Node(EBM3_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end);
+
+  /**
+   * threaded parts of XXX_Fill_Value and XXX_Update_Solution,
+   * process on processor nodes / local nodes in range [begin, end)
+   */
+  void DDM1_Fill_Value_Node(FVM_ThreadFillValue &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM1_Update_Solution_Node(PetscScalar * &lxx, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM2_Fill_Value_Node(FVM_ThreadFillValue &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void DDM2_Update_Solution_Node(PetscScalar * &lxx, unsigned int thread, unsigned int begin, unsigned int end);
+  void EBM3_Fill_Value_Node(FVM_ThreadFillValue &data, unsigned int thread, unsigned int begin, unsigned int end);
+  void EBM3_Update_Solution_Node(PetscScalar * &lxx, unsigned int thread, unsigned int begin, unsigned int end);
 #endif
 
 public:
@@ -390,6 +462,16 @@ public:
    */
   virtual void DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag);
 
+  /**
+   * build function and its jacobian for L1 DDM in one pass
+   */
+  virtual void DDM1_Function_Jacobian(PetscScalar * x, Vec f, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag);
+
+  /**
+   * semiconductor region has a single-pass DDM1 function/jacobian kernel
+   */
+  virtual bool DDM1_Fused_Kernel() const { return true; }
+
   /**
    * build time derivative term and its jacobian for L1 DDM
    */
@@ -32,6 +32,7 @@
 #include "fvm_node_info.h"
 #include "fvm_node_data.h"
 #include "fvm_cell_data.h"
+#include "fvm_edge_table.h"
 #include "petscvec.h"
 #include "petscmat.h"
 #include "sparse_matrix.h"
@@ -483,6 +484,18 @@ public:
   unsigned int elem_edge_index(const Elem* elem, unsigned int e) const
   { return _region_elem_edge_in_edges_index.find(elem)->second[e]; }
 
+  /**
+   * @return the flat edge table of this region, valid after build_edge_table()
+   */
+  const FVM_EdgeTable & edge_table() const
+  { return _edge_table; }
+
+  /**
+   * (re)build the flat edge table from region edges and cells.
+   * should be called after the dof map of solver is built, since node offsets are stored
+   */
+  virtual void build_edge_table();
+
   /**
    * (re)build _region_local_node and _region_processor_node for fast iteration
    */
@@ -780,6 +793,17 @@ public:
   }
 
 
+  /**
+   * write cell and node data of this region, and the history of PMI models to checkpoint file
+   */
+  void checkpoint(CheckpointWriter & out) const;
+
+  /**
+   * read cell and node data of this region from checkpoint file
+   * @return false when the data layout mismatch
+   */
+  bool restart(CheckpointReader & in);
+
   /**
    * approx memory usage
    */
@@ -903,6 +927,11 @@ protected:
     std::map<const Elem *, std::vector<unsigned int> > _region_elem_edge_in_edges_index;
 #endif
 
+  /**
+   * flat copy of region edges with node offsets and cv geometry, for FVM flux kernels
+   */
+  FVM_EdgeTable _edge_table;
+
 
   /**
    * the boundingbox of the region
@@ -1072,6 +1101,32 @@ public:
    */
   virtual void DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag)=0;
 
+  /**
+   * @brief virtual function for evaluating level 1 DDM equation and its Jacobian in one pass.
+   *
+   * @param x                local unknown vector
+   * @param f                petsc global function vector
+   * @param jac              petsc global jacobian matrix
+   * @param add_value_flag   flag for last operator is ADD_VALUES
+   *
+   * @note the default implementation evaluates function and Jacobian one after another,
+   * derived region can override it to share the evaluation of physical models.
+   */
+  virtual void DDM1_Function_Jacobian(PetscScalar * x, Vec f, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag)
+  {
+    DDM1_Function(x, f, add_value_flag);
+    InsertMode jac_flag = NOT_SET_VALUES;
+    DDM1_Jacobian(x, jac, jac_flag);
+  }
+
+  /**
+   * @brief this region overrides DDM1_Function_Jacobian with a single-pass kernel.
+   *
+   * @note the fused assembly mode is only used when all the regions have such kernel,
+   * otherwise the jacobian built together with each rejected trial residual is wasted.
+   */
+  virtual bool DDM1_Fused_Kernel() const { return false; }
+
   /**
    * @brief virtual function for evaluating time derivative term of level 1 DDM equation.
    *
@@ -29,6 +29,7 @@
 #include "tensor_value.h"
 #include "enum_solution.h"
 #include "enum_solver_specify.h"
+#include "enum_mesh_reorder.h"
 #include "error_vector.h"
 #include "physical_unit.h"
 #include "interpolation_base.h"
@@ -389,9 +390,18 @@ public:
   void fill_interpolator(InterpolationBase *, const std::string &, InterpolationBase::InterpolationType /* type */) const;
 
   /**
-   * get data from interpolator after mesh refinement
+   * integral of variable over each region, i.e. sum of node value times control volume,
+   * one value for each region. it is used as the total of conservative transfer
    */
-  void do_interpolation(const InterpolationBase *, const std::string &);
+  void region_integral(const std::string &, std::vector<double> & /* total */) const;
+
+  /**
+   * get data from interpolator after mesh refinement.
+   * when the region totals \p total (see region_integral) of old mesh are given, the transfer
+   * is conservative: the node value is the average of old field over the control volume of
+   * node by a quadrature of sample points, then it is scaled to keep the total of each region.
+   */
+  void do_interpolation(const InterpolationBase *, const std::string &, const std::vector<double> * total=NULL);
 
   /**
    * set unique solver name to _solver_active_history
@@ -464,6 +474,11 @@ private:
    */
   bool _block_partition;
 
+  /**
+   * the node/elem reordering method applied before partition
+   */
+  MeshReorderType _mesh_reorder;
+
   /**
    * data structure for fvm solver
    * only build nodes which belongs to local processor
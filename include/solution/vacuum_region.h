@@ -198,6 +198,11 @@ public:
    */
   virtual void DDM1_Jacobian(PetscScalar * , SparseMatrix<PetscScalar> *, InsertMode &) {}
 
+  /**
+   * vacuum region has no DDM1 equation, the default one-pass evaluation costs nothing
+   */
+  virtual bool DDM1_Fused_Kernel() const { return true; }
+
   /**
    * build time derivative term and its jacobian for L1 DDM, do nothing here
    */
@@ -0,0 +1,133 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+
+#ifndef __xdmf_io_h__
+#define __xdmf_io_h__
+
+// C++ includes
+#include <string>
+#include <vector>
+
+// Local includes
+#include "genius_common.h"
+
+class SimulationSystem;
+class FVM_Node;
+
+
+/**
+ * time series output in HDF5 + XDMF format, which can be opened by paraview/visit.
+ * the mesh (points, cells, region and doping) is written to <prefix>.h5 only once,
+ * each step only appends node based solution to group /step_xxxxxx.
+ * <prefix>.xmf describes the temporal collection of steps and is updated after each step.
+ *
+ * the solution is copied to a buffer, then a background thread compresses and writes it,
+ * so the solver continues while the file is written. only processor 0 holds the file,
+ * and only the writer thread calls HDF5 library.
+ */
+class XDMFTimeSeries
+{
+public:
+
+  /**
+   * create the time series and write the mesh, should be called on all the processors
+   * @param compression  deflate level of HDF5 datasets, 0 for no compression
+   */
+  XDMFTimeSeries(const SimulationSystem & system, const std::string & prefix, int compression=6);
+
+  /**
+   * wait for the pending steps and close the file
+   */
+  ~XDMFTimeSeries();
+
+  /**
+   * snapshot the current solution as a new step at \p time, should be called on all the processors.
+   * returns once the solution is buffered, it may block when too many steps are pending
+   */
+  void write_step(double time);
+
+  /**
+   * block until all the buffered steps are written
+   */
+  void flush();
+
+  /**
+   * @return the number of steps
+   */
+  unsigned int n_steps() const { return _n_steps; }
+
+  /**
+   * @return the name of xdmf file
+   */
+  std::string xdmf_file() const { return _prefix + ".xmf"; }
+
+private:
+
+  const SimulationSystem & _system;
+
+  /**
+   * file name prefix
+   */
+  std::string _prefix;
+
+  /**
+   * steps written so far
+   */
+  unsigned int _n_steps;
+
+  /**
+   * sorted node id of each region, the mesh points are ordered region by region
+   */
+  std::vector< std::vector<unsigned int> > _region_nodes;
+
+  /**
+   * the index of first point of each region
+   */
+  std::vector<unsigned int> _region_offset;
+
+  /**
+   * @return the point index of \p node in region \p r
+   */
+  unsigned int _point_index(unsigned int r, unsigned int node) const;
+
+  /**
+   * gather node based data of all the regions to processor 0, ordered as mesh points.
+   * \p n_values values are collected for each node by \p fun
+   */
+  void _gather_node_data(unsigned int n_values, void (*fun)(const FVM_Node *, float *), std::vector<float> & data) const;
+
+  /**
+   * gather mesh points, cells and region info, queue them for writing
+   */
+  void _write_mesh();
+
+  /**
+   * the file writer of processor 0
+   */
+  class Writer;
+  Writer * _writer;
+};
+
+
+#endif
@@ -23,6 +23,8 @@
 #ifndef __ddm_ac_solver_h__
 #define __ddm_ac_solver_h__
 
+#include <vector>
+
 #include "enum_petsc_type.h"
 #include "fvm_linear_solver.h"
 #include "petscksp.h"
@@ -41,7 +43,7 @@ public:
    * as well as parallel scatter
    */
   DDMACSolver(SimulationSystem & system)
-  : FVM_LinearSolver(system),_first_create(true)
+  : FVM_LinearSolver(system),_first_create(true),_ac_cached(false),_b_created(false)
   {
     system.record_active_solver(this->solver_type());
   }
@@ -235,10 +237,114 @@ private:
    */
   bool           _first_create;
 
+  /**
+   * the region part of A_ is linear to omega, Ar0_ + omega*Ar1_,
+   * the frequency independent matrices are assembled only once for the AC sweep
+   */
+  Mat            Ar0_, Ar1_;
+
+  /**
+   * the region part of b_, br0_ + omega*br1_
+   */
+  Vec            br0_, br1_;
+
+  /**
+   * the transformation matrix T_ = T0_ + omega*T1_
+   */
+  Mat            T0_, T1_;
+
+  /**
+   * flag to show if the frequency independent matrices are built
+   */
+  bool           _ac_cached;
+
   /**
    * building the Matrix A, RHS vector b under certain freq omega
    */
   void build_ddm_ac(PetscScalar omega);
+
+  /**
+   * fill region part of matrix A_ and vector b_ under certain freq omega
+   */
+  void build_ddm_ac_region(PetscScalar omega, InsertMode &add_value_flag);
+
+  /**
+   * fill and assemble the transformation matrix T_ under certain freq omega
+   */
+  void build_transformation_matrix(PetscScalar omega);
+
+  /**
+   * build Ar0_, Ar1_, br0_, br1_, T0_ and T1_
+   */
+  void build_ddm_ac_cache();
+
+  /**
+   * free Ar0_, Ar1_, br0_, br1_, T0_ and T1_
+   */
+  void clear_ddm_ac_cache();
+
+  /**
+   * the boundary part of AC matrix and rhs vector, used by model order reduction
+   */
+  Mat            B_;
+  Vec            bb_;
+
+  /**
+   * local index of rows with nonzero entries in B_
+   */
+  std::vector<PetscInt> _b_rows;
+
+  /**
+   * flag to show if B_ and bb_ are created
+   */
+  bool           _b_created;
+
+  /**
+   * orthonormal projection basis of model order reduction
+   */
+  std::vector<Vec> _mor_basis;
+
+  /**
+   * the projected region part of AC matrix, Vt*Ar0_*V and Vt*Ar1_*V, stored in row major
+   */
+  std::vector<PetscScalar> _mor_G, _mor_K;
+
+  /**
+   * the projected region part of rhs vector, Vt*br0_ and Vt*br1_
+   */
+  std::vector<PetscScalar> _mor_g0, _mor_g1;
+
+  /**
+   * AC sweep by Krylov model order reduction
+   */
+  int solve_mor();
+
+  /**
+   * fill and assemble boundary part of AC matrix and rhs vector to B_ and bb_ under certain freq omega
+   */
+  void build_ddm_ac_boundary(PetscScalar omega);
+
+  /**
+   * solve the full AC system at expansion freq omega, the solution and its
+   * moments with respect to omega are appended to the projection basis
+   */
+  void mor_expand(PetscScalar omega);
+
+  /**
+   * project the region part of AC system to the basis
+   */
+  void mor_project();
+
+  /**
+   * solve the reduced system at freq omega and store the solution in x.
+   * @return the relative residual of full AC system if \p residual is true, otherwise 0
+   */
+  PetscReal mor_solve(PetscScalar omega, bool residual);
+
+  /**
+   * free the projection basis
+   */
+  void mor_clear();
 };
 
 
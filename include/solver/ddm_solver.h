@@ -24,8 +24,14 @@
 #ifndef __ddm_solver_h__
 #define __ddm_solver_h__
 
+#include <deque>
+#include <cstdio>
+
 #include "fvm_flex_nonlinear_solver.h"
 
+class CheckpointWriter;
+class CheckpointReader;
+
 /**
  * the common method for device drift-diffusion method solver
  */
@@ -241,6 +247,46 @@ protected:
    */
   PC           pcc;
 
+  /**
+   * voltage scan of dcsweep. with \p warm_start, current x is used as the initial guess
+   * of the first bias point instead of the solution in regions.
+   * \p x_first, if not PETSC_NULL, gets the solution of the first bias point.
+   * \p record, if not NULL, gets the scan voltage and solution of each converged bias point
+   */
+  int solve_dcsweep_vscan(bool warm_start, Vec x_first, FILE * record=NULL);
+
+  /**
+   * a family of voltage scans, one for each bias value of family electrodes
+   */
+  int solve_dcsweep_vfamily();
+
+  /**
+   * the family branches are swept concurrently by forked worker processes,
+   * each of them holds a private copy of the system and solver.
+   * the results are merged in the order of family bias.
+   * only used when SolverSpecify::VFamilyWorkers != 1 and genius is not built with MPI
+   */
+  int solve_dcsweep_vfamily_concurrent();
+
+  /**
+   * sweep family branch \p b in a worker process from the start solution \p x0,
+   * the result is written to \p record. never returns
+   */
+  void solve_dcsweep_vfamily_worker(unsigned int b, Vec x0, FILE * record, unsigned int n_threads);
+
+  /**
+   * merge the bias points in \p record of a worker process, as if they were solved here.
+   * \p complete is false if the worker did not finish the record
+   */
+  int solve_dcsweep_vfamily_replay(FILE * record, bool & complete);
+
+  /**
+   * set x to the start solution of family bias \p Vfamily from the start solutions \p xf
+   * of other branches at family bias \p Vf.
+   * @return false if there is no start solution yet
+   */
+  bool vfamily_warm_start(const std::vector<Vec> & xf, const std::vector<PetscScalar> & Vf, PetscScalar Vfamily);
+
   /**
    * create ksp solver for trace mode
    */
@@ -251,6 +297,33 @@ protected:
    */
   void solve_iv_trace_end();
 
+  /**
+   * IV curve trace by pseudo-arc-length continuation, called by solve_iv_trace
+   */
+  int solve_iv_trace_arclength();
+
+  /**
+   * write the state of transient simulation to SolverSpecify::Checkpoint, called at the end of accepted time step.
+   * \p time_step_success holds the recent accepted time steps for time step control
+   */
+  bool write_checkpoint(const std::deque<double> & time_step_success);
+
+  /**
+   * resume the state of transient simulation from SolverSpecify::Restart
+   */
+  bool read_checkpoint(std::deque<double> & time_step_success);
+
+  /**
+   * write extra state of derived solver to checkpoint, i.e. spice circuit
+   */
+  virtual void checkpoint_extra(CheckpointWriter & ) {}
+
+  /**
+   * read extra state of derived solver from checkpoint
+   * @return false when the state mismatch
+   */
+  virtual bool restart_extra(CheckpointReader & ) { return true; }
+
   /**
    * virtual function for set electrode dI/dV, each ddm solver should re-implement this function
    */
@@ -29,12 +29,15 @@
 #include "enum_petsc_type.h"
 #include "fvm_flex_pde_solver.h"
 #include "sparse_matrix.h"
+#include "perf_log.h"
 //#include "petscis.h"
 //#include "petscvec.h"
 //#include "petscmat.h"
 //#include "petscksp.h"
 #include "petscsnes.h"
 
+class KLUSolver;
+
 
 
 
@@ -187,6 +190,12 @@ public:
   void set_preconditioner_type (const SolverSpecify::PreconditionerType pct)
   { _preconditioner_type = pct; }
 
+  /**
+   * @return true if the linear solver and preconditioner can work on
+   * block (BAIJ) matrix, see SolverSpecify::JacobianBlock
+   */
+  virtual bool block_matrix_supported() const;
+
   /**
    * PETSC SNES can have an individual prefix
    */
@@ -202,6 +211,41 @@ public:
    */
   virtual void build_petsc_sens_jacobian(Vec x, Mat *jac, Mat *pc)=0;
 
+  /**
+   * evaluate the residual of function f at x, called by SNES.
+   * when fused assembly is enabled, the region part of jacobian at x is built at the same time
+   */
+  void sens_residual(Vec x, Vec r);
+
+  /**
+   * evaluate the Jacobian J of function f at x, called by SNES.
+   * region part of jacobian is reused if it was built by the last residual evaluation at x.
+   * @return true if the previous Jacobian is kept, see SolverSpecify::JacobianReuse
+   */
+  bool sens_jacobian(Vec x, Mat *jac, Mat *pc);
+
+  /**
+   * record residual norm of each Newton step, called by SNES convergence test.
+   * the Jacobian is marked for rebuild when residual contraction degrades
+   */
+  void jacobian_reuse_monitor(PetscInt its, PetscReal fnorm);
+
+  /**
+   * @return the total wall time (s) of Jacobian assembly by sens_jacobian
+   */
+  double jacobian_assembly_time() const { return _jacobian_timer.tot_time; }
+
+  /**
+   * @return how many times the Jacobian is assembled by sens_jacobian
+   */
+  unsigned int jacobian_assembly_count() const { return _jacobian_timer.count; }
+
+  /**
+   * derived class which can build function and jacobian of regions in one pass
+   * should return true, see SolverSpecify::FusedAssembly
+   */
+  virtual bool support_fused_assembly() const { return false; }
+
   /**
    * virtual function for snes monitor. derived class can override it as needed.
    */
@@ -324,11 +368,46 @@ protected:
    */
   PC             pc;
 
+  /**
+   * KLU direct solver, as shell preconditioner of pc
+   */
+  KLUSolver *    _klu;
+
   /**
    * array for ksp residual history
    */
   std::vector<PetscReal> _ksp_residual_history;
 
+  /**
+   * true when build_petsc_sens_residual should also build the region part of jacobian
+   * into Jac, i.e. call XXX_Function_Jacobian of each region
+   */
+  bool fused_assembly() const { return _fused_request; }
+
+  /**
+   * true when build_petsc_sens_jacobian can skip region part of jacobian,
+   * which is already in Jac
+   */
+  bool fused_jacobian_ready() const { return _fused_jacobian_ready; }
+
+  /**
+   * should be called before SNESSolve
+   */
+  void snes_solve_prepare();
+
+  /**
+   * force the Jacobian to be rebuilt by next solve, i.e. at checkpoint,
+   * thus a restarted simulation follows the same newton iterations
+   */
+  void refresh_jacobian() { _jacobian_refresh = true; }
+
+  /**
+   * should be called after SNESSolve. the region part of jacobian left by the last
+   * residual evaluation is completed, thus Jac is always a valid matrix.
+   * a failed solve also forces the Jacobian to be rebuilt next time
+   */
+  void snes_solve_finish();
+
   /**
    * Enum stating which type of nonlinear solver to use.
    */
@@ -376,6 +455,58 @@ protected:
    */
   int set_petsc_option(const std::string &key, const std::string &value, bool has_prefix=true);
 
+private:
+
+  /**
+   * the solution vector of the last fused residual evaluation
+   */
+  Vec  _fused_x;
+
+  /**
+   * build_petsc_sens_residual is called in fused mode
+   */
+  bool _fused_request;
+
+  /**
+   * Jac holds region part of jacobian at _fused_x, which is not used yet
+   */
+  bool _fused_jacobian_pending;
+
+  /**
+   * build_petsc_sens_jacobian is called with region part of jacobian in Jac
+   */
+  bool _fused_jacobian_ready;
+
+  /**
+   * Jac holds a complete Jacobian which can be reused
+   */
+  bool _jacobian_valid;
+
+  /**
+   * the Jacobian should be rebuilt at next request
+   */
+  bool _jacobian_refresh;
+
+  /**
+   * Newton steps since the Jacobian is built
+   */
+  int  _jacobian_age;
+
+  /**
+   * time step when the Jacobian is built
+   */
+  PetscReal _jacobian_dt;
+
+  /**
+   * residual norm of last Newton step
+   */
+  PetscReal _last_fnorm;
+
+  /**
+   * accumulated time of Jacobian assembly
+   */
+  PerfData _jacobian_timer;
+
 };
 
 
@@ -44,7 +44,8 @@ public:
   n_global_bc_dofs(0),
   n_global_dofs(0),
   n_local_dofs(0),
-  global_offset(0)
+  global_offset(0),
+  node_block_size(1)
   {}
 
   /**
@@ -111,7 +112,8 @@ protected:
 
   /**
    * total number of freedom in global
-   * equals to n_global_node_dofs + n_global_bc_dofs + extra_dofs
+   * equals to n_global_node_dofs + n_global_bc_dofs + extra_dofs,
+   * plus the padding dofs before extra_dofs when node_block_size > 1
    */
   unsigned int n_global_dofs;
 
@@ -127,6 +129,18 @@ protected:
    */
   unsigned int global_offset;
 
+  /**
+   * when larger than 1, the dofs of each node are padded to this size
+   * and the total dofs is a multiple of it, for block matrix storage.
+   * should be set before build_dof_map()
+   */
+  unsigned int node_block_size;
+
+  /**
+   * global index of padding dofs on this processor, they have no equation
+   */
+  std::vector<PetscInt> padding_dofs;
+
   /**
    * this array contains the local dof index as well as ghost dofs!
    * the ghost dof are located after the position of n_local_dofs
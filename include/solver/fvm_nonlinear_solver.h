@@ -34,6 +34,8 @@
 //#include "petscksp.h"
 #include "petscsnes.h"
 
+class KLUSolver;
+
 
 
 /**
@@ -333,6 +335,11 @@ protected:
    */
   PC             pc;
 
+  /**
+   * KLU direct solver, as shell preconditioner of pc
+   */
+  KLUSolver *    _klu;
+
   /**
    * array for ksp residual history
    */
@@ -0,0 +1,223 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#ifndef __fvm_thread_assembly_h__
+#define __fvm_thread_assembly_h__
+
+#include <vector>
+
+#include "genius_petsc.h"
+#include "petscvec.h"
+#include "sparse_matrix.h"
+#include "buffered_matrix.h"
+#include "thread_pool.h"
+
+
+/**
+ * per-thread storage of residual entries for threaded region assembly.
+ * each thread push (index, value) pairs to its own buffer, and
+ * the buffers are added to petsc vector in thread order by flush().
+ */
+class FVM_ThreadResidual
+{
+public:
+  /**
+   * constructor, \p reserve is the estimated total entry number
+   */
+  FVM_ThreadResidual(unsigned int reserve)
+    : _index(Genius::n_threads()), _value(Genius::n_threads())
+  {
+    for(unsigned int t=0; t<_index.size(); ++t)
+    {
+      _index[t].reserve(reserve/_index.size()+1);
+      _value[t].reserve(reserve/_value.size()+1);
+    }
+  }
+
+  /**
+   * index buffer of thread t
+   */
+  std::vector<PetscInt> & index(unsigned int t)
+  { return _index[t]; }
+
+  /**
+   * value buffer of thread t
+   */
+  std::vector<PetscScalar> & value(unsigned int t)
+  { return _value[t]; }
+
+  /**
+   * add all the buffered entries into \p f
+   */
+  void flush(Vec f)
+  {
+    for(unsigned int t=0; t<_index.size(); ++t)
+    {
+      // we should prevent zero length vector add here.
+      if( _index[t].size() )
+        VecSetValues(f, _index[t].size(), &(_index[t])[0], &(_value[t])[0], ADD_VALUES);
+      _index[t].clear();
+      _value[t].clear();
+    }
+  }
+
+private:
+
+  std::vector< std::vector<PetscInt> >     _index;
+
+  std::vector< std::vector<PetscScalar> >  _value;
+};
+
+
+
+/**
+ * per-thread storage of solution value and its scaling, used by threaded XXX_Fill_Value.
+ * each thread push (index, value, scale) to its own buffer, and
+ * the buffers are inserted into petsc vectors in thread order by flush().
+ */
+class FVM_ThreadFillValue
+{
+public:
+  /**
+   * constructor, \p reserve is the estimated total entry number
+   */
+  FVM_ThreadFillValue(unsigned int reserve)
+    : _index(Genius::n_threads()), _value(Genius::n_threads()), _scale(Genius::n_threads())
+  {
+    for(unsigned int t=0; t<_index.size(); ++t)
+    {
+      _index[t].reserve(reserve/_index.size()+1);
+      _value[t].reserve(reserve/_index.size()+1);
+      _scale[t].reserve(reserve/_index.size()+1);
+    }
+  }
+
+  /**
+   * index buffer of thread t
+   */
+  std::vector<PetscInt> & index(unsigned int t)
+  { return _index[t]; }
+
+  /**
+   * solution value buffer of thread t
+   */
+  std::vector<PetscScalar> & value(unsigned int t)
+  { return _value[t]; }
+
+  /**
+   * scaling buffer of thread t
+   */
+  std::vector<PetscScalar> & scale(unsigned int t)
+  { return _scale[t]; }
+
+  /**
+   * insert the buffered solution value into \p x and scaling into \p L
+   */
+  void flush(Vec x, Vec L)
+  {
+    for(unsigned int t=0; t<_index.size(); ++t)
+    {
+      if( _index[t].size() )
+      {
+        VecSetValues(x, _index[t].size(), &(_index[t])[0], &(_value[t])[0], INSERT_VALUES) ;
+        VecSetValues(L, _index[t].size(), &(_index[t])[0], &(_scale[t])[0], INSERT_VALUES) ;
+      }
+      _index[t].clear();
+      _value[t].clear();
+      _scale[t].clear();
+    }
+  }
+
+private:
+
+  std::vector< std::vector<PetscInt> >     _index;
+
+  std::vector< std::vector<PetscScalar> >  _value;
+
+  std::vector< std::vector<PetscScalar> >  _scale;
+};
+
+
+
+/**
+ * per-thread storage of jacobian entries for threaded region assembly.
+ * with one thread, the jacobian matrix is used directly.
+ * otherwise each thread records its entries into a BufferedMatrix,
+ * which are replayed into jacobian matrix in thread order by flush().
+ */
+class FVM_ThreadJacobian
+{
+public:
+  /**
+   * constructor
+   */
+  FVM_ThreadJacobian(SparseMatrix<PetscScalar> *jac)
+    : _jac(jac)
+  {
+    if( Genius::n_threads() > 1 )
+      for(unsigned int t=0; t<Genius::n_threads(); ++t)
+        _buffers.push_back( new BufferedMatrix<PetscScalar>(jac) );
+  }
+
+  /**
+   * destructor, free the buffers
+   */
+  ~FVM_ThreadJacobian()
+  {
+    for(unsigned int t=0; t<_buffers.size(); ++t)
+      delete _buffers[t];
+  }
+
+  /**
+   * the matrix thread t should write to
+   */
+  SparseMatrix<PetscScalar> * operator[] (unsigned int t)
+  {
+    if( _buffers.empty() ) return _jac;
+    return _buffers[t];
+  }
+
+  /**
+   * the jacobian matrix itself
+   */
+  const SparseMatrix<PetscScalar> * matrix() const
+  { return _jac; }
+
+  /**
+   * replay the buffered entries into jacobian matrix
+   */
+  void flush()
+  {
+    for(unsigned int t=0; t<_buffers.size(); ++t)
+      _buffers[t]->flush(_jac);
+  }
+
+private:
+
+  SparseMatrix<PetscScalar> *                 _jac;
+
+  std::vector<BufferedMatrix<PetscScalar> *>  _buffers;
+};
+
+
+
+#endif
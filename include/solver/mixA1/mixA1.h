@@ -124,6 +124,11 @@ public:
    */
   virtual void build_petsc_sens_jacobian(Vec x, Mat *jac, Mat *pc);
 
+  /**
+   * fused assembly is only worthwhile when all the regions have a single-pass kernel
+   */
+  virtual bool support_fused_assembly() const;
+
   /**
    * function for line search pre check. do Newton damping here
    */
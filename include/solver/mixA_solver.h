@@ -24,10 +24,15 @@
 #define __mixA_solver_h__
 
 #include "ddm_solver.h"
+#include "mix_schur_solver.h"
 
 /**
  * common functiuons for advanced mixed mode simulation
  * and redefine some methods in DDMSolverBase
+ *
+ * the circuit holds exactly one instance of the device, each electrode links to one spice node.
+ * several instances of the same device would need per instance dof offsets in every FVM kernel,
+ * boundary condition and ghost scatter, that is not supported.
  */
 class MixASolverBase : public DDMSolverBase
 {
@@ -35,14 +40,14 @@ public:
   /**
    * constructor
    */
-  MixASolverBase(SimulationSystem & system): DDMSolverBase(system), _circuit(system.get_circuit())
+  MixASolverBase(SimulationSystem & system): DDMSolverBase(system), _circuit(system.get_circuit()), _schur(0)
   {}
 
   /**
    * destructor
    */
   virtual ~MixASolverBase()
-  {}
+  { delete _schur; }
 
   /**
    * virtual function, create the solver
@@ -134,6 +139,16 @@ public:
    */
   virtual int solve_transient();
 
+  /**
+   * write spice circuit state to checkpoint
+   */
+  virtual void checkpoint_extra(CheckpointWriter & out);
+
+  /**
+   * read spice circuit state from checkpoint
+   */
+  virtual bool restart_extra(CheckpointReader & in);
+
   /**
    * IV curve automatically trace
    */
@@ -171,6 +186,17 @@ protected:
    */
   PetscScalar spice_norm;
 
+  /**
+   * Schur complement solver which eliminates device dofs, see SolverSpecify::MixSchur
+   */
+  MixSchurSolver * _schur;
+
+  /**
+   * the sub matrix extraction of Schur complement solver needs AIJ matrix
+   */
+  virtual bool block_matrix_supported() const
+  { return !SolverSpecify::MixSchur && DDMSolverBase::block_matrix_supported(); }
+
 };
 
 #endif //#define __mixA_solver_h__
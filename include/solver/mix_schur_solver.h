@@ -0,0 +1,175 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+#ifndef __mix_schur_solver_h__
+#define __mix_schur_solver_h__
+
+#include <vector>
+
+#include "genius_petsc.h"
+#include "petscksp.h"
+#include "dense_matrix.h"
+
+class KLUSolver;
+
+
+/**
+ * Schur complement solver for the jacobian of mixed-mode (device + spice) solvers.
+ *
+ * the device dofs come first and the spice dofs are appended to the end, owned by
+ * the last processor:
+ *
+ *   | A  B | | x_d |   | b_d |
+ *   | C  D | | x_s | = | b_s |
+ *
+ * the device interior A is factorized once per jacobian, and only the columns of B
+ * which couple to spice (the electrode dofs) are eliminated, Y = A^-1 B.
+ * the circuit then sees the small dense terminal matrix S = D - C Y, which is
+ * factorized on the last processor by LU with partial pivoting, since the MNA
+ * matrix of circuit has zero diagonals, i.e. the rows of voltage source branch.
+ * a linear solve reuses both factorizations:
+ *
+ *   z = A^-1 b_d,  x_s = S^-1 (b_s - C z),  x_d = z - Y x_s
+ *
+ * it is hooked into PETSc as a shell preconditioner, used together with KSPPREONLY.
+ * the device block is factorized by KLU in serial and by MUMPS in parallel,
+ * the options of its KSP have prefix "mix_schur_".
+ */
+class MixSchurSolver
+{
+public:
+
+  /**
+   * @param n_device_dofs  global number of device dofs, the rest are spice dofs
+   */
+  MixSchurSolver(PetscInt n_device_dofs);
+
+  ~MixSchurSolver();
+
+  /**
+   * set \p pc to be a shell preconditioner which calls this solver
+   */
+  void attach(PC pc);
+
+  /**
+   * factorize the device block of \p P and build the Schur complement
+   */
+  PetscErrorCode setup(Mat P);
+
+  /**
+   * solve P x = b with the factorizations
+   */
+  PetscErrorCode solve(Vec b, Vec x);
+
+  /**
+   * free all the petsc objects and factorizations
+   */
+  void clear();
+
+private:
+
+  /**
+   * global number of device dofs
+   */
+  PetscInt _n_device_dofs;
+
+  /**
+   * number of device dofs on this processor
+   */
+  PetscInt _n_local_device_dofs;
+
+  /**
+   * number of spice dofs, all of them are on the last processor
+   */
+  PetscInt _n_spice_dofs;
+
+  /**
+   * index set of device rows and spice rows on this processor
+   */
+  IS _is_device;
+  IS _is_spice;
+
+  /**
+   * device block A and spice-device block C of the jacobian
+   */
+  Mat _A;
+  Mat _C;
+
+  /**
+   * linear solver of the device block A
+   */
+  KSP _ksp;
+
+  /**
+   * KLU solver as shell preconditioner of _ksp, serial only
+   */
+  KLUSolver * _klu;
+
+  /**
+   * global index of spice dofs which couple to device, i.e. nonzero columns of B
+   */
+  std::vector<PetscInt> _electrode_cols;
+
+  /**
+   * Y = A^-1 B, one vector for each electrode column
+   */
+  std::vector<Vec> _Y;
+
+  /**
+   * work vectors in device layout and spice layout
+   */
+  Vec _bd;
+  Vec _xd;
+  Vec _cz;
+
+  /**
+   * the Schur complement S = D - C Y, only valid on the last processor
+   */
+  DenseMatrix<PetscScalar> _S;
+
+  /**
+   * pivoted LU factorization of _S as sequential dense matrix on the last processor,
+   * and the work vectors of its solve
+   */
+  Mat _S_lu;
+  Vec _s_rhs;
+  Vec _s_sol;
+
+  /**
+   * factorize _S into _S_lu, on the last processor
+   */
+  PetscErrorCode _factorize_S();
+
+  /**
+   * create the device solver _ksp
+   */
+  void _create_device_solver();
+
+  /**
+   * destroy the vectors of _Y
+   */
+  void _clear_Y();
+};
+
+
+#endif
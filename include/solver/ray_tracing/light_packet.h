@@ -0,0 +1,209 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+#ifndef __light_packet_h__
+#define __light_packet_h__
+
+//C++ include
+#include <vector>
+#include <utility>
+
+//local include
+#include "point.h"
+#include "elem_intersection.h"
+
+class Elem;
+class LightThread;
+class ARCoatings;
+
+/**
+ * a packet of lights with different wavelength which share the same path.
+ * the power of each wavelength is stored in continuous arrays.
+ * the wavelength is identified by its index in the spectrum batch.
+ */
+class LightPacket
+{
+public:
+
+  LightPacket(const Point & p, const Point & dir, const Point & E_dir)
+      :_p(p), _dir(dir.unit()), _E_dir(E_dir)
+  {
+    hit_elem = NULL;
+  }
+
+  /**
+   * add a light of wave \p wave to the packet
+   */
+  void add_wave(unsigned int wave, double wavelength, double init_power, double power)
+  {
+    _waves.push_back(wave);
+    _wavelength.push_back(wavelength);
+    _init_power.push_back(init_power);
+    _power.push_back(power);
+  }
+
+  /**
+   * @return the number of wavelength in the packet
+   */
+  unsigned int n_waves() const { return _waves.size(); }
+
+  /**
+   * @return the index of \p i th wavelength in spectrum batch
+   */
+  unsigned int wave(unsigned int i) const { return _waves[i]; }
+
+  /**
+   * @return the \p i th wavelength
+   */
+  double wavelength(unsigned int i) const { return _wavelength[i]; }
+
+  /**
+   * @return the power of \p i th wavelength
+   */
+  double power(unsigned int i) const { return _power[i]; }
+
+  /**
+   * @return the total power of the packet
+   */
+  double total_power() const;
+
+  /**
+   * scale the power of all the wavelength
+   */
+  void scale_power(double f);
+
+  /**
+   * @return writable reference to start point of the packet
+   */
+  Point & start_point()  { return _p; }
+
+  /**
+   * @return the start point of the packet
+   */
+  const Point & start_point() const    { return _p; }
+
+  /**
+   * @return the direction of the packet
+   */
+  const Point & dir() const    { return _dir; }
+
+  /**
+   * packet advance to a new point. the absorption coefficients are given for each
+   * wavelength of the packet.
+   * @param  p_end new packet point
+   * @param  a_band band to band absorption
+   * @param  a_fc free carrier absorption
+   * @param  band_loss  power loss due to band to band absorption
+   * @param  total_loss total power loss
+   */
+  void advance_to(const Point & p_end, const std::vector<double> &a_band, const std::vector<double> &a_fc,
+                  std::vector<double> &band_loss, std::vector<double> &total_loss);
+
+  /**
+   * remove the dead lights from the packet, see LightThread::is_dead()
+   * @return the power of removed lights
+   */
+  double remove_dead();
+
+  /**
+   * @return true when all the lights are dead
+   */
+  bool is_dead() const { return _waves.empty(); }
+
+  /**
+   * @return the \p i th light of the packet as LightThread
+   */
+  LightThread * light(unsigned int i) const;
+
+  /**
+   * reflection by mirror, which doesn't depend on wavelength
+   */
+  LightPacket * reflection(const Point & in_p, const Point & norm) const;
+
+  /**
+   * generate reflection and transmission packets at interface, the lights are processed
+   * by LightThread::interface_light_gen_linear_polarized one by one, and the resulting lights
+   * are grouped into packets when both the direction and the E field direction agree within \p tol (rad).
+   * @param n1   refraction index of material 1 for each wavelength
+   * @param n2   refraction index of material 2 for each wavelength
+   */
+  void interface_light_gen_linear_polarized(const Point & in_p, const Point & norm,
+                                            const std::vector<double> &n1, const std::vector<double> &n2,
+                                            const ARCoatings *arc, bool inv, double tol,
+                                            std::vector<LightPacket *> & reflect, std::vector<LightPacket *> & refract) const;
+
+  /**
+   * pointer to the elem this packet hit
+   */
+  const Elem * hit_elem;
+
+  /**
+   * the intersection result with elem
+   */
+  IntersectionResult result;
+
+private:
+
+  /**
+   * starting point of this packet
+   */
+  Point _p;
+
+  /**
+   * directional vector of this packet
+   */
+  Point _dir;
+
+  /**
+   * direction vector of electrical field
+   */
+  Point _E_dir;
+
+  /**
+   * index of wavelength in spectrum batch
+   */
+  std::vector<unsigned int> _waves;
+
+  /**
+   * the wavelength
+   */
+  std::vector<double> _wavelength;
+
+  /**
+   * initial power of each wavelength
+   */
+  std::vector<double> _init_power;
+
+  /**
+   * current power of each wavelength
+   */
+  std::vector<double> _power;
+
+  /**
+   * group lights (take the ownership) with the wave index into packets
+   */
+  static void _group(std::vector<LightThread *> &lights, const std::vector<unsigned int> &waves,
+                     double tol, std::vector<LightPacket *> & packets);
+};
+
+#endif
@@ -24,6 +24,9 @@
 #define __light_thread_h__
 
 
+//C++ include
+#include <cstddef>
+
 //local include
 #include "point.h"
 #include "elem_intersection.h"
@@ -45,6 +48,17 @@ public:
     hit_elem = NULL;
   }
 
+  /**
+   * a large number of lights are created and destroyed during ray tracing,
+   * they are allocated from a free list owned by each thread
+   */
+  static void * operator new(size_t size);
+
+  /**
+   * give the memory back to the free list of calling thread
+   */
+  static void operator delete(void * p);
+
   /**
    * light advance to a new point. recalculate the light power.
    * @param  p_end new light point
@@ -35,8 +35,9 @@
 #include "solver_base.h"
 
 
-class ObjectTree;
+class ElemBVH;
 class LightThread;
+class LightPacket;
 class LightLenses;
 class ARCoatings;
 
@@ -98,24 +99,45 @@ private:
   unsigned int _dim;
 
   /**
-   * contains refractive_index of each region for a special lamda
+   * the number of wavelength traced together as a spectrum batch
+   */
+  unsigned int _n_waves;
+
+  /**
+   * contains refractive_index of each elem for the wavelength in spectrum batch,
+   * the index of elem e for the w-th wavelength is stored at e*_n_waves+w
    */
   std::vector<Complex> _elem_refractive_index;
 
   /**
-   * build _elem_refractive_index
+   * build _elem_refractive_index for the wavelength in spectrum batch
+   */
+  void build_elem_refractive_index(const std::vector<double> & lamdas);
+
+  /**
+   * access refractive index of the \p wave th wavelength in spectrum batch
+   */
+  double get_refractive_index_re(const Elem *, unsigned int wave=0) const;
+
+  /**
+   * access refractive index of the \p wave th wavelength in spectrum batch
+   */
+  double get_refractive_index_im(const Elem *, unsigned int wave=0) const;
+
+  /**
+   * free carrier absorption of each elem for the wavelength in spectrum batch, only build for batch size > 1
    */
-  void build_elem_refractive_index(double lamda);
+  std::vector<double> _elem_free_carrier_absorption;
 
   /**
-   * access refractive index
+   * the max number of wavelength traced together as light packet
    */
-  double get_refractive_index_re(const Elem *) const;
+  unsigned int _batch_size;
 
   /**
-   * access refractive index
+   * the light packet is split when the direction of lights differs more than this angle (rad)
    */
-  double get_refractive_index_im(const Elem *) const;
+  double _batch_tolerance;
 
 
   /**
@@ -230,9 +252,37 @@ private:
   const Elem * ray_hit(const Point &p, const Point &dir, const Elem *, IntersectionResult&) const;
 
   /**
-   * an element tree for fast ray and surface elem intersection determination
+   * walk the ray(p, dir) which enters \p elem through \p side to the exit face of \p elem,
+   * by the precomputed face planes. the exact intersection test is used when the ray
+   * leaves through an edge or vertex.
+   */
+  void ray_walk(const Point &p, const Point &dir, const Elem *elem, unsigned int side, IntersectionResult&) const;
+
+  /**
+   * face plane of elem, the plane is norm*x = offset with outside unit normal
+   */
+  struct FacePlane
+  {
+    Point  norm;
+    double offset;
+  };
+
+  /**
+   * face planes of all the elems, the planes of elem with id i are stored in
+   * [_elem_face_plane_begin[i], _elem_face_plane_begin[i+1])
+   */
+  std::vector<FacePlane>    _face_planes;
+  std::vector<unsigned int> _elem_face_plane_begin;
+
+  /**
+   * build _face_planes
+   */
+  void build_elem_face_planes();
+
+  /**
+   * a bounding volume hierarchy for fast ray and surface elem intersection determination
    */
-  ObjectTree *surface_elem_tree;
+  ElemBVH *surface_elem_tree;
 
   /**
    * when the light source can be considered as plane wave, this struct stores the plane norm to wave direction.
@@ -331,9 +381,97 @@ private:
   void define_lenses();
 
   /**
-   * do ray tracing of a single ray
+   * energy deposit and power statistic of traced rays. each thread owns one as scratch,
+   * the deposit is dense for fast accumulation, and the elems with deposit are recorded
+   */
+  struct EnergyDeposit
+  {
+    /// energy deposit of elem e for the w-th wavelength in spectrum batch is stored at e*n_waves+w
+    std::vector<double>        band;
+    std::vector<double>        total;
+    std::vector<unsigned char> touched;
+    std::vector<unsigned int>  elems;
+
+    /// the number of wavelength in spectrum batch
+    unsigned int n_waves;
+
+    /// the wavelength of the single ray being traced
+    unsigned int wave;
+
+    double incident, pass, escape, absorb;
+
+    EnergyDeposit() : n_waves(1), wave(0), incident(0.0), pass(0.0), escape(0.0), absorb(0.0) {}
+
+    void add_wave(unsigned int e, unsigned int w, double band_energy, double total_energy)
+    {
+      if(!touched[e]) { touched[e] = 1; elems.push_back(e); }
+      band[e*n_waves+w]  += band_energy;
+      total[e*n_waves+w] += total_energy;
+    }
+
+    void add(unsigned int e, double band_energy, double total_energy)
+    { add_wave(e, wave, band_energy, total_energy); }
+  };
+
+  /**
+   * energy deposit of a chunk of rays, in sparse format sorted by elem id.
+   * each elem has the deposit of all the wavelength in spectrum batch
+   */
+  struct RayChunkDeposit
+  {
+    std::vector<unsigned int>  elems;
+    std::vector<double>        band;
+    std::vector<double>        total;
+
+    double incident, pass, escape, absorb;
+  };
+
+  /**
+   * the rays of one wavelength, traced by threads chunk by chunk
+   */
+  struct RayTraceTask
+  {
+    /// wavelength in spectrum batch
+    std::vector<double> lamdas;
+
+    /// ray power of each wavelength
+    std::vector<double> wave_power;
+
+    /// power factor of each on processor ray, by optical grating
+    std::vector<double> ray_power;
+
+    /// rays in each chunk
+    unsigned int chunk_size;
+
+    /// scratch of each thread
+    std::vector<EnergyDeposit> scratch;
+
+    /// result of each chunk, reduced in chunk order for deterministic result
+    std::vector<RayChunkDeposit> chunks;
+  };
+
+  /**
+   * trace on processor rays [begin, end) as a chunk of \p task
+   */
+  void trace_rays(RayTraceTask & task, unsigned int thread, unsigned int begin, unsigned int end);
+
+  /**
+   * do ray tracing of a single ray, the energy is deposited into \p deposit
+   * as the deposit.wave th wavelength of spectrum batch
+   */
+  void ray_tracing(LightThread *, EnergyDeposit & deposit);
+
+  /**
+   * do ray tracing of a light packet of spectrum batch. the lights go along the same path,
+   * and the packet is split at interface when the refraction of lights diverges.
+   * when the packet hits an edge or vertex, the lights are traced one by one by ray_tracing()
+   */
+  void packet_tracing(LightPacket *, EnergyDeposit & deposit);
+
+  /**
+   * trace the lights of \p packet one by one, and delete the packet
    */
-  void ray_tracing(LightThread *);
+  void dissolve_packet(LightPacket *, EnergyDeposit & deposit);
 
   /**
    * save the energy deposit. for parallel simulation, we must gather this vector
@@ -89,6 +89,49 @@ namespace SolverSpecify
    */
   extern int     NSLagJacobian;
 
+  /**
+   * freeze the nonzero pattern of Jacobian matrix after the first assembly
+   */
+  extern bool    JacobianFrozenPattern;
+
+  /**
+   * store Jacobian matrix in block (BAIJ) format, node dofs are padded to the largest one
+   */
+  extern bool    JacobianBlock;
+
+  /**
+   * reuse the Jacobian matrix (and its LU factorization) between Newton steps
+   * and nonlinear solves, until the residual contraction degrades
+   */
+  extern bool    JacobianReuse;
+
+  /**
+   * the Jacobian is rebuilt when |F_k|/|F_{k-1}| exceeds this ratio
+   */
+  extern double  JacobianReuseContraction;
+
+  /**
+   * max Newton steps a Jacobian can be reused
+   */
+  extern int     JacobianReuseMax;
+
+  /**
+   * the number of threads used for region assembly
+   */
+  extern int     Threads;
+
+  /**
+   * evaluate function and jacobian in one pass at each Newton step,
+   * only takes effect in DDML1, MIX1 and MIXA1 solvers
+   */
+  extern bool    FusedAssembly;
+
+  /**
+   * mixed-mode solver eliminates device dofs by Schur complement,
+   * only the electrode coupled block is solved together with spice circuit
+   */
+  extern bool    MixSchur;
+
   /**
    * linear solver scheme: LU, BCGS, GMRES ...
    */
@@ -367,6 +410,11 @@ namespace SolverSpecify
    */
   extern bool      Predict;
 
+  /**
+   * IV trace by pseudo-arc-length continuation instead of adaptive load line
+   */
+  extern bool      TraceArcLength;
+
   /**
    * relative tol of TS truncate error, used in AutoStep
    */
@@ -423,6 +471,22 @@ namespace SolverSpecify
    */
   extern int       T_Cycles;
 
+  /**
+   * binary checkpoint file of transient solver state, empty for no checkpoint.
+   * not supported by MIX1 solver, its spice circuit runs in an external process
+   */
+  extern std::string Checkpoint;
+
+  /**
+   * write checkpoint every CheckpointSteps accepted time steps
+   */
+  extern int       CheckpointSteps;
+
+  /**
+   * resume transient simulation from this checkpoint file, empty for a new simulation
+   */
+  extern std::string Restart;
+
 
   //------------------------------------------------------
   // parameters for DC and TRACE simulation
@@ -458,6 +522,23 @@ namespace SolverSpecify
    */
   extern double    VStop;
 
+  /**
+   * electrode(s) held at each bias of VFamily in turn, one voltage DC sweep for each bias.
+   * empty for a single DC sweep
+   */
+  extern std::vector<std::string>    Electrode_VFamily;
+
+  /**
+   * bias values of family electrode(s)
+   */
+  extern std::vector<double>    VFamily;
+
+  /**
+   * max number of family branches swept concurrently by worker processes,
+   * 1 (default) for a sequential sweep, 0 for all the branches
+   */
+  extern unsigned int    VFamilyWorkers;
+
   /**
    * electrode the current DC sweep will be performanced
    */
@@ -563,6 +644,31 @@ namespace SolverSpecify
    */
   extern double    Freq;
 
+  /**
+   * assemble the frequency independent part of AC matrix only once for the sweep
+   */
+  extern bool      ACAssembleOnce;
+
+  /**
+   * AC sweep by Krylov model order reduction
+   */
+  extern bool      ACMOR;
+
+  /**
+   * relative residual tolerance of the reduced order model
+   */
+  extern double    ACMORTolerance;
+
+  /**
+   * max dimension of the projection basis
+   */
+  extern unsigned int ACMORMaxBasis;
+
+  /**
+   * moments matched at each expansion frequency
+   */
+  extern unsigned int ACMORMoments;
+
   //------------------------------------------------------
   // parameters for pseudo time stepping method
   //------------------------------------------------------
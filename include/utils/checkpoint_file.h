@@ -0,0 +1,219 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#ifndef __checkpoint_file_h__
+#define __checkpoint_file_h__
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "config.h"
+
+
+/**
+ * writer of binary checkpoint file. data are written in native binary format,
+ * arrays are prefixed by their length. the content goes to filename.tmp first and is
+ * renamed to filename when closed, thus a job killed while writing keeps the previous checkpoint.
+ */
+class CheckpointWriter
+{
+public:
+
+  CheckpointWriter();
+
+  /**
+   * the temporary file is removed if not closed yet
+   */
+  ~CheckpointWriter();
+
+  /**
+   * open filename.tmp for writing
+   * @return false when the file can not be opened
+   */
+  bool open(const std::string & filename);
+
+  /**
+   * start a named section, \p tag has 4 characters
+   */
+  void section(const char * tag)
+  { write_bytes(tag, 4); }
+
+  /**
+   * write a value of plain type
+   */
+  template <typename T>
+  void write_value(const T & value)
+  { write_bytes(&value, sizeof(T)); }
+
+  /**
+   * write \p n values of plain type
+   */
+  template <typename T>
+  void write_array(const T * data, size_t n)
+  { write_value<unsigned long long>(n); if(n) write_bytes(data, n*sizeof(T)); }
+
+  /**
+   * write a vector of plain type
+   */
+  template <typename T>
+  void write_vector(const std::vector<T> & v)
+  { write_array(v.empty() ? static_cast<const T *>(0) : &v[0], v.size()); }
+
+  /**
+   * write a string
+   */
+  void write_string(const std::string & str)
+  { write_array(str.data(), str.size()); }
+
+  /**
+   * flush the file to disk and rename it to the final name
+   * @return false when any write failed
+   */
+  bool close();
+
+private:
+
+  void write_bytes(const void * data, size_t size);
+
+  FILE *       _fp;
+
+  std::string  _filename;
+
+  bool         _failed;
+};
+
+
+
+/**
+ * reader of binary checkpoint file written by CheckpointWriter.
+ * the file is memory mapped (read into memory on windows) and values are copied out of it,
+ * any read beyond the end of file or tag mismatch sets the fail state.
+ */
+class CheckpointReader
+{
+public:
+
+  CheckpointReader();
+
+  ~CheckpointReader();
+
+  /**
+   * map the file
+   * @return false when the file can not be opened
+   */
+  bool open(const std::string & filename);
+
+  /**
+   * unmap the file
+   */
+  void close();
+
+  /**
+   * @return true if no error happened
+   */
+  bool good() const
+  { return _data != 0 && !_failed; }
+
+  /**
+   * check the tag of the next section
+   * @return false if the tag mismatch
+   */
+  bool section(const char * tag);
+
+  /**
+   * read a value of plain type
+   */
+  template <typename T>
+  T read_value()
+  { T value = T(); read_bytes(&value, sizeof(T)); return value; }
+
+  /**
+   * read an array of plain type, its length must be \p n
+   * @return false if the length mismatch
+   */
+  template <typename T>
+  bool read_array(T * data, size_t n)
+  {
+    if( read_value<unsigned long long>() != n ) { _failed = true; return false; }
+    if(n) read_bytes(data, n*sizeof(T));
+    return !_failed;
+  }
+
+  /**
+   * read an array into vector \p v of known length
+   * @return false if the length mismatch
+   */
+  template <typename T>
+  bool read_array(std::vector<T> & v)
+  { return read_array(v.empty() ? static_cast<T *>(0) : &v[0], v.size()); }
+
+  /**
+   * read a vector of plain type
+   */
+  template <typename T>
+  void read_vector(std::vector<T> & v)
+  {
+    size_t n = read_length(sizeof(T));
+    v.resize(n);
+    if(n) read_bytes(&v[0], n*sizeof(T));
+  }
+
+  /**
+   * read a string
+   */
+  std::string read_string()
+  {
+    size_t n = read_length(1);
+    std::string str(n ? _data + _pos : "", n);
+    if(n) skip_bytes(n);
+    return str;
+  }
+
+private:
+
+  void read_bytes(void * data, size_t size);
+
+  void skip_bytes(size_t size);
+
+  /**
+   * read the length of an array, zero if the array exceeds the end of file
+   */
+  size_t read_length(size_t value_size);
+
+  const char * _data;
+
+  size_t       _size;
+
+  size_t       _pos;
+
+  bool         _failed;
+
+  /**
+   * file is mapped by mmap
+   */
+  bool         _mapped;
+};
+
+
+#endif
@@ -0,0 +1,120 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+#ifndef __elem_bvh_h__
+#define __elem_bvh_h__
+
+#include <vector>
+
+#include "point.h"
+#include "tree_base.h"
+#include "elem_intersection.h"
+
+// Forward Declarations
+class MeshBase;
+class Elem;
+
+
+/**
+ * bounding volume hierarchy of mesh elements for fast ray-elem intersection test.
+ * the nodes are stored in a flat array in depth first order, the left child of
+ * a node follows it directly, and only the offset of the right child is recorded.
+ * the ray traverse the hierarchy with a local stack, near child first, and stops
+ * descending into boxes behind the nearest hit already found.
+ */
+class ElemBVH
+{
+public:
+
+  /**
+   * build the hierarchy of mesh elements, support build type of
+   * ELEMENTS, ELEMENTS_ON_BOUNDARY and ELEMENTS_ON_SURFACE
+   */
+  ElemBVH (const MeshBase& mesh, Trees::BuildType type, unsigned int leaf_size=4);
+
+  /**
+   * @return the dimension of the mesh
+   */
+  unsigned int dim() const
+  { return _dim; }
+
+  /**
+   * @return the first elem the ray(p,d) hit, NULL when missed
+   */
+  const Elem * hit(const Point & p, const Point & d) const;
+
+  /**
+   * @return the first elem the ray(p,d) hit, NULL when missed. also get the intersection result
+   */
+  const Elem * hit(const Point & p, const Point & d, IntersectionResult &result) const;
+
+  /**
+   * @return true if the ray(p,d) hit the bounding box of the mesh
+   */
+  bool hit_boundbox(const Point & p, const Point & d) const;
+
+private:
+
+  /**
+   * node of the hierarchy
+   */
+  struct BVHNode
+  {
+    /// bounding box
+    Point lower, upper;
+
+    /// for leaf, the first elem in _elems. for interior node, the offset of right child
+    unsigned int offset;
+
+    /// the number of elems in leaf, 0 for interior node
+    unsigned int n_elems;
+  };
+
+  /**
+   * flattened nodes, _nodes[0] is the root
+   */
+  std::vector<BVHNode> _nodes;
+
+  /**
+   * elements, the elems of each leaf are stored continuously
+   */
+  std::vector<const Elem *> _elems;
+
+  /**
+   * the dimension of the mesh
+   */
+  unsigned int _dim;
+
+  /**
+   * build node for elems in [begin, end), recursively
+   */
+  void build(unsigned int begin, unsigned int end, unsigned int leaf_size, std::vector<unsigned int> &index,
+             const std::vector<std::pair<Point, Point> > &boxes, const std::vector<Point> &centers);
+
+  /**
+   * ray(p, d) and box intersection by slab test, also get the entry parameter \p t_enter
+   */
+  static bool hit_box(const BVHNode &node, const Point & p, const Point & d, double t_max, double &t_enter);
+};
+
+#endif
@@ -0,0 +1,141 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+#ifndef __record_stream_h__
+#define __record_stream_h__
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+#include "config.h"
+
+
+/**
+ * append-only file for the records of each solution step, i.e. electrode IV.
+ * records are buffered in memory and go to disk when the buffer is full or
+ * the sync interval expired, at which time the file is also fsync'ed.
+ * thus a killed run loses at most the records of the last interval,
+ * and the file can be read (tailed) while the run continues.
+ */
+class RecordStream
+{
+public:
+
+  RecordStream();
+
+  /**
+   * flush and close the file
+   */
+  ~RecordStream();
+
+  /**
+   * open (truncate) the file
+   * @param buffer_size    max bytes buffered in memory
+   * @param sync_interval  max seconds between two disk syncs
+   * @return false when the file can not be opened
+   */
+  bool open(const std::string & filename, size_t buffer_size=65536, double sync_interval=10.0);
+
+  /**
+   * open an existing file and truncate it at \p offset, the records after it are discarded.
+   * used to resume a restarted simulation from the file position saved by checkpoint
+   * @return false when the file can not be opened or is shorter than \p offset
+   */
+  bool resume(const std::string & filename, long offset, size_t buffer_size=65536, double sync_interval=10.0);
+
+  /**
+   * @return true when the file is opened
+   */
+  bool is_open() const { return _fp != 0; }
+
+  /**
+   * append raw bytes
+   */
+  void write(const char * data, size_t size) { _buffer.append(data, size); }
+
+  /**
+   * append string
+   */
+  void write(const std::string & str) { _buffer.append(str); }
+
+  /**
+   * append a value in native binary format
+   */
+  template <typename T>
+  void write_binary(const T & value) { write(reinterpret_cast<const char *>(&value), sizeof(T)); }
+
+  /**
+   * @return the position of next byte, counted from the beginning of file
+   */
+  long tell() const { return _offset + static_cast<long>(_buffer.size()); }
+
+  /**
+   * overwrite the bytes at \p offset with \p str when the buffer is flushed.
+   * the region must not grow, i.e. fixed width fields of file header
+   */
+  void patch(long offset, const std::string & str);
+
+  /**
+   * should be called when a record is complete. the buffer is flushed when
+   * it is full or the sync interval expired
+   */
+  void commit();
+
+  /**
+   * write the buffer and the patch to file, and force the file to disk when \p sync is true
+   */
+  void flush(bool sync=true);
+
+  /**
+   * flush and close the file
+   */
+  void close();
+
+private:
+
+  FILE *       _fp;
+
+  /**
+   * bytes not written yet
+   */
+  std::string  _buffer;
+
+  /**
+   * bytes written to the file
+   */
+  long         _offset;
+
+  /**
+   * pending patch of file content
+   */
+  long         _patch_offset;
+  std::string  _patch;
+
+  size_t       _buffer_size;
+  double       _sync_interval;
+  time_t       _last_sync;
+};
+
+
+#endif
@@ -0,0 +1,138 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#ifndef __thread_pool_h__
+#define __thread_pool_h__
+
+#include "config.h"
+
+
+/**
+ * thread local storage qualifier used by shared-memory assembly
+ */
+#if defined(_MSC_VER)
+  #define GENIUS_THREAD_LOCAL __declspec(thread)
+#else
+  #define GENIUS_THREAD_LOCAL __thread
+#endif
+
+/**
+ * the max number of threads a thread pool may hold
+ */
+#define GENIUS_MAX_THREADS 64
+
+
+namespace Genius
+{
+
+  /**
+   * body of a parallel loop. the index range [0, n) of the loop is split into
+   * n_threads() contiguous chunks, each chunk is processed by one thread.
+   * as a result, the chunk processed by each thread is fixed for a given thread number
+   */
+  class ThreadLoopBody
+  {
+  public:
+    virtual ~ThreadLoopBody() {}
+
+    /**
+     * process index range [begin, end) on thread \p thread
+     */
+    virtual void operator() (unsigned int thread, unsigned int begin, unsigned int end) = 0;
+  };
+
+  /**
+   * loop body which forwards the index range to a member function of \p Obj.
+   * the member function has signature
+   *   void Obj::fun(Data &, unsigned int thread, unsigned int begin, unsigned int end)
+   */
+  template <typename Obj, typename Data>
+  class MemberThreadLoop : public ThreadLoopBody
+  {
+  public:
+    typedef void (Obj::*Function)(Data &, unsigned int, unsigned int, unsigned int);
+
+    MemberThreadLoop(Obj * obj, Function fun, Data & data)
+      : _obj(obj), _fun(fun), _data(data) {}
+
+    void operator() (unsigned int thread, unsigned int begin, unsigned int end)
+    { (_obj->*_fun)(_data, thread, begin, end); }
+
+  private:
+    Obj *      _obj;
+    Function   _fun;
+    Data &     _data;
+  };
+
+  /**
+   * @return the number of threads used for shared-memory assembly
+   */
+  unsigned int n_threads();
+
+  /**
+   * set the number of threads used for shared-memory assembly,
+   * the worker threads are (re)created on demand
+   */
+  void set_n_threads(unsigned int n);
+
+  /**
+   * @return the index of calling thread, 0 for main thread
+   */
+  unsigned int thread_id();
+
+  /**
+   * @return true when we are running inside a parallel loop
+   */
+  bool in_parallel_region();
+
+  /**
+   * run \p body over index range [0, n). when n_threads() is 1, or the loop
+   * is too short (less than \p grain indices per thread), or we are already
+   * in a parallel region, the body is executed serially on calling thread
+   * with thread index thread_id().
+   */
+  void parallel_for(unsigned int n, ThreadLoopBody & body, unsigned int grain=64);
+
+  /**
+   * run \p body over index range [0, n) with dynamic scheduling. the range is split
+   * into chunks of \p chunk indices, i.e. [k*chunk, (k+1)*chunk), the idle thread takes the
+   * next chunk not processed yet, and the body is called once for each chunk.
+   * this balances loops with very different cost per index. the thread processing a chunk
+   * is not fixed, so the body should write the result of each chunk to its own place
+   * when deterministic result is required.
+   */
+  void parallel_for_dynamic(unsigned int n, ThreadLoopBody & body, unsigned int chunk=64);
+
+  /**
+   * stop all the worker threads
+   */
+  void clean_threads();
+
+  /**
+   * forget the worker threads in a child process created by fork(), which only
+   * has the calling thread. the child runs serially until set_n_threads() is called again
+   */
+  void reset_threads_after_fork();
+}
+
+
+#endif
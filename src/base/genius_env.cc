@@ -22,6 +22,7 @@
 
 #include "genius_common.h"
 #include "genius_env.h"
+#include "thread_pool.h"
 
 #include <ios>
 #include <fstream>
@@ -71,6 +72,8 @@ bool Genius::init_processors(int *argc, char *** args)
 
 bool Genius::clean_processors()
 {
+  // stop assembly threads
+  Genius::clean_threads();
 
 #ifdef HAVE_MPI
   MPI_Comm_free(&Genius::GeniusPrivateData::_comm_world);
@@ -24,6 +24,7 @@
 GENIUS_LOG_STREAM genius_log;
 
 GENIUS_LOG_STREAM::GENIUS_LOG_STREAM()
+  : _capture(0)
 {
 }
 
@@ -38,6 +39,13 @@ GENIUS_LOG_STREAM::~GENIUS_LOG_STREAM()
 
 void GENIUS_LOG_STREAM::record()
 {
+  if (_capture)
+  {
+    _capture->append(_sstream.str());
+    _sstream.str("");
+    return;
+  }
+
   for (std::map<std::string, std::ostream*>::iterator it = _streams.begin();
        it != _streams.end(); it++)
   {
@@ -24,6 +24,7 @@
 #include <iomanip>
 #include <ctime>
 #include <vector>
+#include <fstream>
 
 // Local includes
 #include "perf_log.h"
@@ -122,7 +123,9 @@ PerfLog::PerfLog(const std::string& ln,
                  const bool le) :
   label_name(ln),
   log_events(le),
-  total_time(0.)
+  total_time(0.),
+  trace_events(false),
+  trace_total(0)
 {
   if (log_events)
     this->clear();
@@ -165,6 +168,9 @@ void PerfLog::clear()
 
       while (!log_stack.empty())
         log_stack.pop();
+
+      trace_total = 0;
+      trace_stack.clear();
     }
 }
 
@@ -555,6 +561,211 @@ void PerfLog::restart_event(const std::string &,
 
 
 
+void PerfLog::enable_trace(unsigned int capacity)
+{
+  genius_assert(log_stack.empty());
+  genius_assert(capacity > 0);
+
+  trace_events = true;
+  trace_buffer.resize(capacity);
+  trace_total = 0;
+  trace_stack.clear();
+}
+
+
+
+double PerfLog::_trace_time() const
+{
+#ifdef WINDOWS
+  struct timeval_t tnow;
+#else
+  struct timeval tnow;
+#endif
+
+  gettimeofday (&tnow, NULL);
+
+  return (static_cast<double>(tnow.tv_sec  - tstart.tv_sec)*1.e6 +
+          static_cast<double>(tnow.tv_usec - tstart.tv_usec));
+}
+
+
+
+void PerfLog::_trace_record(const TraceEvent &event)
+{
+  trace_buffer[trace_total % trace_buffer.size()] = event;
+  trace_total++;
+}
+
+
+
+void PerfLog::_trace_span(PerfData *perf_data,
+                          const std::string &label,
+                          const std::string &header)
+{
+  // event started before trace was enabled
+  if (trace_stack.empty()) return;
+
+  if (perf_data->trace_id < 0)
+    {
+      perf_data->trace_id = trace_names.size();
+      trace_names.push_back(std::make_pair(header, label));
+    }
+
+  TraceEvent event;
+  event.ts      = trace_stack.back();
+  event.value   = this->_trace_time() - event.ts;
+  event.name    = perf_data->trace_id;
+  event.depth   = static_cast<unsigned short>(trace_stack.size()-1);
+  event.phase   = 'X';
+  event.reserved = 0;
+
+  trace_stack.pop_back();
+
+  this->_trace_record(event);
+}
+
+
+
+void PerfLog::trace_counter(const std::string &label,
+                            double value,
+                            const std::string &header)
+{
+  if (!this->tracing()) return;
+
+  std::pair<std::string, std::string> key = std::make_pair(header, label);
+  std::map<std::pair<std::string, std::string>, unsigned int>::const_iterator it = trace_counter_ids.find(key);
+  unsigned int id;
+  if (it == trace_counter_ids.end())
+    {
+      id = trace_names.size();
+      trace_names.push_back(key);
+      trace_counter_ids.insert(std::make_pair(key, id));
+    }
+  else
+    id = it->second;
+
+  TraceEvent event;
+  event.ts      = this->_trace_time();
+  event.value   = value;
+  event.name    = id;
+  event.depth   = static_cast<unsigned short>(trace_stack.size());
+  event.phase   = 'C';
+  event.reserved = 0;
+
+  this->_trace_record(event);
+}
+
+
+
+/**
+ * escape the string for JSON output
+ */
+static std::string _json_string(const std::string &str)
+{
+  std::string out;
+  for (unsigned int i=0; i<str.size(); ++i)
+    {
+      const char c = str[i];
+      if (c == '"' || c == '\\') { out += '\\'; out += c; }
+      else if (static_cast<unsigned char>(c) < 0x20) out += ' ';
+      else out += c;
+    }
+  return out;
+}
+
+
+
+void PerfLog::write_trace_json(const std::string &filename) const
+{
+  std::ofstream out(filename.c_str());
+  if (!out.good())
+    {
+      std::cerr << "ERROR: can't open trace file " << filename << std::endl;
+      return;
+    }
+
+  const unsigned long capacity = trace_buffer.size();
+  const unsigned long n_events = std::min(trace_total, capacity);
+  const unsigned long begin    = trace_total - n_events;
+
+  out << std::setprecision(15);
+  out << "{\"displayTimeUnit\":\"ms\",\n";
+  out << " \"otherData\":{\"name\":\"" << _json_string(label_name) << "\",\"dropped\":" << begin << "},\n";
+  out << " \"traceEvents\":[\n";
+
+  for (unsigned long n=begin; n<trace_total; ++n)
+    {
+      const TraceEvent &event = trace_buffer[n % capacity];
+      const std::pair<std::string, std::string> &name = trace_names[event.name];
+
+      out << "  {\"name\":\"" << _json_string(name.second) << "\""
+          << ",\"cat\":\"" << _json_string(name.first) << "\""
+          << ",\"ph\":\"" << event.phase << "\""
+          << ",\"ts\":" << event.ts
+          << ",\"pid\":" << Genius::processor_id()
+          << ",\"tid\":0";
+
+      if (event.phase == 'X')
+        out << ",\"dur\":" << event.value << ",\"args\":{\"depth\":" << event.depth << "}}";
+      else
+        out << ",\"args\":{\"value\":" << event.value << "}}";
+
+      out << (n+1 < trace_total ? ",\n" : "\n");
+    }
+
+  out << " ]\n}\n";
+}
+
+
+
+void PerfLog::write_trace_binary(const std::string &filename) const
+{
+  std::ofstream out(filename.c_str(), std::ios::binary);
+  if (!out.good())
+    {
+      std::cerr << "ERROR: can't open trace file " << filename << std::endl;
+      return;
+    }
+
+  const unsigned long capacity = trace_buffer.size();
+  const unsigned long n_events = std::min(trace_total, capacity);
+  const unsigned long begin    = trace_total - n_events;
+
+  // magic and layout of the records
+  out.write("GTRC", 4);
+  const unsigned int processor_id = Genius::processor_id();
+  const unsigned int record_size  = sizeof(TraceEvent);
+  out.write(reinterpret_cast<const char *>(&processor_id), sizeof(unsigned int));
+  out.write(reinterpret_cast<const char *>(&record_size), sizeof(unsigned int));
+
+  // name table, each string is written as length followed by characters
+  const unsigned int n_names = trace_names.size();
+  out.write(reinterpret_cast<const char *>(&n_names), sizeof(unsigned int));
+  for (unsigned int i=0; i<n_names; ++i)
+    {
+      const std::string * str[2] = { &trace_names[i].first, &trace_names[i].second };
+      for (unsigned int k=0; k<2; ++k)
+        {
+          const unsigned int len = str[k]->size();
+          out.write(reinterpret_cast<const char *>(&len), sizeof(unsigned int));
+          out.write(str[k]->data(), len);
+        }
+    }
+
+  // the records, the oldest first
+  const unsigned long long n = n_events;
+  out.write(reinterpret_cast<const char *>(&n), sizeof(unsigned long long));
+  const unsigned long b = begin % std::max(capacity, 1ul);
+  if (n_events)
+    {
+      const unsigned long n1 = std::min(n_events, capacity - b);
+      out.write(reinterpret_cast<const char *>(&trace_buffer[b]), n1*sizeof(TraceEvent));
+      out.write(reinterpret_cast<const char *>(&trace_buffer[0]), (n_events-n1)*sizeof(TraceEvent));
+    }
+}
+
+
+
 void PerfLog::_character_line(const unsigned int n,
                               const char c,
                               OStringStream& out) const
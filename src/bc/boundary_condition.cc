@@ -554,6 +554,54 @@ bool BoundaryCondition::has_flag(const std::string & name) const
 }
 
 
+void BoundaryCondition::checkpoint(CheckpointWriter & out) const
+{
+  out.write_value<unsigned int>(_real_parameters.size());
+  for(std::map<std::string, double>::const_iterator it=_real_parameters.begin(); it!=_real_parameters.end(); ++it)
+  {
+    out.write_string(it->first);
+    out.write_value(it->second);
+  }
+
+  out.write_value<unsigned int>(_real_array_parameters.size());
+  for(std::map<std::string, std::vector<double> >::const_iterator it=_real_array_parameters.begin(); it!=_real_array_parameters.end(); ++it)
+  {
+    out.write_string(it->first);
+    out.write_vector(it->second);
+  }
+
+  if( this->has_current_flow() )
+    out.write_value(this->current());
+
+  if( _ext_circuit )
+    _ext_circuit->checkpoint(out);
+}
+
+
+void BoundaryCondition::restart(CheckpointReader & in)
+{
+  unsigned int n_real = in.read_value<unsigned int>();
+  for(unsigned int n=0; n<n_real && in.good(); ++n)
+  {
+    std::string name = in.read_string();
+    _real_parameters[name] = in.read_value<double>();
+  }
+
+  unsigned int n_array = in.read_value<unsigned int>();
+  for(unsigned int n=0; n<n_array && in.good(); ++n)
+  {
+    std::string name = in.read_string();
+    in.read_vector(_real_array_parameters[name]);
+  }
+
+  if( this->has_current_flow() )
+    this->current() = in.read_value<PetscScalar>();
+
+  if( _ext_circuit )
+    _ext_circuit->restart(in);
+}
+
+
 //---------------------------------------------------------------------------------
 // constructors for each derived class
 //---------------------------------------------------------------------------------
@@ -42,6 +42,7 @@
 #include "spice_ckt_define.h"
 #include "spice_ckt.h"
 #include "parallel.h"
+#include "checkpoint_file.h"
 
 
 
@@ -460,6 +461,50 @@ void SPICE_CKT::import_solution(const std::string &file)
 
 
 
+void SPICE_CKT::checkpoint(CheckpointWriter & out) const
+{
+  // solution synced to all the processors
+  out.write_vector(_solution);
+
+  // spice data only exist on the last processor
+  if(Genius::is_last_processor())
+  {
+    out.write_value<long>(*_ckt_mode);
+    out.write_array(*_p_rhs_old, _n_nodes);
+
+    std::vector<double> state;
+    for(int i=0; i<3; ++i)
+    {
+      get_state_vector(i, state);
+      out.write_vector(state);
+    }
+  }
+}
+
+
+bool SPICE_CKT::restart(CheckpointReader & in)
+{
+  in.read_vector(_solution);
+  if( _solution.size() != _n_nodes ) return false;
+
+  if(Genius::is_last_processor())
+  {
+    *_ckt_mode = in.read_value<long>();
+    if( !in.read_array(*_p_rhs_old, _n_nodes) ) return false;
+
+    std::vector<double> state(n_state());
+    for(int i=0; i<3; ++i)
+    {
+      if( !in.read_array(state) ) return false;
+      set_state_vector(i, state);
+    }
+  }
+
+  return in.good();
+}
+
+
+
 void SPICE_CKT::update_rhs_old(const std::vector<double> &rhs)
 {
   assert(Genius::is_last_processor());
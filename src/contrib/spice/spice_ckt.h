@@ -36,6 +36,8 @@
 #endif
 
 class BoundaryCondition;
+class CheckpointWriter;
+class CheckpointReader;
 typedef struct sCKTnode CKTnode;
 
 #include "schur_solver.h"
@@ -258,6 +260,18 @@ public:
    */
   void import_solution(const std::string &file);
 
+  /**
+   * write circuit state, i.e. ckt mode, node voltage/branch current and
+   * the state vectors to checkpoint file
+   */
+  void checkpoint(CheckpointWriter & out) const;
+
+  /**
+   * read circuit state from checkpoint file
+   * @return false when the circuit mismatch
+   */
+  bool restart(CheckpointReader & in);
+
   /**
    * output ckt matrix
    */
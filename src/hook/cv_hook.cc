@@ -24,18 +24,39 @@
 #include <string>
 #include <cstdlib>
 #include <numeric>
+#include <sstream>
 
 #include "solver_base.h"
 #include "cv_hook.h"
 #include "parallel.h"
+#include "parser.h"
 
 
 /*----------------------------------------------------------------------
  * constructor, open the rawfile for writing
  */
-CVHook::CVHook(SolverBase & solver, const std::string & name, void * file)
-    : Hook(solver, name), _input_file((const char *)file), _raw_file(SolverSpecify::out_prefix + ".cv"), _out(_raw_file.c_str()), _n_values(0)
-{}
+CVHook::CVHook(SolverBase & solver, const std::string & name, void * param)
+    : Hook(solver, name), _raw_file(SolverSpecify::out_prefix + ".cv"), _n_values(0)
+{
+  double sync_interval = 10.0;
+
+  const std::vector<Parser::Parameter> & parm_list = *((std::vector<Parser::Parameter> *)param);
+  for ( std::vector<Parser::Parameter>::const_iterator parm_it = parm_list.begin();
+        parm_it != parm_list.end(); parm_it++ )
+  {
+    if ( parm_it->name() == "sync" && parm_it->type() == Parser::REAL )
+      sync_interval = parm_it->get_real();
+  }
+
+  if ( !Genius::processor_id() )
+  {
+    if( !_out.open(_raw_file, 65536, sync_interval) )
+    {
+      MESSAGE<<"ERROR: CV hook can not open file " << _raw_file << " for writing.\n"; RECORD();
+      genius_error();
+    }
+  }
+}
 
 
 /*----------------------------------------------------------------------
@@ -72,6 +93,23 @@ void CVHook::on_init()
       }
     }
     _gate_charge.resize( _gate_electrodes.size() );
+
+    // write file head
+    if ( !Genius::processor_id() )
+    {
+      std::ostringstream head;
+      head << "# Title: CV Curve Created by Genius TCAD Simulation" << '\n';
+      head << "# Date: " << ctime(&_time) << '\n';
+
+      head << "#\t1\t"<< _sweep_electrode << " [V]" << '\n';
+      for(unsigned int n=0; n<_gate_charge.size(); n++)
+        head << "#\t" << n+2 << "\t"<< _gate_electrodes[n] << " [F]" << '\n';
+
+      head << '\n';
+
+      _out.write(head.str());
+      _out.flush();
+    }
   }
 
 }
@@ -102,9 +140,6 @@ void CVHook::post_solve()
     {
       BoundaryCondition * bc = bcs->get_bc(n);
 
-      // Save sweep voltage
-      _vsweep.push_back(SolverSpecify::Electrode_VScan_Voltage/PhysicalUnit::V);
-
       // skip bc which is not gate
       if( bc->bc_type() != GateContact && bc->bc_type() != IF_Insulator_Metal) continue;
 
@@ -167,8 +202,66 @@ void CVHook::post_solve()
       PetscScalar charge = std::accumulate(flux_buffer.begin(), flux_buffer.end(), 0.0);
       _gate_charge[elec_count++].push_back(charge/PhysicalUnit::C);
     }
-    if (elec_count) _n_values++;
+    if (!elec_count) return;
+
+    // Save sweep voltage
+    _vsweep.push_back(SolverSpecify::Electrode_VScan_Voltage/PhysicalUnit::V);
+    _n_values++;
+
+    // the window holds the last 3 points at most.
+    // forward difference for the first point, and 3 point difference for the middle of the window.
+    // the last point is written at on_close
+    if (_n_values == 2)
+      _write_row(0, 0, 1);
+
+    if (_vsweep.size() == 3)
+    {
+      _write_row(1, 0, 2);
+
+      _vsweep.erase(_vsweep.begin());
+      for(unsigned int n=0; n<_gate_charge.size(); n++)
+        _gate_charge[n].erase(_gate_charge[n].begin());
+    }
+  }
+}
+
+
+
+/*----------------------------------------------------------------------
+ * write capacitance row of the window
+ */
+void CVHook::_write_row(unsigned int i, unsigned int l, unsigned int r)
+{
+  // only root processor do this command
+  if ( Genius::processor_id() ) return;
+
+  std::ostringstream row;
+  row << _vsweep[i];
+
+  for(unsigned int n=0; n<_gate_charge.size(); n++)
+  {
+    const std::vector<double> & q = _gate_charge[n];
+    if( r == l+1 )
+    {
+      // one side difference
+      row << '\t' << (q[r]-q[l])/(_vsweep[r]-_vsweep[l]);
+    }
+    else
+    {
+      // nonuniform 3 point difference
+      double hl = _vsweep[l]-_vsweep[i];
+      double hr = _vsweep[r]-_vsweep[i];
+      double c1 = hr/hl/(hr-hl);
+      double c2 = -(hr+hl)/hl/hr;
+      double c3 = -hl/hr/(hr-hl);
+
+      row << '\t' << c1*q[l] + c2*q[i] + c3*q[r];
+    }
   }
+  row << '\n';
+
+  _out.write(row.str());
+  _out.commit();
 }
 
 
@@ -187,61 +280,19 @@ void CVHook::post_iteration()
  */
 void CVHook::on_close()
 {
-  // write spice raw file
-  // only root processor do this command
-  if ( !Genius::processor_id() )
+  if (SolverSpecify::Type == SolverSpecify::DCSWEEP)
   {
-    if (SolverSpecify::Type == SolverSpecify::DCSWEEP)
+    // backward difference for the last point
+    if (_n_values >= 2)
     {
-      // write raw file head
-      _out << "# Title: CV Curve Created by Genius TCAD Simulation" << std::endl;
-      _out << "# Date: " << ctime(&_time) << std::endl;
-
-      //_out << std::setprecision(15) << std::scientific << std::right;
-      _out << "#\t1\t"<< _sweep_electrode << " [V]" << std::endl;
-      for(unsigned int n=0; n<_gate_charge.size(); n++)
-        _out << "#\t" << n+2 << "\t"<< _gate_electrodes[n] << " [F]" << std::endl;
-
-      _out << std::endl;
-
-      if(_vsweep.size())
-      {
-        unsigned int i=0;
-        _out << _vsweep[i];
-        for (unsigned int n=0; n<_gate_charge.size(); n++)
-          _out << "\t" << (_gate_charge[n][i+1]-_gate_charge[n][i])/(_vsweep[i+1]-_vsweep[i]);
-        _out << std::endl;
-      }
-
-      for(unsigned int i=1; i<_n_values-1; i++)
-      {
-        _out << _vsweep[i];
-        for(unsigned int n=0; n<_gate_charge.size(); n++)
-        {
-          double hl = _vsweep[i-1]-_vsweep[i];
-          double hr = _vsweep[i+1]-_vsweep[i];
-          double c1 = hr/hl/(hr-hl);
-          double c2 = -(hr+hl)/hl/hr;
-          double c3 = -hl/hr/(hr-hl);
-
-          _out  << '\t' <<  c1*_gate_charge[n][i-1]
-                          + c2*_gate_charge[n][i]
-                          + c3*_gate_charge[n][i+1];
-        }
-        _out << std::endl;
-      }
-
-      if(_vsweep.size())
-      {
-        unsigned int i= _n_values-1;
-        _out << _vsweep[i];
-        for (unsigned int n=0; n<_gate_charge.size(); n++)
-          _out << "\t" << (_gate_charge[n][i]-_gate_charge[n][i-1])/(_vsweep[i]-_vsweep[i-1]);
-        _out << std::endl;
-      }
-
+      unsigned int i = _vsweep.size()-1;
+      _write_row(i, i-1, i);
     }
   }
+
+  // only root processor do this command
+  if ( !Genius::processor_id() )
+    _out.close();
 }
 
 
@@ -903,7 +903,7 @@ void DDMMonitorHook::solution_to_vtk_ddm(void * _f, void * _x, void * _dx, void
             }
 
             const SemiconductorSimulationRegion * semiconductor_region = dynamic_cast<const SemiconductorSimulationRegion *>(system.region(fvm_node->subdomain_id()));
-            semiconductor_region->material()->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
+            const PMI_Context ctx = semiconductor_region->material()->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
             R[r].push_back( semiconductor_region->material()->band->Recomb(xx[fvm_node->local_offset()+2], xx[fvm_node->local_offset()+1], node_data->T()) / (concentration_scale/s));
             G[r].push_back(node_data->Field_G()/ (concentration_scale/s));
             break;
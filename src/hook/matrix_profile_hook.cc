@@ -0,0 +1,212 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#include <algorithm>
+
+#include "genius_common.h"
+#include "genius_petsc.h"
+#include "parallel.h"
+#include "fvm_flex_nonlinear_solver.h"
+#include "matrix_profile_hook.h"
+
+
+/*----------------------------------------------------------------------
+ * constructor
+ */
+MatrixProfileHook::MatrixProfileHook ( SolverBase & solver, const std::string & name, void * )
+    : Hook ( solver, name ), _reported(false)
+{}
+
+
+/*----------------------------------------------------------------------
+ * destructor
+ */
+MatrixProfileHook::~MatrixProfileHook()
+{}
+
+
+/*----------------------------------------------------------------------
+ *   This is executed before the initialization of the solver
+ */
+void MatrixProfileHook::on_init()
+{}
+
+
+
+/*----------------------------------------------------------------------
+ *   This is executed previously to each solution step.
+ */
+void MatrixProfileHook::pre_solve()
+{}
+
+
+
+/*----------------------------------------------------------------------
+ *  This is executed after each solution step.
+ */
+void MatrixProfileHook::post_solve()
+{}
+
+
+
+/*----------------------------------------------------------------------
+ *  This is executed before each (nonlinear) iteration
+ */
+void MatrixProfileHook::pre_iteration()
+{}
+
+
+#if PETSC_VERSION_GE(3,2,0)
+/**
+ * @return the nonzeros of ILU(levels) factor of sequential matrix A
+ * with the given ordering, which shows the fill-in
+ */
+static double _ilu_nonzeros(Mat A, const char * ordering, PetscInt levels)
+{
+  IS isrow, iscol;
+  MatGetOrdering(A, ordering, &isrow, &iscol);
+
+  Mat F;
+  MatGetFactor(A, MATSOLVERPETSC, MAT_FACTOR_ILU, &F);
+
+  MatFactorInfo factor_info;
+  MatFactorInfoInitialize(&factor_info);
+  factor_info.levels = levels;
+  MatILUFactorSymbolic(F, A, isrow, iscol, &factor_info);
+
+  MatInfo info;
+  MatGetInfo(F, MAT_LOCAL, &info);
+
+  MatDestroy(PetscDestroyObject(F));
+  ISDestroy(PetscDestroyObject(isrow));
+  ISDestroy(PetscDestroyObject(iscol));
+
+  return info.nz_used;
+}
+#endif
+
+
+/*----------------------------------------------------------------------
+ *  This is executed after each (nonlinear) iteration
+ */
+void MatrixProfileHook::post_iteration()
+{
+  if(_reported) return;
+  _reported = true;
+
+  FVM_FlexNonlinearSolver & nonlinear_solver = dynamic_cast<FVM_FlexNonlinearSolver &>(_solver);
+  Mat A = nonlinear_solver.jacobian_matrix();
+
+  PetscInt M, N, begin, end;
+  MatGetSize(A, &M, &N);
+  MatGetOwnershipRange(A, &begin, &end);
+
+  // nonzeros, bandwidth max|i-j| and envelope sum(i-min(j)) of the whole matrix
+  double nonzeros = 0.0;
+  double envelope = 0.0;
+  unsigned int bandwidth = 0;
+  for(PetscInt row=begin; row<end; ++row)
+  {
+    PetscInt ncols;
+    const PetscInt * cols;
+    MatGetRow(A, row, &ncols, &cols, PETSC_NULL);
+    if(ncols)
+    {
+      const PetscInt lower = *std::min_element(cols, cols+ncols);
+      const PetscInt upper = *std::max_element(cols, cols+ncols);
+      bandwidth = std::max(bandwidth, static_cast<unsigned int>(std::max(row-lower, upper-row)));
+      envelope += std::max(row-lower, static_cast<PetscInt>(0));
+      nonzeros += ncols;
+    }
+    MatRestoreRow(A, row, &ncols, &cols, PETSC_NULL);
+  }
+  Parallel::sum(nonzeros);
+  Parallel::sum(envelope);
+  Parallel::max(bandwidth);
+
+  MESSAGE<<"Jacobian matrix profile\n"
+         <<"--------------------------------------------------------------------------------\n"
+         <<"  rows            : " << M << '\n'
+         <<"  nonzeros        : " << nonzeros << " (" << nonzeros/std::max(M, static_cast<PetscInt>(1)) << " per row)\n"
+         <<"  bandwidth       : " << bandwidth << '\n'
+         <<"  envelope        : " << envelope << '\n';
+  RECORD();
+
+#if PETSC_VERSION_GE(3,2,0)
+  // fill-in of ILU(k) on the diagonal block of each processor, as block Jacobi does.
+  // the fill-in with RCM ordering of PETSc is also given for reference
+  Mat Ad = A;
+  if(Genius::n_processors() > 1)
+    MatGetDiagonalBlock(A, &Ad);
+
+  for(PetscInt levels=1; levels<=2; ++levels)
+  {
+    double nz_natural = _ilu_nonzeros(Ad, MATORDERINGNATURAL, levels);
+    double nz_rcm     = _ilu_nonzeros(Ad, MATORDERINGRCM, levels);
+    Parallel::sum(nz_natural);
+    Parallel::sum(nz_rcm);
+
+    MESSAGE<<"  ILU(" << levels << ") nonzeros : " << nz_natural
+           << " (fill " << nz_natural/std::max(nonzeros, 1.0) << "), with PETSc RCM ordering " << nz_rcm
+           << " (fill " << nz_rcm/std::max(nonzeros, 1.0) << ")\n";
+    RECORD();
+  }
+#endif
+
+  MESSAGE<<"--------------------------------------------------------------------------------\n\n";
+  RECORD();
+}
+
+
+
+/*----------------------------------------------------------------------
+ * This is executed after the finalization of the solver
+ */
+void MatrixProfileHook::on_close()
+{
+  FVM_FlexNonlinearSolver & nonlinear_solver = dynamic_cast<FVM_FlexNonlinearSolver &>(_solver);
+
+  const unsigned int count = nonlinear_solver.jacobian_assembly_count();
+  const double time = nonlinear_solver.jacobian_assembly_time();
+
+  MESSAGE<<"Jacobian matrix assembled " << count << " times in " << time << " s";
+  if(count)
+    MESSAGE<<", " << 1e3*time/count << " ms each";
+  MESSAGE<<"\n\n";
+  RECORD();
+}
+
+
+#ifdef DLLHOOK
+
+// dll interface
+extern "C"
+{
+  Hook* get_hook ( SolverBase & solver, const std::string & name, void * fun_data )
+  {
+    return new MatrixProfileHook ( solver, name, fun_data );
+  }
+
+}
+
+#endif
+
@@ -315,14 +315,14 @@ void MobMonitorHook::solution_to_vtk()
 
       double length = f1->distance(f2);
 
-      mt->mapping(f1->root_node(), n1_data, SolverSpecify::clock);
+      const PMI_Context ctx = mt->mapping(f1->root_node(), n1_data, SolverSpecify::clock);
       double V1 = n1_data->psi();
       double n1 = n1_data->n();
       double p1 = n1_data->p();
       double Ec1 =  -(e*V1 + n1_data->affinity() + mt->band->EgNarrowToEc(p1, n1, T) + kb*T*log(n1_data->Nc()));
       double Ev1 =  -(e*V1 + n1_data->affinity() - mt->band->EgNarrowToEv(p1, n1, T) - kb*T*log(n1_data->Nv()) + mt->band->Eg(T));
 
-      mt->mapping(f2->root_node(), n2_data, SolverSpecify::clock);
+      const PMI_Context ctx = mt->mapping(f2->root_node(), n2_data, SolverSpecify::clock);
       double V2 = n2_data->psi();
       double n2 = n2_data->n();
       double p2 = n2_data->p();
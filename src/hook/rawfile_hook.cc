@@ -24,19 +24,41 @@
 #include <string>
 #include <cstdlib>
 #include <iomanip>
+#include <sstream>
 
 #include "solver_base.h"
 #include "rawfile_hook.h"
 #include "spice_ckt.h"
+#include "parser.h"
+
+
+/**
+ * fixed width field of "No. Points", which can be overwritten in place
+ */
+static std::string _points_field(unsigned int n_values)
+{
+  std::ostringstream ss;
+  ss << std::left << std::setw(12) << n_values;
+  return ss.str();
+}
+
 
 /*----------------------------------------------------------------------
- * constructor, open the rawfile for writing
+ * constructor
  */
-RawFileHook::RawFileHook(SolverBase & solver, const std::string & name, void * file)
-    : Hook(solver, name), _input_file((const char *)file), _raw_file(SolverSpecify::out_prefix + ".raw"), _mixA(false), _n_values(0)
+RawFileHook::RawFileHook(SolverBase & solver, const std::string & name, void * param)
+    : Hook(solver, name), _raw_file(SolverSpecify::out_prefix + ".raw"), _binary(false), _sync_interval(10.0),
+      _n_values_offset(0), _mixA(false), _n_values(0)
 {
-  if ( !Genius::processor_id() )
-    _out.open(_raw_file.c_str());
+  const std::vector<Parser::Parameter> & parm_list = *((std::vector<Parser::Parameter> *)param);
+  for ( std::vector<Parser::Parameter>::const_iterator parm_it = parm_list.begin();
+        parm_it != parm_list.end(); parm_it++ )
+  {
+    if ( parm_it->name() == "format" && parm_it->type() == Parser::STRING )
+      _binary = ( parm_it->get_string() == "binary" );
+    if ( parm_it->name() == "sync" && parm_it->type() == Parser::REAL )
+      _sync_interval = parm_it->get_real();
+  }
 
   SolverSpecify::SolverType solver_type = this->get_solver().solver_type();
 
@@ -55,7 +77,7 @@ RawFileHook::RawFileHook(SolverBase & solver, const std::string & name, void * f
  */
 RawFileHook::~RawFileHook()
 {
-
+  _out.close();
 }
 
 
@@ -165,10 +187,67 @@ void RawFileHook::on_init()
       }
     }
 
-    _values.resize( _variables.size() );
+    // a restarted simulation appends to the raw file at the position saved by checkpoint
+    if( SolverSpecify::Restart.empty() )
+      this->_write_head();
+  }
+
+}
+
+
 
+/*----------------------------------------------------------------------
+ * open the raw file and write the head, only root processor do this
+ */
+void RawFileHook::_write_head()
+{
+  if( !_out.open(_raw_file, 65536, _sync_interval) )
+  {
+    MESSAGE<<"ERROR: RawFile hook can not open file " << _raw_file << " for writing.\n"; RECORD();
+    genius_error();
+  }
+
+  _n_values = 0;
+
+  // write raw file head, the number of points is updated with each record
+  std::ostringstream head;
+  head << "Title: SPICE Raw File Created by Genius TCAD Simulation" << '\n';
+  head << "Date: " << ctime(&_time) << '\n';
+
+  switch (SolverSpecify::Type)
+  {
+      case SolverSpecify::DCSWEEP :
+        head << "Plotname: DC transfer characteristic" << '\n'; break;
+      case SolverSpecify::TRACE     :
+        head << "Plotname: DC curve trace" << '\n'; break;
+      case SolverSpecify::TRANSIENT :
+        head << "Plotname: Transient Analysis" << '\n'; break;
+      case SolverSpecify::ACSWEEP   :
+        head << "Plotname: AC small signal Analysis" << '\n'; break;
+      default: break;
+  }
+
+  head <<  "Flags: real" << '\n';
+
+  head <<  "No. Variables: " << _variables.size() << '\n';
+  head <<  "No. Points: ";
+  _n_values_offset = _out.tell() + static_cast<long>(head.str().size());
+  head <<  _points_field(_n_values) << '\n' << '\n';
+
+  // write variables
+  head << "Variables:" << '\n';
+  for(unsigned int n=0; n<_variables.size(); n++)
+  {
+    head << '\t' << n << '\t' << _variables[n].first << '\t' << _variables[n].second << '\n';
   }
 
+  head << '\n';
+
+  // values follow
+  head << (_binary ? "Binary:" : "Values:") << '\n';
+
+  _out.write(head.str());
+  _out.flush();
 }
 
 
@@ -191,8 +270,9 @@ void RawFileHook::post_solve()
   // only root processor do this command
   if ( !Genius::processor_id() )
   {
-    // variable counter
-    unsigned int i=0;
+    // values of this record
+    std::vector<double> values;
+    values.reserve(_variables.size());
 
     if( SolverSpecify::Type==SolverSpecify::DCSWEEP ||
         SolverSpecify::Type==SolverSpecify::TRACE   ||
@@ -201,8 +281,8 @@ void RawFileHook::post_solve()
       // if transient simulation, we need to record time
       if (SolverSpecify::Type == SolverSpecify::TRANSIENT)
       {
-        _values[i++].push_back( SolverSpecify::clock/PhysicalUnit::s );
-        _values[i++].push_back( SolverSpecify::dt/PhysicalUnit::s );
+        values.push_back( SolverSpecify::clock/PhysicalUnit::s );
+        values.push_back( SolverSpecify::dt/PhysicalUnit::s );
       }
 
       if( !_mixA )
@@ -215,27 +295,27 @@ void RawFileHook::post_solve()
           // electrode
           if( bc->is_electrode() )
           {
-            _values[i++].push_back( bc->ext_circuit()->Vapp()/PhysicalUnit::V );
-            _values[i++].push_back( bc->ext_circuit()->potential()/PhysicalUnit::V );
-            _values[i++].push_back( bc->ext_circuit()->current()/PhysicalUnit::A );
+            values.push_back( bc->ext_circuit()->Vapp()/PhysicalUnit::V );
+            values.push_back( bc->ext_circuit()->potential()/PhysicalUnit::V );
+            values.push_back( bc->ext_circuit()->current()/PhysicalUnit::A );
             continue;
           }
 
           if( bc->has_current_flow() )
           {
-            _values[i++].push_back( bc->current()/PhysicalUnit::A );
+            values.push_back( bc->current()/PhysicalUnit::A );
           }
 
           if( bc->bc_type() == IF_Metal_Ohmic || bc->bc_type() == IF_Metal_Schottky)
           {
-            _values[i++].push_back( bc->psi()/PhysicalUnit::V );
+            values.push_back( bc->psi()/PhysicalUnit::V );
           }
 
           // charge integral interface
           if( bc->bc_type() == ChargeIntegral )
           {
-            _values[i++].push_back( bc->scalar("qf")/PhysicalUnit::C );
-            _values[i++].push_back( bc->psi()/PhysicalUnit::V );
+            values.push_back( bc->scalar("qf")/PhysicalUnit::C );
+            values.push_back( bc->psi()/PhysicalUnit::V );
           }
         }
       }
@@ -245,9 +325,9 @@ void RawFileHook::post_solve()
         for(unsigned int n=0; n<spice_ckt->n_ckt_nodes(); n++)
         {
           if(spice_ckt->is_voltage_node(n))
-            _values[i++].push_back(spice_ckt->get_solution(n));
+            values.push_back( spice_ckt->get_solution(n) );
           else
-            _values[i++].push_back(spice_ckt->get_solution(n));
+            values.push_back( spice_ckt->get_solution(n) );
         }
       }
     }
@@ -255,7 +335,7 @@ void RawFileHook::post_solve()
     if( SolverSpecify::Type==SolverSpecify::ACSWEEP)
     {
       //record frequency
-      _values[i++].push_back( SolverSpecify::Freq*PhysicalUnit::s );
+      values.push_back( SolverSpecify::Freq*PhysicalUnit::s );
 
       // record electrode IV information
       const BoundaryConditionCollector * bcs = this->get_solver().get_system().get_bcs();
@@ -266,14 +346,37 @@ void RawFileHook::post_solve()
         // skip bc which is not electrode
         if( !bc->is_electrode() ) continue;
         //
-        _values[i++].push_back( std::abs(bc->ext_circuit()->potential_ac())/PhysicalUnit::V );
-        _values[i++].push_back( std::arg(bc->ext_circuit()->potential_ac()) );
-        _values[i++].push_back( std::abs(bc->ext_circuit()->current_ac())/PhysicalUnit::A );
-        _values[i++].push_back( std::arg(bc->ext_circuit()->current_ac()) );
+        values.push_back( std::abs(bc->ext_circuit()->potential_ac())/PhysicalUnit::V );
+        values.push_back( std::arg(bc->ext_circuit()->potential_ac()) );
+        values.push_back( std::abs(bc->ext_circuit()->current_ac())/PhysicalUnit::A );
+        values.push_back( std::arg(bc->ext_circuit()->current_ac()) );
       }
     }
 
-    if(i)  _n_values++;
+    if( values.empty() ) return;
+
+    // restarted without the state of this hook
+    if( !_out.is_open() )
+      this->_write_head();
+
+    // write the record
+    if( _binary )
+    {
+      _out.write( reinterpret_cast<const char *>(&values[0]), values.size()*sizeof(double) );
+    }
+    else
+    {
+      std::ostringstream record;
+      record << std::setprecision(15) << std::scientific << std::right;
+      record << " " << _n_values;
+      for(unsigned int n=0; n<values.size(); n++)
+        record  << '\t' << std::setw(25) << values[n] << '\n';
+      _out.write(record.str());
+    }
+
+    _n_values++;
+    _out.patch(_n_values_offset, _points_field(_n_values));
+    _out.commit();
   }
 
 }
@@ -293,59 +396,50 @@ void RawFileHook::post_iteration()
  */
 void RawFileHook::on_close()
 {
-  // write spice raw file
+  // records are written already, sync the file to disk
   // only root processor do this command
   if ( !Genius::processor_id() )
-  {
-    // write raw file head
-    _out << "Title: SPICE Raw File Created by Genius TCAD Simulation" << std::endl;
-    _out << "Date: " << ctime(&_time) << std::endl;
+    _out.close();
+}
 
-    switch (SolverSpecify::Type)
-    {
-        case SolverSpecify::DCSWEEP :
-          _out << "Plotname: DC transfer characteristic" << std::endl; break;
-        case SolverSpecify::TRACE     :
-          _out << "Plotname: DC curve trace" << std::endl; break;
-        case SolverSpecify::TRANSIENT :
-          _out << "Plotname: Transient Analysis" << std::endl; break;
-        case SolverSpecify::ACSWEEP   :
-          _out << "Plotname: AC small signal Analysis" << std::endl; break;
-        default: break;
-    }
 
-    _out <<  "Flags: real" << std::endl;
+/*----------------------------------------------------------------------
+ * the position of raw file for checkpoint
+ */
+std::string RawFileHook::checkpoint()
+{
+  if ( Genius::processor_id() || !_out.is_open() ) return std::string();
 
-    _out <<  "No. Variables: " << _variables.size()    << std::endl;
-    _out <<  "No. Points: "    << _n_values  << '\n'   << std::endl;
+  // records before checkpoint must be on the disk
+  _out.flush(true);
 
-    // write variables
-    _out << "Variables:"<<std::endl;
-    for(unsigned int n=0; n<_variables.size(); n++)
-    {
-      _out << '\t' << n << '\t' << _variables[n].first << '\t' << _variables[n].second << std::endl;
-    }
+  std::ostringstream state;
+  state << _n_values << ' ' << _n_values_offset << ' ' << _out.tell();
+  return state.str();
+}
 
-    _out << std::endl;
 
-    // write values
-    _out << "Values:"<<std::endl;
 
-    _out << std::setprecision(15) << std::scientific << std::right;
+/*----------------------------------------------------------------------
+ * resume the raw file at the position saved by checkpoint
+ */
+void RawFileHook::restart(const std::string & state)
+{
+  if ( Genius::processor_id() || state.empty() ) return;
 
-    for(unsigned int i=0; i<_n_values; i++)
-    {
-      _out << " " << i;
-      for(unsigned int n=0; n<_variables.size(); n++)
-        _out  << '\t' << std::setw(25) << _values[n][i] << std::endl;
-    }
+  std::istringstream ss(state);
+  long pos = 0;
+  ss >> _n_values >> _n_values_offset >> pos;
 
-    _out.close();
+  if( !ss || !_out.resume(_raw_file, pos, 65536, _sync_interval) )
+  {
+    MESSAGE<<"Warning: RawFile hook can not resume file " << _raw_file << ", write a new one.\n"; RECORD();
+    this->_write_head();
   }
-
 }
 
 
+
 #ifdef DLLHOOK
 
 // dll interface
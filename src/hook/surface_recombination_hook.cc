@@ -183,6 +183,7 @@ void  SurfaceRecombHook::_surface_recombination(const BoundaryCondition * bc, do
       {
         const SemiconductorSimulationRegion * sregion = (const SemiconductorSimulationRegion *) region;
         const FVM_NodeData * node_data = fvm_node->node_data();
+        const PMI_Context ctx = sregion->material()->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
         double n   =  node_data->n();                         // electron density
         double p   =  node_data->p();                         // hole density
@@ -193,8 +194,7 @@ void  SurfaceRecombHook::_surface_recombination(const BoundaryCondition * bc, do
         {
           // surface recombination
           Material::MaterialSemiconductor *mt =  sregion->material();
-          mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
-          double GSurf = - mt->band->R_Surf(p, n, T) * boundary_area; //generation due to SRH
+          double GSurf = - mt->band->R_Surf(ctx, p, n, T) * boundary_area; //generation due to SRH
 
           recomb_current += GSurf*bc->z_width();
         }
@@ -204,12 +204,12 @@ void  SurfaceRecombHook::_surface_recombination(const BoundaryCondition * bc, do
           // consider charge trapping in semiconductor bulk (bulk_flag=true)
 
           // call the Trap MPI to calculate trap occupancy using the local carrier densities and lattice temperature
-          PetscScalar ni = sregion->material()->band->nie(p, n, T);
-          sregion->material()->trap->Calculate(false,p,n,ni,T);
+          PetscScalar ni = sregion->material()->band->nie(ctx, p, n, T);
+          sregion->material()->trap->Calculate(ctx, false,p,n,ni,T);
 
           // calculate the rates of electron and hole capture
-          PetscScalar TrapElec = sregion->material()->trap->ElectronTrapRate(false,n,ni,T) * boundary_area;
-          PetscScalar TrapHole = sregion->material()->trap->HoleTrapRate    (false,p,ni,T) * boundary_area;
+          PetscScalar TrapElec = sregion->material()->trap->ElectronTrapRate(ctx, false,n,ni,T) * boundary_area;
+          PetscScalar TrapHole = sregion->material()->trap->HoleTrapRate    (ctx, false,p,ni,T) * boundary_area;
 
           recomb_current_trap_n += TrapElec*bc->z_width();
           recomb_current_trap_p += TrapHole*bc->z_width();
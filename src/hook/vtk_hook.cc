@@ -21,9 +21,11 @@
 
 #include <cstdlib>
 #include <iomanip>
+#include <sstream>
 
 #include "solver_base.h"
 #include "vtk_hook.h"
+#include "xdmf_io.h"
 #include "spice_ckt.h"
 #include "MXMLUtil.h"
 
@@ -33,7 +35,7 @@
  */
 VTKHook::VTKHook ( SolverBase & solver, const std::string & name, void * param)
     : Hook ( solver, name ), _vtk_prefix ( SolverSpecify::out_prefix ),
-      _ddm ( false ), _mixA ( false ), _ddm_ac ( false )
+      _ddm ( false ), _mixA ( false ), _ddm_ac ( false ), _xdmf ( 0 )
 {
   this->count  =0;
 
@@ -52,6 +54,8 @@ VTKHook::VTKHook ( SolverBase & solver, const std::string & name, void * param)
   this->_t_start=0;
   this->_t_stop =std::numeric_limits<double>::infinity();
 
+  bool xdmf = false;
+  int  compression = 6;
 
   const std::vector<Parser::Parameter> & parm_list = *((std::vector<Parser::Parameter> *)param);
   for ( std::vector<Parser::Parameter>::const_iterator parm_it = parm_list.begin();
@@ -70,13 +74,26 @@ VTKHook::VTKHook ( SolverBase & solver, const std::string & name, void * param)
       _t_start=parm_it->get_real() * PhysicalUnit::s;
     if ( parm_it->name() == "tstop" && parm_it->type() == Parser::REAL )
       _t_stop=parm_it->get_real() * PhysicalUnit::s;
+
+    // time series of mesh-once HDF5 + XDMF instead of a vtu file for each step
+    if ( parm_it->name() == "format" && parm_it->type() == Parser::STRING )
+      xdmf = ( parm_it->get_string() == "xdmf" );
+    if ( parm_it->name() == "compression" && parm_it->type() == Parser::INTEGER )
+      compression = parm_it->get_int();
   }
 
   const SimulationSystem &system = get_solver().get_system();
 
-  std::ostringstream vtk_filename;
-  vtk_filename << _vtk_prefix << ( this->count++ ) << ".vtu";
-  system.export_vtk ( vtk_filename.str(), false );
+  if ( xdmf )
+    _xdmf = new XDMFTimeSeries ( system, _vtk_prefix, compression );
+
+  // the initial solution of a restarted simulation has been saved before
+  if ( SolverSpecify::Restart.empty() )
+  {
+    std::ostringstream vtk_filename;
+    vtk_filename << _vtk_prefix << ( this->count++ ) << ".vtu";
+    this->_export ( vtk_filename.str(), SolverSpecify::Type==SolverSpecify::TRANSIENT ? SolverSpecify::clock/PhysicalUnit::ps : 0.0 );
+  }
 
   SolverSpecify::SolverType solver_type = this->get_solver().solver_type();
 
@@ -99,7 +116,9 @@ VTKHook::VTKHook ( SolverBase & solver, const std::string & name, void * param)
  * destructor, close file
  */
 VTKHook::~VTKHook()
-{}
+{
+  delete _xdmf;
+}
 
 
 /*----------------------------------------------------------------------
@@ -135,10 +154,8 @@ void VTKHook::post_solve()
 
     if ( std::fabs ( Vscan - this->_v_last ) >= this->_v_step )
     {
-      const SimulationSystem &system = get_solver().get_system();
-
       vtk_filename << _vtk_prefix << ( this->count++ ) << ".vtu";
-      system.export_vtk ( vtk_filename.str(),false );
+      this->_export ( vtk_filename.str(), Vscan/PhysicalUnit::V );
 
       time_sequence.push_back ( std::make_pair ( Vscan/PhysicalUnit::V, vtk_filename.str() ) );
       _v_last = Vscan;
@@ -151,10 +168,8 @@ void VTKHook::post_solve()
 
     if ( std::fabs ( Iscan - this->_i_last ) >= this->_i_step )
     {
-      const SimulationSystem &system = get_solver().get_system();
-
       vtk_filename << _vtk_prefix << ( this->count++ ) << ".vtu";
-      system.export_vtk ( vtk_filename.str(),false );
+      this->_export ( vtk_filename.str(), Iscan/PhysicalUnit::A );
 
       time_sequence.push_back ( std::make_pair ( Iscan/PhysicalUnit::A, vtk_filename.str() ) );
       _i_last = Iscan;
@@ -164,18 +179,14 @@ void VTKHook::post_solve()
 
   if ( SolverSpecify::Type==SolverSpecify::OP )
   {
-    const SimulationSystem &system = get_solver().get_system();
-
-    vtk_filename << _vtk_prefix << ( this->count++ ) << ".vtu";
-    system.export_vtk ( vtk_filename.str(), false );
+    vtk_filename << _vtk_prefix << ( this->count ) << ".vtu";
+    this->_export ( vtk_filename.str(), this->count++ );
   }
 
   if ( SolverSpecify::Type==SolverSpecify::TRACE )
   {
-    const SimulationSystem &system = get_solver().get_system();
-
-    vtk_filename << _vtk_prefix << ( this->count++ ) << ".vtu";
-    system.export_vtk ( vtk_filename.str(), false );
+    vtk_filename << _vtk_prefix << ( this->count ) << ".vtu";
+    this->_export ( vtk_filename.str(), this->count++ );
   }
 
   if ( SolverSpecify::Type==SolverSpecify::TRANSIENT )
@@ -187,10 +198,8 @@ void VTKHook::post_solve()
     {
       if ( SolverSpecify::clock - this->_t_last >= this->_t_step )
       {
-        const SimulationSystem &system = get_solver().get_system();
-
         vtk_filename << _vtk_prefix << ( this->count++ ) << ".vtu";
-        system.export_vtk ( vtk_filename.str(), false );
+        this->_export ( vtk_filename.str(), SolverSpecify::clock/PhysicalUnit::ps );
 
         time_sequence.push_back ( std::make_pair ( SolverSpecify::clock/PhysicalUnit::ps, vtk_filename.str() ) );
         _t_last = SolverSpecify::clock;
@@ -201,10 +210,8 @@ void VTKHook::post_solve()
 
   if ( SolverSpecify::Type==SolverSpecify::ACSWEEP )
   {
-    const SimulationSystem &system = get_solver().get_system();
-
     vtk_filename << _vtk_prefix << ( this->count++ ) << ".vtu";
-    system.export_vtk ( vtk_filename.str(), false );
+    this->_export ( vtk_filename.str(), SolverSpecify::Freq*PhysicalUnit::us );
 
     time_sequence.push_back ( std::make_pair ( SolverSpecify::Freq*PhysicalUnit::us, vtk_filename.str() ) );
     _f_last = SolverSpecify::Freq;
@@ -229,13 +236,30 @@ void VTKHook::post_solve()
       mxml_node_t *eOutput  = mxmlFindElement ( eSolution, eSolution, "output", NULL, NULL, MXML_DESCEND_FIRST );
       mxml_node_t *eVtk = mxmlNewElement ( eOutput, "vtk" );
       mxml_node_t *eFile    = mxmlNewElement ( eVtk, "file" );
-      mxmlAdd ( eFile, MXML_ADD_AFTER, NULL, MXMLQVariant::makeQVString ( vtk_filename.str() ) );
+      mxmlAdd ( eFile, MXML_ADD_AFTER, NULL, MXMLQVariant::makeQVString ( _xdmf ? _xdmf->xdmf_file() : vtk_filename.str() ) );
     }
   }
 }
 
 
 
+/*----------------------------------------------------------------------
+ *  write solution as a vtu file, or a step of xdmf time series at \p value
+ */
+void VTKHook::_export ( const std::string & vtk_filename, double value )
+{
+  if ( _xdmf )
+  {
+    _xdmf->write_step ( value );
+    return;
+  }
+
+  const SimulationSystem &system = get_solver().get_system();
+  system.export_vtk ( vtk_filename, false );
+}
+
+
+
 /*----------------------------------------------------------------------
  *  This is executed after each (nonlinear) iteration
  */
@@ -249,6 +273,13 @@ void VTKHook::post_iteration()
  */
 void VTKHook::on_close()
 {
+  // all the steps should be on disk when solver finished
+  if ( _xdmf )
+  {
+    _xdmf->flush();
+    return;
+  }
+
   if ( time_sequence.size() ==0 ) return;
 
   if ( !Genius::processor_id() )
@@ -273,6 +304,44 @@ void VTKHook::on_close()
 }
 
 
+/*----------------------------------------------------------------------
+ * the file counter and last saved time for checkpoint
+ */
+std::string VTKHook::checkpoint()
+{
+  std::ostringstream state;
+  state << std::setprecision(17);
+  state << count << ' ' << lag_count << ' ' << _t_last << ' ' << time_sequence.size() << '\n';
+  for ( unsigned int n=0; n<time_sequence.size(); ++n )
+    state << time_sequence[n].first << ' ' << time_sequence[n].second << '\n';
+  return state.str();
+}
+
+
+
+/*----------------------------------------------------------------------
+ * resume the file counter and time sequence saved by checkpoint
+ */
+void VTKHook::restart(const std::string & state)
+{
+  std::istringstream ss ( state );
+  unsigned int n_sequence = 0;
+  ss >> count >> lag_count >> _t_last >> n_sequence;
+
+  time_sequence.clear();
+  for ( unsigned int n=0; n<n_sequence && ss; ++n )
+  {
+    double value;
+    std::string file;
+    ss >> value;
+    ss.ignore();
+    std::getline ( ss, file );
+    time_sequence.push_back ( std::make_pair ( value, file ) );
+  }
+}
+
+
+
 #ifdef DLLHOOK
 
 // dll interface
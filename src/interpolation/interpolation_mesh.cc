@@ -0,0 +1,318 @@
+#include <cassert>
+#include <cmath>
+#include <set>
+#include <limits>
+
+#include "genius_common.h"
+#include "parallel.h"
+#include "serial_mesh.h"
+#include "elem.h"
+#include "tree.h"
+#include "fe_type.h"
+#include "fe_interface.h"
+#include "interpolation_mesh.h"
+#include "thread_pool.h"
+
+#include "log.h"
+
+
+/**
+ * parallel loop of InterpolationMesh::get_interpolated_values(),
+ * each thread evaluates a contiguous range of the points
+ */
+class InterpolationMeshLoop : public Genius::ThreadLoopBody
+{
+public:
+  InterpolationMeshLoop(const InterpolationMesh & interpolator, const std::vector<Point> & points, int group, std::vector<double> & values)
+    : _interpolator(interpolator), _points(points), _group(group), _values(values) {}
+
+  void operator() (unsigned int, unsigned int begin, unsigned int end)
+  { _interpolator._interpolate_range(_points, _group, _values, begin, end); }
+
+private:
+  const InterpolationMesh &   _interpolator;
+  const std::vector<Point> &  _points;
+  int                         _group;
+  std::vector<double> &       _values;
+};
+
+
+InterpolationMesh::InterpolationMesh()
+  : _donor(NULL), _tree(NULL)
+{ }
+
+
+InterpolationMesh::~InterpolationMesh()
+{
+  this->clear();
+}
+
+
+void InterpolationMesh::clear()
+{
+  // tree refers to donor mesh, delete it first
+  delete _tree;
+  _tree = NULL;
+  delete _donor;
+  _donor = NULL;
+  _node_elems.clear();
+
+  _field.clear();
+  _field_valid.clear();
+}
+
+
+void InterpolationMesh::set_mesh(const MeshBase & mesh)
+{
+  delete _tree;
+  _tree = NULL;
+  delete _donor;
+
+  // pack the active elements and their nodes of this processor,
+  // element as (type, subdomain, n_nodes, node ids) and node as (id, x, y, z)
+  std::vector<int>  conn;
+  std::vector<Real> pts;
+  std::set<unsigned int> packed_nodes;
+
+  MeshBase::const_element_iterator       el  = mesh.active_this_pid_elements_begin();
+  const MeshBase::const_element_iterator end = mesh.active_this_pid_elements_end();
+  for (; el != end; ++el)
+  {
+    const Elem * elem = *el;
+    conn.push_back(elem->type());
+    conn.push_back(elem->subdomain_id());
+    conn.push_back(elem->n_nodes());
+    for(unsigned int n=0; n<elem->n_nodes(); ++n)
+    {
+      const Node * node = elem->get_node(n);
+      conn.push_back(node->id());
+      if( packed_nodes.insert(node->id()).second )
+      {
+        pts.push_back(node->id());
+        pts.push_back((*node)(0));
+        pts.push_back((*node)(1));
+        pts.push_back((*node)(2));
+      }
+    }
+  }
+
+  Parallel::allgather(conn);
+  Parallel::allgather(pts);
+
+  // build the serial donor mesh with the same node id
+  _donor = new SerialMesh(mesh.mesh_dimension());
+
+  for(unsigned int n=0; n<pts.size(); n+=4)
+    _donor->add_point(Point(pts[n+1], pts[n+2], pts[n+3]), static_cast<unsigned int>(pts[n]));
+
+  _node_elems.clear();
+  _node_elems.resize(_donor->max_node_id());
+  for(unsigned int n=0; n<conn.size(); )
+  {
+    Elem * elem = Elem::build(static_cast<ElemType>(conn[n])).release();
+    elem->subdomain_id() = conn[n+1];
+    unsigned int n_nodes = conn[n+2];
+    for(unsigned int i=0; i<n_nodes; ++i)
+      elem->set_node(i) = _donor->node_ptr(conn[n+3+i]);
+    _donor->add_elem(elem);
+    for(unsigned int i=0; i<n_nodes; ++i)
+      _node_elems[conn[n+3+i]].push_back(elem);
+    n += 3 + n_nodes;
+  }
+
+  _donor->count_mesh_dimension();
+  _donor->build_mesh_bounding_box();
+
+  // the same tree as PointLocatorTree, genius mesh of dimension 2 lies in xy plane.
+  // we search the tree directly, PointLocatorTree fails on missing points of non-affine mesh
+  if( _donor->mesh_dimension() == 3 )
+    _tree = new Trees::OctTree (*_donor, 100, 10, Trees::ELEMENTS);
+  else
+    _tree = new Trees::QuadTree (*_donor, 100, 10, Trees::ELEMENTS);
+}
+
+
+void InterpolationMesh::add_scatter_data(const Point & , int , double )
+{
+  MESSAGE<<"ERROR: Mesh based interpolation requires node data." << std::endl; RECORD();
+  genius_error();
+}
+
+
+void InterpolationMesh::add_node_data(const Node * node, int group, double value)
+{
+  genius_assert(_donor);
+
+  std::vector<double> & field = _field[group];
+  std::vector<int> & valid = _field_valid[group];
+  if( field.size() < _donor->max_node_id() )
+  {
+    field.resize(_donor->max_node_id(), 0.0);
+    valid.resize(_donor->max_node_id(), 0);
+  }
+
+  // nodes of old inactive elements are not in donor mesh
+  if( node->id() >= field.size() || _donor->node_ptr(node->id()) == NULL ) return;
+
+  InterpolationType type = _interpolation_type[group];
+  field[node->id()] = scaleValue(type, value);
+  valid[node->id()] = 1;
+}
+
+
+void InterpolationMesh::setup(int group)
+{
+  genius_assert(_interpolation_type.find(group)!=_interpolation_type.end());
+}
+
+
+void InterpolationMesh::broadcast(unsigned int root)
+{
+  std::vector<int> groups;
+  std::map<int, std::vector<double> >::const_iterator it = _field.begin();
+  for(; it != _field.end(); ++it)
+    groups.push_back(it->first);
+  Parallel::broadcast(groups, root);
+
+  for(unsigned int n=0; n<groups.size(); ++n)
+  {
+    Parallel::broadcast(_field[groups[n]], root);
+    Parallel::broadcast(_field_valid[groups[n]], root);
+
+    int type = _interpolation_type[groups[n]];
+    Parallel::broadcast(type, root);
+    _interpolation_type[groups[n]] = static_cast<InterpolationType>(type);
+  }
+}
+
+
+bool InterpolationMesh::_interpolate(const Elem * elem, const Point & point, int group, double & value) const
+{
+  const std::vector<double> & field = _field.find(group)->second;
+  const std::vector<int> & valid = _field_valid.find(group)->second;
+
+  const unsigned int dim = _donor->mesh_dimension();
+  const FEType fe_type;
+  const Point p = FEInterface::inverse_map(dim, fe_type, elem, point);
+
+  // the shape functions are renormalized over the nodes have value,
+  // i.e. the node lies in other material region than the field defined
+  double v = 0.0, w = 0.0;
+  for(unsigned int n=0; n<elem->n_nodes(); ++n)
+  {
+    unsigned int id = elem->node(n);
+    if( id >= valid.size() || !valid[id] ) continue;
+    double phi = FEInterface::shape(dim, fe_type, elem, n, p);
+    v += phi*field[id];
+    w += phi;
+  }
+
+  if( std::abs(w) < 1e-6 ) return false;
+  value = v/w;
+  return true;
+}
+
+
+double InterpolationMesh::_nearest(const Point & point, int group) const
+{
+  const std::vector<double> & field = _field.find(group)->second;
+  const std::vector<int> & valid = _field_valid.find(group)->second;
+
+  double value = 0.0;
+  Real dist = std::numeric_limits<Real>::max();
+  for(unsigned int id=0; id<valid.size(); ++id)
+  {
+    if( !valid[id] ) continue;
+    Real d = (_donor->point(id) - point).size_sq();
+    if( d < dist )
+    {
+      dist = d;
+      value = field[id];
+    }
+  }
+  return value;
+}
+
+
+const Elem * InterpolationMesh::_locate(const Point & point, const Elem * hint) const
+{
+  if( hint && hint->contains_point(point) ) return hint;
+
+  const Elem * elem = _tree->find_element(point);
+  if( elem ) return elem;
+
+  // the point may lie on the boundary of donor mesh, and be missed by round off error.
+  // check the elements around the nearest donor node with a tolerance in reference coordinate
+  unsigned int nearest = invalid_uint;
+  Real dist = std::numeric_limits<Real>::max();
+  for(unsigned int id=0; id<_node_elems.size(); ++id)
+  {
+    if( _node_elems[id].empty() ) continue;
+    Real d = (_donor->point(id) - point).size_sq();
+    if( d < dist )
+    {
+      dist = d;
+      nearest = id;
+    }
+  }
+  if( nearest == invalid_uint ) return NULL;
+
+  const unsigned int dim = _donor->mesh_dimension();
+  const FEType fe_type;
+  const std::vector<const Elem *> & elems = _node_elems[nearest];
+  for(unsigned int i=0; i<elems.size(); ++i)
+  {
+    const Point p = FEInterface::inverse_map(dim, fe_type, elems[i], point, TOLERANCE, false);
+    if( FEInterface::on_reference_element(p, elems[i]->type(), 1e-3) )
+      return elems[i];
+  }
+
+  return NULL;
+}
+
+
+double InterpolationMesh::get_interpolated_value(const Point & point, int group) const
+{
+  genius_assert(_tree);
+  genius_assert(_field.find(group)!=_field.end());
+
+  InterpolationType type = _interpolation_type.find(group)->second;
+
+  double value;
+  const Elem * elem = _locate(point, NULL);
+  if( !elem || !_interpolate(elem, point, group, value) )
+    value = _nearest(point, group);
+
+  return unscaleValue(type, value);
+}
+
+
+void InterpolationMesh::_interpolate_range(const std::vector<Point> & points, int group, std::vector<double> & values,
+                                           unsigned int begin, unsigned int end) const
+{
+  InterpolationType type = _interpolation_type.find(group)->second;
+
+  // nearby points are adjacent, try the element found last time before tree search
+  const Elem * hint = NULL;
+  for(unsigned int n=begin; n<end; ++n)
+  {
+    double value;
+    const Elem * elem = _locate(points[n], hint);
+    if( elem ) hint = elem;
+    if( !elem || !_interpolate(elem, points[n], group, value) )
+      value = _nearest(points[n], group);
+    values[n] = unscaleValue(type, value);
+  }
+}
+
+
+void InterpolationMesh::get_interpolated_values(const std::vector<Point> & points, int group, std::vector<double> & values) const
+{
+  genius_assert(_tree);
+  genius_assert(_field.find(group)!=_field.end());
+
+  values.resize(points.size());
+
+  InterpolationMeshLoop loop(*this, points, group, values);
+  Genius::parallel_for(points.size(), loop);
+}
@@ -162,6 +162,19 @@ int main(int argc, char ** args)
   if(!log_flg)
     perflog.disable_logging();
 
+  // trace the nested events of performance log into a ring buffer
+  char trace_file[1024];
+  PetscBool     trace_flg;
+  PetscOptionsGetString(PETSC_NULL, "-p_trace", trace_file, 1023, &trace_flg);
+  if(trace_flg)
+  {
+    PetscInt  trace_size = 1048576;
+    PetscBool trace_size_flg;
+    PetscOptionsGetInt(PETSC_NULL, "-p_trace_size", &trace_size, &trace_size_flg);
+    perflog.enable_logging();
+    perflog.enable_trace(trace_size);
+  }
+
   // get the name of user input file by PETSC routine
   {
     PetscBool     file_flg;
@@ -325,6 +338,17 @@ int main(int argc, char ** args)
     MESSAGE<<perf_info; RECORD();
   }
 
+  // trace files, one for each processor
+  if(trace_flg)
+  {
+    std::stringstream trace_ss;
+    trace_ss << trace_file;
+    if(Genius::n_processors() > 1)
+      trace_ss << '.' << Genius::processor_id();
+    perflog.write_trace_json(trace_ss.str() + ".json");
+    perflog.write_trace_binary(trace_ss.str() + ".bin");
+  }
+
   //finish log system
   if (Genius::processor_id() == 0)
   {
@@ -501,9 +501,9 @@ private:
 
 public:
 
-  std::complex<PetscScalar> RefractionIndex(PetscScalar lambda, PetscScalar Tl, PetscScalar Eg=0) const
+  std::complex<PetscScalar> RefractionIndex(const PMI_Context &ctx, PetscScalar lambda, PetscScalar Tl, PetscScalar Eg=0) const
   {
-    PetscScalar mole_x = this->ReadxMoleFraction();
+    PetscScalar mole_x = this->ReadxMoleFraction(ctx);
     if( mole_x <= molex.front() )
       return nk_molex.front().nk(lambda);
     if( mole_x >= molex.back() )
@@ -187,162 +187,162 @@ private:
 public:
   //---------------------------------------------------------------------------
   // we need calculate all the bandgap valley and choose lowest
-  PetscScalar E_Gamma(const PetscScalar &Tl)
+  PetscScalar E_Gamma(const PMI_Context &ctx, const PetscScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
+        PetscScalar x = ReadxMoleFraction(ctx);
         return EG300 + EG_X0 + EG_X1*x + EG_X2*x*x + EG_X3*x*x*x + EG_X4*x*x*x*x
                + (T300*T300/(T300+EGBETA)-Tl*Tl/(Tl+EGBETA))*(EGALPH+EGGAMM*x);
   }
-  AutoDScalar E_Gamma(const AutoDScalar &Tl)
+  AutoDScalar E_Gamma(const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
+        PetscScalar x = ReadxMoleFraction(ctx);
         return EG300 + EG_X0 + EG_X1*x + EG_X2*x*x + EG_X3*x*x*x + EG_X4*x*x*x*x
                + (T300*T300/(T300+EGBETA)-Tl*Tl/(Tl+EGBETA))*(EGALPH+EGGAMM*x);
   }
 
-  PetscScalar E_X(const PetscScalar &Tl)
+  PetscScalar E_X(const PMI_Context &ctx, const PetscScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
+        PetscScalar x = ReadxMoleFraction(ctx);
         return EG300 + EG_X5 + EG_X6*x + EG_X7*x*x + EG_X8*x*x*x + EG_X9*x*x*x*x
                + (T300*T300/(T300+EGBEX)-Tl*Tl/(Tl+EGBEX))*(EGALX+EGGAX*x);
   }
-  AutoDScalar E_X(const AutoDScalar &Tl)
+  AutoDScalar E_X(const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
+        PetscScalar x = ReadxMoleFraction(ctx);
         return EG300 + EG_X5 + EG_X6*x + EG_X7*x*x + EG_X8*x*x*x + EG_X9*x*x*x*x
                + (T300*T300/(T300+EGBEX)-Tl*Tl/(Tl+EGBEX))*(EGALX+EGGAX*x);
   }
 
-  PetscScalar E_L(const PetscScalar &Tl)
+  PetscScalar E_L(const PMI_Context &ctx, const PetscScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
+        PetscScalar x = ReadxMoleFraction(ctx);
         return EG300 + EG_X10 + EG_X11*x + EG_X12*x*x + EG_X13*x*x*x + EG_X14*x*x*x*x
                + (T300*T300/(T300+EGBEL)-Tl*Tl/(Tl+EGBEL))*(EGALL+EGGAL*x);
   }
-  AutoDScalar E_L(const AutoDScalar &Tl)
+  AutoDScalar E_L(const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
+        PetscScalar x = ReadxMoleFraction(ctx);
         return EG300 + EG_X10 + EG_X11*x + EG_X12*x*x + EG_X13*x*x*x + EG_X14*x*x*x*x
                + (T300*T300/(T300+EGBEL)-Tl*Tl/(Tl+EGBEL))*(EGALL+EGGAL*x);
   }
 
   //---------------------------------------------------------------------------
   // procedure of Bandgap, return the lowest valley
-  PetscScalar Eg (const PetscScalar &Tl)
+  PetscScalar Eg (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar Eg1 = E_Gamma(Tl);
-    PetscScalar Eg2 = E_X(Tl);
+    PetscScalar Eg1 = E_Gamma(ctx, Tl);
+    PetscScalar Eg2 = E_X(ctx, Tl);
     return std::min(Eg1 , Eg2);
   }
-  AutoDScalar Eg (const AutoDScalar &Tl)
+  AutoDScalar Eg (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-    AutoDScalar Eg1 = E_Gamma(Tl);
-    AutoDScalar Eg2 = E_X(Tl);
+    AutoDScalar Eg1 = E_Gamma(ctx, Tl);
+    AutoDScalar Eg2 = E_X(ctx, Tl);
     return fmin( Eg1 , Eg2);
   }
 
 
   //---------------------------------------------------------------------------
   // procedure of Bandgap Narrowing due to Heavy Doping
-  PetscScalar EgNarrow(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar EgNarrow(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     PetscScalar x = log(N/N0_BGN);
     return V0_BGN*(x+sqrt(x*x+CON_BGN));
   }
-  PetscScalar EgNarrowToEc   (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
-  PetscScalar EgNarrowToEv   (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
+  PetscScalar EgNarrowToEc   (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
+  PetscScalar EgNarrowToEv   (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
 
-  AutoDScalar EgNarrow(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar EgNarrow(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     PetscScalar x = log(N/N0_BGN);
     return V0_BGN*(x+sqrt(x*x+CON_BGN));
   }
-  AutoDScalar EgNarrowToEc   (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
-  AutoDScalar EgNarrowToEv   (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
+  AutoDScalar EgNarrowToEc   (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
+  AutoDScalar EgNarrowToEv   (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
 
 
   //---------------------------------------------------------------------------
   //electron and hole effect mass
-  PetscScalar EffecElecMass(const PetscScalar &Tl)
+  PetscScalar EffecElecMass(const PMI_Context &ctx, const PetscScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
-        PetscScalar bandgap = Eg(Tl);
+        PetscScalar x = ReadxMoleFraction(ctx);
+        PetscScalar bandgap = Eg(ctx, Tl);
 
-        PetscScalar m_Gamma = std::pow(std::pow(MEG+MEG_X1*x,pm)*exp((bandgap-E_Gamma(Tl))/(kb*Tl)),1.0/pm);
-        PetscScalar m_X = std::pow(std::pow(MEX+MEX_X1*x,pm)*exp((bandgap-E_X(Tl))/(kb*Tl)),1.0/pm);
-        PetscScalar m_L = std::pow(std::pow(MEL+MEL_X1*x,pm)*exp((bandgap-E_L(Tl))/(kb*Tl)),1.0/pm);
+        PetscScalar m_Gamma = std::pow(std::pow(MEG+MEG_X1*x,pm)*exp((bandgap-E_Gamma(ctx, Tl))/(kb*Tl)),1.0/pm);
+        PetscScalar m_X = std::pow(std::pow(MEX+MEX_X1*x,pm)*exp((bandgap-E_X(ctx, Tl))/(kb*Tl)),1.0/pm);
+        PetscScalar m_L = std::pow(std::pow(MEL+MEL_X1*x,pm)*exp((bandgap-E_L(ctx, Tl))/(kb*Tl)),1.0/pm);
         return std::pow(std::pow(m_Gamma,pm)+std::pow(m_X,pm)+std::pow(m_L,pm),1.0/pm);
   }
-  AutoDScalar EffecElecMass(const AutoDScalar &Tl)
+  AutoDScalar EffecElecMass(const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
-        AutoDScalar bandgap = Eg(Tl);
+        PetscScalar x = ReadxMoleFraction(ctx);
+        AutoDScalar bandgap = Eg(ctx, Tl);
 
-        AutoDScalar m_Gamma = adtl::pow(std::pow(MEG+MEG_X1*x,pm)*exp((bandgap-E_Gamma(Tl))/(kb*Tl)),1.0/pm);
-        AutoDScalar m_X = adtl::pow(std::pow(MEX+MEX_X1*x,pm)*exp((bandgap-E_X(Tl))/(kb*Tl)),1.0/pm);
-        AutoDScalar m_L = adtl::pow(std::pow(MEL+MEL_X1*x,pm)*exp((bandgap-E_L(Tl))/(kb*Tl)),1.0/pm);
+        AutoDScalar m_Gamma = adtl::pow(std::pow(MEG+MEG_X1*x,pm)*exp((bandgap-E_Gamma(ctx, Tl))/(kb*Tl)),1.0/pm);
+        AutoDScalar m_X = adtl::pow(std::pow(MEX+MEX_X1*x,pm)*exp((bandgap-E_X(ctx, Tl))/(kb*Tl)),1.0/pm);
+        AutoDScalar m_L = adtl::pow(std::pow(MEL+MEL_X1*x,pm)*exp((bandgap-E_L(ctx, Tl))/(kb*Tl)),1.0/pm);
         return adtl::pow(adtl::pow(m_Gamma,pm)+adtl::pow(m_X,pm)+adtl::pow(m_L,pm),1.0/pm);
   }
 
-  PetscScalar EffecHoleMass(const PetscScalar &Tl)
+  PetscScalar EffecHoleMass(const PMI_Context &ctx, const PetscScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
+        PetscScalar x = ReadxMoleFraction(ctx);
         return std::pow(std::pow(MH0+MH0_X1*x,pm)+std::pow(ML0+ML0_X1*x,pm),1.0/pm);
   }
-  AutoDScalar EffecHoleMass(const AutoDScalar &Tl)
+  AutoDScalar EffecHoleMass(const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-        PetscScalar x = ReadxMoleFraction();
+        PetscScalar x = ReadxMoleFraction(ctx);
         return std::pow(std::pow(MH0+MH0_X1*x,pm)+std::pow(ML0+ML0_X1*x,pm),1.0/pm);
   }
 
 
   //---------------------------------------------------------------------------
   // Nc and Nv calculated from effective mass
-  PetscScalar Nc (const PetscScalar &Tl)
+  PetscScalar Nc (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     //return NC300*std::pow(Tl/T300,NC_F);
-    return 2*std::pow(2*3.14159265359*EffecElecMass(Tl)*kb*Tl/(h*h),pm);
+    return 2*std::pow(2*3.14159265359*EffecElecMass(ctx, Tl)*kb*Tl/(h*h),pm);
   }
-  AutoDScalar Nc (const AutoDScalar &Tl)
+  AutoDScalar Nc (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     //return NC300*adtl::pow(Tl/T300,NC_F);
-    return 2*adtl::pow(2*3.14159265359*EffecElecMass(Tl)*kb*Tl/(h*h),pm);
+    return 2*adtl::pow(2*3.14159265359*EffecElecMass(ctx, Tl)*kb*Tl/(h*h),pm);
   }
 
-  PetscScalar Nv (const PetscScalar &Tl)
+  PetscScalar Nv (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     //return NV300*std::pow(Tl/T300,NV_F);
-    return 2*std::pow(2*3.14159265359*EffecHoleMass(Tl)*kb*Tl/(h*h),pm);
+    return 2*std::pow(2*3.14159265359*EffecHoleMass(ctx, Tl)*kb*Tl/(h*h),pm);
   }
-  AutoDScalar Nv (const AutoDScalar &Tl)
+  AutoDScalar Nv (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     //return NV300*adtl::pow(Tl/T300,NV_F);
-    return 2*adtl::pow(2*3.14159265359*EffecHoleMass(Tl)*kb*Tl/(h*h),pm);
+    return 2*adtl::pow(2*3.14159265359*EffecHoleMass(ctx, Tl)*kb*Tl/(h*h),pm);
   }
 
   //---------------------------------------------------------------------------
-  PetscScalar ni (const PetscScalar &Tl)
+  PetscScalar ni (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar bandgap = Eg(Tl);
-    return sqrt(Nc(Tl)*Nv(Tl))*exp(-bandgap/(2*kb*Tl));
+    PetscScalar bandgap = Eg(ctx, Tl);
+    return sqrt(Nc(ctx, Tl)*Nv(ctx, Tl))*exp(-bandgap/(2*kb*Tl));
   }
 
   // nie, Eg narrow should be considered
-  PetscScalar nie (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar nie (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar bandgap = Eg(Tl);
-    return sqrt(Nc(Tl)*Nv(Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(p, n, Tl)/(2*kb*Tl));
+    PetscScalar bandgap = Eg(ctx, Tl);
+    return sqrt(Nc(ctx, Tl)*Nv(ctx, Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(ctx, p, n, Tl)/(2*kb*Tl));
   }
-  AutoDScalar nie (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar nie (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar bandgap = Eg(Tl);
-    return sqrt(Nc(Tl)*Nv(Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(p, n, Tl)/(2*kb*Tl));
+    AutoDScalar bandgap = Eg(ctx, Tl);
+    return sqrt(Nc(ctx, Tl)*Nv(ctx, Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(ctx, p, n, Tl)/(2*kb*Tl));
   }
   //end of Bandgap
 
@@ -413,31 +413,31 @@ private:
 public:
   //---------------------------------------------------------------------------
   // electron lift time for SHR Recombination
-  PetscScalar TAUN (const PetscScalar &Tl)
+  PetscScalar TAUN (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return TAUN0/(1+(Na+Nd)/NSRHN)*std::pow(Tl/T300,EXN_TAU);
   }
-  AutoDScalar TAUN (const AutoDScalar &Tl)
+  AutoDScalar TAUN (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return TAUN0/(1+(Na+Nd)/NSRHN)*adtl::pow(Tl/T300,EXN_TAU);
   }
 
   //---------------------------------------------------------------------------
   // hole lift time for SHR Recombination
-  PetscScalar TAUP (const PetscScalar &Tl)
+  PetscScalar TAUP (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return TAUP0/(1+(Na+Nd)/NSRHP)*std::pow(Tl/T300,EXP_TAU);
   }
-  AutoDScalar TAUP (const AutoDScalar &Tl)
+  AutoDScalar TAUP (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return TAUP0/(1+(Na+Nd)/NSRHP)*adtl::pow(Tl/T300,EXP_TAU);
   }
   // End of Lifetime
@@ -485,92 +485,92 @@ public:
   /**
    * @return direct Recombination rate
    */
-  PetscScalar CDIR           (const PetscScalar &Tl)  { return C_DIRECT; }
+  PetscScalar CDIR           (const PMI_Context &ctx, const PetscScalar &Tl)  { return C_DIRECT; }
 
   /**
    * @return electron Auger Recombination rate
    */
-  PetscScalar AUGERN           (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) { return AUGN; }
+  PetscScalar AUGERN           (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) { return AUGN; }
 
   /**
    * @return hole Auger Recombination rate
    */
-  PetscScalar AUGERP           (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)  { return AUGP; }
+  PetscScalar AUGERP           (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)  { return AUGP; }
 
   //---------------------------------------------------------------------------
   // Direct Recombination
-  PetscScalar R_Direct     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Direct     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
     return C_DIRECT*(n*p-ni*ni);
   }
-  AutoDScalar R_Direct     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Direct     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
     return C_DIRECT*(n*p-ni*ni);
   }
 
   //---------------------------------------------------------------------------
   // Total Auger Recombination
-  PetscScalar R_Auger     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Auger     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
     return AUGN*(p*n*n-n*ni*ni)+AUGP*(n*p*p-p*ni*ni);
   }
-  AutoDScalar R_Auger     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Auger     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
     return AUGN*(p*n*n-n*ni*ni)+AUGP*(n*p*p-p*ni*ni);
   }
 
   //---------------------------------------------------------------------------
   // Electron Auger Recombination
-  PetscScalar R_Auger_N     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Auger_N     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
     return AUGN*(p*n*n-n*ni*ni);
   }
-  AutoDScalar R_Auger_N     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Auger_N     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
     return AUGN*(p*n*n-n*ni*ni);
   }
   //---------------------------------------------------------------------------
   // Hole Auger Recombination
-  PetscScalar R_Auger_P     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Auger_P     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
     return AUGP*(n*p*p-p*ni*ni);
   }
-  AutoDScalar R_Auger_P     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Auger_P     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
     return AUGP*(n*p*p-p*ni*ni);
   }
 
 
   //---------------------------------------------------------------------------
   // SHR Recombination
-  PetscScalar R_SHR     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_SHR     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
-    PetscScalar taun = TAUN(Tl);
-    PetscScalar taup = TAUP(Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
+    PetscScalar taun = TAUN(ctx, Tl);
+    PetscScalar taup = TAUP(ctx, Tl);
     return (p*n-ni*ni)/(taup*(n+ni)+taun*(p+ni));
   }
-  AutoDScalar R_SHR     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_SHR     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
-    AutoDScalar taun = TAUN(Tl);
-    AutoDScalar taup = TAUP(Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
+    AutoDScalar taun = TAUN(ctx, Tl);
+    AutoDScalar taup = TAUP(ctx, Tl);
     return (p*n-ni*ni)/(taup*(n+ni)+taun*(p+ni));
   }
 
   //---------------------------------------------------------------------------
   // Surface SHR Recombination
-  PetscScalar R_Surf     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Surf     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
 
     PetscScalar seps = 1e-8 * cm/s; // a very small recomb velocity
     if (STAUN < seps || STAUP < seps)
@@ -578,9 +578,9 @@ public:
     else
       return (p*n - ni*ni) / ((n+ni)/STAUP + (p+ni)/STAUN);
   }
-  AutoDScalar R_Surf     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Surf     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
 
     PetscScalar seps = 1e-8 * cm/s; // a very small recomb velocity
     if (STAUN < seps || STAUP < seps)
@@ -591,22 +591,22 @@ public:
 
   //---------------------------------------------------------------------------
   // total Recombination
-  PetscScalar Recomb (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar Recomb (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
-    PetscScalar taun = TAUN(Tl);
-    PetscScalar taup = TAUP(Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
+    PetscScalar taun = TAUN(ctx, Tl);
+    PetscScalar taup = TAUP(ctx, Tl);
     PetscScalar dn   = p*n-ni*ni;
     PetscScalar Rshr = dn/(taup*(n+ni)+taun*(p+ni));
     PetscScalar Rdir = C_DIRECT*dn;
     PetscScalar Raug = (AUGN*n+AUGP*p)*dn;
     return Rshr+Rdir+Raug;
   }
-  AutoDScalar Recomb (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar Recomb (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
-    AutoDScalar taun = TAUN(Tl);
-    AutoDScalar taup = TAUP(Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
+    AutoDScalar taun = TAUN(ctx, Tl);
+    AutoDScalar taup = TAUP(ctx, Tl);
     AutoDScalar dn   = p*n-ni*ni;
     AutoDScalar Rshr = dn/(taup*(n+ni)+taun*(p+ni));
     AutoDScalar Rdir = C_DIRECT*dn;
@@ -662,12 +662,12 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron relaxation time for EBM
-  PetscScalar ElecEnergyRelaxTime(const PetscScalar &Tn,const PetscScalar &Tl)
+  PetscScalar ElecEnergyRelaxTime(const PMI_Context &ctx, const PetscScalar &Tn,const PetscScalar &Tl)
   {
     PetscScalar r = (Tn-Tl)/TNL;
     return WTN1+(WTN0-WTN1)*r*r*exp(2-2*r);
   }
-  AutoDScalar ElecEnergyRelaxTime(const AutoDScalar &Tn,const AutoDScalar &Tl)
+  AutoDScalar ElecEnergyRelaxTime(const PMI_Context &ctx, const AutoDScalar &Tn,const AutoDScalar &Tl)
   {
     AutoDScalar r = (Tn-Tl)/TNL;
     return WTN1+(WTN0-WTN1)*r*r*exp(2-2*r);
@@ -675,11 +675,11 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole relaxation time for EBM
-  PetscScalar HoleEnergyRelaxTime(const PetscScalar &Tp,const PetscScalar &Tl)
+  PetscScalar HoleEnergyRelaxTime(const PMI_Context &ctx, const PetscScalar &Tp,const PetscScalar &Tl)
   {
     return WTPL;
   }
-  AutoDScalar HoleEnergyRelaxTime(const AutoDScalar &Tp,const AutoDScalar &Tl)
+  AutoDScalar HoleEnergyRelaxTime(const PMI_Context &ctx, const AutoDScalar &Tp,const AutoDScalar &Tl)
   {
     return WTPL;
   }
@@ -703,80 +703,80 @@ private:
 #endif
   }
 public:
-  PetscScalar ARichN()
+  PetscScalar ARichN(const PMI_Context &ctx)
   { return ARICHN; }
 
-  PetscScalar ARichP()
+  PetscScalar ARichP(const PMI_Context &ctx)
   { return ARICHP; }
 
-  PetscScalar SchottyJsn (PetscScalar n,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar SchottyJsn (const PMI_Context &ctx, PetscScalar n,PetscScalar Tl,PetscScalar Vb)
   {
-    PetscScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(Tl));
-    PetscScalar nb = Nc(Tl)*exp(-e*Vb/(kb*Tl));
+    PetscScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(ctx, Tl));
+    PetscScalar nb = Nc(ctx, Tl)*exp(-e*Vb/(kb*Tl));
     return -e*VSURFN*(n-nb);
   }
-  AutoDScalar SchottyJsn (AutoDScalar n,AutoDScalar Tl,AutoDScalar Vb)
+  AutoDScalar SchottyJsn (const PMI_Context &ctx, AutoDScalar n,AutoDScalar Tl,AutoDScalar Vb)
   {
-    AutoDScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(Tl));
-    AutoDScalar nb = Nc(Tl)*exp(-e*Vb/(kb*Tl));
+    AutoDScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(ctx, Tl));
+    AutoDScalar nb = Nc(ctx, Tl)*exp(-e*Vb/(kb*Tl));
     return -e*VSURFN*(n-nb);
   }
 
-  PetscScalar SchottyJsp (PetscScalar p,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar SchottyJsp (const PMI_Context &ctx, PetscScalar p,PetscScalar Tl,PetscScalar Vb)
   {
-    PetscScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(Tl));
-    PetscScalar pb = Nv(Tl)*exp((-Eg(Tl)+e*Vb)/(kb*Tl));
+    PetscScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(ctx, Tl));
+    PetscScalar pb = Nv(ctx, Tl)*exp((-Eg(ctx, Tl)+e*Vb)/(kb*Tl));
     return e*VSURFP*(p-pb);
   }
-  AutoDScalar SchottyJsp (AutoDScalar p,AutoDScalar Tl,AutoDScalar Vb)
+  AutoDScalar SchottyJsp (const PMI_Context &ctx, AutoDScalar p,AutoDScalar Tl,AutoDScalar Vb)
   {
-    AutoDScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(Tl));
-    AutoDScalar pb = Nv(Tl)*exp((-Eg(Tl)+e*Vb)/(kb*Tl));
+    AutoDScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(ctx, Tl));
+    AutoDScalar pb = Nv(ctx, Tl)*exp((-Eg(ctx, Tl)+e*Vb)/(kb*Tl));
     return e*VSURFP*(p-pb);
   }
 
-  PetscScalar SchottyBarrierLowerring (PetscScalar eps, PetscScalar E)
+  PetscScalar SchottyBarrierLowerring (const PMI_Context &ctx, PetscScalar eps, PetscScalar E)
   {
     return sqrt(e/(4*3.1415926535*eps)*E);
   }
-  PetscScalar pdSchottyJsn_pdn(PetscScalar n,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar pdSchottyJsn_pdn(const PMI_Context &ctx, PetscScalar n,PetscScalar Tl,PetscScalar Vb)
   {
-    PetscScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(Tl));
+    PetscScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(ctx, Tl));
     return -e*VSURFN;
   }
-  PetscScalar pdSchottyJsp_pdp(PetscScalar p,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar pdSchottyJsp_pdp(const PMI_Context &ctx, PetscScalar p,PetscScalar Tl,PetscScalar Vb)
   {
-    PetscScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(Tl));
+    PetscScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(ctx, Tl));
     return e*VSURFP;
   }
-  PetscScalar pdSchottyJsn_pdTl(PetscScalar n,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar pdSchottyJsn_pdTl(const PMI_Context &ctx, PetscScalar n,PetscScalar Tl,PetscScalar Vb)
   {
     //use finite difference approximate
-    PetscScalar dJ = SchottyJsn(n,Tl,Vb)-SchottyJsn(n,(1-1e-10)*Tl,Vb);
+    PetscScalar dJ = SchottyJsn(ctx, n,Tl,Vb)-SchottyJsn(ctx, n,(1-1e-10)*Tl,Vb);
     return dJ/(1e-10*Tl);
   }
-  PetscScalar pdSchottyJsp_pdTl(PetscScalar p,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar pdSchottyJsp_pdTl(const PMI_Context &ctx, PetscScalar p,PetscScalar Tl,PetscScalar Vb)
   {
     //use finite difference approximate
-    PetscScalar dJ = SchottyJsp(p,Tl,Vb)-SchottyJsp(p,(1-1e-10)*Tl,Vb);
+    PetscScalar dJ = SchottyJsp(ctx, p,Tl,Vb)-SchottyJsp(ctx, p,(1-1e-10)*Tl,Vb);
     return dJ/(1e-10*Tl);
   }
 
-  PetscScalar ThermalVn (PetscScalar Tl)
+  PetscScalar ThermalVn (const PMI_Context &ctx, PetscScalar Tl)
   {
-        return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(Tl)));
+        return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(ctx, Tl)));
   }
-  AutoDScalar ThermalVn (AutoDScalar Tl)
+  AutoDScalar ThermalVn (const PMI_Context &ctx, AutoDScalar Tl)
   {
-        return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(Tl)));
+        return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(ctx, Tl)));
   }
-  PetscScalar ThermalVp (PetscScalar Tl)
+  PetscScalar ThermalVp (const PMI_Context &ctx, PetscScalar Tl)
   {
-        return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(Tl)));
+        return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(ctx, Tl)));
   }
-  AutoDScalar ThermalVp (AutoDScalar Tl)
+  AutoDScalar ThermalVp (const PMI_Context &ctx, AutoDScalar Tl)
   {
-        return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(Tl)));
+        return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(ctx, Tl)));
   }
   PetscScalar pdThermalVn_pdTl (PetscScalar Tl)
   {
@@ -803,13 +803,13 @@ private:
 public:
   //----------------------------------------------------------------
   // band to band Tunneling
-  PetscScalar BB_Tunneling(const PetscScalar &Tl,const  PetscScalar &E)
+  PetscScalar BB_Tunneling(const PMI_Context &ctx, const PetscScalar &Tl,const  PetscScalar &E)
   {
-     return A_BTBT*E*E/sqrt(Eg(Tl))*exp(-B_BTBT*std::pow(Eg(Tl),PetscScalar(1.5))/(E+1*V/cm));
+     return A_BTBT*E*E/sqrt(Eg(ctx, Tl))*exp(-B_BTBT*std::pow(Eg(ctx, Tl),PetscScalar(1.5))/(E+1*V/cm));
   }
-  AutoDScalar BB_Tunneling(const AutoDScalar &Tl,const  AutoDScalar &E)
+  AutoDScalar BB_Tunneling(const PMI_Context &ctx, const AutoDScalar &Tl,const  AutoDScalar &E)
   {
-     return A_BTBT*E*E/sqrt(Eg(Tl))*exp(-B_BTBT*adtl::pow(Eg(Tl),PetscScalar(1.5))/(E+1*V/cm));
+     return A_BTBT*E*E/sqrt(Eg(ctx, Tl))*exp(-B_BTBT*adtl::pow(Eg(ctx, Tl),PetscScalar(1.5))/(E+1*V/cm));
   }
 
 
@@ -74,22 +74,22 @@ private:
 #endif
   }
 public:
-  PetscScalar Density       (const PetscScalar &Tl) const
+  PetscScalar Density       (const PMI_Context &ctx, const PetscScalar &Tl) const
   {
   	return DENSITY;
   }
-  PetscScalar Permittivity() const
+  PetscScalar Permittivity(const PMI_Context &ctx) const
   {
-        PetscScalar mole_x = ReadxMoleFraction();
+        PetscScalar mole_x = ReadxMoleFraction(ctx);
         return PERMITTI + EPS_X1*mole_x + EPS_X2*mole_x*mole_x;
   }
-  PetscScalar Permeability() const
+  PetscScalar Permeability(const PMI_Context &ctx) const
   {
   	return PERMEABI;
   }
-  PetscScalar Affinity      (const PetscScalar &Tl) const
+  PetscScalar Affinity      (const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-        PetscScalar mole_x = ReadxMoleFraction();
+        PetscScalar mole_x = ReadxMoleFraction(ctx);
         if(mole_x<AF_XL)
                 return AFFINITY + AF_X0 + AF_X1*mole_x + AF_X2*mole_x*mole_x;
         else
@@ -102,7 +102,8 @@ public:
     atoms.push_back(Atom("Gallium",   "Ga", 31, 69.72)); //Gallium
     atoms.push_back(Atom("Arsenic",   "As", 33, 74.922)); //Arsenic
 
-    PetscScalar mole_x = ReadxMoleFraction();
+    // region level, no node is evaluated here
+    PetscScalar mole_x = ReadxMoleFraction(PMI_Context());
     fraction.push_back(mole_x);
     fraction.push_back(1.0-mole_x);
     fraction.push_back(1.0);
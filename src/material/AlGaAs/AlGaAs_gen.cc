@@ -80,7 +80,7 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron Impact Ionization rate for DDM
-  PetscScalar ElecGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
+  PetscScalar ElecGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
   {
     if (Ep < 1e3*V/cm)
     {
@@ -93,7 +93,7 @@ public:
       return alpha*exp(-std::pow(Eg/(e*L)/Ep,EXN_II));
     }
   }
-  AutoDScalar ElecGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
+  AutoDScalar ElecGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
   {
     if (Ep < 1e3*V/cm)
     {
@@ -110,7 +110,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole Impact Ionization rate for DDM
-  PetscScalar HoleGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
+  PetscScalar HoleGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
   {
     if (Ep < 1e3*V/cm)
     {
@@ -123,7 +123,7 @@ public:
       return alpha*exp(-std::pow(Eg/(e*L)/Ep,EXP_II));
     }
   }
-  AutoDScalar HoleGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
+  AutoDScalar HoleGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
   {
     if (Ep < 1e3*V/cm)
     {
@@ -141,7 +141,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Electron Impact Ionization rate for EBM
-  PetscScalar ElecGenRateEBM (const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const
+  PetscScalar ElecGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const
   {
     if (fabs(Tn - Tl)<1*K)
     {
@@ -157,7 +157,7 @@ public:
       return N_IONIZA/e*exp(-std::pow(uc/ut,EXN_II));
     }
   }
-  AutoDScalar ElecGenRateEBM (const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const
+  AutoDScalar ElecGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const
   {
     if (fabs(Tn - Tl)<1*K)
     {
@@ -176,7 +176,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole Impact Ionization rate for EBM
-  PetscScalar HoleGenRateEBM (const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const
+  PetscScalar HoleGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const
   {
     if (fabs(Tp - Tl)<1*K)
     {
@@ -192,7 +192,7 @@ public:
       return P_IONIZA/e*exp(-std::pow(uc/ut,EXP_II));
     }
   }
-  AutoDScalar HoleGenRateEBM (const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const
+  AutoDScalar HoleGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const
   {
     if (fabs(Tp - Tl)<1*K)
     {
@@ -142,21 +142,21 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron low field mobility
-  PetscScalar ElecMobLowField(const PetscScalar &Tl) const
+  PetscScalar ElecMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
-    PetscScalar x = ReadxMoleFraction();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
+    PetscScalar x = ReadxMoleFraction(ctx);
     PetscScalar mu_min = MUN_MIN*(1+MIN_X1*x+MIN_X2*x*x);
     PetscScalar mu_max = MUN_MAX*(1+MAN_X1*x+MAN_X2*x*x);
     return mu_min+(mu_max*std::pow(Tl/T300,NUN)-mu_min)/ \
            (1+std::pow(Tl/T300,XIN)*(std::pow((Na+Nd)/NREFN,ALPHAN)+std::pow((Na+Nd)/NREFN2,3)));
   }
-  AutoDScalar ElecMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar ElecMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
-    PetscScalar x = ReadxMoleFraction();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
+    PetscScalar x = ReadxMoleFraction(ctx);
     PetscScalar mu_min = MUN_MIN*(1+MIN_X1*x+MIN_X2*x*x);
     PetscScalar mu_max = MUN_MAX*(1+MAN_X1*x+MAN_X2*x*x);
     return mu_min+(mu_max*adtl::pow(Tl/T300,NUN)-mu_min)/ \
@@ -165,21 +165,21 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole low field mobility
-  PetscScalar HoleMobLowField(const PetscScalar &Tl) const
+  PetscScalar HoleMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
-    PetscScalar x = ReadxMoleFraction();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
+    PetscScalar x = ReadxMoleFraction(ctx);
     PetscScalar mu_min = MUP_MIN*(1+MIP_X1*x+MIP_X2*x*x);
     PetscScalar mu_max = MUP_MAX*(1+MAP_X1*x+MAP_X2*x*x);
     return mu_min+(mu_max*std::pow(Tl/T300,NUP)-mu_min)/ \
            (1+std::pow(Tl/T300,XIP)*(std::pow((Na+Nd)/NREFP,ALPHAP)+std::pow((Na+Nd)/NREFP2,3)));
   }
-  AutoDScalar HoleMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar HoleMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
-    PetscScalar x = ReadxMoleFraction();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
+    PetscScalar x = ReadxMoleFraction(ctx);
     PetscScalar mu_min = MUP_MIN*(1+MIP_X1*x+MIP_X2*x*x);
     PetscScalar mu_max = MUP_MAX*(1+MAP_X1*x+MAP_X2*x*x);
     return mu_min+(mu_max*adtl::pow(Tl/T300,NUP)-mu_min)/ \
@@ -190,36 +190,36 @@ public:
 public:
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
-    PetscScalar x = ReadxMoleFraction();
+    PetscScalar x = ReadxMoleFraction(ctx);
     PetscScalar vsat = VSATN*(1+ VSN1*x + VSN2*x*x);
     PetscScalar E0   = E0N*(1+EN1*x+EN2*x*x);
-    PetscScalar mu0  = ElecMobLowField(Tl);
+    PetscScalar mu0  = ElecMobLowField(ctx, Tl);
     return (mu0+vsat*std::pow(Ep,3)/std::pow(E0,4))/(1+std::pow(Ep/E0,4));
   }
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
-    PetscScalar x = ReadxMoleFraction();
+    PetscScalar x = ReadxMoleFraction(ctx);
     PetscScalar vsat = VSATN*(1+ VSN1*x + VSN2*x*x);
     PetscScalar E0   = E0N*(1+EN1*x+EN2*x*x);
-    AutoDScalar mu0  = ElecMobLowField(Tl);
+    AutoDScalar mu0  = ElecMobLowField(ctx, Tl);
     return (mu0+vsat*adtl::pow(Ep,3)/std::pow(E0,4))/(1+adtl::pow(Ep/E0,4));
   }
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
-    return HoleMobLowField(Tl);
+    return HoleMobLowField(ctx, Tl);
   }
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
-    return HoleMobLowField(Tl);
+    return HoleMobLowField(ctx, Tl);
   }
 
 
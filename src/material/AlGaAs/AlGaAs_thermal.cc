@@ -72,12 +72,12 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Heat Capacity
-  PetscScalar HeatCapacity  (const PetscScalar &Tl) const
+  PetscScalar HeatCapacity  (const PMI_Context &ctx, const PetscScalar &Tl) const
   {
     return A_SP_HEA + B_SP_HEA*Tl + C_SP_HEA*Tl*Tl + D_SP_HEA/Tl/Tl
            + F_SP_HEA*Tl*Tl*Tl + G_SP_HEA*Tl*Tl*Tl*Tl;
   }
-  AutoDScalar HeatCapacity  (const AutoDScalar &Tl) const
+  AutoDScalar HeatCapacity  (const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
     return A_SP_HEA + B_SP_HEA*Tl + C_SP_HEA*Tl*Tl + D_SP_HEA/Tl/Tl
            + F_SP_HEA*Tl*Tl*Tl + G_SP_HEA*Tl*Tl*Tl*Tl;
@@ -85,11 +85,11 @@ public:
 
   //---------------------------------------------------------------------------
   // Heat Conduction
-  PetscScalar HeatConduction(const PetscScalar &Tl) const
+  PetscScalar HeatConduction(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
     return 1.0/(A_TH_CON + B_TH_CON*Tl + C_TH_CON*Tl*Tl + D_TH_CON*std::pow(Tl,E_TH_CON));
   }
-  AutoDScalar HeatConduction(const AutoDScalar &Tl) const
+  AutoDScalar HeatConduction(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
     return 1.0/(A_TH_CON + B_TH_CON*Tl + C_TH_CON*Tl*Tl);
   }
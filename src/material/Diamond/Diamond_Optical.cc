@@ -36,7 +36,7 @@ private:
   }
 
 public:
-  std::complex<PetscScalar> RefractionIndex(PetscScalar lamda, PetscScalar Tl, PetscScalar Eg=0) const
+  std::complex<PetscScalar> RefractionIndex(const PMI_Context &ctx, PetscScalar lamda, PetscScalar Tl, PetscScalar Eg=0) const
   {
     std::complex<PetscScalar> n(2.4,0.0);
     return n;
@@ -82,106 +82,106 @@ private:
 public:
   //---------------------------------------------------------------------------
   // procedure of Bandgap
-  PetscScalar Eg (const PetscScalar &Tl)
+  PetscScalar Eg (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     return EG300+EGALPH*(T300*T300/(T300+EGBETA) - Tl*Tl/(Tl+EGBETA));
   }
-  AutoDScalar Eg (const AutoDScalar &Tl)
+  AutoDScalar Eg (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     return EG300+EGALPH*(T300*T300/(T300+EGBETA) - Tl*Tl/(Tl+EGBETA));
   }
 
   //---------------------------------------------------------------------------
   // procedure of Bandgap Narrowing due to Heavy Doping
-  PetscScalar EgNarrow(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar EgNarrow(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     PetscScalar x = log(N/N0_BGN);
     return V0_BGN*(x+sqrt(x*x+CON_BGN));
   }
-  PetscScalar EgNarrowToEc   (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
-  PetscScalar EgNarrowToEv   (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
+  PetscScalar EgNarrowToEc   (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
+  PetscScalar EgNarrowToEv   (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
 
-  AutoDScalar EgNarrow(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar EgNarrow(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     PetscScalar x = log(N/N0_BGN);
     return V0_BGN*(x+sqrt(x*x+CON_BGN));
   }
-  AutoDScalar EgNarrowToEc   (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
-  AutoDScalar EgNarrowToEv   (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
+  AutoDScalar EgNarrowToEc   (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
+  AutoDScalar EgNarrowToEv   (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
 
 
 
   //---------------------------------------------------------------------------
   //electron and hole effect mass
-  PetscScalar EffecElecMass (const PetscScalar &Tl)
+  PetscScalar EffecElecMass (const PMI_Context &ctx, const PetscScalar &Tl)
   {
         return ELECMASS;
   }
-  AutoDScalar EffecElecMass (const AutoDScalar &Tl)
+  AutoDScalar EffecElecMass (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
         return ELECMASS;
   }
-  PetscScalar EffecHoleMass (const PetscScalar &Tl)
+  PetscScalar EffecHoleMass (const PMI_Context &ctx, const PetscScalar &Tl)
   {
         return HOLEMASS;
   }
-  AutoDScalar EffecHoleMass (const AutoDScalar &Tl)
+  AutoDScalar EffecHoleMass (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
         return HOLEMASS;
   }
 
   //---------------------------------------------------------------------------
   // Nc and Nv
-  PetscScalar Nc (const PetscScalar &Tl)
+  PetscScalar Nc (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     //return NC300*std::pow(Tl/T300,NC_F);
-    return 2*std::pow(2*3.14159265359*EffecElecMass(Tl)*kb*Tl/(h*h),1.5);
+    return 2*std::pow(2*3.14159265359*EffecElecMass(ctx, Tl)*kb*Tl/(h*h),1.5);
   }
-  AutoDScalar Nc (const AutoDScalar &Tl)
+  AutoDScalar Nc (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     //return NC300*std::pow(Tl/T300,NC_F);
-    return 2*adtl::pow(2*3.14159265359*EffecElecMass(Tl)*kb*Tl/(h*h),1.5);
+    return 2*adtl::pow(2*3.14159265359*EffecElecMass(ctx, Tl)*kb*Tl/(h*h),1.5);
   }
 
-  PetscScalar Nv (const PetscScalar &Tl)
+  PetscScalar Nv (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     //return NV300*std::pow(Tl/T300,NV_F);
-    return 2*std::pow(2*3.14159265359*EffecHoleMass(Tl)*kb*Tl/(h*h),1.5);
+    return 2*std::pow(2*3.14159265359*EffecHoleMass(ctx, Tl)*kb*Tl/(h*h),1.5);
   }
-  AutoDScalar Nv (const AutoDScalar &Tl)
+  AutoDScalar Nv (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     //return NV300*std::pow(Tl/T300,NV_F);
-    return 2*adtl::pow(2*3.14159265359*EffecHoleMass(Tl)*kb*Tl/(h*h),1.5);
+    return 2*adtl::pow(2*3.14159265359*EffecHoleMass(ctx, Tl)*kb*Tl/(h*h),1.5);
   }
 
   //---------------------------------------------------------------------------
-  PetscScalar ni (const PetscScalar &Tl)
+  PetscScalar ni (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar bandgap = Eg(Tl);
-    return sqrt(Nc(Tl)*Nv(Tl))*exp(-bandgap/(2*kb*Tl));
+    PetscScalar bandgap = Eg(ctx, Tl);
+    return sqrt(Nc(ctx, Tl)*Nv(ctx, Tl))*exp(-bandgap/(2*kb*Tl));
   }
 
   // nie, Eg narrow should be considered
-  PetscScalar nie (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar nie (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar bandgap = Eg(Tl);
-    return sqrt(Nc(Tl)*Nv(Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(p, n, Tl)/(2*kb*Tl));
+    PetscScalar bandgap = Eg(ctx, Tl);
+    return sqrt(Nc(ctx, Tl)*Nv(ctx, Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(ctx, p, n, Tl)/(2*kb*Tl));
   }
-  AutoDScalar nie (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar nie (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar bandgap = Eg(Tl);
-    return sqrt(Nc(Tl)*Nv(Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(p, n, Tl)/(2*kb*Tl));
+    AutoDScalar bandgap = Eg(ctx, Tl);
+    return sqrt(Nc(ctx, Tl)*Nv(ctx, Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(ctx, p, n, Tl)/(2*kb*Tl));
   }
 
 
   //particle energy to elec-hole pare generation rate
-  PetscScalar ParticleQuantumEffect(const PetscScalar &Tl) { return 13.4*eV; }
+  PetscScalar ParticleQuantumEffect(const PMI_Context &ctx, const PetscScalar &Tl) { return 13.4*eV; }
 
   //end of Bandgap
 
@@ -254,38 +254,38 @@ private:
 public:
   //---------------------------------------------------------------------------
   // electron lift time for SHR Recombination
-  PetscScalar TAUN (const PetscScalar &Tl)
+  PetscScalar TAUN (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return TAUN0/(1+(Na+Nd)/NSRHN)*std::pow(Tl/T300,EXN_TAU);
   }
-  AutoDScalar TAUN (const AutoDScalar &Tl)
+  AutoDScalar TAUN (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return TAUN0/(1+(Na+Nd)/NSRHN)*adtl::pow(Tl/T300,EXN_TAU);
   }
 
   //---------------------------------------------------------------------------
   // hole lift time for SHR Recombination
-  PetscScalar TAUP (const PetscScalar &Tl)
+  PetscScalar TAUP (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return TAUP0/(1+(Na+Nd)/NSRHP)*std::pow(Tl/T300,EXP_TAU);
   }
-  AutoDScalar TAUP (const AutoDScalar &Tl)
+  AutoDScalar TAUP (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return TAUP0/(1+(Na+Nd)/NSRHP)*adtl::pow(Tl/T300,EXP_TAU);
   }
   // End of Lifetime
 
   //[the fit parameter for density-gradient solver]
-  PetscScalar Gamman         () {return 3.6;}
-  PetscScalar Gammap         () {return 5.6;}
+  PetscScalar Gamman         (const PMI_Context &ctx) {return 3.6;}
+  PetscScalar Gammap         (const PMI_Context &ctx) {return 5.6;}
 
 private:
   //[Recombination]
@@ -332,92 +332,92 @@ public:
   /**
    * @return direct Recombination rate
    */
-  PetscScalar CDIR           (const PetscScalar &Tl)  { return C_DIRECT; }
+  PetscScalar CDIR           (const PMI_Context &ctx, const PetscScalar &Tl)  { return C_DIRECT; }
 
   /**
    * @return electron Auger Recombination rate
    */
-  PetscScalar AUGERN           (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) { return AUGN; }
+  PetscScalar AUGERN           (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl) { return AUGN; }
 
   /**
    * @return hole Auger Recombination rate
    */
-  PetscScalar AUGERP           (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)  { return AUGP; }
+  PetscScalar AUGERP           (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)  { return AUGP; }
 
   //---------------------------------------------------------------------------
   // Direct Recombination
-  PetscScalar R_Direct     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Direct     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
     return C_DIRECT*(n*p-ni*ni);
   }
-  AutoDScalar R_Direct     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Direct     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
     return C_DIRECT*(n*p-ni*ni);
   }
 
   //---------------------------------------------------------------------------
   // Total Auger Recombination
-  PetscScalar R_Auger     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Auger     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
     return AUGN*(p*n*n-n*ni*ni)+AUGP*(n*p*p-p*ni*ni);
   }
-  AutoDScalar R_Auger     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Auger     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
     return AUGN*(p*n*n-n*ni*ni)+AUGP*(n*p*p-p*ni*ni);
   }
 
   //---------------------------------------------------------------------------
   // Electron Auger Recombination
-  PetscScalar R_Auger_N     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Auger_N     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
     return AUGN*(p*n*n-n*ni*ni);
   }
-  AutoDScalar R_Auger_N     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Auger_N     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
     return AUGN*(p*n*n-n*ni*ni);
   }
   //---------------------------------------------------------------------------
   // Hole Auger Recombination
-  PetscScalar R_Auger_P     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Auger_P     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
     return AUGP*(n*p*p-p*ni*ni);
   }
-  AutoDScalar R_Auger_P     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Auger_P     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
     return AUGP*(n*p*p-p*ni*ni);
   }
 
 
   //---------------------------------------------------------------------------
   // SHR Recombination
-  PetscScalar R_SHR     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_SHR     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
-    PetscScalar taun = TAUN(Tl);
-    PetscScalar taup = TAUP(Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
+    PetscScalar taun = TAUN(ctx, Tl);
+    PetscScalar taup = TAUP(ctx, Tl);
     return (p*n-ni*ni)/(taup*(n+ni)+taun*(p+ni));
   }
-  AutoDScalar R_SHR     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_SHR     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
-    AutoDScalar taun = TAUN(Tl);
-    AutoDScalar taup = TAUP(Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
+    AutoDScalar taun = TAUN(ctx, Tl);
+    AutoDScalar taup = TAUP(ctx, Tl);
     return (p*n-ni*ni)/(taup*(n+ni)+taun*(p+ni));
   }
 
   //---------------------------------------------------------------------------
   // Surface SHR Recombination
-  PetscScalar R_Surf     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Surf     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
 
     PetscScalar seps = 1e-8 * cm/s; // a very small recomb velocity
     if (STAUN < seps || STAUP < seps)
@@ -425,9 +425,9 @@ public:
     else
       return (p*n - ni*ni) / ((n+ni)/STAUP + (p+ni)/STAUN);
   }
-  AutoDScalar R_Surf     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Surf     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
 
     PetscScalar seps = 1e-8 * cm/s; // a very small recomb velocity
     if (STAUN < seps || STAUP < seps)
@@ -438,22 +438,22 @@ public:
 
   //---------------------------------------------------------------------------
   // total Recombination
-  PetscScalar Recomb (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar Recomb (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   std::max(nie(p, n, Tl),NI_MIN);
-    PetscScalar taun = TAUN(Tl);
-    PetscScalar taup = TAUP(Tl);
+    PetscScalar ni =   std::max(nie(ctx, p, n, Tl),NI_MIN);
+    PetscScalar taun = TAUN(ctx, Tl);
+    PetscScalar taup = TAUP(ctx, Tl);
     PetscScalar dn   = p*n-ni*ni;
     PetscScalar Rshr = dn/(taup*(n+ni)+taun*(p+ni));
     PetscScalar Rdir = C_DIRECT*dn;
     PetscScalar Raug = (AUGN*n+AUGP*p)*dn;
     return Rshr+Rdir+Raug;
   }
-  AutoDScalar Recomb (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar Recomb (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   adtl::fmax(nie(p, n, Tl),NI_MIN);
-    AutoDScalar taun = TAUN(Tl);
-    AutoDScalar taup = TAUP(Tl);
+    AutoDScalar ni =   adtl::fmax(nie(ctx, p, n, Tl),NI_MIN);
+    AutoDScalar taun = TAUN(ctx, Tl);
+    AutoDScalar taup = TAUP(ctx, Tl);
     AutoDScalar dn   = p*n-ni*ni;
     AutoDScalar Rshr = dn/(taup*(n+ni)+taun*(p+ni));
     AutoDScalar Rdir = C_DIRECT*dn;
@@ -504,13 +504,13 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron relaxation time for EBM
-  PetscScalar ElecEnergyRelaxTime(const PetscScalar &Tn,const PetscScalar &Tl)
+  PetscScalar ElecEnergyRelaxTime(const PMI_Context &ctx, const PetscScalar &Tn,const PetscScalar &Tl)
   {
     if(Tn>TNL)     return WTNL;
     PetscScalar x = 1+(Tn-Tl)/T300;
     return WTN0+ WTN1*x + WTN2*x*x;
   }
-  AutoDScalar ElecEnergyRelaxTime(const AutoDScalar &Tn,const AutoDScalar &Tl)
+  AutoDScalar ElecEnergyRelaxTime(const PMI_Context &ctx, const AutoDScalar &Tn,const AutoDScalar &Tl)
   {
     if(Tn>TNL)     return WTNL;
     AutoDScalar x = 1+(Tn-Tl)/T300;
@@ -519,13 +519,13 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole relaxation time for EBM
-  PetscScalar HoleEnergyRelaxTime(const PetscScalar &Tp,const PetscScalar &Tl)
+  PetscScalar HoleEnergyRelaxTime(const PMI_Context &ctx, const PetscScalar &Tp,const PetscScalar &Tl)
   {
     if(Tp>TPL)     return WTPL;
     PetscScalar x = 1+(Tp-Tl)/T300;
     return WTP0+ WTP1*x + WTP2*x*x + WTP3*x*x*x + WTP4*std::pow(x,4) + WTP5*std::pow(x,5);
   }
-  AutoDScalar HoleEnergyRelaxTime(const AutoDScalar &Tp,const AutoDScalar &Tl)
+  AutoDScalar HoleEnergyRelaxTime(const PMI_Context &ctx, const AutoDScalar &Tp,const AutoDScalar &Tl)
   {
     if(Tp>TPL)     return WTPL;
     AutoDScalar x = 1+(Tp-Tl)/T300;
@@ -547,59 +547,59 @@ private:
   }
 
 public:
-  PetscScalar ARichN()
+  PetscScalar ARichN(const PMI_Context &ctx)
   { return ARICHN; }
 
-  PetscScalar ARichP()
+  PetscScalar ARichP(const PMI_Context &ctx)
   { return ARICHP; }
 
-  PetscScalar SchottyJsn (PetscScalar n,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar SchottyJsn (const PMI_Context &ctx, PetscScalar n,PetscScalar Tl,PetscScalar Vb)
   {
-    PetscScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(Tl));
-    PetscScalar nb = Nc(Tl)*exp(-e*Vb/(kb*Tl));
+    PetscScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(ctx, Tl));
+    PetscScalar nb = Nc(ctx, Tl)*exp(-e*Vb/(kb*Tl));
     return -e*VSURFN*(n-nb);
   }
-  AutoDScalar SchottyJsn (AutoDScalar n,AutoDScalar Tl,AutoDScalar Vb)
+  AutoDScalar SchottyJsn (const PMI_Context &ctx, AutoDScalar n,AutoDScalar Tl,AutoDScalar Vb)
   {
-    AutoDScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(Tl));
-    AutoDScalar nb = Nc(Tl)*exp(-e*Vb/(kb*Tl));
+    AutoDScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(ctx, Tl));
+    AutoDScalar nb = Nc(ctx, Tl)*exp(-e*Vb/(kb*Tl));
     return -e*VSURFN*(n-nb);
   }
 
-  PetscScalar SchottyJsp (PetscScalar p,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar SchottyJsp (const PMI_Context &ctx, PetscScalar p,PetscScalar Tl,PetscScalar Vb)
   {
-    PetscScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(Tl));
-    PetscScalar pb = Nv(Tl)*exp((-Eg(Tl)+e*Vb)/(kb*Tl));
+    PetscScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(ctx, Tl));
+    PetscScalar pb = Nv(ctx, Tl)*exp((-Eg(ctx, Tl)+e*Vb)/(kb*Tl));
     return e*VSURFP*(p-pb);
   }
-  AutoDScalar SchottyJsp (AutoDScalar p,AutoDScalar Tl,AutoDScalar Vb)
+  AutoDScalar SchottyJsp (const PMI_Context &ctx, AutoDScalar p,AutoDScalar Tl,AutoDScalar Vb)
   {
-    AutoDScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(Tl));
-    AutoDScalar pb = Nv(Tl)*exp((-Eg(Tl)+e*Vb)/(kb*Tl));
+    AutoDScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(ctx, Tl));
+    AutoDScalar pb = Nv(ctx, Tl)*exp((-Eg(ctx, Tl)+e*Vb)/(kb*Tl));
     return e*VSURFP*(p-pb);
   }
 
-  PetscScalar SchottyBarrierLowerring (PetscScalar eps, PetscScalar E)
+  PetscScalar SchottyBarrierLowerring (const PMI_Context &ctx, PetscScalar eps, PetscScalar E)
   {
     return sqrt(e/(4*3.1415926535*eps)*E);
   }
 
 
-  PetscScalar ThermalVn (PetscScalar Tl)
+  PetscScalar ThermalVn (const PMI_Context &ctx, PetscScalar Tl)
   {
-        return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(Tl)));
+        return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(ctx, Tl)));
   }
-  AutoDScalar ThermalVn (AutoDScalar Tl)
+  AutoDScalar ThermalVn (const PMI_Context &ctx, AutoDScalar Tl)
   {
-        return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(Tl)));
+        return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(ctx, Tl)));
   }
-  PetscScalar ThermalVp (PetscScalar Tl)
+  PetscScalar ThermalVp (const PMI_Context &ctx, PetscScalar Tl)
   {
-        return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(Tl)));
+        return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(ctx, Tl)));
   }
-  AutoDScalar ThermalVp (AutoDScalar Tl)
+  AutoDScalar ThermalVp (const PMI_Context &ctx, AutoDScalar Tl)
   {
-        return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(Tl)));
+        return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(ctx, Tl)));
   }
 
 
@@ -619,13 +619,13 @@ private:
 public:
   //----------------------------------------------------------------
   // band to band Tunneling
-  PetscScalar BB_Tunneling(const PetscScalar &Tl, const PetscScalar &E)
+  PetscScalar BB_Tunneling(const PMI_Context &ctx, const PetscScalar &Tl, const PetscScalar &E)
   {
-     return A_BTBT*E*E/sqrt(Eg(Tl))*exp(-B_BTBT*std::pow(Eg(Tl),PetscScalar(1.5))/(E+1*V/cm));
+     return A_BTBT*E*E/sqrt(Eg(ctx, Tl))*exp(-B_BTBT*std::pow(Eg(ctx, Tl),PetscScalar(1.5))/(E+1*V/cm));
   }
-  AutoDScalar BB_Tunneling(const AutoDScalar &Tl, const AutoDScalar &E)
+  AutoDScalar BB_Tunneling(const PMI_Context &ctx, const AutoDScalar &Tl, const AutoDScalar &E)
   {
-     return A_BTBT*E*E/sqrt(Eg(Tl))*exp(-B_BTBT*adtl::pow(Eg(Tl),PetscScalar(1.5))/(E+1*V/cm));
+     return A_BTBT*E*E/sqrt(Eg(ctx, Tl))*exp(-B_BTBT*adtl::pow(Eg(ctx, Tl),PetscScalar(1.5))/(E+1*V/cm));
   }
 
 
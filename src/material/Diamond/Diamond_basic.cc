@@ -50,10 +50,10 @@ private:
 #endif
   }
 public:
-  PetscScalar Density       (const PetscScalar &Tl) const { return DENSITY;  }
-  PetscScalar Permittivity  ()                      const { return PERMITTI; }
-  PetscScalar Permeability  ()                      const { return PERMEABI; }
-  PetscScalar Affinity      (const PetscScalar &Tl) const { return AFFINITY; }
+  PetscScalar Density       (const PMI_Context &ctx, const PetscScalar &Tl) const { return DENSITY;  }
+  PetscScalar Permittivity  (const PMI_Context &ctx)                      const { return PERMITTI; }
+  PetscScalar Permeability  (const PMI_Context &ctx)                      const { return PERMEABI; }
+  PetscScalar Affinity      (const PMI_Context &ctx, const PetscScalar &Tl) const { return AFFINITY; }
 
   void G4Material(std::vector<Atom> &atoms, std::vector<double> & fraction) const
   {
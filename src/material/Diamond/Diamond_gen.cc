@@ -59,7 +59,7 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron Impact Ionization rate for DDM
-  PetscScalar ElecGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
+  PetscScalar ElecGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
   {
     if (Ep < cut_low*EN_II)
     {
@@ -74,7 +74,7 @@ public:
       return N_IONIZA*exp(-EN_II/Ep);
   }
 
-  AutoDScalar ElecGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
+  AutoDScalar ElecGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
   {
     if (Ep < cut_low*EN_II)
     {
@@ -91,7 +91,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole Impact Ionization rate for DDM
-  PetscScalar HoleGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
+  PetscScalar HoleGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
   {
     if (Ep < cut_low*EP_II)
     {
@@ -105,7 +105,7 @@ public:
     else
       return P_IONIZA*exp(-EP_II/Ep);
   }
-  AutoDScalar HoleGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
+  AutoDScalar HoleGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
   {
     if (Ep < cut_low*EP_II)
     {
@@ -124,22 +124,22 @@ public:
 
   //---------------------------------------------------------------------------
   // Electron Impact Ionization rate for EBM
-  PetscScalar ElecGenRateEBM (const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const
+  PetscScalar ElecGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const
   {
     return 0.0;
   }
-  AutoDScalar ElecGenRateEBM (const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const
+  AutoDScalar ElecGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const
   {
     return 0.0;
   }
 
   //---------------------------------------------------------------------------
   // Hole Impact Ionization rate for EBM
-  PetscScalar HoleGenRateEBM (const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const
+  PetscScalar HoleGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const
   {
     return 0.0;
   }
-  AutoDScalar HoleGenRateEBM (const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const
+  AutoDScalar HoleGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const
   {
     return 0.0;
   }
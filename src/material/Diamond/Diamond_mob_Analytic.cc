@@ -70,21 +70,21 @@ private:
 public:
 
   // Hall mobility factor  for electrons
-  PetscScalar RH_ELEC()  { return 1.1; }
+  PetscScalar RH_ELEC(const PMI_Context &ctx)  { return 1.1; }
 
   // Hall mobility factor  for holes
-  PetscScalar RH_HOLE()  { return 0.7; }
+  PetscScalar RH_HOLE(const PMI_Context &ctx)  { return 0.7; }
 
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
     PetscScalar mu0  = MUN;
     PetscScalar vsat = VSATN0/(1+VSATN_A*exp(Tl/(2*T300)));
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN);
   }
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
     PetscScalar mu0  = MUN;
@@ -94,14 +94,14 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
     PetscScalar mu0  = MUP;
     PetscScalar vsat = VSATP0/(1+VSATP_A*exp(Tl/(2*T300)));
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP);
   }
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
     PetscScalar mu0  = MUP;
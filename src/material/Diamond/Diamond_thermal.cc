@@ -35,22 +35,22 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Heat Capacity, no exact values, use paramters for Si.
-  PetscScalar HeatCapacity  (const PetscScalar &Tl) const
+  PetscScalar HeatCapacity  (const PMI_Context &ctx, const PetscScalar &Tl) const
   {
     return 0.52*J/g/K;
   }
-  AutoDScalar HeatCapacity  (const AutoDScalar &Tl) const
+  AutoDScalar HeatCapacity  (const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
     return 0.52*J/g/K;
   }
 
   //---------------------------------------------------------------------------
   // Heat Conduction, source: Semiconductors on NSM
-  PetscScalar HeatConduction(const PetscScalar &Tl) const
+  PetscScalar HeatConduction(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
     return 10*W/cm/K;
   }
-  AutoDScalar HeatConduction(const AutoDScalar &Tl) const
+  AutoDScalar HeatConduction(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
     return 10*W/cm/K;
   }
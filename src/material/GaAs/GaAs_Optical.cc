@@ -68,7 +68,7 @@ private:
 
 public:
 
-  std::complex<PetscScalar> RefractionIndex(PetscScalar lamda, PetscScalar Tl, PetscScalar Eg=0) const
+  std::complex<PetscScalar> RefractionIndex(const PMI_Context &ctx, PetscScalar lamda, PetscScalar Tl, PetscScalar Eg=0) const
   {
     std::complex<PetscScalar> n(1.0,0.0);
     unsigned int table_size = _wave_table.size();
@@ -97,34 +97,34 @@ private:
 private:
   //---------------------------------------------------------------------------
   // Electron low field mobility
-  PetscScalar ElecMobLowField(const PetscScalar &Tl) const
+  PetscScalar ElecMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUN_MIN+(MUN_MAX*std::pow(Tl/T300,NUN)-MUN_MIN)/ \
            (1+std::pow(Tl/T300,XIN)*std::pow((Na+Nd)/NREFN,ALPHAN));
   }
-  AutoDScalar ElecMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar ElecMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUN_MIN+(MUN_MAX*adtl::pow(Tl/T300,NUN)-MUN_MIN)/ \
            (1+adtl::pow(Tl/T300,XIN)*std::pow((Na+Nd)/NREFN,ALPHAN));
   }
 
   //---------------------------------------------------------------------------
   // Hole low field mobility
-  PetscScalar HoleMobLowField(const PetscScalar &Tl) const
+  PetscScalar HoleMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUP_MIN+(MUP_MAX*std::pow(Tl/T300,NUP)-MUP_MIN)/ \
            (1+std::pow(Tl/T300,XIP)*std::pow((Na+Nd)/NREFP,ALPHAP));
   }
-  AutoDScalar HoleMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar HoleMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUP_MIN+(MUP_MAX*adtl::pow(Tl/T300,NUP)-MUP_MIN)/ \
            (1+adtl::pow(Tl/T300,XIP)*std::pow((Na+Nd)/NREFP,ALPHAP));
   }
@@ -133,38 +133,38 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
     PetscScalar vsat = VSATN_A - VSATN_B*Tl;
-    PetscScalar mu0  = ElecMobLowField(Tl);
+    PetscScalar mu0  = ElecMobLowField(ctx, Tl);
     PetscScalar E = Ep > 0 ? Ep : 0 ;
     return (mu0+vsat*std::pow(E,3)/std::pow(E0N,4))/(1+std::pow(E/E0N,4));
   }
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
     AutoDScalar vsat = VSATN_A - VSATN_B*Tl;
-    AutoDScalar mu0  = ElecMobLowField(Tl);
+    AutoDScalar mu0  = ElecMobLowField(ctx, Tl);
     AutoDScalar E = fmax(Ep, 0.0) ;
     return (mu0+vsat*adtl::pow(E,3)/std::pow(E0N,4))/(1+adtl::pow(E/E0N,4));
   }
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
     PetscScalar vsat = VSATP_A - VSATP_B*Tl;
-    PetscScalar mu0  = HoleMobLowField(Tl);
+    PetscScalar mu0  = HoleMobLowField(ctx, Tl);
     PetscScalar E = Ep > 0 ? Ep : 0 ;
     return (mu0+vsat*std::pow(E,3)/std::pow(E0P,4))/(1+std::pow(E/E0P,4));
   }
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
     AutoDScalar vsat = VSATP_A - VSATP_B*Tl;
-    AutoDScalar mu0  = HoleMobLowField(Tl);
+    AutoDScalar mu0  = HoleMobLowField(ctx, Tl);
     AutoDScalar E = fmax(Ep, 0.0) ;
     return (mu0+vsat*adtl::pow(E,3)/std::pow(E0P,4))/(1+adtl::pow(E/E0P,4));
   }
@@ -97,34 +97,34 @@ private:
 
 public:
 
-  PetscScalar ElecMobLowField(const PetscScalar &Tl) const
+  PetscScalar ElecMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUN_MIN+(MUN_MAX*std::pow(Tl/T300,NUN)-MUN_MIN)/ \
            (1+std::pow(Tl/T300,XIN)*std::pow((Na+Nd)/NREFN,ALPHAN));
   }
 
-  PetscScalar HoleMobLowField(const PetscScalar &Tl) const
+  PetscScalar HoleMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUP_MIN+(MUP_MAX*std::pow(Tl/T300,NUP)-MUP_MIN)/ \
            (1+std::pow(Tl/T300,XIP)*std::pow((Na+Nd)/NREFP,ALPHAP));
   }
 
-  AutoDScalar ElecMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar ElecMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUN_MIN+(MUN_MAX*adtl::pow(Tl/T300,NUN)-MUN_MIN)/ \
            (1+adtl::pow(Tl/T300,XIN)*std::pow((Na+Nd)/NREFN,ALPHAN));
   }
 
-  AutoDScalar HoleMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar HoleMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUP_MIN+(MUP_MAX*adtl::pow(Tl/T300,NUP)-MUP_MIN)/ \
            (1+adtl::pow(Tl/T300,XIP)*std::pow((Na+Nd)/NREFP,ALPHAP));
   }
@@ -134,20 +134,20 @@ public:
 public:
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
-    PetscScalar mu0  = ElecMobLowField(Tl);
+    PetscScalar mu0  = ElecMobLowField(ctx, Tl);
     if(Ep < 1*V/cm)    return mu0;
 
     PetscScalar vsat = VSATN_A - VSATN_B*Tl;
     return vsat/Ep*tanh(mu0*Ep/vsat);
   }
 
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
-    AutoDScalar mu0  = ElecMobLowField(Tl);
+    AutoDScalar mu0  = ElecMobLowField(ctx, Tl);
     if(Ep < 1*V/cm)    return mu0;
 
     AutoDScalar vsat = VSATN_A - VSATN_B*Tl;
@@ -156,20 +156,20 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
-    PetscScalar mu0  = HoleMobLowField(Tl);
+    PetscScalar mu0  = HoleMobLowField(ctx, Tl);
     if(Ep < 1*V/cm)    return mu0;
 
     PetscScalar vsat = VSATP_A - VSATP_B*Tl;
     return vsat/Ep*tanh(mu0*Ep/vsat);
   }
 
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
-    AutoDScalar mu0  = HoleMobLowField(Tl);
+    AutoDScalar mu0  = HoleMobLowField(ctx, Tl);
     if(Ep < 1*V/cm)    return mu0;
 
     AutoDScalar vsat = VSATP_A - VSATP_B*Tl;
@@ -247,13 +247,53 @@ public:
   // }}}
 
   // {{{ PetscScalar Charge(const bool flag_bulk)
+  /**
+   * save the occupancy history of all the traps, in the order of TrapStore
+   */
+  void Checkpoint(std::vector<PetscScalar> &state) const
+  {
+    for (TrapStore_t::const_iterator it=TrapStore.begin(); it!=TrapStore.end(); it++)
+      for (std::vector<Trap>::const_iterator ptrap=it->second.begin(); ptrap!=it->second.end(); ptrap++)
+      {
+        state.push_back(ptrap->n_t);
+        state.push_back(ptrap->n_t_last);
+        state.push_back(ptrap->n_t_last_last);
+        state.push_back(ptrap->clock_last);
+        state.push_back(ptrap->clock_last_last);
+      }
+  }
+
+  /**
+   * restore the occupancy history of all the traps, the traps should be created in the same order
+   */
+  bool Restart(const std::vector<PetscScalar> &state)
+  {
+    size_t n_traps = 0;
+    for (TrapStore_t::const_iterator it=TrapStore.begin(); it!=TrapStore.end(); it++)
+      n_traps += it->second.size();
+    if (state.size() != 5*n_traps) return false;
+
+    std::vector<PetscScalar>::const_iterator s = state.begin();
+    for (TrapStore_t::iterator it=TrapStore.begin(); it!=TrapStore.end(); it++)
+      for (std::vector<Trap>::iterator ptrap=it->second.begin(); ptrap!=it->second.end(); ptrap++)
+      {
+        ptrap->n_t             = *s++;
+        ptrap->n_t_AD          = ptrap->n_t;
+        ptrap->n_t_last        = *s++;
+        ptrap->n_t_last_last   = *s++;
+        ptrap->clock_last      = *s++;
+        ptrap->clock_last_last = *s++;
+      }
+    return true;
+  }
+
   /**
    * returns the electric charge density due to trapped charge at this node
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  PetscScalar Charge(const bool flag_bulk)
+  PetscScalar Charge(const PMI_Context &ctx, const bool flag_bulk)
   {
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -284,9 +324,9 @@ public:
    * w.r.t. the local V,n,p
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  AutoDScalar ChargeAD(const bool flag_bulk)
+  AutoDScalar ChargeAD(const PMI_Context &ctx, const bool flag_bulk)
   {
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -313,11 +353,11 @@ public:
    * Calculates the electron trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  PetscScalar ElectronTrapRate(const bool flag_bulk, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
+  PetscScalar ElectronTrapRate(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
   {
     PetscScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);     // electron thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -352,11 +392,11 @@ public:
    * Calculates the partial derivatives of electron trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  AutoDScalar ElectronTrapRate(const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl)
+  AutoDScalar ElectronTrapRate(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl)
   {
     AutoDScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -389,11 +429,11 @@ public:
    * Calculates the hole trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  PetscScalar HoleTrapRate(const bool flag_bulk, const PetscScalar &p, const PetscScalar &ni, const PetscScalar &Tl)
+  PetscScalar HoleTrapRate(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &ni, const PetscScalar &Tl)
   {
     PetscScalar theta_p = 1.0e7*cm/s * sqrt(Tl/300/K);     // hole thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -428,11 +468,11 @@ public:
    *  Calculates the partial derivatives of hole trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  AutoDScalar HoleTrapRate(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &ni, const AutoDScalar &Tl)
+  AutoDScalar HoleTrapRate(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &ni, const AutoDScalar &Tl)
   {
     AutoDScalar theta_p = 1.0e7*cm/s * sqrt(Tl/300/K);
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -460,12 +500,12 @@ public:
   // }}}
 
   // {{{ PetscScalar TrapHeat(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tp, const PetscScalar &Tn, const PetscScalar &Tl, const PetscScalar &EcEi, const PetscScalar &EiEv)
-  PetscScalar TrapHeat(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tp, const PetscScalar &Tn, const PetscScalar &Tl, const PetscScalar &EcEi, const PetscScalar &EiEv)
+  PetscScalar TrapHeat(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tp, const PetscScalar &Tn, const PetscScalar &Tl, const PetscScalar &EcEi, const PetscScalar &EiEv)
   {
     PetscScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);     // electron thermal velocity
     PetscScalar theta_p = 1.0e7*cm/s * sqrt(Tl/300/K);     // hole thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -504,12 +544,12 @@ public:
   // }}}
 
   // {{{ AutoDScalar TrapHeat(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tp, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi, const AutoDScalar &EiEv)
-  AutoDScalar TrapHeat(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tp, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi, const AutoDScalar &EiEv)
+  AutoDScalar TrapHeat(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tp, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi, const AutoDScalar &EiEv)
   {
     AutoDScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);     // electron thermal velocity
     AutoDScalar theta_p = 1.0e7*cm/s * sqrt(Tl/300/K);     // hole thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -548,11 +588,11 @@ public:
   // }}}
 
   // {{{ AutoDScalar ElectronTrapHeat(const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi)
-  AutoDScalar ElectronTrapHeat(const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi)
+  AutoDScalar ElectronTrapHeat(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi)
   {
     AutoDScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);     // electron thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -589,16 +629,16 @@ public:
    * Actually create traps as specified in PMI commands
    * Called when PMIs are initialized.
    */
-  void init_node()
+  void init_node(const PMI_Context &ctx)
   {
     for (unsigned int i=0; i<TrapSpecs.size(); i++)
     {
       if (TrapSpecs[i].type!=Bulk) continue;  // we only process bulk traps here
 
-      PetscScalar conc = ReadRealVariable(TrapSpecs[i].profile_name); // read concentration from profile
+      PetscScalar conc = ReadRealVariable(ctx, TrapSpecs[i].profile_name); // read concentration from profile
       conc=conc*TrapSpecs[i].prefactor;     // concentration is scaled by the prefactor
       if (conc>0)
-        AddTrap(*(*pp_point),i,conc);
+        AddTrap(*ctx.point,i,conc);
     }
   }
   // }}}
@@ -608,7 +648,7 @@ public:
    * Actually create interface traps as specified in PMI commands
    * Called when PMIs are initialized.
    */
-  void init_bc_node(const std::string & bc_label)
+  void init_bc_node(const PMI_Context &ctx, const std::string & bc_label)
   {
     for (unsigned int i=0; i<TrapSpecs.size(); i++)
     {
@@ -620,7 +660,7 @@ public:
 
       PetscScalar conc = TrapSpecs[i].interface_density;
       if (conc>0)
-        AddTrap(*(*pp_point),i,conc);
+        AddTrap(*ctx.point,i,conc);
     }
   }
   // }}}
@@ -629,10 +669,10 @@ public:
   /**
    * Calculate trap occupancy. The time-derivative term is included with BDF1 discretization
    */
-  void Calculate(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
+  void Calculate(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
   {
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -655,13 +695,13 @@ public:
         A = sigma_n * theta_n * (n + ni/g_n*exp( E_t/kb/Tl)) + sigma_p * theta_p * (p + ni/g_p*exp(-E_t/kb/Tl));
         B = ptrap->N_tt * ( sigma_n * theta_n * n + sigma_p * theta_p * ni / g_p * exp(-E_t/kb/Tl) );
 
-        if (ReadTime() > ptrap->clock_last)
+        if (ReadTime(ctx) > ptrap->clock_last)
         {
           // we should consider the time derivative of trap occupancy
           if (ptrap->clock_last > ptrap->clock_last_last)
           {
             // We have two previous time step available, use BDF2 discretization
-            PetscScalar d =  1.0 / (ReadTime() - ptrap->clock_last_last);
+            PetscScalar d =  1.0 / (ReadTime(ctx) - ptrap->clock_last_last);
             PetscScalar r = (ptrap->clock_last - ptrap->clock_last_last) * d;
 
             A = A + d * (2-r)/(1-r);
@@ -670,7 +710,7 @@ public:
           else
           {
             // We have two previous time step available, use BDF1 discretization
-            PetscScalar d =  1.0 / (ReadTime() - ptrap->clock_last);
+            PetscScalar d =  1.0 / (ReadTime(ctx) - ptrap->clock_last);
             A = A + d;
             B = B + ptrap->n_t_last * d;
 
@@ -688,10 +728,10 @@ public:
    * partial derivatives of trap occupancy w.r.t. local V,n,p,
    * The time-derivative term is included with BDF1 discretization
    */
-  void Calculate(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl)
+  void Calculate(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl)
   {
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -713,13 +753,13 @@ public:
         A = sigma_n * theta_n * (n + ni/g_n*exp( E_t/kb/Tl)) + sigma_p * theta_p * (p + ni/g_p*exp(-E_t/kb/Tl));
         B = ptrap->N_tt * ( sigma_n * theta_n * n + sigma_p * theta_p * ni / g_p * exp(-E_t/kb/Tl) );
 
-        if (ReadTime() > ptrap->clock_last)
+        if (ReadTime(ctx) > ptrap->clock_last)
         {
           // we should consider the time derivative of trap occupancy
           if (ptrap->clock_last > ptrap->clock_last_last)
           {
             // We have two previous time step available, use BDF2 discretization
-            PetscScalar d =  1.0 / (ReadTime() - ptrap->clock_last_last);
+            PetscScalar d =  1.0 / (ReadTime(ctx) - ptrap->clock_last_last);
             PetscScalar r = (ptrap->clock_last - ptrap->clock_last_last) * d;
 
             A = A + d * (2-r)/(1-r);
@@ -728,7 +768,7 @@ public:
           else
           {
             // We have two previous time step available, use BDF1 discretization
-            PetscScalar d =  1.0 / (ReadTime() - ptrap->clock_last);
+            PetscScalar d =  1.0 / (ReadTime(ctx) - ptrap->clock_last);
             A = A + d;
             B = B + ptrap->n_t_last * d;
           }
@@ -744,16 +784,16 @@ public:
   /**
    * Converged results are obtained, so we should update the solution
    */
-  void Update(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
+  void Update(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
   {
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
     if (it != TrapStore.end())
     {
       // Trap::n_t should already contain the correct solution, however let's play safe and calculate again
-      Calculate(flag_bulk, p, n, ni, Tl);
+      Calculate(ctx, flag_bulk, p, n, ni, Tl);
 
       std::vector<Trap> & traps = it->second;
       for (std::vector<Trap>::iterator ptrap=traps.begin(); ptrap!=traps.end(); ptrap++)
@@ -764,7 +804,7 @@ public:
 
         // update timestamp
         ptrap->clock_last_last = ptrap->clock_last;
-        ptrap->clock_last = ReadTime();
+        ptrap->clock_last = ReadTime(ctx);
       }
     }
   }
@@ -91,34 +91,34 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron low field mobility
-  PetscScalar ElecMobLowField(const PetscScalar &Tl) const
+  PetscScalar ElecMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUN_MIN+(MUN_MAX*std::pow(Tl/T300,NUN)-MUN_MIN)/ \
            (1+std::pow(Tl/T300,XIN)*std::pow((Na+Nd)/NREFN,ALPHAN));
   }
-  AutoDScalar ElecMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar ElecMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUN_MIN+(MUN_MAX*adtl::pow(Tl/T300,NUN)-MUN_MIN)/ \
            (1+adtl::pow(Tl/T300,XIN)*std::pow((Na+Nd)/NREFN,ALPHAN));
   }
 
   //---------------------------------------------------------------------------
   // Hole low field mobility
-  PetscScalar HoleMobLowField(const PetscScalar &Tl) const
+  PetscScalar HoleMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUP_MIN+(MUP_MAX*std::pow(Tl/T300,NUP)-MUP_MIN)/ \
            (1+std::pow(Tl/T300,XIP)*std::pow((Na+Nd)/NREFP,ALPHAP));
   }
-  AutoDScalar HoleMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar HoleMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUP_MIN+(MUP_MAX*adtl::pow(Tl/T300,NUP)-MUP_MIN)/ \
            (1+adtl::pow(Tl/T300,XIP)*std::pow((Na+Nd)/NREFP,ALPHAP));
   }
@@ -126,35 +126,35 @@ public:
 public:
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
     PetscScalar vsat = VSATN0/(1+VSATN_A*exp(Tl/(2*T300)));
-    PetscScalar mu0  = ElecMobLowField(Tl);
+    PetscScalar mu0  = ElecMobLowField(ctx, Tl);
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN);
   }
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
     AutoDScalar vsat = VSATN0/(1+VSATN_A*exp(Tl/(2*T300)));
-    AutoDScalar mu0  = ElecMobLowField(Tl);
+    AutoDScalar mu0  = ElecMobLowField(ctx, Tl);
     return mu0/adtl::pow(1+adtl::pow(mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN);
   }
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
     PetscScalar vsat = VSATP0/(1+VSATP_A*exp(Tl/(2*T300)));
-    PetscScalar mu0  = HoleMobLowField(Tl);
+    PetscScalar mu0  = HoleMobLowField(ctx, Tl);
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP);
   }
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
     AutoDScalar vsat = VSATP0/(1+VSATP_A*exp(Tl/(2*T300)));
-    AutoDScalar mu0  = HoleMobLowField(Tl);
+    AutoDScalar mu0  = HoleMobLowField(ctx, Tl);
     return mu0/adtl::pow(1+adtl::pow(mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP);
   }
 
@@ -32,15 +32,15 @@
 using namespace adtl;
 
 /**
- * aux function return node coordinate.
+ * aux function return coordinate of the node in \p ctx.
  */
-void PMI_Server::ReadCoordinate (PetscScalar& x, PetscScalar& y, PetscScalar& z) const
+void PMI_Server::ReadCoordinate (const PMI_Context &ctx, PetscScalar& x, PetscScalar& y, PetscScalar& z) const
 {
-  if(pp_point)
+  if(ctx.point)
   {
-    x = (*pp_point)->x();
-    y = (*pp_point)->y();
-    z = (*pp_point)->z();
+    x = ctx.point->x();
+    y = ctx.point->y();
+    z = ctx.point->z();
   }
   else
   {
@@ -51,13 +51,11 @@ void PMI_Server::ReadCoordinate (PetscScalar& x, PetscScalar& y, PetscScalar& z)
 }
 
 /**
- * aux function return current time.
+ * aux function return time of \p ctx.
  */
-PetscScalar PMI_Server::ReadTime () const
+PetscScalar PMI_Server::ReadTime (const PMI_Context &ctx) const
 {
-  if( p_clock )
-    return *p_clock;
-  return 0.0;
+  return ctx.clock;
 }
 
 
@@ -84,10 +82,10 @@ unsigned int PMI_Server::VariableIndex(const std::string &v) const
 /**
  * aux function return scalar value of given variable.
  */
-PetscScalar PMI_Server::ReadRealVariable (const unsigned int v) const
+PetscScalar PMI_Server::ReadRealVariable (const PMI_Context &ctx, const unsigned int v) const
 {
-  if( pp_node_data )
-    return (*pp_node_data)->data<Real>(v);
+  if(ctx.node_data)
+    return ctx.node_data->data<Real>(v);
   return 0.0;
 }
 
@@ -95,10 +93,10 @@ PetscScalar PMI_Server::ReadRealVariable (const unsigned int v) const
 /**
  * aux function return scalar value of given variable.
  */
-PetscScalar PMI_Server::ReadRealVariable (const std::string & v) const
+PetscScalar PMI_Server::ReadRealVariable (const PMI_Context &ctx, const std::string & v) const
 {
-  if( pp_node_data )
-    return (*pp_node_data)->data<Real>(v);
+  if(ctx.node_data)
+    return ctx.node_data->data<Real>(v);
   return 0.0;
 }
 
@@ -242,7 +240,7 @@ const std::string & PMI_Server::get_parameter_string(const int verbosity)
  * also set the physical constants
  */
 PMI_Server::PMI_Server(const PMI_Environment &env)
-  : pp_variables(env.pp_variables), pp_point(env.pp_point), pp_node_data(env.pp_node_data), p_clock(env.p_clock)
+  : pp_variables(env.pp_variables)
 {
 
   m  = env.m;
@@ -304,22 +302,22 @@ void PMIS_Server::SetFakeStrainEnvironment(const TensorValue<PetscScalar> &T)
 
 
 /**
- * aux function return first mole function of current node.
+ * aux function return first mole function of the node in \p ctx.
  */
-PetscScalar PMIS_Server::ReadxMoleFraction () const
+PetscScalar PMIS_Server::ReadxMoleFraction (const PMI_Context &ctx) const
 {
-  if(pp_node_data) return (*pp_node_data)->mole_x();
+  if(ctx.node_data) return ctx.node_data->mole_x();
   return _mole_x;
 }
 
 /**
- * aux function return first mole function with upper and lower bind of current node.
+ * aux function return first mole function with upper and lower bind of the node in \p ctx.
  */
-PetscScalar PMIS_Server::ReadxMoleFraction (const PetscScalar mole_xmin, const PetscScalar mole_xmax) const
+PetscScalar PMIS_Server::ReadxMoleFraction (const PMI_Context &ctx, const PetscScalar mole_xmin, const PetscScalar mole_xmax) const
 {
-  if(pp_node_data)
+  if(ctx.node_data)
   {
-    PetscScalar mole_x=(*pp_node_data)->mole_x();
+    PetscScalar mole_x=ctx.node_data->mole_x();
     if( mole_x < mole_xmin ) return mole_xmin;
     if( mole_x > mole_xmax ) return mole_xmax;
     return mole_x;
@@ -328,22 +326,22 @@ PetscScalar PMIS_Server::ReadxMoleFraction (const PetscScalar mole_xmin, const P
 }
 
 /**
- * aux function return second mole function of current node.
+ * aux function return second mole function of the node in \p ctx.
  */
-PetscScalar PMIS_Server::ReadyMoleFraction () const
+PetscScalar PMIS_Server::ReadyMoleFraction (const PMI_Context &ctx) const
 {
-  if(pp_node_data) return (*pp_node_data)->mole_y();
+  if(ctx.node_data) return ctx.node_data->mole_y();
   return _mole_y;
 }
 
 /**
- * aux function return second mole function with upper and lower bind of current node.
+ * aux function return second mole function with upper and lower bind of the node in \p ctx.
  */
-PetscScalar PMIS_Server::ReadyMoleFraction (const PetscScalar mole_ymin, const PetscScalar mole_ymax) const
+PetscScalar PMIS_Server::ReadyMoleFraction (const PMI_Context &ctx, const PetscScalar mole_ymin, const PetscScalar mole_ymax) const
 {
-  if(pp_node_data)
+  if(ctx.node_data)
   {
-    PetscScalar mole_y=(*pp_node_data)->mole_y();
+    PetscScalar mole_y=ctx.node_data->mole_y();
     if( mole_y < mole_ymin ) return mole_ymin;
     if( mole_y > mole_ymax ) return mole_ymax;
     return mole_y;
@@ -352,39 +350,39 @@ PetscScalar PMIS_Server::ReadyMoleFraction (const PetscScalar mole_ymin, const P
 }
 
 /**
- * aux function return total Acceptor concentration of current node
+ * aux function return total Acceptor concentration of the node in \p ctx
  */
-PetscScalar PMIS_Server::ReadDopingNa () const
+PetscScalar PMIS_Server::ReadDopingNa (const PMI_Context &ctx) const
 {
-  if(pp_node_data)  return (*pp_node_data)->Total_Na();
+  if(ctx.node_data) return ctx.node_data->Total_Na();
   return _Na;
 }
 
 /**
- * aux function return total Donor concentration of current node
+ * aux function return total Donor concentration of the node in \p ctx
  */
-PetscScalar PMIS_Server::ReadDopingNd () const
+PetscScalar PMIS_Server::ReadDopingNd (const PMI_Context &ctx) const
 {
-  if(pp_node_data) return (*pp_node_data)->Total_Nd();
+  if(ctx.node_data) return ctx.node_data->Total_Nd();
   return _Nd;
 }
 
 /**
- * aux function return minimal distance to surface
+ * aux function return minimal distance to surface of the node in \p ctx
  */
-PetscScalar PMIS_Server::ReadDmin () const
+PetscScalar PMIS_Server::ReadDmin (const PMI_Context &ctx) const
 {
-  if(pp_node_data) return (*pp_node_data)->dmin();
+  if(ctx.node_data) return ctx.node_data->dmin();
   return _dmin;
 }
 
 
 /**
- * aux function return strain tensor
+ * aux function return strain tensor of the node in \p ctx
  */
-TensorValue<PetscScalar> PMIS_Server::ReadStrain() const
+TensorValue<PetscScalar> PMIS_Server::ReadStrain(const PMI_Context &ctx) const
 {
-  if(pp_node_data) return (*pp_node_data)->strain();
+  if(ctx.node_data) return ctx.node_data->strain();
   return _strain;
 }
 
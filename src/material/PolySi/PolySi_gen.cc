@@ -80,7 +80,7 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron Impact Ionization rate for DDM
-  PetscScalar ElecGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
+  PetscScalar ElecGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
   {
     if (Ep < 1e3*V/cm)
     {
@@ -94,7 +94,7 @@ public:
       return alpha*exp(-std::pow(Ecrit/Ep,EXN_II));
     }
   }
-  AutoDScalar ElecGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
+  AutoDScalar ElecGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
   {
     if (Ep < 1e3*V/cm)
     {
@@ -111,7 +111,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole Impact Ionization rate for DDM
-  PetscScalar HoleGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
+  PetscScalar HoleGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
   {
     if (Ep < 1e3*V/cm)
     {
@@ -125,7 +125,7 @@ public:
       return alpha*exp(-std::pow(Ecrit/Ep,EXP_II));
     }
   }
-  AutoDScalar HoleGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
+  AutoDScalar HoleGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
   {
     if (Ep < 1e3*V/cm)
     {
@@ -144,7 +144,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Electron Impact Ionization rate for EBM
-  PetscScalar ElecGenRateEBM (const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const
+  PetscScalar ElecGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const
   {
     if ((Tn - Tl)<100*K)
     {
@@ -159,7 +159,7 @@ public:
       return N_IONIZA/e*exp(-std::pow(Ecrit/Eeff,EXN_II));
     }
   }
-  AutoDScalar ElecGenRateEBM (const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const
+  AutoDScalar ElecGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const
   {
     if ((Tn - Tl)<100*K)
     {
@@ -177,7 +177,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole Impact Ionization rate for EBM
-  PetscScalar HoleGenRateEBM (const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const
+  PetscScalar HoleGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const
   {
     if ((Tp - Tl)<100*K)
     {
@@ -192,7 +192,7 @@ public:
       return P_IONIZA/e*exp(-std::pow(Ecrit/Eeff,EXP_II));
     }
   }
-  AutoDScalar HoleGenRateEBM (const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const
+  AutoDScalar HoleGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const
   {
     if ((Tp - Tl)<100*K)
     {
@@ -82,7 +82,7 @@ private:
 
 public:
 
-  std::complex<PetscScalar> RefractionIndex(PetscScalar lamda, PetscScalar Tl, PetscScalar Eg=0) const
+  std::complex<PetscScalar> RefractionIndex(const PMI_Context &ctx, PetscScalar lamda, PetscScalar Tl, PetscScalar Eg=0) const
   {
     std::complex<PetscScalar> n(1.0,0.0);
     unsigned int table_size = _wave_table.size();
@@ -109,7 +109,7 @@ public:
     return n;
   }
 
-  PetscScalar FreeCarrierAbsorption(PetscScalar lamda, PetscScalar n, PetscScalar p, PetscScalar ) const
+  PetscScalar FreeCarrierAbsorption(const PMI_Context &ctx, PetscScalar lamda, PetscScalar n, PetscScalar p, PetscScalar ) const
   {
     // source:
     // Free Carrier Absorption in Silicon
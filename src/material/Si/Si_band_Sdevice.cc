@@ -102,11 +102,11 @@ private:
 public:
   //---------------------------------------------------------------------------
   // procedure of Bandgap
-  PetscScalar Eg (const PetscScalar &Tl)
+  PetscScalar Eg (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     return EG0 + dEG0 + EGALPH * EGTP*EGTP / (EGBETA + EGTP) - EGALPH * Tl*Tl / (EGBETA + Tl);
   }
-  AutoDScalar Eg (const AutoDScalar &Tl)
+  AutoDScalar Eg (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     return EG0 + dEG0 + EGALPH * EGTP*EGTP / (EGBETA + EGTP) - EGALPH * Tl*Tl / (EGBETA + Tl);
   }
@@ -184,148 +184,148 @@ public:
     }
   }
 
-  PetscScalar EgNarrow_Slotboom(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar EgNarrow_Slotboom(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     return dEG0 + E0_BGN * ( log(N/N0_BGN) + sqrt( std::pow(log(N/N0_BGN), 2) + 0.5) );
   }
-  AutoDScalar EgNarrow_Slotboom(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar EgNarrow_Slotboom(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     return dEG0 + E0_BGN * ( log(N/N0_BGN) + sqrt( std::pow(log(N/N0_BGN), 2) + 0.5) );
   }
 
-  PetscScalar EgNarrow_Bennett(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar EgNarrow_Bennett(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     if(N > N0_BGN)
       return dEG0 + E0_BGN * std::pow(log(N/N0_BGN), 2);
     return 0.0;
   }
-  AutoDScalar EgNarrow_Bennett(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar EgNarrow_Bennett(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     if(N > N0_BGN)
       return dEG0 + E0_BGN * std::pow(log(N/N0_BGN), 2);
     return 0.0;
   }
 
-  PetscScalar EgNarrow_delAlamo(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar EgNarrow_delAlamo(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     if(N > N0_BGN)
       return  dEG0 + E0_BGN *  log(N/N0_BGN);
     return 0.0;
   }
-  AutoDScalar EgNarrow_delAlamo(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar EgNarrow_delAlamo(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N = Na+Nd+1.0*std::pow(cm,-3);
     if(N > N0_BGN)
       return  dEG0 + E0_BGN *  log(N/N0_BGN);
     return 0.0;
   }
 
-  PetscScalar EgNarrow(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar EgNarrow(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
     if(BGN_Model == "Slotboom" || BGN_Model == "OldSlotboom")
-      return EgNarrow_Slotboom(p,n,Tl);
+      return EgNarrow_Slotboom(ctx, p,n,Tl);
     else if (BGN_Model == "delAlamo")
-      return EgNarrow_delAlamo(p,n,Tl);
+      return EgNarrow_delAlamo(ctx, p,n,Tl);
     else if(BGN_Model == "Bennett")
-      return EgNarrow_Bennett(p,n,Tl);
+      return EgNarrow_Bennett(ctx, p,n,Tl);
     return 0.0;
   }
-  AutoDScalar EgNarrow(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar EgNarrow(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
     if(BGN_Model == "Slotboom" || BGN_Model == "OldSlotboom")
-      return EgNarrow_Slotboom(p,n,Tl);
+      return EgNarrow_Slotboom(ctx, p,n,Tl);
     else if (BGN_Model == "delAlamo")
-      return EgNarrow_delAlamo(p,n,Tl);
+      return EgNarrow_delAlamo(ctx, p,n,Tl);
     else if(BGN_Model == "Bennett")
-      return EgNarrow_Bennett(p,n,Tl);
+      return EgNarrow_Bennett(ctx, p,n,Tl);
     return 0.0;
   }
 
 
-  PetscScalar EgNarrowToEc   (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
-  PetscScalar EgNarrowToEv   (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
+  PetscScalar EgNarrowToEc   (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
+  PetscScalar EgNarrowToEv   (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
 
-  AutoDScalar EgNarrowToEc   (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
-  AutoDScalar EgNarrowToEv   (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(p, n, Tl);}
+  AutoDScalar EgNarrowToEc   (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
+  AutoDScalar EgNarrowToEv   (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl){return 0.5*EgNarrow(ctx, p, n, Tl);}
 
 
   //---------------------------------------------------------------------------
   //electron and hole effect mass
-  PetscScalar EffecElecMass (const PetscScalar &Tl)
+  PetscScalar EffecElecMass (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     return ELECMASS;
   }
-  AutoDScalar EffecElecMass (const AutoDScalar &Tl)
+  AutoDScalar EffecElecMass (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     return ELECMASS;
   }
-  PetscScalar EffecHoleMass (const PetscScalar &Tl)
+  PetscScalar EffecHoleMass (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     return HOLEMASS;
   }
-  AutoDScalar EffecHoleMass (const AutoDScalar &Tl)
+  AutoDScalar EffecHoleMass (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     return HOLEMASS;
   }
 
   //---------------------------------------------------------------------------
   // Nc and Nv
-  PetscScalar Nc (const PetscScalar &Tl)
+  PetscScalar Nc (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     return NC300*std::pow(Tl/T300,NC_F);
   }
-  AutoDScalar Nc (const AutoDScalar &Tl)
+  AutoDScalar Nc (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     return NC300*adtl::pow(Tl/T300,NC_F);
   }
-  PetscScalar Nv (const PetscScalar &Tl)
+  PetscScalar Nv (const PMI_Context &ctx, const PetscScalar &Tl)
   {
     return NV300*std::pow(Tl/T300,NV_F);
   }
-  AutoDScalar Nv (const AutoDScalar &Tl)
+  AutoDScalar Nv (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
     return NV300*adtl::pow(Tl/T300,NV_F);
   }
 
   //---------------------------------------------------------------------------
-  PetscScalar ni (const PetscScalar &Tl)
+  PetscScalar ni (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar bandgap = Eg(Tl);
-    return sqrt(Nc(Tl)*Nv(Tl))*exp(-bandgap/(2*kb*Tl));
+    PetscScalar bandgap = Eg(ctx, Tl);
+    return sqrt(Nc(ctx, Tl)*Nv(ctx, Tl))*exp(-bandgap/(2*kb*Tl));
   }
 
   // nie, Eg narrow should be considered
-  PetscScalar nie (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar nie (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar bandgap = Eg(Tl);
-    return sqrt(Nc(Tl)*Nv(Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(p, n, Tl)/(2*kb*Tl));
+    PetscScalar bandgap = Eg(ctx, Tl);
+    return sqrt(Nc(ctx, Tl)*Nv(ctx, Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(ctx, p, n, Tl)/(2*kb*Tl));
   }
-  AutoDScalar nie (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar nie (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar bandgap = Eg(Tl);
-    return sqrt(Nc(Tl)*Nv(Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(p, n, Tl)/(2*kb*Tl));
+    AutoDScalar bandgap = Eg(ctx, Tl);
+    return sqrt(Nc(ctx, Tl)*Nv(ctx, Tl))*exp(-bandgap/(2*kb*Tl))*exp(EgNarrow(ctx, p, n, Tl)/(2*kb*Tl));
   }
 
 
   //particle energy to elec-hole pare generation rate
-  PetscScalar ParticleQuantumEffect(const PetscScalar &Tl) { return 3.6*eV; }
+  PetscScalar ParticleQuantumEffect(const PMI_Context &ctx, const PetscScalar &Tl) { return 3.6*eV; }
 
 
   //end of Bandgap
@@ -354,10 +354,10 @@ public:
 
 
 
-  PetscScalar Na_II(const PetscScalar &p, const PetscScalar &Tl, bool fermi)
+  PetscScalar Na_II(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &Tl, bool fermi)
   {
-    PetscScalar Ni = ReadDopingNa() + ReadDopingNd();
-    PetscScalar Nv = this->Nv(Tl);
+    PetscScalar Ni = ReadDopingNa(ctx) + ReadDopingNd(ctx);
+    PetscScalar Nv = this->Nv(ctx, Tl);
 
     PetscScalar gamma = 1.0;
     if( fermi ) gamma = gamma_f(p/Nv);
@@ -372,7 +372,7 @@ public:
         const std::string & ion_string = it->first;
         if( HasVariable(ion_string) )
         {
-          PetscScalar Na = ReadRealVariable(VariableIndex(ion_string));
+          PetscScalar Na = ReadRealVariable(ctx, VariableIndex(ion_string));
           PetscScalar Na_crit = it->second.N_crit;
           PetscScalar E0      = it->second.E0;
           PetscScalar g       = it->second.GB;
@@ -395,10 +395,10 @@ public:
   }
 
 
-  AutoDScalar Na_II(const AutoDScalar &p, const AutoDScalar &Tl, bool fermi)
+  AutoDScalar Na_II(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &Tl, bool fermi)
   {
-    PetscScalar Ni = ReadDopingNa() + ReadDopingNd();
-    AutoDScalar Nv = this->Nv(Tl);
+    PetscScalar Ni = ReadDopingNa(ctx) + ReadDopingNd(ctx);
+    AutoDScalar Nv = this->Nv(ctx, Tl);
 
     AutoDScalar gamma = 1.0;
     if( fermi ) gamma = gamma_f(p/Nv);
@@ -413,7 +413,7 @@ public:
         const std::string & ion_string = it->first;
         if( HasVariable(ion_string) )
         {
-          PetscScalar Na = ReadRealVariable(VariableIndex(ion_string));
+          PetscScalar Na = ReadRealVariable(ctx, VariableIndex(ion_string));
           PetscScalar Na_crit = it->second.N_crit;
           PetscScalar E0      = it->second.E0;
           PetscScalar g       = it->second.GB;
@@ -436,10 +436,10 @@ public:
     return Na_eff;
   }
 
-  PetscScalar Nd_II(const PetscScalar &n, const PetscScalar &Tl, bool fermi)
+  PetscScalar Nd_II(const PMI_Context &ctx, const PetscScalar &n, const PetscScalar &Tl, bool fermi)
   {
-    PetscScalar Ni = ReadDopingNa() + ReadDopingNd();
-    PetscScalar Nc = this->Nc(Tl);
+    PetscScalar Ni = ReadDopingNa(ctx) + ReadDopingNd(ctx);
+    PetscScalar Nc = this->Nc(ctx, Tl);
 
     PetscScalar gamma = 1.0;
     if( fermi ) gamma = gamma_f(n/Nc);
@@ -454,7 +454,7 @@ public:
         const std::string & ion_string = it->first;
         if( HasVariable(ion_string) )
         {
-          PetscScalar Nd = ReadRealVariable(VariableIndex(ion_string));
+          PetscScalar Nd = ReadRealVariable(ctx, VariableIndex(ion_string));
           PetscScalar Nd_crit = it->second.N_crit;
           PetscScalar E0      = it->second.E0;
           PetscScalar g       = it->second.GB;
@@ -477,10 +477,10 @@ public:
     return Nd_eff;
   }
 
-  AutoDScalar Nd_II(const AutoDScalar &n, const AutoDScalar &Tl, bool fermi)
+  AutoDScalar Nd_II(const PMI_Context &ctx, const AutoDScalar &n, const AutoDScalar &Tl, bool fermi)
   {
-    PetscScalar Ni = ReadDopingNa() + ReadDopingNd();
-    AutoDScalar Nc = this->Nc(Tl);
+    PetscScalar Ni = ReadDopingNa(ctx) + ReadDopingNd(ctx);
+    AutoDScalar Nc = this->Nc(ctx, Tl);
 
     AutoDScalar gamma = 1.0;
     if( fermi ) gamma = gamma_f(n/Nc);
@@ -495,7 +495,7 @@ public:
         const std::string & ion_string = it->first;
         if( HasVariable(ion_string) )
         {
-          PetscScalar Nd = ReadRealVariable(VariableIndex(ion_string));
+          PetscScalar Nd = ReadRealVariable(ctx, VariableIndex(ion_string));
           PetscScalar Nd_crit = it->second.N_crit;
           PetscScalar E0      = it->second.E0;
           PetscScalar g       = it->second.GB;
@@ -684,35 +684,35 @@ private:
 public:
   //---------------------------------------------------------------------------
   // electron lift time for SHR Recombination
-  PetscScalar TAUN (const PetscScalar &Tl)
+  PetscScalar TAUN (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar taun = TAUNMIN + ( TAUNMAX - TAUNMIN ) / ( 1 + ( (Na+Nd)/NSRHN ));
     return taun * std::pow(Tl/T300, TAUNTALH);
   }
 
-  AutoDScalar TAUN (const AutoDScalar &Tl)
+  AutoDScalar TAUN (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar taun = TAUNMIN + ( TAUNMAX - TAUNMIN ) / ( 1 + ( (Na+Nd)/NSRHN ));
     return taun * adtl::pow(Tl/T300, TAUNTALH);
   }
 
   //---------------------------------------------------------------------------
   // hole lift time for SHR Recombination
-  PetscScalar TAUP (const PetscScalar &Tl)
+  PetscScalar TAUP (const PMI_Context &ctx, const PetscScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar taup = TAUPMIN + ( TAUPMAX - TAUPMIN ) / ( 1 + ( (Na+Nd)/NSRHP ));
     return taup * std::pow(Tl/T300, TAUPTALH);
   }
-  AutoDScalar TAUP (const AutoDScalar &Tl)
+  AutoDScalar TAUP (const PMI_Context &ctx, const AutoDScalar &Tl)
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar taup = TAUPMIN + ( TAUPMAX - TAUPMIN ) / ( 1 + ( (Na+Nd)/NSRHP ));
     return taup * adtl::pow(Tl/T300, TAUPTALH);
   }
@@ -737,8 +737,8 @@ private:
 
 public:
 
-  PetscScalar Gamman         () {return GN_DG;}
-  PetscScalar Gammap         () {return GP_DG;}
+  PetscScalar Gamman         (const PMI_Context &ctx) {return GN_DG;}
+  PetscScalar Gammap         (const PMI_Context &ctx) {return GP_DG;}
 
 
 private:
@@ -815,108 +815,108 @@ public:
   /**
    * @return direct Recombination rate
    */
-  PetscScalar CDIR           (const PetscScalar &Tl)  { return C_DIRECT; }
+  PetscScalar CDIR           (const PMI_Context &ctx, const PetscScalar &Tl)  { return C_DIRECT; }
 
-  PetscScalar AUGERN(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar AUGERN(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
     return (AUGAN + AUGBN * (Tl/T300) + AUGCN * std::pow(Tl/T300, 2)) * (1 + AUGHN * exp(-n/AUGN0));
   }
 
-  AutoDScalar AUGERN(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar AUGERN(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
     return (AUGAN + AUGBN * (Tl/T300) + AUGCN * adtl::pow(Tl/T300, 2)) * (1 + AUGHN * exp(-n/AUGN0));
   }
 
-  PetscScalar AUGERP(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar AUGERP(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
     return (AUGAP + AUGBP * (Tl/T300) + AUGCP * std::pow(Tl/T300, 2)) * (1 + AUGHP * exp(-p/AUGP0));
   }
 
-  AutoDScalar AUGERP(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar AUGERP(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
     return (AUGAP + AUGBP * (Tl/T300) + AUGCP * adtl::pow(Tl/T300, 2)) * (1 + AUGHP * exp(-p/AUGP0));
   }
 
   //---------------------------------------------------------------------------
   // Direct Recombination
-  PetscScalar R_Direct     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Direct     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
     return C_DIRECT*(n*p-ni*ni);
   }
-  AutoDScalar R_Direct     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Direct     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
     return C_DIRECT*(n*p-ni*ni);
   }
 
   //---------------------------------------------------------------------------
   // Total Auger Recombination
-  PetscScalar R_Auger     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Auger     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni = nie(p, n, Tl);
+    PetscScalar ni = nie(ctx, p, n, Tl);
     PetscScalar dn = p*n-ni*ni;
-    return (AUGERN(p,n,Tl)*n + AUGERP(p,n,Tl)*p)*dn;
+    return (AUGERN(ctx, p,n,Tl)*n + AUGERP(ctx, p,n,Tl)*p)*dn;
   }
-  AutoDScalar R_Auger     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Auger     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni = nie(p, n, Tl);
+    AutoDScalar ni = nie(ctx, p, n, Tl);
     AutoDScalar dn = p*n-ni*ni;
-    return (AUGERN(p,n,Tl)*n + AUGERP(p,n,Tl)*p)*dn;
+    return (AUGERN(ctx, p,n,Tl)*n + AUGERP(ctx, p,n,Tl)*p)*dn;
   }
 
   //---------------------------------------------------------------------------
   // Electron Auger Recombination
-  PetscScalar R_Auger_N     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Auger_N     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni = nie(p, n, Tl);
+    PetscScalar ni = nie(ctx, p, n, Tl);
     PetscScalar dn = p*n-ni*ni;
-    return (AUGERN(p,n,Tl)*n)*dn;
+    return (AUGERN(ctx, p,n,Tl)*n)*dn;
   }
-  AutoDScalar R_Auger_N     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Auger_N     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni = nie(p, n, Tl);
+    AutoDScalar ni = nie(ctx, p, n, Tl);
     AutoDScalar dn = p*n-ni*ni;
-    return (AUGERN(p,n,Tl)*n)*dn;
+    return (AUGERN(ctx, p,n,Tl)*n)*dn;
   }
   //---------------------------------------------------------------------------
   // Hole Auger Recombination
-  PetscScalar R_Auger_P     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Auger_P     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni = nie(p, n, Tl);
+    PetscScalar ni = nie(ctx, p, n, Tl);
     PetscScalar dn = p*n-ni*ni;
-    return (AUGERP(p,n,Tl)*p)*dn;
+    return (AUGERP(ctx, p,n,Tl)*p)*dn;
   }
-  AutoDScalar R_Auger_P     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Auger_P     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni = nie(p, n, Tl);
+    AutoDScalar ni = nie(ctx, p, n, Tl);
     AutoDScalar dn = p*n-ni*ni;
-    return (AUGERP(p,n,Tl)*p)*dn;
+    return (AUGERP(ctx, p,n,Tl)*p)*dn;
   }
 
 
   //---------------------------------------------------------------------------
   // SHR Recombination
-  PetscScalar R_SHR     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_SHR     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
-    PetscScalar taun = TAUN(Tl);
-    PetscScalar taup = TAUP(Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
+    PetscScalar taun = TAUN(ctx, Tl);
+    PetscScalar taup = TAUP(ctx, Tl);
     return (p*n-ni*ni)/(taup*(n+ni)+taun*(p+ni));
   }
-  AutoDScalar R_SHR     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_SHR     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
-    AutoDScalar taun = TAUN(Tl);
-    AutoDScalar taup = TAUP(Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
+    AutoDScalar taun = TAUN(ctx, Tl);
+    AutoDScalar taup = TAUP(ctx, Tl);
     return (p*n-ni*ni)/(taup*(n+ni)+taun*(p+ni));
   }
 
   //---------------------------------------------------------------------------
   // Surface SHR Recombination
-  PetscScalar R_Surf     (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar R_Surf     (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
 
     PetscScalar seps = 1e-8 * cm/s; // a very small recomb velocity
     if (STAUN < seps || STAUP < seps)
@@ -924,9 +924,9 @@ public:
     else
       return (p*n - ni*ni) / ((n+ni)/STAUP + (p+ni)/STAUN);
   }
-  AutoDScalar R_Surf     (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar R_Surf     (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
 
     PetscScalar seps = 1e-8 * cm/s; // a very small recomb velocity
     if (STAUN < seps || STAUP < seps)
@@ -937,26 +937,26 @@ public:
 
   //---------------------------------------------------------------------------
   // total Recombination
-  PetscScalar Recomb (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
+  PetscScalar Recomb (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl)
   {
-    PetscScalar ni =   nie(p, n, Tl);
-    PetscScalar taun = TAUN(Tl);
-    PetscScalar taup = TAUP(Tl);
+    PetscScalar ni =   nie(ctx, p, n, Tl);
+    PetscScalar taun = TAUN(ctx, Tl);
+    PetscScalar taup = TAUP(ctx, Tl);
     PetscScalar dn   = p*n-ni*ni;
     PetscScalar Rshr = dn/(taup*(n+ni)+taun*(p+ni));
     PetscScalar Rdir = C_DIRECT*dn;
-    PetscScalar Raug = (AUGERN(p,n,Tl)*n + AUGERP(p,n,Tl)*p)*dn;
+    PetscScalar Raug = (AUGERN(ctx, p,n,Tl)*n + AUGERP(ctx, p,n,Tl)*p)*dn;
     return Rshr+Rdir+Raug;
   }
-  AutoDScalar Recomb (const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
+  AutoDScalar Recomb (const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl)
   {
-    AutoDScalar ni =   nie(p, n, Tl);
-    AutoDScalar taun = TAUN(Tl);
-    AutoDScalar taup = TAUP(Tl);
+    AutoDScalar ni =   nie(ctx, p, n, Tl);
+    AutoDScalar taun = TAUN(ctx, Tl);
+    AutoDScalar taup = TAUP(ctx, Tl);
     AutoDScalar dn   = p*n-ni*ni;
     AutoDScalar Rshr = dn/(taup*(n+ni)+taun*(p+ni));
     AutoDScalar Rdir = C_DIRECT*dn;
-    AutoDScalar Raug = (AUGERN(p,n,Tl)*n + AUGERP(p,n,Tl)*p)*dn;
+    AutoDScalar Raug = (AUGERN(ctx, p,n,Tl)*n + AUGERP(ctx, p,n,Tl)*p)*dn;
     return Rshr+Rdir+Raug;
   }
 
@@ -1020,13 +1020,13 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron relaxation time for EBM
-  PetscScalar ElecEnergyRelaxTime(const PetscScalar &Tn,const PetscScalar &Tl)
+  PetscScalar ElecEnergyRelaxTime(const PMI_Context &ctx, const PetscScalar &Tn,const PetscScalar &Tl)
   {
     if(Tn>TNL)     return WTNL;
     PetscScalar x = 1+(Tn-Tl)/T300;
     return WTN0+ WTN1*x + WTN2*x*x;
   }
-  AutoDScalar ElecEnergyRelaxTime(const AutoDScalar &Tn,const AutoDScalar &Tl)
+  AutoDScalar ElecEnergyRelaxTime(const PMI_Context &ctx, const AutoDScalar &Tn,const AutoDScalar &Tl)
   {
     if(Tn>TNL)     return WTNL;
     AutoDScalar x = 1+(Tn-Tl)/T300;
@@ -1035,13 +1035,13 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole relaxation time for EBM
-  PetscScalar HoleEnergyRelaxTime(const PetscScalar &Tp,const PetscScalar &Tl)
+  PetscScalar HoleEnergyRelaxTime(const PMI_Context &ctx, const PetscScalar &Tp,const PetscScalar &Tl)
   {
     if(Tp>TPL)     return WTPL;
     PetscScalar x = 1+(Tp-Tl)/T300;
     return WTP0+ WTP1*x + WTP2*x*x + WTP3*x*x*x + WTP4*std::pow(x,4) + WTP5*std::pow(x,5);
   }
-  AutoDScalar HoleEnergyRelaxTime(const AutoDScalar &Tp,const AutoDScalar &Tl)
+  AutoDScalar HoleEnergyRelaxTime(const PMI_Context &ctx, const AutoDScalar &Tp,const AutoDScalar &Tl)
   {
     if(Tp>TPL)     return WTPL;
     AutoDScalar x = 1+(Tp-Tl)/T300;
@@ -1068,68 +1068,68 @@ private:
   }
 
 public:
-  PetscScalar ARichN()
+  PetscScalar ARichN(const PMI_Context &ctx)
   { return ARICHN; }
 
-  PetscScalar ARichP()
+  PetscScalar ARichP(const PMI_Context &ctx)
   { return ARICHP; }
 
-  PetscScalar SchottyJsn (PetscScalar n,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar SchottyJsn (const PMI_Context &ctx, PetscScalar n,PetscScalar Tl,PetscScalar Vb)
   {
-    PetscScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(Tl));
-    PetscScalar nb = Nc(Tl)*exp(-e*Vb/(kb*Tl));
+    PetscScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(ctx, Tl));
+    PetscScalar nb = Nc(ctx, Tl)*exp(-e*Vb/(kb*Tl));
     return -e*VSURFN*(n-nb);
   }
-  AutoDScalar SchottyJsn (AutoDScalar n,AutoDScalar Tl,AutoDScalar Vb)
+  AutoDScalar SchottyJsn (const PMI_Context &ctx, AutoDScalar n,AutoDScalar Tl,AutoDScalar Vb)
   {
-    AutoDScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(Tl));
-    AutoDScalar nb = Nc(Tl)*exp(-e*Vb/(kb*Tl));
+    AutoDScalar VSURFN = ARICHN*Tl*Tl/(e*Nc(ctx, Tl));
+    AutoDScalar nb = Nc(ctx, Tl)*exp(-e*Vb/(kb*Tl));
     return -e*VSURFN*(n-nb);
   }
 
-  PetscScalar SchottyJsp (PetscScalar p,PetscScalar Tl,PetscScalar Vb)
+  PetscScalar SchottyJsp (const PMI_Context &ctx, PetscScalar p,PetscScalar Tl,PetscScalar Vb)
   {
-    PetscScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(Tl));
-    PetscScalar pb = Nv(Tl)*exp((-Eg(Tl)+e*Vb)/(kb*Tl));
+    PetscScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(ctx, Tl));
+    PetscScalar pb = Nv(ctx, Tl)*exp((-Eg(ctx, Tl)+e*Vb)/(kb*Tl));
     return e*VSURFP*(p-pb);
   }
-  AutoDScalar SchottyJsp (AutoDScalar p,AutoDScalar Tl,AutoDScalar Vb)
+  AutoDScalar SchottyJsp (const PMI_Context &ctx, AutoDScalar p,AutoDScalar Tl,AutoDScalar Vb)
   {
-    AutoDScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(Tl));
-    AutoDScalar pb = Nv(Tl)*exp((-Eg(Tl)+e*Vb)/(kb*Tl));
+    AutoDScalar VSURFP = ARICHP*Tl*Tl/(e*Nv(ctx, Tl));
+    AutoDScalar pb = Nv(ctx, Tl)*exp((-Eg(ctx, Tl)+e*Vb)/(kb*Tl));
     return e*VSURFP*(p-pb);
   }
 
-  PetscScalar SchottyBarrierLowerring (PetscScalar eps, PetscScalar E)
+  PetscScalar SchottyBarrierLowerring (const PMI_Context &ctx, PetscScalar eps, PetscScalar E)
   {
     return sqrt(e/(4*3.1415926535*eps)*E);
   }
 
 
 
-  PetscScalar ThermalVn (PetscScalar Tl)
+  PetscScalar ThermalVn (const PMI_Context &ctx, PetscScalar Tl)
   {
     // the following two result should be equivalent in mathmatic.
     //return ARICHN*Tl*Tl/(e*Nc(Tl));
-    return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(Tl)));
+    return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(ctx, Tl)));
   }
-  AutoDScalar ThermalVn (AutoDScalar Tl)
+  AutoDScalar ThermalVn (const PMI_Context &ctx, AutoDScalar Tl)
   {
     // the following two result should be equivalent in mathmatic.
     //return ARICHN*Tl*Tl/(e*Nc(Tl));
-    return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(Tl)));
+    return sqrt(kb*Tl/(2*3.14159265359*EffecElecMass(ctx, Tl)));
   }
-  PetscScalar ThermalVp (PetscScalar Tl)
+  PetscScalar ThermalVp (const PMI_Context &ctx, PetscScalar Tl)
   {
     // the following two result should be equivalent in mathmatic.
     //return ARICHP*Tl*Tl/(e*Nv(Tl));
-    return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(Tl)));
+    return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(ctx, Tl)));
   }
-  AutoDScalar ThermalVp (AutoDScalar Tl)
+  AutoDScalar ThermalVp (const PMI_Context &ctx, AutoDScalar Tl)
   {
     // the following two result should be equivalent in mathmatic.
     //return ARICHP*Tl*Tl/(e*Nv(Tl));
-    return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(Tl)));
+    return sqrt(kb*Tl/(2*3.14159265359*EffecHoleMass(ctx, Tl)));
   }
 
 
@@ -1163,40 +1163,40 @@ private:
 
 public:
 
-  PetscScalar HCI_Probability_Semiconductor_n(const PetscScalar &dis)
+  PetscScalar HCI_Probability_Semiconductor_n(const PMI_Context &ctx, const PetscScalar &dis)
   {
     if( dis > 30*HCI_LAMHN  ) return 0;
     return exp( - dis/ HCI_LAMHN);
   }
 
-  PetscScalar HCI_Probability_Semiconductor_p(const PetscScalar &dis)
+  PetscScalar HCI_Probability_Semiconductor_p(const PMI_Context &ctx, const PetscScalar &dis)
   {
     if( dis > 30*HCI_LAMHP  ) return 0;
     return exp( - dis/ HCI_LAMHP);
   }
 
-  PetscScalar HCI_Integral_Fiegna_n(const PetscScalar &phin, const PetscScalar &Eeff)
+  PetscScalar HCI_Integral_Fiegna_n(const PMI_Context &ctx, const PetscScalar &phin, const PetscScalar &Eeff)
   {
     if( HCI_Fiegna_X > 30*Eeff  ) return 0;
     return HCI_Fiegna_A/(3*HCI_Fiegna_X)*std::pow(Eeff, 1.5)/sqrt(phin)*exp(-HCI_Fiegna_X*std::pow(phin, 3.0)/std::pow(Eeff, 1.5));
   }
 
 
-  PetscScalar HCI_Integral_Fiegna_p(const PetscScalar &phip, const PetscScalar &Eeff)
+  PetscScalar HCI_Integral_Fiegna_p(const PMI_Context &ctx, const PetscScalar &phip, const PetscScalar &Eeff)
   {
     if( HCI_Fiegna_X > 30*Eeff  ) return 0;
     return HCI_Fiegna_A/(3*HCI_Fiegna_X)*std::pow(Eeff, 1.5)/sqrt(phip)*exp(-HCI_Fiegna_X*std::pow(phip, 3.0)/std::pow(Eeff, 1.5));
   }
 
 
-  PetscScalar HCI_Integral_Classical_n(const PetscScalar &phin, const PetscScalar &Eeff)
+  PetscScalar HCI_Integral_Classical_n(const PMI_Context &ctx, const PetscScalar &phin, const PetscScalar &Eeff)
   {
     if( (HCI_Classical_Lsem_n*Eeff) < phin/30 ) return 0;
     PetscScalar a = phin/(HCI_Classical_Lsem_n*Eeff);
     return 1.0/(2*HCI_Classical_Lsemr_n)*(exp(-a) - sqrt(3.14159265359)*sqrt(a)*Erfc(sqrt(a)));
   }
 
-  PetscScalar HCI_Integral_Classical_p(const PetscScalar &phip, const PetscScalar &Eeff)
+  PetscScalar HCI_Integral_Classical_p(const PMI_Context &ctx, const PetscScalar &phip, const PetscScalar &Eeff)
   {
     if( (HCI_Classical_Lsem_p*Eeff) < phip/30 ) return 0;
     PetscScalar a = phip/(HCI_Classical_Lsem_p*Eeff);
@@ -1220,13 +1220,13 @@ private:
 public:
   //----------------------------------------------------------------
   // band to band Tunneling
-  PetscScalar BB_Tunneling(const PetscScalar &Tl, const PetscScalar &E)
+  PetscScalar BB_Tunneling(const PMI_Context &ctx, const PetscScalar &Tl, const PetscScalar &E)
   {
-    return A_BTBT*E*E/sqrt(Eg(Tl))*exp(-B_BTBT*std::pow(Eg(Tl),PetscScalar(1.5))/(E+1*V/cm));
+    return A_BTBT*E*E/sqrt(Eg(ctx, Tl))*exp(-B_BTBT*std::pow(Eg(ctx, Tl),PetscScalar(1.5))/(E+1*V/cm));
   }
-  AutoDScalar BB_Tunneling(const AutoDScalar &Tl, const AutoDScalar &E)
+  AutoDScalar BB_Tunneling(const PMI_Context &ctx, const AutoDScalar &Tl, const AutoDScalar &E)
   {
-    return A_BTBT*E*E/sqrt(Eg(Tl))*exp(-B_BTBT*adtl::pow(Eg(Tl),PetscScalar(1.5))/(E+1*V/cm));
+    return A_BTBT*E*E/sqrt(Eg(ctx, Tl))*exp(-B_BTBT*adtl::pow(Eg(ctx, Tl),PetscScalar(1.5))/(E+1*V/cm));
   }
 
 
@@ -62,13 +62,13 @@ private:
 #endif
   }
 public:
-  PetscScalar Density       (const PetscScalar &Tl) const { return DENSITY;  }
-  PetscScalar Permittivity  ()                      const { return PERMITTI; }
-  PetscScalar Permeability  ()                      const { return PERMEABI; }
-  PetscScalar Affinity      (const PetscScalar &Tl) const { return AFFINITY; }
+  PetscScalar Density       (const PMI_Context &ctx, const PetscScalar &Tl) const { return DENSITY;  }
+  PetscScalar Permittivity  (const PMI_Context &ctx)                      const { return PERMITTI; }
+  PetscScalar Permeability  (const PMI_Context &ctx)                      const { return PERMEABI; }
+  PetscScalar Affinity      (const PMI_Context &ctx, const PetscScalar &Tl) const { return AFFINITY; }
 
 
-  TensorValue<PetscScalar> Strain(const TensorValue<PetscScalar> & stress) const
+  TensorValue<PetscScalar> Strain(const PMI_Context &ctx, const TensorValue<PetscScalar> & stress) const
   {
     //std::cout<<stress;
 
@@ -118,7 +118,7 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Electron Impact Ionization rate for DDM
-  PetscScalar ElecGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
+  PetscScalar ElecGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
   {
     PetscScalar a = A0N_VALD + A1N_VALD*std::pow(Tl,A2N_VALD);
     PetscScalar b = B0N_VALD*exp(B1N_VALD*Tl);
@@ -137,7 +137,7 @@ public:
     return smooth_rate*Ep/(a+b*exp(d/(Ep+c)));
   }
 
-  AutoDScalar ElecGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
+  AutoDScalar ElecGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
   {
     AutoDScalar a = A0N_VALD + A1N_VALD*adtl::pow(Tl,A2N_VALD);
     AutoDScalar b = B0N_VALD*exp(B1N_VALD*Tl);
@@ -158,7 +158,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole Impact Ionization rate for DDM
-  PetscScalar HoleGenRate (const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
+  PetscScalar HoleGenRate (const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Ep,const PetscScalar &Eg) const
   {
     PetscScalar a = A0P_VALD + A1P_VALD*std::pow(Tl,A2P_VALD);
     PetscScalar b = B0P_VALD*exp(B1P_VALD*Tl);
@@ -176,7 +176,7 @@ public:
 
       return smooth_rate*Ep/(a+b*exp(d/(Ep+c)));
   }
-  AutoDScalar HoleGenRate (const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
+  AutoDScalar HoleGenRate (const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Ep,const AutoDScalar &Eg) const
   {
     AutoDScalar a = A0P_VALD + A1P_VALD*adtl::pow(Tl,A2P_VALD);
     AutoDScalar b = B0P_VALD*exp(B1P_VALD*Tl);
@@ -197,7 +197,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Electron Impact Ionization rate for EBM
-  PetscScalar ElecGenRateEBM (const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const
+  PetscScalar ElecGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tn,const PetscScalar &Tl,const PetscScalar &Eg) const
   {
     PetscScalar vsat = (2.4e7*cm/s)/(1+0.8*exp(Tl/(2*T300)));
     PetscScalar Eeff=1.5*kb*(Tn-Tl)/vsat/ElecTauw;
@@ -207,7 +207,7 @@ public:
     PetscScalar d = D0N_VALD + D1N_VALD*Tl + D2N_VALD*Tl*Tl;
     return Eeff/(a+b*exp(d/(Eeff+c)));
   }
-  AutoDScalar ElecGenRateEBM (const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const
+  AutoDScalar ElecGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tn,const AutoDScalar &Tl,const AutoDScalar &Eg) const
   {
     AutoDScalar vsat = (2.4e7*cm/s)/(1+0.8*exp(Tl/(2*T300)));
     AutoDScalar Eeff=1.5*kb*(Tn-Tl)/vsat/ElecTauw;
@@ -220,7 +220,7 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole Impact Ionization rate for EBM
-  PetscScalar HoleGenRateEBM (const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const
+  PetscScalar HoleGenRateEBM (const PMI_Context &ctx, const PetscScalar &Tp,const PetscScalar &Tl,const PetscScalar &Eg) const
   {
     PetscScalar vsat = (2.4e7*cm/s)/(1+0.8*exp(Tl/(2*T300)));
     PetscScalar Eeff=1.5*kb*(Tp-Tl)/vsat/HoleTauw;
@@ -230,7 +230,7 @@ public:
     PetscScalar d = D0P_VALD + D1P_VALD*Tl + D2P_VALD*Tl*Tl;
     return Eeff/(a+b*exp(d/(Eeff+c)));
   }
-  AutoDScalar HoleGenRateEBM (const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const
+  AutoDScalar HoleGenRateEBM (const PMI_Context &ctx, const AutoDScalar &Tp,const AutoDScalar &Tl,const AutoDScalar &Eg) const
   {
     AutoDScalar vsat = (2.4e7*cm/s)/(1+0.8*exp(Tl/(2*T300)));
     AutoDScalar Eeff=1.5*kb*(Tp-Tl)/vsat/HoleTauw;
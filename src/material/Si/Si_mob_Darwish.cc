@@ -268,13 +268,13 @@ private:
 
   //---------------------------------------------------------------------------
   // Electron low field mobility
-  PetscScalar ElecMobPhilips(const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
+  PetscScalar ElecMobPhilips(const PMI_Context &ctx, const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
   {
     PetscScalar mu_lattice = MMXN_UM*std::pow(Tl/T300,-TETN_UM);
     PetscScalar mu1 = MMXN_UM*MMXN_UM/(MMXN_UM-MMNN_UM)*std::pow(Tl/T300,3*ALPN_UM-1.5);
     PetscScalar mu2 = MMXN_UM*MMNN_UM/(MMXN_UM-MMNN_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+1e0*std::pow(cm,-3);
-    PetscScalar Nd  = ReadDopingNd()+1e0*std::pow(cm,-3);
+    PetscScalar Na  = ReadDopingNa(ctx)+1e0*std::pow(cm,-3);
+    PetscScalar Nd  = ReadDopingNd(ctx)+1e0*std::pow(cm,-3);
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     PetscScalar Nsc = Nds+Nas+fabs(p);
@@ -290,13 +290,13 @@ private:
     PetscScalar mu_scatt = mu1*(Nsc/Nsce)*std::pow(NRFN_UM/Nsc,ALPN_UM)+mu2*(fabs(n+p)/Nsce);
     return 1.0/(1.0/mu_lattice+1.0/mu_scatt);
   }
-  AutoDScalar ElecMobPhilips(const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
+  AutoDScalar ElecMobPhilips(const PMI_Context &ctx, const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
   {
     AutoDScalar mu_lattice = MMXN_UM*adtl::pow(Tl/T300,-TETN_UM);
     AutoDScalar mu1 = MMXN_UM*MMXN_UM/(MMXN_UM-MMNN_UM)*adtl::pow(Tl/T300,3*ALPN_UM-1.5);
     AutoDScalar mu2 = MMXN_UM*MMNN_UM/(MMXN_UM-MMNN_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+1e0*std::pow(cm,-3);
-    PetscScalar Nd  = ReadDopingNd()+1e0*std::pow(cm,-3);
+    PetscScalar Na  = ReadDopingNa(ctx)+1e0*std::pow(cm,-3);
+    PetscScalar Nd  = ReadDopingNd(ctx)+1e0*std::pow(cm,-3);
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     AutoDScalar Nsc = Nds+Nas+fabs(p);
@@ -315,13 +315,13 @@ private:
 
   //---------------------------------------------------------------------------
   // Hole low field mobility
-  PetscScalar HoleMobPhilips(const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
+  PetscScalar HoleMobPhilips(const PMI_Context &ctx, const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
   {
     PetscScalar mu_lattice = MMXP_UM*std::pow(Tl/T300,-TETP_UM);
     PetscScalar mu1 = MMXP_UM*MMXP_UM/(MMXP_UM-MMNP_UM)*std::pow(Tl/T300,3*ALPP_UM-1.5);
     PetscScalar mu2 = MMXP_UM*MMNP_UM/(MMXP_UM-MMNP_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+1e0*std::pow(cm,-3);
-    PetscScalar Nd  = ReadDopingNd()+1e0*std::pow(cm,-3);
+    PetscScalar Na  = ReadDopingNa(ctx)+1e0*std::pow(cm,-3);
+    PetscScalar Nd  = ReadDopingNd(ctx)+1e0*std::pow(cm,-3);
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     PetscScalar Nsc = Nds+Nas+fabs(n);
@@ -337,13 +337,13 @@ private:
     PetscScalar mu_scatt = mu1*(Nsc/Nsce)*std::pow(NRFP_UM/Nsc,ALPP_UM)+mu2*(fabs(n+p)/Nsce);
     return 1.0/(1.0/mu_lattice+1.0/mu_scatt);
   }
-  AutoDScalar HoleMobPhilips(const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
+  AutoDScalar HoleMobPhilips(const PMI_Context &ctx, const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
   {
     AutoDScalar mu_lattice = MMXP_UM*adtl::pow(Tl/T300,-TETP_UM);
     AutoDScalar mu1 = MMXP_UM*MMXP_UM/(MMXP_UM-MMNP_UM)*adtl::pow(Tl/T300,3*ALPP_UM-1.5);
     AutoDScalar mu2 = MMXP_UM*MMNP_UM/(MMXP_UM-MMNP_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+1e0*std::pow(cm,-3);
-    PetscScalar Nd  = ReadDopingNd()+1e0*std::pow(cm,-3);
+    PetscScalar Na  = ReadDopingNa(ctx)+1e0*std::pow(cm,-3);
+    PetscScalar Nd  = ReadDopingNd(ctx)+1e0*std::pow(cm,-3);
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     AutoDScalar Nsc = Nds+Nas+fabs(n);
@@ -362,20 +362,20 @@ private:
 
   //---------------------------------------------------------------------------
   // Electron surface mobility, acoustical phono scattering and roughness scattering
-  PetscScalar ElecMobSurface(const PetscScalar &c, const PetscScalar &Tl,const PetscScalar &Et) const
+  PetscScalar ElecMobSurface(const PMI_Context &ctx, const PetscScalar &c, const PetscScalar &Tl,const PetscScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     PetscScalar ET = Et+1.0*V/cm;
     PetscScalar mu_ac = BN_LSM/ET + CN_LSM*std::pow(N_total/N1,EXN4_LSM)/std::pow(Tl/T300, EXN5_LSM)*std::pow(ET,PetscScalar(-1.0/3.0));
     PetscScalar mu_sr = DN_LSM*std::pow(ET/E1,-(EXN8_LSM + AN_LSM*c/std::pow(N_total/N1,EN_LSM)));
     return 1.0/(1.0/mu_ac+1.0/mu_sr);
   }
-  AutoDScalar ElecMobSurface(const AutoDScalar &c, const AutoDScalar &Tl,const AutoDScalar &Et) const
+  AutoDScalar ElecMobSurface(const PMI_Context &ctx, const AutoDScalar &c, const AutoDScalar &Tl,const AutoDScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     AutoDScalar ET = Et+1.0*V/cm;
     AutoDScalar mu_ac = BN_LSM/ET + CN_LSM*std::pow(N_total/N1,EXN4_LSM)/adtl::pow(Tl/T300, EXN5_LSM)*adtl::pow(ET,PetscScalar(-1.0/3.0));
@@ -385,20 +385,20 @@ private:
 
   //---------------------------------------------------------------------------
   // Hole surface mobility, acoustical phono scattering and roughness scattering
-  PetscScalar HoleMobSurface(const PetscScalar &c, const PetscScalar &Tl,const PetscScalar &Et) const
+  PetscScalar HoleMobSurface(const PMI_Context &ctx, const PetscScalar &c, const PetscScalar &Tl,const PetscScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     PetscScalar ET = Et+1.0*V/cm;
     PetscScalar mu_ac = BP_LSM/ET + CP_LSM*std::pow(N_total/N1,EXP4_LSM)/std::pow(Tl/T300, EXP5_LSM)*std::pow(ET,PetscScalar(-1.0/3.0));
     PetscScalar mu_sr = DP_LSM*std::pow(ET/E1,-(EXP8_LSM + AP_LSM*c/std::pow(N_total/N1,EP_LSM)));
     return 1.0/(1.0/mu_ac+1.0/mu_sr);
   }
-  AutoDScalar HoleMobSurface(const AutoDScalar &c, const AutoDScalar &Tl,const AutoDScalar &Et) const
+  AutoDScalar HoleMobSurface(const PMI_Context &ctx, const AutoDScalar &c, const AutoDScalar &Tl,const AutoDScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     AutoDScalar ET = Et+1.0*V/cm;
     AutoDScalar mu_ac = BP_LSM/ET + CP_LSM*std::pow(N_total/N1,EXP4_LSM)/adtl::pow(Tl/T300, EXP5_LSM)*adtl::pow(ET+1.0*V/cm,PetscScalar(-1.0/3.0));
@@ -412,65 +412,65 @@ public:
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  PetscScalar ZETAN() { return 1.0; }
+  PetscScalar ZETAN(const PMI_Context &ctx) { return 1.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  PetscScalar ETAN()  { return 0.5; }
+  PetscScalar ETAN(const PMI_Context &ctx)  { return 0.5; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  PetscScalar ZETAP() { return 1.0; }
+  PetscScalar ZETAP(const PMI_Context &ctx) { return 1.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  PetscScalar ETAP()  { return 0.333; }
+  PetscScalar ETAP(const PMI_Context &ctx)  { return 0.333; }
 
 
   // Hall mobility factor  for electrons
-  PetscScalar RH_ELEC()  { return 1.1; }
+  PetscScalar RH_ELEC(const PMI_Context &ctx)  { return 1.1; }
 
   // Hall mobility factor  for holes
-  PetscScalar RH_HOLE()  { return 0.7; }
+  PetscScalar RH_HOLE(const PMI_Context &ctx)  { return 0.7; }
 
 
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
     PetscScalar vsat = VSATN0/(1+VSATN_A*exp(Tl/(2*T300)));
-    PetscScalar mu0  = 1.0/(1.0/ElecMobPhilips(p, n, Tl)+1.0/ElecMobSurface(n+p,Tl,Et));
+    PetscScalar mu0  = 1.0/(1.0/ElecMobPhilips(ctx, p, n, Tl)+1.0/ElecMobSurface(ctx, n+p,Tl,Et));
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN);
   }
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
     AutoDScalar vsat = VSATN0/(1+VSATN_A*exp(Tl/(2*T300)));
-    AutoDScalar mu0  = 1.0/(1.0/ElecMobPhilips(p, n, Tl)+1.0/ElecMobSurface(n+p,Tl,Et));
+    AutoDScalar mu0  = 1.0/(1.0/ElecMobPhilips(ctx, p, n, Tl)+1.0/ElecMobSurface(ctx, n+p,Tl,Et));
     return mu0/adtl::pow(1+adtl::pow(mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN);
   }
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
     PetscScalar vsat = VSATP0/(1+VSATP_A*exp(Tl/(2*T300)));
-    PetscScalar mu0  = 1.0/(1.0/HoleMobPhilips(p,n,Tl)+1.0/HoleMobSurface(n+p,Tl,Et));
+    PetscScalar mu0  = 1.0/(1.0/HoleMobPhilips(ctx, p,n,Tl)+1.0/HoleMobSurface(ctx, n+p,Tl,Et));
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP);
   }
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
     AutoDScalar vsat = VSATP0/(1+VSATP_A*exp(Tl/(2*T300)));
-    AutoDScalar mu0  = 1.0/(1.0/HoleMobPhilips(p,n,Tl)+1.0/HoleMobSurface(n+p,Tl,Et));
+    AutoDScalar mu0  = 1.0/(1.0/HoleMobPhilips(ctx, p,n,Tl)+1.0/HoleMobSurface(ctx, n+p,Tl,Et));
     return mu0/adtl::pow(1+adtl::pow(mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP);
   }
 
@@ -112,34 +112,34 @@ private:
 private:
   //---------------------------------------------------------------------------
   // Electron low field mobility, Analytic model
-  PetscScalar ElecMobLowField(const PetscScalar &Tl) const
+  PetscScalar ElecMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUN_MIN+(MUN_MAX*std::pow(Tl/T300,NUN)-MUN_MIN)/ \
            (1+std::pow(Tl/T300,XIN)*std::pow((Na+Nd)/NREFN,ALPHAN));
   }
-  AutoDScalar ElecMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar ElecMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUN_MIN+(MUN_MAX*adtl::pow(Tl/T300,NUN)-MUN_MIN)/ \
            (1+adtl::pow(Tl/T300,XIN)*std::pow((Na+Nd)/NREFN,ALPHAN));
   }
 
   //---------------------------------------------------------------------------
   // Hole low field mobility, Analytic model
-  PetscScalar HoleMobLowField(const PetscScalar &Tl) const
+  PetscScalar HoleMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUP_MIN+(MUP_MAX*std::pow(Tl/T300,NUP)-MUP_MIN)/ \
            (1+std::pow(Tl/T300,XIP)*std::pow((Na+Nd)/NREFP,ALPHAP));
   }
-  AutoDScalar HoleMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar HoleMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     return MUP_MIN+(MUP_MAX*adtl::pow(Tl/T300,NUP)-MUP_MIN)/ \
            (1+adtl::pow(Tl/T300,XIP)*std::pow((Na+Nd)/NREFP,ALPHAP));
   }
@@ -150,53 +150,53 @@ public:
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  PetscScalar ZETAN() { return 1.0; }
+  PetscScalar ZETAN(const PMI_Context &ctx) { return 1.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  PetscScalar ETAN()  { return 0.5; }
+  PetscScalar ETAN(const PMI_Context &ctx)  { return 0.5; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  PetscScalar ZETAP() { return 1.0; }
+  PetscScalar ZETAP(const PMI_Context &ctx) { return 1.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  PetscScalar ETAP()  { return 0.333; }
+  PetscScalar ETAP(const PMI_Context &ctx)  { return 0.333; }
 
 
   // Hall mobility factor  for electrons
-  PetscScalar RH_ELEC()  { return 1.1; }
+  PetscScalar RH_ELEC(const PMI_Context &ctx)  { return 1.1; }
 
   // Hall mobility factor  for holes
-  PetscScalar RH_HOLE()  { return 0.7; }
+  PetscScalar RH_HOLE(const PMI_Context &ctx)  { return 0.7; }
 
 
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
-    PetscScalar Ntotal = ReadDopingNa()+ReadDopingNd();
+    PetscScalar Ntotal = ReadDopingNa(ctx)+ReadDopingNd(ctx);
     PetscScalar mu0;
-    if(Ntotal > NREF_HP) mu0=ElecMobLowField(Tl);
+    if(Ntotal > NREF_HP) mu0=ElecMobLowField(ctx, Tl);
     else mu0 = MUN0_HP/(1+Et/ECN_HP);
     PetscScalar alpha = mu0*Ep/VCN_HP;
     PetscScalar beta  = mu0*Ep/VSN_HP;
     return mu0/sqrt(1+alpha*alpha/(alpha+GN_HP)+beta*beta);
   }
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
-    PetscScalar Ntotal = ReadDopingNa()+ReadDopingNd();
+    PetscScalar Ntotal = ReadDopingNa(ctx)+ReadDopingNd(ctx);
     AutoDScalar mu0;
-    if(Ntotal > NREF_HP) mu0=ElecMobLowField(Tl);
+    if(Ntotal > NREF_HP) mu0=ElecMobLowField(ctx, Tl);
     else mu0 = MUN0_HP/(1+Et/ECN_HP);
     AutoDScalar alpha = mu0*Ep/VCN_HP;
     AutoDScalar beta  = mu0*Ep/VSN_HP;
@@ -205,23 +205,23 @@ public:
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
-    PetscScalar Ntotal = ReadDopingNa()+ReadDopingNd();
+    PetscScalar Ntotal = ReadDopingNa(ctx)+ReadDopingNd(ctx);
     PetscScalar mu0;
-    if(Ntotal > NREF_HP) mu0=HoleMobLowField(Tl);
+    if(Ntotal > NREF_HP) mu0=HoleMobLowField(ctx, Tl);
     else mu0 = MUP0_HP/(1+Et/ECP_HP);
     PetscScalar alpha = mu0*Ep/VCP_HP;
     PetscScalar beta  = mu0*Ep/VSP_HP;
     return mu0/sqrt(1+alpha*alpha/(alpha+GP_HP)+beta*beta);
   }
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
-    PetscScalar Ntotal = ReadDopingNa()+ReadDopingNd();
+    PetscScalar Ntotal = ReadDopingNa(ctx)+ReadDopingNd(ctx);
     AutoDScalar mu0;
-    if(Ntotal > NREF_HP) mu0=HoleMobLowField(Tl);
+    if(Ntotal > NREF_HP) mu0=HoleMobLowField(ctx, Tl);
     else mu0 = MUP0_HP/(1+Et/ECP_HP);
     AutoDScalar alpha = mu0*Ep/VCP_HP;
     AutoDScalar beta  = mu0*Ep/VSP_HP;
@@ -142,18 +142,18 @@ private:
   }
   //---------------------------------------------------------------------------
   // Electron low field mobility
-  PetscScalar ElecMobLowField(const PetscScalar &Tl) const
+  PetscScalar ElecMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     PetscScalar mu_max = MUN2_LSM*std::pow(Tl/T300,-EXN3_LSM);
     return MUN0_LSM+(mu_max-MUN0_LSM)/(1+std::pow(N_total/CRN_LSM,EXN1_LSM))-MUN1_LSM/(1+std::pow(CSN_LSM/N_total,EXN2_LSM));
   }
-  AutoDScalar ElecMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar ElecMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     AutoDScalar mu_max = MUN2_LSM*adtl::pow(Tl/T300,-EXN3_LSM);
     return MUN0_LSM+(mu_max-MUN0_LSM)/(1+std::pow(N_total/CRN_LSM,EXN1_LSM))-MUN1_LSM/(1+std::pow(CSN_LSM/N_total,EXN2_LSM));
@@ -161,18 +161,18 @@ private:
 
   //---------------------------------------------------------------------------
   // Hole low field mobility, Analytic model
-  PetscScalar HoleMobLowField(const PetscScalar &Tl) const
+  PetscScalar HoleMobLowField(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     PetscScalar mu_max = MUP2_LSM*std::pow(Tl/T300,-EXP3_LSM);
     return MUP0_LSM*exp(-PC_LSM/N_total)+mu_max/(1+std::pow(N_total/CRP_LSM,EXP1_LSM))-MUP1_LSM/(1+std::pow(CSP_LSM/N_total,EXP2_LSM));
   }
-  AutoDScalar HoleMobLowField(const AutoDScalar &Tl) const
+  AutoDScalar HoleMobLowField(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     AutoDScalar mu_max = MUP2_LSM*adtl::pow(Tl/T300,-EXP3_LSM);
     return MUP0_LSM*exp(-PC_LSM/N_total)+mu_max/(1+std::pow(N_total/CRP_LSM,EXP1_LSM))-MUP1_LSM/(1+std::pow(CSP_LSM/N_total,EXP2_LSM));
@@ -180,20 +180,20 @@ private:
 
   //---------------------------------------------------------------------------
   // Electron surface mobility, acoustical phono scattering and roughness scattering
-  PetscScalar ElecMobSurface(const PetscScalar &Tl,const PetscScalar &Et) const
+  PetscScalar ElecMobSurface(const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     PetscScalar ET = Et+1.0*V/cm;
     PetscScalar mu_ac = BN_LSM/ET + CN_LSM*std::pow(N_total,EXN4_LSM)/Tl*std::pow(ET,PetscScalar(-1.0/3.0));
     PetscScalar mu_sr = DN_LSM*std::pow(ET,-EXN8_LSM);
     return 1.0/(1.0/mu_ac+1.0/mu_sr);
   }
-  AutoDScalar ElecMobSurface(const AutoDScalar &Tl,const AutoDScalar &Et) const
+  AutoDScalar ElecMobSurface(const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     AutoDScalar ET = Et+1.0*V/cm;
     AutoDScalar mu_ac = BN_LSM/ET + CN_LSM*std::pow(N_total,EXN4_LSM)/Tl*adtl::pow(ET,PetscScalar(-1.0/3.0));
@@ -203,20 +203,20 @@ private:
 
   //---------------------------------------------------------------------------
   // Hole surface mobility, acoustical phono scattering and roughness scattering
-  PetscScalar HoleMobSurface(const PetscScalar &Tl,const PetscScalar &Et) const
+  PetscScalar HoleMobSurface(const PMI_Context &ctx, const PetscScalar &Tl,const PetscScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     PetscScalar ET = Et+1.0*V/cm;
     PetscScalar mu_ac = BP_LSM/ET + CP_LSM*std::pow(N_total,EXP4_LSM)/Tl*std::pow(ET,PetscScalar(-1.0/3.0));
     PetscScalar mu_sr = DP_LSM*std::pow(ET,-EXP8_LSM);
     return 1.0/(1.0/mu_ac+1.0/mu_sr);
   }
-  AutoDScalar HoleMobSurface(const AutoDScalar &Tl,const AutoDScalar &Et) const
+  AutoDScalar HoleMobSurface(const PMI_Context &ctx, const AutoDScalar &Tl,const AutoDScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+1e0*std::pow(cm,-3);
     AutoDScalar ET = Et+1.0*V/cm;
     AutoDScalar mu_ac = BP_LSM/ET + CP_LSM*std::pow(N_total,EXP4_LSM)/Tl*adtl::pow(ET+1.0*V/cm,PetscScalar(-1.0/3.0));
@@ -230,65 +230,65 @@ public:
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  PetscScalar ZETAN() { return 1.0; }
+  PetscScalar ZETAN(const PMI_Context &ctx) { return 1.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  PetscScalar ETAN()  { return 0.5; }
+  PetscScalar ETAN(const PMI_Context &ctx)  { return 0.5; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  PetscScalar ZETAP() { return 1.0; }
+  PetscScalar ZETAP(const PMI_Context &ctx) { return 1.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  PetscScalar ETAP()  { return 0.333; }
+  PetscScalar ETAP(const PMI_Context &ctx)  { return 0.333; }
 
 
   // Hall mobility factor  for electrons
-  PetscScalar RH_ELEC()  { return 1.1; }
+  PetscScalar RH_ELEC(const PMI_Context &ctx)  { return 1.1; }
 
   // Hall mobility factor  for holes
-  PetscScalar RH_HOLE()  { return 0.7; }
+  PetscScalar RH_HOLE(const PMI_Context &ctx)  { return 0.7; }
 
 
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
     PetscScalar vsat = VSATN0/(1+VSATN_A*exp(Tl/(2*T300)));
-    PetscScalar mu0  = 1.0/(1.0/ElecMobLowField(Tl)+1.0/ElecMobSurface(Tl,Et));
+    PetscScalar mu0  = 1.0/(1.0/ElecMobLowField(ctx, Tl)+1.0/ElecMobSurface(ctx, Tl,Et));
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN);
   }
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
     AutoDScalar vsat = VSATN0/(1+VSATN_A*exp(Tl/(2*T300)));
-    AutoDScalar mu0  = 1.0/(1.0/ElecMobLowField(Tl)+1.0/ElecMobSurface(Tl,Et));
+    AutoDScalar mu0  = 1.0/(1.0/ElecMobLowField(ctx, Tl)+1.0/ElecMobSurface(ctx, Tl,Et));
     return mu0/adtl::pow(1+adtl::pow(mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN);
   }
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
     PetscScalar vsat = VSATP0/(1+VSATP_A*exp(Tl/(2*T300)));
-    PetscScalar mu0  = 1.0/(1.0/HoleMobLowField(Tl)+1.0/HoleMobSurface(Tl,Et));
+    PetscScalar mu0  = 1.0/(1.0/HoleMobLowField(ctx, Tl)+1.0/HoleMobSurface(ctx, Tl,Et));
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP);
   }
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
     AutoDScalar vsat = VSATP0/(1+VSATP_A*exp(Tl/(2*T300)));
-    AutoDScalar mu0  = 1.0/(1.0/HoleMobLowField(Tl)+1.0/HoleMobSurface(Tl,Et));
+    AutoDScalar mu0  = 1.0/(1.0/HoleMobLowField(ctx, Tl)+1.0/HoleMobSurface(ctx, Tl,Et));
     return mu0/adtl::pow(1+adtl::pow(mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP);
   }
 
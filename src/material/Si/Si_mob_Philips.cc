@@ -201,13 +201,13 @@ private:
 
   //---------------------------------------------------------------------------
   // Electron low field mobility
-  PetscScalar ElecMobPhilips(const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
+  PetscScalar ElecMobPhilips(const PMI_Context &ctx, const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
   {
     PetscScalar mu_lattice = MMXN_UM*std::pow(Tl/T300,-TETN_UM);
     PetscScalar mu1 = MMXN_UM*MMXN_UM/(MMXN_UM-MMNN_UM)*std::pow(Tl/T300,3*ALPN_UM-1.5);
     PetscScalar mu2 = MMXN_UM*MMNN_UM/(MMXN_UM-MMNN_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+1e0*std::pow(cm,-3);
-    PetscScalar Nd  = ReadDopingNd()+1e0*std::pow(cm,-3);
+    PetscScalar Na  = ReadDopingNa(ctx)+1e0*std::pow(cm,-3);
+    PetscScalar Nd  = ReadDopingNd(ctx)+1e0*std::pow(cm,-3);
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     PetscScalar Nsc = Nds+Nas+fabs(p);
@@ -223,13 +223,13 @@ private:
     PetscScalar mu_scatt = mu1*(Nsc/Nsce)*std::pow(NRFN_UM/Nsc,ALPN_UM)+mu2*(fabs(n+p)/Nsce);
     return 1.0/(1.0/mu_lattice+1.0/mu_scatt);
   }
-  AutoDScalar ElecMobPhilips(const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
+  AutoDScalar ElecMobPhilips(const PMI_Context &ctx, const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
   {
     AutoDScalar mu_lattice = MMXN_UM*adtl::pow(Tl/T300,-TETN_UM);
     AutoDScalar mu1 = MMXN_UM*MMXN_UM/(MMXN_UM-MMNN_UM)*adtl::pow(Tl/T300,3*ALPN_UM-1.5);
     AutoDScalar mu2 = MMXN_UM*MMNN_UM/(MMXN_UM-MMNN_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+1e0*std::pow(cm,-3);
-    PetscScalar Nd  = ReadDopingNd()+1e0*std::pow(cm,-3);
+    PetscScalar Na  = ReadDopingNa(ctx)+1e0*std::pow(cm,-3);
+    PetscScalar Nd  = ReadDopingNd(ctx)+1e0*std::pow(cm,-3);
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     AutoDScalar Nsc = Nds+Nas+fabs(p);
@@ -248,13 +248,13 @@ private:
 
   //---------------------------------------------------------------------------
   // Hole low field mobility
-  PetscScalar HoleMobPhilips(const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
+  PetscScalar HoleMobPhilips(const PMI_Context &ctx, const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
   {
     PetscScalar mu_lattice = MMXP_UM*std::pow(Tl/T300,-TETP_UM);
     PetscScalar mu1 = MMXP_UM*MMXP_UM/(MMXP_UM-MMNP_UM)*std::pow(Tl/T300,3*ALPP_UM-1.5);
     PetscScalar mu2 = MMXP_UM*MMNP_UM/(MMXP_UM-MMNP_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+1e0*std::pow(cm,-3);
-    PetscScalar Nd  = ReadDopingNd()+1e0*std::pow(cm,-3);
+    PetscScalar Na  = ReadDopingNa(ctx)+1e0*std::pow(cm,-3);
+    PetscScalar Nd  = ReadDopingNd(ctx)+1e0*std::pow(cm,-3);
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     PetscScalar Nsc = Nds+Nas+fabs(n);
@@ -270,13 +270,13 @@ private:
     PetscScalar mu_scatt = mu1*(Nsc/Nsce)*std::pow(NRFP_UM/Nsc,ALPP_UM)+mu2*(fabs(n+p)/Nsce);
     return 1.0/(1.0/mu_lattice+1.0/mu_scatt);
   }
-  AutoDScalar HoleMobPhilips(const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
+  AutoDScalar HoleMobPhilips(const PMI_Context &ctx, const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
   {
     AutoDScalar mu_lattice = MMXP_UM*adtl::pow(Tl/T300,-TETP_UM);
     AutoDScalar mu1 = MMXP_UM*MMXP_UM/(MMXP_UM-MMNP_UM)*adtl::pow(Tl/T300,3*ALPP_UM-1.5);
     AutoDScalar mu2 = MMXP_UM*MMNP_UM/(MMXP_UM-MMNP_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+1e0*std::pow(cm,-3);
-    PetscScalar Nd  = ReadDopingNd()+1e0*std::pow(cm,-3);
+    PetscScalar Na  = ReadDopingNa(ctx)+1e0*std::pow(cm,-3);
+    PetscScalar Nd  = ReadDopingNd(ctx)+1e0*std::pow(cm,-3);
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     AutoDScalar Nsc = Nds+Nas+fabs(n);
@@ -295,43 +295,43 @@ private:
 public:
 
   // Hall mobility factor  for electrons
-  PetscScalar RH_ELEC()  { return 1.1; }
+  PetscScalar RH_ELEC(const PMI_Context &ctx)  { return 1.1; }
 
   // Hall mobility factor  for holes
-  PetscScalar RH_HOLE()  { return 0.7; }
+  PetscScalar RH_HOLE(const PMI_Context &ctx)  { return 0.7; }
 
 
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
     PetscScalar vsat = VSATN0/(1+VSATN_A*exp(Tl/(2*T300)));
-    PetscScalar mu0  = ElecMobPhilips(p,n,Tl);
+    PetscScalar mu0  = ElecMobPhilips(ctx, p,n,Tl);
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN);
   }
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
     AutoDScalar vsat = VSATN0/(1+VSATN_A*exp(Tl/(2*T300)));
-    AutoDScalar mu0  = ElecMobPhilips(p,n,Tl);
+    AutoDScalar mu0  = ElecMobPhilips(ctx, p,n,Tl);
     return mu0/adtl::pow(1+adtl::pow(mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN);
   }
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
     PetscScalar vsat = VSATP0/(1+VSATP_A*exp(Tl/(2*T300)));
-    PetscScalar mu0  = HoleMobPhilips(p,n,Tl);
+    PetscScalar mu0  = HoleMobPhilips(ctx, p,n,Tl);
     return mu0/std::pow(1+std::pow(mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP);
   }
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
     AutoDScalar vsat = VSATP0/(1+VSATP_A*exp(Tl/(2*T300)));
-    AutoDScalar mu0  = HoleMobPhilips(p,n,Tl);
+    AutoDScalar mu0  = HoleMobPhilips(ctx, p,n,Tl);
     return mu0/adtl::pow(1+adtl::pow(mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP);
   }
 
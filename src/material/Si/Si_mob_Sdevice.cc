@@ -261,13 +261,13 @@ private:
   }
   //---------------------------------------------------------------------------
   // Electron low field mobility
-  PetscScalar ElecMobPhilips(const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
+  PetscScalar ElecMobPhilips(const PMI_Context &ctx, const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
   {
     PetscScalar mu_lattice = MMXN_UM*std::pow(Tl/T300,-TETN_UM);
     PetscScalar mu1 = MMXN_UM*MMXN_UM/(MMXN_UM-MMNN_UM)*std::pow(Tl/T300,3*ALPN_UM-1.5);
     PetscScalar mu2 = MMXN_UM*MMNN_UM/(MMXN_UM-MMNN_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+N1;
-    PetscScalar Nd  = ReadDopingNd()+N1;
+    PetscScalar Na  = ReadDopingNa(ctx)+N1;
+    PetscScalar Nd  = ReadDopingNd(ctx)+N1;
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     PetscScalar Nsc = Nds+Nas+fabs(p);
@@ -283,13 +283,13 @@ private:
     PetscScalar mu_scatt = mu1*(Nsc/Nsce)*std::pow(NRFN_UM/Nsc,ALPN_UM)+mu2*(fabs(n+p)/Nsce);
     return 1.0/(1.0/mu_lattice+1.0/mu_scatt);
   }
-  AutoDScalar ElecMobPhilips(const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
+  AutoDScalar ElecMobPhilips(const PMI_Context &ctx, const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
   {
     AutoDScalar mu_lattice = MMXN_UM*adtl::pow(Tl/T300,-TETN_UM);
     AutoDScalar mu1 = MMXN_UM*MMXN_UM/(MMXN_UM-MMNN_UM)*adtl::pow(Tl/T300,3*ALPN_UM-1.5);
     AutoDScalar mu2 = MMXN_UM*MMNN_UM/(MMXN_UM-MMNN_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+N1;
-    PetscScalar Nd  = ReadDopingNd()+N1;
+    PetscScalar Na  = ReadDopingNa(ctx)+N1;
+    PetscScalar Nd  = ReadDopingNd(ctx)+N1;
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     AutoDScalar Nsc = Nds+Nas+fabs(p);
@@ -308,13 +308,13 @@ private:
 
   //---------------------------------------------------------------------------
   // Hole low field mobility
-  PetscScalar HoleMobPhilips(const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
+  PetscScalar HoleMobPhilips(const PMI_Context &ctx, const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl) const
   {
     PetscScalar mu_lattice = MMXP_UM*std::pow(Tl/T300,-TETP_UM);
     PetscScalar mu1 = MMXP_UM*MMXP_UM/(MMXP_UM-MMNP_UM)*std::pow(Tl/T300,3*ALPP_UM-1.5);
     PetscScalar mu2 = MMXP_UM*MMNP_UM/(MMXP_UM-MMNP_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+N1;
-    PetscScalar Nd  = ReadDopingNd()+N1;
+    PetscScalar Na  = ReadDopingNa(ctx)+N1;
+    PetscScalar Nd  = ReadDopingNd(ctx)+N1;
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     PetscScalar Nsc = Nds+Nas+fabs(n);
@@ -330,13 +330,13 @@ private:
     PetscScalar mu_scatt = mu1*(Nsc/Nsce)*std::pow(NRFP_UM/Nsc,ALPP_UM)+mu2*(fabs(n+p)/Nsce);
     return 1.0/(1.0/mu_lattice+1.0/mu_scatt);
   }
-  AutoDScalar HoleMobPhilips(const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
+  AutoDScalar HoleMobPhilips(const PMI_Context &ctx, const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl) const
   {
     AutoDScalar mu_lattice = MMXP_UM*adtl::pow(Tl/T300,-TETP_UM);
     AutoDScalar mu1 = MMXP_UM*MMXP_UM/(MMXP_UM-MMNP_UM)*adtl::pow(Tl/T300,3*ALPP_UM-1.5);
     AutoDScalar mu2 = MMXP_UM*MMNP_UM/(MMXP_UM-MMNP_UM)*sqrt(T300/Tl);
-    PetscScalar Na  = ReadDopingNa()+N1;
-    PetscScalar Nd  = ReadDopingNd()+N1;
+    PetscScalar Na  = ReadDopingNa(ctx)+N1;
+    PetscScalar Nd  = ReadDopingNd(ctx)+N1;
     PetscScalar Nds = Nd*(1.0+1.0/(CRFD_UM+(NRFD_UM/Nd)*(NRFD_UM/Nd)));
     PetscScalar Nas = Na*(1.0+1.0/(CRFA_UM+(NRFA_UM/Na)*(NRFA_UM/Na)));
     AutoDScalar Nsc = Nds+Nas+fabs(n);
@@ -355,10 +355,10 @@ private:
 
   //---------------------------------------------------------------------------
   //the surface acoustical phono scattering and roughness scattering for electron
-  PetscScalar ElecMobLombardi(const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl,const PetscScalar &Et) const
+  PetscScalar ElecMobLombardi(const PMI_Context &ctx, const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl,const PetscScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+N1;
     PetscScalar ET = fabs(Et)+E1;
     PetscScalar mu_ac = BN_LUC/ET + CN_LUC*std::pow(N_total,EXN4_LUC)*std::pow(Tl/T300,-KN_LUC)*std::pow(ET,PetscScalar(-1.0/3.0));
@@ -367,10 +367,10 @@ private:
     PetscScalar mu_sr = DN_LUC*std::pow(ET/E1,-r);
     return 1.0/(1.0/mu_ac+1.0/mu_sr);
   }
-  AutoDScalar ElecMobLombardi(const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl,const AutoDScalar &Et) const
+  AutoDScalar ElecMobLombardi(const PMI_Context &ctx, const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl,const AutoDScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+N1;
     AutoDScalar ET = fabs(Et)+E1;
     AutoDScalar mu_ac = BN_LUC/ET + CN_LUC*std::pow(N_total,EXN4_LUC)*adtl::pow(Tl/T300,-KN_LUC)*adtl::pow(ET,PetscScalar(-1.0/3.0));
@@ -382,10 +382,10 @@ private:
 
   //---------------------------------------------------------------------------
   //the surface acoustical phono scattering and roughness scattering for hole
-  PetscScalar HoleMobLombardi(const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl,const PetscScalar &Et) const
+  PetscScalar HoleMobLombardi(const PMI_Context &ctx, const PetscScalar &p,const PetscScalar &n,const PetscScalar &Tl,const PetscScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+N1;
     PetscScalar ET = fabs(Et)+E1;
     PetscScalar mu_ac = BP_LUC/ET + CP_LUC*std::pow(N_total,EXP4_LUC)*std::pow(Tl/T300,-KP_LUC)*std::pow(ET,PetscScalar(-1.0/3.0));
@@ -393,10 +393,10 @@ private:
     PetscScalar mu_sr = DP_LUC*std::pow(ET/E1,-r);
     return 1.0/(1.0/mu_ac+1.0/mu_sr);
   }
-  AutoDScalar HoleMobLombardi(const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl,const AutoDScalar &Et) const
+  AutoDScalar HoleMobLombardi(const PMI_Context &ctx, const AutoDScalar &p,const AutoDScalar &n,const AutoDScalar &Tl,const AutoDScalar &Et) const
   {
-    PetscScalar Na = ReadDopingNa();
-    PetscScalar Nd = ReadDopingNd();
+    PetscScalar Na = ReadDopingNa(ctx);
+    PetscScalar Nd = ReadDopingNd(ctx);
     PetscScalar N_total = Na+Nd+N1;
     AutoDScalar ET = fabs(Et)+E1;
     AutoDScalar mu_ac = BP_LUC/ET + CP_LUC*std::pow(N_total,EXP4_LUC)*adtl::pow(Tl/T300,-KP_LUC)*adtl::pow(ET,PetscScalar(-1.0/3.0));
@@ -411,65 +411,65 @@ public:
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  PetscScalar ZETAN() { return 1.0; }
+  PetscScalar ZETAN(const PMI_Context &ctx) { return 1.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in the field-dependent mobility models for electrons.
    */
-  PetscScalar ETAN()  { return 0.5; }
+  PetscScalar ETAN(const PMI_Context &ctx)  { return 0.5; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  PetscScalar ZETAP() { return 1.0; }
+  PetscScalar ZETAP(const PMI_Context &ctx) { return 1.0; }
 
   /**
    * A factor used in determining the effective electric field at interfaces
    * used in field-dependent mobility models for holes.
    */
-  PetscScalar ETAP()  { return 0.333; }
+  PetscScalar ETAP(const PMI_Context &ctx)  { return 0.333; }
 
 
   // Hall mobility factor  for electrons
-  PetscScalar RH_ELEC()  { return 1.1; }
+  PetscScalar RH_ELEC(const PMI_Context &ctx)  { return 1.1; }
 
   // Hall mobility factor  for holes
-  PetscScalar RH_HOLE()  { return 0.7; }
+  PetscScalar RH_HOLE(const PMI_Context &ctx)  { return 0.7; }
 
 
   //---------------------------------------------------------------------------
   // Electron mobility
-  PetscScalar ElecMob(const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar ElecMob(const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                       const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tn) const
   {
     PetscScalar vsat = VSATN0*std::pow(T300/Tl, VSATN_EXP);
-    PetscScalar mu0  = 1.0/(1.0/ElecMobPhilips(p,n,Tl)+1.0/ElecMobLombardi(p,n,Tl,Et));
+    PetscScalar mu0  = 1.0/(1.0/ElecMobPhilips(ctx, p,n,Tl)+1.0/ElecMobLombardi(ctx, p,n,Tl,Et));
     return 2*mu0/(1+std::pow(1+std::pow(2*mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN));
   }
-  AutoDScalar ElecMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar ElecMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tn) const
   {
     AutoDScalar vsat = VSATN0*adtl::pow(T300/Tl, VSATN_EXP);
-    AutoDScalar mu0  = 1.0/(1.0/ElecMobPhilips(p,n,Tl)+1.0/ElecMobLombardi(p,n,Tl,Et));
+    AutoDScalar mu0  = 1.0/(1.0/ElecMobPhilips(ctx, p,n,Tl)+1.0/ElecMobLombardi(ctx, p,n,Tl,Et));
     return 2*mu0/(1+adtl::pow(1+adtl::pow(2*mu0*fabs(Ep)/vsat,BETAN),1.0/BETAN));
   }
 
   //---------------------------------------------------------------------------
   // Hole mobility
-  PetscScalar HoleMob (const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
+  PetscScalar HoleMob (const PMI_Context &ctx, const PetscScalar &p, const PetscScalar &n, const PetscScalar &Tl,
                        const PetscScalar &Ep, const PetscScalar &Et, const PetscScalar &Tp) const
   {
     PetscScalar vsat = VSATP0*std::pow(T300/Tl, VSATP_EXP);
-    PetscScalar mu0  = 1.0/(1.0/HoleMobPhilips(p,n,Tl)+1.0/HoleMobLombardi(p,n,Tl,Et));
+    PetscScalar mu0  = 1.0/(1.0/HoleMobPhilips(ctx, p,n,Tl)+1.0/HoleMobLombardi(ctx, p,n,Tl,Et));
     return 2*mu0/(1+std::pow(1+std::pow(2*mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP));
   }
-  AutoDScalar HoleMob(const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
+  AutoDScalar HoleMob(const PMI_Context &ctx, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &Tl,
                       const AutoDScalar &Ep, const AutoDScalar &Et, const AutoDScalar &Tp) const
   {
     AutoDScalar vsat = VSATP0*adtl::pow(T300/Tl, VSATP_EXP);
-    AutoDScalar mu0  = 1.0/(1.0/HoleMobPhilips(p,n,Tl)+1.0/HoleMobLombardi(p,n,Tl,Et));
+    AutoDScalar mu0  = 1.0/(1.0/HoleMobPhilips(ctx, p,n,Tl)+1.0/HoleMobLombardi(ctx, p,n,Tl,Et));
     return 2*mu0/(1+adtl::pow(1+adtl::pow(2*mu0*fabs(Ep)/vsat,BETAP),1.0/BETAP));
   }
 
@@ -82,7 +82,7 @@ private:
 public:
   //---------------------------------------------------------------------------
   // Heat Capacity, cover the T range of [20,1500]
-  PetscScalar HeatCapacity  (const PetscScalar &Tl) const
+  PetscScalar HeatCapacity  (const PMI_Context &ctx, const PetscScalar &Tl) const
   {
     if(Tl > 20*K)
       return A_SP_HEA + B_SP_HEA*Tl + C_SP_HEA*Tl*Tl + F_SP_HEA*Tl*Tl*Tl + G_SP_HEA*Tl*Tl*Tl*Tl + H_SP_HEA*Tl*Tl*Tl*Tl*Tl;
@@ -94,7 +94,7 @@ public:
     }
     return 0.0;
   }
-  AutoDScalar HeatCapacity  (const AutoDScalar &Tl) const
+  AutoDScalar HeatCapacity  (const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
     if(Tl > 20*K)
       return A_SP_HEA + B_SP_HEA*Tl + C_SP_HEA*Tl*Tl + F_SP_HEA*Tl*Tl*Tl + G_SP_HEA*Tl*Tl*Tl*Tl + H_SP_HEA*Tl*Tl*Tl*Tl*Tl;
@@ -109,11 +109,11 @@ public:
 
   //---------------------------------------------------------------------------
   // Heat Conduction
-  PetscScalar HeatConduction(const PetscScalar &Tl) const
+  PetscScalar HeatConduction(const PMI_Context &ctx, const PetscScalar &Tl) const
   {
     return 1.0/(A_TH_CON + B_TH_CON*Tl + C_TH_CON*Tl*Tl);
   }
-  AutoDScalar HeatConduction(const AutoDScalar &Tl) const
+  AutoDScalar HeatConduction(const PMI_Context &ctx, const AutoDScalar &Tl) const
   {
     return 1.0/(A_TH_CON + B_TH_CON*Tl + C_TH_CON*Tl*Tl);
   }
@@ -267,13 +267,53 @@ public:
     }
   }
 
+  /**
+   * save the occupancy history of all the traps, in the order of TrapStore
+   */
+  void Checkpoint(std::vector<PetscScalar> &state) const
+  {
+    for (TrapStore_t::const_iterator it=TrapStore.begin(); it!=TrapStore.end(); it++)
+      for (std::vector<Trap>::const_iterator ptrap=it->second.begin(); ptrap!=it->second.end(); ptrap++)
+      {
+        state.push_back(ptrap->n_t);
+        state.push_back(ptrap->n_t_last);
+        state.push_back(ptrap->n_t_last_last);
+        state.push_back(ptrap->clock_last);
+        state.push_back(ptrap->clock_last_last);
+      }
+  }
+
+  /**
+   * restore the occupancy history of all the traps, the traps should be created in the same order
+   */
+  bool Restart(const std::vector<PetscScalar> &state)
+  {
+    size_t n_traps = 0;
+    for (TrapStore_t::const_iterator it=TrapStore.begin(); it!=TrapStore.end(); it++)
+      n_traps += it->second.size();
+    if (state.size() != 5*n_traps) return false;
+
+    std::vector<PetscScalar>::const_iterator s = state.begin();
+    for (TrapStore_t::iterator it=TrapStore.begin(); it!=TrapStore.end(); it++)
+      for (std::vector<Trap>::iterator ptrap=it->second.begin(); ptrap!=it->second.end(); ptrap++)
+      {
+        ptrap->n_t             = *s++;
+        ptrap->n_t_AD          = ptrap->n_t;
+        ptrap->n_t_last        = *s++;
+        ptrap->n_t_last_last   = *s++;
+        ptrap->clock_last      = *s++;
+        ptrap->clock_last_last = *s++;
+      }
+    return true;
+  }
+
   /**
    * returns the electric charge density due to trapped charge at this node
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  PetscScalar Charge(const bool flag_bulk)
+  PetscScalar Charge(const PMI_Context &ctx, const bool flag_bulk)
   {
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -302,9 +342,9 @@ public:
    * w.r.t. the local V,n,p
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  AutoDScalar ChargeAD(const bool flag_bulk)
+  AutoDScalar ChargeAD(const PMI_Context &ctx, const bool flag_bulk)
   {
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -329,11 +369,11 @@ public:
    * Calculates the electron trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  PetscScalar ElectronTrapRate(const bool flag_bulk, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
+  PetscScalar ElectronTrapRate(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
   {
     PetscScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);     // electron thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -366,11 +406,11 @@ public:
    * Calculates the partial derivatives of electron trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  AutoDScalar ElectronTrapRate(const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl)
+  AutoDScalar ElectronTrapRate(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl)
   {
     AutoDScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -401,11 +441,11 @@ public:
    * Calculates the hole trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  PetscScalar HoleTrapRate(const bool flag_bulk, const PetscScalar &p, const PetscScalar &ni, const PetscScalar &Tl)
+  PetscScalar HoleTrapRate(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &ni, const PetscScalar &Tl)
   {
     PetscScalar theta_p = 1.0e7*cm/s * sqrt(Tl/300/K);     // hole thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -438,11 +478,11 @@ public:
    *  Calculates the partial derivatives of hole trapping rate
    * one should call Calculate() to calculate the electron occupancy before calling this function
    */
-  AutoDScalar HoleTrapRate(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &ni, const AutoDScalar &Tl)
+  AutoDScalar HoleTrapRate(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &ni, const AutoDScalar &Tl)
   {
     AutoDScalar theta_p = 1.0e7*cm/s * sqrt(Tl/300/K);
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -468,12 +508,12 @@ public:
     }
   }
 
-  PetscScalar TrapHeat(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tp, const PetscScalar &Tn, const PetscScalar &Tl, const PetscScalar &EcEi, const PetscScalar &EiEv)
+  PetscScalar TrapHeat(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tp, const PetscScalar &Tn, const PetscScalar &Tl, const PetscScalar &EcEi, const PetscScalar &EiEv)
   {
     PetscScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);     // electron thermal velocity
     PetscScalar theta_p = 1.0e7*cm/s * sqrt(Tl/300/K);     // hole thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -510,12 +550,12 @@ public:
     }
   }
 
-  AutoDScalar TrapHeat(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tp, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi, const AutoDScalar &EiEv)
+  AutoDScalar TrapHeat(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tp, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi, const AutoDScalar &EiEv)
   {
     AutoDScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);     // electron thermal velocity
     AutoDScalar theta_p = 1.0e7*cm/s * sqrt(Tl/300/K);     // hole thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -552,11 +592,11 @@ public:
     }
   }
 
-  AutoDScalar ElectronTrapHeat(const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi)
+  AutoDScalar ElectronTrapHeat(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tn, const AutoDScalar &Tl, const AutoDScalar &EcEi)
   {
     AutoDScalar theta_n = 1.0e7*cm/s * sqrt(Tl/300/K);     // electron thermal velocity
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -591,15 +631,15 @@ public:
    * Actually create traps as specified in PMI commands
    * Called when PMIs are initialized.
    */
-  void init_node()
+  void init_node(const PMI_Context &ctx)
   {
     for (unsigned int i=0; i<TrapSpecs.size(); i++)
     {
       if (TrapSpecs[i].type!=Bulk) continue;  // we only process bulk traps here
-      PetscScalar conc = ReadRealVariable(TrapSpecs[i].profile_name); // read concentration from profile
+      PetscScalar conc = ReadRealVariable(ctx, TrapSpecs[i].profile_name); // read concentration from profile
       conc=conc*TrapSpecs[i].prefactor;     // concentration is scaled by the prefactor
       if (conc>0)
-        AddTrap(*(*pp_point),i,conc);
+        AddTrap(*ctx.point,i,conc);
     }
   }
 
@@ -607,7 +647,7 @@ public:
    * Actually create interface traps as specified in PMI commands
    * Called when PMIs are initialized.
    */
-  void init_bc_node(const std::string & bc_label)
+  void init_bc_node(const PMI_Context &ctx, const std::string & bc_label)
   {
     for (unsigned int i=0; i<TrapSpecs.size(); i++)
     {
@@ -618,23 +658,23 @@ public:
       PetscScalar conc = 0.0;
       
       if(!TrapSpecs[i].interface_profile_name.empty())
-        conc += ReadRealVariable(TrapSpecs[i].interface_profile_name)*TrapSpecs[i].prefactor;
+        conc += ReadRealVariable(ctx, TrapSpecs[i].interface_profile_name)*TrapSpecs[i].prefactor;
       
       if (TrapSpecs[i].interface_name == bc_label)
         conc += TrapSpecs[i].interface_density*TrapSpecs[i].prefactor;
             
       if (conc>0)
-        AddTrap(*(*pp_point),i,conc);
+        AddTrap(*ctx.point,i,conc);
     }
   }
 
   /**
    * Calculate trap occupancy. The time-derivative term is included with BDF1 discretization
    */
-  void Calculate(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
+  void Calculate(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
   {
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -657,13 +697,13 @@ public:
         A = sigma_n * theta_n * (n + ni/g_n*exp( E_t/kb/Tl)) + sigma_p * theta_p * (p + ni/g_p*exp(-E_t/kb/Tl));
         B = ptrap->N_tt * ( sigma_n * theta_n * n + sigma_p * theta_p * ni / g_p * exp(-E_t/kb/Tl) );
 
-        if (ReadTime() > ptrap->clock_last)
+        if (ReadTime(ctx) > ptrap->clock_last)
         {
           // we should consider the time derivative of trap occupancy
           if (ptrap->clock_last > ptrap->clock_last_last)
           {
             // We have two previous time step available, use BDF2 discretization
-            PetscScalar d =  1.0 / (ReadTime() - ptrap->clock_last_last);
+            PetscScalar d =  1.0 / (ReadTime(ctx) - ptrap->clock_last_last);
             PetscScalar r = (ptrap->clock_last - ptrap->clock_last_last) * d;
 
             A = A + d * (2-r)/(1-r);
@@ -672,7 +712,7 @@ public:
           else
           {
             // We have two previous time step available, use BDF1 discretization
-            PetscScalar d =  1.0 / (ReadTime() - ptrap->clock_last);
+            PetscScalar d =  1.0 / (ReadTime(ctx) - ptrap->clock_last);
             A = A + d;
             B = B + ptrap->n_t_last * d;
 
@@ -688,10 +728,10 @@ public:
    * partial derivatives of trap occupancy w.r.t. local V,n,p,
    * The time-derivative term is included with BDF1 discretization
    */
-  void Calculate(const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl)
+  void Calculate(const PMI_Context &ctx, const bool flag_bulk, const AutoDScalar &p, const AutoDScalar &n, const AutoDScalar &ni, const AutoDScalar &Tl)
   {
 
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
@@ -713,13 +753,13 @@ public:
         A = sigma_n * theta_n * (n + ni/g_n*exp( E_t/kb/Tl)) + sigma_p * theta_p * (p + ni/g_p*exp(-E_t/kb/Tl));
         B = ptrap->N_tt * ( sigma_n * theta_n * n + sigma_p * theta_p * ni / g_p * exp(-E_t/kb/Tl) );
 
-        if (ReadTime() > ptrap->clock_last)
+        if (ReadTime(ctx) > ptrap->clock_last)
         {
           // we should consider the time derivative of trap occupancy
           if (ptrap->clock_last > ptrap->clock_last_last)
           {
             // We have two previous time step available, use BDF2 discretization
-            PetscScalar d =  1.0 / (ReadTime() - ptrap->clock_last_last);
+            PetscScalar d =  1.0 / (ReadTime(ctx) - ptrap->clock_last_last);
             PetscScalar r = (ptrap->clock_last - ptrap->clock_last_last) * d;
 
             A = A + d * (2-r)/(1-r);
@@ -728,7 +768,7 @@ public:
           else
           {
             // We have two previous time step available, use BDF1 discretization
-            PetscScalar d =  1.0 / (ReadTime() - ptrap->clock_last);
+            PetscScalar d =  1.0 / (ReadTime(ctx) - ptrap->clock_last);
             A = A + d;
             B = B + ptrap->n_t_last * d;
           }
@@ -742,16 +782,16 @@ public:
   /**
    * Converged results are obtained, so we should update the solution
    */
-  void Update(const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
+  void Update(const PMI_Context &ctx, const bool flag_bulk, const PetscScalar &p, const PetscScalar &n, const PetscScalar &ni, const PetscScalar &Tl)
   {
-    TrapLocation tloc = TrapLocation((*pp_point)->x(), (*pp_point)->y(), (*pp_point)->z(), flag_bulk?Bulk:Interface);
+    TrapLocation tloc = TrapLocation(ctx.point->x(), ctx.point->y(), ctx.point->z(), flag_bulk?Bulk:Interface);
 
     TrapStore_t::iterator it = TrapStore.find(tloc);
 
     if (it != TrapStore.end())
     {
       // Trap::n_t should already contain the correct solution, however let's play safe and calculate again
-      Calculate(flag_bulk, p, n, ni, Tl);
+      Calculate(ctx, flag_bulk, p, n, ni, Tl);
 
       std::vector<Trap> & traps = it->second;
       for (std::vector<Trap>::iterator ptrap=traps.begin(); ptrap!=traps.end(); ptrap++)
@@ -762,7 +802,7 @@ public:
 
         // update timestamp
         ptrap->clock_last_last = ptrap->clock_last;
-        ptrap->clock_last = ReadTime();
+        ptrap->clock_last = ReadTime(ctx);
       }
     }
   }
@@ -51,7 +51,7 @@ namespace Material
 {
 
   MaterialBase::MaterialBase(const SimulationRegion * reg)
-  : set_ad_num(0),  region(reg) , material(reg->material()), p_point(0), p_node_data(0), dll_file(0)
+  : set_ad_num(0),  region(reg) , material(reg->material()), dll_file(0)
   {
     point_variables = &(region->region_point_variables());
     cell_variables = &(region->region_cell_variables());
@@ -70,7 +70,7 @@ namespace Material
 
   PMI_Environment MaterialBase::build_PMI_Environment()
   {
-     PMI_Environment env(  &p_point, &p_node_data, &clock, &point_variables,
+     PMI_Environment env(  &point_variables,
                             PhysicalUnit::m, PhysicalUnit::s, PhysicalUnit::V, PhysicalUnit::C, PhysicalUnit::K);
      return env;
   }
@@ -201,29 +201,29 @@ namespace Material
 
   void MaterialSemiconductor::init_node(const std::string &type, const Point* point, FVM_NodeData* node_data)
   {
-    mapping(point, node_data, clock);
+    const PMI_Context ctx = mapping(point, node_data, 0.0);
     switch ( PMI_Type_string_to_enum(type) )
     {
     case Basic:
-      basic->init_node();
+      basic->init_node(ctx);
       break;
     case Band:
-      band->init_node();
+      band->init_node(ctx);
       break;
     case Mobility:
-      mob->init_node();
+      mob->init_node(ctx);
       break;
     case Impact:
-      gen->init_node();
+      gen->init_node(ctx);
       break;
     case Thermal:
-      thermal->init_node();
+      thermal->init_node(ctx);
       break;
     case Optical:
-      optical->init_node();
+      optical->init_node(ctx);
       break;
     case Trap:
-      trap->init_node();
+      trap->init_node(ctx);
       break;
     default: genius_error();
     }
@@ -231,7 +231,7 @@ namespace Material
 
   void MaterialSemiconductor::init_bc_node(const std::string &type, const std::string & bc_label, const Point* point, FVM_NodeData* node_data)
   {
-    this->mapping(point,node_data,clock);
+    const PMI_Context ctx = mapping(point, node_data, 0.0);
 
     switch(PMI_Type_string_to_enum(type))
     {
@@ -243,7 +243,7 @@ namespace Material
     case Optical:
       break;
     case Trap:
-      trap->init_bc_node(bc_label);
+      trap->init_bc_node(ctx, bc_label);
       break;
     default: genius_error();
     }
@@ -519,20 +519,20 @@ namespace Material
 
   void MaterialInsulator::init_node(const std::string &type, const Point* point, FVM_NodeData* node_data)
   {
-    mapping(point, node_data, clock);
+    const PMI_Context ctx = mapping(point, node_data, 0.0);
     switch ( PMI_Type_string_to_enum(type) )
     {
     case Basic:
-      basic->init_node();
+      basic->init_node(ctx);
       break;
     case Band:
-      band->init_node();
+      band->init_node(ctx);
       break;
     case Thermal:
-      thermal->init_node();
+      thermal->init_node(ctx);
       break;
     case Optical:
-      optical->init_node();
+      optical->init_node(ctx);
       break;
     default: genius_error();
     }
@@ -541,7 +541,6 @@ namespace Material
   void MaterialInsulator::init_bc_node(const std::string &type, const std::string & bc_label, const Point* point, FVM_NodeData* node_data)
   {
     genius_assert(bc_label.length()); //prevent compiler warning
-    this->mapping(point, node_data, clock);
 
     switch(PMI_Type_string_to_enum(type))
     {
@@ -740,17 +739,17 @@ namespace Material
 
   void MaterialConductor::init_node(const std::string &type, const Point* point, FVM_NodeData* node_data)
   {
-    mapping(point, node_data, clock);
+    const PMI_Context ctx = mapping(point, node_data, 0.0);
     switch ( PMI_Type_string_to_enum(type) )
     {
     case Basic:
-      basic->init_node();
+      basic->init_node(ctx);
       break;
     case Thermal:
-      thermal->init_node();
+      thermal->init_node(ctx);
       break;
     case Optical:
-      optical->init_node();
+      optical->init_node(ctx);
       break;
     default: genius_error();
     }
@@ -760,7 +759,6 @@ namespace Material
   {
     genius_assert(bc_label.length()); //prevent compiler warning
 
-    this->mapping(point,node_data,clock);
 
     switch(PMI_Type_string_to_enum(type))
     {
@@ -937,17 +935,17 @@ namespace Material
 
   void MaterialVacuum::init_node(const std::string &type, const Point* point, FVM_NodeData* node_data)
   {
-    mapping(point, node_data, clock);
+    const PMI_Context ctx = mapping(point, node_data, 0.0);
     switch ( PMI_Type_string_to_enum(type) )
     {
     case Basic:
-      basic->init_node();
+      basic->init_node(ctx);
       break;
     case Thermal:
-      thermal->init_node();
+      thermal->init_node(ctx);
       break;
     case Optical:
-      optical->init_node();
+      optical->init_node(ctx);
       break;
     default: genius_error();
     }
@@ -957,7 +955,6 @@ namespace Material
   {
     genius_assert(bc_label.length()); //prevent compiler warning
 
-    this->mapping(point,node_data,clock);
 
     switch(PMI_Type_string_to_enum(type))
     {
@@ -1116,14 +1113,14 @@ namespace Material
 
   void MaterialPML::init_node(const std::string &type, const Point* point, FVM_NodeData* node_data)
   {
-    mapping(point, node_data, clock);
+    const PMI_Context ctx = mapping(point, node_data, 0.0);
     switch ( PMI_Type_string_to_enum(type) )
     {
     case Basic:
-      basic->init_node();
+      basic->init_node(ctx);
       break;
     case Thermal:
-      thermal->init_node();
+      thermal->init_node(ctx);
       break;
     default: genius_error();
     }
@@ -1133,7 +1130,6 @@ namespace Material
   {
     genius_assert(bc_label.length()); //prevent compiler warning
 
-    this->mapping(point,node_data,clock);
 
     switch(PMI_Type_string_to_enum(type))
     {
@@ -0,0 +1,162 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#include "genius_petsc.h"
+#include "buffered_matrix.h"
+
+
+
+template <typename T>
+BufferedMatrix<T>::BufferedMatrix (const SparseMatrix<T> * layout)
+  : SparseMatrix<T>(layout)
+{
+  this->_is_initialized = true;
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::clear ()
+{
+  std::vector<Block>().swap(_blocks);
+  std::vector<int>().swap(_cols);
+  std::vector<T>().swap(_values);
+  std::vector<int>().swap(_slots);
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::zero ()
+{
+  // keep the capacity for the next assembly
+  _blocks.clear();
+  _cols.clear();
+  _values.clear();
+  _slots.clear();
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::set (const unsigned int i, const unsigned int j, const T value)
+{
+  _new_block(i, 1, true);
+  _cols.push_back(j);
+  _values.push_back(value);
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::add (const unsigned int i, const unsigned int j, const T value)
+{
+  _new_block(i, 1, false);
+  _cols.push_back(j);
+  _values.push_back(value);
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::add_row (unsigned int row, const std::vector<unsigned int> &cols, const T* dm)
+{
+  if( cols.empty() ) return;
+  this->add_row(row, static_cast<unsigned int>(cols.size()), &cols[0], dm);
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::add_row (unsigned int row, unsigned int n, const unsigned int * cols, const T* dm)
+{
+  _new_block(row, n, false);
+  for(unsigned int i=0; i<n; ++i)
+  {
+    _cols.push_back(cols[i]);
+    _values.push_back(dm[i]);
+  }
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::add_row (unsigned int row, int n, const int * cols, const T* dm)
+{
+  _new_block(row, n, false);
+  _cols.insert(_cols.end(), cols, cols+n);
+  _values.insert(_values.end(), dm, dm+n);
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::add_row (unsigned int row, int n, const int * cols, const int * slots, const T* dm)
+{
+  this->add_row(row, n, cols, dm);
+  if( !slots ) return;
+
+  _blocks.back().slot_offset = _slots.size();
+  _slots.insert(_slots.end(), slots, slots+n);
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::add_matrix (const std::vector<unsigned int> &rows, const std::vector<unsigned int> &cols, const T* dm)
+{
+  for(unsigned int i=0; i<rows.size(); ++i)
+    this->add_row(rows[i], cols, dm + i*cols.size());
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::add_matrix (unsigned int m, unsigned int * rows, unsigned int n, unsigned int * cols, const T* dm)
+{
+  for(unsigned int i=0; i<m; ++i)
+    this->add_row(rows[i], n, cols, dm + i*n);
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::flush (SparseMatrix<T> * mat)
+{
+  for(unsigned int b=0; b<_blocks.size(); ++b)
+  {
+    const Block & block = _blocks[b];
+    if( block.insert )
+    {
+      for(unsigned int i=0; i<block.n; ++i)
+        mat->set(block.row, _cols[block.offset+i], _values[block.offset+i]);
+    }
+    else if( block.slot_offset >= 0 )
+      mat->add_row(block.row, static_cast<int>(block.n), &_cols[block.offset], &_slots[block.slot_offset], &_values[block.offset]);
+    else
+      mat->add_row(block.row, static_cast<int>(block.n), &_cols[block.offset], &_values[block.offset]);
+  }
+
+  this->zero();
+}
+
+
+template <typename T>
+void BufferedMatrix<T>::print_personal(std::ostream& os) const
+{
+  os << "BufferedMatrix with " << _blocks.size() << " operations, " << _values.size() << " entries." << std::endl;
+}
+
+
+
+//------------------------------------------------------------------
+// Explicit instantiations
+template class BufferedMatrix<PetscScalar>;
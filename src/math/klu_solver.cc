@@ -0,0 +1,201 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#include "genius_common.h"
+#include "genius_env.h"
+#include "log.h"
+#include "klu_solver.h"
+
+#include "petscmat.h"
+#include "petscvec.h"
+
+const double KLUSolver::_rcond_tol = 1e-12;
+
+
+/*------------------------------------------------------------------
+ * PETSc shell preconditioner interface
+ */
+#if PETSC_VERSION_GE(3,1,0)
+static PetscErrorCode KLU_PCSetUp(PC pc)
+{
+  void * ctx;
+  PCShellGetContext(pc, &ctx);
+  KLUSolver * klu = static_cast<KLUSolver *>(ctx);
+
+  Mat A, P;
+#if PETSC_VERSION_GE(3,5,0)
+  PCGetOperators(pc, &A, &P);
+#else
+  MatStructure flag;
+  PCGetOperators(pc, &A, &P, &flag);
+#endif
+  return klu->setup(P);
+}
+
+static PetscErrorCode KLU_PCApply(PC pc, Vec b, Vec x)
+{
+  void * ctx;
+  PCShellGetContext(pc, &ctx);
+  KLUSolver * klu = static_cast<KLUSolver *>(ctx);
+  return klu->solve(b, x);
+}
+#endif
+
+
+
+KLUSolver::KLUSolver()
+  : _symbolic(0), _numeric(0)
+{
+  klu_defaults(&_common);
+  // keep going with a singular matrix, the inf/nan in the solution
+  // let the nonlinear solver fail and cut the step
+  _common.halt_if_singular = 0;
+}
+
+
+KLUSolver::~KLUSolver()
+{
+  clear();
+}
+
+
+void KLUSolver::clear()
+{
+  if(_numeric)  klu_free_numeric(&_numeric, &_common);
+  if(_symbolic) klu_free_symbolic(&_symbolic, &_common);
+  _numeric = 0;
+  _symbolic = 0;
+  _row_ptr.clear();
+  _col_idx.clear();
+  _values.clear();
+}
+
+
+void KLUSolver::attach(PC pc)
+{
+#if PETSC_VERSION_GE(3,1,0)
+  PetscErrorCode ierr;
+  ierr = PCSetType(pc, PCSHELL); genius_assert(!ierr);
+  ierr = PCShellSetContext(pc, this); genius_assert(!ierr);
+  ierr = PCShellSetSetUp(pc, KLU_PCSetUp); genius_assert(!ierr);
+  ierr = PCShellSetApply(pc, KLU_PCApply); genius_assert(!ierr);
+  ierr = PCShellSetName(pc, "KLU"); genius_assert(!ierr);
+#else
+  MESSAGE<<"ERROR: KLU solver requires PETSc 3.1 or later." << std::endl; RECORD();
+  genius_error();
+#endif
+}
+
+
+bool KLUSolver::_extract(Mat A)
+{
+  PetscInt M, N;
+  MatGetSize(A, &M, &N);
+  genius_assert(M == N);
+
+  std::vector<int> row_ptr;
+  row_ptr.reserve(M+1);
+  row_ptr.push_back(0);
+
+  std::vector<int> col_idx;
+  col_idx.reserve(_col_idx.size());
+  _values.clear();
+  _values.reserve(_col_idx.size());
+
+  for(PetscInt i=0; i<M; ++i)
+  {
+    PetscInt ncols;
+    const PetscInt * cols;
+    const PetscScalar * vals;
+    MatGetRow(A, i, &ncols, &cols, &vals);
+    for(PetscInt j=0; j<ncols; ++j)
+    {
+      col_idx.push_back(cols[j]);
+      _values.push_back(vals[j]);
+    }
+    MatRestoreRow(A, i, &ncols, &cols, &vals);
+    row_ptr.push_back(col_idx.size());
+  }
+
+  bool same_pattern = (row_ptr == _row_ptr && col_idx == _col_idx);
+  if(!same_pattern)
+  {
+    _row_ptr.swap(row_ptr);
+    _col_idx.swap(col_idx);
+  }
+  return same_pattern;
+}
+
+
+PetscErrorCode KLUSolver::setup(Mat A)
+{
+  // the CSR arrays of A are the CSC arrays of A^T
+  bool same_pattern = _extract(A);
+  int n = _row_ptr.size() - 1;
+
+  // numerical refactorization with the old ordering and pivot sequence
+  if(same_pattern && _symbolic && _numeric)
+  {
+    if( klu_refactor(&_row_ptr[0], &_col_idx[0], &_values[0], _symbolic, _numeric, &_common) &&
+        klu_rcond(_symbolic, _numeric, &_common) && _common.rcond > _rcond_tol )
+      return 0;
+  }
+
+  if(_numeric) klu_free_numeric(&_numeric, &_common);
+
+  if(!same_pattern || !_symbolic)
+  {
+    if(_symbolic) klu_free_symbolic(&_symbolic, &_common);
+    _symbolic = klu_analyze(n, &_row_ptr[0], &_col_idx[0], &_common);
+    if(!_symbolic)
+    {
+      MESSAGE<<"ERROR: KLU symbolic analysis failed with status " << _common.status << "." << std::endl; RECORD();
+      genius_error();
+    }
+  }
+
+  // full factorization with partial pivoting
+  _numeric = klu_factor(&_row_ptr[0], &_col_idx[0], &_values[0], _symbolic, &_common);
+  if(!_numeric)
+  {
+    MESSAGE<<"ERROR: KLU factorization failed with status " << _common.status << "." << std::endl; RECORD();
+    genius_error();
+  }
+
+  return 0;
+}
+
+
+PetscErrorCode KLUSolver::solve(Vec b, Vec x)
+{
+  PetscErrorCode ierr;
+  ierr = VecCopy(b, x); CHKERRQ(ierr);
+
+  PetscInt n;
+  PetscScalar * xx;
+  ierr = VecGetLocalSize(x, &n); CHKERRQ(ierr);
+  ierr = VecGetArray(x, &xx); CHKERRQ(ierr);
+  klu_tsolve(_symbolic, _numeric, n, 1, xx, &_common);
+  ierr = VecRestoreArray(x, &xx); CHKERRQ(ierr);
+
+  return 0;
+}
@@ -19,6 +19,7 @@
 
 
 // C++ includes
+#include <set>
 #include "config.h"
 
 
@@ -27,12 +28,16 @@
 // Local includes
 #include "petsc_matrix.h"
 #include "parallel.h"
+#include "perf_log.h"
 
 
 
 //-----------------------------------------------------------------------
 // PetscMatrix members
 
+template <typename T>
+unsigned int PetscMatrix<T>::_csr_pattern_counter = 0;
+
 //-----------------------------------------------------------------------
 // PetscMatrix inline members
 template <typename T>
@@ -40,6 +45,13 @@ PetscMatrix<T>::PetscMatrix(const unsigned int m,   const unsigned int n,
                             const unsigned int m_l, const unsigned int n_l)
   : SparseMatrix<T>(m,n,m_l,n_l), 
     _mat_buf_mode(true), 
+    _mat_frozen_enabled(false),
+    _mat_frozen_mode(false),
+    _block_size(1),
+    _csr_n_spill(0),
+    _csr_pattern_synced(false),
+    _csr_raw_copy(false),
+    _csr_pattern_id(0),
     _add_value_flag(NOT_SET_VALUES), 
     _closed(false), 
     _destroy_mat_on_exit(false)
@@ -75,6 +87,29 @@ PetscMatrix<T>::~PetscMatrix()
 
 
 
+template <typename T>
+void PetscMatrix<T>::set_block_size (unsigned int bs)
+{
+  genius_assert (this->initialized());
+  genius_assert (_mat_buf_mode);
+  genius_assert (bs > 0 && SparseMatrix<T>::_m_local % bs == 0);
+
+  if( bs == _block_size ) return;
+  _block_size = bs;
+
+  int ierr = 0;
+  if (Genius::n_processors()==1)
+  {
+    ierr = MatSetType(_mat, bs > 1 ? MATSEQBAIJ : MATSEQAIJ); genius_assert(!ierr);
+  }
+  else
+  {
+    ierr = MatSetType(_mat, bs > 1 ? MATMPIBAIJ : MATMPIAIJ); genius_assert(!ierr);
+  }
+}
+
+
+
   
   
   
@@ -84,10 +119,10 @@ void PetscMatrix<T>::set (const unsigned int i, const unsigned int j, const T va
   genius_assert (this->initialized());
   genius_assert (_add_value_flag==INSERT_VALUES || _add_value_flag==NOT_SET_VALUES);
   
-  if(_mat_buf_mode)
+  if(_mat_buf_mode || _mat_frozen_mode)
   {
     if( SparseMatrix<T>::row_on_processor(i) )
-      _mat_local[i-SparseMatrix<T>::_global_offset][j] = value;
+      _local_entry(i-SparseMatrix<T>::_global_offset, j) = value;
     else 
       _mat_nonlocal[std::make_pair(i,j)] = value;
   }
@@ -110,10 +145,10 @@ void PetscMatrix<T>::add (const unsigned int i, const unsigned int j, const T va
   genius_assert (this->initialized());
   genius_assert (_add_value_flag==ADD_VALUES || _add_value_flag==NOT_SET_VALUES);
 
-  if(_mat_buf_mode)
+  if(_mat_buf_mode || _mat_frozen_mode)
   {
     if( SparseMatrix<T>::row_on_processor(i) )
-      _mat_local[i-SparseMatrix<T>::_global_offset][j] += value;
+      _local_entry(i-SparseMatrix<T>::_global_offset, j) += value;
     else 
       _mat_nonlocal[std::make_pair(i,j)] += value;
   }
@@ -135,12 +170,12 @@ void PetscMatrix<T>::add_row (unsigned int row, const std::vector<unsigned int>
   genius_assert (this->initialized());
   genius_assert (_add_value_flag==ADD_VALUES || _add_value_flag==NOT_SET_VALUES);
 
-  if(_mat_buf_mode)
+  if(_mat_buf_mode || _mat_frozen_mode)
   {
     if( SparseMatrix<T>::row_on_processor(row) )
     {
       for(unsigned int j=0; j<cols.size(); j++)
-         _mat_local[row-SparseMatrix<T>::_global_offset][cols[j]] += dm[j];
+         _local_entry(row-SparseMatrix<T>::_global_offset, cols[j]) += dm[j];
     }
     else
     {
@@ -166,12 +201,12 @@ void PetscMatrix<T>::add_row (unsigned int row, unsigned int n, const unsigned i
   genius_assert (this->initialized());
   genius_assert (_add_value_flag==ADD_VALUES || _add_value_flag==NOT_SET_VALUES);
 
-  if(_mat_buf_mode)
+  if(_mat_buf_mode || _mat_frozen_mode)
   {
     if( SparseMatrix<T>::row_on_processor(row) )
     {
       for(unsigned int j=0; j<n; j++)
-         _mat_local[row-SparseMatrix<T>::_global_offset][cols[j]] += dm[j];
+         _local_entry(row-SparseMatrix<T>::_global_offset, cols[j]) += dm[j];
     }
     else
     {
@@ -198,12 +233,12 @@ void PetscMatrix<T>::add_row (unsigned int row, int n, const int * cols, const T
   genius_assert (this->initialized());
   genius_assert (_add_value_flag==ADD_VALUES || _add_value_flag==NOT_SET_VALUES);
 
-  if(_mat_buf_mode)
+  if(_mat_buf_mode || _mat_frozen_mode)
   {
     if( SparseMatrix<T>::row_on_processor(row) )
     {
       for(int j=0; j<n; j++)
-         _mat_local[row-SparseMatrix<T>::_global_offset][cols[j]] += dm[j];
+         _local_entry(row-SparseMatrix<T>::_global_offset, cols[j]) += dm[j];
     }
     else
     {
@@ -224,6 +259,26 @@ void PetscMatrix<T>::add_row (unsigned int row, int n, const int * cols, const T
 }
 
 
+template <typename T>
+void PetscMatrix<T>::add_row (unsigned int row, int n, const int * cols, const int * slots, const T* dm)
+{
+  if( !slots || !_mat_frozen_mode )
+  {
+    this->add_row(row, n, cols, dm);
+    return;
+  }
+
+  genius_assert (_add_value_flag==ADD_VALUES || _add_value_flag==NOT_SET_VALUES);
+  genius_assert (SparseMatrix<T>::row_on_processor(row));
+
+  for(int j=0; j<n; j++)
+    _csr_values[slots[j]] += dm[j];
+
+  _closed = false;
+  _add_value_flag=ADD_VALUES;
+}
+
+
 template <typename T>
 void PetscMatrix<T>::add_matrix(const std::vector<unsigned int>& rows,
                                 const std::vector<unsigned int>& cols,
@@ -235,14 +290,14 @@ void PetscMatrix<T>::add_matrix(const std::vector<unsigned int>& rows,
   const unsigned int m = rows.size();
   const unsigned int n = cols.size();
 
-  if(_mat_buf_mode)
+  if(_mat_buf_mode || _mat_frozen_mode)
   {
     for(unsigned int i=0; i<m; i++)
     {
       if( SparseMatrix<T>::row_on_processor(rows[i]) )
       {
         for(unsigned int j=0; j<n; j++)
-          _mat_local[rows[i]-SparseMatrix<T>::_global_offset][cols[j]] += dm[i*n+j];
+          _local_entry(rows[i]-SparseMatrix<T>::_global_offset, cols[j]) += dm[i*n+j];
       }
       else
         for(unsigned int j=0; j<n; j++)
@@ -272,14 +327,14 @@ void PetscMatrix<T>::add_matrix (unsigned int m, unsigned int * rows,
   genius_assert (this->initialized());
   genius_assert (_add_value_flag==ADD_VALUES || _add_value_flag==NOT_SET_VALUES);
 
-  if(_mat_buf_mode)
+  if(_mat_buf_mode || _mat_frozen_mode)
   {
     for(unsigned int i=0; i<m; i++)
     {
       if( SparseMatrix<T>::row_on_processor(rows[i]) )
       {
         for(unsigned int j=0; j<n; j++)
-          _mat_local[rows[i]-SparseMatrix<T>::_global_offset][cols[j]] += dm[i*n+j];
+          _local_entry(rows[i]-SparseMatrix<T>::_global_offset, cols[j]) += dm[i*n+j];
       }
       else
         for(unsigned int j=0; j<n; j++)
@@ -306,7 +361,7 @@ bool PetscMatrix<T>::closed() const
 {
   genius_assert (this->initialized());
 
-  if(_mat_buf_mode)
+  if(_mat_buf_mode || _mat_frozen_mode)
   {
     return _closed;
   }
@@ -336,7 +391,7 @@ void PetscMatrix<T>::init ()
 template <typename T>
 void PetscMatrix<T>::close (bool final)
 {
-  if(_mat_buf_mode)
+  if(_mat_buf_mode || _mat_frozen_mode)
   {
     unsigned int nonlocal_entries = _mat_nonlocal.size();
     Parallel::sum(nonlocal_entries);
@@ -366,13 +421,17 @@ void PetscMatrix<T>::close (bool final)
 
         unsigned int col = cols[n];
         T value = values[n];
-        _mat_local[row-SparseMatrix<T>::_global_offset][col] += value;
+        _local_entry(row-SparseMatrix<T>::_global_offset, col) += value;
       }
     }
     
     _closed = true;
     
-    if(final) flush_buf();
+    if(final)
+    {
+      if(_mat_frozen_mode) flush_csr();
+      else flush_buf();
+    }
   }
   else
   {
@@ -401,6 +460,24 @@ void PetscMatrix<T>::zero ()
     for(typename std::map< std::pair<unsigned int, unsigned int>, T >::iterator it= _mat_nonlocal.begin();it!=_mat_nonlocal.end(); it++)
       it->second = 0.0;  
   }
+  else if(_mat_frozen_mode)
+  {
+    std::fill(_csr_values.begin(), _csr_values.end(), T(0.0));
+
+    // spilled entries
+    if(_csr_n_spill)
+    {
+      for(size_t n=0; n<_mat_local.size(); ++n)
+      {
+        std::map<unsigned int, T> & cols = _mat_local[n];
+        for(typename std::map<unsigned int, T>::iterator it=cols.begin(); it!=cols.end(); it++)
+          it->second = 0.0;
+      }
+    }
+
+    for(typename std::map< std::pair<unsigned int, unsigned int>, T >::iterator it= _mat_nonlocal.begin();it!=_mat_nonlocal.end(); it++)
+      it->second = 0.0;
+  }
   else
   {
     genius_assert (this->initialized());
@@ -418,6 +495,17 @@ void PetscMatrix<T>::clear ()
 {
   _mat_local.clear();
   _mat_nonlocal.clear();
+
+  _csr_row_ptr.clear();
+  _csr_cols.clear();
+  _csr_values.clear();
+  _bcsr_row_ptr.clear();
+  _bcsr_cols.clear();
+  _csr_n_spill = 0;
+  _csr_pattern_synced = false;
+  _csr_raw_copy = false;
+  _csr_pattern_id = 0;
+  _mat_frozen_mode = false;
   
   int ierr=0;
 
@@ -442,6 +530,23 @@ void PetscMatrix<T>::get_row (unsigned int row, int n, const int * cols, T* dm)
       dm[i] = buf.find(cols[i])->second;
     }
   }
+  else if(_mat_frozen_mode)
+  {
+    unsigned int local_row = row-SparseMatrix<T>::_global_offset;
+    for(int i=0; i<n; i++)
+    {
+      int slot = _csr_slot(local_row, cols[i]);
+      if( slot >= 0 ) { dm[i] = _csr_values[slot]; continue; }
+
+      // not in frozen pattern, try spilled entries
+      dm[i] = 0.0;
+      if(_csr_n_spill)
+      {
+        typename std::map<unsigned int, T>::const_iterator ent = _mat_local[local_row].find(cols[i]);
+        if( ent != _mat_local[local_row].end() ) dm[i] = ent->second;
+      }
+    }
+  }
   else
   {
     MatGetValues(_mat, 1, (int*)&row, n, (int*)cols, (PetscScalar*)dm);
@@ -466,6 +571,21 @@ T PetscMatrix<T>::operator () (const unsigned int i, const unsigned int j) const
     // i.e. it is 0.
     return 0.0;
   }
+
+  if(_mat_frozen_mode)
+  {
+    unsigned int local_row = i-SparseMatrix<T>::_global_offset;
+    int slot = _csr_slot(local_row, j);
+    if( slot >= 0 ) return _csr_values[slot];
+
+    if(_csr_n_spill)
+    {
+      const std::map<unsigned int, T> & buf = _mat_local[local_row];
+      typename std::map<unsigned int, T>::const_iterator ent =  buf.find(j);
+      if(ent != buf.end() ) return ent->second;
+    }
+    return 0.0;
+  }
   
   // else 
 
@@ -546,6 +666,46 @@ void PetscMatrix<T>::add_row_to_row(const std::vector<int> &src_rows,
     
     return;
   }
+
+  if(_mat_frozen_mode)
+  {
+    genius_assert(_closed);
+
+    // the source rows should be read before any modification
+    std::vector< std::vector<PetscInt> > row_cols(src_rows.size());
+    std::vector< std::vector<T> > row_vals(src_rows.size());
+    for(unsigned int n=0; n<src_rows.size(); n++)
+    {
+      unsigned int src_row = static_cast<unsigned int>(src_rows[n]);
+      genius_assert(SparseMatrix<T>::row_on_processor(src_row));
+
+      unsigned int local_src_row = src_row - SparseMatrix<T>::_global_offset;
+      for(unsigned int k=_csr_row_ptr[local_src_row]; k<_csr_row_ptr[local_src_row+1]; ++k)
+      {
+        row_cols[n].push_back(_csr_cols[k]);
+        row_vals[n].push_back(_csr_values[k]);
+      }
+
+      if(_csr_n_spill)
+      {
+        const std::map<unsigned int, T> & cols = _mat_local[local_src_row];
+        for(typename std::map<unsigned int, T>::const_iterator it=cols.begin(); it!=cols.end(); it++)
+        {
+          row_cols[n].push_back(it->first);
+          row_vals[n].push_back(it->second);
+        }
+      }
+    }
+
+    for(unsigned int n=0; n<src_rows.size(); n++)
+      for(unsigned int k=0; k<row_cols[n].size(); ++k)
+        add(static_cast<unsigned int>(dst_rows[n]), row_cols[n][k], row_vals[n][k]);
+
+    // sync _mat_nonlocal entries
+    close(false);
+
+    return;
+  }
   
   // test if the matrix is assembled
   // note: the test is not work properly! if it is a bug...
@@ -621,6 +781,23 @@ void PetscMatrix<T>::clear_row(int row, const T diag )
     cols[row] = diag;
     return;
   }
+
+  if(_mat_frozen_mode)
+  {
+    unsigned int local_row = row-SparseMatrix<T>::_global_offset;
+    for(unsigned int k=_csr_row_ptr[local_row]; k<_csr_row_ptr[local_row+1]; ++k)
+      _csr_values[k] = 0.0;
+
+    if(_csr_n_spill)
+    {
+      std::map<unsigned int, T> & cols = _mat_local[local_row];
+      for(typename std::map<unsigned int, T>::iterator it=cols.begin(); it!=cols.end(); it++)
+        it->second = 0.0;
+    }
+
+    _local_entry(local_row, row) = diag;
+    return;
+  }
     
   
 #if PETSC_VERSION_GE(3,2,0)
@@ -649,6 +826,13 @@ void PetscMatrix<T>::clear_row(const std::vector<int> &rows, const T diag)
     }
     return;
   }
+
+  if(_mat_frozen_mode)
+  {
+    for(unsigned int n=0; n<rows.size(); n++)
+      clear_row(rows[n], diag);
+    return;
+  }
     
   
 #if PETSC_VERSION_GE(3,2,0)
@@ -726,6 +910,8 @@ void PetscMatrix<T>::flush_buf()
 {
   genius_assert(_closed);
   genius_assert(_mat_buf_mode);
+
+  START_LOG("flush_buf()", "PetscMatrix");
     
   std::vector<int> n_nz(SparseMatrix<T>::_m_local, 0);
   std::vector<int> n_oz(SparseMatrix<T>::_m_local, 0);
@@ -747,8 +933,39 @@ void PetscMatrix<T>::flush_buf()
   
   int ierr     = 0;
 
+  if (_block_size > 1)
+  {
+    // count the nonzero blocks of each block row
+    const unsigned int bs = _block_size;
+    std::vector<int> n_bnz(SparseMatrix<T>::_m_local/bs, 0);
+    std::vector<int> n_boz(SparseMatrix<T>::_m_local/bs, 0);
+    for(size_t b=0; b<n_bnz.size(); ++b)
+    {
+      std::set<unsigned int> block_cols;
+      for(unsigned int i=0; i<bs; ++i)
+      {
+        const std::map<unsigned int, T> & cols = _mat_local[b*bs+i];
+        for(typename std::map<unsigned int, T>::const_iterator it=cols.begin(); it!=cols.end(); it++)
+          block_cols.insert(it->first/bs);
+      }
+      for(std::set<unsigned int>::const_iterator it=block_cols.begin(); it!=block_cols.end(); it++)
+      {
+        if( SparseMatrix<T>::col_on_processor((*it)*bs) ) n_bnz[b]++;
+        else n_boz[b]++;
+      }
+    }
+
+    if (Genius::n_processors()==1)
+    {
+      ierr = MatSeqBAIJSetPreallocation(_mat, bs, 0, &n_bnz[0]); genius_assert(!ierr);
+    }
+    else
+    {
+      ierr = MatMPIBAIJSetPreallocation(_mat, bs, 0, &n_bnz[0], 0, &n_boz[0]); genius_assert(!ierr);
+    }
+  }
   // create a sequential matrix on one processor
-  if (Genius::n_processors()==1)
+  else if (Genius::n_processors()==1)
   {
     // alloc memory for sequence matrix here
     ierr = MatSeqAIJSetPreallocation(_mat, 0, &n_nz[0]); genius_assert(!ierr);
@@ -797,8 +1014,235 @@ void PetscMatrix<T>::flush_buf()
   genius_assert(!ierr);
   
   
-  _mat_local.clear();
   _mat_buf_mode = false;
+
+  if(_mat_frozen_enabled)
+  {
+    // record the nonzero pattern, later assemblies go to CSR arrays
+    _build_csr_pattern();
+    _mat_frozen_mode = true;
+    _csr_pattern_synced = true;
+    _csr_raw_copy = _check_csr_pattern();
+  }
+
+  _mat_local.clear();
+
+  STOP_LOG("flush_buf()", "PetscMatrix");
+}
+
+
+
+template <typename T>
+int PetscMatrix<T>::slot(const unsigned int i, const unsigned int j) const
+{
+  if( !_mat_frozen_mode || !SparseMatrix<T>::row_on_processor(i) ) return -1;
+  return _csr_slot(i-SparseMatrix<T>::_global_offset, j);
+}
+
+
+
+template <typename T>
+int PetscMatrix<T>::_csr_slot(unsigned int local_row, unsigned int col) const
+{
+  std::vector<PetscInt>::const_iterator begin = _csr_cols.begin() + _csr_row_ptr[local_row];
+  std::vector<PetscInt>::const_iterator end   = _csr_cols.begin() + _csr_row_ptr[local_row+1];
+  std::vector<PetscInt>::const_iterator it = std::lower_bound(begin, end, static_cast<PetscInt>(col));
+  if( it != end && *it == static_cast<PetscInt>(col) )
+    return static_cast<int>(it - _csr_cols.begin());
+  return -1;
+}
+
+
+
+template <typename T>
+T & PetscMatrix<T>::_local_entry(unsigned int local_row, unsigned int col)
+{
+  if(_mat_frozen_mode)
+  {
+    int slot = _csr_slot(local_row, col);
+    if( slot >= 0 ) return _csr_values[slot];
+
+    // entry out of frozen pattern, buffer it in the map
+    if(_mat_local.empty()) _mat_local.resize(SparseMatrix<T>::_m_local);
+    std::map<unsigned int, T> & buf = _mat_local[local_row];
+    if( buf.find(col) == buf.end() ) _csr_n_spill++;
+    return buf[col];
+  }
+
+  return _mat_local[local_row][col];
+}
+
+
+
+template <typename T>
+void PetscMatrix<T>::_build_csr_pattern()
+{
+  const bool merge = !_csr_row_ptr.empty();
+
+  std::vector<unsigned int> row_ptr(SparseMatrix<T>::_m_local+1, 0);
+  std::vector<PetscInt> csr_cols;
+  std::vector<T> csr_values;
+
+  const unsigned int bs = _block_size;
+  std::vector<unsigned int> brow_ptr(1, 0);
+  std::vector<PetscInt> bcols;
+
+  for(unsigned int b=0; b<SparseMatrix<T>::_m_local/bs; ++b)
+  {
+    // merge the old pattern and the map buffer, both of them are sorted
+    std::vector< std::map<unsigned int, T> > row_entries(bs);
+    std::set<unsigned int> block_cols;
+    for(unsigned int i=0; i<bs; ++i)
+    {
+      const unsigned int n = b*bs+i;
+      if(merge)
+      {
+        for(unsigned int k=_csr_row_ptr[n]; k<_csr_row_ptr[n+1]; ++k)
+          row_entries[i][_csr_cols[k]] = _csr_values[k];
+      }
+      if(n < _mat_local.size())
+      {
+        const std::map<unsigned int, T> & cols = _mat_local[n];
+        for(typename std::map<unsigned int, T>::const_iterator it=cols.begin(); it!=cols.end(); it++)
+          row_entries[i][it->first] += it->second;
+      }
+      if(bs > 1)
+      {
+        for(typename std::map<unsigned int, T>::const_iterator it=row_entries[i].begin(); it!=row_entries[i].end(); it++)
+          block_cols.insert(it->first/bs);
+      }
+    }
+
+    // expand the pattern to full blocks, each block row has the same columns in all its rows
+    if(bs > 1)
+    {
+      for(std::set<unsigned int>::const_iterator it=block_cols.begin(); it!=block_cols.end(); it++)
+      {
+        bcols.push_back(*it);
+        for(unsigned int i=0; i<bs; ++i)
+          for(unsigned int j=0; j<bs; ++j)
+            row_entries[i].insert(std::make_pair((*it)*bs+j, T(0.0)));
+      }
+      brow_ptr.push_back(bcols.size());
+    }
+
+    for(unsigned int i=0; i<bs; ++i)
+    {
+      for(typename std::map<unsigned int, T>::const_iterator it=row_entries[i].begin(); it!=row_entries[i].end(); it++)
+      {
+        csr_cols.push_back(it->first);
+        csr_values.push_back(it->second);
+      }
+      row_ptr[b*bs+i+1] = csr_cols.size();
+    }
+  }
+
+  _csr_row_ptr.swap(row_ptr);
+  _csr_cols.swap(csr_cols);
+  _csr_values.swap(csr_values);
+  if(bs > 1)
+  {
+    _bcsr_row_ptr.swap(brow_ptr);
+    _bcsr_cols.swap(bcols);
+  }
+
+  _mat_local.clear();
+  _csr_n_spill = 0;
+  _csr_pattern_id = ++_csr_pattern_counter;
+}
+
+
+
+template <typename T>
+bool PetscMatrix<T>::_check_csr_pattern() const
+{
+  // only SeqAIJ storage can be copied directly
+  if( Genius::n_processors()!=1 || _block_size > 1 ) return false;
+
+  int ierr = 0;
+
+  MatInfo info;
+  ierr = MatGetInfo(_mat, MAT_LOCAL, &info); genius_assert(!ierr);
+  if( static_cast<size_t>(info.nz_used) != _csr_cols.size() ) return false;
+
+  for(unsigned int n=0; n<SparseMatrix<T>::_m_local; ++n)
+  {
+    PetscInt row = n+SparseMatrix<T>::_global_offset;
+    PetscInt ncols = 0;
+    const PetscInt * cols;
+    ierr = MatGetRow(_mat, row, &ncols, &cols, PETSC_NULL); genius_assert(!ierr);
+    bool match = ( ncols == static_cast<PetscInt>(_csr_row_ptr[n+1] - _csr_row_ptr[n]) ) &&
+                 std::equal(cols, cols+ncols, _csr_cols.begin() + _csr_row_ptr[n]);
+    ierr = MatRestoreRow(_mat, row, &ncols, &cols, PETSC_NULL); genius_assert(!ierr);
+    if( !match ) return false;
+  }
+
+  return true;
+}
+
+
+
+template <typename T>
+void PetscMatrix<T>::flush_csr()
+{
+  genius_assert(_closed);
+  genius_assert(_mat_frozen_mode);
+
+  int ierr = 0;
+
+  // entries out of the frozen pattern appeared, extend the pattern
+  if(_csr_n_spill)
+  {
+    _build_csr_pattern();
+    _csr_pattern_synced = false;
+  }
+
+  if( _csr_pattern_synced && _block_size > 1 )
+  {
+    // the values of each block row are stored as a dense row major array in CSR,
+    // which is the layout MatSetValuesBlocked expected
+    const unsigned int bs = _block_size;
+    for(unsigned int b=0; b+1<_bcsr_row_ptr.size(); ++b)
+    {
+      PetscInt nb = _bcsr_row_ptr[b+1] - _bcsr_row_ptr[b];
+      if( !nb ) continue;
+      PetscInt brow = (b*bs+SparseMatrix<T>::_global_offset)/bs;
+      ierr = MatSetValuesBlocked(_mat, 1, &brow, nb, &_bcsr_cols[_bcsr_row_ptr[b]], &_csr_values[_csr_row_ptr[b*bs]], INSERT_VALUES);
+      genius_assert(!ierr);
+    }
+  }
+  else if( _csr_pattern_synced && _csr_raw_copy )
+  {
+    // PETSc SeqAIJ stores sorted columns in each row, the same as our CSR arrays,
+    // which was verified when the pattern was synced
+    PetscScalar * a;
+    ierr = MatSeqAIJGetArray(_mat, &a); genius_assert(!ierr);
+    std::copy(_csr_values.begin(), _csr_values.end(), a);
+    ierr = MatSeqAIJRestoreArray(_mat, &a); genius_assert(!ierr);
+  }
+  else
+  {
+    // insert values row by row, the PETSc pattern will be extended if necessary
+    for(unsigned int n=0; n<SparseMatrix<T>::_m_local; ++n)
+    {
+      unsigned int nz = _csr_row_ptr[n+1] - _csr_row_ptr[n];
+      if( !nz ) continue;
+      PetscInt row = n+SparseMatrix<T>::_global_offset;
+      ierr = MatSetValues(_mat, 1, &row, nz, &_csr_cols[_csr_row_ptr[n]], &_csr_values[_csr_row_ptr[n]], INSERT_VALUES);
+      genius_assert(!ierr);
+    }
+  }
+
+  ierr = MatAssemblyBegin (_mat, MAT_FINAL_ASSEMBLY);
+  ierr = MatAssemblyEnd   (_mat, MAT_FINAL_ASSEMBLY);
+  genius_assert(!ierr);
+
+  // the pattern of PETSc matrix is extended to the CSR arrays now
+  if( !_csr_pattern_synced )
+  {
+    _csr_pattern_synced = true;
+    _csr_raw_copy = _check_csr_pattern();
+  }
 }
 
 //------------------------------------------------------------------
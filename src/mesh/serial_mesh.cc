@@ -28,6 +28,19 @@
 #include "serial_mesh.h"
 #include "mesh_tools.h"
 #include "parallel.h"
+#include "genius_petsc.h"
+
+#if (defined(PETSC_HAVE_PARMETIS) || defined(PETSC_HAVE_METIS))
+
+namespace Metis
+{
+  extern "C"
+  {
+#     include "metis.h"
+  }
+}
+
+#endif
 
 // ------------------------------------------------------------
 // SerialMesh class member functions
@@ -489,6 +502,366 @@ bool SerialMesh::reorder_nodes(std::string &err)
 }
 
 
+
+/**
+ * the level structure of connected component rooted at \p root by Breadth-First Search,
+ * nodes already in the new order are skipped. \p depth should be -1 for all the nodes
+ * in the component and it is reset before return
+ * @return the eccentricity of root, the nodes of last level are saved in \p last_level
+ */
+static unsigned int _rooted_level_structure(const std::vector<std::vector<unsigned int> > &adj,
+                                            const std::vector<bool> &placed,
+                                            unsigned int root,
+                                            std::vector<int> &depth,
+                                            std::vector<unsigned int> &last_level)
+{
+  std::vector<unsigned int> Q;
+  Q.push_back(root);
+  depth[root] = 0;
+  for(unsigned int q=0; q<Q.size(); ++q)
+  {
+    const unsigned int current = Q[q];
+    for(unsigned int i=0; i<adj[current].size(); ++i)
+    {
+      const unsigned int neighbor = adj[current][i];
+      if( !placed[neighbor] && depth[neighbor] < 0 )
+      {
+        depth[neighbor] = depth[current] + 1;
+        Q.push_back(neighbor);
+      }
+    }
+  }
+
+  const int ecc = depth[Q.back()];
+  last_level.clear();
+  for(unsigned int q=0; q<Q.size(); ++q)
+  {
+    if( depth[Q[q]] == ecc ) last_level.push_back(Q[q]);
+    depth[Q[q]] = -1;
+  }
+  return static_cast<unsigned int>(ecc);
+}
+
+
+/**
+ * compare node by its degree, node index breaks the tie
+ */
+struct _DegreeLess
+{
+  _DegreeLess(const std::vector<std::vector<unsigned int> > &adj) : _adj(adj) {}
+
+  bool operator() (unsigned int a, unsigned int b) const
+  {
+    if( _adj[a].size() != _adj[b].size() ) return _adj[a].size() < _adj[b].size();
+    return a < b;
+  }
+
+  const std::vector<std::vector<unsigned int> > &_adj;
+};
+
+
+/**
+ * Reverse Cuthill-McKee ordering of node graph. each connected component
+ * starts from a pseudo-peripheral node found by George-Liu algorithm
+ * @return old node index in the new order
+ */
+static void _rcm_order(const std::vector<std::vector<unsigned int> > &adj, std::vector<unsigned int> &order)
+{
+  const unsigned int n = adj.size();
+  _DegreeLess degree_less(adj);
+
+  std::vector<bool> placed(n, false);
+  std::vector<int>  depth(n, -1);
+  std::vector<unsigned int> last_level;
+
+  order.clear();
+  order.reserve(n);
+
+  // visit nodes by degree, the unplaced one begins a new component
+  std::vector<unsigned int> by_degree(n);
+  for(unsigned int i=0; i<n; ++i) by_degree[i] = i;
+  std::sort(by_degree.begin(), by_degree.end(), degree_less);
+
+  for(unsigned int s=0; s<n; ++s)
+  {
+    unsigned int root = by_degree[s];
+    if( placed[root] ) continue;
+
+    // pseudo-peripheral node: move root to the smallest degree node of
+    // the last level while the eccentricity increases
+    unsigned int ecc = _rooted_level_structure(adj, placed, root, depth, last_level);
+    while(true)
+    {
+      unsigned int candidate = *std::min_element(last_level.begin(), last_level.end(), degree_less);
+      std::vector<unsigned int> candidate_last_level;
+      unsigned int candidate_ecc = _rooted_level_structure(adj, placed, candidate, depth, candidate_last_level);
+      if( candidate_ecc <= ecc ) break;
+      root = candidate;
+      ecc = candidate_ecc;
+      last_level.swap(candidate_last_level);
+    }
+
+    // Cuthill-McKee, neighbors are visited by increasing degree
+    const unsigned int begin = order.size();
+    order.push_back(root);
+    placed[root] = true;
+    for(unsigned int q=begin; q<order.size(); ++q)
+    {
+      const unsigned int current = order[q];
+      const unsigned int first_neighbor = order.size();
+      for(unsigned int i=0; i<adj[current].size(); ++i)
+      {
+        const unsigned int neighbor = adj[current][i];
+        if( !placed[neighbor] )
+        {
+          placed[neighbor] = true;
+          order.push_back(neighbor);
+        }
+      }
+      std::sort(order.begin()+first_neighbor, order.end(), degree_less);
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+}
+
+
+/**
+ * interleave the bits of integer coordinates, the highest bit of x[0] goes first
+ */
+static unsigned long long _interleave_bits(const unsigned int *x, unsigned int dim, unsigned int bits)
+{
+  unsigned long long key = 0;
+  for(int b=bits-1; b>=0; --b)
+    for(unsigned int d=0; d<dim; ++d)
+      key = (key << 1) | ((x[d] >> b) & 1);
+  return key;
+}
+
+
+/**
+ * convert integer coordinates to the transposed Hilbert index,
+ * see J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 381 (2004)
+ */
+static void _hilbert_transpose(unsigned int *x, unsigned int dim, unsigned int bits)
+{
+  const unsigned int M = 1u << (bits-1);
+
+  // inverse undo
+  for(unsigned int Q=M; Q>1; Q>>=1)
+  {
+    const unsigned int P = Q-1;
+    for(unsigned int d=0; d<dim; ++d)
+    {
+      if( x[d] & Q )
+        x[0] ^= P;
+      else
+      {
+        const unsigned int t = (x[0] ^ x[d]) & P;
+        x[0] ^= t;
+        x[d] ^= t;
+      }
+    }
+  }
+
+  // gray encode
+  for(unsigned int d=1; d<dim; ++d)
+    x[d] ^= x[d-1];
+  unsigned int t = 0;
+  for(unsigned int Q=M; Q>1; Q>>=1)
+    if( x[dim-1] & Q ) t ^= Q-1;
+  for(unsigned int d=0; d<dim; ++d)
+    x[d] ^= t;
+}
+
+
+/**
+ * space filling curve ordering of nodes by their location
+ * @return old node index in the new order
+ */
+static void _sfc_order(const std::vector<Point> &points, unsigned int dim, bool hilbert, std::vector<unsigned int> &order)
+{
+  const unsigned int n = points.size();
+
+  // 63 bits of the key are shared by all the dimensions
+  const unsigned int bits = std::min(63u/dim, 31u);
+  const double scale = static_cast<double>((1u << bits) - 1);
+
+  Point lower = n ? points[0] : Point();
+  Point upper = lower;
+  for(unsigned int i=0; i<n; ++i)
+    for(unsigned int d=0; d<dim; ++d)
+    {
+      lower(d) = std::min(lower(d), points[i](d));
+      upper(d) = std::max(upper(d), points[i](d));
+    }
+
+  std::vector<std::pair<unsigned long long, unsigned int> > keys(n);
+  for(unsigned int i=0; i<n; ++i)
+  {
+    unsigned int x[3] = {0, 0, 0};
+    for(unsigned int d=0; d<dim; ++d)
+    {
+      const double length = upper(d) - lower(d);
+      if( length > 0.0 )
+        x[d] = static_cast<unsigned int>( (points[i](d) - lower(d))/length*scale + 0.5 );
+    }
+    if( hilbert ) _hilbert_transpose(x, dim, bits);
+    keys[i] = std::make_pair(_interleave_bits(x, dim, bits), i);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  order.resize(n);
+  for(unsigned int i=0; i<n; ++i)
+    order[i] = keys[i].second;
+}
+
+
+
+bool SerialMesh::reorder(MeshReorderType type, std::string &err)
+{
+  // do it only on serial mesh
+  assert(_is_serial);
+
+  if( type == Reorder_NONE || _nodes.empty() ) return true;
+
+  START_LOG("reorder()", "Mesh");
+
+  const unsigned int n = _nodes.size();
+  for(unsigned int i=0; i<n; ++i)
+    genius_assert( _nodes[i] && _nodes[i]->id() == i );
+
+  // old node index in the new order
+  std::vector<unsigned int> order;
+
+  switch(type)
+  {
+    case Reorder_RCM :
+    case Reorder_NESTED_DISSECTION :
+    {
+      // node graph, two nodes are connected when they share an elem
+      std::vector<std::vector<unsigned int> > adj(n);
+      for(unsigned int e=0; e<_elements.size(); ++e)
+      {
+        const Elem * elem = _elements[e];
+        for(unsigned int i=0; i<elem->n_nodes(); ++i)
+          for(unsigned int j=0; j<elem->n_nodes(); ++j)
+            if( i != j ) adj[elem->node(i)].push_back(elem->node(j));
+      }
+      for(unsigned int i=0; i<n; ++i)
+      {
+        std::sort(adj[i].begin(), adj[i].end());
+        adj[i].erase(std::unique(adj[i].begin(), adj[i].end()), adj[i].end());
+      }
+
+      if( type == Reorder_RCM )
+      {
+        _rcm_order(adj, order);
+        break;
+      }
+
+#if (defined(PETSC_HAVE_PARMETIS) || defined(PETSC_HAVE_METIS))
+      std::vector<int> xadj, adjncy;
+      xadj.reserve(n+1);
+      for(unsigned int i=0; i<n; ++i)
+      {
+        xadj.push_back(adjncy.size());
+        adjncy.insert(adjncy.end(), adj[i].begin(), adj[i].end());
+      }
+      xadj.push_back(adjncy.size());
+      if (adjncy.empty())
+        adjncy.push_back(0);
+
+      int nvtxs = static_cast<int>(n);
+      std::vector<int> perm(n), iperm(n);
+#if PETSC_VERSION_GE(3,3,0)
+      // METIS-5 interface
+      int metis_error = Metis::METIS_NodeND(&nvtxs, &xadj[0], &adjncy[0], NULL, NULL, &perm[0], &iperm[0]);
+      if( metis_error != Metis::METIS_OK )
+      {
+        err += "Error: METIS nested dissection failed.\n";
+        STOP_LOG("reorder()", "Mesh");
+        return false;
+      }
+#else
+      // old METIS-4 interface
+      int numflag = 0;
+      int options[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      Metis::METIS_NodeND(&nvtxs, &xadj[0], &adjncy[0], &numflag, options, &perm[0], &iperm[0]);
+#endif
+      order.assign(perm.begin(), perm.end());
+#else
+      err += "Error: nested dissection reordering requires METIS.\n";
+      STOP_LOG("reorder()", "Mesh");
+      return false;
+#endif
+      break;
+    }
+    case Reorder_HILBERT :
+    case Reorder_MORTON  :
+    {
+      std::vector<Point> points(n);
+      for(unsigned int i=0; i<n; ++i)
+        points[i] = *_nodes[i];
+      _sfc_order(points, std::max(this->mesh_dimension(), 1u), type == Reorder_HILBERT, order);
+      break;
+    }
+    default:
+    {
+      err += "Error: unknown mesh reorder method.\n";
+      STOP_LOG("reorder()", "Mesh");
+      return false;
+    }
+  }
+
+  genius_assert( order.size() == n );
+  for(unsigned int e=0; e<_elements.size(); ++e)
+    genius_assert( _elements[e] && _elements[e]->id() == e );
+
+  // ok, assign ordered index to each node
+  std::vector<unsigned int> new_order(n, invalid_uint);
+  for(unsigned int i=0; i<n; ++i)
+    new_order[order[i]] = i;
+
+  for(unsigned int i=0; i<n; ++i)
+    _nodes[i]->set_id() = new_order[i];
+
+  // elems follow the smallest (then the largest) new index of their nodes,
+  // as a result the elem loop of assembly touches nodes almost in order
+  {
+    std::vector<std::pair<std::pair<unsigned int, unsigned int>, unsigned int> > keys(_elements.size());
+    for(unsigned int e=0; e<_elements.size(); ++e)
+    {
+      const Elem * elem = _elements[e];
+      unsigned int min_index = invalid_uint, max_index = 0;
+      for(unsigned int i=0; i<elem->n_nodes(); ++i)
+      {
+        min_index = std::min(min_index, elem->get_node(i)->id());
+        max_index = std::max(max_index, elem->get_node(i)->id());
+      }
+      keys[e] = std::make_pair(std::make_pair(min_index, max_index), elem->id());
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<unsigned int> new_elem_order(_elements.size(), invalid_uint);
+    for(unsigned int e=0; e<keys.size(); ++e)
+      new_elem_order[keys[e].second] = e;
+
+    for(unsigned int e=0; e<_elements.size(); ++e)
+      _elements[e]->set_id() = new_elem_order[_elements[e]->id()];
+  }
+
+  // sort the nodes and elems by new ID
+  DofObject::Less less;
+  std::sort( _nodes.begin(), _nodes.end(), less );
+  std::sort( _elements.begin(), _elements.end(), less );
+
+  STOP_LOG("reorder()", "Mesh");
+
+  return true;
+}
+
+
 void SerialMesh::generate_boundary_info(short int id)
 {
   for(unsigned int n=0; n<_elements.size(); ++n)
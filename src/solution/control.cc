@@ -21,6 +21,8 @@
 
 //  $Id: control.cc,v 1.54 2008/07/09 12:56:23 gdiso Exp $
 
+#include <algorithm>
+
 #include "genius_common.h"
 
 #ifdef WINDOWS
@@ -54,6 +56,7 @@
 #include "field_source.h"
 #include "enum_solution.h"
 #include "spice_ckt.h"
+#include "thread_pool.h"
 
 
 #ifdef TCAD_SOLVERS
@@ -98,6 +101,7 @@
 #include "interpolation_2d_csa.h"
 #include "interpolation_3d_qshep.h"
 #include "interpolation_3d_nbtet.h"
+#include "interpolation_mesh.h"
 
 #include "dlhook.h"
 #ifndef DLLHOOK
@@ -421,6 +425,24 @@ int SolverControl::set_method ( const Parser::Card & c )
   SolverSpecify::NSLagPCLU                  = c.get_int("pclu.lag", 5);
   // set jacobian lag
   SolverSpecify::NSLagJacobian              = c.get_int("jacobian.lag", 1);
+  // freeze jacobian nonzero pattern after first assembly
+  SolverSpecify::JacobianFrozenPattern      = c.get_bool("jacobian.frozen", false);
+  // block storage of jacobian matrix
+  SolverSpecify::JacobianBlock              = c.get_bool("jacobian.block", false);
+  // reuse jacobian while newton iteration contracts fast enough
+  SolverSpecify::JacobianReuse              = c.get_bool("jacobian.reuse", false);
+  SolverSpecify::JacobianReuseContraction   = c.get_real("jacobian.reuse.contraction", 0.3);
+  SolverSpecify::JacobianReuseMax           = c.get_int("jacobian.reuse.max", 10);
+
+  // threads for region assembly
+  SolverSpecify::Threads                    = c.get_int("threads", 1);
+  Genius::set_n_threads(SolverSpecify::Threads);
+
+  // evaluate function and jacobian together
+  SolverSpecify::FusedAssembly              = c.get_bool("fused.assembly", false);
+
+  // schur complement elimination of device dofs for mixed-mode solvers
+  SolverSpecify::MixSchur                   = c.get_bool("mix.schur", false);
 
   // set Newton damping type
   if(c.is_parameter_exist("damping"))
@@ -692,6 +714,10 @@ int SolverControl::do_solve( const Parser::Card & c )
   if(c.is_parameter_exist("label"))
     SolverSpecify::label = c.get_string("label", "");
 
+  // checkpoint and restart are only given by transient solve
+  SolverSpecify::Checkpoint.clear();
+  SolverSpecify::Restart.clear();
+
   // set more detailed solution parameters
   switch (SolverSpecify::Type)
   {
@@ -784,6 +810,8 @@ int SolverControl::do_solve( const Parser::Card & c )
         // clear electrode vector
         SolverSpecify::Electrode_VScan.clear();
         SolverSpecify::Electrode_IScan.clear();
+        SolverSpecify::Electrode_VFamily.clear();
+        SolverSpecify::VFamily.clear();
 
         if(c.is_parameter_exist("vscan"))
         {
@@ -834,6 +862,51 @@ int SolverControl::do_solve( const Parser::Card & c )
             MESSAGE<<"ERROR at " <<c.get_fileline()<< " SOLVE: VStep shoud not be zero."<<std::endl; RECORD();
             genius_error();
           }
+
+          // a family of voltage sweeps, one for each bias of family electrode(s)
+          if(c.is_parameter_exist("vfamily"))
+          {
+            if(system().get_circuit()!=NULL)
+            {
+              MESSAGE<<"ERROR at " <<c.get_fileline()<< " SOLVE: VFamily is not supported with SPICE netlist."<<std::endl; RECORD();
+              genius_error();
+            }
+
+            unsigned int elec_num = c.parameter_count("vfamily");
+            for(unsigned int n=0; n<elec_num; n++)
+            {
+              std::string electrode = c.get_n_string("vfamily", "", n, 0);
+              if( !system().get_bcs()->is_electrode(electrode) )
+              {
+                MESSAGE<<"ERROR at " <<c.get_fileline()<< " SOLVE: Electrode " << electrode << " can't be found in device structure." << std::endl; RECORD();
+                genius_error();
+              }
+              if( std::find(SolverSpecify::Electrode_VScan.begin(), SolverSpecify::Electrode_VScan.end(), electrode) != SolverSpecify::Electrode_VScan.end() )
+              {
+                MESSAGE<<"ERROR at " <<c.get_fileline()<< " SOLVE: Electrode " << electrode << " can't be both VScan and VFamily electrode." << std::endl; RECORD();
+                genius_error();
+              }
+              SolverSpecify::Electrode_VFamily.push_back(electrode);
+            }
+
+            std::vector<double> values = c.get_array<double>("vfamily.values");
+            for(unsigned int n=0; n<values.size(); n++)
+              SolverSpecify::VFamily.push_back(values[n]*V);
+
+            if( SolverSpecify::VFamily.empty() )
+            {
+              MESSAGE<<"ERROR at " <<c.get_fileline()<< " SOLVE: You must specify the bias values of VFamily by VFamily.Values."<<std::endl; RECORD();
+              genius_error();
+            }
+
+            int workers = c.get_int("vfamily.workers", 1);
+            if( workers < 0 )
+            {
+              MESSAGE<<"ERROR at " <<c.get_fileline()<< " SOLVE: VFamily.Workers should not be negative."<<std::endl; RECORD();
+              genius_error();
+            }
+            SolverSpecify::VFamilyWorkers = workers;
+          }
         }
 
         if(c.is_parameter_exist("iscan"))
@@ -951,6 +1024,7 @@ int SolverControl::do_solve( const Parser::Card & c )
         SolverSpecify::IStop     = c.get_real("istop", 1.0)*A; //current limit
         SolverSpecify::IStepMax  = c.get_real("istepmax", SolverSpecify::IStop/A)*A;
         SolverSpecify::Predict   = c.get_bool("predict", true);
+        SolverSpecify::TraceArcLength = c.get_bool("arclength", false);
 
         SolverSpecify::OptG      = c.get_bool("optical.gen", false);
         SolverSpecify::PatG      = c.get_bool("particle.gen", false);
@@ -983,6 +1057,18 @@ int SolverControl::do_solve( const Parser::Card & c )
         SolverSpecify::FStop     = c.get_real("f.stop", 10e9)/s;
         SolverSpecify::FMultiple = c.get_real("f.multiple", 1.1);
         SolverSpecify::VAC       = c.get_real("vac", 0.0026)*V;
+        SolverSpecify::ACAssembleOnce = c.get_bool("ac.assemble.once", true);
+        SolverSpecify::ACMOR          = c.get_bool("ac.mor", false);
+        SolverSpecify::ACMORTolerance = c.get_real("ac.mor.tol", 1e-4);
+        int mor_max_basis = c.get_int("ac.mor.maxbasis", 60);
+        int mor_moments   = c.get_int("ac.mor.moments", 2);
+        if( mor_max_basis <= 0 || mor_moments <= 0 )
+        {
+          MESSAGE<<"ERROR at " <<c.get_fileline()<< " SOLVE: ac.mor.maxbasis and ac.mor.moments should be positive."<<std::endl; RECORD();
+          genius_error();
+        }
+        SolverSpecify::ACMORMaxBasis  = mor_max_basis;
+        SolverSpecify::ACMORMoments   = mor_moments;
 
         unsigned int elec_num = c.parameter_count("acscan");
         for(unsigned int n=0; n<elec_num; n++)
@@ -1088,6 +1174,16 @@ int SolverControl::do_solve( const Parser::Card & c )
         if(c.is_parameter_exist("tran.histroy"))
           SolverSpecify::tran_histroy   = c.get_bool("tran.histroy", false);
 
+        // binary checkpoint of transient state, and resume from it
+        SolverSpecify::Checkpoint      = c.get_string("checkpoint", "");
+        SolverSpecify::CheckpointSteps = c.get_int("checkpoint.steps", 10);
+        SolverSpecify::Restart         = c.get_string("restart", "");
+        if(SolverSpecify::CheckpointSteps <= 0)
+        {
+          MESSAGE<<"ERROR at " <<c.get_fileline()<< " SOLVE: checkpoint.steps should be positive."<<std::endl; RECORD();
+          genius_error();
+        }
+
         break;
       }
 
@@ -1791,15 +1887,31 @@ int SolverControl::do_refine_conform(const Parser::Card & c)
 
   // save previous solution
   AutoPtr<InterpolationBase> interpolator;
-  if( mesh().mesh_dimension() == 2 )
+  if( !c.is_enum_value("interpolation", "scatter") )
+  {
+    // keep a copy of old mesh, data is transferred by its shape functions
+    InterpolationMesh * mesh_interpolator = new InterpolationMesh;
+    mesh_interpolator->set_mesh(mesh());
+    interpolator = AutoPtr<InterpolationBase>(mesh_interpolator);
+  }
+  else if( mesh().mesh_dimension() == 2 )
     interpolator = AutoPtr<InterpolationBase>(new Interpolation2D_CSA);
   else
     interpolator = AutoPtr<InterpolationBase>(new Interpolation3D_nbtet);
 
+  // conservative transfer keeps the total dopant of each region
+  bool conservative = c.get_bool("conservative", false);
+  std::vector<double> na_total, nd_total;
+
   if( DopingSolver.get() == NULL )
   {
     system().fill_interpolator(interpolator.get(), "doping.na", InterpolationBase::Asinh);
     system().fill_interpolator(interpolator.get(), "doping.nd", InterpolationBase::Asinh);
+    if( conservative )
+    {
+      system().region_integral("doping.na", na_total);
+      system().region_integral("doping.nd", nd_total);
+    }
   }
 
   if(system().has_single_compound_semiconductor_region()  && MoleSolver.get() == NULL )
@@ -1884,8 +1996,8 @@ int SolverControl::do_refine_conform(const Parser::Card & c)
   else
   {
     // no doping information?
-    system().do_interpolation(interpolator.get(), "doping.na");
-    system().do_interpolation(interpolator.get(), "doping.nd");
+    system().do_interpolation(interpolator.get(), "doping.na", conservative ? &na_total : NULL);
+    system().do_interpolation(interpolator.get(), "doping.nd", conservative ? &nd_total : NULL);
   }
 
   // set mole fraction to semiconductor region
@@ -1919,15 +2031,31 @@ int SolverControl::do_refine_hierarchical(const Parser::Card & c)
 
   // save previous solution
   AutoPtr<InterpolationBase> interpolator;
-  if( mesh().mesh_dimension() == 2 )
+  if( !c.is_enum_value("interpolation", "scatter") )
+  {
+    // keep a copy of old mesh, data is transferred by its shape functions
+    InterpolationMesh * mesh_interpolator = new InterpolationMesh;
+    mesh_interpolator->set_mesh(mesh());
+    interpolator = AutoPtr<InterpolationBase>(mesh_interpolator);
+  }
+  else if( mesh().mesh_dimension() == 2 )
     interpolator = AutoPtr<InterpolationBase>(new Interpolation2D_CSA);
   else
     interpolator = AutoPtr<InterpolationBase>(new Interpolation3D_nbtet);
 
+  // conservative transfer keeps the total dopant of each region
+  bool conservative = c.get_bool("conservative", false);
+  std::vector<double> na_total, nd_total;
+
   if( DopingSolver.get() == NULL )
   {
     system().fill_interpolator(interpolator.get(), "doping.na", InterpolationBase::Asinh);
     system().fill_interpolator(interpolator.get(), "doping.nd", InterpolationBase::Asinh);
+    if( conservative )
+    {
+      system().region_integral("doping.na", na_total);
+      system().region_integral("doping.nd", nd_total);
+    }
   }
 
   if(system().has_single_compound_semiconductor_region()  && MoleSolver.get() == NULL )
@@ -1986,8 +2114,8 @@ int SolverControl::do_refine_hierarchical(const Parser::Card & c)
   else
   {
     // no doping information?
-    system().do_interpolation(interpolator.get(), "doping.na");
-    system().do_interpolation(interpolator.get(), "doping.nd");
+    system().do_interpolation(interpolator.get(), "doping.na", conservative ? &na_total : NULL);
+    system().do_interpolation(interpolator.get(), "doping.nd", conservative ? &nd_total : NULL);
   }
 
   // set mole fraction to semiconductor region
@@ -23,6 +23,7 @@
 
 #include "parser_card.h"
 #include "physical_unit.h"
+#include "checkpoint_file.h"
 
 #include "external_circuit.h"
 #include "external_circuit_rcl.h"
@@ -74,3 +75,34 @@ ExternalCircuit * ExternalCircuit::build(const Parser::Card &c)
 }
 
 
+
+void ExternalCircuit::checkpoint(CheckpointWriter & out) const
+{
+  out.write_value<int>(_drv);
+  out.write_value(_Vapp);
+  out.write_value(_Iapp);
+  out.write_value(_potential);
+  out.write_value(_potential_old);
+  out.write_value(_current);
+  out.write_value(_current_old);
+  out.write_value(_current_displacement);
+  out.write_value(_current_conductance);
+  out.write_value(_current_electron);
+  out.write_value(_current_hole);
+}
+
+
+void ExternalCircuit::restart(CheckpointReader & in)
+{
+  _drv                  = static_cast<DRIVEN>(in.read_value<int>());
+  _Vapp                 = in.read_value<Real>();
+  _Iapp                 = in.read_value<Real>();
+  _potential            = in.read_value<Real>();
+  _potential_old        = in.read_value<Real>();
+  _current              = in.read_value<Real>();
+  _current_old          = in.read_value<Real>();
+  _current_displacement = in.read_value<Real>();
+  _current_conductance  = in.read_value<Real>();
+  _current_electron     = in.read_value<Real>();
+  _current_hole         = in.read_value<Real>();
+}
@@ -24,6 +24,7 @@
 
 #include "external_circuit_pi.h"
 #include "physical_unit.h"
+#include "checkpoint_file.h"
 
 std::string ExternalCircuitPI::format() const
 {
@@ -210,3 +211,17 @@ void ExternalCircuitPI::tran_op_init()
 
 
 
+void ExternalCircuitPI::checkpoint(CheckpointWriter & out) const
+{
+  ExternalCircuit::checkpoint(out);
+  out.write_value(_V1);
+  out.write_value(_V1_last);
+}
+
+
+void ExternalCircuitPI::restart(CheckpointReader & in)
+{
+  ExternalCircuit::restart(in);
+  _V1      = in.read_value<Real>();
+  _V1_last = in.read_value<Real>();
+}
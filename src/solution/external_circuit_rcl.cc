@@ -24,6 +24,7 @@
 
 #include "external_circuit_rcl.h"
 #include "physical_unit.h"
+#include "checkpoint_file.h"
 
 std::string ExternalCircuitRCL::format() const
 {
@@ -87,3 +88,19 @@ std::complex <Real> ExternalCircuitRCL::mna_ac_jacobian(Real omega)
 }
   
 
+
+
+void ExternalCircuitRCL::checkpoint(CheckpointWriter & out) const
+{
+  ExternalCircuit::checkpoint(out);
+  out.write_value(_cap_current);
+  out.write_value(_cap_current_old);
+}
+
+
+void ExternalCircuitRCL::restart(CheckpointReader & in)
+{
+  ExternalCircuit::restart(in);
+  _cap_current     = in.read_value<Real>();
+  _cap_current_old = in.read_value<Real>();
+}
@@ -24,6 +24,7 @@
 
 #include "external_circuit_rct.h"
 #include "physical_unit.h"
+#include "checkpoint_file.h"
 
 ExternalCircuitRCTLine::ExternalCircuitRCTLine(Real r, Real Rl, Real Cl, Real length, int div)
   :_r_app(r),_r_per_um(Rl),_c_per_um(Cl),_length(length), N(div)
@@ -174,3 +175,17 @@ void ExternalCircuitRCTLine::tran_op_init()
 
 
 
+void ExternalCircuitRCTLine::checkpoint(CheckpointWriter & out) const
+{
+  ExternalCircuit::checkpoint(out);
+  out.write_vector(_v);
+  out.write_vector(_v_last);
+}
+
+
+void ExternalCircuitRCTLine::restart(CheckpointReader & in)
+{
+  ExternalCircuit::restart(in);
+  in.read_array(_v);
+  in.read_array(_v_last);
+}
@@ -156,9 +156,6 @@ void InsulatorSimulationRegion::init(PetscScalar T_external)
     FVM_Node * fvm_node = *node_it;
     FVM_NodeData * node_data = fvm_node->node_data();
 
-    // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
-
     // set the initial temperature of lattice to external temperature
     node_data->T()  =  T_external;
 
@@ -191,9 +188,6 @@ void InsulatorSimulationRegion::reinit_after_import()
     FVM_Node * fvm_node = *node_it;
     FVM_NodeData * node_data = fvm_node->node_data();
 
-    // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
-
     // lattice temperature, have been read from data file!
     PetscScalar T = node_data->T();
 
@@ -334,9 +328,6 @@ void InsulatorSimulationRegion::set_pmi(const std::string &type, const std::stri
     FVM_Node * fvm_node = *node_it;
     FVM_NodeData * node_data = fvm_node->node_data();
 
-    // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
-
     // lattice temperature, have been read from data file!
     PetscScalar T = node_data->T();
 
@@ -120,9 +120,6 @@ void PMLSimulationRegion::init(PetscScalar T_external)
     FVM_Node * fvm_node = *node_it;
     FVM_NodeData * node_data = fvm_node->node_data();
 
-    // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
-
     // set aux data for insulator
     node_data->affinity() = mt->basic->Affinity(T_external);
     node_data->density()  = mt->basic->Density(T_external);
@@ -148,9 +145,6 @@ void PMLSimulationRegion::reinit_after_import()
     FVM_Node * fvm_node = *node_it;
     FVM_NodeData * node_data = fvm_node->node_data();
 
-    // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
-
     // lattice temperature.
     PetscScalar T = 1.0;
 
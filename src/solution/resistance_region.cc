@@ -157,9 +157,6 @@ void MetalSimulationRegion::init(PetscScalar T_external)
     FVM_Node * fvm_node = *node_it;
     FVM_NodeData * node_data = fvm_node->node_data();
 
-    // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
-
     // set the initial temperature of lattice to external temperature
     node_data->T()  =  T_external;
 
@@ -193,9 +190,6 @@ void MetalSimulationRegion::reinit_after_import()
     FVM_Node * fvm_node = *node_it;
     FVM_NodeData * node_data = fvm_node->node_data();
 
-    // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
-
     // lattice temperature, have been read from data file!
     PetscScalar T =node_data->T();
 
@@ -238,9 +232,6 @@ void MetalSimulationRegion::set_pmi(const std::string &type, const std::string &
     FVM_Node * fvm_node = *node_it;
     FVM_NodeData * node_data = fvm_node->node_data();
 
-    // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
-
     // lattice temperature, have been read from data file!
     PetscScalar T =node_data->T();
 
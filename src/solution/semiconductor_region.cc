@@ -231,12 +231,12 @@ void SemiconductorSimulationRegion::init(PetscScalar T_external)
     node_data->Tp() =  T_external;
 
     // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, 0.0);
 
     // we can get some parameter only related with temperature
-    PetscScalar ni  = mt->band->ni(T_external);
-    PetscScalar Nc  = mt->band->Nc(T_external);
-    PetscScalar Nv  = mt->band->Nv(T_external);
+    PetscScalar ni  = mt->band->ni(ctx, T_external);
+    PetscScalar Nc  = mt->band->Nc(ctx, T_external);
+    PetscScalar Nv  = mt->band->Nv(ctx, T_external);
 
     // get net doping concentration
     PetscScalar Net_Doping = node_data->Net_doping();
@@ -254,26 +254,26 @@ void SemiconductorSimulationRegion::init(PetscScalar T_external)
     }
 
     // init more physical parameters
-    node_data->affinity() = mt->basic->Affinity(T_external);
-    node_data->density()  = mt->basic->Density(T_external);
-    node_data->eps()      = eps0*mt->basic->Permittivity();
-    node_data->mu()       = mu0*mt->basic->Permeability();
-    node_data->Eg()       = mt->band->Eg(T_external);
-    node_data->Nc()       = mt->band->Nc(T_external);
-    node_data->Nv()       = mt->band->Nv(T_external);
-    node_data->mun()      = mt->mob->ElecMob(node_data->p(), node_data->n(), T_external, 0, 0, T_external);
-    node_data->mup()      = mt->mob->HoleMob(node_data->p(), node_data->n(), T_external, 0, 0, T_external);
+    node_data->affinity() = mt->basic->Affinity(ctx, T_external);
+    node_data->density()  = mt->basic->Density(ctx, T_external);
+    node_data->eps()      = eps0*mt->basic->Permittivity(ctx);
+    node_data->mu()       = mu0*mt->basic->Permeability(ctx);
+    node_data->Eg()       = mt->band->Eg(ctx, T_external);
+    node_data->Nc()       = mt->band->Nc(ctx, T_external);
+    node_data->Nv()       = mt->band->Nv(ctx, T_external);
+    node_data->mun()      = mt->mob->ElecMob(ctx, node_data->p(), node_data->n(), T_external, 0, 0, T_external);
+    node_data->mup()      = mt->mob->HoleMob(ctx, node_data->p(), node_data->n(), T_external, 0, 0, T_external);
 
     // the electrostatic potential is initializted as vacuum level
     node_data->psi() = kb*T_external/e*asinh(Net_Doping/(2*ni))
                        - node_data->Eg()/(2*e)
                        - kb*T_external/(2*e)*log(Nc/Nv)
                        - node_data->affinity()
-                       - mt->band->EgNarrowToEc(node_data->p(), node_data->n(), T_external);
+                       - mt->band->EgNarrowToEc(ctx, node_data->p(), node_data->n(), T_external);
 
     node_data->Ec() = -(e*node_data->psi() + node_data->affinity());
     node_data->Ev() = -(e*node_data->psi() + node_data->affinity()
-                        - mt->band->EgNarrowToEv(node_data->p(), node_data->n(), T_external)
+                        - mt->band->EgNarrowToEv(ctx, node_data->p(), node_data->n(), T_external)
                         + node_data->Eg()
                        );
 
@@ -284,9 +284,9 @@ void SemiconductorSimulationRegion::init(PetscScalar T_external)
     node_data->Eqv() = node_data->Ev();
 
 
-    node_data->strain() = mt->basic->Strain(node_data->stress());
-    node_data->dEcStrain() = mt->band->dEcStrain();
-    node_data->dEvStrain() = mt->band->dEvStrain();
+    node_data->strain() = mt->basic->Strain(ctx, node_data->stress());
+    node_data->dEcStrain() = mt->band->dEcStrain(ctx);
+    node_data->dEvStrain() = mt->band->dEvStrain(ctx);
   }
 
   // build data structure for insulator interface
@@ -311,26 +311,26 @@ void SemiconductorSimulationRegion::reinit_after_import()
     PetscScalar T = node_data->T();
 
     // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, 0.0);
 
     // init more physical parameters
     node_data->n_last()   = node_data->n();
     node_data->p_last()   = node_data->p();
-    node_data->affinity() = mt->basic->Affinity(T);
-    node_data->density()  = mt->basic->Density(T);
-    node_data->eps()      = eps0*mt->basic->Permittivity();
-    node_data->mu()       = mu0*mt->basic->Permeability();
-    node_data->Eg()       = mt->band->Eg(T);
-    node_data->Nc()       = mt->band->Nc(T);
-    node_data->Nv()       = mt->band->Nv(T);
+    node_data->affinity() = mt->basic->Affinity(ctx, T);
+    node_data->density()  = mt->basic->Density(ctx, T);
+    node_data->eps()      = eps0*mt->basic->Permittivity(ctx);
+    node_data->mu()       = mu0*mt->basic->Permeability(ctx);
+    node_data->Eg()       = mt->band->Eg(ctx, T);
+    node_data->Nc()       = mt->band->Nc(ctx, T);
+    node_data->Nv()       = mt->band->Nv(ctx, T);
     node_data->Ec()       = -(e*node_data->psi() + node_data->affinity());
     node_data->Ev()       = -(e*node_data->psi() + node_data->affinity()
-                            - mt->band->EgNarrowToEv(node_data->p(), node_data->n(), T)
+                            - mt->band->EgNarrowToEv(ctx, node_data->p(), node_data->n(), T)
                             + node_data->Eg());
-    node_data->mun()      = mt->mob->ElecMob(node_data->p(), node_data->n(), T, 0, 0, T);
-    node_data->mup()      = mt->mob->HoleMob(node_data->p(), node_data->n(), T, 0, 0, T);
+    node_data->mun()      = mt->mob->ElecMob(ctx, node_data->p(), node_data->n(), T, 0, 0, T);
+    node_data->mup()      = mt->mob->HoleMob(ctx, node_data->p(), node_data->n(), T, 0, 0, T);
 
-    node_data->strain()   = mt->basic->Strain(node_data->stress());
+    node_data->strain()   = mt->basic->Strain(ctx, node_data->stress());
   }
 
   // build data structure for insulator interface
@@ -367,15 +367,15 @@ void SemiconductorSimulationRegion::set_pmi(const std::string &type, const std::
     PetscScalar T = node_data->T();
 
     // map current node to material buffer
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, 0.0);
 
     if(type == "basic")
     {
-      node_data->affinity() = mt->basic->Affinity(T);
-      node_data->density()  = mt->basic->Density(T);
-      node_data->eps()      = eps0*mt->basic->Permittivity();
-      node_data->mu()       = mu0*mt->basic->Permeability();
-      node_data->strain()   = mt->basic->Strain(node_data->stress());
+      node_data->affinity() = mt->basic->Affinity(ctx, T);
+      node_data->density()  = mt->basic->Density(ctx, T);
+      node_data->eps()      = eps0*mt->basic->Permittivity(ctx);
+      node_data->mu()       = mu0*mt->basic->Permeability(ctx);
+      node_data->strain()   = mt->basic->Strain(ctx, node_data->stress());
     }
 
     if(type == "band")
@@ -385,11 +385,11 @@ void SemiconductorSimulationRegion::set_pmi(const std::string &type, const std::
       PetscScalar Net_Doping = node_data->Net_doping();
 
       // we can get some parameter only related with temperature
-      PetscScalar ni  = mt->band->ni(T);
+      PetscScalar ni  = mt->band->ni(ctx, T);
 
-      node_data->Eg()       = mt->band->Eg(T);
-      node_data->Nc()       = mt->band->Nc(T);
-      node_data->Nv()       = mt->band->Nv(T);
+      node_data->Eg()       = mt->band->Eg(ctx, T);
+      node_data->Nc()       = mt->band->Nc(ctx, T);
+      node_data->Nv()       = mt->band->Nv(ctx, T);
 
       /*
       node_data->psi() = kb*T/e*asinh(Net_Doping/(2*ni))
@@ -426,8 +426,8 @@ void SemiconductorSimulationRegion::set_pmi(const std::string &type, const std::
 
     if(type == "mobility")
     {
-      node_data->mun()      = mt->mob->ElecMob(node_data->p(), node_data->n(), T, 0, 0, T);
-      node_data->mup()      = mt->mob->HoleMob(node_data->p(), node_data->n(), T, 0, 0, T);
+      node_data->mun()      = mt->mob->ElecMob(ctx, node_data->p(), node_data->n(), T, 0, 0, T);
+      node_data->mup()      = mt->mob->HoleMob(ctx, node_data->p(), node_data->n(), T, 0, 0, T);
     }
   }
 
@@ -617,6 +617,22 @@ void SemiconductorSimulationRegion::zero_node_current()
 }
 
 
+void SemiconductorSimulationRegion::build_edge_table()
+{
+  SimulationRegion::build_edge_table();
+
+  // truncated partial area of semiconductor region
+  const_element_iterator elem_it = elements_begin();
+  const_element_iterator elem_it_end = elements_end();
+  for(unsigned int nelem=0; elem_it!=elem_it_end; ++elem_it, ++nelem)
+  {
+    const Elem * elem = *elem_it;
+    for(unsigned int ne=0; ne<elem->n_edges(); ++ne )
+      _edge_table.truncated_partial_area[_edge_table.elem_slot(nelem, ne)] = this->truncated_partial_area(elem, ne);
+  }
+}
+
+
 Real SemiconductorSimulationRegion::fvm_cell_quality() const
 {
   std::map<const FVM_Node *, std::map<const FVM_Node *, double> > truncated_partial_area_map;
@@ -675,15 +691,15 @@ Real SemiconductorSimulationRegion::fvm_cell_quality() const
 
 Complex SemiconductorSimulationRegion::get_optical_refraction(const FVM_Node *fvm_node, double lambda) const
 {
-  mt->mapping(fvm_node->root_node(), fvm_node->node_data(), 0.0);
-  std::complex<PetscScalar> r = mt->optical->RefractionIndex(lambda, fvm_node->node_data()->T());
+  const PMI_Context ctx = mt->mapping(fvm_node->root_node(), fvm_node->node_data(), 0.0);
+  std::complex<PetscScalar> r = mt->optical->RefractionIndex(ctx, lambda, fvm_node->node_data()->T());
   return Complex(r.real(), r.imag());
 }
 
 double SemiconductorSimulationRegion::get_optical_Eg(const FVM_Node * fvm_node) const
 {
-  mt->mapping(fvm_node->root_node(), fvm_node->node_data(), 0.0);
-  return mt->band->Eg(fvm_node->node_data()->T());
+  const PMI_Context ctx = mt->mapping(fvm_node->root_node(), fvm_node->node_data(), 0.0);
+  return mt->band->Eg(ctx, fvm_node->node_data()->T());
 }
 
 
@@ -173,6 +173,7 @@ void SimulationRegion::clear()
 
   _region_edges.clear();
   _region_elem_edge_in_edges_index.clear();
+  _edge_table.clear();
   _region_neighbors.clear();
   _region_boundaries.clear();
   _region_bounding_box = std::make_pair(Point(), Point());
@@ -397,6 +398,81 @@ void SimulationRegion::prepare_for_use_parallel()
 
 
 
+void SimulationRegion::build_edge_table()
+{
+  START_LOG("build_edge_table()", "SimulationRegion");
+
+  FVM_EdgeTable & table = _edge_table;
+  table.clear();
+
+  // region edges
+  const unsigned int n_edges = _region_edges.size();
+  table.n1_local_offset.resize(n_edges);
+  table.n2_local_offset.resize(n_edges);
+  table.n1_global_offset.resize(n_edges);
+  table.n2_global_offset.resize(n_edges);
+  table.n1_on_processor.resize(n_edges);
+  table.n2_on_processor.resize(n_edges);
+  table.length.resize(n_edges);
+  table.cv_area.resize(n_edges);
+  table.cv_volume.resize(n_edges, 0.0);
+
+  for(unsigned int n=0; n<n_edges; ++n)
+  {
+    const FVM_Node * fvm_n1 = _region_edges[n].first;
+    const FVM_Node * fvm_n2 = _region_edges[n].second;
+
+    table.n1_local_offset[n]  = fvm_n1->local_offset();
+    table.n2_local_offset[n]  = fvm_n2->local_offset();
+    table.n1_global_offset[n] = fvm_n1->global_offset();
+    table.n2_global_offset[n] = fvm_n2->global_offset();
+    table.n1_on_processor[n]  = fvm_n1->on_processor();
+    table.n2_on_processor[n]  = fvm_n2->on_processor();
+    table.length[n]  = fvm_n1->distance(fvm_n2);
+    table.cv_area[n] = fvm_n1->cv_surface_area(fvm_n2);
+  }
+
+  // element edges
+  const unsigned int n_cells = _region_cell.size();
+  table.elem_edge_begin.resize(n_cells+1);
+  table.elem_edge_begin[0] = 0;
+  for(unsigned int n=0; n<n_cells; ++n)
+    table.elem_edge_begin[n+1] = table.elem_edge_begin[n] + _region_cell[n]->n_edges();
+
+  const unsigned int n_slots = table.elem_edge_begin[n_cells];
+  table.elem_edge.resize(n_slots);
+  table.elem_edge_inverse.resize(n_slots);
+  table.partial_area.resize(n_slots);
+  table.partial_volume.resize(n_slots);
+  table.truncated_partial_area.resize(n_slots);
+  table.truncated_partial_volume.resize(n_slots);
+
+  for(unsigned int n=0; n<n_cells; ++n)
+  {
+    const Elem * elem = _region_cell[n];
+    for(unsigned int ne=0; ne<elem->n_edges(); ++ne)
+    {
+      const unsigned int slot = table.elem_slot(n, ne);
+      const unsigned int edge_index = this->elem_edge_index(elem, ne);
+
+      std::pair<unsigned int, unsigned int> edge_nodes;
+      elem->nodes_on_edge(ne, edge_nodes);
+
+      table.elem_edge[slot] = edge_index;
+      table.elem_edge_inverse[slot] = elem->get_node(edge_nodes.first)->id() > elem->get_node(edge_nodes.second)->id();
+      table.partial_area[slot] = elem->partial_area_with_edge(ne);
+      table.partial_volume[slot] = elem->partial_volume_with_edge(ne);
+      table.truncated_partial_area[slot] = elem->partial_area_with_edge_truncated(ne);
+      table.truncated_partial_volume[slot] = elem->partial_volume_with_edge_truncated(ne);
+
+      table.cv_volume[edge_index] += table.partial_volume[slot];
+    }
+  }
+
+  STOP_LOG("build_edge_table()", "SimulationRegion");
+}
+
+
 void SimulationRegion::sync_fvm_node_volume()
 {
   // reset fvm_node volume for all the FVM_Node (also sync ghost nodes)
@@ -893,6 +969,33 @@ void SimulationRegion::add_hanging_node_on_edge(const Node * node, const Elem *
 }
 
 
+void SimulationRegion::checkpoint(CheckpointWriter & out) const
+{
+  out.write_string(_region_name);
+  _cell_data_storage.checkpoint(out);
+  _node_data_storage.checkpoint(out);
+
+  // PMI models may keep their own history, i.e. trap occupancy for BDF2
+  std::vector<PetscScalar> pmi_state;
+  if( get_material_base() ) get_material_base()->checkpoint(pmi_state);
+  out.write_vector(pmi_state);
+}
+
+
+bool SimulationRegion::restart(CheckpointReader & in)
+{
+  if( in.read_string() != _region_name ) return false;
+  if( !_cell_data_storage.restart(in) ) return false;
+  if( !_node_data_storage.restart(in) ) return false;
+
+  std::vector<PetscScalar> pmi_state;
+  in.read_vector(pmi_state);
+  if( !in.good() ) return false;
+  if( get_material_base() ) return get_material_base()->restart(pmi_state);
+  return pmi_state.empty();
+}
+
+
 size_t SimulationRegion::memory_size() const
 {
   size_t counter = sizeof(*this);
@@ -915,6 +1018,7 @@ size_t SimulationRegion::memory_size() const
   counter += _region_image_node.capacity()*sizeof(FVM_Node *);
   counter +=  _node_data_storage.memory_size();
   counter += _region_edges.capacity()*sizeof(std::pair<FVM_Node *, FVM_Node *>);
+  counter += _edge_table.memory_size();
 
   return counter;
 }
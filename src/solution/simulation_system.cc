@@ -74,7 +74,7 @@
 
 SimulationSystem::SimulationSystem(MeshBase & mesh)
   : _mesh(mesh), _cylindrical_mesh(false), _distributed_mesh(true), _resistive_metal_mode(false), _block_partition(true),
-    _bcs(0), _electrical_source(0),
+    _mesh_reorder(Reorder_NONE), _bcs(0), _electrical_source(0),
     _field_source(0), _spice_ckt(0), _global_z_width(false)
 {
   // set PhysicalUnit
@@ -88,7 +88,7 @@ SimulationSystem::SimulationSystem(MeshBase & mesh)
 
 SimulationSystem::SimulationSystem(MeshBase & mesh, Parser::InputParser & _decks)
   :  _T_external(300.0), _mesh(mesh), _cylindrical_mesh(false), _distributed_mesh(true), _resistive_metal_mode(false), _block_partition(true),
-    _bcs(0), _electrical_source(0),
+    _mesh_reorder(Reorder_NONE), _bcs(0), _electrical_source(0),
     _field_source(0), _spice_ckt(0), _global_z_width(false), _z_width(1.0)
 {
 
@@ -162,6 +162,11 @@ SimulationSystem::SimulationSystem(MeshBase & mesh, Parser::InputParser & _decks
       _resistive_metal_mode = c.get_bool("resistivemetal", false);
       _block_partition = c.get_bool("blockpartition", true);
 
+      if( c.is_enum_value("reorder", "rcm") )          _mesh_reorder = Reorder_RCM;
+      else if( c.is_enum_value("reorder", "hilbert") ) _mesh_reorder = Reorder_HILBERT;
+      else if( c.is_enum_value("reorder", "morton") )  _mesh_reorder = Reorder_MORTON;
+      else if( c.is_enum_value("reorder", "nd") )      _mesh_reorder = Reorder_NESTED_DISSECTION;
+
       double res = c.get_real("leakage.res", 1e100)*PhysicalUnit::V/PhysicalUnit::A;
       double cap = c.get_real("leakage.cap", 0.0)*PhysicalUnit::C/PhysicalUnit::V;
       MetalSimulationRegion::set_aux_parasitic_parameter(std::max(res, 1e-3*PhysicalUnit::V/PhysicalUnit::A), cap);
@@ -496,15 +501,17 @@ void SimulationSystem::build_region_fvm_mesh()
     // let all the elements find their neighbors
     mesh.find_neighbors();
 
-#if 0
-    // reorder the elem/node index by Reverse Cuthill-McKee Algorithm
-    std::string err;
-    if(!mesh.reorder_elems(err))
+    // renumber the node/elem index, which also orders the unknowns
+    // for small bandwidth/fill-in and memory locality of assembly
+    if(_mesh_reorder != Reorder_NONE)
     {
-      MESSAGE<<err;RECORD();
-      genius_error();
+      std::string err;
+      if(!mesh.reorder(_mesh_reorder, err))
+      {
+        MESSAGE<<err;RECORD();
+        genius_error();
+      }
     }
-#endif
     MESSAGE<<std::endl;  RECORD();
 
 
@@ -1309,41 +1316,142 @@ void SimulationSystem::fill_interpolator(InterpolationBase *interpolator,
   // fill the interpolator
   std::map<unsigned int, double>::const_iterator it = value_map.begin();
   for(; it != value_map.end(); ++it)
-    interpolator->add_scatter_data(_mesh.point(it->first), group_code, it->second);
+    interpolator->add_node_data(_mesh.node_ptr(it->first), group_code, it->second);
 
   interpolator->setup(group_code);
 }
 
 
+/**
+ * integral of variable over each region
+ */
+void SimulationSystem::region_integral(const std::string & variable_string, std::vector<double> & total) const
+{
+  SolutionVariable variable = solution_string_to_enum(FormatVariableString(variable_string));
+  genius_assert(variable!=INVALID_Variable);
+  genius_assert(variable_data_type(variable)==SCALAR);
+
+  total.assign(this->n_regions(), 0.0);
+  for( unsigned int r=0; r<this->n_regions(); r++)
+  {
+    const SimulationRegion * region = this->region(r);
+
+    SimulationRegion::const_processor_node_iterator node_it = region->on_processor_nodes_begin();
+    SimulationRegion::const_processor_node_iterator node_it_end = region->on_processor_nodes_end();
+    for(; node_it!=node_it_end; ++node_it)
+    {
+      const FVM_Node * fvm_node = *node_it;
+      const FVM_NodeData * node_data = fvm_node->node_data();
+      if(node_data->is_variable_valid(variable))
+        total[r] += node_data->get_variable_real(variable)*fvm_node->volume();
+    }
+  }
+  Parallel::sum(total);
+}
+
+
 /**
  * get data from interpolator after mesh refinement
  */
-void SimulationSystem::do_interpolation(const InterpolationBase * interpolator , const std::string & variable_string)
+void SimulationSystem::do_interpolation(const InterpolationBase * interpolator , const std::string & variable_string, const std::vector<double> * total)
 {
   SolutionVariable variable = solution_string_to_enum(FormatVariableString(variable_string));
   genius_assert(variable!=INVALID_Variable);
   genius_assert(variable_data_type(variable)==SCALAR);
+  genius_assert(!total || total->size()==n_regions());
 
   int group_code = interpolator->group_code(variable_string);
 
-  // fill gradient of var for all the cells in each region
   for(unsigned int n=0; n<n_regions(); n++)
   {
     SimulationRegion * region = this->region(n);
 
+    // nodes of this region, and the sample points with their weights
+    std::vector<FVM_Node *> nodes;
+    std::vector<unsigned int> sample_begin(1, 0);
+    std::vector<Point> samples;
+    std::vector<Real> weights;
+
     SimulationRegion::local_node_iterator node_it = region->on_local_nodes_begin();
     SimulationRegion::local_node_iterator node_it_end = region->on_local_nodes_end();
     for(; node_it!=node_it_end; ++node_it)
     {
       FVM_Node * fvm_node = (*node_it);
+      if(!fvm_node->node_data()->is_variable_valid(variable)) continue;
 
-      FVM_NodeData * node_data = fvm_node->node_data();
-      if(node_data->is_variable_valid(variable))
+      const Point & p = *(fvm_node->root_node());
+      nodes.push_back(fvm_node);
+
+      // conservative transfer integrates the old field over the control volume of node.
+      // the sub-cell of node in each element is split by the element edges on the node,
+      // each piece is sampled at the center of node, edge center and element centroid,
+      // and takes an equal part of the truncated partial volume
+      if(total)
+      {
+        const std::vector< std::pair<const Elem *, unsigned int> > & elems = fvm_node->elem_has_this_node();
+        for(unsigned int i=0; i<elems.size(); ++i)
+        {
+          const Elem * elem = elems[i].first;
+          const unsigned int local = elems[i].second;
+          const Point centroid = elem->centroid();
+
+          std::vector<unsigned int> edges;
+          for(unsigned int e=0; e<elem->n_edges(); ++e)
+            if( elem->is_node_on_edge(local, e) ) edges.push_back(e);
+          if( edges.empty() ) continue;
+
+          const Real w = elem->partial_volume_truncated(local)/edges.size();
+          for(unsigned int k=0; k<edges.size(); ++k)
+          {
+            std::pair<unsigned int, unsigned int> edge_nodes;
+            elem->nodes_on_edge(edges[k], edge_nodes);
+            const Point edge_center = 0.5*(elem->point(edge_nodes.first) + elem->point(edge_nodes.second));
+            samples.push_back((p + edge_center + centroid)/3.0);
+            weights.push_back(w);
+          }
+        }
+      }
+
+      // the node itself, used when control volume vanishes
+      samples.push_back(p);
+      weights.push_back(0.0);
+      sample_begin.push_back(samples.size());
+    }
+
+    std::vector<double> values;
+    interpolator->get_interpolated_values(samples, group_code, values);
+
+    std::vector<double> node_values(nodes.size());
+    for(unsigned int i=0; i<nodes.size(); ++i)
+    {
+      double v = 0.0, w = 0.0;
+      for(unsigned int k=sample_begin[i]; k<sample_begin[i+1]; ++k)
       {
-        double value = interpolator->get_interpolated_value(*(fvm_node->root_node()), group_code);
-        node_data->set_variable_real(variable, value);
+        v += weights[k]*values[k];
+        w += weights[k];
       }
+      node_values[i] = w > 0.0 ? v/w : values[sample_begin[i+1]-1];
     }
+
+    // scale the field to keep the total of region in old mesh
+    if(total)
+    {
+      double new_total = 0.0;
+      for(unsigned int i=0; i<nodes.size(); ++i)
+        if( nodes[i]->on_processor() )
+          new_total += node_values[i]*nodes[i]->volume();
+      Parallel::sum(new_total);
+
+      if( new_total != 0.0 && (*total)[n] != 0.0 )
+      {
+        const double scale = (*total)[n]/new_total;
+        for(unsigned int i=0; i<nodes.size(); ++i)
+          node_values[i] *= scale;
+      }
+    }
+
+    for(unsigned int i=0; i<nodes.size(); ++i)
+      nodes[i]->node_data()->set_variable_real(variable, node_values[i]);
   }
 }
 
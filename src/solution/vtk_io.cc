@@ -778,7 +778,7 @@ void VTKIO::solution_to_vtk(const MeshBase& mesh, vtkUnstructuredGrid* grid)
           if( region->type() == SemiconductorRegion )
           {
             const SemiconductorSimulationRegion * semiconductor_region = dynamic_cast<const SemiconductorSimulationRegion *>(region);
-            semiconductor_region->material()->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semiconductor_region->material()->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
             Taun.push_back(static_cast<float>(semiconductor_region->material()->band->TAUN(node_data->T())/s));
             Taup.push_back(static_cast<float>(semiconductor_region->material()->band->TAUP(node_data->T())/s));
           }
@@ -0,0 +1,646 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+// C++ includes
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <deque>
+#include <algorithm>
+
+// Local includes
+#include "xdmf_io.h"
+#include "elem.h"
+#include "mesh_base.h"
+#include "parallel.h"
+#include "simulation_system.h"
+#include "simulation_region.h"
+#include "fvm_node_info.h"
+#include "fvm_node_data.h"
+#include "enum_io_package.h"
+#include "perf_log.h"
+#include "log.h"
+
+#ifdef HAVE_HDF5
+#include "CogendaHDF5.h"
+#endif
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+
+using PhysicalUnit::s;
+using PhysicalUnit::eV;
+using PhysicalUnit::cm;
+using PhysicalUnit::um;
+using PhysicalUnit::V;
+using PhysicalUnit::K;
+
+
+/**
+ * node based solution of each step
+ */
+static const unsigned int _n_step_fields = 9;
+static const char * _step_field_name[_n_step_fields] =
+  { "potential", "electron", "hole", "temperature", "Ec", "Ev", "qFn", "qFp", "E_magnitude" };
+
+static void _step_fields(const FVM_Node * fvm_node, float * values)
+{
+  const FVM_NodeData * node_data = fvm_node->node_data();
+  const double concentration_scale = std::pow(cm, -3);
+
+  values[0] = static_cast<float>(node_data->psi()/V);
+  values[1] = static_cast<float>(node_data->n()/concentration_scale);
+  values[2] = static_cast<float>(node_data->p()/concentration_scale);
+  values[3] = static_cast<float>(node_data->T()/K);
+  values[4] = static_cast<float>(node_data->Ec()/eV);
+  values[5] = static_cast<float>(node_data->Ev()/eV);
+  values[6] = static_cast<float>(node_data->qFn()/eV);
+  values[7] = static_cast<float>(node_data->qFp()/eV);
+  values[8] = static_cast<float>(node_data->E().size()/(V/cm));
+}
+
+/**
+ * node based data written with the mesh: coordinates and net doping
+ */
+static void _mesh_fields(const FVM_Node * fvm_node, float * values)
+{
+  const Point & p = *(fvm_node->root_node());
+  values[0] = static_cast<float>(p[0]/um);
+  values[1] = static_cast<float>(p[1]/um);
+  values[2] = static_cast<float>(p[2]/um);
+  values[3] = static_cast<float>(fvm_node->node_data()->Net_doping()/std::pow(cm, -3));
+}
+
+
+/**
+ * @return the xdmf cell type of a (first order) elem
+ */
+static int _xdmf_cell_type(const Elem * elem)
+{
+  switch(elem->dim())
+  {
+    case 1: return 2;                                    // Polyline
+    case 2: return elem->n_nodes() == 3 ? 4 : 5;         // Triangle, Quadrilateral
+    case 3:
+      switch(elem->n_nodes())
+      {
+        case 4 : return 6;                               // Tetrahedron
+        case 5 : return 7;                               // Pyramid
+        case 6 : return 8;                               // Wedge
+        default: return 9;                               // Hexahedron
+      }
+  }
+  return 0;
+}
+
+
+
+/**
+ * a block of data to be written by the writer thread
+ */
+struct XDMFJob
+{
+  /// -1 for mesh, otherwise the step index
+  int                  step;
+  double               time;
+  /// node based data, n_values per point
+  std::vector<float>   node_data;
+  /// xdmf mixed topology and region index of cells, only for mesh
+  std::vector<int>     topology;
+  std::vector<int>     cell_region;
+  unsigned int         n_cells;
+};
+
+
+
+/**
+ * own the HDF5 file and the writer thread. jobs are written in FIFO order,
+ * at most max_pending jobs are buffered
+ */
+class XDMFTimeSeries::Writer
+{
+public:
+
+  Writer(const std::string & prefix, const std::vector<std::string> & region_info, int compression)
+    : _prefix(prefix), _region_info(region_info), _compression(compression),
+      _n_points(0), _n_cells(0), _topology_size(0), _shutdown(false)
+  {
+#ifdef HAVE_HDF5
+    _file = -1;
+#endif
+#ifdef HAVE_PTHREAD
+    pthread_mutex_init(&_mutex, NULL);
+    pthread_cond_init(&_cond, NULL);
+    _thread_running = (pthread_create(&_thread, NULL, _writer_main, this) == 0);
+#endif
+  }
+
+  ~Writer()
+  {
+#ifdef HAVE_PTHREAD
+    if(_thread_running)
+    {
+      pthread_mutex_lock(&_mutex);
+      _shutdown = true;
+      pthread_cond_broadcast(&_cond);
+      pthread_mutex_unlock(&_mutex);
+      pthread_join(_thread, NULL);
+    }
+    pthread_cond_destroy(&_cond);
+    pthread_mutex_destroy(&_mutex);
+#endif
+    // jobs not written by thread
+    while(!_queue.empty())
+    {
+      _write(_queue.front());
+      delete _queue.front();
+      _queue.pop_front();
+    }
+#ifdef HAVE_HDF5
+    if(_file >= 0) H5Fclose(_file);
+#endif
+    if(_xmf.is_open()) _xmf.close();
+  }
+
+  /**
+   * queue the job, the writer takes the ownership
+   */
+  void push(XDMFJob * job)
+  {
+#ifdef HAVE_PTHREAD
+    if(_thread_running)
+    {
+      pthread_mutex_lock(&_mutex);
+      while(_queue.size() >= max_pending)
+        pthread_cond_wait(&_cond, &_mutex);
+      _queue.push_back(job);
+      pthread_cond_broadcast(&_cond);
+      pthread_mutex_unlock(&_mutex);
+      return;
+    }
+#endif
+    _write(job);
+    delete job;
+  }
+
+  /**
+   * wait until the queue is empty
+   */
+  void flush()
+  {
+#ifdef HAVE_PTHREAD
+    if(_thread_running)
+    {
+      pthread_mutex_lock(&_mutex);
+      while(!_queue.empty())
+        pthread_cond_wait(&_cond, &_mutex);
+      pthread_mutex_unlock(&_mutex);
+    }
+#endif
+  }
+
+  static const unsigned int max_pending = 4;
+
+private:
+
+  std::string                _prefix;
+  std::vector<std::string>   _region_info;
+  int                        _compression;
+
+  unsigned int               _n_points;
+  unsigned int               _n_cells;
+  unsigned int               _topology_size;
+
+  /// the xdmf file, kept open to append steps
+  std::ofstream              _xmf;
+  /// position of the closing tags in xdmf file
+  std::streampos             _xmf_footer;
+
+  /// jobs wait for writing, the front one is being written
+  std::deque<XDMFJob *>      _queue;
+  bool                       _shutdown;
+
+#ifdef HAVE_HDF5
+  hid_t                      _file;
+#endif
+
+#ifdef HAVE_PTHREAD
+  pthread_t                  _thread;
+  pthread_mutex_t            _mutex;
+  pthread_cond_t             _cond;
+  bool                       _thread_running;
+
+  static void * _writer_main(void * arg)
+  {
+    Writer * writer = static_cast<Writer *>(arg);
+
+    pthread_mutex_lock(&writer->_mutex);
+    while(true)
+    {
+      while(writer->_queue.empty() && !writer->_shutdown)
+        pthread_cond_wait(&writer->_cond, &writer->_mutex);
+      if(writer->_queue.empty()) break;
+
+      // keep the job in queue while writing, thus flush() waits for it
+      XDMFJob * job = writer->_queue.front();
+      pthread_mutex_unlock(&writer->_mutex);
+
+      writer->_write(job);
+      delete job;
+
+      pthread_mutex_lock(&writer->_mutex);
+      writer->_queue.pop_front();
+      pthread_cond_broadcast(&writer->_cond);
+    }
+    pthread_mutex_unlock(&writer->_mutex);
+
+    return NULL;
+  }
+#endif
+
+#ifdef HAVE_HDF5
+  /**
+   * write a (compressed) dataset of \p rows x \p cols
+   */
+  template <typename T>
+  void _write_dataset(hid_t group, const std::string & name, const std::vector<T> & data, hsize_t cols)
+  {
+    const hsize_t dims[2] = { cols ? data.size()/cols : 0, cols };
+    const int rank = cols > 1 ? 2 : 1;
+    hid_t dspace = H5Screate_simple(rank, dims, NULL);
+
+    hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+    if(_compression > 0 && !data.empty())
+    {
+      H5Pset_chunk(plist, rank, dims);
+      H5Pset_shuffle(plist);
+      H5Pset_deflate(plist, _compression);
+    }
+
+    hid_t dset = H5Dcreate(group, name.c_str(), CogendaHDF5::getHDF5MemType<T>(), dspace, H5P_DEFAULT, plist, H5P_DEFAULT);
+    if(dset >= 0)
+    {
+      if(!data.empty())
+        H5Dwrite(dset, CogendaHDF5::getHDF5MemType<T>(), H5S_ALL, H5S_ALL, H5P_DEFAULT, &data[0]);
+      H5Dclose(dset);
+    }
+    H5Pclose(plist);
+    H5Sclose(dspace);
+  }
+#endif
+
+  /**
+   * @return the name of hdf5 group of step
+   */
+  static std::string _step_group(unsigned int step)
+  {
+    std::ostringstream name;
+    name << "step_" << std::setw(6) << std::setfill('0') << step;
+    return name.str();
+  }
+
+  /**
+   * write the job to hdf5 file, then update the xdmf file
+   */
+  void _write(XDMFJob * job)
+  {
+#ifdef HAVE_HDF5
+    if(job->step < 0)
+    {
+      _file = H5Fcreate((_prefix + ".h5").c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+      if(_file < 0) return;
+
+      // split point coordinates and doping
+      const unsigned int n_points = job->node_data.size()/4;
+      std::vector<float> points(3*n_points), doping(n_points);
+      for(unsigned int n=0; n<n_points; ++n)
+      {
+        points[3*n+0] = job->node_data[4*n+0];
+        points[3*n+1] = job->node_data[4*n+1];
+        points[3*n+2] = job->node_data[4*n+2];
+        doping[n]     = job->node_data[4*n+3];
+      }
+
+      hid_t group = H5Gcreate(_file, "mesh", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      _write_dataset(group, "points", points, 3);
+      _write_dataset(group, "topology", job->topology, 1);
+      _write_dataset(group, "region", job->cell_region, 1);
+      _write_dataset(group, "net_doping", doping, 1);
+      H5Gclose(group);
+
+      _n_points = n_points;
+      _n_cells = job->n_cells;
+      _topology_size = job->topology.size();
+
+      // the xdmf file only refers to the data on disk
+      H5Fflush(_file, H5F_SCOPE_GLOBAL);
+      _write_xdmf_header();
+    }
+    else
+    {
+      if(_file < 0) return;
+
+      hid_t group = H5Gcreate(_file, _step_group(job->step).c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      CogendaHDF5::setAttribute(group, "time", job->time);
+      for(unsigned int f=0; f<_n_step_fields; ++f)
+      {
+        std::vector<float> field(_n_points);
+        for(unsigned int n=0; n<_n_points; ++n)
+          field[n] = job->node_data[_n_step_fields*n+f];
+        _write_dataset(group, _step_field_name[f], field, 1);
+      }
+      H5Gclose(group);
+
+      H5Fflush(_file, H5F_SCOPE_GLOBAL);
+      _write_xdmf_step(job->step, job->time);
+    }
+#endif
+  }
+
+  /**
+   * @return the name of hdf5 file as referred by the xdmf file
+   */
+  std::string _h5_name() const
+  {
+    std::string h5 = _prefix + ".h5";
+    std::string::size_type slash = h5.rfind('/');
+    if(slash != std::string::npos) h5 = h5.substr(slash+1);
+    return h5;
+  }
+
+  /**
+   * write the header of xdmf file and remember where the closing tags begin
+   */
+  void _write_xdmf_header()
+  {
+    _xmf.open((_prefix + ".xmf").c_str(), std::ios::out | std::ios::trunc);
+    _xmf << "<?xml version=\"1.0\" ?>\n"
+         << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n"
+         << "<Xdmf Version=\"2.0\">\n"
+         << "  <Domain>\n";
+    for(unsigned int r=0; r<_region_info.size(); ++r)
+      _xmf << "    <Information Name=\"region" << r << "\" Value=\"" << _region_info[r] << "\"/>\n";
+    _xmf << "    <Grid Name=\"TimeSeries\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+    _write_xdmf_footer();
+  }
+
+  /**
+   * append the grid of one step to the xdmf file.
+   * only the closing tags are overwritten, thus the cost does not grow with the number of steps
+   */
+  void _write_xdmf_step(int step, double time)
+  {
+    if(!_xmf.is_open()) return;
+
+    const std::string h5 = _h5_name();
+    const std::string group = _step_group(step);
+
+    _xmf.seekp(_xmf_footer);
+    _xmf << "      <Grid Name=\"" << group << "\" GridType=\"Uniform\">\n"
+         << "        <Time Value=\"" << std::setprecision(12) << time << "\"/>\n"
+         << "        <Topology TopologyType=\"Mixed\" NumberOfElements=\"" << _n_cells << "\">\n"
+         << "          <DataItem Dimensions=\"" << _topology_size << "\" NumberType=\"Int\" Format=\"HDF\">" << h5 << ":/mesh/topology</DataItem>\n"
+         << "        </Topology>\n"
+         << "        <Geometry GeometryType=\"XYZ\">\n"
+         << "          <DataItem Dimensions=\"" << _n_points << " 3\" NumberType=\"Float\" Precision=\"4\" Format=\"HDF\">" << h5 << ":/mesh/points</DataItem>\n"
+         << "        </Geometry>\n"
+         << "        <Attribute Name=\"region\" AttributeType=\"Scalar\" Center=\"Cell\">\n"
+         << "          <DataItem Dimensions=\"" << _n_cells << "\" NumberType=\"Int\" Format=\"HDF\">" << h5 << ":/mesh/region</DataItem>\n"
+         << "        </Attribute>\n"
+         << "        <Attribute Name=\"net_doping\" AttributeType=\"Scalar\" Center=\"Node\">\n"
+         << "          <DataItem Dimensions=\"" << _n_points << "\" NumberType=\"Float\" Precision=\"4\" Format=\"HDF\">" << h5 << ":/mesh/net_doping</DataItem>\n"
+         << "        </Attribute>\n";
+    for(unsigned int f=0; f<_n_step_fields; ++f)
+      _xmf << "        <Attribute Name=\"" << _step_field_name[f] << "\" AttributeType=\"Scalar\" Center=\"Node\">\n"
+           << "          <DataItem Dimensions=\"" << _n_points << "\" NumberType=\"Float\" Precision=\"4\" Format=\"HDF\">"
+           << h5 << ":/" << group << '/' << _step_field_name[f] << "</DataItem>\n"
+           << "        </Attribute>\n";
+    _xmf << "      </Grid>\n";
+    _write_xdmf_footer();
+  }
+
+  /**
+   * write the closing tags at the end of xdmf file, they are overwritten by the next step.
+   * a step grid is always longer than the closing tags, no stale bytes are left behind
+   */
+  void _write_xdmf_footer()
+  {
+    _xmf_footer = _xmf.tellp();
+    _xmf << "    </Grid>\n"
+         << "  </Domain>\n"
+         << "</Xdmf>\n";
+    _xmf.flush();
+  }
+};
+
+
+
+
+XDMFTimeSeries::XDMFTimeSeries(const SimulationSystem & system, const std::string & prefix, int compression)
+  : _system(system), _prefix(prefix), _n_steps(0), _writer(0)
+{
+
+  // the points are ordered region by region
+  unsigned int n_points = 0;
+  _region_nodes.resize(_system.n_regions());
+  for(unsigned int r=0; r<_system.n_regions(); ++r)
+  {
+    _system.region(r)->region_node(_region_nodes[r]);
+    _region_offset.push_back(n_points);
+    n_points += _region_nodes[r].size();
+  }
+
+#ifdef HAVE_HDF5
+  if(Genius::processor_id() == 0)
+  {
+    std::vector<std::string> region_info;
+    for(unsigned int r=0; r<_system.n_regions(); ++r)
+      region_info.push_back(_system.region(r)->name() + " " + _system.region(r)->material());
+    _writer = new Writer(prefix, region_info, compression);
+  }
+#else
+  MESSAGE<<"Genius is not compiled with HDF5 support, skip XDMF export... "<< std::endl; RECORD();
+#endif
+
+  _write_mesh();
+}
+
+
+
+XDMFTimeSeries::~XDMFTimeSeries()
+{
+  delete _writer;
+}
+
+
+
+unsigned int XDMFTimeSeries::_point_index(unsigned int r, unsigned int node) const
+{
+  const std::vector<unsigned int> & nodes = _region_nodes[r];
+  std::vector<unsigned int>::const_iterator it = std::lower_bound(nodes.begin(), nodes.end(), node);
+  genius_assert( it != nodes.end() && *it == node );
+  return _region_offset[r] + (it - nodes.begin());
+}
+
+
+
+void XDMFTimeSeries::_gather_node_data(unsigned int n_values, void (*fun)(const FVM_Node *, float *), std::vector<float> & data) const
+{
+  data.clear();
+
+  for(unsigned int r=0; r<_system.n_regions(); ++r)
+  {
+    const SimulationRegion * region = _system.region(r);
+
+    std::vector<unsigned int> ids;
+    std::vector<float> values;
+
+    SimulationRegion::const_processor_node_iterator it = region->on_processor_nodes_begin();
+    SimulationRegion::const_processor_node_iterator it_end = region->on_processor_nodes_end();
+    for(; it!=it_end; ++it)
+    {
+      const FVM_Node * fvm_node = *it;
+      ids.push_back(fvm_node->root_node()->id());
+      values.resize(values.size() + n_values);
+      fun(fvm_node, &values[values.size() - n_values]);
+    }
+
+    Parallel::gather(0, ids);
+    Parallel::gather(0, values);
+
+    if(Genius::processor_id() == 0)
+    {
+      data.resize((_region_offset[r] + _region_nodes[r].size())*n_values);
+      for(unsigned int n=0; n<ids.size(); ++n)
+      {
+        const unsigned int index = _point_index(r, ids[n]);
+        std::copy(&values[n*n_values], &values[n*n_values] + n_values, &data[index*n_values]);
+      }
+    }
+  }
+}
+
+
+
+void XDMFTimeSeries::_write_mesh()
+{
+  START_LOG("write_mesh()", "XDMFTimeSeries");
+
+  XDMFJob * job = new XDMFJob;
+  job->step = -1;
+  job->time = 0.0;
+  job->n_cells = 0;
+
+  _gather_node_data(4, _mesh_fields, job->node_data);
+
+  // cells of this processor: id, region, xdmf type, number of nodes and node ids
+  const MeshBase & mesh = _system.mesh();
+  std::vector<unsigned int> cell_ids;
+  std::vector<int> cell_conns;
+  {
+    MeshBase::const_element_iterator       it  = mesh.active_this_pid_elements_begin();
+    const MeshBase::const_element_iterator end = mesh.active_this_pid_elements_end();
+    for ( ; it != end; ++it)
+    {
+      const Elem *elem  = (*it);
+
+      std::vector<unsigned int> conn;
+      elem->connectivity(0, VTK, conn);
+
+      cell_ids.push_back(elem->id());
+      cell_conns.push_back(elem->subdomain_id());
+      cell_conns.push_back(_xdmf_cell_type(elem));
+      cell_conns.push_back(conn.size());
+      for(unsigned int i=0; i<conn.size(); ++i)
+        cell_conns.push_back(conn[i]);
+    }
+
+    Parallel::gather(0, cell_ids);
+    Parallel::gather(0, cell_conns);
+  }
+
+  if(Genius::processor_id() == 0)
+  {
+    // cells are ordered by id
+    std::vector< std::pair<unsigned int, unsigned int> > order;
+    for(unsigned int n=0, cnt=0; n<cell_ids.size(); ++n)
+    {
+      order.push_back(std::make_pair(cell_ids[n], cnt));
+      cnt += 3 + cell_conns[cnt+2];
+    }
+    std::sort(order.begin(), order.end());
+
+    for(unsigned int n=0; n<order.size(); ++n)
+    {
+      unsigned int cnt = order[n].second;
+      const unsigned int region = cell_conns[cnt++];
+      const int type = cell_conns[cnt++];
+      const unsigned int n_nodes = cell_conns[cnt++];
+
+      job->cell_region.push_back(region);
+      job->topology.push_back(type);
+      if(type == 2) job->topology.push_back(n_nodes);
+      for(unsigned int i=0; i<n_nodes; ++i)
+        job->topology.push_back(_point_index(region, cell_conns[cnt++]));
+    }
+    job->n_cells = order.size();
+  }
+
+  if(_writer)
+    _writer->push(job);
+  else
+    delete job;
+
+  STOP_LOG("write_mesh()", "XDMFTimeSeries");
+}
+
+
+
+void XDMFTimeSeries::write_step(double time)
+{
+  START_LOG("write_step()", "XDMFTimeSeries");
+
+  XDMFJob * job = new XDMFJob;
+  job->step = _n_steps++;
+  job->time = time;
+  job->n_cells = 0;
+
+  _gather_node_data(_n_step_fields, _step_fields, job->node_data);
+
+  if(_writer)
+    _writer->push(job);
+  else
+    delete job;
+
+  STOP_LOG("write_step()", "XDMFTimeSeries");
+}
+
+
+
+void XDMFTimeSeries::flush()
+{
+  if(_writer) _writer->flush();
+}
+
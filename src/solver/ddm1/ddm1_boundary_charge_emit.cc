@@ -168,14 +168,14 @@ void ChargeEmitBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_value_f
           PetscScalar p = x[local_offset+2];  // hole density
 
           // mapping this node to material library
-          semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+          const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-          PetscScalar ni  = semi_region->material()->band->ni(T);
-          PetscScalar nie = semi_region->material()->band->nie(p, n, T);
-          PetscScalar Nc  = semi_region->material()->band->Nc(T);
-          PetscScalar Nv  = semi_region->material()->band->Nv(T);
-          PetscScalar Eg  = semi_region->material()->band->Eg(T);
-          PetscScalar dEg = semi_region->material()->band->EgNarrow(p, n, T);
+          PetscScalar ni  = semi_region->material()->band->ni(ctx, T);
+          PetscScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+          PetscScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+          PetscScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+          PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
+          PetscScalar dEg = semi_region->material()->band->EgNarrow(ctx, p, n, T);
 
           //Boltzmann
           {
@@ -315,14 +315,14 @@ void ChargeEmitBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *jac
           AutoDScalar n = x[fvm_nodes[i]->local_offset()+1];    n.setADValue(1, 1.0);  // electron density
           AutoDScalar p = x[fvm_nodes[i]->local_offset()+2];    p.setADValue(2, 1.0);  // hole density
 
-          semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+          const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-          PetscScalar ni  = semi_region->material()->band->ni(T);
-          AutoDScalar nie = semi_region->material()->band->nie(p, n, T);
-          PetscScalar Nc  = semi_region->material()->band->Nc(T);
-          PetscScalar Nv  = semi_region->material()->band->Nv(T);
-          PetscScalar Eg  = semi_region->material()->band->Eg(T);
-          AutoDScalar dEg = semi_region->material()->band->EgNarrow(p, n, T);
+          PetscScalar ni  = semi_region->material()->band->ni(ctx, T);
+          AutoDScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+          PetscScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+          PetscScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+          PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
+          AutoDScalar dEg = semi_region->material()->band->EgNarrow(ctx, p, n, T);
 
           //governing equation for Ohmic contact boundary
           AutoDScalar ff2;
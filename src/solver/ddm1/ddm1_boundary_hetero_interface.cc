@@ -141,6 +141,7 @@ void HeteroInterfaceBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_va
     PetscScalar n0;
     PetscScalar p0;
     Material::MaterialSemiconductor * mt0;
+    PMI_Context ctx0;
     PetscScalar Ec0,Ev0;
 
     // search all the fvm_node which has *node_it as root node, these nodes are the same in geometry,
@@ -165,10 +166,10 @@ void HeteroInterfaceBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_va
         p0 = x[fvm_node->local_offset()+2];  // hole density
 
         mt0 = semi_region->material();
-        mt0->mapping(fvm_node->root_node(), n0_data, SolverSpecify::clock);
+        ctx0 = mt0->mapping(fvm_node->root_node(), n0_data, SolverSpecify::clock);
 
-        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(p0, n0, T) + kb*T*log(n0_data->Nc()));
-        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(p0, n0, T) - kb*T*log(n0_data->Nv()) + mt0->band->Eg(T));
+        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(ctx0, p0, n0, T) + kb*T*log(n0_data->Nc()));
+        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(ctx0, p0, n0, T) - kb*T*log(n0_data->Nv()) + mt0->band->Eg(ctx0, T));
         if(semi_region->get_advanced_model()->Fermi)
         {
           Ec0 = Ec0 - e*Vt*log(gamma_f(fabs(n0)/n0_data->Nc()));
@@ -199,9 +200,9 @@ void HeteroInterfaceBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_va
 
               // mapping this node to material library
               Material::MaterialSemiconductor *mt = semi_region->material();
-              mt->mapping(fvm_node->root_node(), n_data, SolverSpecify::clock);
-              PetscScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(p, n, T) + kb*T*log(n_data->Nc()));
-              PetscScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(T));
+              const PMI_Context ctx = mt->mapping(fvm_node->root_node(), n_data, SolverSpecify::clock);
+              PetscScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(ctx, p, n, T) + kb*T*log(n_data->Nc()));
+              PetscScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(ctx, p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(ctx, T));
               if(semi_region->get_advanced_model()->Fermi)
               {
                 Ec = Ec - e*Vt*log(gamma_f(fabs(n)/n_data->Nc()));
@@ -221,16 +222,16 @@ void HeteroInterfaceBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_va
               if(Ec0 > Ec)
               {
                 // electrons are leaving region 0
-                PetscScalar pm = mt0->band->EffecElecMass(T)/mt->band->EffecElecMass(T);
-                PetscScalar Jn = 2.*(mt0->band->ThermalVn(T)*n0 - pm*mt->band->ThermalVn(T)*(n*exp(-(Ec0-Ec)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt0->band->EffecElecMass(ctx0, T)/mt->band->EffecElecMass(ctx, T);
+                PetscScalar Jn = 2.*(mt0->band->ThermalVn(ctx0, T)*n0 - pm*mt->band->ThermalVn(ctx, T)*(n*exp(-(Ec0-Ec)/(kb*T))))*cv_boundary;
                 VecSetValue(f, fvm_node->global_offset()+1,   Jn, ADD_VALUES);
                 VecSetValue(f, fvm_node0->global_offset()+1, -Jn, ADD_VALUES);
               }
               else
               {
                 // electrons are leaving this region
-                PetscScalar pm = mt->band->EffecElecMass(T)/mt0->band->EffecElecMass(T);
-                PetscScalar Jn = 2.*(mt->band->ThermalVn(T)*n - pm*mt0->band->ThermalVn(T)*(n0*exp(-(Ec-Ec0)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt->band->EffecElecMass(ctx, T)/mt0->band->EffecElecMass(ctx0, T);
+                PetscScalar Jn = 2.*(mt->band->ThermalVn(ctx, T)*n - pm*mt0->band->ThermalVn(ctx0, T)*(n0*exp(-(Ec-Ec0)/(kb*T))))*cv_boundary;
                 VecSetValue(f, fvm_node->global_offset()+1,  -Jn, ADD_VALUES);
                 VecSetValue(f, fvm_node0->global_offset()+1,  Jn, ADD_VALUES);
               }
@@ -238,16 +239,16 @@ void HeteroInterfaceBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_va
               if(Ev0 < Ev)
               {
                 // holes are leaving region 0
-                PetscScalar pm = mt0->band->EffecHoleMass(T)/mt->band->EffecHoleMass(T);
-                PetscScalar Jp = 2.*(mt0->band->ThermalVp(T)*p0 - pm*mt->band->ThermalVp(T)*(p*exp((Ev0-Ev)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt0->band->EffecHoleMass(ctx0, T)/mt->band->EffecHoleMass(ctx, T);
+                PetscScalar Jp = 2.*(mt0->band->ThermalVp(ctx0, T)*p0 - pm*mt->band->ThermalVp(ctx, T)*(p*exp((Ev0-Ev)/(kb*T))))*cv_boundary;
                 VecSetValue(f, fvm_node->global_offset()+2,   Jp, ADD_VALUES);
                 VecSetValue(f, fvm_node0->global_offset()+2, -Jp, ADD_VALUES);
               }
               else
               {
                 // holes are leaving this region
-                PetscScalar pm = mt->band->EffecHoleMass(T)/mt0->band->EffecHoleMass(T);
-                PetscScalar Jp = 2.*(mt->band->ThermalVp(T)*p - pm*mt0->band->ThermalVp(T)*(p0*exp((Ev-Ev0)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt->band->EffecHoleMass(ctx, T)/mt0->band->EffecHoleMass(ctx0, T);
+                PetscScalar Jp = 2.*(mt->band->ThermalVp(ctx, T)*p - pm*mt0->band->ThermalVp(ctx0, T)*(p0*exp((Ev-Ev0)/(kb*T))))*cv_boundary;
                 VecSetValue(f, fvm_node->global_offset()+2,  -Jp, ADD_VALUES);
                 VecSetValue(f, fvm_node0->global_offset()+2,  Jp, ADD_VALUES);
               }
@@ -378,6 +379,7 @@ void HeteroInterfaceBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
     AutoDScalar n0;
     AutoDScalar p0;
     Material::MaterialSemiconductor * mt0;
+    PMI_Context ctx0;
     AutoDScalar Ec0,Ev0;
 
     // search all the fvm_node which has *node_it as root node, these nodes are the same in geometry,
@@ -398,7 +400,7 @@ void HeteroInterfaceBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
 
         mt0 = semi_region->material();
         mt0->set_ad_num(adtl::AutoDScalar::numdir);
-        mt0->mapping(fvm_node->root_node(), n0_data, SolverSpecify::clock);
+        ctx0 = mt0->mapping(fvm_node->root_node(), n0_data, SolverSpecify::clock);
 
         fvm_node0 = fvm_node;
         V0 = x[fvm_node->local_offset()+0];  V0.setADValue(0,1.0);
@@ -407,8 +409,8 @@ void HeteroInterfaceBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
 
 
 
-        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(p0, n0, T) + kb*T*log(n0_data->Nc()));
-        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(p0, n0, T) - kb*T*log(n0_data->Nv()) + mt0->band->Eg(T));
+        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(ctx0, p0, n0, T) + kb*T*log(n0_data->Nc()));
+        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(ctx0, p0, n0, T) - kb*T*log(n0_data->Nv()) + mt0->band->Eg(ctx0, T));
         if(semi_region->get_advanced_model()->Fermi)
         {
           Ec0 = Ec0 - e*Vt*log(gamma_f(fabs(n0)/n0_data->Nc()));
@@ -442,9 +444,9 @@ void HeteroInterfaceBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
               // mapping this node to material library
               Material::MaterialSemiconductor *mt = semi_region->material();
               mt->set_ad_num(adtl::AutoDScalar::numdir);
-              mt->mapping(fvm_node->root_node(), n_data, SolverSpecify::clock);
-              AutoDScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(p, n, T) + kb*T*log(n_data->Nc()));
-              AutoDScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(T));
+              const PMI_Context ctx = mt->mapping(fvm_node->root_node(), n_data, SolverSpecify::clock);
+              AutoDScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(ctx, p, n, T) + kb*T*log(n_data->Nc()));
+              AutoDScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(ctx, p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(ctx, T));
               if(semi_region->get_advanced_model()->Fermi)
               {
                 Ec = Ec - e*Vt*log(gamma_f(fabs(n)/n_data->Nc()));
@@ -462,16 +464,16 @@ void HeteroInterfaceBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
               if(Ec0 > Ec)
               {
                 // electrons are leaving region 0
-                PetscScalar pm = mt0->band->EffecElecMass(T)/mt->band->EffecElecMass(T);
-                AutoDScalar Jn = 2.*(mt0->band->ThermalVn(T)*n0 - pm*mt->band->ThermalVn(T)*(n*exp(-(Ec0-Ec)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt0->band->EffecElecMass(ctx0, T)/mt->band->EffecElecMass(ctx, T);
+                AutoDScalar Jn = 2.*(mt0->band->ThermalVn(ctx0, T)*n0 - pm*mt->band->ThermalVn(ctx, T)*(n*exp(-(Ec0-Ec)/(kb*T))))*cv_boundary;
                 jac->add_row(  rows[4],  cols.size(),  &cols[0],  Jn.getADValue() );
                 jac->add_row(  rows[1],  cols.size(),  &cols[0],  (-Jn).getADValue() );
               }
               else
               {
                 // electrons are leaving this region
-                PetscScalar pm = mt->band->EffecElecMass(T)/mt0->band->EffecElecMass(T);
-                AutoDScalar Jn = 2.*(mt->band->ThermalVn(T)*n - pm*mt0->band->ThermalVn(T)*(n0*exp(-(Ec-Ec0)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt->band->EffecElecMass(ctx, T)/mt0->band->EffecElecMass(ctx0, T);
+                AutoDScalar Jn = 2.*(mt->band->ThermalVn(ctx, T)*n - pm*mt0->band->ThermalVn(ctx0, T)*(n0*exp(-(Ec-Ec0)/(kb*T))))*cv_boundary;
                 jac->add_row(  rows[4],  cols.size(),  &cols[0],  (-Jn).getADValue() );
                 jac->add_row(  rows[1],  cols.size(),  &cols[0],  Jn.getADValue() );
               }
@@ -479,16 +481,16 @@ void HeteroInterfaceBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
               if(Ev0 < Ev)
               {
                 // holes are leaving region 0
-                PetscScalar pm = mt0->band->EffecHoleMass(T)/mt->band->EffecHoleMass(T);
-                AutoDScalar Jp = 2.*(mt0->band->ThermalVp(T)*p0 - pm*mt->band->ThermalVp(T)*(p*exp((Ev0-Ev)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt0->band->EffecHoleMass(ctx0, T)/mt->band->EffecHoleMass(ctx, T);
+                AutoDScalar Jp = 2.*(mt0->band->ThermalVp(ctx0, T)*p0 - pm*mt->band->ThermalVp(ctx, T)*(p*exp((Ev0-Ev)/(kb*T))))*cv_boundary;
                 jac->add_row(  rows[5],  cols.size(),  &cols[0],  Jp.getADValue() );
                 jac->add_row(  rows[2],  cols.size(),  &cols[0],  (-Jp).getADValue() );
               }
               else
               {
                 // holes are leaving this region
-                PetscScalar pm = mt->band->EffecHoleMass(T)/mt0->band->EffecHoleMass(T);
-                AutoDScalar Jp = 2.*(mt->band->ThermalVp(T)*p - pm*mt0->band->ThermalVp(T)*(p0*exp((Ev-Ev0)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt->band->EffecHoleMass(ctx, T)/mt0->band->EffecHoleMass(ctx0, T);
+                AutoDScalar Jp = 2.*(mt->band->ThermalVp(ctx, T)*p - pm*mt0->band->ThermalVp(ctx0, T)*(p0*exp((Ev-Ev0)/(kb*T))))*cv_boundary;
                 jac->add_row(  rows[5],  cols.size(),  &cols[0],  (-Jp).getADValue() );
                 jac->add_row(  rows[2],  cols.size(),  &cols[0],  Jp.getADValue() );
               }
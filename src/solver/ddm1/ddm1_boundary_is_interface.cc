@@ -195,8 +195,8 @@ void InsulatorSemiconductorInterfaceBC::DDM1_Function(PetscScalar * x, Vec f, In
           {
               // surface recombination
             Material::MaterialSemiconductor *mt =  sregion->material();
-            mt->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
-            PetscScalar GSurf = - mt->band->R_Surf(p, n, T) * boundary_area; //generation due to SRH
+            const PMI_Context ctx = mt->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            PetscScalar GSurf = - mt->band->R_Surf(ctx, p, n, T) * boundary_area; //generation due to SRH
 
             VecSetValue(f, fvm_nodes[i]->global_offset()+1, GSurf, ADD_VALUES);
             VecSetValue(f, fvm_nodes[i]->global_offset()+2, GSurf, ADD_VALUES);
@@ -205,20 +205,20 @@ void InsulatorSemiconductorInterfaceBC::DDM1_Function(PetscScalar * x, Vec f, In
           if (sregion->get_advanced_model()->Trap)
           {
               // process interface traps
-            sregion->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = sregion->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
               // calculate interface trap occupancy
-            PetscScalar ni = sregion->material()->band->nie(p, n, T);
-            sregion->material()->trap->Calculate(false,p,n,ni,T);
+            PetscScalar ni = sregion->material()->band->nie(ctx, p, n, T);
+            sregion->material()->trap->Calculate(ctx, false,p,n,ni,T);
 
               // contribution of trapped charge to Poisson's eqn
-            PetscScalar TrappedC = sregion->material()->trap->Charge(false) * boundary_area;
+            PetscScalar TrappedC = sregion->material()->trap->Charge(ctx, false) * boundary_area;
             if (TrappedC !=0)
               VecSetValue(f, fvm_nodes[i]->global_offset(), TrappedC, ADD_VALUES);
 
               // electron/hole capture rates and contribution to continuity equations
-            PetscScalar TrapElec = sregion->material()->trap->ElectronTrapRate(false,n,ni,T) * boundary_area;
-            PetscScalar TrapHole = sregion->material()->trap->HoleTrapRate    (false,p,ni,T) * boundary_area;
+            PetscScalar TrapElec = sregion->material()->trap->ElectronTrapRate(ctx, false,n,ni,T) * boundary_area;
+            PetscScalar TrapHole = sregion->material()->trap->HoleTrapRate    (ctx, false,p,ni,T) * boundary_area;
             if (TrapElec != 0)
               VecSetValue(f, fvm_nodes[i]->global_offset()+1, -TrapElec, ADD_VALUES);
             if (TrapHole != 0)
@@ -388,13 +388,13 @@ void InsulatorSemiconductorInterfaceBC::DDM1_Jacobian(PetscScalar * x, SparseMat
               mt->set_ad_num(adtl::AutoDScalar::numdir);
 
 
-              mt->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+              const PMI_Context ctx = mt->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-              AutoDScalar ni = mt->band->nie(p, n, T);
+              AutoDScalar ni = mt->band->nie(ctx, p, n, T);
 
               {
                 // surface recombination
-                AutoDScalar GSurf = - mt->band->R_Surf(p, n, T) * boundary_area;
+                AutoDScalar GSurf = - mt->band->R_Surf(ctx, p, n, T) * boundary_area;
 
                 jac->add_row(  index[1],  3,  &index[0],  GSurf.getADValue() );
                 jac->add_row(  index[2],  3,  &index[0],  GSurf.getADValue() );
@@ -403,12 +403,12 @@ void InsulatorSemiconductorInterfaceBC::DDM1_Jacobian(PetscScalar * x, SparseMat
               if (sregion->get_advanced_model()->Trap)
               {
 
-                mt->trap->Calculate(false,p,n,ni,T);
-                AutoDScalar TrappedC = mt->trap->ChargeAD(false) * boundary_area;
+                mt->trap->Calculate(ctx, false,p,n,ni,T);
+                AutoDScalar TrappedC = mt->trap->ChargeAD(ctx, false) * boundary_area;
                 jac->add_row(  index[0],  3,  &index[0],  TrappedC.getADValue() );
 
-                AutoDScalar GElec = - mt->trap->ElectronTrapRate(false,n,ni,T) * boundary_area;
-                AutoDScalar GHole = - mt->trap->HoleTrapRate    (false,p,ni,T) * boundary_area;
+                AutoDScalar GElec = - mt->trap->ElectronTrapRate(ctx, false,n,ni,T) * boundary_area;
+                AutoDScalar GHole = - mt->trap->HoleTrapRate    (ctx, false,p,ni,T) * boundary_area;
                 jac->add_row(  index[1],  3,  &index[0],  GElec.getADValue() );
                 jac->add_row(  index[2],  3,  &index[0],  GHole.getADValue() );
 
@@ -214,16 +214,16 @@ void OhmicContactBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_value
             PetscScalar p = x[local_offset+2];  // hole density
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
-
-            PetscScalar ni  = semi_region->material()->band->ni(T);
-            PetscScalar nie = semi_region->material()->band->nie(p, n, T);
-            PetscScalar Nc  = semi_region->material()->band->Nc(T);
-            PetscScalar Nv  = semi_region->material()->band->Nv(T);
-            PetscScalar Eg  = semi_region->material()->band->Eg(T);
-            PetscScalar dEg = semi_region->material()->band->EgNarrow(p, n, T);
-            PetscScalar dEc = semi_region->material()->band->EgNarrowToEc(p, n, T);
-            PetscScalar dEv = semi_region->material()->band->EgNarrowToEv(p, n, T);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+
+            PetscScalar ni  = semi_region->material()->band->ni(ctx, T);
+            PetscScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+            PetscScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+            PetscScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+            PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
+            PetscScalar dEg = semi_region->material()->band->EgNarrow(ctx, p, n, T);
+            PetscScalar dEc = semi_region->material()->band->EgNarrowToEc(ctx, p, n, T);
+            PetscScalar dEv = semi_region->material()->band->EgNarrowToEv(ctx, p, n, T);
             //governing equation for Ohmic contact boundary
             if(semi_region->get_advanced_model()->Fermi) //Fermi
             {
@@ -650,16 +650,16 @@ void OhmicContactBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *j
             // the electrode potential in current iteration
             AutoDScalar Ve = x[this->local_offset()];             Ve.setADValue(3, 1.0);
 
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-            PetscScalar ni  = semi_region->material()->band->ni(T);
-            AutoDScalar nie = semi_region->material()->band->nie(p, n, T);
-            PetscScalar Nc  = semi_region->material()->band->Nc(T);
-            PetscScalar Nv  = semi_region->material()->band->Nv(T);
-            PetscScalar Eg  = semi_region->material()->band->Eg(T);
-            AutoDScalar dEg = semi_region->material()->band->EgNarrow(p, n, T);
-            AutoDScalar dEc = semi_region->material()->band->EgNarrowToEc(p, n, T);
-            AutoDScalar dEv = semi_region->material()->band->EgNarrowToEv(p, n, T);
+            PetscScalar ni  = semi_region->material()->band->ni(ctx, T);
+            AutoDScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+            PetscScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+            PetscScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+            PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
+            AutoDScalar dEg = semi_region->material()->band->EgNarrow(ctx, p, n, T);
+            AutoDScalar dEc = semi_region->material()->band->EgNarrowToEc(ctx, p, n, T);
+            AutoDScalar dEv = semi_region->material()->band->EgNarrowToEv(ctx, p, n, T);
 
             //governing equation for Ohmic contact boundary
             AutoDScalar ff1,ff2,ff3;
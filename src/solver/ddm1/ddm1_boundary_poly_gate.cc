@@ -179,9 +179,9 @@ void PolyGateContactBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_va
           PetscScalar p = x[fvm_nodes[i]->local_offset()+2];
 
           // mapping this node to material library
-          semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+          const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-          PetscScalar nie = semi_region->material()->band->nie(p, n, T);
+          PetscScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
 
           // the governing equation
           PetscScalar f_psi = V + Work_Function - Ve;
@@ -467,9 +467,9 @@ void PolyGateContactBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
           AutoDScalar f_psi = V + Work_Function - Ve;
 
 
-          semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+          const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-          AutoDScalar nie = semi_region->material()->band->nie(p, n, T);
+          AutoDScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
 
           AutoDScalar  electron_density;
           AutoDScalar  hole_density;
@@ -295,12 +295,12 @@ void IF_Metal_OhmicBC::_DDM1_Function_Limited_Recombination ( PetscScalar * x, V
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    const PetscScalar nie = semiconductor_region->material()->band->nie ( p, n, T );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T );
+    const PetscScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T );
 
     PetscScalar  electron_density;
     PetscScalar  hole_density;
@@ -499,12 +499,12 @@ void IF_Metal_OhmicBC::_DDM1_Function_Infinite_Recombination ( PetscScalar * x,
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    const PetscScalar nie = semiconductor_region->material()->band->nie ( p, n, T );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T );
+    const PetscScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T );
 
     // here we should calculate current flow into this cell
     const PetscScalar inject_current = this->_current_buffer[i];//pre-computed
@@ -821,12 +821,12 @@ void IF_Metal_OhmicBC::_DDM1_Jacobian_Limited_Recombination ( PetscScalar * x, S
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    AutoDScalar nie = semiconductor_region->material()->band->nie ( p, n, T );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T );
+    AutoDScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T );
 
     AutoDScalar  electron_density;
     AutoDScalar  hole_density;
@@ -1000,12 +1000,12 @@ void IF_Metal_OhmicBC::_DDM1_Jacobian_Infinite_Recombination ( PetscScalar * x,
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    const PetscScalar nie = semiconductor_region->material()->band->nie ( p.getValue(), n.getValue(), T );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T );
+    const PetscScalar nie = semiconductor_region->material()->band->nie (ctx, p.getValue(), n.getValue(), T );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T );
 
     // d(current)/d(independent variables of bd node and its neighbors)
     const std::vector<PetscInt> & inject_current_col = _buffer_cols[i];
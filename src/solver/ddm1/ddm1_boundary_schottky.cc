@@ -159,7 +159,7 @@ void SchottkyContactBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_va
             const FVM_NodeData * node_data = fvm_nodes[i]->node_data();
             const SemiconductorSimulationRegion * semi_region = dynamic_cast<const SemiconductorSimulationRegion *>(regions[i]);
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
             PetscScalar V = x[local_offset+0];  // psi of this node
             PetscScalar n = x[local_offset+1];  // electron density
@@ -167,11 +167,11 @@ void SchottkyContactBC::DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_va
             PetscScalar T = T_external();
 
             //Schotty Barrier Lowerring
-            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
             //Schottky current
             PetscScalar S  = fvm_nodes[i]->outside_boundary_surface_area();
-            PetscScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-            PetscScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+            PetscScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+            PetscScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
             PetscScalar f_psi = V + Work_Function - deltaVB - Ve;
 
@@ -442,7 +442,7 @@ void SchottkyContactBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
             const FVM_NodeData * node_data = fvm_nodes[i]->node_data();
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
             //the indepedent variable number, we only need 4 here.
             adtl::AutoDScalar::numdir=4;
@@ -460,12 +460,12 @@ void SchottkyContactBC::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
             PetscScalar T = T_external();
 
             //Schotty Barrier Lowerring
-            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
 
             //Schottky current
             PetscScalar S  = fvm_nodes[i]->outside_boundary_surface_area();
-            AutoDScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-            AutoDScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+            AutoDScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+            AutoDScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
             // schottky boundary condition of poisson's equation
             AutoDScalar f_psi = V + Work_Function - deltaVB - Ve;
@@ -702,11 +702,14 @@ void SchottkyContactBC::DDM1_Electrode_Trace(Vec lx, SparseMatrix<PetscScalar> *
     AutoDScalar n = xx[fvm_node->local_offset()+1];   n.setADValue(0, 1.0);  // electron density of node
     AutoDScalar p = xx[fvm_node->local_offset()+2];   p.setADValue(1, 1.0);  // hole density of node
 
+    // mapping this node to material library
+    const PMI_Context ctx = semi_region->material()->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+
     //Schottky current
     PetscScalar S  = fvm_node->outside_boundary_surface_area();
-    PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring( node_data->eps(), node_data->E().size() );
-    AutoDScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-    AutoDScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+    PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size() );
+    AutoDScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+    AutoDScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
     VecSetValues( pdI_pdx, index.size(), &index[0], (-Fn*current_scale).getADValue(), ADD_VALUES);
     VecSetValues( pdI_pdx, index.size(), &index[0], (-Fp*current_scale).getADValue(), ADD_VALUES);
@@ -100,10 +100,12 @@ void MetalSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, InsertMode &ad
   const PetscScalar T   = T_external();
   
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -115,31 +117,31 @@ void MetalSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, InsertMode &ad
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       // electrostatic potential, as independent variable
       PetscScalar V1   =  x[n1_local_offset];
       PetscScalar V2   =  x[n2_local_offset];
-      PetscScalar E    = (V2-V1)/fvm_n1->distance(fvm_n2);
+      PetscScalar E    = (V2-V1)/edge_table.length[nedge];
 
       // truncated to positive
-      double S = std::abs(fvm_n1->cv_surface_area(fvm_n2));
+      double S = std::abs(edge_table.cv_area[nedge]);
 
       // "flux" from node 2 to node 1
       PetscScalar f = mt->basic->CurrentDensity(E, T)*S;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
-        iy.push_back(fvm_n1->global_offset());
+        iy.push_back(edge_table.n1_global_offset[nedge]);
         y.push_back(f);
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
-        iy.push_back(fvm_n2->global_offset());
+        iy.push_back(edge_table.n2_global_offset[nedge]);
         y.push_back(-f);
       }
     }
@@ -196,10 +198,12 @@ void MetalSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
 
   const PetscScalar T   = T_external();
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -211,34 +215,138 @@ void MetalSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     // the row/colume position of variables in the matrix
     PetscInt row[2],col[2];
-    row[0] = col[0] = fvm_n1->global_offset();
-    row[1] = col[1] = fvm_n2->global_offset();
+    row[0] = col[0] = edge_table.n1_global_offset[nedge];
+    row[1] = col[1] = edge_table.n2_global_offset[nedge];
 
     // here we use AD, however it is great overkill for such a simple problem.
     {
       // electrostatic potential, as independent variable
       AutoDScalar V1   =  x[n1_local_offset];   V1.setADValue(0,1.0);
       AutoDScalar V2   =  x[n2_local_offset];   V2.setADValue(1,1.0);
-      AutoDScalar E    = (V2-V1)/fvm_n1->distance(fvm_n2);
+      AutoDScalar E    = (V2-V1)/edge_table.length[nedge];
 
       // truncated to positive
-      double S = std::abs(fvm_n1->cv_surface_area(fvm_n2));
+      double S = std::abs(edge_table.cv_area[nedge]);
       AutoDScalar f = mt->basic->CurrentDensity(E, T)*S;
 
       // ignore thoese ghost nodes
 
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
+      {
+        jac->add_row(  row[0],  2,  &col[0],  f.getADValue() );
+      }
+
+      if( edge_table.n2_on_processor[nedge] )
+      {
+        jac->add_row(  row[1],  2,  &col[0],  (-f).getADValue() );
+      }
+    }
+  }
+
+
+  adtl::AutoDScalar::numdir=1;
+  //synchronize with material database
+  mt->set_ad_num(adtl::AutoDScalar::numdir);
+
+
+  double cap = _aux_capacitance/(_total_nodes_in_connected_resistance_region+1);
+  double res = _aux_resistance*(_total_nodes_in_connected_resistance_region+1);
+
+  // process aux cap/res
+  const_processor_node_iterator node_it = on_processor_nodes_begin();
+  const_processor_node_iterator node_it_end = on_processor_nodes_end();
+  for(; node_it!=node_it_end; ++node_it)
+  {
+    const FVM_Node * fvm_node = *node_it;
+    const FVM_NodeData * fvm_node_data = fvm_node->node_data();
+
+    AutoDScalar V   =  x[fvm_node->local_offset()];  V.setADValue(0, 1.0);
+    AutoDScalar current = -cap*(V-fvm_node_data->psi())/SolverSpecify::dt - (V-fvm_node_data->psi())/res;
+
+    jac->add( fvm_node->global_offset(),  fvm_node->global_offset(),  current.getADValue(0) );
+  }
+
+  // boundary condition should be processed later!
+
+  // the last operator is ADD_VALUES
+  add_value_flag = ADD_VALUES;
+
+}
+
+
+
+/*---------------------------------------------------------------------
+ * build function and its jacobian for DDML1 solver in one pass,
+ * the function value is the value part of AD variables
+ */
+void MetalSimulationRegion::DDM1_Function_Jacobian(PetscScalar * x, Vec f, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag)
+{
+
+  // note, we will use ADD_VALUES to set values of vec f
+  // if the previous operator is not ADD_VALUES, we should assembly the vec
+  if( (add_value_flag != ADD_VALUES) && (add_value_flag != NOT_SET_VALUES) )
+  {
+    VecAssemblyBegin(f);
+    VecAssemblyEnd(f);
+  }
+
+  //the indepedent variable number, since we only process edges, 2 is enough
+  adtl::AutoDScalar::numdir=2;
+
+  //synchronize with material database
+  mt->set_ad_num(adtl::AutoDScalar::numdir);
+
+  // set local buf here
+  std::vector<int>          iy;
+  std::vector<PetscScalar>  y;
+
+  iy.reserve(2*n_edge()+n_node());
+  y.reserve(2*n_edge()+n_node());
+
+  const PetscScalar T   = T_external();
+
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
+  // search all the edges of this region, do integral over control volume...
+  for(unsigned int nedge=0; nedge<edge_table.n_edges(); ++nedge)
+  {
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
+
+    // the row/colume position of variables in the matrix
+    PetscInt row[2],col[2];
+    row[0] = col[0] = edge_table.n1_global_offset[nedge];
+    row[1] = col[1] = edge_table.n2_global_offset[nedge];
+
+    {
+      // electrostatic potential, as independent variable
+      AutoDScalar V1   =  x[n1_local_offset];   V1.setADValue(0,1.0);
+      AutoDScalar V2   =  x[n2_local_offset];   V2.setADValue(1,1.0);
+      AutoDScalar E    = (V2-V1)/edge_table.length[nedge];
+
+      // truncated to positive
+      double S = std::abs(edge_table.cv_area[nedge]);
+
+      // "flux" from node 2 to node 1
+      AutoDScalar f = mt->basic->CurrentDensity(E, T)*S;
+
+      // ignore thoese ghost nodes
+      if( edge_table.n1_on_processor[nedge] )
       {
+        iy.push_back(row[0]);
+        y.push_back(f.getValue());
         jac->add_row(  row[0],  2,  &col[0],  f.getADValue() );
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
+        iy.push_back(row[1]);
+        y.push_back(-f.getValue());
         jac->add_row(  row[1],  2,  &col[0],  (-f).getADValue() );
       }
     }
@@ -264,9 +372,14 @@ void MetalSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
     AutoDScalar V   =  x[fvm_node->local_offset()];  V.setADValue(0, 1.0);
     AutoDScalar current = -cap*(V-fvm_node_data->psi())/SolverSpecify::dt - (V-fvm_node_data->psi())/res;
 
+    iy.push_back(fvm_node->global_offset());
+    y.push_back( current.getValue() );
     jac->add( fvm_node->global_offset(),  fvm_node->global_offset(),  current.getADValue(0) );
   }
 
+
+  if(iy.size()) VecSetValues(f, iy.size(), &iy[0], &y[0], ADD_VALUES);
+
   // boundary condition should be processed later!
 
   // the last operator is ADD_VALUES
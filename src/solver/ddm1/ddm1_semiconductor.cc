@@ -26,6 +26,8 @@
 #include "semiconductor_region.h"
 #include "solver_specify.h"
 #include "log.h"
+#include "thread_pool.h"
+#include "fvm_thread_assembly.h"
 
 #include "jflux1.h"
 
@@ -46,22 +48,36 @@ using PhysicalUnit::us;
 
 void SemiconductorSimulationRegion::DDM1_Fill_Value(Vec x, Vec L)
 {
-  std::vector<int> ix;
-  std::vector<PetscScalar> y;
-  std::vector<PetscScalar> s;
+  // data buffer
+  FVM_ThreadFillValue data(3*this->n_node());
 
-  ix.reserve(3*this->n_node());
-  y.reserve(3*this->n_node());
-  s.reserve(3*this->n_node());
+  // for all the on processor node, insert value to petsc vector
+  Genius::MemberThreadLoop<SemiconductorSimulationRegion, FVM_ThreadFillValue>
+      node_loop(this, &SemiconductorSimulationRegion::DDM1_Fill_Value_Node, data);
+  Genius::parallel_for(n_on_processor_node(), node_loop);
 
-  const_processor_node_iterator node_it = on_processor_nodes_begin();
-  const_processor_node_iterator node_it_end = on_processor_nodes_end();
+  // call petsc VecSetValues routine to insert bufferred value, in thread order
+  data.flush(x, L);
+}
+
+
+/*---------------------------------------------------------------------
+ * fill solution data of on processor nodes [begin, end)
+ */
+void SemiconductorSimulationRegion::DDM1_Fill_Value_Node(FVM_ThreadFillValue &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  std::vector<PetscInt>    & ix = data.index(thread);
+  std::vector<PetscScalar> & y  = data.value(thread);
+  std::vector<PetscScalar> & s  = data.scale(thread);
+
+  const_processor_node_iterator node_it = on_processor_nodes_begin() + begin;
+  const_processor_node_iterator node_it_end = on_processor_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
 
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, 0.0);
 
     // the first variable, psi
     ix.push_back(fvm_node->global_offset()+0);
@@ -78,15 +94,45 @@ void SemiconductorSimulationRegion::DDM1_Fill_Value(Vec x, Vec L)
     y.push_back(node_data->p());
     s.push_back(1.0/fvm_node->volume());
   }
-
-  if( ix.size() )
-  {
-    VecSetValues(x, ix.size(), &ix[0], &y[0], INSERT_VALUES) ;
-    VecSetValues(L, ix.size(), &ix[0], &s[0], INSERT_VALUES) ;
-  }
 }
 
 
+/*---------------------------------------------------------------------
+ * data shared by the threads of DDM1_Function
+ */
+struct SemiconductorSimulationRegion::DDM1_Function_Data
+{
+  DDM1_Function_Data(unsigned int n_cell, unsigned int n_node)
+    : flux(3*(24*n_cell)), bbt(0), ii(0), source(3*n_node), node_ii(Genius::n_threads())
+  {}
+
+  /// local solution vector
+  PetscScalar *   x;
+  /// external temperature
+  PetscScalar     T;
+  /// thermal voltage
+  PetscScalar     Vt;
+  /// highfield mobility is used
+  bool            highfield_mob;
+
+  /// precomputed S-G current on each edge
+  std::vector<PetscScalar> Jn_edge_buffer;
+  std::vector<PetscScalar> Jp_edge_buffer;
+
+  /// buffer for flux
+  FVM_ThreadResidual  flux;
+  /// buffer for band band tunneling
+  FVM_ThreadResidual  bbt;
+  /// buffer for impact ionization
+  FVM_ThreadResidual  ii;
+  /// buffer for source item
+  FVM_ThreadResidual  source;
+
+  /// impact ionization generation rate of node, which is added to node data after the cell loop
+  std::vector< std::vector< std::pair<FVM_NodeData *, PetscScalar> > >  node_ii;
+};
+
+
 /*---------------------------------------------------------------------
  * build function and its jacobian for DDML1 solver
  */
@@ -102,39 +148,10 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
   }
 
   // set local buf here
+  DDM1_Function_Data data(this->n_cell(), this->n_node());
 
-  // buffer for flux
-  std::vector<PetscInt>          iflux;
-  std::vector<PetscScalar>       flux;
-  // slightly overkill -- the HEX8 element has 12 edges, each edge has 2 node
-  iflux.reserve(3*(24*this->n_cell()));
-  flux.reserve(3*(24*this->n_cell()));
-
-  // buffer for source item
-  std::vector<PetscInt>          isource;
-  std::vector<PetscScalar>       source;
-  isource.reserve(3*this->n_node());
-  source.reserve(3*this->n_node());
-
-  // buffer for band band tunneling
-  std::vector<PetscInt>          ibbt;
-  std::vector<PetscScalar>       bbt;
-  if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
-  {
-    // slightly overkill -- the HEX8 element has 12 edges, each edge has 2 node
-    ibbt.reserve(3*(24*this->n_cell()));
-    bbt.reserve(3*(24*this->n_cell()));
-  }
-
-  // buffer for impact ionization
-  std::vector<PetscInt>          iii;
-  std::vector<PetscScalar>       ii;
   if (get_advanced_model()->ImpactIonization && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
   {
-    // slightly overkill -- the HEX8 element has 12 edges, each edge has 2 node
-    iii.reserve(3*(24*this->n_cell()));
-    ii.reserve(3*(24*this->n_cell()));
-
     processor_node_iterator node_it = on_processor_nodes_begin();
     processor_node_iterator node_it_end = on_processor_nodes_end();
     for(; node_it!=node_it_end; ++node_it)
@@ -147,111 +164,210 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
   }
 
   //common used variable
-  const PetscScalar T   = T_external();
-  const PetscScalar Vt  = kb*T/e;
-  bool  highfield_mob   = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
+  data.x             = x;
+  data.T             = T_external();
+  data.Vt            = kb*data.T/e;
+  data.highfield_mob = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
 
   // precompute S-G current on each edge
-  std::vector<PetscScalar> Jn_edge_buffer;
-  std::vector<PetscScalar> Jp_edge_buffer;
+  data.Jn_edge_buffer.resize(n_edge());
+  data.Jp_edge_buffer.resize(n_edge());
   {
-    Jn_edge_buffer.reserve(n_edge());
-    Jp_edge_buffer.reserve(n_edge());
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM1_Function_Data>
+        edge_loop(this, &SemiconductorSimulationRegion::DDM1_Function_Edge, data);
+    Genius::parallel_for(n_edge(), edge_loop);
+  }
 
-    // search all the edges of this region
-    const_edge_iterator it = edges_begin();
-    const_edge_iterator it_end = edges_end();
-    for(; it!=it_end; ++it)
-    {
-      // fvm_node of node1
-      const FVM_Node * fvm_n1 = (*it).first;
-      // fvm_node of node2
-      const FVM_Node * fvm_n2 = (*it).second;
+  // then, search all the element in this region and process "cell" related terms
+  // note, they are all local element, thus must be processed
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM1_Function_Data>
+        cell_loop(this, &SemiconductorSimulationRegion::DDM1_Function_Cell, data);
+    Genius::parallel_for(n_cell(), cell_loop);
+  }
 
-      // fvm_node_data of node1
-      const FVM_NodeData * n1_data =  fvm_n1->node_data();
-      // fvm_node_data of node2
-      const FVM_NodeData * n2_data =  fvm_n2->node_data();
+  // impact ionization generation of each node, in thread order
+  for(unsigned int t=0; t<data.node_ii.size(); ++t)
+    for(unsigned int i=0; i<data.node_ii[t].size(); ++i)
+      data.node_ii[t][i].first->ImpactIonization() += data.node_ii[t][i].second;
+
+  // add into petsc vector
+  data.flux.flush(f);
+  data.bbt.flush(f);
+  data.ii.flush(f);
+
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
 
-      const unsigned int n1_local_offset = fvm_n1->local_offset();
-      const unsigned int n2_local_offset = fvm_n2->local_offset();
+  // process node related terms
+  // including \rho of poisson's equation and recombination term of continuation equation
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM1_Function_Data>
+        node_loop(this, &SemiconductorSimulationRegion::DDM1_Function_Node, data);
+    Genius::parallel_for(n_on_processor_node(), node_loop);
+  }
 
-      const double length = fvm_n1->distance(fvm_n2);
+  // add into petsc vector
+  data.source.flush(f);
 
-      // build S-G current along edge
 
-      //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+  // after the first scan, every nodes are updated.
+  // however, boundary condition should be processed later.
 
-      const PetscScalar V1   =  x[n1_local_offset+0];                  // electrostatic potential
-      const PetscScalar n1   =  x[n1_local_offset+1];                  // electron density
-      const PetscScalar p1   =  x[n1_local_offset+2];                  // hole density
+  // the last operator is ADD_VALUES
+  add_value_flag = ADD_VALUES;
 
-      // NOTE: Here Ec1, Ev1 are not the conduction/valence band energy.
-      // They are here for the calculation of effective driving field for electrons and holes
-      // They differ from the conduction/valence band energy by the term with kb*T*log(Nc or Nv), which
-      // takes care of the change effective DOS.
-      // Ec/Ev should not be used except when its difference between two nodes.
-      // The same comment applies to Ec2/Ev2.
-      PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(p1, n1, T) + kb*T*log(n1_data->Nc()));
-      PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(p1, n1, T) - kb*T*log(n1_data->Nv()) + mt->band->Eg(T));
-      if(get_advanced_model()->Fermi)
-      {
-        Ec1 = Ec1 - kb*T*log(gamma_f(fabs(n1)/n1_data->Nc()));
-        Ev1 = Ev1 + kb*T*log(gamma_f(fabs(p1)/n1_data->Nv()));
-      }
-      const PetscScalar eps1 =  n1_data->eps();
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+}
+
+
+/*---------------------------------------------------------------------
+ * S-G current and poisson flux of edges [begin, end)
+ */
+void SemiconductorSimulationRegion::DDM1_Function_Edge(DDM1_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+  const PetscScalar T   = data.T;
+  const PetscScalar Vt  = data.Vt;
 
-      //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+  std::vector<PetscInt>    & iflux = data.flux.index(thread);
+  std::vector<PetscScalar> & flux  = data.flux.value(thread);
 
-      const PetscScalar V2   =  x[n2_local_offset+0];                   // electrostatic potential
-      const PetscScalar n2   =  x[n2_local_offset+1];                   // electron density
-      const PetscScalar p2   =  x[n2_local_offset+2];                   // hole density
+  const FVM_EdgeTable & edge_table = this->edge_table();
 
-      PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(p2, n2, T) + kb*T*log(n2_data->Nc()));
-      PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(p2, n2, T) - kb*T*log(n2_data->Nv()) + mt->band->Eg(T));
-      if(get_advanced_model()->Fermi)
-      {
-        Ec2 = Ec2 - kb*T*log(gamma_f(fabs(n2)/n2_data->Nc()));
-        Ev2 = Ev2 + kb*T*log(gamma_f(fabs(p2)/n2_data->Nv()));
-      }
-      const PetscScalar eps2 =  n2_data->eps();
+  // arguments of S-G current, the current of all the edges is evaluated in batch after the edge loop
+  const unsigned int n_edges = end - begin;
+  std::vector<PetscScalar> dEc(n_edges), dEv(n_edges);
+  std::vector<PetscScalar> en1(n_edges), en2(n_edges), ep1(n_edges), ep2(n_edges);
 
-      // S-G current along the edge
-      Jn_edge_buffer.push_back( In_dd(Vt,(Ec2-Ec1)/e,n1,n2,length) );
-      Jp_edge_buffer.push_back( Ip_dd(Vt,(Ev2-Ev1)/e,p1,p2,length) );
+  // search the edges of this region
+  const_edge_iterator it = edges_begin() + begin;
+  const_edge_iterator it_end = edges_begin() + end;
+  for(unsigned int nedge=begin; it!=it_end; ++it, ++nedge)
+  {
+    // fvm_node of node1
+    const FVM_Node * fvm_n1 = (*it).first;
+    // fvm_node of node2
+    const FVM_Node * fvm_n2 = (*it).second;
+
+    // fvm_node_data of node1
+    const FVM_NodeData * n1_data =  fvm_n1->node_data();
+    // fvm_node_data of node2
+    const FVM_NodeData * n2_data =  fvm_n2->node_data();
+
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
+
+    const double length = edge_table.length[nedge];
+
+    // build S-G current along edge
+
+    //for node 1 of the edge
+    const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+
+    const PetscScalar V1   =  x[n1_local_offset+0];                  // electrostatic potential
+    const PetscScalar n1   =  x[n1_local_offset+1];                  // electron density
+    const PetscScalar p1   =  x[n1_local_offset+2];                  // hole density
+
+    // NOTE: Here Ec1, Ev1 are not the conduction/valence band energy.
+    // They are here for the calculation of effective driving field for electrons and holes
+    // They differ from the conduction/valence band energy by the term with kb*T*log(Nc or Nv), which
+    // takes care of the change effective DOS.
+    // Ec/Ev should not be used except when its difference between two nodes.
+    // The same comment applies to Ec2/Ev2.
+    PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(ctx1, p1, n1, T) + kb*T*log(n1_data->Nc()));
+    PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(ctx1, p1, n1, T) - kb*T*log(n1_data->Nv()) + mt->band->Eg(ctx1, T));
+    if(get_advanced_model()->Fermi)
+    {
+      Ec1 = Ec1 - kb*T*log(gamma_f(fabs(n1)/n1_data->Nc()));
+      Ev1 = Ev1 + kb*T*log(gamma_f(fabs(p1)/n1_data->Nv()));
+    }
+    const PetscScalar eps1 =  n1_data->eps();
 
+    //for node 2 of the edge
+    const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
-      // poisson's equation
+    const PetscScalar V2   =  x[n2_local_offset+0];                   // electrostatic potential
+    const PetscScalar n2   =  x[n2_local_offset+1];                   // electron density
+    const PetscScalar p2   =  x[n2_local_offset+2];                   // hole density
 
-      PetscScalar eps = 0.5*(eps1+eps2);
+    PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(ctx2, p2, n2, T) + kb*T*log(n2_data->Nc()));
+    PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(ctx2, p2, n2, T) - kb*T*log(n2_data->Nv()) + mt->band->Eg(ctx2, T));
+    if(get_advanced_model()->Fermi)
+    {
+      Ec2 = Ec2 - kb*T*log(gamma_f(fabs(n2)/n2_data->Nc()));
+      Ev2 = Ev2 + kb*T*log(gamma_f(fabs(p2)/n2_data->Nv()));
+    }
+    const PetscScalar eps2 =  n2_data->eps();
 
-      // "flux" from node 2 to node 1
-      PetscScalar f =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/fvm_n1->distance(fvm_n2) ;
+    // arguments of S-G current along the edge
+    dEc[nedge-begin] = (Ec2-Ec1)/e;
+    dEv[nedge-begin] = (Ev2-Ev1)/e;
+    en1[nedge-begin] = n1;
+    en2[nedge-begin] = n2;
+    ep1[nedge-begin] = p1;
+    ep2[nedge-begin] = p2;
 
-      // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
-      {
-        iflux.push_back(fvm_n1->global_offset());
-        flux.push_back(f);
-      }
 
-      if( fvm_n2->on_processor() )
-      {
-        iflux.push_back(fvm_n2->global_offset());
-        flux.push_back(-f);
-      }
+    // poisson's equation
+
+    PetscScalar eps = 0.5*(eps1+eps2);
+
+    // "flux" from node 2 to node 1
+    PetscScalar f =  eps*edge_table.cv_area[nedge]*(V2 - V1)/length ;
+
+    // ignore thoese ghost nodes
+    if( edge_table.n1_on_processor[nedge] )
+    {
+      iflux.push_back(edge_table.n1_global_offset[nedge]);
+      flux.push_back(f);
+    }
+
+    if( edge_table.n2_on_processor[nedge] )
+    {
+      iflux.push_back(edge_table.n2_global_offset[nedge]);
+      flux.push_back(-f);
     }
   }
 
-  // then, search all the element in this region and process "cell" related terms
-  // note, they are all local element, thus must be processed
+  // S-G current along the edges
+  if( n_edges )
+  {
+    In_dd_batch(Vt, n_edges, &dEc[0], &en1[0], &en2[0], &edge_table.length[begin], &data.Jn_edge_buffer[begin]);
+    Ip_dd_batch(Vt, n_edges, &dEv[0], &ep1[0], &ep2[0], &edge_table.length[begin], &data.Jp_edge_buffer[begin]);
+  }
+}
 
 
-  const_element_iterator it = elements_begin();
-  const_element_iterator it_end = elements_end();
-  for(unsigned int nelem=0 ; it!=it_end; ++it, ++nelem)
+/*---------------------------------------------------------------------
+ * "cell" related terms of elements [begin, end)
+ */
+void SemiconductorSimulationRegion::DDM1_Function_Cell(DDM1_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+  const PetscScalar T   = data.T;
+  const PetscScalar Vt  = data.Vt;
+  const bool  highfield_mob = data.highfield_mob;
+
+  const std::vector<PetscScalar> & Jn_edge_buffer = data.Jn_edge_buffer;
+  const std::vector<PetscScalar> & Jp_edge_buffer = data.Jp_edge_buffer;
+
+  std::vector<PetscInt>    & iflux = data.flux.index(thread);
+  std::vector<PetscScalar> & flux  = data.flux.value(thread);
+  std::vector<PetscInt>    & ibbt  = data.bbt.index(thread);
+  std::vector<PetscScalar> & bbt   = data.bbt.value(thread);
+  std::vector<PetscInt>    & iii   = data.ii.index(thread);
+  std::vector<PetscScalar> & ii    = data.ii.value(thread);
+  std::vector< std::pair<FVM_NodeData *, PetscScalar> > & node_ii = data.node_ii[thread];
+
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
+  const_element_iterator it = elements_begin() + begin;
+  const_element_iterator it_end = elements_begin() + end;
+  for(unsigned int nelem=begin ; it!=it_end; ++it, ++nelem)
   {
     const Elem * elem = *it;
 
@@ -352,10 +468,10 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
         // stupid code... we can not dot point with VectorValue<PetscScalar> yet.
         VectorValue<PetscScalar> norm(_norm(0), _norm(1), _norm(2));
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         PetscScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         PetscScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -411,34 +527,37 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
       std::pair<unsigned int, unsigned int> edge_nodes;
       elem->nodes_on_edge(ne, edge_nodes);
 
-      const unsigned int edge_index = this->elem_edge_index(elem, ne);
+      const unsigned int slot = edge_table.elem_slot(nelem, ne);
+      const unsigned int edge_index = edge_table.elem_edge[slot];
 
-      const double length = elem->edge_length(ne);                         // the length of this edge
+      const double length = edge_table.length[edge_index];                  // the length of this edge
 
       FVM_Node * fvm_n1 = elem->get_fvm_node(edge_nodes.first);   // fvm_node of node1
       FVM_Node * fvm_n2 = elem->get_fvm_node(edge_nodes.second);  // fvm_node of node2
 
-      double partial_area = elem->partial_area_with_edge(ne);        // partial area associated with this edge
-      double partial_volume = elem->partial_volume_with_edge(ne);    // partial volume associated with this edge
+      double partial_area = edge_table.partial_area[slot];        // partial area associated with this edge
+      double partial_volume = edge_table.partial_volume[slot];    // partial volume associated with this edge
       double truncated_partial_area =  partial_area;
       double truncated_partial_volume =  partial_volume;
       if(truncation)
       {
         // use truncated partial area to avoid negative area due to bad mesh elem
-        truncated_partial_area =  this->truncated_partial_area(elem, ne);
-        truncated_partial_volume =  elem->partial_volume_with_edge_truncated(ne);
+        truncated_partial_area =  edge_table.truncated_partial_area[slot];
+        truncated_partial_volume =  edge_table.truncated_partial_volume[slot];
       }
 
 
-      bool inverse = fvm_n1->root_node()->id() > fvm_n2->root_node()->id();
+      bool inverse = edge_table.elem_edge_inverse[slot];
 
       FVM_NodeData * n1_data = fvm_n1->node_data();            // fvm_node_data of node1
       FVM_NodeData * n2_data = fvm_n2->node_data();            // fvm_node_data of node2
 
-      const unsigned int n1_local_offset  = fvm_n1->local_offset();
-      const unsigned int n2_local_offset  = fvm_n2->local_offset();
-      const unsigned int n1_global_offset = fvm_n1->global_offset();
-      const unsigned int n2_global_offset = fvm_n2->global_offset();
+      const unsigned int n1_local_offset  = inverse ? edge_table.n2_local_offset[edge_index] : edge_table.n1_local_offset[edge_index];
+      const unsigned int n2_local_offset  = inverse ? edge_table.n1_local_offset[edge_index] : edge_table.n2_local_offset[edge_index];
+      const unsigned int n1_global_offset = inverse ? edge_table.n2_global_offset[edge_index] : edge_table.n1_global_offset[edge_index];
+      const unsigned int n2_global_offset = inverse ? edge_table.n1_global_offset[edge_index] : edge_table.n2_global_offset[edge_index];
+      const bool n1_on_processor = inverse ? edge_table.n2_on_processor[edge_index] : edge_table.n1_on_processor[edge_index];
+      const bool n2_on_processor = inverse ? edge_table.n1_on_processor[edge_index] : edge_table.n2_on_processor[edge_index];
 
       // build governing equation of DDML1
       {
@@ -447,11 +566,13 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
         const PetscScalar V1   =  x[n1_local_offset+0];                  // electrostatic potential
         const PetscScalar n1   =  x[n1_local_offset+1];                  // electron density
         const PetscScalar p1   =  x[n1_local_offset+2];                  // hole density
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         //for node 2 of the edge
         const PetscScalar V2   =  x[n2_local_offset+0];                   // electrostatic potential
         const PetscScalar n2   =  x[n2_local_offset+1];                   // electron density
         const PetscScalar p2   =  x[n2_local_offset+2];                   // hole density
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         PetscScalar mun1;  // electron mobility
         PetscScalar mup1;  // hole mobility
@@ -462,13 +583,11 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
         {
           if(get_advanced_model()->ESurface && insulator_interface_elem)
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Etn, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Etp, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Etn, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Etp, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Etn, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Etp, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Etn, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Etp, T);
           }
           else
           {
@@ -487,35 +606,29 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
                 Et = (E - dir*(E*dir)).size();
               }
 
-              mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-              mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Et, T);
-              mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Et, T);
+              mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Et, T);
+              mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Et, T);
 
-              mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-              mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Et, T);
-              mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Et, T);
+              mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Et, T);
+              mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Et, T);
             }
             else// ModelSpecify::EJ || ModelSpecify::EQF
             {
-              mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-              mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Etn, T);
-              mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Etp, T);
+              mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Etn, T);
+              mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Etp, T);
 
-              mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-              mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Etn, T);
-              mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Etp, T);
+              mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Etn, T);
+              mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Etp, T);
             }
           }
         }
         else // low field mobility
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T, 0, 0, T);
-          mup1 = mt->mob->HoleMob(p1, n1, T, 0, 0, T);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, 0, 0, T);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, 0, 0, T);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T, 0, 0, T);
-          mup2 = mt->mob->HoleMob(p2, n2, T, 0, 0, T);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, 0, 0, T);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, 0, 0, T);
         }
 
 
@@ -533,7 +646,7 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
 
 
         // ignore thoese ghost nodes (ghost nodes is local but with different processor_id())
-        if( fvm_n1->on_processor() )
+        if( n1_on_processor )
         {
           // poisson's equation
           //iflux.push_back( n1_global_offset );
@@ -549,7 +662,7 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
         }
 
         // for node 2.
-        if( fvm_n2->on_processor() )
+        if( n2_on_processor )
         {
           // poisson's equation
           //iflux.push_back( n2_global_offset );
@@ -567,10 +680,10 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
 
-          PetscScalar GBTBT1 = mt->band->BB_Tunneling(T, E.size());
-          PetscScalar GBTBT2 = mt->band->BB_Tunneling(T, E.size());
+          PetscScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T, E.size());
+          PetscScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T, E.size());
 
-          if( fvm_n1->on_processor() )
+          if( n1_on_processor )
           {
             // continuity equation
             ibbt.push_back( n1_global_offset + 1);
@@ -580,7 +693,7 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
             bbt.push_back ( 0.5*GBTBT1*truncated_partial_volume );
           }
 
-          if( fvm_n2->on_processor() )
+          if( n2_on_processor )
           {
             // continuity equation
             ibbt.push_back( n2_global_offset + 1);
@@ -609,20 +722,20 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
               case ModelSpecify::IIForce_EdotJ:
               Epn = std::max(E.dot(Jnv.unit(true)), 0.0);
               Epp = std::max(E.dot(Jpv.unit(true)), 0.0);
-              IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-              IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
               break;
               case ModelSpecify::EVector:
-              IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
               break;
               case ModelSpecify::ESide:
-              IIn = mt->gen->ElecGenRate(T,fabs((V2-V1)/length),Eg);
-              IIp = mt->gen->HoleGenRate(T,fabs((V2-V1)/length),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,fabs((V2-V1)/length),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,fabs((V2-V1)/length),Eg);
               break;
               case ModelSpecify::GradQf:
-              IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
               break;
               default:
               {
@@ -633,7 +746,7 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
           GIIn = IIn * fabs(Jn)/e;
           GIIp = IIp * fabs(Jp)/e;
 
-          if( fvm_n1->on_processor() )
+          if( n1_on_processor )
           {
             // continuity equation
             iii.push_back( n1_global_offset + 1);
@@ -642,10 +755,10 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
             iii.push_back( n1_global_offset + 2);
             ii.push_back ( (riin1*GIIn+riip1*GIIp)*truncated_partial_volume );
 
-            n1_data->ImpactIonization() += (riin1*GIIn+riip1*GIIp)*truncated_partial_volume/fvm_n1->volume();
+            node_ii.push_back( std::make_pair(n1_data, (riin1*GIIn+riip1*GIIp)*truncated_partial_volume/fvm_n1->volume()) );
           }
 
-          if( fvm_n2->on_processor() )
+          if( n2_on_processor )
           {
             // continuity equation
             iii.push_back( n2_global_offset + 1);
@@ -654,7 +767,7 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
             iii.push_back( n2_global_offset + 2);
             ii.push_back ( (riin2*GIIn+riip2*GIIp)*truncated_partial_volume );
 
-            n2_data->ImpactIonization() += (riin2*GIIn+riip2*GIIp)*truncated_partial_volume/fvm_n2->volume();
+            node_ii.push_back( std::make_pair(n2_data, (riin2*GIIn+riip2*GIIp)*truncated_partial_volume/fvm_n2->volume()) );
           }
         }
       }
@@ -664,20 +777,22 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
     elem_data->Jp() =  elem->reconstruct_vector(Jp_edge_cell);
 
   }
+}
 
-  // add into petsc vector, we should prevent zero length vector add here.
-  if(iflux.size())    VecSetValues(f, iflux.size(), &iflux[0], &flux[0], ADD_VALUES);
-  if(ibbt.size())     VecSetValues(f, ibbt.size(), &ibbt[0], &bbt[0], ADD_VALUES);
-  if(iii.size())      VecSetValues(f, iii.size(), &iii[0], &ii[0], ADD_VALUES);
 
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
+/*---------------------------------------------------------------------
+ * node related terms of on processor nodes [begin, end)
+ */
+void SemiconductorSimulationRegion::DDM1_Function_Node(DDM1_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+  const PetscScalar T   = data.T;
 
-  // process node related terms
-  // including \rho of poisson's equation and recombination term of continuation equation
-  const_processor_node_iterator node_it = on_processor_nodes_begin();
-  const_processor_node_iterator node_it_end = on_processor_nodes_end();
+  std::vector<PetscInt>    & isource = data.source.index(thread);
+  std::vector<PetscScalar> & source  = data.source.value(thread);
+
+  const_processor_node_iterator node_it = on_processor_nodes_begin() + begin;
+  const_processor_node_iterator node_it_end = on_processor_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     const FVM_Node * fvm_node = *node_it;
@@ -690,13 +805,13 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
     PetscScalar n   =  x[local_offset+1];                         // electron density
     PetscScalar p   =  x[local_offset+2];                         // hole density
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
 
-    PetscScalar R   = - mt->band->Recomb(p, n, T)*fvm_node->volume();         // the recombination term
+    PetscScalar R   = - mt->band->Recomb(ctx, p, n, T)*fvm_node->volume();         // the recombination term
 
     PetscScalar doping = node_data->Net_doping();
     if(get_advanced_model()->IncompleteIonization)
-      doping = mt->band->Nd_II(n, T, get_advanced_model()->Fermi) - mt->band->Na_II(p, T, get_advanced_model()->Fermi);
+      doping = mt->band->Nd_II(ctx, n, T, get_advanced_model()->Fermi) - mt->band->Na_II(ctx, p, T, get_advanced_model()->Fermi);
     PetscScalar rho = e*( doping + p - n)*fvm_node->volume(); // the charge density
 
 
@@ -716,11 +831,11 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
       // consider charge trapping in semiconductor bulk (bulk_flag=true)
 
       // call the Trap MPI to calculate trap occupancy using the local carrier densities and lattice temperature
-      PetscScalar ni = mt->band->nie(p, n, T);
-      mt->trap->Calculate(true,p,n,ni,T);
+      PetscScalar ni = mt->band->nie(ctx, p, n, T);
+      mt->trap->Calculate(ctx, true,p,n,ni,T);
 
       // calculate the contribution of trapped charge to Poisson's equation
-      PetscScalar TrappedC = mt->trap->Charge(true) * fvm_node->volume();
+      PetscScalar TrappedC = mt->trap->Charge(ctx, true) * fvm_node->volume();
       if (TrappedC !=0)
       {
         isource.push_back(fvm_node->global_offset());
@@ -728,8 +843,8 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
       }
 
       // calculate the rates of electron and hole capture
-      PetscScalar TrapElec = mt->trap->ElectronTrapRate(true,n,ni,T) * fvm_node->volume();
-      PetscScalar TrapHole = mt->trap->HoleTrapRate    (true,p,ni,T) * fvm_node->volume();
+      PetscScalar TrapElec = mt->trap->ElectronTrapRate(ctx, true,n,ni,T) * fvm_node->volume();
+      PetscScalar TrapHole = mt->trap->HoleTrapRate    (ctx, true,p,ni,T) * fvm_node->volume();
       // contribution to the contribution to continuity equations
       if (TrapElec != 0)
       {
@@ -744,14 +859,64 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
       }
     }
   }
+}
 
 
-  // add into petsc vector, we should prevent zero length vector add here.
-  if(isource.size())  VecSetValues(f, isource.size(), &isource[0], &source[0], ADD_VALUES);
 
 
-  // after the first scan, every nodes are updated.
-  // however, boundary condition should be processed later.
+
+
+/*---------------------------------------------------------------------
+ * data shared by the threads of DDM1_Jacobian
+ */
+struct SemiconductorSimulationRegion::DDM1_Jacobian_Data
+{
+  DDM1_Jacobian_Data(SparseMatrix<PetscScalar> *jac, bool fused=false, unsigned int n_cell=0, unsigned int n_node=0)
+    : fused(fused), jac(jac),
+      flux(fused ? 3*(24*n_cell) : 0), bbt(0), ii(0), source(fused ? 3*n_node : 0), node_ii(Genius::n_threads())
+  {}
+
+  /// function value is also collected, see DDM1_Function_Jacobian
+  bool            fused;
+
+  /// local solution vector
+  PetscScalar *   x;
+  /// external temperature
+  PetscScalar     T;
+  /// thermal voltage
+  PetscScalar     Vt;
+  /// highfield mobility is used
+  bool            highfield_mob;
+
+  /// precomputed S-G current on each edge, with respect to the 6 variables of edge nodes
+  std::vector< FixedDScalar<6> > Jn_edge_buffer;
+  std::vector< FixedDScalar<6> > Jp_edge_buffer;
+
+  /// jacobian matrix of each thread
+  FVM_ThreadJacobian  jac;
+
+  /// buffers of function value, the same as DDM1_Function_Data, only used in fused mode
+  FVM_ThreadResidual  flux;
+  FVM_ThreadResidual  bbt;
+  FVM_ThreadResidual  ii;
+  FVM_ThreadResidual  source;
+  std::vector< std::vector< std::pair<FVM_NodeData *, PetscScalar> > >  node_ii;
+};
+
+
+/*---------------------------------------------------------------------
+ * build function and its jacobian for DDML1 solver
+ * AD is fully used here
+ */
+void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag)
+{
+
+  DDM1_Jacobian_Data data(jac);
+  data.x = x;
+
+  DDM1_Jacobian_Assemble(data);
+
+  // boundary condition should be processed later!
 
   // the last operator is ADD_VALUES
   add_value_flag = ADD_VALUES;
@@ -759,134 +924,285 @@ void SemiconductorSimulationRegion::DDM1_Function(PetscScalar * x, Vec f, Insert
 #if defined(HAVE_FENV_H) && defined(DEBUG)
   genius_assert( !fetestexcept(FE_INVALID) );
 #endif
+
 }
 
 
+/*---------------------------------------------------------------------
+ * build function and jacobian for DDML1 solver together.
+ * the function value is the value part of AD variables of jacobian kernels,
+ * thus physical models are only evaluated once
+ */
+void SemiconductorSimulationRegion::DDM1_Function_Jacobian(PetscScalar * x, Vec f, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag)
+{
+  // note, we will use ADD_VALUES to set values of vec f
+  // if the previous operator is not ADD_VALUES, we should assembly the vec first!
+  if( (add_value_flag != ADD_VALUES) && (add_value_flag != NOT_SET_VALUES) )
+  {
+    VecAssemblyBegin(f);
+    VecAssemblyEnd(f);
+  }
+
+  DDM1_Jacobian_Data data(jac, true, this->n_cell(), this->n_node());
+  data.x = x;
+
+  if (get_advanced_model()->ImpactIonization && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
+  {
+    processor_node_iterator node_it = on_processor_nodes_begin();
+    processor_node_iterator node_it_end = on_processor_nodes_end();
+    for(; node_it!=node_it_end; ++node_it)
+      (*node_it)->node_data()->ImpactIonization() = 0.0;
+  }
 
+  DDM1_Jacobian_Assemble(data);
+
+  // impact ionization generation of each node, in thread order
+  for(unsigned int t=0; t<data.node_ii.size(); ++t)
+    for(unsigned int i=0; i<data.node_ii[t].size(); ++i)
+      data.node_ii[t][i].first->ImpactIonization() += data.node_ii[t][i].second;
+
+  // add into petsc vector, in the same order as DDM1_Function
+  data.flux.flush(f);
+  data.bbt.flush(f);
+  data.ii.flush(f);
+  data.source.flush(f);
+
+  // the last operator is ADD_VALUES
+  add_value_flag = ADD_VALUES;
 
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+}
 
 
 /*---------------------------------------------------------------------
- * build function and its jacobian for DDML1 solver
- * AD is fully used here
+ * edge, cell and node loops of DDM1 jacobian
  */
-void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag)
+void SemiconductorSimulationRegion::DDM1_Jacobian_Assemble(DDM1_Jacobian_Data &data)
 {
-
   //common used variable
-  const PetscScalar T   = T_external();
-  const PetscScalar Vt  = kb*T/e;
-  bool  highfield_mob   = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
+  data.T             = T_external();
+  data.Vt            = kb*data.T/e;
+  data.highfield_mob = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
+
+  // jacobian slots are looked up in the threads, drop them if the nonzero pattern changed
+  _ddm1_edge_slots.sync(data.jac.matrix(), n_edge());
+  _ddm1_cell_slots.sync(data.jac.matrix(), n_cell());
+  _ddm1_node_slots.sync(data.jac.matrix(), n_on_processor_node());
 
   // precompute S-G current on each edge
-  std::vector<AutoDScalar> Jn_edge_buffer;
-  std::vector<AutoDScalar> Jp_edge_buffer;
+  data.Jn_edge_buffer.resize(n_edge());
+  data.Jp_edge_buffer.resize(n_edge());
   {
-    Jn_edge_buffer.reserve(n_edge());
-    Jp_edge_buffer.reserve(n_edge());
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM1_Jacobian_Data>
+        edge_loop(this, &SemiconductorSimulationRegion::DDM1_Jacobian_Edge, data);
+    Genius::parallel_for(n_edge(), edge_loop);
+  }
 
-    //the indepedent variable number, 2 nodes * 3 variables per edge
-    adtl::AutoDScalar::numdir = 6;
+  // search all the element in this region.
+  // note, they are all local element, thus must be processed
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM1_Jacobian_Data>
+        cell_loop(this, &SemiconductorSimulationRegion::DDM1_Jacobian_Cell, data);
+    Genius::parallel_for(n_cell(), cell_loop);
+  }
 
-    //synchronize with material database
-    mt->set_ad_num(adtl::AutoDScalar::numdir);
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
 
-    // search all the edges of this region
-    const_edge_iterator it = edges_begin();
-    const_edge_iterator it_end = edges_end();
-    for(; it!=it_end; ++it)
-    {
-      // fvm_node of node1
-      const FVM_Node * fvm_n1 = (*it).first;
-      // fvm_node of node2
-      const FVM_Node * fvm_n2 = (*it).second;
+  // process node related terms
+  // including \rho of poisson's equation and recombination term of continuation equation
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM1_Jacobian_Data>
+        node_loop(this, &SemiconductorSimulationRegion::DDM1_Jacobian_Node, data);
+    Genius::parallel_for(n_on_processor_node(), node_loop);
+  }
 
-      // fvm_node_data of node1
-      const FVM_NodeData * n1_data =  fvm_n1->node_data();
-      // fvm_node_data of node2
-      const FVM_NodeData * n2_data =  fvm_n2->node_data();
+  // write thread buffers into jacobian matrix
+  data.jac.flush();
+}
 
-      const unsigned int n1_local_offset = fvm_n1->local_offset();
-      const unsigned int n2_local_offset = fvm_n2->local_offset();
 
-      const double length = fvm_n1->distance(fvm_n2);
+/*---------------------------------------------------------------------
+ * S-G current and poisson flux of edges [begin, end), AD version
+ */
+void SemiconductorSimulationRegion::DDM1_Jacobian_Edge(DDM1_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+  const PetscScalar T   = data.T;
+  const PetscScalar Vt  = data.Vt;
+  SparseMatrix<PetscScalar> * jac = data.jac[thread];
 
-      // build S-G current along edge
+  // the edge kernel has 2 nodes * 3 variables, which is done by FixedDScalar<6>.
+  // AutoDScalar is only used for material functions of each node, 3 variables per node
+  adtl::AutoDScalar::numdir = 3;
 
+  //synchronize with material database
+  mt->set_ad_num(adtl::AutoDScalar::numdir);
 
-      //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+  const FVM_EdgeTable & edge_table = this->edge_table();
 
-      AutoDScalar V1   =  x[n1_local_offset+0];   V1.setADValue(0, 1.0);               // electrostatic potential
-      AutoDScalar n1   =  x[n1_local_offset+1];   n1.setADValue(1, 1.0);               // electron density
-      AutoDScalar p1   =  x[n1_local_offset+2];   p1.setADValue(2, 1.0);               // hole density
+  // arguments of S-G current, the current is evaluated in batch for every chunk of edges
+  const unsigned int chunk = 64;
+  FixedDScalar<6> dEc[chunk], dEv[chunk], cn1[chunk], cn2[chunk], cp1[chunk], cp2[chunk];
+  unsigned int n_chunk = 0;
 
-      // NOTE: Here Ec1, Ev1 are not the conduction/valence band energy.
-      // They are here for the calculation of effective driving field for electrons and holes
-      // They differ from the conduction/valence band energy by the term with kb*T*log(Nc or Nv), which
-      // takes care of the change effective DOS.
-      // Ec/Ev should not be used except when its difference between two nodes.
-      // The same comment applies to Ec2/Ev2.
-      AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(p1, n1, T) + kb*T*log(n1_data->Nc()));
-      AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(p1, n1, T) - kb*T*log(n1_data->Nv()) + mt->band->Eg(T));
-      if(get_advanced_model()->Fermi)
-      {
-        Ec1 = Ec1 - kb*T*log(gamma_f(fabs(n1)/n1_data->Nc()));
-        Ev1 = Ev1 + kb*T*log(gamma_f(fabs(p1)/n1_data->Nv()));
-      }
-      const PetscScalar eps1 =  n1_data->eps();
+  // search the edges of this region
+  const_edge_iterator it = edges_begin() + begin;
+  const_edge_iterator it_end = edges_begin() + end;
+  for(unsigned int nedge=begin; it!=it_end; ++it, ++nedge)
+  {
+    // fvm_node of node1
+    const FVM_Node * fvm_n1 = (*it).first;
+    // fvm_node of node2
+    const FVM_Node * fvm_n2 = (*it).second;
 
-      //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+    // fvm_node_data of node1
+    const FVM_NodeData * n1_data =  fvm_n1->node_data();
+    // fvm_node_data of node2
+    const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-      AutoDScalar V2   =  x[n2_local_offset+0];   V2.setADValue(3, 1.0);                // electrostatic potential
-      AutoDScalar n2   =  x[n2_local_offset+1];   n2.setADValue(4, 1.0);                // electron density
-      AutoDScalar p2   =  x[n2_local_offset+2];   p2.setADValue(5, 1.0);                // hole density
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
+
+    const double length = edge_table.length[nedge];
+
+    // build S-G current along edge
 
-      AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(p2, n2, T) + kb*T*log(n2_data->Nc()));
-      AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(p2, n2, T) - kb*T*log(n2_data->Nv()) + mt->band->Eg(T));
-      if(get_advanced_model()->Fermi)
-      {
-        Ec2 = Ec2 - kb*T*log(gamma_f(fabs(n2)/n2_data->Nc()));
-        Ev2 = Ev2 + kb*T*log(gamma_f(fabs(p2)/n2_data->Nv()));
-      }
-      const PetscScalar eps2 =  n2_data->eps();
 
-      // S-G current along the edge
-      Jn_edge_buffer.push_back( In_dd(Vt,(Ec2-Ec1)/e,n1,n2,length) );
-      Jp_edge_buffer.push_back( Ip_dd(Vt,(Ev2-Ev1)/e,p1,p2,length) );
+    //for node 1 of the edge
+    const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
-      // poisson's equation
+    AutoDScalar V1   =  x[n1_local_offset+0];   V1.setADValue(0, 1.0);               // electrostatic potential
+    AutoDScalar n1   =  x[n1_local_offset+1];   n1.setADValue(1, 1.0);               // electron density
+    AutoDScalar p1   =  x[n1_local_offset+2];   p1.setADValue(2, 1.0);               // hole density
 
-      const PetscScalar eps = 0.5*(eps1+eps2);
-      AutoDScalar f_phi =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/length ;
+    // NOTE: Here Ec1, Ev1 are not the conduction/valence band energy.
+    // They are here for the calculation of effective driving field for electrons and holes
+    // They differ from the conduction/valence band energy by the term with kb*T*log(Nc or Nv), which
+    // takes care of the change effective DOS.
+    // Ec/Ev should not be used except when its difference between two nodes.
+    // The same comment applies to Ec2/Ev2.
+    AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(ctx1, p1, n1, T) + kb*T*log(n1_data->Nc()));
+    AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(ctx1, p1, n1, T) - kb*T*log(n1_data->Nv()) + mt->band->Eg(ctx1, T));
+    if(get_advanced_model()->Fermi)
+    {
+      Ec1 = Ec1 - kb*T*log(gamma_f(fabs(n1)/n1_data->Nc()));
+      Ev1 = Ev1 + kb*T*log(gamma_f(fabs(p1)/n1_data->Nv()));
+    }
+    const PetscScalar eps1 =  n1_data->eps();
+
+    //for node 2 of the edge
+    const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+
+    AutoDScalar V2   =  x[n2_local_offset+0];   V2.setADValue(0, 1.0);                // electrostatic potential
+    AutoDScalar n2   =  x[n2_local_offset+1];   n2.setADValue(1, 1.0);                // electron density
+    AutoDScalar p2   =  x[n2_local_offset+2];   p2.setADValue(2, 1.0);                // hole density
+
+    AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(ctx2, p2, n2, T) + kb*T*log(n2_data->Nc()));
+    AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(ctx2, p2, n2, T) - kb*T*log(n2_data->Nv()) + mt->band->Eg(ctx2, T));
+    if(get_advanced_model()->Fermi)
+    {
+      Ec2 = Ec2 - kb*T*log(gamma_f(fabs(n2)/n2_data->Nc()));
+      Ev2 = Ev2 + kb*T*log(gamma_f(fabs(p2)/n2_data->Nv()));
+    }
+    const PetscScalar eps2 =  n2_data->eps();
+
+    // lift the node variables to the edge kernel, node 1 at directions 0-2 and node 2 at directions 3-5
+    const FixedDScalar<6> fV1(V1, 0, 3),   fV2(V2, 3, 3);
+    const FixedDScalar<6> fn1(n1, 0, 3),   fn2(n2, 3, 3);
+    const FixedDScalar<6> fp1(p1, 0, 3),   fp2(p2, 3, 3);
+    const FixedDScalar<6> fEc1(Ec1, 0, 3), fEc2(Ec2, 3, 3);
+    const FixedDScalar<6> fEv1(Ev1, 0, 3), fEv2(Ev2, 3, 3);
+
+    // S-G current along the edge
+    dEc[n_chunk] = (fEc2-fEc1)/e;
+    dEv[n_chunk] = (fEv2-fEv1)/e;
+    cn1[n_chunk] = fn1;
+    cn2[n_chunk] = fn2;
+    cp1[n_chunk] = fp1;
+    cp2[n_chunk] = fp2;
+    if( ++n_chunk == chunk || nedge+1 == end )
+    {
+      const unsigned int first = nedge+1-n_chunk;
+      In_dd_batch(Vt, n_chunk, dEc, cn1, cn2, &edge_table.length[first], &data.Jn_edge_buffer[first]);
+      Ip_dd_batch(Vt, n_chunk, dEv, cp1, cp2, &edge_table.length[first], &data.Jp_edge_buffer[first]);
+      n_chunk = 0;
+    }
 
-      PetscInt row[2],col[2];
-      row[0] = col[0] = fvm_n1->global_offset();
-      row[1] = col[1] = fvm_n2->global_offset();
+    // poisson's equation
 
-      // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+    const PetscScalar eps = 0.5*(eps1+eps2);
+    FixedDScalar<6> f_phi =  eps*edge_table.cv_area[nedge]*(fV2 - fV1)/length ;
+
+    PetscInt row[2],col[2];
+    row[0] = col[0] = edge_table.n1_global_offset[nedge];
+    row[1] = col[1] = edge_table.n2_global_offset[nedge];
+
+    // slots of the 2x2 block in jacobian matrix
+    const int * slots = _ddm1_edge_slots.slots(data.jac.matrix(), nedge, 2, row, 2, col);
+
+    // ignore thoese ghost nodes
+    if( edge_table.n1_on_processor[nedge] )
+    {
+      PetscScalar J[2] = { f_phi.getADValue(0), f_phi.getADValue(3) };
+      jac->add_row( row[0],  2,  col,  slots ? slots+0 : 0,  J );
+    }
+
+    if( edge_table.n2_on_processor[nedge] )
+    {
+      PetscScalar J[2] = { -f_phi.getADValue(0), -f_phi.getADValue(3) };
+      jac->add_row( row[1],  2,  col,  slots ? slots+2 : 0,  J );
+    }
+
+    if( data.fused )
+    {
+      if( edge_table.n1_on_processor[nedge] )
       {
-        jac->add( row[0],  col[0],  f_phi.getADValue(0) );
-        jac->add( row[0],  col[1],  f_phi.getADValue(3) );
+        data.flux.index(thread).push_back(row[0]);
+        data.flux.value(thread).push_back(f_phi.getValue());
       }
-
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
-        jac->add( row[1],  col[0],  -f_phi.getADValue(0) );
-        jac->add( row[1],  col[1],  -f_phi.getADValue(3) );
+        data.flux.index(thread).push_back(row[1]);
+        data.flux.value(thread).push_back(-f_phi.getValue());
       }
-
     }
   }
+}
 
-  // search all the element in this region.
-  // note, they are all local element, thus must be processed
 
-  const_element_iterator it = elements_begin();
-  const_element_iterator it_end = elements_end();
-  for(; it!=it_end; ++it)
+/*---------------------------------------------------------------------
+ * "cell" related terms of elements [begin, end), AD version
+ */
+void SemiconductorSimulationRegion::DDM1_Jacobian_Cell(DDM1_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+  const PetscScalar T   = data.T;
+  const PetscScalar Vt  = data.Vt;
+  const bool  highfield_mob = data.highfield_mob;
+  SparseMatrix<PetscScalar> * jac = data.jac[thread];
+
+  const std::vector< FixedDScalar<6> > & Jn_edge_buffer = data.Jn_edge_buffer;
+  const std::vector< FixedDScalar<6> > & Jp_edge_buffer = data.Jp_edge_buffer;
+
+  // function value buffers, only used in fused mode
+  const bool fused = data.fused;
+  std::vector<PetscInt>    & iflux = data.flux.index(thread);
+  std::vector<PetscScalar> & flux  = data.flux.value(thread);
+  std::vector<PetscInt>    & ibbt  = data.bbt.index(thread);
+  std::vector<PetscScalar> & bbt   = data.bbt.value(thread);
+  std::vector<PetscInt>    & iii   = data.ii.index(thread);
+  std::vector<PetscScalar> & ii    = data.ii.value(thread);
+  std::vector< std::pair<FVM_NodeData *, PetscScalar> > & node_ii = data.node_ii[thread];
+
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
+  const_element_iterator it = elements_begin() + begin;
+  const_element_iterator it_end = elements_begin() + end;
+  for(unsigned int nelem=begin; it!=it_end; ++it, ++nelem)
   {
     const Elem * elem = *it;
     bool insulator_interface_elem = is_elem_on_insulator_interface(elem);
@@ -914,6 +1230,9 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
     }
 
 
+    std::vector<PetscScalar> Jn_edge_cell; //store all the edge Jn, fused mode only
+    std::vector<PetscScalar> Jp_edge_cell; //store all the edge Jp, fused mode only
+
     // first, we build the gradient of psi and fermi potential in this cell.
     VectorValue<AutoDScalar> E;
     VectorValue<AutoDScalar> Jnv;
@@ -1019,10 +1338,10 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
         VectorValue<AutoDScalar> norm(_norm(0), _norm(1), _norm(2));
 
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         AutoDScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         AutoDScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -1071,6 +1390,10 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
     }
 
 
+    // slots of the cell block in jacobian matrix, rows are the variables of cell nodes
+    const unsigned int n_cell_col = cell_col.size();
+    const int * cell_slots = _ddm1_cell_slots.slots(data.jac.matrix(), nelem, 3*elem->n_nodes(), &cell_col[0], n_cell_col, &cell_col[0]);
+
     // process conservation terms: laplace operator of poisson's equation and div operator of continuation equation
     // search for all the Edge this cell own
     for(unsigned int ne=0; ne<elem->n_edges(); ++ne )
@@ -1078,52 +1401,62 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
       std::pair<unsigned int, unsigned int> edge_nodes;
       elem->nodes_on_edge(ne, edge_nodes);
 
-      const unsigned int edge_index = this->elem_edge_index(elem, ne);
+      const unsigned int slot = edge_table.elem_slot(nelem, ne);
+      const unsigned int edge_index = edge_table.elem_edge[slot];
 
       // the length of this edge
-      const double length = elem->edge_length(ne);
+      const double length = edge_table.length[edge_index];
 
-      const FVM_Node * fvm_n1 = elem->get_fvm_node(edge_nodes.first);   // fvm_node of node1
-      const FVM_Node * fvm_n2 = elem->get_fvm_node(edge_nodes.second);  // fvm_node of node2
+      FVM_Node * fvm_n1 = elem->get_fvm_node(edge_nodes.first);   // fvm_node of node1
+      FVM_Node * fvm_n2 = elem->get_fvm_node(edge_nodes.second);  // fvm_node of node2
 
-      double partial_area = elem->partial_area_with_edge(ne);        // partial area associated with this edge
-      double partial_volume = elem->partial_volume_with_edge(ne);    // partial volume associated with this edge
+      double partial_area = edge_table.partial_area[slot];        // partial area associated with this edge
+      double partial_volume = edge_table.partial_volume[slot];    // partial volume associated with this edge
       double truncated_partial_area =  partial_area;
       double truncated_partial_volume =  partial_volume;
       if(truncation)
       {
         // use truncated partial area to avoid negative area due to bad mesh elem
-        truncated_partial_area =  this->truncated_partial_area(elem, ne);
-        truncated_partial_volume =  elem->partial_volume_with_edge_truncated(ne);
+        truncated_partial_area =  edge_table.truncated_partial_area[slot];
+        truncated_partial_volume =  edge_table.truncated_partial_volume[slot];
       }
 
-      bool inverse = fvm_n1->root_node()->id() > fvm_n2->root_node()->id();       // find the correct order
+      bool inverse = edge_table.elem_edge_inverse[slot];       // find the correct order
 
 
       // fvm_node_data of node1
-      const FVM_NodeData * n1_data =  fvm_n1->node_data();
+      FVM_NodeData * n1_data =  fvm_n1->node_data();
       // fvm_node_data of node2
-      const FVM_NodeData * n2_data =  fvm_n2->node_data();
+      FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-      const unsigned int n1_local_offset = fvm_n1->local_offset();
-      const unsigned int n2_local_offset = fvm_n2->local_offset();
-      const unsigned int n1_global_offset = fvm_n1->global_offset();
-      const unsigned int n2_global_offset = fvm_n2->global_offset();
+      const unsigned int n1_local_offset = inverse ? edge_table.n2_local_offset[edge_index] : edge_table.n1_local_offset[edge_index];
+      const unsigned int n2_local_offset = inverse ? edge_table.n1_local_offset[edge_index] : edge_table.n2_local_offset[edge_index];
+      const unsigned int n1_global_offset = inverse ? edge_table.n2_global_offset[edge_index] : edge_table.n1_global_offset[edge_index];
+      const unsigned int n2_global_offset = inverse ? edge_table.n1_global_offset[edge_index] : edge_table.n2_global_offset[edge_index];
+      const bool n1_on_processor = inverse ? edge_table.n2_on_processor[edge_index] : edge_table.n1_on_processor[edge_index];
+      const bool n2_on_processor = inverse ? edge_table.n1_on_processor[edge_index] : edge_table.n2_on_processor[edge_index];
 
       // the row position of variables in the matrix
       PetscInt row[6];
       for(int i=0; i<3; ++i) row[i]   = n1_global_offset+i;
       for(int i=0; i<3; ++i) row[i+3] = n2_global_offset+i;
 
+      // and their slots, NULL when the matrix should search the columns
+      const int * slot_row[6];
+      for(int i=0; i<3; ++i) slot_row[i]   = cell_slots ? cell_slots + (3*edge_nodes.first+i)*n_cell_col : 0;
+      for(int i=0; i<3; ++i) slot_row[i+3] = cell_slots ? cell_slots + (3*edge_nodes.second+i)*n_cell_col : 0;
+
       // here we use AD again. Can we hand write it for more efficient?
       {
         AutoDScalar V1(x[n1_local_offset+0]);       V1.setADValue(3*edge_nodes.first+0, 1.0);           // electrostatic potential
         AutoDScalar n1(x[n1_local_offset+1]);       n1.setADValue(3*edge_nodes.first+1, 1.0);           // electron density
         AutoDScalar p1(x[n1_local_offset+2]);       p1.setADValue(3*edge_nodes.first+2, 1.0);           // hole density
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         AutoDScalar V2(x[n2_local_offset+0]);       V2.setADValue(3*edge_nodes.second+0, 1.0);          // electrostatic potential
         AutoDScalar n2(x[n2_local_offset+1]);       n2.setADValue(3*edge_nodes.second+1, 1.0);          // electron density
         AutoDScalar p2(x[n2_local_offset+2]);       p2.setADValue(3*edge_nodes.second+2, 1.0);          // hole density
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         AutoDScalar mun1;   // electron mobility for node 1 of the edge
         AutoDScalar mup1;   // hole mobility for node 1 of the edge
@@ -1136,13 +1469,11 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
 
           if(get_advanced_model()->ESurface && insulator_interface_elem)
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Etn, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Etp, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Etn, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Etp, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Etn, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Etp, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Etn, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Etp, T);
           }
           else
           {
@@ -1159,35 +1490,29 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
               if(mos_channel_elem)
                 Et = (E - (E*dir)*dir).size();
 
-              mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-              mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Et, T);
-              mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Et, T);
+              mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Et, T);
+              mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Et, T);
 
-              mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-              mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Et, T);
-              mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Et, T);
+              mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Et, T);
+              mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Et, T);
             }
             else // ModelSpecify::EJ || ModelSpecify::EQF
             {
-              mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-              mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Etn, T);
-              mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Etp, T);
+              mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Etn, T);
+              mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Etp, T);
 
-              mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-              mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Etn, T);
-              mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Etp, T);
+              mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Etn, T);
+              mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Etp, T);
             }
           }
         }
         else // low field mobility
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T, 0, 0, T);
-          mup1 = mt->mob->HoleMob(p1, n1, T, 0, 0, T);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, 0, 0, T);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, 0, 0, T);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T, 0, 0, T);
-          mup2 = mt->mob->HoleMob(p2, n2, T, 0, 0, T);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, 0, 0, T);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, 0, 0, T);
         }
 
 
@@ -1195,8 +1520,8 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
         AutoDScalar mup = 0.5*(mup1+mup2);  // the hole mobility at the mid point of the edge, use linear interpolation
 
         // S-G current along the edge
-        const AutoDScalar & Jn_edge = Jn_edge_buffer[edge_index];
-        const AutoDScalar & Jp_edge = Jp_edge_buffer[edge_index];
+        const FixedDScalar<6> & Jn_edge = Jn_edge_buffer[edge_index];
+        const FixedDScalar<6> & Jp_edge = Jp_edge_buffer[edge_index];
 
         // shift AD value since they have different location
         unsigned int order[6];
@@ -1219,50 +1544,81 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
           order[5]= 3*edge_nodes.second+2;
         }
 
-        AutoDScalar Jn = (inverse ? -1.0 : 1.0)*mun*AutoDScalar(Jn_edge, order, 6);
-        AutoDScalar Jp = (inverse ? -1.0 : 1.0)*mup*AutoDScalar(Jp_edge, order, 6);
+        AutoDScalar Jn = (inverse ? -1.0 : 1.0)*mun*Jn_edge.to_auto(order);
+        AutoDScalar Jp = (inverse ? -1.0 : 1.0)*mup*Jp_edge.to_auto(order);
 
         // ignore thoese ghost nodes (ghost nodes is local but with different processor_id())
-        if( fvm_n1->on_processor() )
+        if( n1_on_processor )
         {
           // flux on edge
           AutoDScalar f_Jn  =  Jn*truncated_partial_area ;
           AutoDScalar f_Jp  = -Jp*truncated_partial_area;
           // general coding always has some overkill... bypass it.
-          jac->add_row(  row[1],  cell_col.size(),  &cell_col[0],  f_Jn.getADValue() );
-          jac->add_row(  row[2],  cell_col.size(),  &cell_col[0],  f_Jp.getADValue() );
+          jac->add_row(  row[1],  n_cell_col,  &cell_col[0],  slot_row[1],  f_Jn.getADValue() );
+          jac->add_row(  row[2],  n_cell_col,  &cell_col[0],  slot_row[2],  f_Jp.getADValue() );
         }
 
-        if( fvm_n2->on_processor() )
+        if( n2_on_processor )
         {
           // flux on edge
           AutoDScalar f_Jn  = -Jn*truncated_partial_area ;
           AutoDScalar f_Jp  =  Jp*truncated_partial_area;
-          jac->add_row(  row[4],  cell_col.size(),  &cell_col[0],  f_Jn.getADValue() );
-          jac->add_row(  row[5],  cell_col.size(),  &cell_col[0],  f_Jp.getADValue() );
+          jac->add_row(  row[4],  n_cell_col,  &cell_col[0],  slot_row[4],  f_Jn.getADValue() );
+          jac->add_row(  row[5],  n_cell_col,  &cell_col[0],  slot_row[5],  f_Jp.getADValue() );
+        }
+
+        if( fused )
+        {
+          Jn_edge_cell.push_back(Jn.getValue());
+          Jp_edge_cell.push_back(Jp.getValue());
+
+          if( n1_on_processor )
+          {
+            iflux.push_back( row[1] );
+            flux.push_back ( Jn.getValue()*truncated_partial_area );
+            iflux.push_back( row[2] );
+            flux.push_back ( - Jp.getValue()*truncated_partial_area );
+          }
+          if( n2_on_processor )
+          {
+            iflux.push_back( row[4] );
+            flux.push_back ( - Jn.getValue()*truncated_partial_area );
+            iflux.push_back( row[5] );
+            flux.push_back ( Jp.getValue()*truncated_partial_area );
+          }
         }
 
         // BandBandTunneling && ImpactIonization
 
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
-          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(T, E.size());
-          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(T, E.size());
+          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T, E.size());
+          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T, E.size());
 
-          if( fvm_n1->on_processor() )
+          if( n1_on_processor )
           {
             // continuity equation
             AutoDScalar continuity = 0.5*GBTBT1*truncated_partial_volume;
-            jac->add_row(  row[1],  cell_col.size(),  &cell_col[0],  continuity.getADValue() );
-            jac->add_row(  row[2],  cell_col.size(),  &cell_col[0],  continuity.getADValue() );
+            jac->add_row(  row[1],  n_cell_col,  &cell_col[0],  slot_row[1],  continuity.getADValue() );
+            jac->add_row(  row[2],  n_cell_col,  &cell_col[0],  slot_row[2],  continuity.getADValue() );
+            if( fused )
+            {
+              ibbt.push_back( row[1] );  bbt.push_back( continuity.getValue() );
+              ibbt.push_back( row[2] );  bbt.push_back( continuity.getValue() );
+            }
           }
 
-          if( fvm_n2->on_processor() )
+          if( n2_on_processor )
           {
             // continuity equation
             AutoDScalar continuity = 0.5*GBTBT2*truncated_partial_volume;
-            jac->add_row(  row[4],  cell_col.size(),  &cell_col[0],  continuity.getADValue() );
-            jac->add_row(  row[5],  cell_col.size(),  &cell_col[0],  continuity.getADValue() );
+            jac->add_row(  row[4],  n_cell_col,  &cell_col[0],  slot_row[4],  continuity.getADValue() );
+            jac->add_row(  row[5],  n_cell_col,  &cell_col[0],  slot_row[5],  continuity.getADValue() );
+            if( fused )
+            {
+              ibbt.push_back( row[4] );  bbt.push_back( continuity.getValue() );
+              ibbt.push_back( row[5] );  bbt.push_back( continuity.getValue() );
+            }
           }
         }
 
@@ -1287,20 +1643,20 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
               case ModelSpecify::IIForce_EdotJ:
               Epn = adtl::fmax(E.dot(Jnv.unit(true)), 0.0);
               Epp = adtl::fmax(E.dot(Jpv.unit(true)), 0.0);
-              IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-              IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
               break;
               case ModelSpecify::EVector:
-              IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
               break;
               case ModelSpecify::ESide:
-              IIn = mt->gen->ElecGenRate(T,fabs((V2-V1)/length),Eg);
-              IIp = mt->gen->HoleGenRate(T,fabs((V2-V1)/length),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,fabs((V2-V1)/length),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,fabs((V2-V1)/length),Eg);
               break;
               case ModelSpecify::GradQf:
-              IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
               break;
               default:
               {
@@ -1311,37 +1667,65 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
           GIIn = IIn * fabs(Jn)/e;
           GIIp = IIp * fabs(Jp)/e;
 
-          if( fvm_n1->on_processor() )
+          if( n1_on_processor )
           {
             // continuity equation
             AutoDScalar electron_continuity = (riin1*GIIn+riip1*GIIp)*truncated_partial_volume ;
             AutoDScalar hole_continuity     = (riin1*GIIn+riip1*GIIp)*truncated_partial_volume ;
-            jac->add_row(  row[1],  cell_col.size(),  &cell_col[0],  electron_continuity.getADValue() );
-            jac->add_row(  row[2],  cell_col.size(),  &cell_col[0],  hole_continuity.getADValue() );
+            jac->add_row(  row[1],  n_cell_col,  &cell_col[0],  slot_row[1],  electron_continuity.getADValue() );
+            jac->add_row(  row[2],  n_cell_col,  &cell_col[0],  slot_row[2],  hole_continuity.getADValue() );
+            if( fused )
+            {
+              iii.push_back( row[1] );  ii.push_back( electron_continuity.getValue() );
+              iii.push_back( row[2] );  ii.push_back( hole_continuity.getValue() );
+              node_ii.push_back( std::make_pair(n1_data, electron_continuity.getValue()/fvm_n1->volume()) );
+            }
           }
 
-          if( fvm_n2->on_processor() )
+          if( n2_on_processor )
           {
             // continuity equation
             AutoDScalar electron_continuity = (riin2*GIIn+riip2*GIIp)*truncated_partial_volume ;
             AutoDScalar hole_continuity     = (riin2*GIIn+riip2*GIIp)*truncated_partial_volume ;
-            jac->add_row(  row[4],  cell_col.size(),  &cell_col[0],  electron_continuity.getADValue() );
-            jac->add_row(  row[5],  cell_col.size(),  &cell_col[0],  hole_continuity.getADValue() );
+            jac->add_row(  row[4],  n_cell_col,  &cell_col[0],  slot_row[4],  electron_continuity.getADValue() );
+            jac->add_row(  row[5],  n_cell_col,  &cell_col[0],  slot_row[5],  hole_continuity.getADValue() );
+            if( fused )
+            {
+              iii.push_back( row[4] );  ii.push_back( electron_continuity.getValue() );
+              iii.push_back( row[5] );  ii.push_back( hole_continuity.getValue() );
+              node_ii.push_back( std::make_pair(n2_data, electron_continuity.getValue()/fvm_n2->volume()) );
+            }
           }
         }
 
       }
     }// end of scan all edges of the cell
 
+    // the average cell electron/hole current density vector
+    if( fused )
+    {
+      FVM_CellData * elem_data = this->get_region_elem_data(nelem);
+      elem_data->Jn() = -elem->reconstruct_vector(Jn_edge_cell);
+      elem_data->Jp() =  elem->reconstruct_vector(Jp_edge_cell);
+    }
+
   }// end of scan all the cell
+}
 
 
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
+/*---------------------------------------------------------------------
+ * node related terms of on processor nodes [begin, end), AD version
+ */
+void SemiconductorSimulationRegion::DDM1_Jacobian_Node(DDM1_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+  const PetscScalar T   = data.T;
+  SparseMatrix<PetscScalar> * jac = data.jac[thread];
 
-  // process node related terms
-  // including \rho of poisson's equation and recombination term of continuation equation
+  // function value buffers, only used in fused mode
+  const bool fused = data.fused;
+  std::vector<PetscInt>    & isource = data.source.index(thread);
+  std::vector<PetscScalar> & source  = data.source.value(thread);
 
   //the indepedent variable number, 3 for each node
   adtl::AutoDScalar::numdir = 3;
@@ -1349,9 +1733,9 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
   //synchronize with material database
   mt->set_ad_num(adtl::AutoDScalar::numdir);
 
-  const_processor_node_iterator node_it = on_processor_nodes_begin();
-  const_processor_node_iterator node_it_end = on_processor_nodes_end();
-  for(; node_it!=node_it_end; ++node_it)
+  const_processor_node_iterator node_it = on_processor_nodes_begin() + begin;
+  const_processor_node_iterator node_it_end = on_processor_nodes_begin() + end;
+  for(unsigned int nnode=begin; node_it!=node_it_end; ++node_it, ++nnode)
   {
     const FVM_Node * fvm_node = *node_it;
 
@@ -1365,48 +1749,69 @@ void SemiconductorSimulationRegion::DDM1_Jacobian(PetscScalar * x, SparseMatrix<
     AutoDScalar n(x[local_offset+1]);   n.setADValue(1, 1.0);              // electron density
     AutoDScalar p(x[local_offset+2]);   p.setADValue(2, 1.0);              // hole density
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);                   // map this node and its data to material database
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);                   // map this node and its data to material database
 
-    AutoDScalar R   = - mt->band->Recomb(p, n, T)*fvm_node->volume();                      // the recombination term
+    AutoDScalar R   = - mt->band->Recomb(ctx, p, n, T)*fvm_node->volume();                      // the recombination term
 
     AutoDScalar doping = node_data->Net_doping();
     if(get_advanced_model()->IncompleteIonization)
-      doping = mt->band->Nd_II(n, T, get_advanced_model()->Fermi) - mt->band->Na_II(p, T, get_advanced_model()->Fermi);
+      doping = mt->band->Nd_II(ctx, n, T, get_advanced_model()->Fermi) - mt->band->Na_II(ctx, p, T, get_advanced_model()->Fermi);
     AutoDScalar rho = e*( doping + p - n)*fvm_node->volume(); // the charge density
 
 
 
     // ADD to Jacobian matrix,
-    jac->add_row(  index[0],  3,  &index[0],  rho.getADValue() );
-    jac->add_row(  index[1],  3,  &index[0],  R.getADValue() );
-    jac->add_row(  index[2],  3,  &index[0],  R.getADValue() );
+    const int * slots = _ddm1_node_slots.slots(data.jac.matrix(), nnode, 3, index, 3, index);
+    jac->add_row(  index[0],  3,  &index[0],  slots ? slots+0 : 0,  rho.getADValue() );
+    jac->add_row(  index[1],  3,  &index[0],  slots ? slots+3 : 0,  R.getADValue() );
+    jac->add_row(  index[2],  3,  &index[0],  slots ? slots+6 : 0,  R.getADValue() );
+
+    if( fused )
+    {
+      // carrier generation only contributes to function value
+      PetscScalar Field_G = node_data->Field_G()*fvm_node->volume();
+      isource.push_back(index[0]);
+      isource.push_back(index[1]);
+      isource.push_back(index[2]);
+      source.push_back( rho.getValue() );
+      source.push_back( R.getValue() + Field_G + node_data->EIn() );
+      source.push_back( R.getValue() + Field_G + node_data->HIn() );
+    }
 
     if (get_advanced_model()->Trap)
     {
-      AutoDScalar ni = mt->band->nie(p, n, T);
-      mt->trap->Calculate(true,p,n,ni,T);
+      AutoDScalar ni = mt->band->nie(ctx, p, n, T);
+      mt->trap->Calculate(ctx, true,p,n,ni,T);
 
-      AutoDScalar TrappedC = mt->trap->ChargeAD(true) * fvm_node->volume();
+      AutoDScalar TrappedC = mt->trap->ChargeAD(ctx, true) * fvm_node->volume();
       jac->add_row(  index[0],  3,  &index[0],  TrappedC.getADValue() );
 
-      AutoDScalar GElec = - mt->trap->ElectronTrapRate(true,n,ni,T) * fvm_node->volume();
-      AutoDScalar GHole = - mt->trap->HoleTrapRate    (true,p,ni,T) * fvm_node->volume();
+      AutoDScalar GElec = - mt->trap->ElectronTrapRate(ctx, true,n,ni,T) * fvm_node->volume();
+      AutoDScalar GHole = - mt->trap->HoleTrapRate    (ctx, true,p,ni,T) * fvm_node->volume();
 
       jac->add_row(  index[1],  3,  &index[0],  GElec.getADValue() );
       jac->add_row(  index[2],  3,  &index[0],  GHole.getADValue() );
+
+      if( fused )
+      {
+        if (TrappedC.getValue() != 0)
+        {
+          isource.push_back(index[0]);
+          source.push_back(TrappedC.getValue());
+        }
+        if (GElec.getValue() != 0)
+        {
+          isource.push_back(index[1]);
+          source.push_back(GElec.getValue());
+        }
+        if (GHole.getValue() != 0)
+        {
+          isource.push_back(index[2]);
+          source.push_back(GHole.getValue());
+        }
+      }
     }
   }
-
-
-  // boundary condition should be processed later!
-
-  // the last operator is ADD_VALUES
-  add_value_flag = ADD_VALUES;
-
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
-
 }
 
 
@@ -1701,13 +2106,52 @@ int SemiconductorSimulationRegion::DDM1_Pseudo_Time_Step_Convergence_Test(PetscS
 
 
 void SemiconductorSimulationRegion::DDM1_Update_Solution(PetscScalar *lxx)
+{
+  // update node data of each local node
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, PetscScalar *>
+        node_loop(this, &SemiconductorSimulationRegion::DDM1_Update_Solution_Node, lxx);
+    Genius::parallel_for(on_local_nodes_end()-on_local_nodes_begin(), node_loop);
+  }
+
+  // addtional work: compute electrical field for all the cell.
+  // Since this value is only used for reference.
+  // It can be done simply by weighted average of cell's electrical field
+  for(unsigned int n=0; n<n_cell(); ++n)
+  {
+    const Elem * elem = this->get_region_elem(n);
+    FVM_CellData * elem_data = this->get_region_elem_data(n);
+
+    std::vector<PetscScalar> psi_vertex;
+    psi_vertex.reserve(elem->n_nodes());
+
+    for(unsigned int nd=0; nd<elem->n_nodes(); ++nd)
+    {
+      const FVM_Node * fvm_node = elem->get_fvm_node(nd);
+      const FVM_NodeData * fvm_node_data = fvm_node->node_data();
+      psi_vertex.push_back  ( fvm_node_data->psi() );
+    }
+    // compute the gradient in the cell
+    elem_data->E()  = - elem->gradient(psi_vertex);  // E = - grad(psi)
+  }
+
+  // calculate mobility on node
+  Mob_Evaluation();
+
+}
+
+
+/*---------------------------------------------------------------------
+ * update node data of local nodes [begin, end)
+ */
+void SemiconductorSimulationRegion::DDM1_Update_Solution_Node(PetscScalar * &lxx, unsigned int , unsigned int begin, unsigned int end)
 {
   //common used variable
   const PetscScalar T   = T_external();
   const PetscScalar Vt  = kb*T/e;
 
-  local_node_iterator node_it = on_local_nodes_begin();
-  local_node_iterator node_it_end = on_local_nodes_end();
+  local_node_iterator node_it = on_local_nodes_begin() + begin;
+  local_node_iterator node_it_end = on_local_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     FVM_Node * fvm_node = *node_it;
@@ -1717,7 +2161,7 @@ void SemiconductorSimulationRegion::DDM1_Update_Solution(PetscScalar *lxx)
     PetscScalar p          = lxx[fvm_node->local_offset()+2];
 
     FVM_NodeData * node_data = fvm_node->node_data();  genius_assert(node_data!=NULL);
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     //update psi
     node_data->psi_old()  =  node_data->psi_last();
@@ -1733,9 +2177,9 @@ void SemiconductorSimulationRegion::DDM1_Update_Solution(PetscScalar *lxx)
     node_data->p()        =  p;
 
 
-    node_data->Eg() = mt->band->Eg(T) - mt->band->EgNarrow(p, n, T);
-    node_data->Ec() = -(e*V + node_data->affinity() + mt->band->EgNarrowToEc(p, n, T));
-    node_data->Ev() = -(e*V + node_data->affinity() + mt->band->Eg(T) - mt->band->EgNarrowToEv(p, n, T) );
+    node_data->Eg() = mt->band->Eg(ctx, T) - mt->band->EgNarrow(ctx, p, n, T);
+    node_data->Ec() = -(e*V + node_data->affinity() + mt->band->EgNarrowToEc(ctx, p, n, T));
+    node_data->Ev() = -(e*V + node_data->affinity() + mt->band->Eg(ctx, T) - mt->band->EgNarrowToEv(ctx, p, n, T) );
 
     if(get_advanced_model()->Fermi)
     {
@@ -1748,44 +2192,18 @@ void SemiconductorSimulationRegion::DDM1_Update_Solution(PetscScalar *lxx)
       node_data->qFp() = node_data->Ev() - log(fabs(p/node_data->Nv()))*kb*T;
     }
 
-    node_data->Recomb() = mt->band->Recomb(p, n, T);
-    node_data->Recomb_Dir() = mt->band->R_Direct(p, n, T);
-    node_data->Recomb_SRH() = mt->band->R_SHR(p, n, T);
-    node_data->Recomb_Auger() = mt->band->R_Auger(p, n, T);
+    node_data->Recomb() = mt->band->Recomb(ctx, p, n, T);
+    node_data->Recomb_Dir() = mt->band->R_Direct(ctx, p, n, T);
+    node_data->Recomb_SRH() = mt->band->R_SHR(ctx, p, n, T);
+    node_data->Recomb_Auger() = mt->band->R_Auger(ctx, p, n, T);
 
     if (get_advanced_model()->Trap)
     {
       // update traps
-      mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
-      mt->trap->Update(true, p, n, node_data->ni(), T_external());
-      mt->trap->Update(false, p, n, node_data->ni(), T_external());
-    }
-  }
-
-  // addtional work: compute electrical field for all the cell.
-  // Since this value is only used for reference.
-  // It can be done simply by weighted average of cell's electrical field
-  for(unsigned int n=0; n<n_cell(); ++n)
-  {
-    const Elem * elem = this->get_region_elem(n);
-    FVM_CellData * elem_data = this->get_region_elem_data(n);
-
-    std::vector<PetscScalar> psi_vertex;
-    psi_vertex.reserve(elem->n_nodes());
-
-    for(unsigned int nd=0; nd<elem->n_nodes(); ++nd)
-    {
-      const FVM_Node * fvm_node = elem->get_fvm_node(nd);
-      const FVM_NodeData * fvm_node_data = fvm_node->node_data();
-      psi_vertex.push_back  ( fvm_node_data->psi() );
+      mt->trap->Update(ctx, true, p, n, node_data->ni(), T_external());
+      mt->trap->Update(ctx, false, p, n, node_data->ni(), T_external());
     }
-    // compute the gradient in the cell
-    elem_data->E()  = - elem->gradient(psi_vertex);  // E = - grad(psi)
   }
-
-  // calculate mobility on node
-  Mob_Evaluation();
-
 }
 
 
@@ -155,6 +155,7 @@ void HeteroInterfaceBC::DDM2_Function(PetscScalar * x, Vec f, InsertMode &add_va
     PetscScalar p0;
     PetscScalar T0;
     Material::MaterialSemiconductor * mt0;
+    PMI_Context ctx0;
     PetscScalar Ec0,Ev0;
 
     // search all the fvm_node which has *node_it as root node, these nodes are the same in geometry,
@@ -185,10 +186,10 @@ void HeteroInterfaceBC::DDM2_Function(PetscScalar * x, Vec f, InsertMode &add_va
         T0 = x[fvm_nodes[i]->local_offset()+3];
 
         mt0 = semi_region->material();
-        mt0->mapping(fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock);
+        ctx0 = mt0->mapping(fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock);
 
-        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(p0, n0, T0) + kb*T0*log(n0_data->Nc()));
-        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(p0, n0, T0) - kb*T0*log(n0_data->Nv()) + mt0->band->Eg(T0));
+        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(ctx0, p0, n0, T0) + kb*T0*log(n0_data->Nc()));
+        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(ctx0, p0, n0, T0) - kb*T0*log(n0_data->Nv()) + mt0->band->Eg(ctx0, T0));
         if(semi_region->get_advanced_model()->Fermi)
         {
           Ec0 = Ec0 - kb*T0*log(gamma_f(fabs(n0)/n0_data->Nc()));
@@ -219,9 +220,9 @@ void HeteroInterfaceBC::DDM2_Function(PetscScalar * x, Vec f, InsertMode &add_va
 
               // mapping this node to material library
               Material::MaterialSemiconductor *mt = semi_region->material();
-              mt->mapping(fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock);
-              PetscScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(p, n, T) + kb*T*log(n_data->Nc()));
-              PetscScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(T));
+              const PMI_Context ctx = mt->mapping(fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock);
+              PetscScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(ctx, p, n, T) + kb*T*log(n_data->Nc()));
+              PetscScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(ctx, p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(ctx, T));
               if(semi_region->get_advanced_model()->Fermi)
               {
                 Ec = Ec - kb*T*log(gamma_f(fabs(n)/n_data->Nc()));
@@ -245,16 +246,16 @@ void HeteroInterfaceBC::DDM2_Function(PetscScalar * x, Vec f, InsertMode &add_va
               if(Ec0 > Ec)
               {
                 // Jn is enter region 0
-                PetscScalar pm = mt0->band->EffecElecMass(T)/mt->band->EffecElecMass(T);
-                PetscScalar Jn = 2*(mt0->band->ThermalVn(T)*n0 - pm*mt->band->ThermalVn(T)*(n*exp(-(Ec0-Ec)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt0->band->EffecElecMass(ctx0, T)/mt->band->EffecElecMass(ctx, T);
+                PetscScalar Jn = 2*(mt0->band->ThermalVn(ctx0, T)*n0 - pm*mt->band->ThermalVn(ctx, T)*(n*exp(-(Ec0-Ec)/(kb*T))))*cv_boundary;
                 VecSetValue(f, fvm_node->global_offset()+1,   Jn, ADD_VALUES);
                 VecSetValue(f, fvm_node0->global_offset()+1, -Jn, ADD_VALUES);
               }
               else
               {
                 // Jn is enter this region
-                PetscScalar pm = mt->band->EffecElecMass(T)/mt0->band->EffecElecMass(T);
-                PetscScalar Jn = 2*(mt->band->ThermalVn(T)*n - pm*mt0->band->ThermalVn(T)*(n0*exp(-(Ec-Ec0)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt->band->EffecElecMass(ctx, T)/mt0->band->EffecElecMass(ctx0, T);
+                PetscScalar Jn = 2*(mt->band->ThermalVn(ctx, T)*n - pm*mt0->band->ThermalVn(ctx0, T)*(n0*exp(-(Ec-Ec0)/(kb*T))))*cv_boundary;
                 VecSetValue(f, fvm_node->global_offset()+1,  -Jn, ADD_VALUES);
                 VecSetValue(f, fvm_node0->global_offset()+1,  Jn, ADD_VALUES);
               }
@@ -262,16 +263,16 @@ void HeteroInterfaceBC::DDM2_Function(PetscScalar * x, Vec f, InsertMode &add_va
               if(Ev0 < Ev)
               {
                 // Jp is enter region 0
-                PetscScalar pm = mt0->band->EffecHoleMass(T)/mt->band->EffecHoleMass(T);
-                PetscScalar Jp = 2*(mt0->band->ThermalVp(T)*p0 - pm*mt->band->ThermalVp(T)*(p*exp((Ev0-Ev)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt0->band->EffecHoleMass(ctx0, T)/mt->band->EffecHoleMass(ctx, T);
+                PetscScalar Jp = 2*(mt0->band->ThermalVp(ctx0, T)*p0 - pm*mt->band->ThermalVp(ctx, T)*(p*exp((Ev0-Ev)/(kb*T))))*cv_boundary;
                 VecSetValue(f, fvm_node->global_offset()+2,   Jp, ADD_VALUES);
                 VecSetValue(f, fvm_node0->global_offset()+2, -Jp, ADD_VALUES);
               }
               else
               {
                 // Jp is enter this region
-                PetscScalar pm = mt->band->EffecHoleMass(T)/mt0->band->EffecHoleMass(T);
-                PetscScalar Jp = 2*(mt->band->ThermalVp(T)*p - pm*mt0->band->ThermalVp(T)*(p0*exp((Ev-Ev0)/(kb*T))))*cv_boundary;
+                PetscScalar pm = mt->band->EffecHoleMass(ctx, T)/mt0->band->EffecHoleMass(ctx0, T);
+                PetscScalar Jp = 2*(mt->band->ThermalVp(ctx, T)*p - pm*mt0->band->ThermalVp(ctx0, T)*(p0*exp((Ev-Ev0)/(kb*T))))*cv_boundary;
                 VecSetValue(f, fvm_node->global_offset()+2,  -Jp, ADD_VALUES);
                 VecSetValue(f, fvm_node0->global_offset()+2,  Jp, ADD_VALUES);
               }
@@ -411,6 +412,7 @@ void HeteroInterfaceBC::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
     AutoDScalar p0;
     AutoDScalar T0;
     Material::MaterialSemiconductor * mt0;
+    PMI_Context ctx0;
     AutoDScalar Ec0,Ev0;
 
     // search all the fvm_node which has *node_it as root node, these nodes are the same in geometry,
@@ -435,15 +437,15 @@ void HeteroInterfaceBC::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
 
         mt0 = semi_region->material();
         mt0->set_ad_num(adtl::AutoDScalar::numdir);
-        mt0->mapping(fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock);
+        ctx0 = mt0->mapping(fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock);
 
         V0 = x[fvm_nodes[i]->local_offset()+0];  V0.setADValue(0,1.0);
         n0 = x[fvm_nodes[i]->local_offset()+1];  n0.setADValue(1,1.0);  // electron density
         p0 = x[fvm_nodes[i]->local_offset()+2];  p0.setADValue(2,1.0);  // hole density
         T0 = x[fvm_nodes[i]->local_offset()+3];  T0.setADValue(3,1.0);
 
-        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(p0, n0, T0) + kb*T0*log(n0_data->Nc()));
-        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(p0, n0, T0) - kb*T0*log(n0_data->Nv()) + mt0->band->Eg(T0));
+        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(ctx0, p0, n0, T0) + kb*T0*log(n0_data->Nc()));
+        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(ctx0, p0, n0, T0) - kb*T0*log(n0_data->Nv()) + mt0->band->Eg(ctx0, T0));
         if(semi_region->get_advanced_model()->Fermi)
         {
           Ec0 = Ec0 - kb*T0*log(gamma_f(fabs(n0)/n0_data->Nc()));
@@ -482,9 +484,9 @@ void HeteroInterfaceBC::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
               // mapping this node to material library
               Material::MaterialSemiconductor *mt = semi_region->material();
               mt->set_ad_num(adtl::AutoDScalar::numdir);
-              mt->mapping(fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock);
-              AutoDScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(p, n, T) + kb*T*log(n_data->Nc()));
-              AutoDScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(T));
+              const PMI_Context ctx = mt->mapping(fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock);
+              AutoDScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(ctx, p, n, T) + kb*T*log(n_data->Nc()));
+              AutoDScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(ctx, p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(ctx, T));
               if(semi_region->get_advanced_model()->Fermi)
               {
                 Ec = Ec - kb*T*log(gamma_f(fabs(n)/n_data->Nc()));
@@ -505,16 +507,16 @@ void HeteroInterfaceBC::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
               if(Ec0 > Ec)
               {
                 // Jn is enter region 0
-                AutoDScalar pm = mt0->band->EffecElecMass(T)/mt->band->EffecElecMass(T);
-                AutoDScalar Jn = 2*(mt0->band->ThermalVn(T)*n0 - pm*mt->band->ThermalVn(T)*(n*exp(-(Ec0-Ec)/(kb*T))))*cv_boundary;
+                AutoDScalar pm = mt0->band->EffecElecMass(ctx0, T)/mt->band->EffecElecMass(ctx, T);
+                AutoDScalar Jn = 2*(mt0->band->ThermalVn(ctx0, T)*n0 - pm*mt->band->ThermalVn(ctx, T)*(n*exp(-(Ec0-Ec)/(kb*T))))*cv_boundary;
                 jac->add_row(  rows[5],  cols.size(),  &cols[0],  Jn.getADValue() );
                 jac->add_row(  rows[1],  cols.size(),  &cols[0],  (-Jn).getADValue() );
               }
               else
               {
                 // Jn is enter this region
-                AutoDScalar pm = mt->band->EffecElecMass(T)/mt0->band->EffecElecMass(T);
-                AutoDScalar Jn = 2*(mt->band->ThermalVn(T)*n - pm*mt0->band->ThermalVn(T)*(n0*exp(-(Ec-Ec0)/(kb*T))))*cv_boundary;
+                AutoDScalar pm = mt->band->EffecElecMass(ctx, T)/mt0->band->EffecElecMass(ctx0, T);
+                AutoDScalar Jn = 2*(mt->band->ThermalVn(ctx, T)*n - pm*mt0->band->ThermalVn(ctx0, T)*(n0*exp(-(Ec-Ec0)/(kb*T))))*cv_boundary;
                 jac->add_row(  rows[5],  cols.size(),  &cols[0],  (-Jn).getADValue() );
                 jac->add_row(  rows[1],  cols.size(),  &cols[0],  Jn.getADValue() );
               }
@@ -522,16 +524,16 @@ void HeteroInterfaceBC::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
               if(Ev0 < Ev)
               {
                 // Jp is enter region 0
-                AutoDScalar pm = mt0->band->EffecHoleMass(T)/mt->band->EffecHoleMass(T);
-                AutoDScalar Jp = 2*(mt0->band->ThermalVp(T)*p0 - pm*mt->band->ThermalVp(T)*(p*exp((Ev0-Ev)/(kb*T))))*cv_boundary;
+                AutoDScalar pm = mt0->band->EffecHoleMass(ctx0, T)/mt->band->EffecHoleMass(ctx, T);
+                AutoDScalar Jp = 2*(mt0->band->ThermalVp(ctx0, T)*p0 - pm*mt->band->ThermalVp(ctx, T)*(p*exp((Ev0-Ev)/(kb*T))))*cv_boundary;
                 jac->add_row(  rows[6],  cols.size(),  &cols[0],  Jp.getADValue() );
                 jac->add_row(  rows[2],  cols.size(),  &cols[0],  (-Jp).getADValue() );
               }
               else
               {
                 // Jp is enter this region
-                AutoDScalar pm = mt->band->EffecHoleMass(T)/mt0->band->EffecHoleMass(T);
-                AutoDScalar Jp = 2*(mt->band->ThermalVp(T)*p - pm*mt0->band->ThermalVp(T)*(p0*exp((Ev-Ev0)/(kb*T))))*cv_boundary;
+                AutoDScalar pm = mt->band->EffecHoleMass(ctx, T)/mt0->band->EffecHoleMass(ctx0, T);
+                AutoDScalar Jp = 2*(mt->band->ThermalVp(ctx, T)*p - pm*mt0->band->ThermalVp(ctx0, T)*(p0*exp((Ev-Ev0)/(kb*T))))*cv_boundary;
                 jac->add_row(  rows[6],  cols.size(),  &cols[0],  (-Jp).getADValue() );
                 jac->add_row(  rows[2],  cols.size(),  &cols[0],  Jp.getADValue() );
               }
@@ -85,8 +85,8 @@ void NeumannBC::DDM2_Function(PetscScalar * x, Vec f, InsertMode &add_value_flag
         {
           // surface recombination
           Material::MaterialSemiconductor *mt =  sregion->material();
-          mt->mapping(fvm_node->root_node(), fvm_node->node_data(), SolverSpecify::clock);
-          PetscScalar GSurf = - mt->band->R_Surf(p, n, T) * boundary_area; //generation due to SRH
+          const PMI_Context ctx = mt->mapping(fvm_node->root_node(), fvm_node->node_data(), SolverSpecify::clock);
+          PetscScalar GSurf = - mt->band->R_Surf(ctx, p, n, T) * boundary_area; //generation due to SRH
 
           VecSetValue(f, fvm_node->global_offset()+1, GSurf, ADD_VALUES);
           VecSetValue(f, fvm_node->global_offset()+2, GSurf, ADD_VALUES);
@@ -170,14 +170,14 @@ void NeumannBC::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *jac, I
         PetscScalar boundary_area = fvm_node->outside_boundary_surface_area();
 
         Material::MaterialSemiconductor *mt =  sregion->material();
-        mt->mapping(fvm_node->root_node(), fvm_node->node_data(), SolverSpecify::clock);
+        const PMI_Context ctx = mt->mapping(fvm_node->root_node(), fvm_node->node_data(), SolverSpecify::clock);
         //synchronize with material database
         mt->set_ad_num(adtl::AutoDScalar::numdir);
 
         if(surface_recomb)
         {
           // surface recombination
-          AutoDScalar GSurf = - mt->band->R_Surf(p, n, T) * boundary_area;
+          AutoDScalar GSurf = - mt->band->R_Surf(ctx, p, n, T) * boundary_area;
           jac->add_row(  index[1],  4,  &index[0],  GSurf.getADValue() );
           jac->add_row(  index[2],  4,  &index[0],  GSurf.getADValue() );
         }
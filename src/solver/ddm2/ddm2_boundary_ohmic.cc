@@ -222,14 +222,14 @@ void OhmicContactBC::DDM2_Function(PetscScalar * x, Vec f, InsertMode &add_value
             PetscScalar T = x[fvm_nodes[i]->local_offset()+3];  // lattice temperature
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
-
-            PetscScalar nie = semi_region->material()->band->nie(p, n, T);
-            PetscScalar Nc  = semi_region->material()->band->Nc(T);
-            PetscScalar Nv  = semi_region->material()->band->Nv(T);
-            PetscScalar Eg  = semi_region->material()->band->Eg(T);
-            PetscScalar dEc = semi_region->material()->band->EgNarrowToEc(p, n, T);
-            PetscScalar dEv = semi_region->material()->band->EgNarrowToEv(p, n, T);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+
+            PetscScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+            PetscScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+            PetscScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+            PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
+            PetscScalar dEc = semi_region->material()->band->EgNarrowToEc(ctx, p, n, T);
+            PetscScalar dEv = semi_region->material()->band->EgNarrowToEv(ctx, p, n, T);
             /*
              * governing equation of psi/n/p for Ohmic contact boundary
              */
@@ -691,14 +691,14 @@ void OhmicContactBC::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *j
             col = row;
             col.push_back(this->global_offset()); // the position of electrode equation
 
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-            AutoDScalar nie = semi_region->material()->band->nie(p, n, T);
-            AutoDScalar Nc  = semi_region->material()->band->Nc(T);
-            AutoDScalar Nv  = semi_region->material()->band->Nv(T);
-            AutoDScalar Eg  = semi_region->material()->band->Eg(T);
-            AutoDScalar dEc = semi_region->material()->band->EgNarrowToEc(p, n, T);
-            AutoDScalar dEv = semi_region->material()->band->EgNarrowToEv(p, n, T);
+            AutoDScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+            AutoDScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+            AutoDScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+            AutoDScalar Eg  = semi_region->material()->band->Eg(ctx, T);
+            AutoDScalar dEc = semi_region->material()->band->EgNarrowToEc(ctx, p, n, T);
+            AutoDScalar dEv = semi_region->material()->band->EgNarrowToEv(ctx, p, n, T);
 
             //governing equation of pis/n/p for Ohmic contact boundary
             AutoDScalar ff1,ff2,ff3;
@@ -237,12 +237,12 @@ void IF_Metal_OhmicBC::_DDM2_Function_Limited_Recombination ( PetscScalar * x, V
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    const PetscScalar nie = semiconductor_region->material()->band->nie ( p, n, T_semiconductor );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T_semiconductor );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T_semiconductor );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T_semiconductor );
+    const PetscScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T_semiconductor );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T_semiconductor );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T_semiconductor );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T_semiconductor );
 
     PetscScalar  electron_density;
     PetscScalar  hole_density;
@@ -451,12 +451,12 @@ void IF_Metal_OhmicBC::_DDM2_Function_Infinite_Recombination ( PetscScalar * x,
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    const PetscScalar nie = semiconductor_region->material()->band->nie ( p, n, T_semiconductor );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T_semiconductor );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T_semiconductor );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T_semiconductor );
+    const PetscScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T_semiconductor );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T_semiconductor );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T_semiconductor );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T_semiconductor );
 
 
     //governing equation for Ohmic contact boundary
@@ -795,12 +795,12 @@ void IF_Metal_OhmicBC::_DDM2_Jacobian_Limited_Recombination ( PetscScalar * x, S
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    AutoDScalar nie = semiconductor_region->material()->band->nie ( p, n, T_semiconductor );
-    const AutoDScalar Nc  = semiconductor_region->material()->band->Nc ( T_semiconductor );
-    const AutoDScalar Nv  = semiconductor_region->material()->band->Nv ( T_semiconductor );
-    const AutoDScalar Eg  = semiconductor_region->material()->band->Eg ( T_semiconductor );
+    AutoDScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T_semiconductor );
+    const AutoDScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T_semiconductor );
+    const AutoDScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T_semiconductor );
+    const AutoDScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T_semiconductor );
 
     AutoDScalar  electron_density;
     AutoDScalar  hole_density;
@@ -982,12 +982,12 @@ void IF_Metal_OhmicBC::_DDM2_Jacobian_Infinite_Recombination ( PetscScalar * x,
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    AutoDScalar nie = semiconductor_region->material()->band->nie ( p, n, T_semiconductor );
-    const AutoDScalar Nc  = semiconductor_region->material()->band->Nc ( T_semiconductor );
-    const AutoDScalar Nv  = semiconductor_region->material()->band->Nv ( T_semiconductor );
-    const AutoDScalar Eg  = semiconductor_region->material()->band->Eg ( T_semiconductor );
+    AutoDScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T_semiconductor );
+    const AutoDScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T_semiconductor );
+    const AutoDScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T_semiconductor );
+    const AutoDScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T_semiconductor );
 
     //governing equation for Ohmic contact boundary
     AutoDScalar f_phi,f_elec,f_hole;
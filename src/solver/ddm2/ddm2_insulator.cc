@@ -94,10 +94,12 @@ void InsulatorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, InsertMode
   iy.reserve(4*n_edge());
   y.reserve(4*n_edge());
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -109,14 +111,13 @@ void InsulatorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, InsertMode
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_global_offset = fvm_n1->global_offset();
-    const unsigned int n2_global_offset = fvm_n2->global_offset();
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_global_offset = edge_table.n1_global_offset[nedge];
+    const unsigned int n2_global_offset = edge_table.n2_global_offset[nedge];
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
       PetscScalar V1   =  x[n1_local_offset+0];             // electrostatic potential
       PetscScalar T1   =  x[n1_local_offset+1];             // lattice temperature
       PetscScalar rho1 =  0;                                // charge density
@@ -124,7 +125,6 @@ void InsulatorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, InsertMode
       PetscScalar kap1 =  mt->thermal->HeatConduction(T1);
 
         //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
       PetscScalar V2   =  x[n2_local_offset+0];
       PetscScalar T2   =  x[n2_local_offset+1];
       PetscScalar rho2 =  0;
@@ -136,11 +136,11 @@ void InsulatorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, InsertMode
 
 
       // "flux" from node 2 to node 1
-      PetscScalar f_psi =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/fvm_n1->distance(fvm_n2) ;
-      PetscScalar f_q   =  kap*fvm_n1->cv_surface_area(fvm_n2)*(T2 - T1)/fvm_n1->distance(fvm_n2) ;
+      PetscScalar f_psi =  eps*edge_table.cv_area[nedge]*(V2 - V1)/edge_table.length[nedge] ;
+      PetscScalar f_q   =  kap*edge_table.cv_area[nedge]*(T2 - T1)/edge_table.length[nedge] ;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         iy.push_back(n1_global_offset+0);
         y.push_back(f_psi);
@@ -148,7 +148,7 @@ void InsulatorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, InsertMode
         y.push_back(f_q);
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         iy.push_back(n2_global_offset+0);
         y.push_back(-f_psi);
@@ -204,10 +204,12 @@ void InsulatorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<Pets
   //synchronize with material database
   mt->set_ad_num(adtl::AutoDScalar::numdir);
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -219,14 +221,13 @@ void InsulatorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<Pets
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_global_offset = fvm_n1->global_offset();
-    const unsigned int n2_global_offset = fvm_n2->global_offset();
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_global_offset = edge_table.n1_global_offset[nedge];
+    const unsigned int n2_global_offset = edge_table.n2_global_offset[nedge];
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
       AutoDScalar V1   =  x[n1_local_offset+0];  V1.setADValue(0,1.0);           // electrostatic potential
       AutoDScalar T1   =  x[n1_local_offset+1];  T1.setADValue(0,1.0);           // lattice temperature
       PetscScalar rho1 =  0;                                // charge density
@@ -234,7 +235,6 @@ void InsulatorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<Pets
       PetscScalar kap1 =  mt->thermal->HeatConduction(T1.getValue());
 
         //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
       AutoDScalar V2   =  x[n2_local_offset+0];  V2.setADValue(1,1.0);
       AutoDScalar T2   =  x[n2_local_offset+1];  T2.setADValue(1,1.0);
       PetscScalar rho2 =  0;
@@ -246,11 +246,11 @@ void InsulatorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<Pets
 
 
       // "flux" from node 2 to node 1
-      AutoDScalar f_psi =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/fvm_n1->distance(fvm_n2) ;
-      AutoDScalar f_q   =  kap*fvm_n1->cv_surface_area(fvm_n2)*(T2 - T1)/fvm_n1->distance(fvm_n2) ;
+      AutoDScalar f_psi =  eps*edge_table.cv_area[nedge]*(V2 - V1)/edge_table.length[nedge] ;
+      AutoDScalar f_q   =  kap*edge_table.cv_area[nedge]*(T2 - T1)/edge_table.length[nedge] ;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         jac->add( n1_global_offset,  n1_global_offset,  f_psi.getADValue(0) );
         jac->add( n1_global_offset,  n2_global_offset,  f_psi.getADValue(1) );
@@ -259,7 +259,7 @@ void InsulatorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<Pets
         jac->add( n1_global_offset+1,  n2_global_offset+1,  f_q.getADValue(1) );
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         jac->add( n2_global_offset,  n1_global_offset,  -f_psi.getADValue(0) );
         jac->add( n2_global_offset,  n2_global_offset,  -f_psi.getADValue(1) );
@@ -304,7 +304,6 @@ void InsulatorSimulationRegion::DDM2_Time_Dependent_Function(PetscScalar * x, Ve
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     PetscScalar T   =  x[fvm_node->local_offset()+1];                         // lattice temperature
     PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(T);
@@ -358,7 +357,6 @@ void InsulatorSimulationRegion::DDM2_Time_Dependent_Jacobian(PetscScalar * x, Sp
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     AutoDScalar T   =  x[fvm_node->local_offset()+1];   T.setADValue(0, 1.0);              // lattice temperature
     PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(T.getValue());
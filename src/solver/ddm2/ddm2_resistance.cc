@@ -101,10 +101,12 @@ void MetalSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, InsertMode &ad
   iy.reserve(4*n_edge());
   y.reserve(4*n_edge());
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -116,41 +118,39 @@ void MetalSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, InsertMode &ad
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_global_offset = fvm_n1->global_offset();
-    const unsigned int n2_global_offset = fvm_n2->global_offset();
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_global_offset = edge_table.n1_global_offset[nedge];
+    const unsigned int n2_global_offset = edge_table.n2_global_offset[nedge];
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
       PetscScalar V1   =  x[n1_local_offset+0];             // electrostatic potential
       PetscScalar T1   =  x[n1_local_offset+1];             // lattice temperature
       PetscScalar kap1 =  mt->thermal->HeatConduction(T1);
 
       //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
       PetscScalar V2   =  x[n2_local_offset+0];
       PetscScalar T2   =  x[n2_local_offset+1];
       PetscScalar kap2 =  mt->thermal->HeatConduction(T2);
 
-      PetscScalar E    = (V2-V1)/fvm_n1->distance(fvm_n2);
+      PetscScalar E    = (V2-V1)/edge_table.length[nedge];
       PetscScalar kap = 0.5*(kap1+kap2);       // kapa at mid point of the edge
             
       PetscScalar J = mt->basic->CurrentDensity(E, 0.5*(T1+T2));
 
       // truncated to positive
-      double S = std::abs(fvm_n1->cv_surface_area(fvm_n2));
+      double S = std::abs(edge_table.cv_area[nedge]);
 
       // "flux" from node 2 to node 1
       PetscScalar f_psi = J*S;
-      PetscScalar f_q   = kap*S*(T2 - T1)/fvm_n1->distance(fvm_n2) ;
+      PetscScalar f_q   = kap*S*(T2 - T1)/edge_table.length[nedge] ;
 
       // joule heating
       PetscScalar H = 0.5*(V2-V1)*J*S;
         
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         iy.push_back(n1_global_offset+0);
         y.push_back(f_psi);
@@ -158,7 +158,7 @@ void MetalSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, InsertMode &ad
         y.push_back(f_q + H);
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         iy.push_back(n2_global_offset+0);
         y.push_back(-f_psi);
@@ -198,10 +198,12 @@ void MetalSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
   mt->set_ad_num(adtl::AutoDScalar::numdir);
 
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
  // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -213,49 +215,47 @@ void MetalSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_global_offset = fvm_n1->global_offset();
-    const unsigned int n2_global_offset = fvm_n2->global_offset();
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_global_offset = edge_table.n1_global_offset[nedge];
+    const unsigned int n2_global_offset = edge_table.n2_global_offset[nedge];
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     PetscInt col[4]={n1_global_offset, n1_global_offset+1, n2_global_offset, n2_global_offset+1};
 
     // here we use AD, however it is great overkill for such a simple problem.
     {
       //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
       AutoDScalar V1   =  x[n1_local_offset+0];  V1.setADValue(0,1.0);           // electrostatic potential
       AutoDScalar T1   =  x[n1_local_offset+1];  T1.setADValue(1,1.0);           // lattice temperature
       PetscScalar kap1 =  mt->thermal->HeatConduction(T1.getValue());
 
       //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
       AutoDScalar V2   =  x[n2_local_offset+0];  V2.setADValue(2,1.0);
       AutoDScalar T2   =  x[n2_local_offset+1];  T2.setADValue(3,1.0);
       PetscScalar kap2 =  mt->thermal->HeatConduction(T2.getValue());
 
-      AutoDScalar E    = (V2-V1)/fvm_n1->distance(fvm_n2);
+      AutoDScalar E    = (V2-V1)/edge_table.length[nedge];
       PetscScalar kap  = 0.5*(kap1+kap2);       // kapa at mid point of the edge
             
       AutoDScalar J = mt->basic->CurrentDensity(E, 0.5*(T1+T2));
       
       // truncated to positive
-      double S = std::abs(fvm_n1->cv_surface_area(fvm_n2));
+      double S = std::abs(edge_table.cv_area[nedge]);
       // "flux" from node 2 to node 1
       AutoDScalar f_psi = J*S;
-      AutoDScalar f_q   = kap*S*(T2 - T1)/fvm_n1->distance(fvm_n2) ;
+      AutoDScalar f_q   = kap*S*(T2 - T1)/edge_table.length[nedge] ;
       
       // joule heating
       AutoDScalar H = 0.5*(V2-V1)*J*S;
       
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         jac->add_row( n1_global_offset+0, 4, col,  f_psi.getADValue() );
         jac->add_row( n1_global_offset+1, 4, col,  (f_q+H).getADValue() );
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         jac->add_row( n2_global_offset+0,  4, col,  (-f_psi).getADValue() );
         jac->add_row( n2_global_offset+1,  4, col,  (-f_q+H).getADValue() );
@@ -294,7 +294,6 @@ void MetalSimulationRegion::DDM2_Time_Dependent_Function(PetscScalar * x, Vec f,
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     PetscScalar T   =  x[fvm_node->local_offset()+1];                         // lattice temperature
     PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(T);
@@ -349,7 +348,6 @@ void MetalSimulationRegion::DDM2_Time_Dependent_Jacobian(PetscScalar * x, Sparse
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     AutoDScalar T   =  x[fvm_node->local_offset()+1];   T.setADValue(0, 1.0);              // lattice temperature
     PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(T.getValue());
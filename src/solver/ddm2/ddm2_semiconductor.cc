@@ -26,6 +26,8 @@
 
 #include "log.h"
 #include "jflux2.h"
+#include "thread_pool.h"
+#include "fvm_thread_assembly.h"
 
 
 using PhysicalUnit::kb;
@@ -43,22 +45,36 @@ using PhysicalUnit::cm;
 
 void SemiconductorSimulationRegion::DDM2_Fill_Value(Vec x, Vec L)
 {
-  std::vector<int> ix;
-  std::vector<PetscScalar> y;
-  std::vector<PetscScalar> s;
+  // data buffer
+  FVM_ThreadFillValue data(4*this->n_node());
 
-  ix.reserve(4*this->n_node());
-  y.reserve(4*this->n_node());
-  s.reserve(4*this->n_node());
+  // for all the on processor node, insert value to petsc vector
+  Genius::MemberThreadLoop<SemiconductorSimulationRegion, FVM_ThreadFillValue>
+      node_loop(this, &SemiconductorSimulationRegion::DDM2_Fill_Value_Node, data);
+  Genius::parallel_for(n_on_processor_node(), node_loop);
 
-  const_processor_node_iterator node_it = on_processor_nodes_begin();
-  const_processor_node_iterator node_it_end = on_processor_nodes_end();
+  // call petsc VecSetValues routine to insert bufferred value, in thread order
+  data.flush(x, L);
+}
+
+
+/*---------------------------------------------------------------------
+ * fill solution data of on processor nodes [begin, end)
+ */
+void SemiconductorSimulationRegion::DDM2_Fill_Value_Node(FVM_ThreadFillValue &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  std::vector<PetscInt>    & ix = data.index(thread);
+  std::vector<PetscScalar> & y  = data.value(thread);
+  std::vector<PetscScalar> & s  = data.scale(thread);
+
+  const_processor_node_iterator node_it = on_processor_nodes_begin() + begin;
+  const_processor_node_iterator node_it_end = on_processor_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
 
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, 0.0);
 
     // the first variable, psi
     ix.push_back(fvm_node->global_offset()+0);
@@ -80,16 +96,34 @@ void SemiconductorSimulationRegion::DDM2_Fill_Value(Vec x, Vec L)
     y.push_back(node_data->T());
     s.push_back(1.0/fvm_node->volume());
   }
-
-  if( ix.size() )
-  {
-    VecSetValues(x, ix.size(), &ix[0], &y[0], INSERT_VALUES) ;
-    VecSetValues(L, ix.size(), &ix[0], &s[0], INSERT_VALUES) ;
-  }
 }
 
 
 
+/*---------------------------------------------------------------------
+ * data shared by the threads of DDM2_Function
+ */
+struct SemiconductorSimulationRegion::DDM2_Function_Data
+{
+  DDM2_Function_Data(unsigned int n_cell, unsigned int n_node)
+    : cell(4*(24*n_cell)), node(4*n_node), node_ii(Genius::n_threads())
+  {}
+
+  /// local solution vector
+  PetscScalar *   x;
+  /// highfield mobility is used
+  bool            highfield_mob;
+
+  /// buffer for "cell" related terms
+  FVM_ThreadResidual  cell;
+  /// buffer for node related terms
+  FVM_ThreadResidual  node;
+
+  /// impact ionization generation rate of node, which is added to node data after the cell loop
+  std::vector< std::vector< std::pair<FVM_NodeData *, PetscScalar> > >  node_ii;
+};
+
+
 /*---------------------------------------------------------------------
  * build function and its jacobian for DDML2 solver
  */
@@ -105,22 +139,69 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
   }
 
   // set local buf here
-  std::vector<int>          iy;
-  std::vector<PetscScalar>  y;
-
-  // slightly overkill -- the HEX8 element has 12 edges, each edge has 2 node
-  iy.reserve(4*(24*this->n_cell()+this->n_node()));
-  y.reserve(4*(24*this->n_cell()+this->n_node()));
-
+  DDM2_Function_Data data(this->n_cell(), this->n_node());
 
-  bool  highfield_mob   = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
+  data.x             = x;
+  data.highfield_mob = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
 
   // first, search all the element in this region and process "cell" related terms
   // note, they are all local element, thus must be processed
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM2_Function_Data>
+        cell_loop(this, &SemiconductorSimulationRegion::DDM2_Function_Cell, data);
+    Genius::parallel_for(n_cell(), cell_loop);
+  }
+
+  // impact ionization generation of each node, in thread order
+  for(unsigned int t=0; t<data.node_ii.size(); ++t)
+    for(unsigned int i=0; i<data.node_ii[t].size(); ++i)
+      data.node_ii[t][i].first->ImpactIonization() += data.node_ii[t][i].second;
+
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+
+  // process node related terms
+  // including \rho of poisson's equation and recombination term of continuation equation
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM2_Function_Data>
+        node_loop(this, &SemiconductorSimulationRegion::DDM2_Function_Node, data);
+    Genius::parallel_for(n_on_processor_node(), node_loop);
+  }
+
+  // add into petsc vector, we should prevent zero length vector add here.
+  data.cell.flush(f);
+  data.node.flush(f);
+
+  // after the first scan, every nodes are updated.
+  // however, boundary condition should be processed later.
+
+  // the last operator is ADD_VALUES
+  add_value_flag = ADD_VALUES;
+
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+}
+
+
+/*---------------------------------------------------------------------
+ * "cell" related terms of elements [begin, end)
+ */
+void SemiconductorSimulationRegion::DDM2_Function_Cell(DDM2_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+  const bool  highfield_mob = data.highfield_mob;
+
+  std::vector<PetscInt>    & iy = data.cell.index(thread);
+  std::vector<PetscScalar> & y  = data.cell.value(thread);
+  std::vector< std::pair<FVM_NodeData *, PetscScalar> > & node_ii = data.node_ii[thread];
 
-  const_element_iterator it = elements_begin();
-  const_element_iterator it_end = elements_end();
-  for(unsigned int nelem=0 ; it!=it_end; ++it, ++nelem)
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
+  const_element_iterator it = elements_begin() + begin;
+  const_element_iterator it_end = elements_begin() + end;
+  for(unsigned int nelem=begin ; it!=it_end; ++it, ++nelem)
   {
     const Elem * elem = *it;
 
@@ -231,10 +312,10 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
         // stupid code... we can not dot point with VectorValue<PetscScalar> yet.
         VectorValue<PetscScalar> norm(_norm(0), _norm(1), _norm(2));
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         PetscScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         PetscScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -289,8 +370,11 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
       std::pair<unsigned int, unsigned int> edge_nodes;
       elem->nodes_on_edge(ne, edge_nodes);
 
+      const unsigned int slot = edge_table.elem_slot(nelem, ne);
+      const unsigned int edge_index = edge_table.elem_edge[slot];
+
       // the length of this edge
-      const double length = elem->edge_length(ne);
+      const double length = edge_table.length[edge_index];
 
       // fvm_node of node1
       FVM_Node * fvm_n1 = elem->get_fvm_node(edge_nodes.first);
@@ -303,26 +387,31 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
       FVM_NodeData * n2_data =  fvm_n2->node_data();
 
       // partial area associated with this edge
-      double partial_area = elem->partial_area_with_edge(ne);
-      double partial_volume = elem->partial_volume_with_edge(ne);
+      double partial_area = edge_table.partial_area[slot];
+      double partial_volume = edge_table.partial_volume[slot];
 
       double truncated_partial_area =  partial_area;
       double truncated_partial_volume =  partial_volume;
       if(truncation)
       {
         // use truncated partial area to avoid negative area due to bad mesh elem
-        truncated_partial_area =  this->truncated_partial_area(elem, ne);
-        truncated_partial_volume =  elem->partial_volume_with_edge_truncated(ne);
+        truncated_partial_area =  edge_table.truncated_partial_area[slot];
+        truncated_partial_volume =  edge_table.truncated_partial_volume[slot];
       }
 
-      const unsigned int n1_local_offset = fvm_n1->local_offset();
-      const unsigned int n2_local_offset = fvm_n2->local_offset();
+      bool inverse = edge_table.elem_edge_inverse[slot];       // find the correct order
+      const unsigned int n1_local_offset = inverse ? edge_table.n2_local_offset[edge_index] : edge_table.n1_local_offset[edge_index];
+      const unsigned int n2_local_offset = inverse ? edge_table.n1_local_offset[edge_index] : edge_table.n2_local_offset[edge_index];
+      const unsigned int n1_global_offset = inverse ? edge_table.n2_global_offset[edge_index] : edge_table.n1_global_offset[edge_index];
+      const unsigned int n2_global_offset = inverse ? edge_table.n1_global_offset[edge_index] : edge_table.n2_global_offset[edge_index];
+      const bool n1_on_processor = inverse ? edge_table.n2_on_processor[edge_index] : edge_table.n1_on_processor[edge_index];
+      const bool n2_on_processor = inverse ? edge_table.n1_on_processor[edge_index] : edge_table.n2_on_processor[edge_index];
 
       // build governing equation of DDML2
       {
 
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         PetscScalar V1   =  x[n1_local_offset+0];                  // electrostatic potential
         PetscScalar n1   =  x[n1_local_offset+1];                  // electron density
@@ -335,8 +424,8 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
         // takes care of the change effective DOS.
         // Ec/Ev should not be used except when its difference between two nodes.
         // The same comment applies to Ec2/Ev2.
-        PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(p1, n1, T1) + kb*T1*log(n1_data->Nc()));
-        PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(p1, n1, T1) - kb*T1*log(n1_data->Nv()) + mt->band->Eg(T1));
+        PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(ctx1, p1, n1, T1) + kb*T1*log(n1_data->Nc()));
+        PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(ctx1, p1, n1, T1) - kb*T1*log(n1_data->Nv()) + mt->band->Eg(ctx1, T1));
         if(get_advanced_model()->Fermi)
         {
           Ec1 = Ec1 - kb*T1*log(gamma_f(fabs(n1)/n1_data->Nc()));
@@ -344,20 +433,20 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
         }
 
         PetscScalar eps1 =  n1_data->eps();                        // eps
-        PetscScalar Eg1  =  mt->band->Eg(T1);
-        PetscScalar kap1 =  mt->thermal->HeatConduction(T1);
+        PetscScalar Eg1  =  mt->band->Eg(ctx1, T1);
+        PetscScalar kap1 =  mt->thermal->HeatConduction(ctx1, T1);
 
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         PetscScalar V2   =  x[n2_local_offset+0];                   // electrostatic potential
         PetscScalar n2   =  x[n2_local_offset+1];                   // electron density
         PetscScalar p2   =  x[n2_local_offset+2];                   // hole density
         PetscScalar T2   =  x[n2_local_offset+3];                   // lattice temperature
 
-        PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(p2, n2, T2) + kb*T2*log(n2_data->Nc()));
-        PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(p2, n2, T2) - kb*T2*log(n2_data->Nv()) + mt->band->Eg(T2));
+        PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(ctx2, p2, n2, T2) + kb*T2*log(n2_data->Nc()));
+        PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(ctx2, p2, n2, T2) - kb*T2*log(n2_data->Nv()) + mt->band->Eg(ctx2, T2));
         if(get_advanced_model()->Fermi)
         {
           Ec2 = Ec2 - kb*T2*log(gamma_f(fabs(n2)/n2_data->Nc()));
@@ -365,8 +454,8 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
         }
 
         PetscScalar eps2 =  n2_data->eps();                         // eps
-        PetscScalar Eg2  =  mt->band->Eg(T2);
-        PetscScalar kap2 =  mt->thermal->HeatConduction(T2);
+        PetscScalar Eg2  =  mt->band->Eg(ctx2, T2);
+        PetscScalar kap2 =  mt->thermal->HeatConduction(ctx2, T2);
 
         PetscScalar mun1;  // electron mobility
         PetscScalar mup1;  // hole mobility
@@ -386,34 +475,28 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
               Et = (E - dir*(E*dir)).size();
             }
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Ep, Et, T1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Ep, Et, T1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Ep, Et, T1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Ep, Et, T1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Ep, Et, T2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Ep, Et, T2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Ep, Et, T2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Ep, Et, T2);
           }
           else // ModelSpecify::EJ || ModelSpecify::EQF
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Epn, Etn, T1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Epp, Etp, T1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Epn, Etn, T1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Epp, Etp, T1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Epn, Etn, T2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Epp, Etp, T2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Epn, Etn, T2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Epp, Etp, T2);
           }
         }
         else
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T1, 0, 0, T1);
-          mup1 = mt->mob->HoleMob(p1, n1, T1, 0, 0, T1);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, 0, 0, T1);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, 0, 0, T1);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T2, 0, 0, T2);
-          mup2 = mt->mob->HoleMob(p2, n2, T2, 0, 0, T2);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, 0, 0, T2);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, 0, 0, T2);
         }
 
 
@@ -433,68 +516,68 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
         PetscScalar H = 0.5*(V1-V2)*(Jn + Jp);
 
         // ignore thoese ghost nodes (ghost nodes is local but with different processor_id())
-        if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+        if( n1_on_processor )
         {
           // poisson's equation
-          iy.push_back( fvm_n1->global_offset()+0 );
+          iy.push_back( n1_global_offset+0 );
           y.push_back ( eps*(V2 - V1)/length*partial_area );
 
           // continuity equation of electron
-          iy.push_back( fvm_n1->global_offset()+1 );
+          iy.push_back( n1_global_offset+1 );
           y.push_back ( Jn*truncated_partial_area );
 
           // continuity equation of hole
-          iy.push_back( fvm_n1->global_offset()+2 );
+          iy.push_back( n1_global_offset+2 );
           y.push_back ( - Jp*truncated_partial_area );
 
           // heat transport equation
-          iy.push_back( fvm_n1->global_offset()+3 );
+          iy.push_back( n1_global_offset+3 );
           y.push_back ( kap*(T2 - T1)/length*partial_area + H*truncated_partial_area);
 
         }
 
         // for node 2.
-        if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+        if( n2_on_processor )
         {
           // poisson's equation
-          iy.push_back( fvm_n2->global_offset()+0 );
+          iy.push_back( n2_global_offset+0 );
           y.push_back ( eps*(V1 - V2)/length*partial_area );
 
           // continuity equation of electron
-          iy.push_back( fvm_n2->global_offset()+1 );
+          iy.push_back( n2_global_offset+1 );
           y.push_back ( - Jn*truncated_partial_area );
 
           // continuity equation of hole
-          iy.push_back( fvm_n2->global_offset()+2 );
+          iy.push_back( n2_global_offset+2 );
           y.push_back ( Jp*truncated_partial_area );
 
           // heat transport equation
-          iy.push_back( fvm_n2->global_offset()+3 );
+          iy.push_back( n2_global_offset+3 );
           y.push_back ( kap*(T1 - T2)/length*partial_area + H*truncated_partial_area);
         }
 
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
-          PetscScalar GBTBT1 = mt->band->BB_Tunneling(T1, E.size());
-          PetscScalar GBTBT2 = mt->band->BB_Tunneling(T2, E.size());
+          PetscScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T1, E.size());
+          PetscScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T2, E.size());
 
-          if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+          if( n1_on_processor )
           {
             // continuity equation
-            iy.push_back( fvm_n1->global_offset() + 1);
+            iy.push_back( n1_global_offset + 1);
             y.push_back ( 0.5*GBTBT1*truncated_partial_volume );
 
-            iy.push_back( fvm_n1->global_offset() + 2);
+            iy.push_back( n1_global_offset + 2);
             y.push_back ( 0.5*GBTBT1*truncated_partial_volume );
           }
 
-          if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+          if( n2_on_processor )
           {
             // continuity equation
-            iy.push_back( fvm_n2->global_offset() + 1);
+            iy.push_back( n2_global_offset + 1);
             y.push_back ( 0.5*GBTBT2*truncated_partial_volume );
 
-            iy.push_back( fvm_n2->global_offset() + 2);
+            iy.push_back( n2_global_offset + 2);
             y.push_back ( 0.5*GBTBT2*truncated_partial_volume );
           }
         }
@@ -519,20 +602,20 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
           case ModelSpecify::IIForce_EdotJ:
             Epn = std::max(E.dot(Jnv.unit(true)), 0.0);
             Epp = std::max(E.dot(Jpv.unit(true)), 0.0);
-            IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-            IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
             break;
           case ModelSpecify::EVector:
-            IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
             break;
           case ModelSpecify::ESide:
-            IIn = mt->gen->ElecGenRate(T,fabs(Ec2-Ec1)/e/length,Eg);
-            IIp = mt->gen->HoleGenRate(T,fabs(Ev2-Ev1)/e/length,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,fabs(Ec2-Ec1)/e/length,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,fabs(Ev2-Ev1)/e/length,Eg);
             break;
           case ModelSpecify::GradQf:
-            IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
             break;
           default:
             {
@@ -543,28 +626,28 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
           GIIn = IIn * fabs(Jn)/e;
           GIIp = IIp * fabs(Jp)/e;
 
-          if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+          if( n1_on_processor )
           {
             // continuity equation
-            iy.push_back( fvm_n1->global_offset() + 1);
+            iy.push_back( n1_global_offset + 1);
             y.push_back ( (riin1*GIIn+riip1*GIIp)*truncated_partial_volume );
 
-            iy.push_back( fvm_n1->global_offset() + 2);
+            iy.push_back( n1_global_offset + 2);
             y.push_back ( (riin1*GIIn+riip1*GIIp)*truncated_partial_volume );
 
-            n1_data->ImpactIonization() += (riin1*GIIn+riip1*GIIp)*truncated_partial_volume/fvm_n1->volume();
+            node_ii.push_back( std::make_pair(n1_data, (riin1*GIIn+riip1*GIIp)*truncated_partial_volume/fvm_n1->volume()) );
           }
 
-          if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+          if( n2_on_processor )
           {
             // continuity equation
-            iy.push_back( fvm_n2->global_offset() + 1);
+            iy.push_back( n2_global_offset + 1);
             y.push_back ( (riin2*GIIn+riip2*GIIp)*truncated_partial_volume );
 
-            iy.push_back( fvm_n2->global_offset() + 2);
+            iy.push_back( n2_global_offset + 2);
             y.push_back ( (riin2*GIIn+riip2*GIIp)*truncated_partial_volume );
 
-            n2_data->ImpactIonization() += (riin2*GIIn+riip2*GIIp)*truncated_partial_volume/fvm_n2->volume();
+            node_ii.push_back( std::make_pair(n2_data, (riin2*GIIn+riip2*GIIp)*truncated_partial_volume/fvm_n2->volume()) );
           }
         }
 
@@ -577,15 +660,21 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
     elem_data->Jp() =  elem->reconstruct_vector(Jp_edge);
 
   }
+}
 
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
 
-  // process node related terms
-  // including \rho of poisson's equation and recombination term of continuation equation
-  const_processor_node_iterator node_it = on_processor_nodes_begin();
-  const_processor_node_iterator node_it_end = on_processor_nodes_end();
+/*---------------------------------------------------------------------
+ * node related terms of on processor nodes [begin, end)
+ */
+void SemiconductorSimulationRegion::DDM2_Function_Node(DDM2_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+
+  std::vector<PetscInt>    & iy = data.node.index(thread);
+  std::vector<PetscScalar> & y  = data.node.value(thread);
+
+  const_processor_node_iterator node_it = on_processor_nodes_begin() + begin;
+  const_processor_node_iterator node_it_end = on_processor_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     const FVM_Node * fvm_node = *node_it;
@@ -600,8 +689,8 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
     PetscScalar p   =  x[local_offset+2];                         // hole density
     PetscScalar T   =  x[local_offset+3];                         // lattice temperature
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
-    PetscScalar R   = mt->band->Recomb(p, n, T)*fvm_node->volume();         // the recombination term
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
+    PetscScalar R   = mt->band->Recomb(ctx, p, n, T)*fvm_node->volume();         // the recombination term
     PetscScalar rho = e*(node_data->Net_doping() + p - n)*fvm_node->volume(); // the charge density
     PetscScalar HR  = R*(node_data->Eg()+3*kb*T);                             // heat due to carrier recombination
 
@@ -624,11 +713,11 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
       // consider charge trapping in semiconductor bulk (bulk_flag=true)
 
       // call the Trap MPI to calculate trap occupancy using the local carrier densities and lattice temperature
-      PetscScalar ni = mt->band->nie(p, n, T);
-      mt->trap->Calculate(true,p,n,ni,T);
+      PetscScalar ni = mt->band->nie(ctx, p, n, T);
+      mt->trap->Calculate(ctx, true,p,n,ni,T);
 
       // calculate the contribution of trapped charge to Poisson's equation
-      PetscScalar TrappedC = mt->trap->Charge(true) * fvm_node->volume();
+      PetscScalar TrappedC = mt->trap->Charge(ctx, true) * fvm_node->volume();
       if (TrappedC !=0)
       {
         iy.push_back(fvm_node->global_offset());
@@ -636,8 +725,8 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
       }
 
       // calculate the rates of electron and hole capture
-      PetscScalar TrapElec = mt->trap->ElectronTrapRate(true,n,ni,T) * fvm_node->volume();
-      PetscScalar TrapHole = mt->trap->HoleTrapRate    (true,p,ni,T) * fvm_node->volume();
+      PetscScalar TrapElec = mt->trap->ElectronTrapRate(ctx, true,n,ni,T) * fvm_node->volume();
+      PetscScalar TrapHole = mt->trap->HoleTrapRate    (ctx, true,p,ni,T) * fvm_node->volume();
       // contribution to the contribution to continuity equations
       if (TrapElec != 0)
       {
@@ -653,31 +742,36 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
 
       PetscScalar EcEi = 0.5*node_data->Eg() - kb*T*log(node_data->Nc()/node_data->Nv());
       PetscScalar EiEv = 0.5*node_data->Eg() + kb*T*log(node_data->Nc()/node_data->Nv());
-      PetscScalar H = mt->trap->TrapHeat(true,p,n,ni,T,T,T,EcEi,EiEv);
+      PetscScalar H = mt->trap->TrapHeat(ctx, true,p,n,ni,T,T,T,EcEi,EiEv);
       iy.push_back(fvm_node->global_offset()+3);
       y.push_back( H*fvm_node->volume() );
 
     }
   }
+}
 
 
-  // add into petsc vector, we should prevent zero length vector add here.
-  if(iy.size())  VecSetValues(f, iy.size(), &iy[0], &y[0], ADD_VALUES);
 
-  // after the first scan, every nodes are updated.
-  // however, boundary condition should be processed later.
-
-  // the last operator is ADD_VALUES
-  add_value_flag = ADD_VALUES;
 
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
-}
 
 
+/*---------------------------------------------------------------------
+ * data shared by the threads of DDM2_Jacobian
+ */
+struct SemiconductorSimulationRegion::DDM2_Jacobian_Data
+{
+  DDM2_Jacobian_Data(SparseMatrix<PetscScalar> *jac)
+    : jac(jac)
+  {}
 
+  /// local solution vector
+  PetscScalar *   x;
+  /// highfield mobility is used
+  bool            highfield_mob;
 
+  /// jacobian matrix of each thread
+  FVM_ThreadJacobian  jac;
+};
 
 
 /*---------------------------------------------------------------------
@@ -686,14 +780,60 @@ void SemiconductorSimulationRegion::DDM2_Function(PetscScalar * x, Vec f, Insert
  */
 void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag)
 {
-  bool  highfield_mob   = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
+  DDM2_Jacobian_Data data(jac);
+
+  data.x             = x;
+  data.highfield_mob = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
 
   // search all the element in this region.
   // note, they are all local element, thus must be processed
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM2_Jacobian_Data>
+        cell_loop(this, &SemiconductorSimulationRegion::DDM2_Jacobian_Cell, data);
+    Genius::parallel_for(n_cell(), cell_loop);
+  }
+
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+
+  // process node related terms
+  // including \rho of poisson's equation and recombination term of continuation equation
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, DDM2_Jacobian_Data>
+        node_loop(this, &SemiconductorSimulationRegion::DDM2_Jacobian_Node, data);
+    Genius::parallel_for(n_on_processor_node(), node_loop);
+  }
 
-  const_element_iterator it = elements_begin();
-  const_element_iterator it_end = elements_end();
-  for(; it!=it_end; ++it)
+  // write thread buffers into jacobian matrix
+  data.jac.flush();
+
+  // boundary condition should be processed later!
+
+  // the last operator is ADD_VALUES
+  add_value_flag = ADD_VALUES;
+
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+
+}
+
+
+/*---------------------------------------------------------------------
+ * "cell" related terms of elements [begin, end), AD version
+ */
+void SemiconductorSimulationRegion::DDM2_Jacobian_Cell(DDM2_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+  const bool  highfield_mob = data.highfield_mob;
+  SparseMatrix<PetscScalar> * jac = data.jac[thread];
+
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
+  const_element_iterator it = elements_begin() + begin;
+  const_element_iterator it_end = elements_begin() + end;
+  for(unsigned int nelem=begin; it!=it_end; ++it, ++nelem)
   {
     const Elem * elem = *it;
     bool insulator_interface_elem = is_elem_on_insulator_interface(elem);
@@ -839,10 +979,10 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
         VectorValue<AutoDScalar> norm(_norm(0), _norm(1), _norm(2));
 
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         AutoDScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         AutoDScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -897,8 +1037,11 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
       std::pair<unsigned int, unsigned int> edge_nodes;
       elem->nodes_on_edge(ne, edge_nodes);
 
+      const unsigned int slot = edge_table.elem_slot(nelem, ne);
+      const unsigned int edge_index = edge_table.elem_edge[slot];
+
       // the length of this edge
-      const double length = elem->edge_length(ne);
+      const double length = edge_table.length[edge_index];
 
       // fvm_node of node1
       const FVM_Node * fvm_n1 = elem->get_fvm_node(edge_nodes.first);
@@ -911,68 +1054,73 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
       const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
       // partial area associated with this edge
-      double partial_area = elem->partial_area_with_edge(ne);
-      double partial_volume = elem->partial_volume_with_edge(ne);
+      double partial_area = edge_table.partial_area[slot];
+      double partial_volume = edge_table.partial_volume[slot];
 
       double truncated_partial_area =  partial_area;
       double truncated_partial_volume =  partial_volume;
       if(truncation)
       {
         // use truncated partial area to avoid negative area due to bad mesh elem
-        truncated_partial_area =  this->truncated_partial_area(elem, ne);
-        truncated_partial_volume =  elem->partial_volume_with_edge_truncated(ne);
+        truncated_partial_area =  edge_table.truncated_partial_area[slot];
+        truncated_partial_volume =  edge_table.truncated_partial_volume[slot];
       }
 
-      const unsigned int n1_local_offset = fvm_n1->local_offset();
-      const unsigned int n2_local_offset = fvm_n2->local_offset();
+      bool inverse = edge_table.elem_edge_inverse[slot];       // find the correct order
+      const unsigned int n1_local_offset = inverse ? edge_table.n2_local_offset[edge_index] : edge_table.n1_local_offset[edge_index];
+      const unsigned int n2_local_offset = inverse ? edge_table.n1_local_offset[edge_index] : edge_table.n2_local_offset[edge_index];
+      const unsigned int n1_global_offset = inverse ? edge_table.n2_global_offset[edge_index] : edge_table.n1_global_offset[edge_index];
+      const unsigned int n2_global_offset = inverse ? edge_table.n1_global_offset[edge_index] : edge_table.n2_global_offset[edge_index];
+      const bool n1_on_processor = inverse ? edge_table.n2_on_processor[edge_index] : edge_table.n1_on_processor[edge_index];
+      const bool n2_on_processor = inverse ? edge_table.n1_on_processor[edge_index] : edge_table.n2_on_processor[edge_index];
 
       // the row position of variables in the matrix
       PetscInt row[8];
-      for(unsigned int i=0; i<4; ++i) row[i]   = fvm_n1->global_offset()+i;
-      for(unsigned int i=0; i<4; ++i) row[i+4] = fvm_n2->global_offset()+i;
+      for(unsigned int i=0; i<4; ++i) row[i]   = n1_global_offset+i;
+      for(unsigned int i=0; i<4; ++i) row[i+4] = n2_global_offset+i;
 
 
       // here we use AD again. Can we hand write it for more efficient?
       {
 
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         AutoDScalar V1   =  x[n1_local_offset+0];       V1.setADValue(4*edge_nodes.first+0, 1.0);           // electrostatic potential
         AutoDScalar n1   =  x[n1_local_offset+1];       n1.setADValue(4*edge_nodes.first+1, 1.0);           // electron density
         AutoDScalar p1   =  x[n1_local_offset+2];       p1.setADValue(4*edge_nodes.first+2, 1.0);           // hole density
         AutoDScalar T1   =  x[n1_local_offset+3];       T1.setADValue(4*edge_nodes.first+3, 1.0);           // lattice temperature
 
-        AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(p1, n1, T1) + kb*T1*log(n1_data->Nc()));//conduct band energy level
-        AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(p1, n1, T1) - kb*T1*log(n1_data->Nv()) + mt->band->Eg(T1));//valence band energy level
+        AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(ctx1, p1, n1, T1) + kb*T1*log(n1_data->Nc()));//conduct band energy level
+        AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(ctx1, p1, n1, T1) - kb*T1*log(n1_data->Nv()) + mt->band->Eg(ctx1, T1));//valence band energy level
         if(get_advanced_model()->Fermi)
         {
           Ec1 = Ec1 - kb*T1*log(gamma_f(fabs(n1)/n1_data->Nc()));
           Ev1 = Ev1 + kb*T1*log(gamma_f(fabs(p1)/n1_data->Nv()));
         }
         PetscScalar eps1 =  n1_data->eps();                        // eps
-        AutoDScalar Eg1  =  mt->band->Eg(T1);
-        AutoDScalar kap1 =  mt->thermal->HeatConduction(T1);
+        AutoDScalar Eg1  =  mt->band->Eg(ctx1, T1);
+        AutoDScalar kap1 =  mt->thermal->HeatConduction(ctx1, T1);
 
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         AutoDScalar V2   =  x[n2_local_offset+0];       V2.setADValue(4*edge_nodes.second+0, 1.0);             // electrostatic potential
         AutoDScalar n2   =  x[n2_local_offset+1];       n2.setADValue(4*edge_nodes.second+1, 1.0);             // electron density
         AutoDScalar p2   =  x[n2_local_offset+2];       p2.setADValue(4*edge_nodes.second+2, 1.0);             // hole density
         AutoDScalar T2   =  x[n2_local_offset+3];       T2.setADValue(4*edge_nodes.second+3, 1.0);             // hole density
 
-        AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(p2, n2, T2) + kb*T2*log(n2_data->Nc()));//conduct band energy level
-        AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(p2, n2, T2) - kb*T2*log(n2_data->Nv()) + mt->band->Eg(T2));//valence band energy level
+        AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(ctx2, p2, n2, T2) + kb*T2*log(n2_data->Nc()));//conduct band energy level
+        AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(ctx2, p2, n2, T2) - kb*T2*log(n2_data->Nv()) + mt->band->Eg(ctx2, T2));//valence band energy level
         if(get_advanced_model()->Fermi)
         {
           Ec2 = Ec2 - kb*T2*log(gamma_f(fabs(n2)/n2_data->Nc()));
           Ev2 = Ev2 + kb*T2*log(gamma_f(fabs(p2)/n2_data->Nv()));
         }
         PetscScalar eps2 =  n2_data->eps();                         // eps
-        AutoDScalar Eg2  = mt->band->Eg(T2);
-        AutoDScalar kap2 =  mt->thermal->HeatConduction(T2);
+        AutoDScalar Eg2  = mt->band->Eg(ctx2, T2);
+        AutoDScalar kap2 =  mt->thermal->HeatConduction(ctx2, T2);
 
 
         AutoDScalar mun1;   // electron mobility for node 1 of the edge
@@ -991,34 +1139,28 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
             if(mos_channel_elem)
               Et = (E - (E*dir)*dir).size();
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Ep, Et, T1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Ep, Et, T1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Ep, Et, T1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Ep, Et, T1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Ep, Et, T2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Ep, Et, T2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Ep, Et, T2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Ep, Et, T2);
           }
           else // ModelSpecify::EJ || ModelSpecify::EQF
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Epn, Etn, T1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Epp, Etp, T1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Epn, Etn, T1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Epp, Etp, T1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Epn, Etn, T2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Epp, Etp, T2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Epn, Etn, T2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Epp, Etp, T2);
           }
         }
         else
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T1, 0, 0, T1);
-          mup1 = mt->mob->HoleMob(p1, n1, T1, 0, 0, T1);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, 0, 0, T1);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, 0, 0, T1);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T2, 0, 0, T2);
-          mup2 = mt->mob->HoleMob(p2, n2, T2, 0, 0, T2);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, 0, 0, T2);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, 0, 0, T2);
         }
 
         AutoDScalar mun = 0.5*(mun1+mun2);  // the electron mobility at the mid point of the edge, use linear interpolation
@@ -1040,7 +1182,7 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
 #endif
 
         // ignore thoese ghost nodes (ghost nodes is local but with different processor_id())
-        if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+        if( n1_on_processor )
         {
           AutoDScalar ff1 = ( eps*(V2 - V1)/length*partial_area );
 
@@ -1057,7 +1199,7 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
           jac->add_row(  row[3],  cell_col.size(),  &cell_col[0],  ff4.getADValue() );
         }
 
-        if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+        if( n2_on_processor )
         {
           AutoDScalar ff1 = ( eps*(V1 - V2)/length*partial_area );
 
@@ -1075,10 +1217,10 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
 
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
-          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(T1, E.size());
-          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(T2, E.size());
+          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T1, E.size());
+          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T2, E.size());
 
-          if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+          if( n1_on_processor )
           {
             // continuity equation
             AutoDScalar continuity = 0.5*GBTBT1*truncated_partial_volume;
@@ -1086,7 +1228,7 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
             jac->add_row(  row[2],  cell_col.size(),  &cell_col[0],  continuity.getADValue() );
           }
 
-          if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+          if( n2_on_processor )
           {
             // continuity equation
             AutoDScalar continuity = 0.5*GBTBT2*truncated_partial_volume;
@@ -1118,20 +1260,20 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
           case ModelSpecify::IIForce_EdotJ:
             Epn = adtl::fmax(E.dot(Jnv.unit(true)), 0.0);
             Epp = adtl::fmax(E.dot(Jpv.unit(true)), 0.0);
-            IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-            IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
             break;
           case ModelSpecify::EVector:
-            IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
             break;
           case ModelSpecify::ESide:
-            IIn = mt->gen->ElecGenRate(T,fabs(Ec2-Ec1)/e/length,Eg);
-            IIp = mt->gen->HoleGenRate(T,fabs(Ev2-Ev1)/e/length,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,fabs(Ec2-Ec1)/e/length,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,fabs(Ev2-Ev1)/e/length,Eg);
             break;
           case ModelSpecify::GradQf:
-            IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
             break;
           default:
             {
@@ -1142,7 +1284,7 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
           GIIn = IIn * fabs(Jn)/e;
           GIIp = IIp * fabs(Jp)/e;
 
-          if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+          if( n1_on_processor )
           {
             // continuity equation
             AutoDScalar electron_continuity = (riin1*GIIn+riip1*GIIp)*truncated_partial_volume ;
@@ -1151,7 +1293,7 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
             jac->add_row(  row[2],  cell_col.size(),  &cell_col[0],  hole_continuity.getADValue() );
           }
 
-          if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+          if( n2_on_processor )
           {
             // continuity equation
             AutoDScalar electron_continuity = (riin2*GIIn+riip2*GIIp)*truncated_partial_volume ;
@@ -1165,13 +1307,16 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
     }// end of scan all edges of the cell
 
   }// end of scan all the cell
+}
 
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
 
-  // process node related terms
-  // including \rho of poisson's equation and recombination term of continuation equation
+/*---------------------------------------------------------------------
+ * node related terms of on processor nodes [begin, end), AD version
+ */
+void SemiconductorSimulationRegion::DDM2_Jacobian_Node(DDM2_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  const PetscScalar * x = data.x;
+  SparseMatrix<PetscScalar> * jac = data.jac[thread];
 
   //the indepedent variable number, 4 for each node
   adtl::AutoDScalar::numdir = 4;
@@ -1179,8 +1324,8 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
   //synchronize with material database
   mt->set_ad_num(adtl::AutoDScalar::numdir);
 
-  const_processor_node_iterator node_it = on_processor_nodes_begin();
-  const_processor_node_iterator node_it_end = on_processor_nodes_end();
+  const_processor_node_iterator node_it = on_processor_nodes_begin() + begin;
+  const_processor_node_iterator node_it_end = on_processor_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     const FVM_Node * fvm_node = *node_it;
@@ -1194,8 +1339,8 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
     AutoDScalar p   =  x[fvm_node->local_offset()+2];   p.setADValue(2, 1.0);              // hole density
     AutoDScalar T   =  x[fvm_node->local_offset()+3];   T.setADValue(3, 1.0);              // hole density
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);                   // map this node and its data to material database
-    AutoDScalar R   = mt->band->Recomb(p, n, T)*fvm_node->volume();                      // the recombination term
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);                   // map this node and its data to material database
+    AutoDScalar R   = mt->band->Recomb(ctx, p, n, T)*fvm_node->volume();                      // the recombination term
     AutoDScalar rho = e*(node_data->Net_doping() + p - n)*fvm_node->volume();              // the charge density
     AutoDScalar HR  = R*(node_data->Eg()+3*kb*T);                                          // heat due to carrier recombination
 
@@ -1207,37 +1352,26 @@ void SemiconductorSimulationRegion::DDM2_Jacobian(PetscScalar * x, SparseMatrix<
 
     if (get_advanced_model()->Trap)
     {
-      AutoDScalar ni = mt->band->nie(p, n, T);
-      mt->trap->Calculate(true,p,n,ni,T);
+      AutoDScalar ni = mt->band->nie(ctx, p, n, T);
+      mt->trap->Calculate(ctx, true,p,n,ni,T);
 
-      AutoDScalar TrappedC = mt->trap->ChargeAD(true) * fvm_node->volume();
+      AutoDScalar TrappedC = mt->trap->ChargeAD(ctx, true) * fvm_node->volume();
       jac->add_row(  index[0],  4,  &index[0],  TrappedC.getADValue() );
 
-      AutoDScalar GElec = - mt->trap->ElectronTrapRate(true,n,ni,T) * fvm_node->volume();
-      AutoDScalar GHole = - mt->trap->HoleTrapRate    (true,p,ni,T) * fvm_node->volume();
+      AutoDScalar GElec = - mt->trap->ElectronTrapRate(ctx, true,n,ni,T) * fvm_node->volume();
+      AutoDScalar GHole = - mt->trap->HoleTrapRate    (ctx, true,p,ni,T) * fvm_node->volume();
 
       jac->add_row(  index[1],  4,  &index[0],  GElec.getADValue() );
       jac->add_row(  index[2],  4,  &index[0],  GHole.getADValue() );
 
       AutoDScalar EcEi = 0.5*node_data->Eg() - kb*T*log(node_data->Nc()/node_data->Nv());
       AutoDScalar EiEv = 0.5*node_data->Eg() + kb*T*log(node_data->Nc()/node_data->Nv());
-      AutoDScalar H = mt->trap->TrapHeat(true,p,n,ni,T,T,T,EcEi,EiEv);
+      AutoDScalar H = mt->trap->TrapHeat(ctx, true,p,n,ni,T,T,T,EcEi,EiEv);
       jac->add_row(  index[3],  4,  &index[0],  (H*fvm_node->volume()).getADValue() );
 
     }
 
   }
-
-
-  // boundary condition should be processed later!
-
-  // the last operator is ADD_VALUES
-  add_value_flag = ADD_VALUES;
-
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
-
 }
 
 
@@ -1269,14 +1403,14 @@ void SemiconductorSimulationRegion::DDM2_Time_Dependent_Function(PetscScalar * x
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     //PetscScalar V   =  x[fvm_node->local_offset()+0];                         // electrostatic potential
     PetscScalar n   =  x[fvm_node->local_offset()+1];                         // electron density
     PetscScalar p   =  x[fvm_node->local_offset()+2];                         // hole density
     PetscScalar T   =  x[fvm_node->local_offset()+3];                         // lattice temperature
 
-    PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(T);
+    PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(ctx, T);
 
     // process \partial t
 
@@ -1342,7 +1476,7 @@ void SemiconductorSimulationRegion::DDM2_Time_Dependent_Jacobian(PetscScalar * x
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     PetscInt index[4] = {fvm_node->global_offset()+0, fvm_node->global_offset()+1, fvm_node->global_offset()+2, fvm_node->global_offset()+3};
 
@@ -1351,7 +1485,7 @@ void SemiconductorSimulationRegion::DDM2_Time_Dependent_Jacobian(PetscScalar * x
     AutoDScalar p   =  x[fvm_node->local_offset()+2];   p.setADValue(2, 1.0);              // hole density
     AutoDScalar T   =  x[fvm_node->local_offset()+3];   T.setADValue(3, 1.0);              // lattice temperature
 
-    AutoDScalar HeatCapacity =  mt->thermal->HeatCapacity(T);
+    AutoDScalar HeatCapacity =  mt->thermal->HeatCapacity(ctx, T);
 
     // process \partial t
 
@@ -1558,9 +1692,47 @@ int SemiconductorSimulationRegion::DDM2_Pseudo_Time_Step_Convergence_Test(PetscS
 
 void SemiconductorSimulationRegion::DDM2_Update_Solution(PetscScalar *lxx)
 {
+  // update node data of each local node
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, PetscScalar *>
+        node_loop(this, &SemiconductorSimulationRegion::DDM2_Update_Solution_Node, lxx);
+    Genius::parallel_for(on_local_nodes_end()-on_local_nodes_begin(), node_loop);
+  }
+
+  // addtional work: compute electrical field for all the cell.
+  // Since this value is only used for reference.
+  // It can be done simply by weighted average of cell's electrical field
+  for(unsigned int n=0; n<n_cell(); ++n)
+  {
+    const Elem * elem = this->get_region_elem(n);
+    FVM_CellData * elem_data = this->get_region_elem_data(n);
+
+    std::vector<PetscScalar> psi_vertex;
 
-  local_node_iterator node_it = on_local_nodes_begin();
-  local_node_iterator node_it_end = on_local_nodes_end();
+    for(unsigned int nd=0; nd<elem->n_nodes(); ++nd)
+    {
+      const FVM_Node * fvm_node = elem->get_fvm_node(nd);
+      const FVM_NodeData * fvm_node_data = fvm_node->node_data();
+      psi_vertex.push_back  ( fvm_node_data->psi() );
+    }
+    // compute the gradient in the cell
+    elem_data->E()  = - elem->gradient(psi_vertex);  // E = - grad(psi)
+  }
+
+
+  // calculate mobility on node
+  Mob_Evaluation();
+
+}
+
+
+/*---------------------------------------------------------------------
+ * update node data of local nodes [begin, end)
+ */
+void SemiconductorSimulationRegion::DDM2_Update_Solution_Node(PetscScalar * &lxx, unsigned int , unsigned int begin, unsigned int end)
+{
+  local_node_iterator node_it = on_local_nodes_begin() + begin;
+  local_node_iterator node_it_end = on_local_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     FVM_Node * fvm_node = *node_it;
@@ -1591,10 +1763,10 @@ void SemiconductorSimulationRegion::DDM2_Update_Solution(PetscScalar *lxx)
     node_data->T()        =  T;
 
     // update buffered parameters dependent on temperature
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
-    node_data->Eg() = mt->band->Eg(T) - mt->band->EgNarrow(p, n, T);
-    node_data->Ec() = -(e*V + node_data->affinity() + mt->band->EgNarrowToEc(p, n, T));
-    node_data->Ev() = -(e*V + node_data->affinity() - mt->band->EgNarrowToEv(p, n, T) + mt->band->Eg(T));
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    node_data->Eg() = mt->band->Eg(ctx, T) - mt->band->EgNarrow(ctx, p, n, T);
+    node_data->Ec() = -(e*V + node_data->affinity() + mt->band->EgNarrowToEc(ctx, p, n, T));
+    node_data->Ev() = -(e*V + node_data->affinity() - mt->band->EgNarrowToEv(ctx, p, n, T) + mt->band->Eg(ctx, T));
 
     if(get_advanced_model()->Fermi)
     {
@@ -1607,48 +1779,22 @@ void SemiconductorSimulationRegion::DDM2_Update_Solution(PetscScalar *lxx)
       node_data->qFp() = node_data->Ev() - log(fabs(p/node_data->Nv()))*kb*T;
     }
 
-    node_data->Nc() = mt->band->Nc(T);
-    node_data->Nv() = mt->band->Nv(T);
+    node_data->Nc() = mt->band->Nc(ctx, T);
+    node_data->Nv() = mt->band->Nv(ctx, T);
 
-    node_data->Recomb() = mt->band->Recomb(p, n, T);
-    node_data->Recomb_Dir() = mt->band->R_Direct(p, n, T);
-    node_data->Recomb_SRH() = mt->band->R_SHR(p, n, T);
-    node_data->Recomb_Auger() = mt->band->R_Auger(p, n, T);
+    node_data->Recomb() = mt->band->Recomb(ctx, p, n, T);
+    node_data->Recomb_Dir() = mt->band->R_Direct(ctx, p, n, T);
+    node_data->Recomb_SRH() = mt->band->R_SHR(ctx, p, n, T);
+    node_data->Recomb_Auger() = mt->band->R_Auger(ctx, p, n, T);
 
     if (get_advanced_model()->Trap)
     {
       // update traps
-      mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
-      mt->trap->Update(true, p, n, node_data->ni(), T_external());
-      mt->trap->Update(false, p, n, node_data->ni(), T_external());
+      mt->trap->Update(ctx, true, p, n, node_data->ni(), T_external());
+      mt->trap->Update(ctx, false, p, n, node_data->ni(), T_external());
     }
 
   }
-
-  // addtional work: compute electrical field for all the cell.
-  // Since this value is only used for reference.
-  // It can be done simply by weighted average of cell's electrical field
-  for(unsigned int n=0; n<n_cell(); ++n)
-  {
-    const Elem * elem = this->get_region_elem(n);
-    FVM_CellData * elem_data = this->get_region_elem_data(n);
-
-    std::vector<PetscScalar> psi_vertex;
-
-    for(unsigned int nd=0; nd<elem->n_nodes(); ++nd)
-    {
-      const FVM_Node * fvm_node = elem->get_fvm_node(nd);
-      const FVM_NodeData * fvm_node_data = fvm_node->node_data();
-      psi_vertex.push_back  ( fvm_node_data->psi() );
-    }
-    // compute the gradient in the cell
-    elem_data->E()  = - elem->gradient(psi_vertex);  // E = - grad(psi)
-  }
-
-
-  // calculate mobility on node
-  Mob_Evaluation();
-
 }
 
 
@@ -236,6 +236,9 @@ int DDMACSolver::pre_solve_process ( bool /*load_solution*/ )
   MatCopy(Jac->mat(), J_, DIFFERENT_NONZERO_PATTERN);
   delete Jac;
 
+  // frequency independent matrices depend on J_
+  clear_ddm_ac_cache();
+
   // restore array back to Vec
   VecRestoreArray ( ls, &lss );
 
@@ -283,6 +286,13 @@ int DDMACSolver::solve()
 
   this->pre_solve_process();
 
+  if ( SolverSpecify::ACMOR )
+  {
+    int ierr = solve_mor();
+    STOP_LOG ( "solve()", "DDMACSolver" );
+    return ierr;
+  }
+
   for ( SolverSpecify::Freq = SolverSpecify::FStart; SolverSpecify::Freq <= SolverSpecify::FStop;  )
   {
 
@@ -393,6 +403,16 @@ int DDMACSolver::destroy_solver()
 
   if ( !_first_create ) MatDestroy ( PetscDestroyObject(C_) );
 
+  clear_ddm_ac_cache();
+
+  mor_clear();
+  if ( _b_created )
+  {
+    MatDestroy ( PetscDestroyObject(B_) );
+    VecDestroy ( PetscDestroyObject(bb_) );
+    _b_created = false;
+  }
+
   return FVM_LinearSolver::destroy_solver();
 }
 
@@ -419,18 +439,27 @@ void DDMACSolver::build_ddm_ac ( PetscScalar omega )
 
   START_LOG ( "build_ddm_ac()", "DDMACSolver" );
 
+  if ( SolverSpecify::ACAssembleOnce && !_ac_cached )
+    build_ddm_ac_cache();
+
   // flag for indicate ADD_VALUES operator.
   InsertMode add_value_flag = NOT_SET_VALUES;
 
   MatZeroEntries ( A_ );
   VecZeroEntries ( b_ );
 
-  // evaluate Jacobian matrix of governing equations of EBM for all the regions
-  for ( unsigned int n=0; n<_system.n_regions(); n++ )
+  if ( SolverSpecify::ACAssembleOnce )
   {
-    SimulationRegion * region = _system.region ( n );
-    region->DDMAC_Fill_Matrix_Vector ( A_, b_, J_, omega, add_value_flag );
+    // region part by linear combination, the boundaries may add extra nonzeros
+    // at the first frequency, after that A_ keeps its nonzero pattern
+    MatAXPY ( A_, 1.0,   Ar0_, SUBSET_NONZERO_PATTERN );
+    MatAXPY ( A_, omega, Ar1_, SUBSET_NONZERO_PATTERN );
+    VecAXPY ( b_, 1.0,   br0_ );
+    VecAXPY ( b_, omega, br1_ );
+    add_value_flag = ADD_VALUES;
   }
+  else
+    build_ddm_ac_region ( omega, add_value_flag );
 
   // evaluate Jacobian matrix of governing equations of EBM for all the boundaries
   for ( unsigned int n=0; n<_system.get_bcs()->n_bcs(); ++n )
@@ -450,39 +479,27 @@ void DDMACSolver::build_ddm_ac ( PetscScalar omega )
 
   // process transformation matrix
   {
-    MatZeroEntries ( T_ );
-    add_value_flag = NOT_SET_VALUES;
-    for ( unsigned int n=0; n<_system.n_regions(); n++ )
+    if ( SolverSpecify::ACAssembleOnce )
     {
-      SimulationRegion * region = _system.region ( n );
-      region->DDMAC_Fill_Transformation_Matrix ( T_, J_, omega, add_value_flag );
+      MatCopy ( T0_, T_, SAME_NONZERO_PATTERN );
+      MatAXPY ( T_, omega, T1_, SAME_NONZERO_PATTERN );
     }
+    else
+      build_transformation_matrix ( omega );
 
-    if(Genius::processor_id() == Genius::n_processors() -1)
-    {
-      for ( unsigned int n=0; n<_system.get_bcs()->n_bcs(); ++n )
-      {
-        BoundaryCondition * bc = _system.get_bcs()->get_bc ( n );
-        if ( !bc->is_electrode() ) continue;
-        MatSetValue ( T_, bc->global_offset(), bc->global_offset(), 1.0, ADD_VALUES );
-        MatSetValue ( T_, bc->global_offset() +1, bc->global_offset() +1, 1.0, ADD_VALUES );
-      }
-    }
-
-    // assembly the transformation matrix
-    MatAssemblyBegin ( T_, MAT_FINAL_ASSEMBLY );
-    MatAssemblyEnd ( T_, MAT_FINAL_ASSEMBLY );
-
-
-    // do transport
+    // do transport, A keeps the nonzero pattern of C_ after the first frequency,
+    // then the symbolic factorization of A can be reused
     if ( _first_create )
     {
       MatMatMult ( T_, A_, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &C_ );
+      MatCopy ( C_, A, DIFFERENT_NONZERO_PATTERN );
       _first_create = false;
     }
     else
+    {
       MatMatMult ( T_, A_, MAT_REUSE_MATRIX , PETSC_DEFAULT, &C_ );
-    MatCopy(C_, A, DIFFERENT_NONZERO_PATTERN);
+      MatCopy ( C_, A, SAME_NONZERO_PATTERN );
+    }
 
     MatMult ( T_, b_, b );
   }
@@ -496,3 +513,120 @@ void DDMACSolver::build_ddm_ac ( PetscScalar omega )
 }
 
 
+
+/*------------------------------------------------------------------
+ * fill region part of matrix A_ and vector b_ with certain freq omega
+ */
+void DDMACSolver::build_ddm_ac_region ( PetscScalar omega, InsertMode &add_value_flag )
+{
+  // evaluate Jacobian matrix of governing equations of EBM for all the regions
+  for ( unsigned int n=0; n<_system.n_regions(); n++ )
+  {
+    SimulationRegion * region = _system.region ( n );
+    region->DDMAC_Fill_Matrix_Vector ( A_, b_, J_, omega, add_value_flag );
+  }
+}
+
+
+
+/*------------------------------------------------------------------
+ * build the transformation matrix T_ with certain freq omega
+ */
+void DDMACSolver::build_transformation_matrix ( PetscScalar omega )
+{
+  MatZeroEntries ( T_ );
+
+  InsertMode add_value_flag = NOT_SET_VALUES;
+  for ( unsigned int n=0; n<_system.n_regions(); n++ )
+  {
+    SimulationRegion * region = _system.region ( n );
+    region->DDMAC_Fill_Transformation_Matrix ( T_, J_, omega, add_value_flag );
+  }
+
+  if(Genius::processor_id() == Genius::n_processors() -1)
+  {
+    for ( unsigned int n=0; n<_system.get_bcs()->n_bcs(); ++n )
+    {
+      BoundaryCondition * bc = _system.get_bcs()->get_bc ( n );
+      if ( !bc->is_electrode() ) continue;
+      MatSetValue ( T_, bc->global_offset(), bc->global_offset(), 1.0, ADD_VALUES );
+      MatSetValue ( T_, bc->global_offset() +1, bc->global_offset() +1, 1.0, ADD_VALUES );
+    }
+  }
+
+  // assembly the transformation matrix
+  MatAssemblyBegin ( T_, MAT_FINAL_ASSEMBLY );
+  MatAssemblyEnd ( T_, MAT_FINAL_ASSEMBLY );
+}
+
+
+
+/*------------------------------------------------------------------
+ * the region part of A_ and b_ as well as T_ are linear to omega.
+ * since J is real, omega only appears in the blocks coupling real and
+ * image parts, so the difference of fills at omega=1 and omega=0 gives
+ * the exact coefficient of omega.
+ */
+void DDMACSolver::build_ddm_ac_cache()
+{
+  START_LOG ( "build_ddm_ac_cache()", "DDMACSolver" );
+
+  // region part at omega = 0
+  InsertMode add_value_flag = NOT_SET_VALUES;
+  MatZeroEntries ( A_ );
+  VecZeroEntries ( b_ );
+  build_ddm_ac_region ( 0.0, add_value_flag );
+  MatAssemblyBegin ( A_, MAT_FINAL_ASSEMBLY );
+  MatAssemblyEnd ( A_, MAT_FINAL_ASSEMBLY );
+  VecAssemblyBegin ( b_ );
+  VecAssemblyEnd ( b_ );
+  MatDuplicate ( A_, MAT_COPY_VALUES, &Ar0_ );
+  VecDuplicate ( b_, &br0_ );
+  VecCopy ( b_, br0_ );
+
+  // region part at omega = 1
+  add_value_flag = NOT_SET_VALUES;
+  MatZeroEntries ( A_ );
+  VecZeroEntries ( b_ );
+  build_ddm_ac_region ( 1.0, add_value_flag );
+  MatAssemblyBegin ( A_, MAT_FINAL_ASSEMBLY );
+  MatAssemblyEnd ( A_, MAT_FINAL_ASSEMBLY );
+  VecAssemblyBegin ( b_ );
+  VecAssemblyEnd ( b_ );
+  MatDuplicate ( A_, MAT_COPY_VALUES, &Ar1_ );
+  VecDuplicate ( b_, &br1_ );
+  VecCopy ( b_, br1_ );
+
+  MatAXPY ( Ar1_, -1.0, Ar0_, SAME_NONZERO_PATTERN );
+  VecAXPY ( br1_, -1.0, br0_ );
+
+  // transformation matrix
+  build_transformation_matrix ( 0.0 );
+  MatDuplicate ( T_, MAT_COPY_VALUES, &T0_ );
+  build_transformation_matrix ( 1.0 );
+  MatDuplicate ( T_, MAT_COPY_VALUES, &T1_ );
+  MatAXPY ( T1_, -1.0, T0_, SAME_NONZERO_PATTERN );
+
+  _ac_cached = true;
+
+  STOP_LOG ( "build_ddm_ac_cache()", "DDMACSolver" );
+}
+
+
+
+/*------------------------------------------------------------------
+ * free the frequency independent matrices
+ */
+void DDMACSolver::clear_ddm_ac_cache()
+{
+  if ( !_ac_cached ) return;
+
+  MatDestroy ( PetscDestroyObject(Ar0_) );
+  MatDestroy ( PetscDestroyObject(Ar1_) );
+  VecDestroy ( PetscDestroyObject(br0_) );
+  VecDestroy ( PetscDestroyObject(br1_) );
+  MatDestroy ( PetscDestroyObject(T0_) );
+  MatDestroy ( PetscDestroyObject(T1_) );
+
+  _ac_cached = false;
+}
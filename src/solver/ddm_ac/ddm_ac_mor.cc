@@ -0,0 +1,468 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+
+#include "ddm_ac/ddm_ac.h"
+#include "parallel.h"
+#include "mathfunc.h"  // for PI
+
+
+/**
+ * solve dense system A y = b of order n by gaussian elimination with partial pivoting,
+ * A is stored in row major and is destroyed. the solution is returned in b.
+ * @return false if A is singular
+ */
+static bool _dense_solve(std::vector<PetscScalar> &A, std::vector<PetscScalar> &b, unsigned int n)
+{
+  for ( unsigned int k=0; k<n; ++k )
+  {
+    unsigned int p = k;
+    for ( unsigned int i=k+1; i<n; ++i )
+      if ( std::abs ( A[i*n+k] ) > std::abs ( A[p*n+k] ) ) p = i;
+
+    if ( A[p*n+k] == 0.0 ) return false;
+
+    if ( p != k )
+    {
+      for ( unsigned int j=0; j<n; ++j ) std::swap ( A[k*n+j], A[p*n+j] );
+      std::swap ( b[k], b[p] );
+    }
+
+    for ( unsigned int i=k+1; i<n; ++i )
+    {
+      const PetscScalar f = A[i*n+k]/A[k*n+k];
+      if ( f == 0.0 ) continue;
+      for ( unsigned int j=k+1; j<n; ++j ) A[i*n+j] -= f*A[k*n+j];
+      b[i] -= f*b[k];
+    }
+  }
+
+  for ( unsigned int i=n; i-->0; )
+  {
+    PetscScalar sum = b[i];
+    for ( unsigned int j=i+1; j<n; ++j ) sum -= A[i*n+j]*b[j];
+    b[i] = sum/A[i*n+i];
+  }
+
+  return true;
+}
+
+
+
+/*------------------------------------------------------------------
+ * AC sweep by Krylov model order reduction.
+ * The AC system A(omega) x = b(omega) is projected to the orthonormal basis V
+ *   Vt*A(omega)*V y = Vt*b(omega),  x = V*y
+ * V is spanned by the solutions at a few expansion frequencies and their moments
+ *   A x_{m} = -dA/domega x_{m-1}
+ * which share the factorization of A at the expansion frequency. The region part of A
+ * is linear to omega and projected once, the boundary part only involves boundary rows
+ * and is projected at each frequency. The expansion frequencies are added greedily at
+ * the sweep frequency with the max residual until the reduced model reaches the tolerance.
+ */
+int DDMACSolver::solve_mor()
+{
+  MESSAGE<<"AC Scan by Krylov model order reduction\n"; RECORD();
+
+  // all the frequencies of the sweep
+  std::vector<PetscScalar> freqs;
+  for ( PetscScalar f = SolverSpecify::FStart; f <= SolverSpecify::FStop;  )
+  {
+    freqs.push_back ( f );
+    if( f < SolverSpecify::FStop && f*SolverSpecify::FMultiple > SolverSpecify::FStop)
+      f = SolverSpecify::FStop;
+    else
+      f *= SolverSpecify::FMultiple;
+  }
+  if ( freqs.empty() ) return 0;
+
+  // the region part of AC system, the cache is always used here
+  if ( !_ac_cached ) build_ddm_ac_cache();
+
+  mor_clear();
+
+  // index of expansion frequencies in freqs, start with both ends of the sweep
+  std::vector<unsigned int> expansions;
+  expansions.push_back ( 0 );
+  mor_expand ( 2*PI*freqs.front() );
+  if ( freqs.size() > 1 )
+  {
+    expansions.push_back ( freqs.size()-1 );
+    mor_expand ( 2*PI*freqs.back() );
+  }
+  mor_project();
+
+  while ( _mor_basis.size() < SolverSpecify::ACMORMaxBasis )
+  {
+    // test the reduced model at the middle of neighbor expansion frequencies
+    std::sort ( expansions.begin(), expansions.end() );
+
+    PetscReal err_max = 0.0;
+    unsigned int worst = 0;
+    for ( unsigned int i=1; i<expansions.size(); ++i )
+    {
+      if ( expansions[i] - expansions[i-1] < 2 ) continue;
+      const unsigned int mid = ( expansions[i] + expansions[i-1] )/2;
+      const PetscReal err = mor_solve ( 2*PI*freqs[mid], true );
+      if ( err > err_max ) { err_max = err; worst = mid; }
+    }
+
+    MESSAGE<<"------> reduced order " << _mor_basis.size() << ", max relative residual = " << err_max << "\n";
+    RECORD();
+
+    if ( err_max <= SolverSpecify::ACMORTolerance ) break;
+
+    MESSAGE<<"------> add expansion frequency " << std::scientific << freqs[worst]*PhysicalUnit::s/1e6 << " MHz\n";
+    RECORD();
+
+    const unsigned int n_basis = _mor_basis.size();
+    expansions.push_back ( worst );
+    mor_expand ( 2*PI*freqs[worst] );
+    mor_project();
+
+    // all the new vectors are linear dependent to the basis
+    if ( _mor_basis.size() == n_basis ) break;
+  }
+
+  MESSAGE<<"------> reduced order model with " << _mor_basis.size() << " basis vectors\n\n";
+  RECORD();
+
+  // evaluate the sweep by the reduced model
+  for ( unsigned int n=0; n<freqs.size(); ++n )
+  {
+    SolverSpecify::Freq = freqs[n];
+
+    MESSAGE
+    <<"AC Scan: f("<<SolverSpecify::Electrode_ACScan[0]<<") = "
+    << std::scientific
+    <<SolverSpecify::Freq*PhysicalUnit::s/1e6<<" MHz "<<"\n";
+    RECORD();
+
+    mor_solve ( 2*PI*SolverSpecify::Freq, false );
+
+    this->post_solve_process();
+  }
+
+  mor_clear();
+
+  return 0;
+}
+
+
+
+/*------------------------------------------------------------------
+ * fill the boundary part of AC matrix and rhs vector with certain freq omega
+ */
+void DDMACSolver::build_ddm_ac_boundary ( PetscScalar omega )
+{
+  if ( !_b_created )
+  {
+    // only boundary rows have entries, allocate them on the fly
+    MatCreate ( PETSC_COMM_WORLD, &B_ );
+    MatSetSizes ( B_, n_local_dofs, n_local_dofs, n_global_dofs, n_global_dofs );
+    if ( Genius::n_processors() >1 )
+    {
+      MatSetType ( B_, MATMPIAIJ );
+      MatMPIAIJSetPreallocation ( B_, 0, PETSC_NULL, 0, PETSC_NULL );
+    }
+    else
+    {
+      MatSetType ( B_, MATSEQAIJ );
+      MatSeqAIJSetPreallocation ( B_, 0, PETSC_NULL );
+    }
+    MatSetOption ( B_, MAT_NEW_NONZERO_LOCATIONS, PETSC_TRUE );
+#if PETSC_VERSION_GE(3,3,0)
+    MatSetOption ( B_, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE );
+#endif
+    VecDuplicate ( b_, &bb_ );
+  }
+
+  MatZeroEntries ( B_ );
+  VecZeroEntries ( bb_ );
+
+  // the same as build_ddm_ac, boundary conditions add to the region part
+  InsertMode add_value_flag = ADD_VALUES;
+  for ( unsigned int n=0; n<_system.get_bcs()->n_bcs(); ++n )
+  {
+    BoundaryCondition * bc = _system.get_bcs()->get_bc ( n );
+    bc->DDMAC_Fill_Matrix_Vector ( B_, bb_, J_, omega, add_value_flag );
+  }
+
+  MatAssemblyBegin ( B_, MAT_FINAL_ASSEMBLY );
+  MatAssemblyEnd ( B_, MAT_FINAL_ASSEMBLY );
+
+  VecAssemblyBegin ( bb_ );
+  VecAssemblyEnd ( bb_ );
+
+  if ( !_b_created )
+  {
+    // the nonzero rows of B_ does not change with omega
+    PetscInt begin, end;
+    MatGetOwnershipRange ( B_, &begin, &end );
+    for ( PetscInt row=begin; row<end; ++row )
+    {
+      PetscInt ncols;
+      MatGetRow ( B_, row, &ncols, PETSC_NULL, PETSC_NULL );
+      if ( ncols ) _b_rows.push_back ( row-begin );
+      MatRestoreRow ( B_, row, &ncols, PETSC_NULL, PETSC_NULL );
+    }
+    _b_created = true;
+  }
+}
+
+
+
+/*------------------------------------------------------------------
+ * full AC solve at expansion frequency, extend the basis with the solution and its moments
+ */
+void DDMACSolver::mor_expand ( PetscScalar omega )
+{
+  // A x = b at expansion frequency, the same as the direct sweep
+  build_ddm_ac ( omega );
+  KSPSolve ( ksp, b, x );
+
+  KSPConvergedReason reason;
+  KSPGetConvergedReason ( ksp, &reason );
+  if ( reason < 0 )
+  {
+    MESSAGE<<"------> linear solver " << KSPConvergedReasons[reason] << " at expansion frequency.\n"; RECORD();
+  }
+
+  Vec u, r;
+  VecDuplicate ( x, &u );
+  VecDuplicate ( x, &r );
+  VecCopy ( x, u );
+
+  // dA/domega = Ar1_ + dB/domega, the boundary part is not linear to omega
+  // and is differentiated by central difference
+  Mat dB = PETSC_NULL;
+  if ( SolverSpecify::ACMORMoments > 1 )
+  {
+    const PetscScalar h = omega != 0.0 ? 1e-6*std::abs ( omega ) : 1e-6*2*PI*SolverSpecify::FStop;
+    build_ddm_ac_boundary ( omega + h );
+    MatDuplicate ( B_, MAT_COPY_VALUES, &dB );
+    build_ddm_ac_boundary ( omega - h );
+    MatAXPY ( dB, -1.0, B_, DIFFERENT_NONZERO_PATTERN );
+    MatScale ( dB, 1.0/ ( 2*h ) );
+  }
+
+  std::vector<PetscScalar> h;
+  for ( unsigned int m=0; m<SolverSpecify::ACMORMoments; ++m )
+  {
+    if ( m > 0 )
+    {
+      // the next moment, A x_{m} = -dA/domega x_{m-1}, solved with the same operator of ksp
+      MatMult ( Ar1_, u, r );
+      MatMultAdd ( dB, u, r, r );
+      VecScale ( r, -1.0 );
+      MatMult ( T_, r, b );
+      KSPSolve ( ksp, b, u );
+    }
+
+    if ( _mor_basis.size() >= SolverSpecify::ACMORMaxBasis ) break;
+
+    // orthogonalize against the basis by modified gram-schmidt, twice is enough
+    Vec v;
+    VecDuplicate ( u, &v );
+    VecCopy ( u, v );
+
+    PetscReal norm0;
+    VecNorm ( v, NORM_2, &norm0 );
+    if ( norm0 == 0.0 ) { VecDestroy ( PetscDestroyObject(v) ); break; }
+
+    for ( unsigned int pass=0; pass<2 && !_mor_basis.empty(); ++pass )
+    {
+      h.resize ( _mor_basis.size() );
+      VecMDot ( v, _mor_basis.size(), &_mor_basis[0], &h[0] );
+      for ( unsigned int i=0; i<h.size(); ++i ) h[i] = -h[i];
+      VecMAXPY ( v, _mor_basis.size(), &h[0], &_mor_basis[0] );
+    }
+
+    PetscReal norm;
+    VecNorm ( v, NORM_2, &norm );
+
+    // deflate the linear dependent vector
+    if ( norm < 1e-10*norm0 ) { VecDestroy ( PetscDestroyObject(v) ); continue; }
+
+    VecScale ( v, 1.0/norm );
+    _mor_basis.push_back ( v );
+
+    // keep the moment in a moderate scale
+    VecScale ( u, 1.0/norm0 );
+  }
+
+  VecDestroy ( PetscDestroyObject(u) );
+  VecDestroy ( PetscDestroyObject(r) );
+  if ( dB ) MatDestroy ( PetscDestroyObject(dB) );
+}
+
+
+
+/*------------------------------------------------------------------
+ * project the frequency independent region part to the basis
+ */
+void DDMACSolver::mor_project()
+{
+  const unsigned int k = _mor_basis.size();
+
+  _mor_G.assign ( k*k, 0.0 );
+  _mor_K.assign ( k*k, 0.0 );
+  _mor_g0.assign ( k, 0.0 );
+  _mor_g1.assign ( k, 0.0 );
+  if ( !k ) return;
+
+  Vec w;
+  VecDuplicate ( _mor_basis[0], &w );
+
+  std::vector<PetscScalar> col ( k );
+  for ( unsigned int j=0; j<k; ++j )
+  {
+    MatMult ( Ar0_, _mor_basis[j], w );
+    VecMDot ( w, k, &_mor_basis[0], &col[0] );
+    for ( unsigned int i=0; i<k; ++i ) _mor_G[i*k+j] = col[i];
+
+    MatMult ( Ar1_, _mor_basis[j], w );
+    VecMDot ( w, k, &_mor_basis[0], &col[0] );
+    for ( unsigned int i=0; i<k; ++i ) _mor_K[i*k+j] = col[i];
+  }
+
+  VecMDot ( br0_, k, &_mor_basis[0], &_mor_g0[0] );
+  VecMDot ( br1_, k, &_mor_basis[0], &_mor_g1[0] );
+
+  VecDestroy ( PetscDestroyObject(w) );
+}
+
+
+
+/*------------------------------------------------------------------
+ * solve the reduced system with certain freq omega
+ */
+PetscReal DDMACSolver::mor_solve ( PetscScalar omega, bool residual )
+{
+  START_LOG ( "mor_solve()", "DDMACSolver" );
+
+  const unsigned int k = _mor_basis.size();
+
+  build_ddm_ac_boundary ( omega );
+
+  // the reduced matrix and rhs vector
+  std::vector<PetscScalar> Ar ( k*k ), br ( k );
+  for ( unsigned int i=0; i<k*k; ++i ) Ar[i] = _mor_G[i] + omega*_mor_K[i];
+
+  VecMDot ( bb_, k, &_mor_basis[0], &br[0] );
+  for ( unsigned int i=0; i<k; ++i ) br[i] += _mor_g0[i] + omega*_mor_g1[i];
+
+  // Vt*B_*V, only the nonzero rows of B_ contribute
+  {
+    Vec w;
+    VecDuplicate ( bb_, &w );
+
+    std::vector<PetscScalar *> v ( k );
+    for ( unsigned int i=0; i<k; ++i ) VecGetArray ( _mor_basis[i], &v[i] );
+
+    std::vector<PetscScalar> Br ( k*k, 0.0 );
+    for ( unsigned int j=0; j<k; ++j )
+    {
+      VecRestoreArray ( _mor_basis[j], &v[j] );
+      MatMult ( B_, _mor_basis[j], w );
+      VecGetArray ( _mor_basis[j], &v[j] );
+
+      PetscScalar * ww;
+      VecGetArray ( w, &ww );
+      for ( unsigned int i=0; i<k; ++i )
+        for ( unsigned int r=0; r<_b_rows.size(); ++r )
+          Br[i*k+j] += v[i][_b_rows[r]]*ww[_b_rows[r]];
+      VecRestoreArray ( w, &ww );
+    }
+
+    for ( unsigned int i=0; i<k; ++i ) VecRestoreArray ( _mor_basis[i], &v[i] );
+
+    Parallel::sum ( Br );
+    for ( unsigned int i=0; i<k*k; ++i ) Ar[i] += Br[i];
+
+    VecDestroy ( PetscDestroyObject(w) );
+  }
+
+  if ( !_dense_solve ( Ar, br, k ) )
+  {
+    // singular reduced model, fall back to the full system and mark this frequency for expansion
+    build_ddm_ac ( omega );
+    KSPSolve ( ksp, b, x );
+    STOP_LOG ( "mor_solve()", "DDMACSolver" );
+    return residual ? 1.0 : 0.0;
+  }
+
+  // x = V*y
+  VecZeroEntries ( x );
+  VecMAXPY ( x, k, &br[0], &_mor_basis[0] );
+
+  PetscReal err = 0.0;
+  if ( residual )
+  {
+    // r = b(omega) - A(omega)*x
+    Vec r, w;
+    VecDuplicate ( x, &r );
+    VecDuplicate ( x, &w );
+
+    MatMult ( Ar0_, x, r );
+    MatMult ( Ar1_, x, w );
+    VecAXPY ( r, omega, w );
+    MatMult ( B_, x, w );
+    VecAXPY ( r, 1.0, w );
+
+    VecWAXPY ( w, omega, br1_, br0_ );
+    VecAXPY ( w, 1.0, bb_ );
+    VecAYPX ( r, -1.0, w );
+
+    PetscReal rnorm, bnorm;
+    VecNorm ( r, NORM_2, &rnorm );
+    VecNorm ( w, NORM_2, &bnorm );
+    err = bnorm > 0.0 ? rnorm/bnorm : rnorm;
+
+    VecDestroy ( PetscDestroyObject(r) );
+    VecDestroy ( PetscDestroyObject(w) );
+  }
+
+  STOP_LOG ( "mor_solve()", "DDMACSolver" );
+
+  return err;
+}
+
+
+
+/*------------------------------------------------------------------
+ * free the projection basis
+ */
+void DDMACSolver::mor_clear()
+{
+  for ( unsigned int i=0; i<_mor_basis.size(); ++i )
+    VecDestroy ( PetscDestroyObject(_mor_basis[i]) );
+  _mor_basis.clear();
+
+  _mor_G.clear();
+  _mor_K.clear();
+  _mor_g0.clear();
+  _mor_g1.clear();
+}
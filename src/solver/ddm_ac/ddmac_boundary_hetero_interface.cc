@@ -53,6 +53,7 @@ void HeteroInterfaceBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, con
     AutoDScalar Tn0;
     AutoDScalar Tp0;
     Material::MaterialSemiconductor * mt0;
+    PMI_Context ctx0;
     AutoDScalar Ec0,Ev0;
 
     // search all the fvm_node which has *node_it as root node, these nodes are the same in geometry,
@@ -122,10 +123,10 @@ void HeteroInterfaceBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, con
           Tp0 = T0;
 
         mt0 = semi_region->material();
-        mt0->mapping(fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock);
+        ctx0 = mt0->mapping(fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock);
 
-        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(p0, n0, T0) + kb*T0*log(n0_data->Nc()));
-        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(p0, n0, T0) - kb*T0*log(n0_data->Nv()) + mt0->band->Eg(T0));
+        Ec0 =  -(e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc(ctx0, p0, n0, T0) + kb*T0*log(n0_data->Nc()));
+        Ev0 =  -(e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv(ctx0, p0, n0, T0) - kb*T0*log(n0_data->Nv()) + mt0->band->Eg(ctx0, T0));
         if(semi_region->get_advanced_model()->Fermi)
         {
           Ec0 = Ec0 - kb*T0*log(gamma_f(fabs(n0)/n0_data->Nc()));
@@ -185,9 +186,9 @@ void HeteroInterfaceBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, con
 
               // mapping this node to material library
               Material::MaterialSemiconductor *mt = semi_region->material();
-              mt->mapping(fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock);
-              AutoDScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(p, n, T) + kb*T*log(n_data->Nc()));
-              AutoDScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(T));
+              const PMI_Context ctx = mt->mapping(fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock);
+              AutoDScalar Ec =  -(e*V + n_data->affinity() + mt->band->EgNarrowToEc(ctx, p, n, T) + kb*T*log(n_data->Nc()));
+              AutoDScalar Ev =  -(e*V + n_data->affinity() - mt->band->EgNarrowToEv(ctx, p, n, T) - kb*T*log(n_data->Nv()) + mt->band->Eg(ctx, T));
               if(semi_region->get_advanced_model()->Fermi)
               {
                 Ec = Ec - kb*T*log(gamma_f(fabs(n)/n_data->Nc()));
@@ -231,30 +232,30 @@ void HeteroInterfaceBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, con
               if(Ec0 > Ec)
               {
                 // Jn is enter region 0
-                AutoDScalar pm = mt0->band->EffecElecMass(T)/mt->band->EffecElecMass(T);
-                Jn =  2*e*(mt0->band->ThermalVn(T)*n0 - pm*mt->band->ThermalVn(T)*n*exp(-(Ec0-Ec)/(kb*T)))*cv_boundary;
-                Sn = -2*e*(mt0->band->ThermalVn(T)*n0*2.5*kb*Tn0 - pm*mt->band->ThermalVn(T)*n*exp(-(Ec0-Ec)/(kb*T))*2.5*kb*Tn)*cv_boundary;
+                AutoDScalar pm = mt0->band->EffecElecMass(ctx0, T)/mt->band->EffecElecMass(ctx, T);
+                Jn =  2*e*(mt0->band->ThermalVn(ctx0, T)*n0 - pm*mt->band->ThermalVn(ctx, T)*n*exp(-(Ec0-Ec)/(kb*T)))*cv_boundary;
+                Sn = -2*e*(mt0->band->ThermalVn(ctx0, T)*n0*2.5*kb*Tn0 - pm*mt->band->ThermalVn(ctx, T)*n*exp(-(Ec0-Ec)/(kb*T))*2.5*kb*Tn)*cv_boundary;
               }
               else
               {
                 // Jn is left region 0
-                AutoDScalar pm = mt->band->EffecElecMass(T)/mt0->band->EffecElecMass(T);
-                Jn = -2*e*(mt->band->ThermalVn(T)*n - pm*mt0->band->ThermalVn(T)*n0*exp(-(Ec-Ec0)/(kb*T)))*cv_boundary;
-                Sn =  2*e*(mt->band->ThermalVn(T)*n*2.5*kb*Tn - pm*mt0->band->ThermalVn(T)*n0*exp(-(Ec-Ec0)/(kb*T))*2.5*kb*Tn0)*cv_boundary;
+                AutoDScalar pm = mt->band->EffecElecMass(ctx, T)/mt0->band->EffecElecMass(ctx0, T);
+                Jn = -2*e*(mt->band->ThermalVn(ctx, T)*n - pm*mt0->band->ThermalVn(ctx0, T)*n0*exp(-(Ec-Ec0)/(kb*T)))*cv_boundary;
+                Sn =  2*e*(mt->band->ThermalVn(ctx, T)*n*2.5*kb*Tn - pm*mt0->band->ThermalVn(ctx0, T)*n0*exp(-(Ec-Ec0)/(kb*T))*2.5*kb*Tn0)*cv_boundary;
               }
 
               if(Ev0 < Ev)
               {
                 // Jp is enter region 0
-                AutoDScalar pm = mt0->band->EffecHoleMass(T)/mt->band->EffecHoleMass(T);
-                Jp = -2*e*(mt0->band->ThermalVp(T)*p0 - pm*mt->band->ThermalVp(T)*p*exp((Ev0-Ev)/(kb*T)))*cv_boundary;
-                Sp =  2*e*(mt0->band->ThermalVp(T)*p0*2.5*kb*Tp0 - pm*mt->band->ThermalVp(T)*p*exp((Ev0-Ev)/(kb*T))*2.5*kb*Tp)*cv_boundary;
+                AutoDScalar pm = mt0->band->EffecHoleMass(ctx0, T)/mt->band->EffecHoleMass(ctx, T);
+                Jp = -2*e*(mt0->band->ThermalVp(ctx0, T)*p0 - pm*mt->band->ThermalVp(ctx, T)*p*exp((Ev0-Ev)/(kb*T)))*cv_boundary;
+                Sp =  2*e*(mt0->band->ThermalVp(ctx0, T)*p0*2.5*kb*Tp0 - pm*mt->band->ThermalVp(ctx, T)*p*exp((Ev0-Ev)/(kb*T))*2.5*kb*Tp)*cv_boundary;
               }
               else
               {
-                AutoDScalar pm = mt->band->EffecHoleMass(T)/mt0->band->EffecHoleMass(T);
-                Jp =  2*e*(mt->band->ThermalVp(T)*p - pm*mt0->band->ThermalVp(T)*p0*exp((Ev-Ev0)/(kb*T)))*cv_boundary;
-                Sp = -2*e*(mt->band->ThermalVp(T)*p*2.5*kb*Tp - pm*mt0->band->ThermalVp(T)*p0*exp((Ev-Ev0)/(kb*T))*2.5*kb*Tp0)*cv_boundary;
+                AutoDScalar pm = mt->band->EffecHoleMass(ctx, T)/mt0->band->EffecHoleMass(ctx0, T);
+                Jp =  2*e*(mt->band->ThermalVp(ctx, T)*p - pm*mt0->band->ThermalVp(ctx0, T)*p0*exp((Ev-Ev0)/(kb*T)))*cv_boundary;
+                Sp = -2*e*(mt->band->ThermalVp(ctx, T)*p*2.5*kb*Tp - pm*mt0->band->ThermalVp(ctx0, T)*p0*exp((Ev-Ev0)/(kb*T))*2.5*kb*Tp0)*cv_boundary;
               }
 
 
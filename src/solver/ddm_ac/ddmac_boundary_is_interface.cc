@@ -75,7 +75,7 @@ void InsulatorSemiconductorInterfaceBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b,
            * process interface traps
            */
           const FVM_NodeData * node_data = fvm_nodes[0]->node_data();
-          sregion->material()->mapping(fvm_nodes[0]->root_node(), node_data, SolverSpecify::clock);
+          const PMI_Context ctx = sregion->material()->mapping(fvm_nodes[0]->root_node(), node_data, SolverSpecify::clock);
 
           unsigned int n_node_var      = sregion->ebm_n_variables();
           unsigned int node_psi_offset = sregion->ebm_variable_offset(POTENTIAL);
@@ -134,17 +134,17 @@ void InsulatorSemiconductorInterfaceBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b,
             }
 
 
-            AutoDScalar Eg = sregion->material()->band->Eg(T);
+            AutoDScalar Eg = sregion->material()->band->Eg(ctx, T);
             PetscScalar boundary_area = fvm_nodes[i]->outside_boundary_surface_area();
-            AutoDScalar ni = sregion->material()->band->nie(p, n, T);
-            sregion->material()->trap->Calculate(false,p,n,ni,T);
-            AutoDScalar TrappedC = sregion->material()->trap->ChargeAD(false) * boundary_area;
+            AutoDScalar ni = sregion->material()->band->nie(ctx, p, n, T);
+            sregion->material()->trap->Calculate(ctx, false,p,n,ni,T);
+            AutoDScalar TrappedC = sregion->material()->trap->ChargeAD(ctx, false) * boundary_area;
             MatSetValues(A, 1, &index_re[node_psi_offset], n_node_var, &index_re[0], TrappedC.getADValue(), ADD_VALUES);
             MatSetValues(A, 1, &index_im[node_psi_offset], n_node_var, &index_im[0], TrappedC.getADValue(), ADD_VALUES);
 
 
-            AutoDScalar TrapElec = sregion->material()->trap->ElectronTrapRate(false,n,ni,T);
-            AutoDScalar TrapHole = sregion->material()->trap->HoleTrapRate    (false,p,ni,T);
+            AutoDScalar TrapElec = sregion->material()->trap->ElectronTrapRate(ctx, false,n,ni,T);
+            AutoDScalar TrapHole = sregion->material()->trap->HoleTrapRate    (ctx, false,p,ni,T);
             MatSetValues(A, 1, &index_re[node_n_offset], n_node_var, &index_re[0], (-TrapElec*boundary_area).getADValue(), ADD_VALUES);
             MatSetValues(A, 1, &index_im[node_n_offset], n_node_var, &index_im[0], (-TrapElec*boundary_area).getADValue(), ADD_VALUES);
 
@@ -170,7 +170,7 @@ void InsulatorSemiconductorInterfaceBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b,
             {
               AutoDScalar EcEi = 0.5*Eg - kb*T*log(node_data->Nc()/node_data->Nv());
               AutoDScalar EiEv = 0.5*Eg + kb*T*log(node_data->Nc()/node_data->Nv());
-              AutoDScalar H = sregion->material()->trap->TrapHeat(true,p,n,ni,Tp,Tn,T,EcEi,EiEv);
+              AutoDScalar H = sregion->material()->trap->TrapHeat(ctx, true,p,n,ni,Tp,Tn,T,EcEi,EiEv);
               MatSetValues(A, 1, &index_re[node_Tl_offset], n_node_var, &index_re[0], (H*boundary_area).getADValue(),   ADD_VALUES);
               MatSetValues(A, 1, &index_im[node_Tl_offset], n_node_var, &index_im[0], (H*boundary_area).getADValue(),   ADD_VALUES);
             }
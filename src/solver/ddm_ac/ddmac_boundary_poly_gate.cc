@@ -98,7 +98,7 @@ void PolyGateContactBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, con
           adtl::AutoDScalar::numdir = n_node_var + 1;
           //synchronize with material database
           semi_region->material()->set_ad_num(adtl::AutoDScalar::numdir);
-          semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+          const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
           AutoDScalar V = node_data->psi();  V.setADValue(node_psi_offset, 1.0);  // psi of this node
           AutoDScalar n = node_data->n();    n.setADValue(node_n_offset, 1.0);  // electron density
@@ -150,7 +150,7 @@ void PolyGateContactBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, con
           col_re.push_back(bc_global_offset_re);
           col_im.push_back(bc_global_offset_im);
 
-          AutoDScalar nie = semi_region->material()->band->nie(p, n, T);
+          AutoDScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
 
           //governing equation of pis/n/p for Ohmic contact boundary
 
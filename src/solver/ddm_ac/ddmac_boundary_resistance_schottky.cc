@@ -79,7 +79,7 @@ void IF_Metal_SchottkyBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, c
     adtl::AutoDScalar::numdir = semiconductor_n_node_var + resistance_n_node_var;
     //synchronize with material database
     semiconductor_region->material()->set_ad_num(adtl::AutoDScalar::numdir);
-    semiconductor_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock);
+    const PMI_Context ctx = semiconductor_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock);
 
     PetscInt ad_index = 0;
     AutoDScalar V = semiconductor_node_data->psi();  V.setADValue(ad_index++, 1.0);  // psi of this node
@@ -141,18 +141,18 @@ void IF_Metal_SchottkyBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, c
       col_im.push_back(resistance_node->global_offset() + resistance_n_node_var + nv);
     }
 
-    AutoDScalar nie = semiconductor_region->material()->band->nie(p, n, T);
-    AutoDScalar Nc  = semiconductor_region->material()->band->Nc(T);
-    AutoDScalar Nv  = semiconductor_region->material()->band->Nv(T);
-    AutoDScalar Eg  = semiconductor_region->material()->band->Eg(T);
+    AutoDScalar nie = semiconductor_region->material()->band->nie(ctx, p, n, T);
+    AutoDScalar Nc  = semiconductor_region->material()->band->Nc(ctx, T);
+    AutoDScalar Nv  = semiconductor_region->material()->band->Nv(ctx, T);
+    AutoDScalar Eg  = semiconductor_region->material()->band->Eg(ctx, T);
 
 
     //Schotty Barrier Lowerring
-    PetscScalar deltaVB = semiconductor_region->material()->band->SchottyBarrierLowerring(semiconductor_node_data->eps(), semiconductor_node_data->E().size());
+    PetscScalar deltaVB = semiconductor_region->material()->band->SchottyBarrierLowerring(ctx, semiconductor_node_data->eps(), semiconductor_node_data->E().size());
     //Schottky current
     PetscScalar S  = semiconductor_node->outside_boundary_surface_area();
-    AutoDScalar Fn = semiconductor_region->material()->band->SchottyJsn(n, T, resistance_node_data->affinity() - semiconductor_node_data->affinity() - deltaVB) * S;
-    AutoDScalar Fp = semiconductor_region->material()->band->SchottyJsp(p, T, resistance_node_data->affinity() - semiconductor_node_data->affinity() + deltaVB) * S;
+    AutoDScalar Fn = semiconductor_region->material()->band->SchottyJsn(ctx, n, T, resistance_node_data->affinity() - semiconductor_node_data->affinity() - deltaVB) * S;
+    AutoDScalar Fp = semiconductor_region->material()->band->SchottyJsp(ctx, p, T, resistance_node_data->affinity() - semiconductor_node_data->affinity() + deltaVB) * S;
 
     // schottky boundary condition of poisson's equation
     AutoDScalar f_phi = V - V_resistance - deltaVB;
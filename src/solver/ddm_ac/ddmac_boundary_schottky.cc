@@ -97,7 +97,7 @@ void SchottkyContactBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, con
             const FVM_NodeData * node_data = fvm_nodes[i]->node_data();
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
             //the indepedent variable number, we only need n_node_var+1 here.
             adtl::AutoDScalar::numdir=n_node_var+1;
@@ -140,12 +140,12 @@ void SchottkyContactBC::DDMAC_Fill_Matrix_Vector( Mat A, Vec b, const Mat J, con
             AutoDScalar Ve = this->ext_circuit()->Vac();             Ve.setADValue(n_node_var, 1.0);
 
             //Schotty Barrier Lowerring
-            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
 
             //Schottky current
             PetscScalar S  = fvm_nodes[i]->outside_boundary_surface_area();
-            AutoDScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-            AutoDScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+            AutoDScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+            AutoDScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
             // the insert position
             std::vector<PetscInt> row_re, col_re;
@@ -413,7 +413,7 @@ void SchottkyContactBC::DDMAC_Update_Solution(const PetscScalar * lxx, const Mat
         const FVM_NodeData * node_data = fvm_node->node_data();
 
         // mapping this node to material library
-        semi_region->material()->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+        const PMI_Context ctx = semi_region->material()->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
         //the indepedent variable number, we only need 2/3 here.
         adtl::AutoDScalar::numdir=2;
@@ -432,12 +432,12 @@ void SchottkyContactBC::DDMAC_Update_Solution(const PetscScalar * lxx, const Mat
         }
 
         //Schotty Barrier Lowerring
-        PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+        PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
 
         //Schottky current
         PetscScalar S  = fvm_node->outside_boundary_surface_area();
-        AutoDScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-        AutoDScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+        AutoDScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+        AutoDScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
         std::vector <PetscScalar> x_real, x_imag;
         {
@@ -199,7 +199,6 @@ void MetalSimulationRegion::DDMAC_Fill_Nodal_Matrix_Vector(
 
 
   const FVM_NodeData * node_data = fvm_node->node_data();
-  this->mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
   for(unsigned int n=0; n<indepedent_variable.size(); ++n)
   {
@@ -275,7 +274,6 @@ void MetalSimulationRegion::DDMAC_Fill_Nodal_Matrix_Vector(
   genius_assert( fvm_node->root_node()->processor_id() == Genius::processor_id() );
 
   const FVM_NodeData * node_data = fvm_node->node_data();
-  this->mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
   PetscInt ncols;
   const PetscInt    * row_cols_pointer;
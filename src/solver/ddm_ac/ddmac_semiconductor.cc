@@ -261,7 +261,7 @@ void SemiconductorSimulationRegion::DDMAC_Fill_Nodal_Matrix_Vector (
 
 
   const FVM_NodeData * node_data = fvm_node->node_data();
-  this->mt->mapping ( fvm_node->root_node(), node_data, SolverSpecify::clock );
+  const PMI_Context ctx = this->mt->mapping ( fvm_node->root_node(), node_data, SolverSpecify::clock );
 
   for ( unsigned int n=0; n<indepedent_variable.size(); ++n )
   {
@@ -327,7 +327,7 @@ void SemiconductorSimulationRegion::DDMAC_Fill_Nodal_Matrix_Vector (
   // process omega item of lattice temperature equ
   if ( this->get_advanced_model()->enable_Tl() )
   {
-    PetscScalar HeatCapacity =  this->mt->thermal->HeatCapacity ( node_data->T() );
+    PetscScalar HeatCapacity =  this->mt->thermal->HeatCapacity (ctx, node_data->T() );
 
     PetscInt real_row = fvm_node->global_offset() + this->ebm_variable_offset ( TEMPERATURE );
     PetscInt imag_row = fvm_node->global_offset() + this->ebm_n_variables() + this->ebm_variable_offset ( TEMPERATURE ) ;
@@ -405,7 +405,7 @@ void SemiconductorSimulationRegion::DDMAC_Fill_Nodal_Matrix_Vector (
   genius_assert ( fvm_node->root_node()->processor_id() == Genius::processor_id() );
 
   const FVM_NodeData * node_data = fvm_node->node_data();
-  this->mt->mapping ( fvm_node->root_node(), node_data, SolverSpecify::clock );
+  const PMI_Context ctx = this->mt->mapping ( fvm_node->root_node(), node_data, SolverSpecify::clock );
 
   PetscInt ncols;
   const PetscInt    * row_cols_pointer;
@@ -472,7 +472,7 @@ void SemiconductorSimulationRegion::DDMAC_Fill_Nodal_Matrix_Vector (
   // process omega item of lattice temperature equ
   if ( var == TEMPERATURE && this->get_advanced_model()->enable_Tl() )
   {
-    PetscScalar HeatCapacity =  this->mt->thermal->HeatCapacity ( node_data->T() );
+    PetscScalar HeatCapacity =  this->mt->thermal->HeatCapacity (ctx, node_data->T() );
 
     PetscInt real_row = fvm_node->global_offset() + this->ebm_variable_offset ( TEMPERATURE );
     PetscInt imag_row = fvm_node->global_offset() + this->ebm_n_variables() + this->ebm_variable_offset ( TEMPERATURE ) ;
@@ -0,0 +1,249 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#include <sstream>
+
+#include "solver_specify.h"
+#include "physical_unit.h"
+#include "simulation_system.h"
+#include "boundary_condition_collector.h"
+#include "ddm_solver.h"
+#include "checkpoint_file.h"
+#include "parallel.h"
+#include "perf_log.h"
+
+
+/**
+ * version of checkpoint file layout
+ */
+static const unsigned int checkpoint_version = 2;
+
+
+/**
+ * each processor has its own checkpoint file, since the local part of
+ * solution vectors and region data are stored
+ */
+static std::string _checkpoint_file(const std::string & file)
+{
+  if( Genius::n_processors() == 1 ) return file;
+
+  std::ostringstream ss;
+  ss << file << '.' << Genius::processor_id();
+  return ss.str();
+}
+
+
+/**
+ * write the local part of vector \p v
+ */
+static void _checkpoint_vec(CheckpointWriter & out, Vec v)
+{
+  PetscInt n;
+  PetscScalar * a;
+  VecGetLocalSize(v, &n);
+  VecGetArray(v, &a);
+  out.write_array(a, n);
+  VecRestoreArray(v, &a);
+}
+
+
+/**
+ * read the local part of vector \p v, the local size should be the same
+ */
+static bool _restart_vec(CheckpointReader & in, Vec v)
+{
+  PetscInt n;
+  PetscScalar * a;
+  VecGetLocalSize(v, &n);
+  VecGetArray(v, &a);
+  bool ok = in.read_array(a, n);
+  VecRestoreArray(v, &a);
+  return ok;
+}
+
+
+
+/* ----------------------------------------------------------------------------
+ * the checkpoint is written at the end of an accepted time step, after the solution of next
+ * step is predicted. it holds everything the main loop of transient solver depends on:
+ * simulation clock and time step history, solution vector and BDF history vectors,
+ * cell/node data of regions (i.e. solution of last step) and trap history of their PMI models,
+ * boundary and external circuit state and the state of hooks.
+ */
+bool DDMSolverBase::write_checkpoint(const std::deque<double> & time_step_success)
+{
+  START_LOG("write_checkpoint()", "DDMSolverBase");
+
+  // the state of hooks, i.e. the position of output files
+  std::vector< std::pair<std::string, std::string> > hook_states;
+  hook_list()->checkpoint(hook_states);
+
+  unsigned int failed = 0;
+
+  CheckpointWriter out;
+  if( out.open(_checkpoint_file(SolverSpecify::Checkpoint)) )
+  {
+    out.section("GCKP");
+    out.write_value<unsigned int>(checkpoint_version);
+    out.write_value<unsigned int>(Genius::n_processors());
+    out.write_value<unsigned int>(Genius::processor_id());
+
+    out.section("TIME");
+    out.write_value(SolverSpecify::clock);
+    out.write_value(SolverSpecify::dt);
+    out.write_value(SolverSpecify::dt_last);
+    out.write_value(SolverSpecify::dt_last_last);
+    out.write_value<int>(SolverSpecify::T_Cycles);
+    out.write_value<char>(SolverSpecify::BDF2_LowerOrder);
+    out.write_vector(std::vector<double>(time_step_success.begin(), time_step_success.end()));
+
+    out.section("VECS");
+    _checkpoint_vec(out, x);
+    _checkpoint_vec(out, L);
+    _checkpoint_vec(out, x_n);
+    _checkpoint_vec(out, x_n1);
+    _checkpoint_vec(out, x_n2);
+
+    out.section("REGN");
+    out.write_value<unsigned int>(_system.n_regions());
+    for(unsigned int n=0; n<_system.n_regions(); n++)
+      _system.region(n)->checkpoint(out);
+
+    out.section("BCND");
+    out.write_value<unsigned int>(_system.get_bcs()->n_bcs());
+    for(unsigned int b=0; b<_system.get_bcs()->n_bcs(); b++)
+      _system.get_bcs()->get_bc(b)->checkpoint(out);
+
+    out.section("EXTR");
+    this->checkpoint_extra(out);
+
+    out.section("HOOK");
+    out.write_value<unsigned int>(hook_states.size());
+    for(unsigned int n=0; n<hook_states.size(); n++)
+    {
+      out.write_string(hook_states[n].first);
+      out.write_string(hook_states[n].second);
+    }
+
+    out.section("END ");
+    if( !out.close() ) failed = 1;
+  }
+  else
+    failed = 1;
+
+  Parallel::sum(failed);
+
+  if( failed )
+  {
+    MESSAGE<<"Warning: write checkpoint " << SolverSpecify::Checkpoint << " failed.\n\n"; RECORD();
+  }
+  else
+  {
+    MESSAGE<<"Checkpoint " << SolverSpecify::Checkpoint << " written at t = " << (SolverSpecify::clock-SolverSpecify::dt)/PhysicalUnit::s*1e12 << " ps.\n\n"; RECORD();
+  }
+
+  STOP_LOG("write_checkpoint()", "DDMSolverBase");
+
+  return !failed;
+}
+
+
+
+bool DDMSolverBase::read_checkpoint(std::deque<double> & time_step_success)
+{
+  START_LOG("read_checkpoint()", "DDMSolverBase");
+
+  std::vector< std::pair<std::string, std::string> > hook_states;
+
+  CheckpointReader in;
+  bool ok = in.open(_checkpoint_file(SolverSpecify::Restart));
+
+  ok = ok && in.section("GCKP") &&
+       in.read_value<unsigned int>() == checkpoint_version &&
+       in.read_value<unsigned int>() == Genius::n_processors() &&
+       in.read_value<unsigned int>() == Genius::processor_id();
+
+  if( ok && in.section("TIME") )
+  {
+    SolverSpecify::clock           = in.read_value<double>();
+    SolverSpecify::dt              = in.read_value<double>();
+    SolverSpecify::dt_last         = in.read_value<double>();
+    SolverSpecify::dt_last_last    = in.read_value<double>();
+    SolverSpecify::T_Cycles        = in.read_value<int>();
+    SolverSpecify::BDF2_LowerOrder = in.read_value<char>() != 0;
+
+    std::vector<double> steps;
+    in.read_vector(steps);
+    time_step_success.assign(steps.begin(), steps.end());
+  }
+
+  ok = ok && in.section("VECS") &&
+       _restart_vec(in, x) &&
+       _restart_vec(in, L) &&
+       _restart_vec(in, x_n) &&
+       _restart_vec(in, x_n1) &&
+       _restart_vec(in, x_n2);
+
+  ok = ok && in.section("REGN") && in.read_value<unsigned int>() == _system.n_regions();
+  for(unsigned int n=0; ok && n<_system.n_regions(); n++)
+    ok = _system.region(n)->restart(in);
+
+  ok = ok && in.section("BCND") && in.read_value<unsigned int>() == _system.get_bcs()->n_bcs();
+  for(unsigned int b=0; ok && b<_system.get_bcs()->n_bcs(); b++)
+  {
+    _system.get_bcs()->get_bc(b)->restart(in);
+    ok = in.good();
+  }
+
+  ok = ok && in.section("EXTR") && this->restart_extra(in);
+
+  if( ok && in.section("HOOK") )
+  {
+    unsigned int n_hooks = in.read_value<unsigned int>();
+    for(unsigned int n=0; n<n_hooks && in.good(); n++)
+    {
+      std::string name  = in.read_string();
+      std::string state = in.read_string();
+      hook_states.push_back( std::make_pair(name, state) );
+    }
+  }
+
+  ok = ok && in.section("END ");
+
+  // checkpoint files of all the processors should be written at the same time step
+  unsigned int failed = ok ? 0 : 1;
+  Parallel::sum(failed);
+  if( !failed && !Parallel::verify(SolverSpecify::T_Cycles) ) failed = 1;
+
+  if( !failed )
+  {
+    hook_list()->restart(hook_states);
+
+    MESSAGE<<"Restart from checkpoint " << SolverSpecify::Restart << " at t = "
+           << (SolverSpecify::clock-SolverSpecify::dt)/PhysicalUnit::s*1e12 << " ps, time step " << SolverSpecify::T_Cycles << ".\n\n";
+    RECORD();
+  }
+
+  STOP_LOG("read_checkpoint()", "DDMSolverBase");
+
+  return !failed;
+}
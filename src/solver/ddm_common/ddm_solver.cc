@@ -23,8 +23,16 @@
 #include <iomanip>
 #include <stack>
 #include <deque>
+#include <map>
 #include <numeric>
+#include <iostream>
+#include <cerrno>
 
+#ifndef WINDOWS
+  #include <unistd.h>
+  #include <sys/types.h>
+  #include <sys/wait.h>
+#endif
 
 #include "solver_specify.h"
 #include "physical_unit.h"
@@ -35,6 +43,9 @@
 #include "ddm_solver.h"
 #include "parallel.h"
 #include "MXMLUtil.h"
+#include "perf_log.h"
+#include "memory_log.h"
+#include "thread_pool.h"
 
 
 using PhysicalUnit::A;
@@ -265,7 +276,9 @@ void DDMSolverBase::snes_solve()
   feclearexcept (FE_ALL_EXCEPT);
 #endif
   // do snes solve
+  snes_solve_prepare();
   SNESSolve ( snes, PETSC_NULL, x );
+  snes_solve_finish();
 
   // get the converged reason
   SNESConvergedReason reason;
@@ -282,7 +295,9 @@ void DDMSolverBase::snes_solve()
     SNESLineSearchSet(snesls, SNESLineSearchNo,PETSC_NULL);
 #endif
     this->diverged_recovery();
+    snes_solve_prepare();
     SNESSolve ( snes, PETSC_NULL, x );
+    snes_solve_finish();
   }
 
 #if defined(HAVE_FENV_H)
@@ -452,35 +467,46 @@ int DDMSolverBase::solve_dcsweep()
   // voltage scan
   if ( SolverSpecify::Electrode_VScan.size() )
   {
-    // the current vscan voltage
-    PetscScalar Vscan = SolverSpecify::VStart;
+    if ( SolverSpecify::Electrode_VFamily.size() )
+      ierr = solve_dcsweep_vfamily();
+    else
+      ierr = solve_dcsweep_vscan ( false, PETSC_NULL );
+  }
+
+
+
+  // current scan
+  if ( SolverSpecify::Electrode_IScan.size() )
+  {
+    // iscan current
+    PetscScalar Iscan = SolverSpecify::IStart;
 
-    // the current vscan step
-    PetscScalar VStep = SolverSpecify::VStep;
+    // iscan step
+    PetscScalar IStep = SolverSpecify::IStep;
 
-    // saved solutions and vscan values for solution projection.
+    // saved solutions and iscan values for solution projection.
     Vec xs1, xs2, xs3;
-    PetscScalar Vs1=Vscan, Vs2=Vscan, Vs3=Vscan;
-    std::stack<PetscScalar> V_retry;
+    PetscScalar Is1=Iscan, Is2=Iscan, Is3=Iscan;
+    std::stack<PetscScalar> I_retry;
     VecDuplicate ( x,&xs1 );
     VecDuplicate ( x,&xs2 );
     VecDuplicate ( x,&xs3 );
 
     // main loop
-    for ( SolverSpecify::DC_Cycles=0;  (Vscan*SolverSpecify::VStep) <= SolverSpecify::VStop*SolverSpecify::VStep* ( 1.0+1e-7 ); )
+    for ( SolverSpecify::DC_Cycles=0;  (Iscan*SolverSpecify::IStep) <= SolverSpecify::IStop*SolverSpecify::IStep* ( 1.0+1e-7 ); )
     {
-      // show current vscan value
-      MESSAGE << "DC Scan: V("  << SolverSpecify::Electrode_VScan[0];
-      for ( unsigned int i=1; i<SolverSpecify::Electrode_VScan.size(); i++ )
-        MESSAGE << ", "  << SolverSpecify::Electrode_VScan[i];
-      MESSAGE << ") = "  << Vscan/PhysicalUnit::V  <<" V" << '\n'
+      // show current iscan value
+      MESSAGE << "DC Scan: I("  << SolverSpecify::Electrode_IScan[0];
+      for ( unsigned int i=1; i<SolverSpecify::Electrode_IScan.size(); i++ )
+        MESSAGE << ", "  << SolverSpecify::Electrode_IScan[i];
+      MESSAGE << ") = "  << Iscan/PhysicalUnit::A  <<" A" << '\n'
       <<"--------------------------------------------------------------------------------\n";
       RECORD();
 
-      // set current vscan voltage to corresponding electrode
-      _system.get_electrical_source()->assign_voltage_to ( SolverSpecify::Electrode_VScan, Vscan );
+      // set iscan current to corresponding electrode
+      _system.get_electrical_source()->assign_current_to ( SolverSpecify::Electrode_IScan, Iscan );
       _system.get_field_source()->update ( 0, SolverSpecify::SourceCoupled );
-      SolverSpecify::Electrode_VScan_Voltage = Vscan;
+      SolverSpecify::Electrode_IScan_Current = Iscan;
 
       // call pre_solve_process
       if ( SolverSpecify::DC_Cycles == 0 )
@@ -488,9 +514,7 @@ int DDMSolverBase::solve_dcsweep()
       else
         this->pre_solve_process ( false );
 
-      // here call Petsc to solve the nonlinear equations
       snes_solve();
-
       // get the converged reason
       SNESConvergedReason reason;
       SNESGetConvergedReason ( snes,&reason );
@@ -509,39 +533,38 @@ int DDMSolverBase::solve_dcsweep()
         SolverSpecify::DC_Cycles++;
 
         // save solution for linear/quadratic projection
-        Vs3=Vs2;
-        Vs2=Vs1;
-        Vs1=Vscan;
+        Is3=Is2;
+        Is2=Is1;
+        Is1=Iscan;
 
         VecCopy ( xs2,xs3 );
         VecCopy ( xs1,xs2 );
         VecCopy ( x,xs1 );
 
-        if ( V_retry.empty() )
+        if ( I_retry.empty() )
         {
           // add vstep to current voltage
-          Vscan += VStep;
+          Iscan += IStep;
         }
         else
         {
           // pop
-          Vscan = V_retry.top();
-          V_retry.pop();
+          Iscan = I_retry.top();
+          I_retry.pop();
         }
 
-        if ( fabs ( Vscan-SolverSpecify::VStop ) <1e-10 )
-          Vscan=SolverSpecify::VStop;
+        if ( fabs ( Iscan-SolverSpecify::IStop ) <1e-10 )
+          Iscan=SolverSpecify::IStop;
 
-        // if v step small than VStepMax, mult by factor of 1.1
-        if ( fabs ( VStep ) < fabs ( SolverSpecify::VStepMax ) )  VStep *= 1.1;
+        // if I step small than IStepMax, mult by factor of 1.1
+        if ( fabs ( IStep ) < fabs ( SolverSpecify::IStepMax ) )  IStep *= 1.1;
 
 
-        // however, for last step, we force V equal to VStop
-        if ( (Vscan*SolverSpecify::VStep) > SolverSpecify::VStop*SolverSpecify::VStep &&
-             (Vscan*SolverSpecify::VStep) < ( SolverSpecify::VStop + VStep - 1e-10*VStep ) *SolverSpecify::VStep
+        // however, for last step, we force I equal to IStop
+        if ( (Iscan*SolverSpecify::IStep) > SolverSpecify::IStop*SolverSpecify::IStep &&
+             (Iscan*SolverSpecify::IStep) < ( SolverSpecify::IStop + IStep - 1e-10*IStep ) *SolverSpecify::IStep
            )
-          Vscan = SolverSpecify::VStop;
-
+          Iscan = SolverSpecify::IStop;
 
         MESSAGE
         <<"--------------------------------------------------------------------------------\n"
@@ -550,7 +573,6 @@ int DDMSolverBase::solve_dcsweep()
       }
       else // oh, diverged... reduce step and try again
       {
-
         if(reason == SNES_DIVERGED_LINEAR_SOLVE)
         {
           KSPConvergedReason ksp_reason;
@@ -560,7 +582,6 @@ int DDMSolverBase::solve_dcsweep()
         else
           MESSAGE <<"------> nonlinear solver "<<SNESConvergedReasons[reason];
 
-        // failed in the first step, we didn't know how to set the scan bias
         if ( SolverSpecify::DC_Cycles == 0 )
         {
           MESSAGE <<". Failed in the first step.\n\n\n";
@@ -568,12 +589,11 @@ int DDMSolverBase::solve_dcsweep()
           ierr = 1;
           break;
         }
-
-        if ( V_retry.size() >=8 )
+        if ( I_retry.size() >=8 )
         {
           MESSAGE <<". Too many failed steps, give up tring.\n\n\n";
           RECORD();
-          ierr=1;
+          ierr = 1;
           break;
         }
 
@@ -583,16 +603,17 @@ int DDMSolverBase::solve_dcsweep()
         this->diverged_recovery();
 
         // reduce step by a factor of 2
-        V_retry.push ( Vscan );
-        Vscan= ( Vscan+Vs1 ) /2.0;
+        I_retry.push ( Iscan );
+        Iscan= ( Iscan+Is1 ) /2.0;
+
 
       }
 
       if ( SolverSpecify::Predict )
       {
-        PetscScalar hn = Vscan-Vs1;
-        PetscScalar hn1 = Vs1-Vs2;
-        PetscScalar hn2 = Vs2-Vs3;
+        PetscScalar hn = Iscan-Is1;
+        PetscScalar hn1 = Is1-Is2;
+        PetscScalar hn2 = Is2-Is3;
 
         if ( SolverSpecify::DC_Cycles>=3 )
         {
@@ -619,180 +640,561 @@ int DDMSolverBase::solve_dcsweep()
     VecDestroy ( PetscDestroyObject(xs1) );
     VecDestroy ( PetscDestroyObject(xs2) );
     VecDestroy ( PetscDestroyObject(xs3) );
-
   }
 
 
+  SolverSpecify::tran_histroy = false;
 
-  // current scan
-  if ( SolverSpecify::Electrode_IScan.size() )
+  return ierr;
+}
+
+
+
+/* ----------------------------------------------------------------------------
+ * voltage scan of SolverSpecify::Electrode_VScan, called by solve_dcsweep
+ */
+int DDMSolverBase::solve_dcsweep_vscan ( bool warm_start, Vec x_first, FILE * record )
+{
+  int ierr = 0;
+
+  PetscInt total_lits = 0;
+
+  // the current vscan voltage
+  PetscScalar Vscan = SolverSpecify::VStart;
+
+  // the current vscan step
+  PetscScalar VStep = SolverSpecify::VStep;
+
+  // saved solutions and vscan values for solution projection.
+  Vec xs1, xs2, xs3;
+  PetscScalar Vs1=Vscan, Vs2=Vscan, Vs3=Vscan;
+  std::stack<PetscScalar> V_retry;
+  VecDuplicate ( x,&xs1 );
+  VecDuplicate ( x,&xs2 );
+  VecDuplicate ( x,&xs3 );
+
+  // main loop
+  for ( SolverSpecify::DC_Cycles=0;  (Vscan*SolverSpecify::VStep) <= SolverSpecify::VStop*SolverSpecify::VStep* ( 1.0+1e-7 ); )
   {
-    // iscan current
-    PetscScalar Iscan = SolverSpecify::IStart;
+    // show current vscan value
+    MESSAGE << "DC Scan: V("  << SolverSpecify::Electrode_VScan[0];
+    for ( unsigned int i=1; i<SolverSpecify::Electrode_VScan.size(); i++ )
+      MESSAGE << ", "  << SolverSpecify::Electrode_VScan[i];
+    MESSAGE << ") = "  << Vscan/PhysicalUnit::V  <<" V" << '\n'
+    <<"--------------------------------------------------------------------------------\n";
+    RECORD();
 
-    // iscan step
-    PetscScalar IStep = SolverSpecify::IStep;
+    // set current vscan voltage to corresponding electrode
+    _system.get_electrical_source()->assign_voltage_to ( SolverSpecify::Electrode_VScan, Vscan );
+    _system.get_field_source()->update ( 0, SolverSpecify::SourceCoupled );
+    SolverSpecify::Electrode_VScan_Voltage = Vscan;
 
-    // saved solutions and iscan values for solution projection.
-    Vec xs1, xs2, xs3;
-    PetscScalar Is1=Iscan, Is2=Iscan, Is3=Iscan;
-    std::stack<PetscScalar> I_retry;
-    VecDuplicate ( x,&xs1 );
-    VecDuplicate ( x,&xs2 );
-    VecDuplicate ( x,&xs3 );
+    // call pre_solve_process, a warm started scan keeps x as its initial guess
+    if ( SolverSpecify::DC_Cycles == 0 )
+      this->pre_solve_process ( !warm_start );
+    else
+      this->pre_solve_process ( false );
 
-    // main loop
-    for ( SolverSpecify::DC_Cycles=0;  (Iscan*SolverSpecify::IStep) <= SolverSpecify::IStop*SolverSpecify::IStep* ( 1.0+1e-7 ); )
+    // here call Petsc to solve the nonlinear equations
+    snes_solve();
+
+    // get the converged reason
+    SNESConvergedReason reason;
+    SNESGetConvergedReason ( snes,&reason );
+
+    // linear solver iteration
+    PetscInt lits;
+    SNESGetLinearSolveIterations(snes, &lits);
+    total_lits += lits;
+
+    if ( reason>0 ) //ok, converged.
     {
-      // show current iscan value
-      MESSAGE << "DC Scan: I("  << SolverSpecify::Electrode_IScan[0];
-      for ( unsigned int i=1; i<SolverSpecify::Electrode_IScan.size(); i++ )
-        MESSAGE << ", "  << SolverSpecify::Electrode_IScan[i];
-      MESSAGE << ") = "  << Iscan/PhysicalUnit::A  <<" A" << '\n'
-      <<"--------------------------------------------------------------------------------\n";
+
+      // call post_solve_process
+      this->post_solve_process();
+
+      SolverSpecify::DC_Cycles++;
+
+      if ( SolverSpecify::DC_Cycles == 1 && x_first )
+        VecCopy ( x, x_first );
+
+      if ( record )
+      {
+        PetscInt n;
+        PetscScalar *xx;
+        VecGetLocalSize ( x, &n );
+        VecGetArray ( x, &xx );
+        const char tag = 'P';
+        fwrite ( &tag, sizeof(char), 1, record );
+        fwrite ( &Vscan, sizeof(PetscScalar), 1, record );
+        fwrite ( xx, sizeof(PetscScalar), n, record );
+        VecRestoreArray ( x, &xx );
+      }
+
+      // save solution for linear/quadratic projection
+      Vs3=Vs2;
+      Vs2=Vs1;
+      Vs1=Vscan;
+
+      VecCopy ( xs2,xs3 );
+      VecCopy ( xs1,xs2 );
+      VecCopy ( x,xs1 );
+
+      if ( V_retry.empty() )
+      {
+        // add vstep to current voltage
+        Vscan += VStep;
+      }
+      else
+      {
+        // pop
+        Vscan = V_retry.top();
+        V_retry.pop();
+      }
+
+      if ( fabs ( Vscan-SolverSpecify::VStop ) <1e-10 )
+        Vscan=SolverSpecify::VStop;
+
+      // if v step small than VStepMax, mult by factor of 1.1
+      if ( fabs ( VStep ) < fabs ( SolverSpecify::VStepMax ) )  VStep *= 1.1;
+
+
+      // however, for last step, we force V equal to VStop
+      if ( (Vscan*SolverSpecify::VStep) > SolverSpecify::VStop*SolverSpecify::VStep &&
+           (Vscan*SolverSpecify::VStep) < ( SolverSpecify::VStop + VStep - 1e-10*VStep ) *SolverSpecify::VStep
+         )
+        Vscan = SolverSpecify::VStop;
+
+
+      MESSAGE
+      <<"--------------------------------------------------------------------------------\n"
+      <<"      "<<SNESConvergedReasons[reason]<<", total linear iteration " << lits << "\n\n\n";
       RECORD();
+    }
+    else // oh, diverged... reduce step and try again
+    {
 
-      // set iscan current to corresponding electrode
-      _system.get_electrical_source()->assign_current_to ( SolverSpecify::Electrode_IScan, Iscan );
-      _system.get_field_source()->update ( 0, SolverSpecify::SourceCoupled );
-      SolverSpecify::Electrode_IScan_Current = Iscan;
+      if(reason == SNES_DIVERGED_LINEAR_SOLVE)
+      {
+        KSPConvergedReason ksp_reason;
+        KSPGetConvergedReason ( ksp, &ksp_reason );
+        MESSAGE <<"------> linear solver "<<KSPConvergedReasons[ksp_reason];
+      }
+      else
+        MESSAGE <<"------> nonlinear solver "<<SNESConvergedReasons[reason];
 
-      // call pre_solve_process
+      // the projected initial guess failed, try again from the last solution
+      if ( SolverSpecify::DC_Cycles == 0 && warm_start )
+      {
+        MESSAGE <<", restart from the last solution.\n\n\n";
+        RECORD();
+        warm_start = false;
+        continue;
+      }
+
+      // failed in the first step, we didn't know how to set the scan bias
       if ( SolverSpecify::DC_Cycles == 0 )
-        this->pre_solve_process();
-      else
-        this->pre_solve_process ( false );
+      {
+        MESSAGE <<". Failed in the first step.\n\n\n";
+        RECORD();
+        ierr = 1;
+        break;
+      }
+
+      if ( V_retry.size() >=8 )
+      {
+        MESSAGE <<". Too many failed steps, give up tring.\n\n\n";
+        RECORD();
+        ierr=1;
+        break;
+      }
+
+      MESSAGE <<", do recovery...\n\n\n"; RECORD();
+
+      // load previous result into solution vector
+      this->diverged_recovery();
+
+      // reduce step by a factor of 2
+      V_retry.push ( Vscan );
+      Vscan= ( Vscan+Vs1 ) /2.0;
+
+    }
+
+    if ( SolverSpecify::Predict )
+    {
+      PetscScalar hn = Vscan-Vs1;
+      PetscScalar hn1 = Vs1-Vs2;
+      PetscScalar hn2 = Vs2-Vs3;
+
+      if ( SolverSpecify::DC_Cycles>=3 )
+      {
+        // quadradic projection
+        PetscScalar cn=hn* ( hn+2*hn1+hn2 ) / ( hn1* ( hn1+hn2 ) );
+        PetscScalar cn1=-hn* ( hn+hn1+hn2 ) / ( hn1*hn2 );
+        PetscScalar cn2=hn* ( hn+hn1 ) / ( hn2* ( hn1+hn2 ) );
+
+        VecAXPY ( x,cn,xs1 );
+        VecAXPY ( x,cn1,xs2 );
+        VecAXPY ( x,cn2,xs3 );
+        this->projection_positive_density_check ( x,xs1 );
+      }
+      else if ( SolverSpecify::DC_Cycles>=2 )
+      {
+        // linear projection
+        VecAXPY ( x, hn/hn1,xs1 );
+        VecAXPY ( x,-hn/hn1,xs2 );
+        this->projection_positive_density_check ( x,xs1 );
+      }
+    }
+  }
+
+  VecDestroy ( PetscDestroyObject(xs1) );
+  VecDestroy ( PetscDestroyObject(xs2) );
+  VecDestroy ( PetscDestroyObject(xs3) );
+
+  return ierr;
+}
+
+
 
+/* ----------------------------------------------------------------------------
+ * a family of voltage scans, one for each bias of SolverSpecify::Electrode_VFamily.
+ * each scan starts from the first point of the finished scans, projected to the new family bias
+ */
+int DDMSolverBase::solve_dcsweep_vfamily()
+{
+#ifndef WINDOWS
+  // worker processes are opt-in, they copy the whole system by fork().
+  // MPI libraries do not support fork() after MPI_Init, even for a serial run
+  if ( SolverSpecify::VFamily.size() > 1 && SolverSpecify::VFamilyWorkers != 1 )
+  {
+#ifdef HAVE_MPI
+    MESSAGE << "Warning: DC Family worker processes are not supported with MPI, branches are swept in turn.\n"; RECORD();
+#else
+    return solve_dcsweep_vfamily_concurrent();
+#endif
+  }
+#endif
+
+  int ierr = 0;
+
+  // solutions at the first point of finished scans, and the family bias of them
+  std::vector<Vec> xf;
+  std::vector<PetscScalar> Vf;
+
+  for ( unsigned int b=0; b<SolverSpecify::VFamily.size(); ++b )
+  {
+    const PetscScalar Vfamily = SolverSpecify::VFamily[b];
+
+    MESSAGE << "DC Family: V("  << SolverSpecify::Electrode_VFamily[0];
+    for ( unsigned int i=1; i<SolverSpecify::Electrode_VFamily.size(); i++ )
+      MESSAGE << ", "  << SolverSpecify::Electrode_VFamily[i];
+    MESSAGE << ") = "  << Vfamily/PhysicalUnit::V  <<" V" << '\n'
+    <<"================================================================================\n";
+    RECORD();
+
+    _system.get_electrical_source()->assign_voltage_to ( SolverSpecify::Electrode_VFamily, Vfamily );
+
+    bool warm_start = vfamily_warm_start ( xf, Vf, Vfamily );
+
+    Vec xs;
+    VecDuplicate ( x, &xs );
+    xf.push_back ( xs );
+    Vf.push_back ( Vfamily );
+
+    ierr = solve_dcsweep_vscan ( warm_start, xs );
+    if ( ierr ) break;
+  }
+
+  for ( unsigned int i=0; i<xf.size(); ++i )
+    VecDestroy ( PetscDestroyObject(xf[i]) );
+
+  return ierr;
+}
+
+
+
+bool DDMSolverBase::vfamily_warm_start ( const std::vector<Vec> & xf, const std::vector<PetscScalar> & Vf, PetscScalar Vfamily )
+{
+  if ( xf.empty() ) return false;
+
+  // seed the scan with the nearest converged start point, the second nearest one
+  // gives a linear projection along the family bias
+  unsigned int n0 = 0;
+  for ( unsigned int i=1; i<xf.size(); ++i )
+    if ( fabs ( Vf[i]-Vfamily ) < fabs ( Vf[n0]-Vfamily ) ) n0 = i;
+
+  unsigned int n1 = xf.size();
+  for ( unsigned int i=0; i<xf.size(); ++i )
+    if ( i != n0 && ( n1 == xf.size() || fabs ( Vf[i]-Vfamily ) < fabs ( Vf[n1]-Vfamily ) ) ) n1 = i;
+
+  VecCopy ( xf[n0], x );
+  if ( SolverSpecify::Predict && n1 < xf.size() && Vf[n0] != Vf[n1] )
+  {
+    PetscScalar c = ( Vfamily-Vf[n0] ) / ( Vf[n0]-Vf[n1] );
+    VecAXPY ( x,  c, xf[n0] );
+    VecAXPY ( x, -c, xf[n1] );
+    this->projection_positive_density_check ( x, xf[n0] );
+  }
+
+  return true;
+}
+
+
+
+/* ----------------------------------------------------------------------------
+ * concurrent family of voltage scans:
+ * 1. the first bias point of each branch is solved here in the order of family bias, warm started
+ *    from the finished branches. this is cheap compared to the whole scans.
+ * 2. each branch is swept from its first point by a forked worker process, which has its own copy
+ *    of system, regions, boundary conditions and PETSc objects. the hooks and log of worker are muted,
+ *    the converged bias points are written to a temporary file.
+ * 3. the bias points are merged in the order of family bias, the solution of each point is loaded
+ *    and post processed here, so the hooks (CV file, rawfile, ...) get the same output as a serial sweep.
+ */
+int DDMSolverBase::solve_dcsweep_vfamily_concurrent()
+{
+  int ierr = 0;
+
+#ifndef WINDOWS
+  const unsigned int n_branch = SolverSpecify::VFamily.size();
+
+  MESSAGE << "DC Family: " << n_branch << " branches are swept concurrently\n"; RECORD();
+
+  // start solutions of the branches
+  std::vector<Vec> xf;
+  std::vector<PetscScalar> Vf;
+  {
+    HookList muted;
+    hook_list()->swap ( muted );
+
+    for ( unsigned int b=0; b<n_branch; ++b )
+    {
+      const PetscScalar Vfamily = SolverSpecify::VFamily[b];
+
+      _system.get_electrical_source()->assign_voltage_to ( SolverSpecify::Electrode_VFamily, Vfamily );
+      _system.get_electrical_source()->assign_voltage_to ( SolverSpecify::Electrode_VScan, SolverSpecify::VStart );
+      _system.get_field_source()->update ( 0, SolverSpecify::SourceCoupled );
+      SolverSpecify::Electrode_VScan_Voltage = SolverSpecify::VStart;
+
+      bool warm_start = vfamily_warm_start ( xf, Vf, Vfamily );
+
+      this->pre_solve_process ( !warm_start );
       snes_solve();
-      // get the converged reason
+
       SNESConvergedReason reason;
-      SNESGetConvergedReason ( snes,&reason );
+      SNESGetConvergedReason ( snes, &reason );
+
+      // the projected initial guess failed, try again from the solution in regions
+      if ( reason < 0 && warm_start )
+      {
+        this->pre_solve_process ( true );
+        snes_solve();
+        SNESGetConvergedReason ( snes, &reason );
+      }
+
+      if ( reason < 0 )
+      {
+        MESSAGE << "DC Family: V = " << Vfamily/PhysicalUnit::V << " V, "
+                << SNESConvergedReasons[reason] << ". Failed in the first step.\n\n\n";
+        RECORD();
+        ierr = 1;
+        break;
+      }
+
+      Vec xs;
+      VecDuplicate ( x, &xs );
+      VecCopy ( x, xs );
+      xf.push_back ( xs );
+      Vf.push_back ( Vfamily );
+    }
+
+    hook_list()->swap ( muted );
+  }
+
+  // sweep the branches by worker processes, at most n_workers at the same time
+  const unsigned int n_seeded = xf.size();
+  unsigned int n_workers = SolverSpecify::VFamilyWorkers ? SolverSpecify::VFamilyWorkers : n_seeded;
+  n_workers = std::max ( 1u, std::min ( n_workers, n_seeded ) );
+  const unsigned int n_worker_threads = std::max ( 1u, Genius::n_threads()/n_workers );
+
+  std::vector<FILE *> records ( n_seeded, static_cast<FILE *> ( NULL ) );
+  std::vector<char> worker_ok ( n_seeded, 0 );
+  std::map<pid_t, unsigned int> running;
+
+  // nothing buffered should be written twice by the workers
+  fflush ( NULL );
+  std::cout.flush();
+  std::cerr.flush();
+
+  unsigned int next = 0;
+  while ( next < n_seeded || !running.empty() )
+  {
+    while ( next < n_seeded && running.size() < n_workers )
+    {
+      records[next] = tmpfile();
+      pid_t pid = records[next] ? fork() : -1;
+      if ( pid == 0 )
+        solve_dcsweep_vfamily_worker ( next, xf[next], records[next], n_worker_threads );
+      if ( pid > 0 )
+        running[pid] = next;
+      // can not fork, this branch is swept at merge
+      ++next;
+    }
+    if ( running.empty() ) continue;
+
+    // only wait for our own workers, other children (spice, shell of hooks, ...) are not reaped here
+    bool reaped = false;
+    for ( std::map<pid_t, unsigned int>::iterator it = running.begin(); it != running.end(); )
+    {
+      int status = 0;
+      pid_t pid = waitpid ( it->first, &status, WNOHANG );
+      if ( pid == 0 || ( pid < 0 && errno == EINTR ) ) { ++it; continue; }
+
+      // the worker is lost if waitpid fails, its branch is swept at merge
+      worker_ok[it->second] = pid > 0 && WIFEXITED ( status ) && WEXITSTATUS ( status ) == 0;
+      running.erase ( it++ );
+      reaped = true;
+    }
+    if ( !reaped ) usleep ( 10000 );
+  }
+
+  // merge the branches in the order of family bias
+  for ( unsigned int b=0; b<n_seeded && !ierr; ++b )
+  {
+    const PetscScalar Vfamily = Vf[b];
+
+    MESSAGE << "DC Family: V("  << SolverSpecify::Electrode_VFamily[0];
+    for ( unsigned int i=1; i<SolverSpecify::Electrode_VFamily.size(); i++ )
+      MESSAGE << ", "  << SolverSpecify::Electrode_VFamily[i];
+    MESSAGE << ") = "  << Vfamily/PhysicalUnit::V  <<" V" << '\n'
+    <<"================================================================================\n";
+    RECORD();
+
+    _system.get_electrical_source()->assign_voltage_to ( SolverSpecify::Electrode_VFamily, Vfamily );
+
+    bool complete = false;
+    int branch_ierr = 0;
+    if ( records[b] && worker_ok[b] )
+    {
+      rewind ( records[b] );
+      branch_ierr = solve_dcsweep_vfamily_replay ( records[b], complete );
+    }
+
+    // the worker failed, sweep this branch here
+    if ( !complete )
+    {
+      MESSAGE << "DC Family: worker of this branch failed, sweep it in main process.\n"; RECORD();
+      VecCopy ( xf[b], x );
+      branch_ierr = solve_dcsweep_vscan ( true, PETSC_NULL );
+    }
+
+    ierr = branch_ierr;
+  }
 
-      // linear solver iteration
-      PetscInt lits;
-      SNESGetLinearSolveIterations(snes, &lits);
-      total_lits += lits;
+  for ( unsigned int b=0; b<n_seeded; ++b )
+    if ( records[b] ) fclose ( records[b] );
 
-      if ( reason>0 ) //ok, converged.
-      {
+  for ( unsigned int i=0; i<xf.size(); ++i )
+    VecDestroy ( PetscDestroyObject(xf[i]) );
+#endif
 
-        // call post_solve_process
-        this->post_solve_process();
+  return ierr;
+}
 
-        SolverSpecify::DC_Cycles++;
 
-        // save solution for linear/quadratic projection
-        Is3=Is2;
-        Is2=Is1;
-        Is1=Iscan;
 
-        VecCopy ( xs2,xs3 );
-        VecCopy ( xs1,xs2 );
-        VecCopy ( x,xs1 );
+void DDMSolverBase::solve_dcsweep_vfamily_worker ( unsigned int b, Vec x0, FILE * record, unsigned int n_threads )
+{
+#ifndef WINDOWS
+  // only the calling thread exists in the forked process
+  Genius::reset_threads_after_fork();
+  Genius::set_n_threads ( n_threads );
 
-        if ( I_retry.empty() )
-        {
-          // add vstep to current voltage
-          Iscan += IStep;
-        }
-        else
-        {
-          // pop
-          Iscan = I_retry.top();
-          I_retry.pop();
-        }
+  // output files belong to the main process. the muted hooks are never freed since
+  // the worker leaves by _exit, which also skips all the destructors and atexit functions
+  HookList * muted = new HookList;
+  hook_list()->swap ( *muted );
 
-        if ( fabs ( Iscan-SolverSpecify::IStop ) <1e-10 )
-          Iscan=SolverSpecify::IStop;
+  std::string log;
+  genius_log.capture ( &log );
 
-        // if I step small than IStepMax, mult by factor of 1.1
-        if ( fabs ( IStep ) < fabs ( SolverSpecify::IStepMax ) )  IStep *= 1.1;
+  _system.get_electrical_source()->assign_voltage_to ( SolverSpecify::Electrode_VFamily, SolverSpecify::VFamily[b] );
+  VecCopy ( x0, x );
+  int ierr = solve_dcsweep_vscan ( true, PETSC_NULL, record );
 
+  genius_log.capture ( NULL );
 
-        // however, for last step, we force I equal to IStop
-        if ( (Iscan*SolverSpecify::IStep) > SolverSpecify::IStop*SolverSpecify::IStep &&
-             (Iscan*SolverSpecify::IStep) < ( SolverSpecify::IStop + IStep - 1e-10*IStep ) *SolverSpecify::IStep
-           )
-          Iscan = SolverSpecify::IStop;
+  const char tag = 'E';
+  const unsigned int log_size = log.size();
+  fwrite ( &tag, sizeof(char), 1, record );
+  fwrite ( &ierr, sizeof(int), 1, record );
+  fwrite ( &log_size, sizeof(unsigned int), 1, record );
+  fwrite ( log.data(), sizeof(char), log_size, record );
 
-        MESSAGE
-        <<"--------------------------------------------------------------------------------\n"
-        <<"      "<<SNESConvergedReasons[reason]<<", total linear iteration " << lits << "\n\n\n";
-        RECORD();
-      }
-      else // oh, diverged... reduce step and try again
-      {
-        if(reason == SNES_DIVERGED_LINEAR_SOLVE)
-        {
-          KSPConvergedReason ksp_reason;
-          KSPGetConvergedReason ( ksp, &ksp_reason );
-          MESSAGE <<"------> linear solver "<<KSPConvergedReasons[ksp_reason];
-        }
-        else
-          MESSAGE <<"------> nonlinear solver "<<SNESConvergedReasons[reason];
+  _exit ( fflush ( record ) == 0 ? 0 : 1 );
+#endif
+}
 
-        if ( SolverSpecify::DC_Cycles == 0 )
-        {
-          MESSAGE <<". Failed in the first step.\n\n\n";
-          RECORD();
-          ierr = 1;
-          break;
-        }
-        if ( I_retry.size() >=8 )
-        {
-          MESSAGE <<". Too many failed steps, give up tring.\n\n\n";
-          RECORD();
-          ierr = 1;
-          break;
-        }
 
-        MESSAGE <<", do recovery...\n\n\n"; RECORD();
 
-        // load previous result into solution vector
-        this->diverged_recovery();
+int DDMSolverBase::solve_dcsweep_vfamily_replay ( FILE * record, bool & complete )
+{
+  int ierr = 0;
+  complete = false;
 
-        // reduce step by a factor of 2
-        I_retry.push ( Iscan );
-        Iscan= ( Iscan+Is1 ) /2.0;
+  // check the record is finished before any output, each point has a fixed size
+  PetscInt n;
+  VecGetLocalSize ( x, &n );
+  const long point_size = static_cast<long> ( sizeof(PetscScalar) ) * ( n+1 );
+  for ( char tag; fread ( &tag, sizeof(char), 1, record ) == 1; )
+  {
+    if ( tag == 'E' ) { complete = true; break; }
+    if ( tag != 'P' || fseek ( record, point_size, SEEK_CUR ) != 0 ) break;
+  }
+  if ( !complete ) return 0;
+  rewind ( record );
 
+  SolverSpecify::DC_Cycles = 0;
+  for ( char tag; fread ( &tag, sizeof(char), 1, record ) == 1; )
+  {
+    if ( tag == 'P' )
+    {
+      PetscScalar Vscan;
+      if ( fread ( &Vscan, sizeof(PetscScalar), 1, record ) != 1 ) break;
 
-      }
+      _system.get_electrical_source()->assign_voltage_to ( SolverSpecify::Electrode_VScan, Vscan );
+      _system.get_field_source()->update ( 0, SolverSpecify::SourceCoupled );
+      SolverSpecify::Electrode_VScan_Voltage = Vscan;
 
-      if ( SolverSpecify::Predict )
-      {
-        PetscScalar hn = Iscan-Is1;
-        PetscScalar hn1 = Is1-Is2;
-        PetscScalar hn2 = Is2-Is3;
+      this->pre_solve_process ( false );
 
-        if ( SolverSpecify::DC_Cycles>=3 )
-        {
-          // quadradic projection
-          PetscScalar cn=hn* ( hn+2*hn1+hn2 ) / ( hn1* ( hn1+hn2 ) );
-          PetscScalar cn1=-hn* ( hn+hn1+hn2 ) / ( hn1*hn2 );
-          PetscScalar cn2=hn* ( hn+hn1 ) / ( hn2* ( hn1+hn2 ) );
+      PetscScalar *xx;
+      VecGetArray ( x, &xx );
+      size_t n_read = fread ( xx, sizeof(PetscScalar), n, record );
+      VecRestoreArray ( x, &xx );
+      if ( n_read != static_cast<size_t> ( n ) ) break;
 
-          VecAXPY ( x,cn,xs1 );
-          VecAXPY ( x,cn1,xs2 );
-          VecAXPY ( x,cn2,xs3 );
-          this->projection_positive_density_check ( x,xs1 );
-        }
-        else if ( SolverSpecify::DC_Cycles>=2 )
-        {
-          // linear projection
-          VecAXPY ( x, hn/hn1,xs1 );
-          VecAXPY ( x,-hn/hn1,xs2 );
-          this->projection_positive_density_check ( x,xs1 );
-        }
-      }
-    }
+      // the residual sets the electrode currents, the same as the last newton iteration
+      build_petsc_sens_residual ( x, f );
 
-    VecDestroy ( PetscDestroyObject(xs1) );
-    VecDestroy ( PetscDestroyObject(xs2) );
-    VecDestroy ( PetscDestroyObject(xs3) );
-  }
+      this->post_solve_process();
+      SolverSpecify::DC_Cycles++;
+      continue;
+    }
 
+    if ( tag == 'E' )
+    {
+      unsigned int log_size;
+      if ( fread ( &ierr, sizeof(int), 1, record ) != 1 ) break;
+      if ( fread ( &log_size, sizeof(unsigned int), 1, record ) != 1 ) break;
+      std::string log ( log_size, ' ' );
+      if ( log_size && fread ( &log[0], sizeof(char), log_size, record ) != log_size ) break;
 
-  SolverSpecify::tran_histroy = false;
+      MESSAGE << log; RECORD();
+    }
+    break;
+  }
 
   return ierr;
 }
@@ -1067,6 +1469,9 @@ void DDMSolverBase::solve_iv_trace_end()
  */
 int DDMSolverBase::solve_iv_trace()
 {
+  if(SolverSpecify::TraceArcLength)
+    return solve_iv_trace_arclength();
+
   int         error=0;
   int         first_step=1;
   int         slope_flag=0;
@@ -1343,6 +1748,269 @@ trace_end:
 }
 
 
+
+/**
+ * the value of global vector \p v at global index \p k, can be called on all the processors
+ */
+static PetscScalar _vec_global_value(Vec v, PetscInt k)
+{
+  PetscInt begin, end;
+  VecGetOwnershipRange(v, &begin, &end);
+
+  PetscScalar value = 0.0;
+  if( k >= begin && k < end )
+    VecGetValues(v, 1, &k, &value);
+  Parallel::sum(value);
+
+  return value;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * DDMSolverBase::solve_iv_trace_arclength:  trace IV curve by pseudo-arc-length continuation.
+ * the applied voltage lambda of trace electrode is an unknown of the augmented system
+ *   F(x, lambda) = 0
+ *   N(x, lambda) = t1*(u1-u1_0) + t2*(u2-u2_0) - ds = 0
+ * where u1 is the electrode potential, u2 = lambda - u1 is the voltage drop on a fixed load
+ * resistance, i.e. the scaled electrode current, and (t1, t2) is the unit tangent of IV curve in (u1, u2) plane.
+ * Newton method with bordered block elimination is used, both blocks are solved by the
+ * factorization of Jacobian J:
+ *   J a = F, J b = dF/dlambda
+ *   dlambda = ((t1-t2)*a_k - N)/(t2 - (t1-t2)*b_k),  dx = -a - b*dlambda
+ * the tangent at last solution is also given by b, which predicts the next point.
+ */
+int DDMSolverBase::solve_iv_trace_arclength()
+{
+  int error = 0;
+
+  std::string electrode_trace = SolverSpecify::Electrode_VScan[0];
+  BoundaryCondition * bc_trace = _system.get_bcs()->get_bc(electrode_trace);
+  PetscScalar R_bak = bc_trace->ext_circuit()->serial_resistance();
+
+  // the load resistance, IV curve is a smooth function of applied voltage with it
+  const PetscScalar Rload = PhysicalUnit::V/(1e-5*PhysicalUnit::A);
+
+  // global index of electrode potential in solution vector
+  const PetscInt k = bc_trace->global_offset();
+
+  // the direction and step length of arc
+  const PetscScalar direction = SolverSpecify::VStep > 0 ? 1.0 : -1.0;
+  PetscScalar ds = fabs(SolverSpecify::VStep);
+  const PetscScalar ds_min = ds/256;
+  const PetscScalar ds_max = std::max(fabs(SolverSpecify::VStepMax), 50*ds);
+
+  // set electrode with transient time 0 value of stimulate source(s)
+  _system.get_electrical_source()->update ( 0 );
+  _system.get_field_source()->update ( 0 );
+
+  // not time dependent
+  SolverSpecify::TimeDependent = false;
+  SolverSpecify::dt = 1e100;
+  SolverSpecify::clock = 0.0;
+
+  solve_iv_trace_begin();
+
+  MESSAGE<<"IV automatically trace by pseudo-arc-length continuation\n"; RECORD();
+
+  // the initial point
+  PetscScalar lambda = SolverSpecify::VStart;
+  bc_trace->ext_circuit()->set_serial_resistance(Rload);
+  bc_trace->ext_circuit()->Vapp() = lambda;
+
+  this->pre_solve_process();
+  snes_solve();
+
+  SNESConvergedReason reason;
+  SNESGetConvergedReason ( snes, &reason );
+
+  PetscInt lits;
+  SNESGetLinearSolveIterations(snes, &lits);
+
+  if(reason<0)
+  {
+    MESSAGE<<"I can't get convergence even at initial point, need a better initial condition.\n\n"; RECORD();
+    bc_trace->ext_circuit()->set_serial_resistance(R_bak);
+    solve_iv_trace_end();
+    return 1;
+  }
+
+  MESSAGE
+      <<"--------------------------------------------------------------------------------\n"
+      <<"      "<<SNESConvergedReasons[reason]<<", total linear iteration " << lits << "\n\n\n";
+  RECORD();
+
+  this->post_solve_process();
+
+  PetscScalar I = bc_trace->ext_circuit()->current();
+  PetscScalar Potential = bc_trace->ext_circuit()->potential();
+
+  // last solution, newton update and the new iterate
+  Vec x0, a, y, w;
+  VecDuplicate(x, &x0);
+  VecDuplicate(x, &a);
+  VecDuplicate(x, &y);
+  VecDuplicate(x, &w);
+
+  // tangent of last accepted step, zero before the first step
+  PetscScalar t1_last = 0.0, t2_last = 0.0;
+
+  int n_failed = 0;
+
+  while(Potential*direction < SolverSpecify::VStop*direction && fabs(I) < SolverSpecify::IStop)
+  {
+    VecCopy(x, x0);
+    const PetscScalar lambda0 = lambda;
+    const PetscScalar u1_0 = _vec_global_value(x0, k);
+
+    // dF/dlambda, the residual is linear to applied voltage
+    const PetscScalar dlambda_fd = 1.0*PhysicalUnit::V;
+    bc_trace->ext_circuit()->Vapp() = lambda0 + dlambda_fd;
+    sens_residual(x0, pdF_pdV);
+    bc_trace->ext_circuit()->Vapp() = lambda0;
+    sens_residual(x0, f);
+    VecAXPY(pdF_pdV, -1.0, f);
+    VecScale(pdF_pdV, 1.0/dlambda_fd);
+
+    // tangent: dx/dlambda = -b, du1/dlambda = -b_k, du2/dlambda = 1 + b_k
+    sens_jacobian(x0, &J, &J);
+#if PETSC_VERSION_GE(3,5,0)
+    KSPSetOperators(kspc, J, J);
+#else
+    KSPSetOperators(kspc, J, J, SAME_NONZERO_PATTERN);
+#endif
+    KSPSolve(kspc, pdF_pdV, pdx_pdV);
+
+    PetscScalar bk = _vec_global_value(pdx_pdV, k);
+    PetscScalar tnorm = sqrt(bk*bk + (1+bk)*(1+bk));
+    PetscScalar t1 = -bk/tnorm;
+    PetscScalar t2 = (1+bk)/tnorm;
+
+    // keep the orientation of the curve, the first step follows the sign of VStep
+    PetscScalar orientation = (t1_last == 0.0 && t2_last == 0.0) ? (t1+t2)*direction : t1*t1_last + t2*t2_last;
+    if(orientation < 0) { t1 = -t1; t2 = -t2; }
+
+    // predictor along the tangent, since lambda = u1 + u2, dlambda/ds = t1 + t2
+    lambda = lambda0 + (t1+t2)*ds;
+    if(SolverSpecify::Predict)
+    {
+      VecAXPY(x, -(t1+t2)*ds, pdx_pdV);
+      this->projection_positive_density_check(x, x0);
+    }
+
+    MESSAGE << "Trace "<< electrode_trace <<" for VTrace=" << lambda/PhysicalUnit::V << "(V), V=" << Potential/PhysicalUnit::V
+            << "(V), arc step " << ds/PhysicalUnit::V << '\n'
+            <<"--------------------------------------------------------------------------------\n";
+    RECORD();
+
+    // corrector, newton iteration of the bordered system
+    this->pre_solve_process(false);
+    snes_solve_prepare();
+
+    reason = SNES_CONVERGED_ITERATING;
+    PetscReal ynorm = 0.0;
+    PetscInt its = 0;
+    for(; ; ++its)
+    {
+      bc_trace->ext_circuit()->Vapp() = lambda;
+      sens_residual(x, f);
+
+      PetscReal fnorm, xnorm;
+      VecNorm(f, NORM_2, &fnorm);
+      VecNorm(x, NORM_2, &xnorm);
+      jacobian_reuse_monitor(its, fnorm);
+      this->petsc_snes_convergence_test(its, xnorm, ynorm, fnorm, &reason);
+      if(reason != SNES_CONVERGED_ITERATING) break;
+
+      if(its >= static_cast<PetscInt>(SolverSpecify::MaxIteration))
+      { reason = SNES_DIVERGED_MAX_IT; break; }
+
+      sens_jacobian(x, &J, &J);
+#if PETSC_VERSION_GE(3,5,0)
+      KSPSetOperators(kspc, J, J);
+#else
+      KSPSetOperators(kspc, J, J, SAME_NONZERO_PATTERN);
+#endif
+      KSPConvergedReason ksp_reason;
+      KSPSolve(kspc, f, a);
+      KSPGetConvergedReason(kspc, &ksp_reason);
+      if(ksp_reason < 0) { reason = SNES_DIVERGED_LINEAR_SOLVE; break; }
+      KSPSolve(kspc, pdF_pdV, pdx_pdV);
+
+      const PetscScalar u1 = _vec_global_value(x, k);
+      const PetscScalar ak = _vec_global_value(a, k);
+      bk = _vec_global_value(pdx_pdV, k);
+
+      // arc length constraint and the elimination of the border
+      const PetscScalar N = t1*(u1-u1_0) + t2*((lambda-u1)-(lambda0-u1_0)) - ds;
+      const PetscScalar dlambda = ((t1-t2)*ak - N)/(t2 - (t1-t2)*bk);
+
+      // newton direction y = a + b*dlambda, the new iterate is w = x - y
+      VecWAXPY(y, dlambda, pdx_pdV, a);
+
+      PetscBool changed_y = PETSC_FALSE, changed_w = PETSC_FALSE;
+      sens_line_search_pre_check(x, y, &changed_y);
+      VecWAXPY(w, -1.0, y, x);
+      sens_line_search_post_check(x, y, w, &changed_y, &changed_w);
+
+      VecCopy(w, x);
+      lambda += dlambda;
+      VecNorm(y, NORM_2, &ynorm);
+    }
+
+    if(reason > 0)
+    {
+      MESSAGE
+          <<"--------------------------------------------------------------------------------\n"
+          <<"      "<<SNESConvergedReasons[reason]<<", newton iteration " << its << "\n\n\n";
+      RECORD();
+
+      this->post_solve_process();
+
+      I = bc_trace->ext_circuit()->current();
+      Potential = bc_trace->ext_circuit()->potential();
+
+      t1_last = t1;
+      t2_last = t2;
+      n_failed = 0;
+
+      // step length from the cost of corrector
+      if(its <= 3)      ds = std::min(1.5*ds, ds_max);
+      else if(its >= 8) ds = std::max(0.5*ds, ds_min);
+    }
+    else
+    {
+      MESSAGE<<"--------------------------------------------------------------------------------\n"
+             <<"      "<<SNESConvergedReasons[reason]<<", reduce arc step and try again...\n\n\n";
+      RECORD();
+
+      if(++n_failed > 8 || ds <= ds_min)
+      {
+        MESSAGE<<"------>  Too many failed steps, give up tring.\n\n\n";RECORD();
+        error = 1;
+        break;
+      }
+
+      VecCopy(x0, x);
+      lambda = lambda0;
+      bc_trace->ext_circuit()->Vapp() = lambda;
+      ds = std::max(0.5*ds, ds_min);
+    }
+  }
+
+  VecDestroy(PetscDestroyObject(x0));
+  VecDestroy(PetscDestroyObject(a));
+  VecDestroy(PetscDestroyObject(y));
+  VecDestroy(PetscDestroyObject(w));
+
+  bc_trace->ext_circuit()->set_serial_resistance(R_bak);
+  solve_iv_trace_end();
+
+  SolverSpecify::tran_histroy = false;
+
+  return error;
+}
+
+
 /*----------------------------------------------------------------------------
  * transient simulation!
  */
@@ -1401,9 +2069,27 @@ int DDMSolverBase::solve_transient()
 
   std::deque<double> time_step_success;
   double average_time_step = SolverSpecify::dt;
+
+  // resume from checkpoint, which is written at the end of an accepted time step
+  bool finished = false;
+  if ( !SolverSpecify::Restart.empty() )
+  {
+    if ( !this->read_checkpoint ( time_step_success ) )
+    {
+      MESSAGE<<"ERROR: can not restart transient simulation from checkpoint " << SolverSpecify::Restart << ".\n"; RECORD();
+      genius_error();
+    }
+    finished = SolverSpecify::clock >= SolverSpecify::TStop+0.5*SolverSpecify::dt;
+  }
+
   // the main loop of transient solver.
   do
   {
+    if ( finished ) break;
+
+    // time step is accepted in this loop
+    bool accepted = false;
+
     MESSAGE
     <<"t = "<<SolverSpecify::clock/s*1e12<<" ps, "<< "dt = " << SolverSpecify::dt/s*1e12 <<" ps"<< '\n'
     <<"--------------------------------------------------------------------------------\n";
@@ -1561,6 +2247,7 @@ int DDMSolverBase::solve_transient()
 
     // time step counter ++
     SolverSpecify::T_Cycles++;
+    accepted = true;
 
     // save time step information
     SolverSpecify::dt_last_last = SolverSpecify::dt_last;
@@ -1650,6 +2337,17 @@ int DDMSolverBase::solve_transient()
       }
     }
 
+    // a restarted simulation starts with a fresh jacobian. refresh it at every step a checkpoint
+    // may be written, whether it is written or not, so a checkpoint never changes the Newton path
+    if ( accepted && SolverSpecify::T_Cycles % SolverSpecify::CheckpointSteps == 0 )
+      this->refresh_jacobian();
+
+    // periodic checkpoint, and the last one at the end of simulation
+    if ( accepted && !SolverSpecify::Checkpoint.empty() &&
+         ( SolverSpecify::T_Cycles % SolverSpecify::CheckpointSteps == 0 ||
+           SolverSpecify::clock >= SolverSpecify::TStop+0.5*SolverSpecify::dt ) )
+      this->write_checkpoint ( time_step_success );
+
   }
   while ( SolverSpecify::clock < SolverSpecify::TStop+0.5*SolverSpecify::dt );
 
@@ -1784,6 +2482,15 @@ void DDMSolverBase::petsc_snes_convergence_test ( PetscInt its, PetscReal , Pets
   // update error norm
   this->error_norm();
 
+  // memory usage and residual of each newton step for performance trace
+  if ( perflog.tracing() )
+  {
+    MMU * mmu = MMU::instance();
+    mmu->measure();
+    perflog.trace_counter ( "VmRSS(kB)", mmu->vmrss(), "Memory" );
+    perflog.trace_counter ( "fnorm", fnorm, "Newton" );
+  }
+
   *reason = SNES_CONVERGED_ITERATING;
 
   // the first iteration
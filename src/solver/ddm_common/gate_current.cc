@@ -128,8 +128,9 @@ void InsulatorSemiconductorInterfaceBC::_gate_current()
     PetscScalar Affinity_semi = semiconductor_node->node_data()->affinity();
     PetscScalar Efn_semi = semiconductor_node->node_data()->qFn();
     PetscScalar Efp_semi = semiconductor_node->node_data()->qFp();
-    PetscScalar me_semi = semiconductor_region->material()->band->EffecElecMass(T_semi);
-    PetscScalar mh_semi = semiconductor_region->material()->band->EffecHoleMass(T_semi);
+    const PMI_Context ctx = semiconductor_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node->node_data(), SolverSpecify::clock);
+    PetscScalar me_semi = semiconductor_region->material()->band->EffecElecMass(ctx, T_semi);
+    PetscScalar mh_semi = semiconductor_region->material()->band->EffecHoleMass(ctx, T_semi);
 
     // barraier (of conduction band)
     const FVM_Node * insulator_node = get_region_fvm_node(node_it->first, insulator_region);    assert(insulator_node);
@@ -195,8 +196,8 @@ void InsulatorSemiconductorInterfaceBC::_gate_current()
       PetscScalar P_insulator_n = insulator_region->material()->band->HCI_Probability_Insulator_n( t, E_insulator);
       PetscScalar P_insulator_p = insulator_region->material()->band->HCI_Probability_Insulator_p( t, E_insulator );
 
-      PetscScalar Jn_HCI = n_semi*P_insulator_n*semiconductor_region->material()->band->HCI_Integral_Fiegna_n(phi_barrier_n, E_eff_n);
-      PetscScalar Jp_HCI = p_semi*P_insulator_p*semiconductor_region->material()->band->HCI_Integral_Fiegna_p(phi_barrier_p, E_eff_p);
+      PetscScalar Jn_HCI = n_semi*P_insulator_n*semiconductor_region->material()->band->HCI_Integral_Fiegna_n(ctx, phi_barrier_n, E_eff_n);
+      PetscScalar Jp_HCI = p_semi*P_insulator_p*semiconductor_region->material()->band->HCI_Integral_Fiegna_p(ctx, phi_barrier_p, E_eff_p);
 
       In = Jn_HCI*semiconductor_node->outside_boundary_surface_area()*current_scale;
       Ip = Jp_HCI*semiconductor_node->outside_boundary_surface_area()*current_scale;
@@ -421,8 +422,9 @@ void InsulatorSemiconductorInterfaceBC::_gate_current_function(PetscScalar * x,
     PetscScalar Ev_semi = Ec_semi - Eg_semi;
     PetscScalar Efn_semi = -(e*V_semi + Affinity_semi) + log(fabs(n_semi/semiconductor_node->node_data()->Nc()))*kb*T_semi;
     PetscScalar Efp_semi = -(e*V_semi + Affinity_semi + Eg_semi) - log(fabs(p_semi/semiconductor_node->node_data()->Nv()))*kb*T_semi;
-    PetscScalar me_semi = semiconductor_region->material()->band->EffecElecMass(T_semi);
-    PetscScalar mh_semi = semiconductor_region->material()->band->EffecHoleMass(T_semi);
+    const PMI_Context ctx = semiconductor_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node->node_data(), SolverSpecify::clock);
+    PetscScalar me_semi = semiconductor_region->material()->band->EffecElecMass(ctx, T_semi);
+    PetscScalar mh_semi = semiconductor_region->material()->band->EffecHoleMass(ctx, T_semi);
 
     // barraier (of conduction band)
     const FVM_Node * insulator_node = get_region_fvm_node(node_it->first, insulator_region);    assert(insulator_node);
@@ -617,8 +619,9 @@ void InsulatorSemiconductorInterfaceBC::_gate_current_jacobian(PetscScalar * x,
     AutoDScalar Ev_semi = Ec_semi - Eg_semi;
     AutoDScalar Efn_semi = -(e*V_semi + Affinity_semi) + log(fabs(n_semi/semiconductor_node->node_data()->Nc()))*kb*T_semi;
     AutoDScalar Efp_semi = -(e*V_semi + Affinity_semi + Eg_semi) - log(fabs(p_semi/semiconductor_node->node_data()->Nv()))*kb*T_semi;
-    PetscScalar me_semi = semiconductor_region->material()->band->EffecElecMass(T_semi);
-    PetscScalar mh_semi = semiconductor_region->material()->band->EffecHoleMass(T_semi);
+    const PMI_Context ctx = semiconductor_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node->node_data(), SolverSpecify::clock);
+    PetscScalar me_semi = semiconductor_region->material()->band->EffecElecMass(ctx, T_semi);
+    PetscScalar mh_semi = semiconductor_region->material()->band->EffecHoleMass(ctx, T_semi);
 
     // barraier (of conduction band)
     const FVM_Node * insulator_node = get_region_fvm_node(node_it->first, insulator_region);    assert(insulator_node);
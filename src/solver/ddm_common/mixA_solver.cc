@@ -22,6 +22,7 @@
 
 #include <stack>
 #include <iomanip>
+#include <deque>
 
 #include "solver_specify.h"
 #include "physical_unit.h"
@@ -64,6 +65,15 @@ int MixASolverBase::create_solver()
   // user can do further adjusment from command line
   SNESSetFromOptions (snes);
 
+  // eliminate device dofs, the linear system is solved directly by Schur complement
+  if(SolverSpecify::MixSchur)
+  {
+    MESSAGE<< "Using Schur complement of device dofs for mixed-mode solver..."<<std::endl;  RECORD();
+    KSPSetType (ksp, (char*) KSPPREONLY);
+    if (!_schur) _schur = new MixSchurSolver(n_global_dofs - extra_dofs());
+    _schur->attach(pc);
+  }
+
   return FVM_FlexNonlinearSolver::create_solver();
 }
 
@@ -74,6 +84,10 @@ int MixASolverBase::destroy_solver()
   // clear nonlinear matrix/vector
   clear_nonlinear_data();
 
+  // Schur complement solver is referenced by pc, free it after snes
+  delete _schur;
+  _schur = 0;
+
 #if defined(HAVE_FENV_H)
   feclearexcept(FE_INVALID);
 #endif
@@ -1227,8 +1241,8 @@ int MixASolverBase::solve_transient()
   }
 
 
-  // if we need do op
-  if(SolverSpecify::tran_op)
+  // if we need do op, a restarted simulation loads the state from checkpoint instead
+  if(SolverSpecify::tran_op && SolverSpecify::Restart.empty())
   {
     solve_dcop(true);
   }
@@ -1271,10 +1285,29 @@ int MixASolverBase::solve_transient()
     _circuit->set_integrate_method(GEAR);
   }
 
+  // resume from checkpoint, which is written at the end of an accepted time step
+  bool finished = false;
+  if( !SolverSpecify::Restart.empty() )
+  {
+    std::deque<double> time_step_success;
+    if( !this->read_checkpoint(time_step_success) )
+    {
+      MESSAGE<<"ERROR: can not restart transient simulation from checkpoint " << SolverSpecify::Restart << ".\n"; RECORD();
+      genius_error();
+    }
+    if(Genius::is_last_processor())
+      _circuit->set_time_order(2);
+    finished = SolverSpecify::clock >= SolverSpecify::TStop+0.5*SolverSpecify::dt;
+  }
 
   // the main loop of transient solver.
   do
   {
+    if( finished ) break;
+
+    // time step is accepted in this loop
+    bool accepted = false;
+
     MESSAGE
     <<"t = "<<SolverSpecify::clock/s*1e12<<" ps, "<< "dt = " << SolverSpecify::dt/s*1e12 <<" ps"<< '\n'
     <<"--------------------------------------------------------------------------------\n";
@@ -1441,6 +1474,7 @@ int MixASolverBase::solve_transient()
 
     // time step counter ++
     SolverSpecify::T_Cycles++;
+    accepted = true;
 
     // save time step information
     SolverSpecify::dt_last_last = SolverSpecify::dt_last;
@@ -1522,6 +1556,17 @@ int MixASolverBase::solve_transient()
       }
     }
 
+    // a restarted simulation starts with a fresh jacobian. refresh it at every step a checkpoint
+    // may be written, whether it is written or not, so a checkpoint never changes the Newton path
+    if ( accepted && SolverSpecify::T_Cycles % SolverSpecify::CheckpointSteps == 0 )
+      this->refresh_jacobian();
+
+    // periodic checkpoint, and the last one at the end of simulation
+    if ( accepted && !SolverSpecify::Checkpoint.empty() &&
+         ( SolverSpecify::T_Cycles % SolverSpecify::CheckpointSteps == 0 ||
+           SolverSpecify::clock >= SolverSpecify::TStop+0.5*SolverSpecify::dt ) )
+      this->write_checkpoint ( std::deque<double>() );
+
   }
   while(SolverSpecify::clock < SolverSpecify::TStop+0.5*SolverSpecify::dt);
 
@@ -1555,6 +1600,20 @@ int MixASolverBase::solve_transient()
 #if PETSC_VERSION_GE(3, 6, 0)
   #include <petsc/private/snesimpl.h>
 #endif
+void MixASolverBase::checkpoint_extra(CheckpointWriter & out)
+{
+  _circuit->checkpoint(out);
+}
+
+
+
+bool MixASolverBase::restart_extra(CheckpointReader & in)
+{
+  return _circuit->restart(in);
+}
+
+
+
 void MixASolverBase::petsc_snes_convergence_test(PetscInt its, PetscReal , PetscReal pnorm, PetscReal fnorm, SNESConvergedReason *reason)
 {
   // update error norm
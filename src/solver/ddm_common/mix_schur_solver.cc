@@ -0,0 +1,411 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+#include <map>
+#include <set>
+
+#include "genius_common.h"
+#include "genius_env.h"
+#include "log.h"
+#include "parallel.h"
+#include "klu_solver.h"
+#include "mix_schur_solver.h"
+
+#include "petscmat.h"
+#include "petscvec.h"
+
+
+/*------------------------------------------------------------------
+ * PETSc shell preconditioner interface
+ */
+#if PETSC_VERSION_GE(3,1,0)
+static PetscErrorCode MixSchur_PCSetUp(PC pc)
+{
+  void * ctx;
+  PCShellGetContext(pc, &ctx);
+  MixSchurSolver * schur = static_cast<MixSchurSolver *>(ctx);
+
+  Mat A, P;
+#if PETSC_VERSION_GE(3,5,0)
+  PCGetOperators(pc, &A, &P);
+#else
+  MatStructure flag;
+  PCGetOperators(pc, &A, &P, &flag);
+#endif
+  return schur->setup(P);
+}
+
+static PetscErrorCode MixSchur_PCApply(PC pc, Vec b, Vec x)
+{
+  void * ctx;
+  PCShellGetContext(pc, &ctx);
+  MixSchurSolver * schur = static_cast<MixSchurSolver *>(ctx);
+  return schur->solve(b, x);
+}
+#endif
+
+
+
+MixSchurSolver::MixSchurSolver(PetscInt n_device_dofs)
+  : _n_device_dofs(n_device_dofs), _n_local_device_dofs(0), _n_spice_dofs(0),
+    _is_device(0), _is_spice(0), _A(0), _C(0), _ksp(0), _klu(0),
+    _bd(0), _xd(0), _cz(0), _S_lu(0), _s_rhs(0), _s_sol(0)
+{}
+
+
+MixSchurSolver::~MixSchurSolver()
+{
+  clear();
+}
+
+
+void MixSchurSolver::clear()
+{
+  _clear_Y();
+  _electrode_cols.clear();
+
+  if(_ksp) KSPDestroy(PetscDestroyObject(_ksp));
+  if(_A)   MatDestroy(PetscDestroyObject(_A));
+  if(_C)   MatDestroy(PetscDestroyObject(_C));
+  if(_is_device) ISDestroy(PetscDestroyObject(_is_device));
+  if(_is_spice)  ISDestroy(PetscDestroyObject(_is_spice));
+  if(_bd)  VecDestroy(PetscDestroyObject(_bd));
+  if(_xd)  VecDestroy(PetscDestroyObject(_xd));
+  if(_cz)  VecDestroy(PetscDestroyObject(_cz));
+  if(_S_lu)  MatDestroy(PetscDestroyObject(_S_lu));
+  if(_s_rhs) VecDestroy(PetscDestroyObject(_s_rhs));
+  if(_s_sol) VecDestroy(PetscDestroyObject(_s_sol));
+  _ksp = 0;
+  _A = 0;
+  _C = 0;
+  _is_device = 0;
+  _is_spice = 0;
+  _bd = 0;
+  _xd = 0;
+  _cz = 0;
+  _S_lu = 0;
+  _s_rhs = 0;
+  _s_sol = 0;
+
+  // KLU solver is referenced by the pc of _ksp, free it after _ksp
+  delete _klu;
+  _klu = 0;
+
+  _S.resize(0, 0);
+}
+
+
+void MixSchurSolver::_clear_Y()
+{
+  for(unsigned int i=0; i<_Y.size(); ++i)
+    VecDestroy(PetscDestroyObject(_Y[i]));
+  _Y.clear();
+}
+
+
+void MixSchurSolver::attach(PC pc)
+{
+#if PETSC_VERSION_GE(3,1,0)
+  PetscErrorCode ierr;
+  ierr = PCSetType(pc, PCSHELL); genius_assert(!ierr);
+  ierr = PCShellSetContext(pc, this); genius_assert(!ierr);
+  ierr = PCShellSetSetUp(pc, MixSchur_PCSetUp); genius_assert(!ierr);
+  ierr = PCShellSetApply(pc, MixSchur_PCApply); genius_assert(!ierr);
+  ierr = PCShellSetName(pc, "MixSchur"); genius_assert(!ierr);
+#else
+  MESSAGE<<"ERROR: Schur complement mixed-mode solver requires PETSc 3.1 or later." << std::endl; RECORD();
+  genius_error();
+#endif
+}
+
+
+void MixSchurSolver::_create_device_solver()
+{
+  PetscErrorCode ierr;
+  PC pc;
+
+  ierr = KSPCreate(PETSC_COMM_WORLD, &_ksp); genius_assert(!ierr);
+  ierr = KSPSetOptionsPrefix(_ksp, "mix_schur_"); genius_assert(!ierr);
+  ierr = KSPGetPC(_ksp, &pc); genius_assert(!ierr);
+
+  if (Genius::n_processors() == 1)
+  {
+    ierr = KSPSetType (_ksp, (char*) KSPPREONLY); genius_assert(!ierr);
+    _klu = new KLUSolver;
+    _klu->attach(pc);
+  }
+  else
+  {
+#ifdef PETSC_HAVE_MUMPS
+    ierr = KSPSetType (_ksp, (char*) KSPPREONLY); genius_assert(!ierr);
+    ierr = PCSetType  (pc, (char*) PCLU); genius_assert(!ierr);
+    ierr = PCFactorSetMatSolverPackage (pc, "mumps"); genius_assert(!ierr);
+#else
+    MESSAGE<< "Warning:  no MUMPS solver configured, device block of Schur complement solver use GMRES instead!" << std::endl;
+    RECORD();
+    ierr = KSPSetType (_ksp, (char*) KSPGMRES); genius_assert(!ierr);
+    ierr = PCSetType  (pc, (char*) PCASM);      genius_assert(!ierr);
+    ierr = KSPSetTolerances(_ksp, 1e-14, 1e-30, PETSC_DEFAULT, 1000); genius_assert(!ierr);
+#endif
+  }
+
+  ierr = KSPSetFromOptions(_ksp); genius_assert(!ierr);
+}
+
+
+PetscErrorCode MixSchurSolver::setup(Mat P)
+{
+  PetscErrorCode ierr;
+
+  PetscInt M, N;
+  ierr = MatGetSize(P, &M, &N); CHKERRQ(ierr);
+  genius_assert(M == N && _n_device_dofs <= M);
+
+  PetscInt begin, end;
+  ierr = MatGetOwnershipRange(P, &begin, &end); CHKERRQ(ierr);
+
+  const PetscInt device_end = std::min(end, _n_device_dofs);
+  const PetscInt spice_begin = std::max(begin, _n_device_dofs);
+
+  // device and spice blocks of P, the pattern is kept between jacobians
+  MatReuse reuse = MAT_REUSE_MATRIX;
+  if(!_A)
+  {
+    reuse = MAT_INITIAL_MATRIX;
+
+    _n_local_device_dofs = std::max(device_end - begin, static_cast<PetscInt>(0));
+    _n_spice_dofs = M - _n_device_dofs;
+
+    // the spice dofs should be the tail of the last processor
+    PetscInt n_local_spice_dofs = std::max(end - spice_begin, static_cast<PetscInt>(0));
+    genius_assert(n_local_spice_dofs == (Genius::is_last_processor() ? _n_spice_dofs : 0));
+
+    ierr = ISCreateStride(PETSC_COMM_WORLD, _n_local_device_dofs, begin, 1, &_is_device); CHKERRQ(ierr);
+    ierr = ISCreateStride(PETSC_COMM_WORLD, n_local_spice_dofs, spice_begin, 1, &_is_spice); CHKERRQ(ierr);
+
+    ierr = VecCreateMPI(PETSC_COMM_WORLD, _n_local_device_dofs, _n_device_dofs, &_bd); CHKERRQ(ierr);
+    ierr = VecDuplicate(_bd, &_xd); CHKERRQ(ierr);
+    ierr = VecCreateMPI(PETSC_COMM_WORLD, n_local_spice_dofs, _n_spice_dofs, &_cz); CHKERRQ(ierr);
+
+    _create_device_solver();
+  }
+
+  ierr = MatGetSubMatrix(P, _is_device, _is_device, reuse, &_A); CHKERRQ(ierr);
+  ierr = MatGetSubMatrix(P, _is_spice, _is_device, reuse, &_C); CHKERRQ(ierr);
+
+  // factorize the device block
+#if PETSC_VERSION_GE(3,5,0)
+  ierr = KSPSetOperators(_ksp, _A, _A); CHKERRQ(ierr);
+#else
+  ierr = KSPSetOperators(_ksp, _A, _A, SAME_NONZERO_PATTERN); CHKERRQ(ierr);
+#endif
+  ierr = KSPSetUp(_ksp); CHKERRQ(ierr);
+
+  // nonzero columns of block B, grouped by column
+  std::map<PetscInt, std::vector<std::pair<PetscInt, PetscScalar> > > B;
+  for(PetscInt row=begin; row<device_end; ++row)
+  {
+    PetscInt ncols;
+    const PetscInt * cols;
+    const PetscScalar * vals;
+    ierr = MatGetRow(P, row, &ncols, &cols, &vals); CHKERRQ(ierr);
+    for(PetscInt j=0; j<ncols; ++j)
+      if(cols[j] >= _n_device_dofs)
+        B[cols[j]].push_back(std::make_pair(row, vals[j]));
+    ierr = MatRestoreRow(P, row, &ncols, &cols, &vals); CHKERRQ(ierr);
+  }
+
+  std::set<PetscInt> electrode_cols;
+  std::map<PetscInt, std::vector<std::pair<PetscInt, PetscScalar> > >::const_iterator it = B.begin();
+  for(; it!=B.end(); ++it)
+    electrode_cols.insert(it->first);
+  Parallel::allgather(electrode_cols);
+
+  if(electrode_cols.size() != _Y.size())
+  {
+    _clear_Y();
+    _Y.resize(electrode_cols.size());
+    for(unsigned int i=0; i<_Y.size(); ++i)
+    { ierr = VecDuplicate(_bd, &_Y[i]); CHKERRQ(ierr); }
+  }
+  _electrode_cols.assign(electrode_cols.begin(), electrode_cols.end());
+
+  // Y = A^-1 B, one solve with the device factorization for each electrode column
+  for(unsigned int i=0; i<_electrode_cols.size(); ++i)
+  {
+    ierr = VecSet(_bd, 0.0); CHKERRQ(ierr);
+
+    it = B.find(_electrode_cols[i]);
+    if(it != B.end())
+    {
+      PetscScalar * bb;
+      ierr = VecGetArray(_bd, &bb); CHKERRQ(ierr);
+      for(unsigned int k=0; k<it->second.size(); ++k)
+        bb[it->second[k].first - begin] = it->second[k].second;
+      ierr = VecRestoreArray(_bd, &bb); CHKERRQ(ierr);
+    }
+
+    ierr = KSPSolve(_ksp, _bd, _Y[i]); CHKERRQ(ierr);
+  }
+
+  // block D, on the last processor
+  if(Genius::is_last_processor())
+  {
+    _S.resize(_n_spice_dofs, _n_spice_dofs);
+    for(PetscInt row=spice_begin; row<end; ++row)
+    {
+      PetscInt ncols;
+      const PetscInt * cols;
+      const PetscScalar * vals;
+      ierr = MatGetRow(P, row, &ncols, &cols, &vals); CHKERRQ(ierr);
+      for(PetscInt j=0; j<ncols; ++j)
+        if(cols[j] >= _n_device_dofs)
+          _S(row-_n_device_dofs, cols[j]-_n_device_dofs) = vals[j];
+      ierr = MatRestoreRow(P, row, &ncols, &cols, &vals); CHKERRQ(ierr);
+    }
+  }
+
+  // S = D - C Y
+  for(unsigned int i=0; i<_electrode_cols.size(); ++i)
+  {
+    ierr = MatMult(_C, _Y[i], _cz); CHKERRQ(ierr);
+    if(Genius::is_last_processor())
+    {
+      const unsigned int col = _electrode_cols[i] - _n_device_dofs;
+      PetscScalar * cz;
+      ierr = VecGetArray(_cz, &cz); CHKERRQ(ierr);
+      for(PetscInt r=0; r<_n_spice_dofs; ++r)
+        _S(r, col) -= cz[r];
+      ierr = VecRestoreArray(_cz, &cz); CHKERRQ(ierr);
+    }
+  }
+
+  // factorize S once per jacobian
+  if(Genius::is_last_processor() && _n_spice_dofs)
+  { ierr = _factorize_S(); CHKERRQ(ierr); }
+
+  return 0;
+}
+
+
+PetscErrorCode MixSchurSolver::_factorize_S()
+{
+  PetscErrorCode ierr;
+
+  // factored matrix can not be refilled, build a new one
+  if(_S_lu) { ierr = MatDestroy(PetscDestroyObject(_S_lu)); CHKERRQ(ierr); }
+  ierr = MatCreateSeqDense(PETSC_COMM_SELF, _n_spice_dofs, _n_spice_dofs, PETSC_NULL, &_S_lu); CHKERRQ(ierr);
+
+  std::vector<PetscInt> index(_n_spice_dofs);
+  for(PetscInt i=0; i<_n_spice_dofs; ++i)
+    index[i] = i;
+  // _S is row-major, the same as the default orientation of MatSetValues
+  ierr = MatSetValues(_S_lu, _n_spice_dofs, &index[0], _n_spice_dofs, &index[0], &(_S.get_values()[0]), INSERT_VALUES); CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(_S_lu, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(_S_lu, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+
+  // dense LU of PETSc calls LAPACK getrf, which does partial pivoting. the orderings are not used
+  MatFactorInfo factor_info;
+  ierr = MatFactorInfoInitialize(&factor_info); CHKERRQ(ierr);
+  ierr = MatLUFactor(_S_lu, PETSC_NULL, PETSC_NULL, &factor_info); CHKERRQ(ierr);
+
+  if(!_s_rhs)
+  {
+    ierr = VecCreateSeq(PETSC_COMM_SELF, _n_spice_dofs, &_s_rhs); CHKERRQ(ierr);
+    ierr = VecDuplicate(_s_rhs, &_s_sol); CHKERRQ(ierr);
+  }
+
+  return 0;
+}
+
+
+PetscErrorCode MixSchurSolver::solve(Vec b, Vec x)
+{
+  PetscErrorCode ierr;
+
+  // z = A^-1 b_d
+  {
+    PetscScalar * bb;
+    PetscScalar * bd;
+    ierr = VecGetArray(b, &bb); CHKERRQ(ierr);
+    ierr = VecGetArray(_bd, &bd); CHKERRQ(ierr);
+    for(PetscInt i=0; i<_n_local_device_dofs; ++i)
+      bd[i] = bb[i];
+    ierr = VecRestoreArray(_bd, &bd); CHKERRQ(ierr);
+    ierr = VecRestoreArray(b, &bb); CHKERRQ(ierr);
+  }
+  ierr = KSPSolve(_ksp, _bd, _xd); CHKERRQ(ierr);
+
+  // x_s = S^-1 (b_s - C z) by the LU factorization of S
+  ierr = MatMult(_C, _xd, _cz); CHKERRQ(ierr);
+
+  std::vector<PetscScalar> xs(_n_spice_dofs, 0.0);
+  if(Genius::is_last_processor() && _n_spice_dofs)
+  {
+    PetscScalar * bb;
+    PetscScalar * cz;
+    PetscScalar * rhs;
+    ierr = VecGetArray(b, &bb); CHKERRQ(ierr);
+    ierr = VecGetArray(_cz, &cz); CHKERRQ(ierr);
+    ierr = VecGetArray(_s_rhs, &rhs); CHKERRQ(ierr);
+    for(PetscInt i=0; i<_n_spice_dofs; ++i)
+      rhs[i] = bb[_n_local_device_dofs+i] - cz[i];
+    ierr = VecRestoreArray(_s_rhs, &rhs); CHKERRQ(ierr);
+    ierr = VecRestoreArray(_cz, &cz); CHKERRQ(ierr);
+    ierr = VecRestoreArray(b, &bb); CHKERRQ(ierr);
+
+    ierr = MatSolve(_S_lu, _s_rhs, _s_sol); CHKERRQ(ierr);
+
+    PetscScalar * sol;
+    ierr = VecGetArray(_s_sol, &sol); CHKERRQ(ierr);
+    for(PetscInt i=0; i<_n_spice_dofs; ++i)
+      xs[i] = sol[i];
+    ierr = VecRestoreArray(_s_sol, &sol); CHKERRQ(ierr);
+  }
+  Parallel::broadcast(xs, Genius::last_processor_id());
+
+  // x_d = z - Y x_s
+  if(!_electrode_cols.empty())
+  {
+    std::vector<PetscScalar> alpha(_electrode_cols.size());
+    for(unsigned int i=0; i<_electrode_cols.size(); ++i)
+      alpha[i] = -xs[_electrode_cols[i] - _n_device_dofs];
+    ierr = VecMAXPY(_xd, alpha.size(), &alpha[0], &_Y[0]); CHKERRQ(ierr);
+  }
+
+  {
+    PetscScalar * xd;
+    PetscScalar * xx;
+    ierr = VecGetArray(_xd, &xd); CHKERRQ(ierr);
+    ierr = VecGetArray(x, &xx); CHKERRQ(ierr);
+    for(PetscInt i=0; i<_n_local_device_dofs; ++i)
+      xx[i] = xd[i];
+    if(Genius::is_last_processor())
+      for(PetscInt i=0; i<_n_spice_dofs; ++i)
+        xx[_n_local_device_dofs+i] = xs[i];
+    ierr = VecRestoreArray(x, &xx); CHKERRQ(ierr);
+    ierr = VecRestoreArray(_xd, &xd); CHKERRQ(ierr);
+  }
+
+  return 0;
+}
@@ -1086,6 +1086,13 @@ int MixSolverBase::solve_dcsweep()
  */
 int MixSolverBase::solve_transient()
 {
+  // the spice circuit lives in an external ngspice process, its state can not be saved with the device
+  if(!SolverSpecify::Checkpoint.empty() || !SolverSpecify::Restart.empty())
+  {
+    MESSAGE<<"ERROR: checkpoint/restart is not supported by MIX1 transient solver, use MIXA1 instead.\n"; RECORD();
+    genius_error();
+  }
+
   // diverged counter
   int diverged_retry=0;
 
@@ -148,10 +148,10 @@ void SemiconductorSimulationRegion::Mob_Evaluation()
           // stupid code... we can not dot point with VectorValue<PetscScalar> yet.
           VectorValue<PetscScalar> norm(_norm(0), _norm(1), _norm(2));
           // effective electric fields in vertical
-          PetscScalar ZETAN = mt->mob->ZETAN();
-          PetscScalar ETAN  = mt->mob->ETAN();
-          PetscScalar ZETAP = mt->mob->ZETAP();
-          PetscScalar ETAP  = mt->mob->ETAP();
+          PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+          PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+          PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+          PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
           PetscScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
           PetscScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
           // effective electric fields in parallel
@@ -230,7 +230,7 @@ void SemiconductorSimulationRegion::Mob_Evaluation()
       {
 
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         PetscScalar V1    =  n1_data->psi();       // electrostatic potential
         PetscScalar n1    =  n1_data->n();           // electron density
@@ -238,7 +238,7 @@ void SemiconductorSimulationRegion::Mob_Evaluation()
         PetscScalar T1    =  n1_data->T();           // lattice temperature
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         PetscScalar V2    =  n2_data->psi();       // electrostatic potential
         PetscScalar n2    =  n2_data->n();           // electron density
@@ -264,34 +264,28 @@ void SemiconductorSimulationRegion::Mob_Evaluation()
               Et = (E - dir*(E*dir)).size();
             }
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Epn, Et, T1);
-            mup1 = mt->mob->HoleMob(p1, n1, T2, Epp, Et, T2);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Epn, Et, T1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T2, Epp, Et, T2);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T1, Epn, Et, T1);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Epp, Et, T2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T1, Epn, Et, T1);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Epp, Et, T2);
           }
           else // ModelSpecify::EJ || ModelSpecify::EQF
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Epn, Etn, T1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Epp, Etp, T1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Epn, Etn, T1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Epp, Etp, T1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Epn, Etn, T2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Epp, Etp, T2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Epn, Etn, T2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Epp, Etp, T2);
           }
         }
         else
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T1, 0, 0, T1);
-          mup1 = mt->mob->HoleMob(p1, n1, T1, 0, 0, T1);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, 0, 0, T1);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, 0, 0, T1);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T2, 0, 0, T2);
-          mup2 = mt->mob->HoleMob(p2, n2, T2, 0, 0, T2);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, 0, 0, T2);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, 0, 0, T2);
         }
 
         PetscScalar In = std::max(Imin, highfield_mob ? std::abs(In_dd(kb*T1/e,(V1-V2),n1,n2,length)) : 1.0);
@@ -437,10 +431,10 @@ void SemiconductorSimulationRegion::Mob_Evaluation( std::vector< std::pair<unsig
           // stupid code... we can not dot point with VectorValue<PetscScalar> yet.
           VectorValue<PetscScalar> norm(_norm(0), _norm(1), _norm(2));
           // effective electric fields in vertical
-          PetscScalar ZETAN = mt->mob->ZETAN();
-          PetscScalar ETAN  = mt->mob->ETAN();
-          PetscScalar ZETAP = mt->mob->ZETAP();
-          PetscScalar ETAP  = mt->mob->ETAP();
+          PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+          PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+          PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+          PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
           PetscScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
           PetscScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
           // effective electric fields in parallel
@@ -522,7 +516,7 @@ void SemiconductorSimulationRegion::Mob_Evaluation( std::vector< std::pair<unsig
       {
 
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         PetscScalar V1    =  n1_data->psi();       // electrostatic potential
         PetscScalar n1    =  n1_data->n();           // electron density
@@ -530,7 +524,7 @@ void SemiconductorSimulationRegion::Mob_Evaluation( std::vector< std::pair<unsig
         PetscScalar T1    =  n1_data->T();           // lattice temperature
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         PetscScalar V2    =  n2_data->psi();       // electrostatic potential
         PetscScalar n2    =  n2_data->n();           // electron density
@@ -556,34 +550,28 @@ void SemiconductorSimulationRegion::Mob_Evaluation( std::vector< std::pair<unsig
               Et = (E - dir*(E*dir)).size();
             }
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Epn, Et, T1);
-            mup1 = mt->mob->HoleMob(p1, n1, T2, Epp, Et, T2);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Epn, Et, T1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T2, Epp, Et, T2);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T1, Epn, Et, T1);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Epp, Et, T2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T1, Epn, Et, T1);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Epp, Et, T2);
           }
           else // ModelSpecify::EJ || ModelSpecify::EQF
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Epn, Etn, T1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Epp, Etp, T1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Epn, Etn, T1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Epp, Etp, T1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Epn, Etn, T2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Epp, Etp, T2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Epn, Etn, T2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Epp, Etp, T2);
           }
         }
         else
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T1, 0, 0, T1);
-          mup1 = mt->mob->HoleMob(p1, n1, T1, 0, 0, T1);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, 0, 0, T1);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, 0, 0, T1);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T2, 0, 0, T2);
-          mup2 = mt->mob->HoleMob(p2, n2, T2, 0, 0, T2);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, 0, 0, T2);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, 0, 0, T2);
         }
 
         PetscScalar mun = 0.5*(mun1+mun2); // the electron mobility at the mid point of the edge, use linear interpolation
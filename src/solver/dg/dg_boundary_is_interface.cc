@@ -164,9 +164,9 @@ void InsulatorSemiconductorInterfaceBC::DG_Function(PetscScalar * x, Vec f, Inse
   const PetscScalar  melec = insulator_region->material()->band->EffecElecMass(T);
   const PetscScalar  mhole = insulator_region->material()->band->EffecHoleMass(T);
   const PetscScalar  Affinity_ins  = insulator_region->material()->basic->Affinity(T);
-  const PetscScalar  Affinity_semi = semiconductor_region->material()->basic->Affinity(T);
+  const PetscScalar  Affinity_semi = semiconductor_region->material()->basic->Affinity(PMI_Context(), T);
   const PetscScalar  Eg_ins  = insulator_region->material()->band->Eg(T);
-  const PetscScalar  Eg_semi = semiconductor_region->material()->band->Eg(T);
+  const PetscScalar  Eg_semi = semiconductor_region->material()->band->Eg(PMI_Context(), T);
   const PetscScalar  Phi_elec = std::abs(Affinity_semi - Affinity_ins);// elec barrier hight
   const PetscScalar  Phi_hole = std::abs(Affinity_ins+Eg_ins - Affinity_semi - Eg_semi);// hole barrier hight
 
@@ -218,13 +218,15 @@ void InsulatorSemiconductorInterfaceBC::DG_Function(PetscScalar * x, Vec f, Inse
     }
 
 
+    // mapping this node to material library
+    const PMI_Context ctx = semiconductor_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock);
+
     // process interface fixed charge density
     VecSetValue(f, semiconductor_node->global_offset(), (qf+semiconductor_node_data->interface_charge())*boundary_area, ADD_VALUES);
 
     {
       // surface recombination
-      semiconductor_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock);
-      PetscScalar GSurf = - semiconductor_region->material()->band->R_Surf(p, n, T) * boundary_area;
+      PetscScalar GSurf = - semiconductor_region->material()->band->R_Surf(ctx, p, n, T) * boundary_area;
 
       VecSetValue(f, semiconductor_node->global_offset()+1, GSurf, ADD_VALUES);
       VecSetValue(f, semiconductor_node->global_offset()+2, GSurf, ADD_VALUES);
@@ -233,17 +235,17 @@ void InsulatorSemiconductorInterfaceBC::DG_Function(PetscScalar * x, Vec f, Inse
     if (semiconductor_region->get_advanced_model()->Trap)
     {
       // calculate interface trap occupancy
-      PetscScalar ni = semiconductor_region->material()->band->nie(p, n, T);
-      semiconductor_region->material()->trap->Calculate(false,p,n,ni,T);
+      PetscScalar ni = semiconductor_region->material()->band->nie(ctx, p, n, T);
+      semiconductor_region->material()->trap->Calculate(ctx, false,p,n,ni,T);
 
       // contribution of trapped charge to Poisson's eqn
-      PetscScalar TrappedC = semiconductor_region->material()->trap->Charge(false) * boundary_area;
+      PetscScalar TrappedC = semiconductor_region->material()->trap->Charge(ctx, false) * boundary_area;
       if (TrappedC !=0)
         VecSetValue(f, semiconductor_node->global_offset(), TrappedC, ADD_VALUES);
 
       // electron/hole capture rates and contribution to continuity equations
-      PetscScalar TrapElec = semiconductor_region->material()->trap->ElectronTrapRate(false,n,ni,T) * boundary_area;
-      PetscScalar TrapHole = semiconductor_region->material()->trap->HoleTrapRate    (false,p,ni,T) * boundary_area;
+      PetscScalar TrapElec = semiconductor_region->material()->trap->ElectronTrapRate(ctx, false,n,ni,T) * boundary_area;
+      PetscScalar TrapHole = semiconductor_region->material()->trap->HoleTrapRate    (ctx, false,p,ni,T) * boundary_area;
       if (TrapElec != 0)
         VecSetValue(f, semiconductor_node->global_offset()+1, -TrapElec, ADD_VALUES);
       if (TrapHole != 0)
@@ -363,11 +365,11 @@ void InsulatorSemiconductorInterfaceBC::DG_Jacobian(PetscScalar * x, SparseMatri
     //synchronize with material database
     mt->set_ad_num(adtl::AutoDScalar::numdir);
 
-    mt->mapping(semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock);
+    const PMI_Context ctx = mt->mapping(semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock);
 
     {
       // surface recombination
-      AutoDScalar GSurf = - mt->band->R_Surf(p, n, T) * boundary_area;
+      AutoDScalar GSurf = - mt->band->R_Surf(ctx, p, n, T) * boundary_area;
 
       jac->add_row(  index[1],  3,  &index[0],  GSurf.getADValue() );
       jac->add_row(  index[2],  3,  &index[0],  GSurf.getADValue() );
@@ -375,13 +377,13 @@ void InsulatorSemiconductorInterfaceBC::DG_Jacobian(PetscScalar * x, SparseMatri
 
     if (semiconductor_region->get_advanced_model()->Trap)
     {
-      AutoDScalar ni = mt->band->nie(p, n, T);
-      mt->trap->Calculate(false,p,n,ni,T);
-      AutoDScalar TrappedC = mt->trap->ChargeAD(false) * boundary_area;
+      AutoDScalar ni = mt->band->nie(ctx, p, n, T);
+      mt->trap->Calculate(ctx, false,p,n,ni,T);
+      AutoDScalar TrappedC = mt->trap->ChargeAD(ctx, false) * boundary_area;
       jac->add_row(  index[0],  3,  &index[0],  TrappedC.getADValue() );
 
-      AutoDScalar GElec = - mt->trap->ElectronTrapRate(false,n,ni,T) * boundary_area;
-      AutoDScalar GHole = - mt->trap->HoleTrapRate    (false,p,ni,T) * boundary_area;
+      AutoDScalar GElec = - mt->trap->ElectronTrapRate(ctx, false,n,ni,T) * boundary_area;
+      AutoDScalar GHole = - mt->trap->HoleTrapRate    (ctx, false,p,ni,T) * boundary_area;
       jac->add_row(  index[1],  3,  &index[0],  GElec.getADValue() );
       jac->add_row(  index[2],  3,  &index[0],  GHole.getADValue() );
     }
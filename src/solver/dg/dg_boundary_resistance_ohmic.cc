@@ -238,12 +238,12 @@ void IF_Metal_OhmicBC::DG_Function ( PetscScalar * x, Vec f, InsertMode &add_val
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    const PetscScalar nie = semiconductor_region->material()->band->nie ( p, n, T );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T );
+    const PetscScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T );
 
     // here we should calculate current flow into this cell
     const PetscScalar inject_current = this->_current_buffer[i];//pre-computed
@@ -538,12 +538,12 @@ void IF_Metal_OhmicBC::DG_Jacobian ( PetscScalar * x, SparseMatrix<PetscScalar>
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    const PetscScalar nie = semiconductor_region->material()->band->nie ( p.getValue(), n.getValue(), T );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T );
+    const PetscScalar nie = semiconductor_region->material()->band->nie (ctx, p.getValue(), n.getValue(), T );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T );
 
     // d(current)/d(independent variables of bd node and its neighbors)
     const std::vector<PetscInt> & inject_current_col = _buffer_cols[i];
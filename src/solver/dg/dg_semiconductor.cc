@@ -102,7 +102,7 @@ void SemiconductorSimulationRegion::DG_Fill_Value(Vec x, Vec L)
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
 
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, 0.0);
 
     // the first variable, psi
     ix.push_back(fvm_node->global_offset()+0);
@@ -173,10 +173,10 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
   //common used variable
   const PetscScalar T   = T_external();
   const PetscScalar Vt  = kb*T/e;
-  const PetscScalar gn = mt->band->Gamman();
-  const PetscScalar gp = mt->band->Gammap();
-  const PetscScalar bn = hbar*hbar/(6*e*mt->band->EffecElecMass(T));
-  const PetscScalar bp = hbar*hbar/(6*e*mt->band->EffecHoleMass(T));
+  const PetscScalar gn = mt->band->Gamman(PMI_Context());
+  const PetscScalar gp = mt->band->Gammap(PMI_Context());
+  const PetscScalar bn = hbar*hbar/(6*e*mt->band->EffecElecMass(PMI_Context(), T));
+  const PetscScalar bp = hbar*hbar/(6*e*mt->band->EffecHoleMass(PMI_Context(), T));
   const PetscScalar QNFactor = get_advanced_model()->QNFactor;
   const PetscScalar QPFactor = get_advanced_model()->QPFactor;
   const PetscScalar minconc  = get_advanced_model()->QMinConcentration;
@@ -298,10 +298,10 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
         // stupid code... we can not dot point with VectorValue<PetscScalar> yet.
         VectorValue<PetscScalar> norm(_norm(0), _norm(1), _norm(2));
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         PetscScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         PetscScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -389,7 +389,7 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
       {
 
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         PetscScalar V1   =  x[n1_local_offset+0];                  // electrostatic potential
         PetscScalar n1   =  x[n1_local_offset+1];                  // electron density
@@ -401,26 +401,26 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
         // takes care of the change effective DOS.
         // Ec/Ev should not be used except when its difference between two nodes.
         // The same comment applies to Ec2/Ev2.
-        PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(p1, n1, T) + kb*T*log(n1_data->Nc()));
-        PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(p1, n1, T) - kb*T*log(n1_data->Nv()) + mt->band->Eg(T));
+        PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(ctx1, p1, n1, T) + kb*T*log(n1_data->Nc()));
+        PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(ctx1, p1, n1, T) - kb*T*log(n1_data->Nv()) + mt->band->Eg(ctx1, T));
         PetscScalar qc1  = 0.0;
         PetscScalar qv1  = 0.0;
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         PetscScalar V2   =  x[n2_local_offset+0];                   // electrostatic potential
         PetscScalar n2   =  x[n2_local_offset+1];                   // electron density
         PetscScalar p2   =  x[n2_local_offset+2];                   // hole density
 
 
-        PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(p2, n2, T) + kb*T*log(n2_data->Nc()));
-        PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(p2, n2, T) - kb*T*log(n2_data->Nv()) + mt->band->Eg(T));
+        PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(ctx2, p2, n2, T) + kb*T*log(n2_data->Nc()));
+        PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(ctx2, p2, n2, T) - kb*T*log(n2_data->Nv()) + mt->band->Eg(ctx2, T));
         PetscScalar qc2  = 0.0;
         PetscScalar qv2  = 0.0;
 
-        PetscScalar effn = (n1_data->n()+n2_data->n())/(n1_data->n()+n2_data->n() + mt->band->ni(T));
-        PetscScalar effp = (n1_data->p()+n2_data->p())/(n1_data->p()+n2_data->p() + mt->band->ni(T));
+        PetscScalar effn = (n1_data->n()+n2_data->n())/(n1_data->n()+n2_data->n() + mt->band->ni(ctx2, T));
+        PetscScalar effp = (n1_data->p()+n2_data->p())/(n1_data->p()+n2_data->p() + mt->band->ni(ctx2, T));
 
         if(get_advanced_model()->QNEnabled)
         {
@@ -463,34 +463,28 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
               Et = (E - dir*(E*dir)).size();
             }
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Ep, Et, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Ep, Et, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Ep, Et, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Ep, Et, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Ep, Et, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Ep, Et, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Ep, Et, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Ep, Et, T);
           }
           else // ModelSpecify::EJ || ModelSpecify::EQF
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Etn, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Etp, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Etn, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Etp, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Etn, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Etp, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Etn, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Etp, T);
           }
         }
         else
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T, 0, 0, T);
-          mup1 = mt->mob->HoleMob(p1, n1, T, 0, 0, T);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, 0, 0, T);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, 0, 0, T);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T, 0, 0, T);
-          mup2 = mt->mob->HoleMob(p2, n2, T, 0, 0, T);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, 0, 0, T);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, 0, 0, T);
         }
 
 
@@ -565,8 +559,8 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
 
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
-          PetscScalar GBTBT1 = mt->band->BB_Tunneling(T, E.size());
-          PetscScalar GBTBT2 = mt->band->BB_Tunneling(T, E.size());
+          PetscScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T, E.size());
+          PetscScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T, E.size());
 
           if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
           {
@@ -606,20 +600,20 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
             case ModelSpecify::IIForce_EdotJ:
               Epn = std::max(E.dot(Jnv.unit(true)), 0.0);
               Epp = std::max(E.dot(Jpv.unit(true)), 0.0);
-              IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-              IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
               break;
             case ModelSpecify::EVector:
-              IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
               break;
             case ModelSpecify::ESide:
-              IIn = mt->gen->ElecGenRate(T,fabs(Ec2-Ec1)/e/length,Eg);
-              IIp = mt->gen->HoleGenRate(T,fabs(Ev2-Ev1)/e/length,Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,fabs(Ec2-Ec1)/e/length,Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,fabs(Ev2-Ev1)/e/length,Eg);
               break;
             case ModelSpecify::GradQf:
-              IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
               break;
             default:
             {
@@ -686,8 +680,8 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
     PetscScalar n   =  x[local_offset+1];                       // electron density
     PetscScalar p   =  x[local_offset+2];                       // hole density
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
-    PetscScalar R   = mt->band->Recomb(p, n, T)*fvm_node->volume();         // the recombination term
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
+    PetscScalar R   = mt->band->Recomb(ctx, p, n, T)*fvm_node->volume();         // the recombination term
     PetscScalar rho = e*(node_data->Net_doping() + p - n)*fvm_node->volume(); // the charge density
 
     // consider carrier generation
@@ -721,11 +715,11 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
       // consider charge trapping in semiconductor bulk (bulk_flag=true)
 
       // call the Trap MPI to calculate trap occupancy using the local carrier densities and lattice temperature
-      PetscScalar ni = mt->band->nie(p, n, T);
-      mt->trap->Calculate(true,p,n,ni,T);
+      PetscScalar ni = mt->band->nie(ctx, p, n, T);
+      mt->trap->Calculate(ctx, true,p,n,ni,T);
 
       // calculate the contribution of trapped charge to Poisson's equation
-      PetscScalar TrappedC = mt->trap->Charge(true) * fvm_node->volume();
+      PetscScalar TrappedC = mt->trap->Charge(ctx, true) * fvm_node->volume();
       if (TrappedC !=0)
       {
         iy.push_back(fvm_node->global_offset());
@@ -733,8 +727,8 @@ void SemiconductorSimulationRegion::DG_Function(PetscScalar * x, Vec f, InsertMo
       }
 
       // calculate the rates of electron and hole capture
-      PetscScalar TrapElec = mt->trap->ElectronTrapRate(true,n,ni,T) * fvm_node->volume();
-      PetscScalar TrapHole = mt->trap->HoleTrapRate    (true,p,ni,T) * fvm_node->volume();
+      PetscScalar TrapElec = mt->trap->ElectronTrapRate(ctx, true,n,ni,T) * fvm_node->volume();
+      PetscScalar TrapHole = mt->trap->HoleTrapRate    (ctx, true,p,ni,T) * fvm_node->volume();
       // contribution to the contribution to continuity equations
       if (TrapElec != 0)
       {
@@ -778,10 +772,10 @@ void SemiconductorSimulationRegion::DG_Jacobian(PetscScalar * x, SparseMatrix<Pe
   //common used variable
   const PetscScalar T   = T_external();
   const PetscScalar Vt  = kb*T/e;
-  const PetscScalar gn = mt->band->Gamman();
-  const PetscScalar gp = mt->band->Gammap();
-  const PetscScalar bn = hbar*hbar/(6*e*mt->band->EffecElecMass(T));
-  const PetscScalar bp = hbar*hbar/(6*e*mt->band->EffecHoleMass(T));
+  const PetscScalar gn = mt->band->Gamman(PMI_Context());
+  const PetscScalar gp = mt->band->Gammap(PMI_Context());
+  const PetscScalar bn = hbar*hbar/(6*e*mt->band->EffecElecMass(PMI_Context(), T));
+  const PetscScalar bp = hbar*hbar/(6*e*mt->band->EffecHoleMass(PMI_Context(), T));
   const PetscScalar QNFactor = get_advanced_model()->QNFactor;
   const PetscScalar QPFactor = get_advanced_model()->QPFactor;
   const PetscScalar minconc  = get_advanced_model()->QMinConcentration;
@@ -939,10 +933,10 @@ void SemiconductorSimulationRegion::DG_Jacobian(PetscScalar * x, SparseMatrix<Pe
         VectorValue<AutoDScalar> norm(_norm(0), _norm(1), _norm(2));
 
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         AutoDScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         AutoDScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -1036,33 +1030,33 @@ void SemiconductorSimulationRegion::DG_Jacobian(PetscScalar * x, SparseMatrix<Pe
       {
 
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         AutoDScalar V1   =  x[n1_local_offset+0];       V1.setADValue(n_variables*edge_nodes.first+0, 1.0);           // electrostatic potential
         AutoDScalar n1   =  x[n1_local_offset+1];       n1.setADValue(n_variables*edge_nodes.first+1, 1.0);           // electron density
         AutoDScalar p1   =  x[n1_local_offset+2];       p1.setADValue(n_variables*edge_nodes.first+2, 1.0);           // hole density
 
-        AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(p1, n1, T) + kb*T*log(n1_data->Nc()));
-        AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(p1, n1, T) - kb*T*log(n1_data->Nv()) + mt->band->Eg(T));
+        AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(ctx1, p1, n1, T) + kb*T*log(n1_data->Nc()));
+        AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(ctx1, p1, n1, T) - kb*T*log(n1_data->Nv()) + mt->band->Eg(ctx1, T));
 
         AutoDScalar qc1  = 0.0;
         AutoDScalar qv1  = 0.0;
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         AutoDScalar V2   =  x[n2_local_offset+0];       V2.setADValue(n_variables*edge_nodes.second+0, 1.0);             // electrostatic potential
         AutoDScalar n2   =  x[n2_local_offset+1];       n2.setADValue(n_variables*edge_nodes.second+1, 1.0);             // electron density
         AutoDScalar p2   =  x[n2_local_offset+2];       p2.setADValue(n_variables*edge_nodes.second+2, 1.0);             // hole density
 
-        AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(p2, n2, T) + kb*T*log(n2_data->Nc()));
-        AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(p2, n2, T) - kb*T*log(n2_data->Nv()) + mt->band->Eg(T));
+        AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(ctx2, p2, n2, T) + kb*T*log(n2_data->Nc()));
+        AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(ctx2, p2, n2, T) - kb*T*log(n2_data->Nv()) + mt->band->Eg(ctx2, T));
 
         AutoDScalar qc2  = 0.0;
         AutoDScalar qv2  = 0.0;
 
-        PetscScalar effn = (n1_data->n()+n2_data->n())/(n1_data->n()+n2_data->n() + mt->band->ni(T));
-        PetscScalar effp = (n1_data->p()+n2_data->p())/(n1_data->p()+n2_data->p() + mt->band->ni(T));
+        PetscScalar effn = (n1_data->n()+n2_data->n())/(n1_data->n()+n2_data->n() + mt->band->ni(ctx2, T));
+        PetscScalar effp = (n1_data->p()+n2_data->p())/(n1_data->p()+n2_data->p() + mt->band->ni(ctx2, T));
 
         if(get_advanced_model()->QNEnabled)
         {
@@ -1103,34 +1097,28 @@ void SemiconductorSimulationRegion::DG_Jacobian(PetscScalar * x, SparseMatrix<Pe
             if(mos_channel_elem)
               Et = (E - (E*dir)*dir).size();
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Ep, Et, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Ep, Et, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Ep, Et, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Ep, Et, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Ep, Et, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Ep, Et, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Ep, Et, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Ep, Et, T);
           }
           else // ModelSpecify::EJ || ModelSpecify::EQF
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Etn, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Etp, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Etn, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Etp, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Etn, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Etp, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Etn, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Etp, T);
           }
         }
         else
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T, 0, 0, T);
-          mup1 = mt->mob->HoleMob(p1, n1, T, 0, 0, T);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, 0, 0, T);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, 0, 0, T);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T, 0, 0, T);
-          mup2 = mt->mob->HoleMob(p2, n2, T, 0, 0, T);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, 0, 0, T);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, 0, 0, T);
         }
 
         AutoDScalar mun = 0.5*(mun1+mun2);  // the electron mobility at the mid point of the edge, use linear interpolation
@@ -1196,8 +1184,8 @@ void SemiconductorSimulationRegion::DG_Jacobian(PetscScalar * x, SparseMatrix<Pe
 
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
-          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(T, E.size());
-          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(T, E.size());
+          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T, E.size());
+          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T, E.size());
 
           if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
           {
@@ -1237,20 +1225,20 @@ void SemiconductorSimulationRegion::DG_Jacobian(PetscScalar * x, SparseMatrix<Pe
           case ModelSpecify::IIForce_EdotJ:
             Epn = adtl::fmax(E.dot(Jnv.unit(true)), 0.0);
             Epp = adtl::fmax(E.dot(Jpv.unit(true)), 0.0);
-            IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-            IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
             break;
           case ModelSpecify::EVector:
-            IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
             break;
           case ModelSpecify::ESide:
-            IIn = mt->gen->ElecGenRate(T,fabs(Ec2-Ec1)/e/length,Eg);
-            IIp = mt->gen->HoleGenRate(T,fabs(Ev2-Ev1)/e/length,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,fabs(Ec2-Ec1)/e/length,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,fabs(Ev2-Ev1)/e/length,Eg);
             break;
           case ModelSpecify::GradQf:
-            IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
             break;
           default:
             {
@@ -1314,8 +1302,8 @@ void SemiconductorSimulationRegion::DG_Jacobian(PetscScalar * x, SparseMatrix<Pe
     AutoDScalar n   =  x[local_offset+1];   n.setADValue(1, 1.0);              // electron density
     AutoDScalar p   =  x[local_offset+2];   p.setADValue(2, 1.0);              // hole density
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);                   // map this node and its data to material database
-    AutoDScalar R   = -mt->band->Recomb(p, n, T)*fvm_node->volume();                       // the recombination term
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);                   // map this node and its data to material database
+    AutoDScalar R   = -mt->band->Recomb(ctx, p, n, T)*fvm_node->volume();                       // the recombination term
     AutoDScalar rho = e*(node_data->Net_doping() + p - n)*fvm_node->volume();              // the charge density
 
     // ADD to Jacobian matrix,
@@ -1340,14 +1328,14 @@ void SemiconductorSimulationRegion::DG_Jacobian(PetscScalar * x, SparseMatrix<Pe
 
     if (get_advanced_model()->Trap)
     {
-      AutoDScalar ni = mt->band->nie(p, n, T);
-      mt->trap->Calculate(true,p,n,ni,T);
+      AutoDScalar ni = mt->band->nie(ctx, p, n, T);
+      mt->trap->Calculate(ctx, true,p,n,ni,T);
 
-      AutoDScalar TrappedC = mt->trap->ChargeAD(true) * fvm_node->volume();
+      AutoDScalar TrappedC = mt->trap->ChargeAD(ctx, true) * fvm_node->volume();
       jac->add_row(  index[0],  n_variables,  &index[0],  TrappedC.getADValue() );
 
-      AutoDScalar GElec = - mt->trap->ElectronTrapRate(true,n,ni,T) * fvm_node->volume();
-      AutoDScalar GHole = - mt->trap->HoleTrapRate    (true,p,ni,T) * fvm_node->volume();
+      AutoDScalar GElec = - mt->trap->ElectronTrapRate(ctx, true,n,ni,T) * fvm_node->volume();
+      AutoDScalar GHole = - mt->trap->HoleTrapRate    (ctx, true,p,ni,T) * fvm_node->volume();
 
       jac->add_row(  index[1],  n_variables,  &index[0],  GElec.getADValue() );
       jac->add_row(  index[2],  n_variables,  &index[0],  GHole.getADValue() );
@@ -1516,7 +1504,7 @@ void SemiconductorSimulationRegion::DG_Update_Solution(PetscScalar *lxx)
     PetscScalar p          = lxx[fvm_node->local_offset()+2];
 
     FVM_NodeData * node_data = fvm_node->node_data();  genius_assert(node_data!=NULL);
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     //update psi
     node_data->psi_old()  =  node_data->psi_last();
@@ -1533,9 +1521,9 @@ void SemiconductorSimulationRegion::DG_Update_Solution(PetscScalar *lxx)
     node_data->p_last()   = node_data->p();
     node_data->p()        =  p;
 
-    node_data->Eg() = mt->band->Eg(T) - mt->band->EgNarrow(p, n, T);
-    node_data->Ec() = -(e*V + node_data->affinity() + mt->band->EgNarrowToEc(p, n, T));
-    node_data->Ev() = -(e*V + node_data->affinity() + mt->band->Eg(T) - mt->band->EgNarrowToEv(p, n, T) );
+    node_data->Eg() = mt->band->Eg(ctx, T) - mt->band->EgNarrow(ctx, p, n, T);
+    node_data->Ec() = -(e*V + node_data->affinity() + mt->band->EgNarrowToEc(ctx, p, n, T));
+    node_data->Ev() = -(e*V + node_data->affinity() + mt->band->Eg(ctx, T) - mt->band->EgNarrowToEv(ctx, p, n, T) );
 
     //Eqc?
     if(qn_offset != invalid_uint)
@@ -1552,25 +1540,24 @@ void SemiconductorSimulationRegion::DG_Update_Solution(PetscScalar *lxx)
     if(get_advanced_model()->Fermi)
     {
       node_data->qFn() = -(e*V + node_data->affinity()) + inv_fermi_half(fabs(n/node_data->Nc()))*kb*T;
-      node_data->qFp() = -(e*V + node_data->affinity() + mt->band->Eg(T)) - inv_fermi_half(fabs(p/node_data->Nv()))*kb*T;
+      node_data->qFp() = -(e*V + node_data->affinity() + mt->band->Eg(ctx, T)) - inv_fermi_half(fabs(p/node_data->Nv()))*kb*T;
     }
     else
     {
       node_data->qFn() = -(e*V + node_data->affinity()) + log(fabs(n/node_data->Nc()))*kb*T;
-      node_data->qFp() = -(e*V + node_data->affinity() + mt->band->Eg(T)) - log(fabs(p/node_data->Nv()))*kb*T;
+      node_data->qFp() = -(e*V + node_data->affinity() + mt->band->Eg(ctx, T)) - log(fabs(p/node_data->Nv()))*kb*T;
     }
 
-    node_data->Recomb() = mt->band->Recomb(p, n, T);
-    node_data->Recomb_Dir() = mt->band->R_Direct(p, n, T);
-    node_data->Recomb_SRH() = mt->band->R_SHR(p, n, T);
-    node_data->Recomb_Auger() = mt->band->R_Auger(p, n, T);
+    node_data->Recomb() = mt->band->Recomb(ctx, p, n, T);
+    node_data->Recomb_Dir() = mt->band->R_Direct(ctx, p, n, T);
+    node_data->Recomb_SRH() = mt->band->R_SHR(ctx, p, n, T);
+    node_data->Recomb_Auger() = mt->band->R_Auger(ctx, p, n, T);
 
     if (get_advanced_model()->Trap)
     {
       // update traps
-      mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
-      mt->trap->Update(true, p, n, node_data->ni(), T_external());
-      mt->trap->Update(false, p, n, node_data->ni(), T_external());
+      mt->trap->Update(ctx, true, p, n, node_data->ni(), T_external());
+      mt->trap->Update(ctx, false, p, n, node_data->ni(), T_external());
     }
   }
 
@@ -201,6 +201,7 @@ void HeteroInterfaceBC::EBM3_Function ( PetscScalar * x, Vec f, InsertMode &add_
     PetscScalar Tn0;
     PetscScalar Tp0;
     Material::MaterialSemiconductor * mt0;
+    PMI_Context ctx0;
     PetscScalar Ec0,Ev0;
 
     // search all the fvm_node which has *node_it as root node, these nodes are the same in geometry,
@@ -250,10 +251,10 @@ void HeteroInterfaceBC::EBM3_Function ( PetscScalar * x, Vec f, InsertMode &add_
           Tp0 = T0;
 
         mt0 = semi_region->material();
-        mt0->mapping ( fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock );
+        ctx0 = mt0->mapping ( fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock );
 
-        Ec0 =  - ( e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc ( p0, n0, T0 ) + kb*T0*log ( n0_data->Nc() ) );
-        Ev0 =  - ( e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv ( p0, n0, T0 ) - kb*T0*log ( n0_data->Nv() ) + mt0->band->Eg ( T0 ) );
+        Ec0 =  - ( e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc (ctx0, p0, n0, T0 ) + kb*T0*log ( n0_data->Nc() ) );
+        Ev0 =  - ( e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv (ctx0, p0, n0, T0 ) - kb*T0*log ( n0_data->Nv() ) + mt0->band->Eg (ctx0, T0 ) );
         if ( semi_region->get_advanced_model()->Fermi )
         {
           Ec0 = Ec0 - kb*T0*log ( gamma_f ( fabs ( n0 ) /n0_data->Nc() ) );
@@ -297,9 +298,9 @@ void HeteroInterfaceBC::EBM3_Function ( PetscScalar * x, Vec f, InsertMode &add_
 
               // mapping this node to material library
               Material::MaterialSemiconductor *mt = semi_region->material();
-              mt->mapping ( fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock );
-              PetscScalar Ec =  - ( e*V + n_data->affinity() + mt->band->EgNarrowToEc ( p, n, T ) + kb*T*log ( n_data->Nc() ) );
-              PetscScalar Ev =  - ( e*V + n_data->affinity() - mt->band->EgNarrowToEv ( p, n, T ) - kb*T*log ( n_data->Nv() ) + mt->band->Eg ( T ) );
+              const PMI_Context ctx = mt->mapping ( fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock );
+              PetscScalar Ec =  - ( e*V + n_data->affinity() + mt->band->EgNarrowToEc (ctx, p, n, T ) + kb*T*log ( n_data->Nc() ) );
+              PetscScalar Ev =  - ( e*V + n_data->affinity() - mt->band->EgNarrowToEv (ctx, p, n, T ) - kb*T*log ( n_data->Nv() ) + mt->band->Eg (ctx, T ) );
               if ( semi_region->get_advanced_model()->Fermi )
               {
                 Ec = Ec - kb*T*log ( gamma_f ( fabs ( n ) /n_data->Nc() ) );
@@ -320,13 +321,13 @@ void HeteroInterfaceBC::EBM3_Function ( PetscScalar * x, Vec f, InsertMode &add_
               if ( Ec0 > Ec )
               {
                 // electrons are leaving region 0
-                PetscScalar pm = mt0->band->EffecElecMass ( T ) /mt->band->EffecElecMass ( T );
-                PetscScalar Jn = 2*( mt0->band->ThermalVn ( T ) *n0 - pm*mt->band->ThermalVn ( T ) *n*exp ( - ( Ec0-Ec ) / ( kb*T ) ) ) *cv_boundary;
+                PetscScalar pm = mt0->band->EffecElecMass (ctx0, T ) /mt->band->EffecElecMass (ctx, T );
+                PetscScalar Jn = 2*( mt0->band->ThermalVn (ctx0, T ) *n0 - pm*mt->band->ThermalVn (ctx, T ) *n*exp ( - ( Ec0-Ec ) / ( kb*T ) ) ) *cv_boundary;
                 VecSetValue ( f, fvm_nodes[i]->global_offset() +node_n_offset,  Jn, ADD_VALUES );
                 VecSetValue ( f, fvm_nodes[0]->global_offset() +node_n_offset, -Jn, ADD_VALUES );
 
                 // electron energy flux
-                PetscScalar Sn = -2*e* ( mt0->band->ThermalVn ( T ) *n0*2.5*kb*Tn0 - pm*mt->band->ThermalVn ( T ) *n*exp ( - ( Ec0-Ec ) / ( kb*T ) ) *2.5*kb*Tn ) *cv_boundary;
+                PetscScalar Sn = -2*e* ( mt0->band->ThermalVn (ctx0, T ) *n0*2.5*kb*Tn0 - pm*mt->band->ThermalVn (ctx, T ) *n*exp ( - ( Ec0-Ec ) / ( kb*T ) ) *2.5*kb*Tn ) *cv_boundary;
                 if ( regions[i]->get_advanced_model()->enable_Tn() )
                   VecSetValue ( f, fvm_nodes[i]->global_offset() +node_Tn_offset,  -Sn, ADD_VALUES );
                 if ( regions[0]->get_advanced_model()->enable_Tn() )
@@ -335,13 +336,13 @@ void HeteroInterfaceBC::EBM3_Function ( PetscScalar * x, Vec f, InsertMode &add_
               else
               {
                 // electrons are leaving this region
-                PetscScalar pm = mt->band->EffecElecMass ( T ) /mt0->band->EffecElecMass ( T );
-                PetscScalar Jn = 2*( mt->band->ThermalVn ( T ) *n - pm*mt0->band->ThermalVn ( T ) *n0*exp ( - ( Ec-Ec0 ) / ( kb*T ) ) ) *cv_boundary;
+                PetscScalar pm = mt->band->EffecElecMass (ctx, T ) /mt0->band->EffecElecMass (ctx0, T );
+                PetscScalar Jn = 2*( mt->band->ThermalVn (ctx, T ) *n - pm*mt0->band->ThermalVn (ctx0, T ) *n0*exp ( - ( Ec-Ec0 ) / ( kb*T ) ) ) *cv_boundary;
                 VecSetValue ( f, fvm_nodes[i]->global_offset() +node_n_offset, -Jn, ADD_VALUES );
                 VecSetValue ( f, fvm_nodes[0]->global_offset() +node_n_offset,  Jn, ADD_VALUES );
 
                 // electron energy flux
-                PetscScalar Sn = -2*e* ( mt->band->ThermalVn ( T ) *n*2.5*kb*Tn - pm*mt0->band->ThermalVn ( T ) *n0*exp ( - ( Ec-Ec0 ) / ( kb*T ) ) *2.5*kb*Tn0 ) *cv_boundary;
+                PetscScalar Sn = -2*e* ( mt->band->ThermalVn (ctx, T ) *n*2.5*kb*Tn - pm*mt0->band->ThermalVn (ctx0, T ) *n0*exp ( - ( Ec-Ec0 ) / ( kb*T ) ) *2.5*kb*Tn0 ) *cv_boundary;
                 if ( regions[i]->get_advanced_model()->enable_Tn() )
                   VecSetValue ( f, fvm_nodes[i]->global_offset() +node_Tn_offset,  Sn, ADD_VALUES );
                 if ( regions[0]->get_advanced_model()->enable_Tn() )
@@ -351,13 +352,13 @@ void HeteroInterfaceBC::EBM3_Function ( PetscScalar * x, Vec f, InsertMode &add_
               if ( Ev0 < Ev )
               {
                 // holes are leaving region 0
-                PetscScalar pm = mt0->band->EffecHoleMass ( T ) /mt->band->EffecHoleMass ( T );
-                PetscScalar Jp = 2*( mt0->band->ThermalVp ( T ) *p0 - pm*mt->band->ThermalVp ( T ) *p*exp ( ( Ev0-Ev ) / ( kb*T ) ) ) *cv_boundary;
+                PetscScalar pm = mt0->band->EffecHoleMass (ctx0, T ) /mt->band->EffecHoleMass (ctx, T );
+                PetscScalar Jp = 2*( mt0->band->ThermalVp (ctx0, T ) *p0 - pm*mt->band->ThermalVp (ctx, T ) *p*exp ( ( Ev0-Ev ) / ( kb*T ) ) ) *cv_boundary;
                 VecSetValue ( f, fvm_nodes[i]->global_offset() +node_p_offset,  Jp, ADD_VALUES );
                 VecSetValue ( f, fvm_nodes[0]->global_offset() +node_p_offset, -Jp, ADD_VALUES );
 
                 // electron energy flux
-                PetscScalar Sp =  2*e* ( mt0->band->ThermalVp ( T ) *p0*2.5*kb*Tp0 - pm*mt->band->ThermalVp ( T ) *p*exp ( ( Ev0-Ev ) / ( kb*T ) ) *2.5*kb*Tp ) *cv_boundary;
+                PetscScalar Sp =  2*e* ( mt0->band->ThermalVp (ctx0, T ) *p0*2.5*kb*Tp0 - pm*mt->band->ThermalVp (ctx, T ) *p*exp ( ( Ev0-Ev ) / ( kb*T ) ) *2.5*kb*Tp ) *cv_boundary;
                 if ( regions[i]->get_advanced_model()->enable_Tp() )
                   VecSetValue ( f, fvm_nodes[i]->global_offset() +node_Tp_offset,  -Sp, ADD_VALUES );
                 if ( regions[0]->get_advanced_model()->enable_Tp() )
@@ -366,13 +367,13 @@ void HeteroInterfaceBC::EBM3_Function ( PetscScalar * x, Vec f, InsertMode &add_
               else
               {
                 // holes are leaving this region
-                PetscScalar pm = mt->band->EffecHoleMass ( T ) /mt0->band->EffecHoleMass ( T );
-                PetscScalar Jp = 2*( mt->band->ThermalVp ( T ) *p - pm*mt0->band->ThermalVp ( T ) *p0*exp ( ( Ev-Ev0 ) / ( kb*T ) ) ) *cv_boundary;
+                PetscScalar pm = mt->band->EffecHoleMass (ctx, T ) /mt0->band->EffecHoleMass (ctx0, T );
+                PetscScalar Jp = 2*( mt->band->ThermalVp (ctx, T ) *p - pm*mt0->band->ThermalVp (ctx0, T ) *p0*exp ( ( Ev-Ev0 ) / ( kb*T ) ) ) *cv_boundary;
                 VecSetValue ( f, fvm_nodes[i]->global_offset() +node_p_offset,  -Jp, ADD_VALUES );
                 VecSetValue ( f, fvm_nodes[0]->global_offset() +node_p_offset,   Jp, ADD_VALUES );
 
                 // electron energy flux
-                PetscScalar Sp =  2*e* ( mt->band->ThermalVp ( T ) *p*2.5*kb*Tp - pm*mt0->band->ThermalVp ( T ) *p0*exp ( ( Ev-Ev0 ) / ( kb*T ) ) *2.5*kb*Tp0 ) *cv_boundary;
+                PetscScalar Sp =  2*e* ( mt->band->ThermalVp (ctx, T ) *p*2.5*kb*Tp - pm*mt0->band->ThermalVp (ctx0, T ) *p0*exp ( ( Ev-Ev0 ) / ( kb*T ) ) *2.5*kb*Tp0 ) *cv_boundary;
                 if ( regions[i]->get_advanced_model()->enable_Tp() )
                   VecSetValue ( f, fvm_nodes[i]->global_offset() +node_Tp_offset,  Sp, ADD_VALUES );
                 if ( regions[0]->get_advanced_model()->enable_Tp() )
@@ -598,6 +599,7 @@ void HeteroInterfaceBC::EBM3_Jacobian ( PetscScalar * x, SparseMatrix<PetscScala
     AutoDScalar Tn0;
     AutoDScalar Tp0;
     Material::MaterialSemiconductor * mt0;
+    PMI_Context ctx0;
     AutoDScalar Ec0,Ev0;
 
     // search all the fvm_node which has *node_it as root node, these nodes are the same in geometry,
@@ -663,10 +665,10 @@ void HeteroInterfaceBC::EBM3_Jacobian ( PetscScalar * x, SparseMatrix<PetscScala
 
         mt0 = semi_region->material();
         mt0->set_ad_num(adtl::AutoDScalar::numdir);
-        mt0->mapping ( fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock );
+        ctx0 = mt0->mapping ( fvm_nodes[i]->root_node(), n0_data, SolverSpecify::clock );
 
-        Ec0 =  - ( e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc ( p0, n0, T0 ) + kb*T0*log ( n0_data->Nc() ) );
-        Ev0 =  - ( e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv ( p0, n0, T0 ) - kb*T0*log ( n0_data->Nv() ) + mt0->band->Eg ( T0 ) );
+        Ec0 =  - ( e*V0 + n0_data->affinity() + mt0->band->EgNarrowToEc (ctx0, p0, n0, T0 ) + kb*T0*log ( n0_data->Nc() ) );
+        Ev0 =  - ( e*V0 + n0_data->affinity() - mt0->band->EgNarrowToEv (ctx0, p0, n0, T0 ) - kb*T0*log ( n0_data->Nv() ) + mt0->band->Eg (ctx0, T0 ) );
         if ( semi_region->get_advanced_model()->Fermi )
         {
           Ec0 = Ec0 - kb*T0*log ( gamma_f ( fabs ( n0 ) /n0_data->Nc() ) );
@@ -738,9 +740,9 @@ void HeteroInterfaceBC::EBM3_Jacobian ( PetscScalar * x, SparseMatrix<PetscScala
               // mapping this node to material library
               Material::MaterialSemiconductor *mt = semi_region->material();
               mt->set_ad_num(adtl::AutoDScalar::numdir);
-              mt->mapping ( fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock );
-              AutoDScalar Ec =  - ( e*V + n_data->affinity() + mt->band->EgNarrowToEc ( p, n, T ) + kb*T*log ( n_data->Nc() ) );
-              AutoDScalar Ev =  - ( e*V + n_data->affinity() - mt->band->EgNarrowToEv ( p, n, T ) - kb*T*log ( n_data->Nv() ) + mt->band->Eg ( T ) );
+              const PMI_Context ctx = mt->mapping ( fvm_nodes[i]->root_node(), n_data, SolverSpecify::clock );
+              AutoDScalar Ec =  - ( e*V + n_data->affinity() + mt->band->EgNarrowToEc (ctx, p, n, T ) + kb*T*log ( n_data->Nc() ) );
+              AutoDScalar Ev =  - ( e*V + n_data->affinity() - mt->band->EgNarrowToEv (ctx, p, n, T ) - kb*T*log ( n_data->Nv() ) + mt->band->Eg (ctx, T ) );
               if ( semi_region->get_advanced_model()->Fermi )
               {
                 Ec = Ec - kb*T*log ( gamma_f ( fabs ( n ) /n_data->Nc() ) );
@@ -765,12 +767,12 @@ void HeteroInterfaceBC::EBM3_Jacobian ( PetscScalar * x, SparseMatrix<PetscScala
               if ( Ec0 > Ec )
               {
                 // electrons are leaving region 0
-                AutoDScalar pm = mt0->band->EffecElecMass ( T ) /mt->band->EffecElecMass ( T );
-                AutoDScalar Jn = 2*( mt0->band->ThermalVn ( T ) *n0 - pm*mt->band->ThermalVn ( T ) *n*exp ( - ( Ec0-Ec ) / ( kb*T ) ) ) *cv_boundary;
+                AutoDScalar pm = mt0->band->EffecElecMass (ctx0, T ) /mt->band->EffecElecMass (ctx, T );
+                AutoDScalar Jn = 2*( mt0->band->ThermalVn (ctx0, T ) *n0 - pm*mt->band->ThermalVn (ctx, T ) *n*exp ( - ( Ec0-Ec ) / ( kb*T ) ) ) *cv_boundary;
                   jac->add_row(  rows[n_node_var_0+node_n_offset],  cols.size(),  &cols[0],  Jn.getADValue() );
                   jac->add_row(  rows[node_n_offset],  cols.size(),  &cols[0],  (-Jn).getADValue() );
 
-                AutoDScalar Sn = -2*e* ( mt0->band->ThermalVn ( T ) *n0*2.5*kb*Tn0 - pm*mt->band->ThermalVn ( T ) *n*exp ( - ( Ec0-Ec ) / ( kb*T ) ) *2.5*kb*Tn ) *cv_boundary;
+                AutoDScalar Sn = -2*e* ( mt0->band->ThermalVn (ctx0, T ) *n0*2.5*kb*Tn0 - pm*mt->band->ThermalVn (ctx, T ) *n*exp ( - ( Ec0-Ec ) / ( kb*T ) ) *2.5*kb*Tn ) *cv_boundary;
                 // electron energy flux
                 if ( regions[i]->get_advanced_model()->enable_Tn() )
                     jac->add_row(  rows[n_node_var_0+node_Tn_offset],  cols.size(),  &cols[0],  ( -Sn ).getADValue() );
@@ -780,12 +782,12 @@ void HeteroInterfaceBC::EBM3_Jacobian ( PetscScalar * x, SparseMatrix<PetscScala
               else
               {
                 // electrons are leaving this region
-                AutoDScalar pm = mt->band->EffecElecMass ( T ) /mt0->band->EffecElecMass ( T );
-                AutoDScalar Jn = 2*( mt->band->ThermalVn ( T ) *n - pm*mt0->band->ThermalVn ( T ) *n0*exp ( - ( Ec-Ec0 ) / ( kb*T ) ) ) *cv_boundary;
+                AutoDScalar pm = mt->band->EffecElecMass (ctx, T ) /mt0->band->EffecElecMass (ctx0, T );
+                AutoDScalar Jn = 2*( mt->band->ThermalVn (ctx, T ) *n - pm*mt0->band->ThermalVn (ctx0, T ) *n0*exp ( - ( Ec-Ec0 ) / ( kb*T ) ) ) *cv_boundary;
                   jac->add_row(  rows[n_node_var_0+node_n_offset],  cols.size(),  &cols[0],  (-Jn).getADValue() );
                   jac->add_row(  rows[node_n_offset],  cols.size(),  &cols[0],  Jn.getADValue() );
 
-                AutoDScalar Sn = -2*e* ( mt->band->ThermalVn ( T ) *n*2.5*kb*Tn - pm*mt0->band->ThermalVn ( T ) *n0*exp ( - ( Ec-Ec0 ) / ( kb*T ) ) *2.5*kb*Tn0 ) *cv_boundary;
+                AutoDScalar Sn = -2*e* ( mt->band->ThermalVn (ctx, T ) *n*2.5*kb*Tn - pm*mt0->band->ThermalVn (ctx0, T ) *n0*exp ( - ( Ec-Ec0 ) / ( kb*T ) ) *2.5*kb*Tn0 ) *cv_boundary;
                 // electron energy flux
                 if ( regions[i]->get_advanced_model()->enable_Tn() )
                     jac->add_row(  rows[n_node_var_0+node_Tn_offset],  cols.size(),  &cols[0],  Sn.getADValue() );
@@ -798,13 +800,13 @@ void HeteroInterfaceBC::EBM3_Jacobian ( PetscScalar * x, SparseMatrix<PetscScala
               if ( Ev0 < Ev )
               {
                 // holes are leaving region 0
-                AutoDScalar pm = mt0->band->EffecHoleMass ( T ) /mt->band->EffecHoleMass ( T );
-                AutoDScalar Jp = 2*( mt0->band->ThermalVp ( T ) *p0 - pm*mt->band->ThermalVp ( T ) *p*exp ( ( Ev0-Ev ) / ( kb*T ) ) )*cv_boundary;
+                AutoDScalar pm = mt0->band->EffecHoleMass (ctx0, T ) /mt->band->EffecHoleMass (ctx, T );
+                AutoDScalar Jp = 2*( mt0->band->ThermalVp (ctx0, T ) *p0 - pm*mt->band->ThermalVp (ctx, T ) *p*exp ( ( Ev0-Ev ) / ( kb*T ) ) )*cv_boundary;
                   jac->add_row(  rows[n_node_var_0+node_p_offset],  cols.size(),  &cols[0],  Jp.getADValue() );
                   jac->add_row(  rows[node_p_offset],  cols.size(),  &cols[0],  ( -Jp ).getADValue() );
 
                 // hole energy flux
-                AutoDScalar Sp = 2*e* ( mt0->band->ThermalVp ( T ) *p0*2.5*kb*Tp0 - pm*mt->band->ThermalVp ( T ) *p*exp ( ( Ev0-Ev ) / ( kb*T ) ) *2.5*kb*Tp )*cv_boundary;
+                AutoDScalar Sp = 2*e* ( mt0->band->ThermalVp (ctx0, T ) *p0*2.5*kb*Tp0 - pm*mt->band->ThermalVp (ctx, T ) *p*exp ( ( Ev0-Ev ) / ( kb*T ) ) *2.5*kb*Tp )*cv_boundary;
                 if ( regions[i]->get_advanced_model()->enable_Tp() )
                     jac->add_row(  rows[n_node_var_0+node_Tp_offset],  cols.size(),  &cols[0],  ( -Sp ).getADValue() );
                 if ( regions[0]->get_advanced_model()->enable_Tp() )
@@ -813,13 +815,13 @@ void HeteroInterfaceBC::EBM3_Jacobian ( PetscScalar * x, SparseMatrix<PetscScala
               else
               {
                 // holes are leaving this region
-                AutoDScalar pm = mt->band->EffecHoleMass ( T ) /mt0->band->EffecHoleMass ( T );
-                AutoDScalar Jp = 2*( mt->band->ThermalVp ( T ) *p - pm*mt0->band->ThermalVp ( T ) *p0*exp ( ( Ev-Ev0 ) / ( kb*T ) ) )*cv_boundary;
+                AutoDScalar pm = mt->band->EffecHoleMass (ctx, T ) /mt0->band->EffecHoleMass (ctx0, T );
+                AutoDScalar Jp = 2*( mt->band->ThermalVp (ctx, T ) *p - pm*mt0->band->ThermalVp (ctx0, T ) *p0*exp ( ( Ev-Ev0 ) / ( kb*T ) ) )*cv_boundary;
                   jac->add_row(  rows[n_node_var_0+node_p_offset],  cols.size(),  &cols[0],  (-Jp).getADValue() );
                   jac->add_row(  rows[node_p_offset],  cols.size(),  &cols[0],  Jp.getADValue() );
 
                 // hole energy flux
-                AutoDScalar Sp = 2*e* ( mt->band->ThermalVp ( T ) *p*2.5*kb*Tp - pm*mt0->band->ThermalVp ( T ) *p0*exp ( ( Ev-Ev0 ) / ( kb*T ) ) *2.5*kb*Tp0 )*cv_boundary;
+                AutoDScalar Sp = 2*e* ( mt->band->ThermalVp (ctx, T ) *p*2.5*kb*Tp - pm*mt0->band->ThermalVp (ctx0, T ) *p0*exp ( ( Ev-Ev0 ) / ( kb*T ) ) *2.5*kb*Tp0 )*cv_boundary;
                 if ( regions[i]->get_advanced_model()->enable_Tp() )
                     jac->add_row(  rows[n_node_var_0+node_Tp_offset],  cols.size(),  &cols[0],  Sp.getADValue() );
                 if ( regions[0]->get_advanced_model()->enable_Tp() )
@@ -177,7 +177,10 @@ void InsulatorSemiconductorInterfaceBC::EBM3_Function(PetscScalar * x, Vec f, In
           if(sregion->get_advanced_model()->enable_Tp())
             Tp = x[fvm_nodes[i]->local_offset() + node_Tp_offset]/p;
 
-          PetscScalar Eg = sregion->material()->band->Eg(T);
+          // mapping this node to material library
+          const PMI_Context ctx = sregion->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+
+          PetscScalar Eg = sregion->material()->band->Eg(ctx, T);
 
           // process interface fixed charge density
           PetscScalar boundary_area = fvm_nodes[i]->outside_boundary_surface_area();
@@ -186,9 +189,8 @@ void InsulatorSemiconductorInterfaceBC::EBM3_Function(PetscScalar * x, Vec f, In
           {
             // surface recombination
             Material::MaterialSemiconductor *mt =  sregion->material();
-            mt->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
-            mt->band->nie(p, n, T);
-            PetscScalar GSurf = - mt->band->R_Surf(p, n, T) * boundary_area; //generation due to SRH
+            mt->band->nie(ctx, p, n, T);
+            PetscScalar GSurf = - mt->band->R_Surf(ctx, p, n, T) * boundary_area; //generation due to SRH
 
             VecSetValue(f, fvm_nodes[i]->global_offset()+node_n_offset, GSurf, ADD_VALUES);
             VecSetValue(f, fvm_nodes[i]->global_offset()+node_p_offset, GSurf, ADD_VALUES);
@@ -205,7 +207,7 @@ void InsulatorSemiconductorInterfaceBC::EBM3_Function(PetscScalar * x, Vec f, In
             }
             if (sregion->get_advanced_model()->enable_Tl())
             {
-              PetscScalar Eg = mt->band->Eg(T);
+              PetscScalar Eg = mt->band->Eg(ctx, T);
               PetscScalar H  = - GSurf*(Eg+1.5*kb*Tn+1.5*kb*Tp);
               VecSetValue(f, fvm_nodes[i]->global_offset()+node_Tl_offset, H, ADD_VALUES);
             }
@@ -214,20 +216,18 @@ void InsulatorSemiconductorInterfaceBC::EBM3_Function(PetscScalar * x, Vec f, In
           if (sregion->get_advanced_model()->Trap)
           {
             // process interface traps
-            sregion->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
-
             // calculate interface trap occupancy
-            PetscScalar ni = sregion->material()->band->nie(p, n, T);
-            sregion->material()->trap->Calculate(false,p,n,ni,T);
+            PetscScalar ni = sregion->material()->band->nie(ctx, p, n, T);
+            sregion->material()->trap->Calculate(ctx, false,p,n,ni,T);
 
             // contribution of trapped charge to Poisson's eqn
-            PetscScalar TrappedC = sregion->material()->trap->Charge(false) * boundary_area;
+            PetscScalar TrappedC = sregion->material()->trap->Charge(ctx, false) * boundary_area;
             if (TrappedC !=0)
               VecSetValue(f, fvm_nodes[i]->global_offset(), TrappedC, ADD_VALUES);
 
             // electron/hole capture rates and contribution to continuity equations
-            PetscScalar TrapElec = sregion->material()->trap->ElectronTrapRate(false,n,ni,T) * boundary_area;
-            PetscScalar TrapHole = sregion->material()->trap->HoleTrapRate    (false,p,ni,T) * boundary_area;
+            PetscScalar TrapElec = sregion->material()->trap->ElectronTrapRate(ctx, false,n,ni,T) * boundary_area;
+            PetscScalar TrapHole = sregion->material()->trap->HoleTrapRate    (ctx, false,p,ni,T) * boundary_area;
 
             VecSetValue(f, fvm_nodes[i]->global_offset()+node_n_offset, -TrapElec, ADD_VALUES);
             VecSetValue(f, fvm_nodes[i]->global_offset()+node_p_offset, -TrapHole, ADD_VALUES);
@@ -240,7 +240,7 @@ void InsulatorSemiconductorInterfaceBC::EBM3_Function(PetscScalar * x, Vec f, In
             {
               PetscScalar EcEi = 0.5*Eg - kb*T*log(node_data->Nc()/node_data->Nv());
               PetscScalar EiEv = 0.5*Eg + kb*T*log(node_data->Nc()/node_data->Nv());
-              PetscScalar H    = sregion->material()->trap->TrapHeat(false,p,n,ni,Tp,Tn,T,EcEi,EiEv);
+              PetscScalar H    = sregion->material()->trap->TrapHeat(ctx, false,p,n,ni,Tp,Tn,T,EcEi,EiEv);
               VecSetValue(f, fvm_nodes[i]->global_offset()+node_Tl_offset, H*boundary_area, ADD_VALUES);
             }
           }
@@ -433,7 +433,7 @@ void InsulatorSemiconductorInterfaceBC::EBM3_Jacobian(PetscScalar * x, SparseMat
 
             //synchronize with material database
             mt->set_ad_num(adtl::AutoDScalar::numdir);
-            mt->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = mt->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
             std::vector<PetscInt> index;
             for(unsigned int nv=0; nv<n_node_var; ++nv)  index.push_back( fvm_nodes[i]->global_offset()+nv );
@@ -471,13 +471,13 @@ void InsulatorSemiconductorInterfaceBC::EBM3_Jacobian(PetscScalar * x, SparseMat
               pTp.setADValue(node_Tp_offset, 1.0);
               Tp = pTp/p;
             }
-            AutoDScalar Eg = mt->band->Eg(T);
-            AutoDScalar ni = sregion->material()->band->nie(p, n, T);
+            AutoDScalar Eg = mt->band->Eg(ctx, T);
+            AutoDScalar ni = sregion->material()->band->nie(ctx, p, n, T);
 
             PetscScalar boundary_area = fvm_nodes[i]->outside_boundary_surface_area();
 
             // surface recombination
-            AutoDScalar GSurf = - mt->band->R_Surf(p, n, T) * boundary_area; //generation due to SRH
+            AutoDScalar GSurf = - mt->band->R_Surf(ctx, p, n, T) * boundary_area; //generation due to SRH
 
             jac->add_row(  index[node_n_offset],  n_node_var,  &index[0],  GSurf.getADValue() );
             jac->add_row(  index[node_p_offset],  n_node_var,  &index[0],  GSurf.getADValue() );
@@ -500,12 +500,12 @@ void InsulatorSemiconductorInterfaceBC::EBM3_Jacobian(PetscScalar * x, SparseMat
 
             if (sregion->get_advanced_model()->Trap)
             {
-              mt->trap->Calculate(false,p,n,ni,T);
-              AutoDScalar TrappedC = mt->trap->ChargeAD(false) * boundary_area;
+              mt->trap->Calculate(ctx, false,p,n,ni,T);
+              AutoDScalar TrappedC = mt->trap->ChargeAD(ctx, false) * boundary_area;
               jac->add_row(  index[node_psi_offset],  n_node_var,  &index[0],  TrappedC.getADValue() );
 
-              AutoDScalar TrapElec = mt->trap->ElectronTrapRate(false,n,ni,T);
-              AutoDScalar TrapHole = mt->trap->HoleTrapRate    (false,p,ni,T);
+              AutoDScalar TrapElec = mt->trap->ElectronTrapRate(ctx, false,n,ni,T);
+              AutoDScalar TrapHole = mt->trap->HoleTrapRate    (ctx, false,p,ni,T);
               jac->add_row(  index[node_n_offset],  n_node_var,  &index[0],  (-TrapElec*boundary_area).getADValue() );
               jac->add_row(  index[node_p_offset],  n_node_var,  &index[0],  (-TrapElec*boundary_area).getADValue() );
 
@@ -525,7 +525,7 @@ void InsulatorSemiconductorInterfaceBC::EBM3_Jacobian(PetscScalar * x, SparseMat
               {
                 AutoDScalar EcEi = 0.5*Eg - kb*T*log(node_data->Nc()/node_data->Nv());
                 AutoDScalar EiEv = 0.5*Eg + kb*T*log(node_data->Nc()/node_data->Nv());
-                AutoDScalar H = mt->trap->TrapHeat(false,p,n,ni,Tp,Tn,T,EcEi,EiEv);
+                AutoDScalar H = mt->trap->TrapHeat(ctx, false,p,n,ni,Tp,Tn,T,EcEi,EiEv);
                 jac->add_row(  index[node_Tl_offset],  n_node_var,  &index[0],  (H*boundary_area).getADValue() );
               }
             }
@@ -221,12 +221,12 @@ void IF_Metal_OhmicBC::_EBM3_Function_Infinite_Recombination ( PetscScalar * x,
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    const PetscScalar nie = semiconductor_region->material()->band->nie ( p, n, T_semiconductor );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T_semiconductor );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T_semiconductor );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T_semiconductor );
+    const PetscScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T_semiconductor );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T_semiconductor );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T_semiconductor );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T_semiconductor );
 
 
     //governing equation for Ohmic contact boundary
@@ -617,12 +617,12 @@ void IF_Metal_OhmicBC::_EBM3_Jacobian_Infinite_Recombination ( PetscScalar * x,
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    AutoDScalar nie = semiconductor_region->material()->band->nie ( p, n, T_semiconductor );
-    const AutoDScalar Nc  = semiconductor_region->material()->band->Nc ( T_semiconductor );
-    const AutoDScalar Nv  = semiconductor_region->material()->band->Nv ( T_semiconductor );
-    const AutoDScalar Eg  = semiconductor_region->material()->band->Eg ( T_semiconductor );
+    AutoDScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T_semiconductor );
+    const AutoDScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T_semiconductor );
+    const AutoDScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T_semiconductor );
+    const AutoDScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T_semiconductor );
 
     //governing equation for Ohmic contact boundary
     AutoDScalar f_phi,f_elec,f_hole;
@@ -182,20 +182,20 @@ void IF_Metal_SchottkyBC::EBM3_Function(PetscScalar * x, Vec f, InsertMode &add_
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    const PetscScalar nie = semiconductor_region->material()->band->nie ( p, n, T_semiconductor );
-    const PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T_semiconductor );
-    const PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T_semiconductor );
-    const PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T_semiconductor );
+    const PetscScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T_semiconductor );
+    const PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T_semiconductor );
+    const PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T_semiconductor );
+    const PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T_semiconductor );
 
 
     //Schotty Barrier Lowerring
-    PetscScalar deltaVB = semiconductor_region->material()->band->SchottyBarrierLowerring(semiconductor_node_data->eps(), semiconductor_node_data->E().size());
+    PetscScalar deltaVB = semiconductor_region->material()->band->SchottyBarrierLowerring(ctx, semiconductor_node_data->eps(), semiconductor_node_data->E().size());
     //Schottky current
     PetscScalar S  = semiconductor_node->outside_boundary_surface_area();
-    PetscScalar In = semiconductor_region->material()->band->SchottyJsn(n, T_semiconductor, resistance_node_data->affinity() - semiconductor_node_data->affinity() - deltaVB) * S;
-    PetscScalar Ip = semiconductor_region->material()->band->SchottyJsp(p, T_semiconductor, resistance_node_data->affinity() - semiconductor_node_data->affinity() + deltaVB) * S;
+    PetscScalar In = semiconductor_region->material()->band->SchottyJsn(ctx, n, T_semiconductor, resistance_node_data->affinity() - semiconductor_node_data->affinity() - deltaVB) * S;
+    PetscScalar Ip = semiconductor_region->material()->band->SchottyJsp(ctx, p, T_semiconductor, resistance_node_data->affinity() - semiconductor_node_data->affinity() + deltaVB) * S;
 
     PetscScalar f_phi = V_semiconductor - V_resistance - deltaVB;
 
@@ -499,20 +499,20 @@ void IF_Metal_SchottkyBC::EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscScala
     // process semiconductor region
 
     // mapping this node to material library
-    semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+    const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-    AutoDScalar nie = semiconductor_region->material()->band->nie ( p, n, T_semiconductor );
-    AutoDScalar Nc  = semiconductor_region->material()->band->Nc ( T_semiconductor );
-    AutoDScalar Nv  = semiconductor_region->material()->band->Nv ( T_semiconductor );
-    AutoDScalar Eg  = semiconductor_region->material()->band->Eg ( T_semiconductor );
+    AutoDScalar nie = semiconductor_region->material()->band->nie (ctx, p, n, T_semiconductor );
+    AutoDScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T_semiconductor );
+    AutoDScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T_semiconductor );
+    AutoDScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T_semiconductor );
 
 
     //Schotty Barrier Lowerring
-    PetscScalar deltaVB = semiconductor_region->material()->band->SchottyBarrierLowerring(semiconductor_node_data->eps(), semiconductor_node_data->E().size());
+    PetscScalar deltaVB = semiconductor_region->material()->band->SchottyBarrierLowerring(ctx, semiconductor_node_data->eps(), semiconductor_node_data->E().size());
     //Schottky current
     PetscScalar S  = semiconductor_node->outside_boundary_surface_area();
-    AutoDScalar In = semiconductor_region->material()->band->SchottyJsn(n, T_semiconductor, resistance_node_data->affinity() - semiconductor_node_data->affinity() - deltaVB) * S;
-    AutoDScalar Ip = semiconductor_region->material()->band->SchottyJsp(p, T_semiconductor, resistance_node_data->affinity() - semiconductor_node_data->affinity() + deltaVB) * S;
+    AutoDScalar In = semiconductor_region->material()->band->SchottyJsn(ctx, n, T_semiconductor, resistance_node_data->affinity() - semiconductor_node_data->affinity() - deltaVB) * S;
+    AutoDScalar Ip = semiconductor_region->material()->band->SchottyJsp(ctx, p, T_semiconductor, resistance_node_data->affinity() - semiconductor_node_data->affinity() + deltaVB) * S;
 
     // the insert position
     PetscInt gloabl_node_phi_offset = semiconductor_node->global_offset()+0;
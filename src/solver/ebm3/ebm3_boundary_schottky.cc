@@ -196,7 +196,7 @@ void SchottkyContactBC::EBM3_Function(PetscScalar * x, Vec f, InsertMode &add_va
             const FVM_NodeData * node_data = fvm_nodes[i]->node_data();
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
             PetscScalar V = x[fvm_nodes[i]->local_offset()+node_psi_offset];  // psi of this node
             PetscScalar n = x[fvm_nodes[i]->local_offset()+node_n_offset];  // electron density
@@ -209,11 +209,11 @@ void SchottkyContactBC::EBM3_Function(PetscScalar * x, Vec f, InsertMode &add_va
               T = x[fvm_nodes[i]->local_offset() + node_Tl_offset];
 
             //Schotty Barrier Lowerring
-            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
             //Schottky current
             PetscScalar S  = fvm_nodes[i]->outside_boundary_surface_area();
-            PetscScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-            PetscScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+            PetscScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+            PetscScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
             PetscScalar ff = V + Work_Function - deltaVB - Ve;
 
@@ -561,7 +561,7 @@ void SchottkyContactBC::EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
             const FVM_NodeData * node_data = fvm_nodes[i]->node_data();
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
             //the indepedent variable number, we only need n_node_var+1 here.
             adtl::AutoDScalar::numdir=n_node_var+1;
@@ -604,12 +604,12 @@ void SchottkyContactBC::EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
             AutoDScalar Ve = x[this->local_offset()];             Ve.setADValue(n_node_var, 1.0);
 
             //Schotty Barrier Lowerring
-            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
 
             //Schottky current
             PetscScalar S  = fvm_nodes[i]->outside_boundary_surface_area();
-            AutoDScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-            AutoDScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+            AutoDScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+            AutoDScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
             // schottky boundary condition of poisson's equation
             AutoDScalar ff = V + Work_Function - deltaVB - Ve;
@@ -896,11 +896,14 @@ void SchottkyContactBC::EBM3_Electrode_Trace(Vec lx, SparseMatrix<PetscScalar> *
     if( semi_region->get_advanced_model()->enable_Tl() )
     { T = xx[fvm_node->local_offset()+node_Tl_offset];   T.setADValue(2, 1.0);  } // T of node
 
+    // mapping this node to material library
+    const PMI_Context ctx = semi_region->material()->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+
     //Schottky current
     PetscScalar S  = fvm_node->outside_boundary_surface_area();
-    PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring( node_data->eps(), node_data->E().size() );
-    AutoDScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-    AutoDScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+    PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size() );
+    AutoDScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+    AutoDScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
     VecSetValues( pdI_pdx, index.size(), &index[0], (-Fn*current_scale).getADValue(), ADD_VALUES);
     VecSetValues( pdI_pdx, index.size(), &index[0], (-Fp*current_scale).getADValue(), ADD_VALUES);
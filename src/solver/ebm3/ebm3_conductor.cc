@@ -147,10 +147,12 @@ void ElectrodeSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, InsertMode
   y.reserve(4*n_edge());
 
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -162,21 +164,19 @@ void ElectrodeSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, InsertMode
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_global_offset = fvm_n1->global_offset();
-    const unsigned int n2_global_offset = fvm_n2->global_offset();
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_global_offset = edge_table.n1_global_offset[nedge];
+    const unsigned int n2_global_offset = edge_table.n2_global_offset[nedge];
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
       PetscScalar V1   =  x[n1_local_offset+node_psi_offset];             // electrostatic potential
       PetscScalar rho1 =  0;                                // charge density
       PetscScalar eps1 =  n1_data->eps();                   // permittivity
 
 
       //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
       PetscScalar V2   =  x[n2_local_offset+node_psi_offset];
       PetscScalar rho2 =  0;
       PetscScalar eps2 =  n2_data->eps();
@@ -184,16 +184,16 @@ void ElectrodeSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, InsertMode
       PetscScalar eps = 0.5*(eps1+eps2);       // eps at mid point of the edge
 
       // "flux" from node 2 to node 1
-      PetscScalar f_psi =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/fvm_n1->distance(fvm_n2) ;
+      PetscScalar f_psi =  eps*edge_table.cv_area[nedge]*(V2 - V1)/edge_table.length[nedge] ;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         iy.push_back(n1_global_offset+node_psi_offset);
         y.push_back(f_psi);
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         iy.push_back(n2_global_offset+node_psi_offset);
         y.push_back(-f_psi);
@@ -204,23 +204,21 @@ void ElectrodeSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, InsertMode
        */
       if(get_advanced_model()->enable_Tl())
       {
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
         PetscScalar T1   =  x[n1_local_offset+node_Tl_offset];             // lattice temperature
         PetscScalar kap1 =  mt->thermal->HeatConduction(T1);
 
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
         PetscScalar T2   =  x[n2_local_offset+node_Tl_offset];
         PetscScalar kap2 =  mt->thermal->HeatConduction(T2);
         PetscScalar kap = 0.5*(kap1+kap2);       // kapa at mid point of the edge
-        PetscScalar f_q =  kap*fvm_n1->cv_surface_area(fvm_n2)*(T2 - T1)/fvm_n1->distance(fvm_n2) ;
+        PetscScalar f_q =  kap*edge_table.cv_area[nedge]*(T2 - T1)/edge_table.length[nedge] ;
         // ignore thoese ghost nodes
-        if( fvm_n1->on_processor() )
+        if( edge_table.n1_on_processor[nedge] )
         {
           iy.push_back(n1_global_offset+node_Tl_offset);
           y.push_back(f_q);
         }
 
-        if( fvm_n2->on_processor() )
+        if( edge_table.n2_on_processor[nedge] )
         {
           iy.push_back(n2_global_offset+node_Tl_offset);
           y.push_back(-f_q);
@@ -261,10 +259,12 @@ void ElectrodeSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<Pets
   mt->set_ad_num(adtl::AutoDScalar::numdir);
 
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -276,21 +276,19 @@ void ElectrodeSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<Pets
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_global_offset = fvm_n1->global_offset();
-    const unsigned int n2_global_offset = fvm_n2->global_offset();
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_global_offset = edge_table.n1_global_offset[nedge];
+    const unsigned int n2_global_offset = edge_table.n2_global_offset[nedge];
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
       AutoDScalar V1   =  x[n1_local_offset+node_psi_offset];  V1.setADValue(0,1.0);           // electrostatic potential
       PetscScalar rho1 =  0;                                // charge density
       PetscScalar eps1 =  n1_data->eps();                   // permittivity
 
 
       //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
       AutoDScalar V2   =  x[n2_local_offset+node_psi_offset];  V2.setADValue(1,1.0);
       PetscScalar rho2 =  0;
       PetscScalar eps2 =  n2_data->eps();
@@ -298,16 +296,16 @@ void ElectrodeSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<Pets
 
       PetscScalar eps = 0.5*(eps1+eps2);       // eps at mid point of the edge
       // "flux" from node 2 to node 1
-      AutoDScalar f_psi =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/fvm_n1->distance(fvm_n2) ;
+      AutoDScalar f_psi =  eps*edge_table.cv_area[nedge]*(V2 - V1)/edge_table.length[nedge] ;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         jac->add( n1_global_offset+node_psi_offset,  n1_global_offset+node_psi_offset,  f_psi.getADValue(0) );
         jac->add( n1_global_offset+node_psi_offset,  n2_global_offset+node_psi_offset,  f_psi.getADValue(1) );
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         jac->add( n2_global_offset+node_psi_offset,  n1_global_offset+node_psi_offset,  -f_psi.getADValue(0) );
         jac->add( n2_global_offset+node_psi_offset,  n2_global_offset+node_psi_offset,  -f_psi.getADValue(1) );
@@ -318,25 +316,23 @@ void ElectrodeSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<Pets
        */
       if(get_advanced_model()->enable_Tl())
       {
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
         AutoDScalar T1   =  x[n1_local_offset+node_Tl_offset];  T1.setADValue(0,1.0);           // lattice temperature
         PetscScalar kap1 =  mt->thermal->HeatConduction(T1.getValue());
 
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
         AutoDScalar T2   =  x[n2_local_offset+node_Tl_offset];  T2.setADValue(1,1.0);
         PetscScalar kap2 =  mt->thermal->HeatConduction(T2.getValue());
 
         PetscScalar kap = 0.5*(kap1+kap2);       // kapa at mid point of the edge
-        AutoDScalar f_q =  kap*fvm_n1->cv_surface_area(fvm_n2)*(T2 - T1)/fvm_n1->distance(fvm_n2) ;
+        AutoDScalar f_q =  kap*edge_table.cv_area[nedge]*(T2 - T1)/edge_table.length[nedge] ;
 
         // ignore thoese ghost nodes
-        if( fvm_n1->on_processor() )
+        if( edge_table.n1_on_processor[nedge] )
         {
           jac->add( n1_global_offset+node_Tl_offset,  n1_global_offset+node_Tl_offset,  f_q.getADValue(0) );
           jac->add( n1_global_offset+node_Tl_offset,  n2_global_offset+node_Tl_offset,  f_q.getADValue(1) );
         }
 
-        if( fvm_n2->on_processor() )
+        if( edge_table.n2_on_processor[nedge] )
         {
           jac->add( n2_global_offset+node_Tl_offset,  n1_global_offset+node_Tl_offset,  -f_q.getADValue(0) );
           jac->add( n2_global_offset+node_Tl_offset,  n2_global_offset+node_Tl_offset,  -f_q.getADValue(1) );
@@ -384,7 +380,6 @@ void ElectrodeSimulationRegion::EBM3_Time_Dependent_Function(PetscScalar * x, Ve
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     PetscScalar T   =  x[fvm_node->local_offset()+node_Tl_offset];                         // lattice temperature
     PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(T);
@@ -445,7 +440,6 @@ void ElectrodeSimulationRegion::EBM3_Time_Dependent_Jacobian(PetscScalar * x, Sp
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     AutoDScalar T   =  x[fvm_node->local_offset()+node_Tl_offset];   T.setADValue(0, 1.0);              // lattice temperature
     PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(T.getValue());
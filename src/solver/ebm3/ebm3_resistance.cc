@@ -151,10 +151,12 @@ void MetalSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, InsertMode &ad
   y.reserve(4*n_edge());
 
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -166,20 +168,18 @@ void MetalSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, InsertMode &ad
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_global_offset = fvm_n1->global_offset();
-    const unsigned int n2_global_offset = fvm_n2->global_offset();
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_global_offset = edge_table.n1_global_offset[nedge];
+    const unsigned int n2_global_offset = edge_table.n2_global_offset[nedge];
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
       PetscScalar V1   =  x[n1_local_offset+node_psi_offset];             // electrostatic potential
       PetscScalar rho1 =  0;                                // charge density
       PetscScalar T1   = n1_data->T();
 
       //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
       PetscScalar V2   =  x[n2_local_offset+node_psi_offset];
       PetscScalar rho2 =  0;
       PetscScalar T2   = n2_data->T();
@@ -190,23 +190,23 @@ void MetalSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, InsertMode &ad
         T2 = x[n2_local_offset+node_Tl_offset];
       }
       
-      PetscScalar E = (V2-V1)/fvm_n1->distance(fvm_n2);
+      PetscScalar E = (V2-V1)/edge_table.length[nedge];
       PetscScalar J = mt->basic->CurrentDensity(E, 0.5*(T1+T2));
 
       // truncated to positive
-      double S = std::abs(fvm_n1->cv_surface_area(fvm_n2));
+      double S = std::abs(edge_table.cv_area[nedge]);
 
       // "flux" from node 2 to node 1
       PetscScalar f_psi = J*S;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         iy.push_back(n1_global_offset+node_psi_offset);
         y.push_back(f_psi);
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         iy.push_back(n2_global_offset+node_psi_offset);
         y.push_back(-f_psi);
@@ -217,25 +217,23 @@ void MetalSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, InsertMode &ad
       */
       if(get_advanced_model()->enable_Tl())
       {
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
         PetscScalar kap1 =  mt->thermal->HeatConduction(T1);
 
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
         PetscScalar kap2 =  mt->thermal->HeatConduction(T2);
         
         PetscScalar kap = 0.5*(kap1+kap2);       // kapa at mid point of the edge
-        PetscScalar f_q =  kap*S*(T2 - T1)/fvm_n1->distance(fvm_n2) ;
+        PetscScalar f_q =  kap*S*(T2 - T1)/edge_table.length[nedge] ;
         // joule heating
         PetscScalar H = 0.5*(V2-V1)*J*S;
       
         // ignore thoese ghost nodes
-        if( fvm_n1->on_processor() )
+        if( edge_table.n1_on_processor[nedge] )
         {
           iy.push_back(n1_global_offset+node_Tl_offset);
           y.push_back(f_q+H);
         }
 
-        if( fvm_n2->on_processor() )
+        if( edge_table.n2_on_processor[nedge] )
         {
           iy.push_back(n2_global_offset+node_Tl_offset);
           y.push_back(-f_q+H);
@@ -278,10 +276,12 @@ void MetalSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
   const PetscScalar sigma = mt->basic->Conductance();
 
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -293,10 +293,10 @@ void MetalSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_global_offset = fvm_n1->global_offset();
-    const unsigned int n2_global_offset = fvm_n2->global_offset();
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_global_offset = edge_table.n1_global_offset[nedge];
+    const unsigned int n2_global_offset = edge_table.n2_global_offset[nedge];
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
     
     std::vector<PetscInt> col;
     col.push_back(n1_global_offset+node_psi_offset);
@@ -309,13 +309,11 @@ void MetalSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
 
     {
       //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
       AutoDScalar V1   =  x[n1_local_offset+node_psi_offset];  V1.setADValue(0,1.0);           // electrostatic potential
       PetscScalar rho1 =  0;                                // charge density
       AutoDScalar T1   = n1_data->T();
 
       //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
       AutoDScalar V2   =  x[n2_local_offset+node_psi_offset];  V2.setADValue(1,1.0);
       PetscScalar rho2 =  0;
       AutoDScalar T2   = n1_data->T();
@@ -326,22 +324,22 @@ void MetalSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
         T2 = x[n2_local_offset+node_Tl_offset];  T2.setADValue(3,1.0);
       }
 
-      AutoDScalar E    = (V2-V1)/fvm_n1->distance(fvm_n2);
+      AutoDScalar E    = (V2-V1)/edge_table.length[nedge];
       AutoDScalar J = mt->basic->CurrentDensity(E, 0.5*(T1+T2));
       
       // truncated to positive
-      double S = std::abs(fvm_n1->cv_surface_area(fvm_n2));
+      double S = std::abs(edge_table.cv_area[nedge]);
 
       // "flux" from node 2 to node 1
       AutoDScalar f_psi = J*S;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         jac->add_row( n1_global_offset+node_psi_offset,  col.size(), &col[0],  f_psi.getADValue() );
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         jac->add_row( n2_global_offset+node_psi_offset,  col.size(), &col[0],  (-f_psi).getADValue() );
       }
@@ -351,23 +349,21 @@ void MetalSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
       */
       if(get_advanced_model()->enable_Tl())
       {
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
         PetscScalar kap1 =  mt->thermal->HeatConduction(T1.getValue());
 
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
         PetscScalar kap2 =  mt->thermal->HeatConduction(T2.getValue());
 
         PetscScalar kap = 0.5*(kap1+kap2);       // kapa at mid point of the edge
-        AutoDScalar f_q = kap*S*(T2 - T1)/fvm_n1->distance(fvm_n2) ;
+        AutoDScalar f_q = kap*S*(T2 - T1)/edge_table.length[nedge] ;
         AutoDScalar H   = 0.5*(V2-V1)*J*S;
 
         // ignore thoese ghost nodes
-        if( fvm_n1->on_processor() )
+        if( edge_table.n1_on_processor[nedge] )
         {
           jac->add_row( n1_global_offset+node_Tl_offset, col.size(), &col[0],  (f_q+H).getADValue() );
         }
 
-        if( fvm_n2->on_processor() )
+        if( edge_table.n2_on_processor[nedge] )
         {
           jac->add_row( n2_global_offset+node_Tl_offset, col.size(), &col[0],  (-f_q+H).getADValue() );
         }
@@ -414,7 +410,6 @@ void MetalSimulationRegion::EBM3_Time_Dependent_Function(PetscScalar * x, Vec f,
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     PetscScalar T   =  x[fvm_node->local_offset()+node_Tl_offset];                         // lattice temperature
     PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(T);
@@ -474,7 +469,6 @@ void MetalSimulationRegion::EBM3_Time_Dependent_Jacobian(PetscScalar * x, Sparse
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     AutoDScalar T   =  x[fvm_node->local_offset()+node_Tl_offset];   T.setADValue(0, 1.0);              // lattice temperature
     PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(T.getValue());
@@ -26,6 +26,8 @@
 #include "semiconductor_region.h"
 #include "solver_specify.h"
 #include "log.h"
+#include "thread_pool.h"
+#include "fvm_thread_assembly.h"
 
 #include "jflux1.h"
 #include "jflux2.h"
@@ -117,6 +119,24 @@ unsigned int SemiconductorSimulationRegion::ebm_variable_offset(SolutionVariable
  * filling solution data from FVM_NodeData into petsc vector of L3 EBM.
  */
 void SemiconductorSimulationRegion::EBM3_Fill_Value(Vec x, Vec L)
+{
+  // data buffer
+  FVM_ThreadFillValue data(6*this->n_node());
+
+  // for all the on processor node, insert value to petsc vector
+  Genius::MemberThreadLoop<SemiconductorSimulationRegion, FVM_ThreadFillValue>
+      node_loop(this, &SemiconductorSimulationRegion::EBM3_Fill_Value_Node, data);
+  Genius::parallel_for(n_on_processor_node(), node_loop);
+
+  // call petsc VecSetValues routine to insert bufferred value, in thread order
+  data.flush(x, L);
+}
+
+
+/*---------------------------------------------------------------------
+ * fill solution data of on processor nodes [begin, end)
+ */
+void SemiconductorSimulationRegion::EBM3_Fill_Value_Node(FVM_ThreadFillValue &data, unsigned int thread, unsigned int begin, unsigned int end)
 {
   // find the node variable offset
   unsigned int node_psi_offset = ebm_variable_offset(POTENTIAL);
@@ -126,25 +146,18 @@ void SemiconductorSimulationRegion::EBM3_Fill_Value(Vec x, Vec L)
   unsigned int node_Tn_offset  = ebm_variable_offset(E_TEMP);
   unsigned int node_Tp_offset  = ebm_variable_offset(H_TEMP);
 
-  // data buffer
-  std::vector<int> ix;
-  std::vector<PetscScalar> y;
-  std::vector<PetscScalar> s;
-
-  // reserve menory for data buffer
-  ix.reserve(6*this->n_node());
-  y.reserve(6*this->n_node());
-  s.reserve(6*this->n_node());
+  std::vector<PetscInt>    & ix = data.index(thread);
+  std::vector<PetscScalar> & y  = data.value(thread);
+  std::vector<PetscScalar> & s  = data.scale(thread);
 
-  // for all the on processor node, insert value to petsc vector
-  const_processor_node_iterator node_it = on_processor_nodes_begin();
-  const_processor_node_iterator node_it_end = on_processor_nodes_end();
+  const_processor_node_iterator node_it = on_processor_nodes_begin() + begin;
+  const_processor_node_iterator node_it_end = on_processor_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
 
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, 0.0);
 
     // the first variable, psi
     ix.push_back(fvm_node->global_offset()+node_psi_offset);
@@ -186,13 +199,6 @@ void SemiconductorSimulationRegion::EBM3_Fill_Value(Vec x, Vec L)
     }
 
   }
-
-  // call petsc VecSetValues routine to insert bufferred value
-  if( ix.size() )
-  {
-    VecSetValues(x, ix.size(), &ix[0], &y[0], INSERT_VALUES) ;
-    VecSetValues(L, ix.size(), &ix[0], &s[0], INSERT_VALUES) ;
-  }
 }
 
 
@@ -204,12 +210,96 @@ void SemiconductorSimulationRegion::EBM3_Fill_Value(Vec x, Vec L)
 
 
 
+/*---------------------------------------------------------------------
+ * data shared by the threads of EBM3_Function
+ */
+struct SemiconductorSimulationRegion::EBM3_Function_Data
+{
+  EBM3_Function_Data(unsigned int n_node)
+    : cell(6*n_node), node(6*n_node), node_ii(Genius::n_threads())
+  {}
+
+  /// local solution vector
+  PetscScalar *   x;
+  /// highfield mobility is used
+  bool            highfield_mob;
+
+  /// buffer for "cell" related terms
+  FVM_ThreadResidual  cell;
+  /// buffer for node related terms
+  FVM_ThreadResidual  node;
+
+  /// impact ionization generation rate of node, which is added to node data after the cell loop
+  std::vector< std::vector< std::pair<FVM_NodeData *, PetscScalar> > >  node_ii;
+};
+
+
 /*---------------------------------------------------------------------
  * build function and its jacobian for EBM3 solver
  */
 void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, InsertMode &add_value_flag)
 {
 
+  // note, we will use ADD_VALUES to set values of vec f
+  // if the previous operator is not ADD_VALUES, we should assembly the vec first!
+  if( (add_value_flag != ADD_VALUES) && (add_value_flag != NOT_SET_VALUES) )
+  {
+    VecAssemblyBegin(f);
+    VecAssemblyEnd(f);
+  }
+
+  // set local buf here
+  EBM3_Function_Data data(n_node());
+
+  data.x             = x;
+  data.highfield_mob = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
+
+  // first, search all the element in this region and process "cell" related terms
+  // note, they are all local element, thus must be processed
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, EBM3_Function_Data>
+        cell_loop(this, &SemiconductorSimulationRegion::EBM3_Function_Cell, data);
+    Genius::parallel_for(n_cell(), cell_loop);
+  }
+
+  // impact ionization generation of each node, in thread order
+  for(unsigned int t=0; t<data.node_ii.size(); ++t)
+    for(unsigned int i=0; i<data.node_ii[t].size(); ++i)
+      data.node_ii[t][i].first->ImpactIonization() += data.node_ii[t][i].second;
+
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+
+  // process node related terms
+  // including \rho of poisson's equation and recombination term of continuation equation
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, EBM3_Function_Data>
+        node_loop(this, &SemiconductorSimulationRegion::EBM3_Function_Node, data);
+    Genius::parallel_for(n_on_processor_node(), node_loop);
+  }
+
+  // add into petsc vector
+  data.cell.flush(f);
+  data.node.flush(f);
+
+  // after the first scan, every nodes are updated.
+  // however, boundary condition should be processed later.
+
+  // the last operator is ADD_VALUES
+  add_value_flag = ADD_VALUES;
+
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+}
+
+
+/*---------------------------------------------------------------------
+ * "cell" related terms of elements [begin, end)
+ */
+void SemiconductorSimulationRegion::EBM3_Function_Cell(EBM3_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
   // find the node variable offset
   unsigned int node_psi_offset = ebm_variable_offset(POTENTIAL);
   unsigned int node_n_offset   = ebm_variable_offset(ELECTRON);
@@ -224,29 +314,18 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
   unsigned int Hn_level = get_advanced_model()->Hn_level();
   unsigned int Hp_level = get_advanced_model()->Hp_level();
 
-  // note, we will use ADD_VALUES to set values of vec f
-  // if the previous operator is not ADD_VALUES, we should assembly the vec first!
-  if( (add_value_flag != ADD_VALUES) && (add_value_flag != NOT_SET_VALUES) )
-  {
-    VecAssemblyBegin(f);
-    VecAssemblyEnd(f);
-  }
+  const PetscScalar * x = data.x;
+  const bool  highfield_mob = data.highfield_mob;
 
-  // set local buf here
-  std::vector<int>          iy;
-  std::vector<PetscScalar>  y;
+  std::vector<PetscInt>    & iy = data.cell.index(thread);
+  std::vector<PetscScalar> & y  = data.cell.value(thread);
+  std::vector< std::pair<FVM_NodeData *, PetscScalar> > & node_ii = data.node_ii[thread];
 
-  iy.reserve(6*n_node());
-  y.reserve(6*n_node());
+  const FVM_EdgeTable & edge_table = this->edge_table();
 
-  bool  highfield_mob   = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
-
-  // first, search all the element in this region and process "cell" related terms
-  // note, they are all local element, thus must be processed
-
-  const_element_iterator it = elements_begin();
-  const_element_iterator it_end = elements_end();
-  for(unsigned int nelem=0 ; it!=it_end; ++it, ++nelem)
+  const_element_iterator it = elements_begin() + begin;
+  const_element_iterator it_end = elements_begin() + end;
+  for(unsigned int nelem=begin ; it!=it_end; ++it, ++nelem)
   {
     const Elem * elem = *it;
     FVM_CellData * elem_data = this->get_region_elem_data(nelem);
@@ -358,10 +437,10 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
         // stupid code... we can not dot point with VectorValue<PetscScalar> yet.
         VectorValue<PetscScalar> norm(_norm(0), _norm(1), _norm(2));
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         PetscScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         PetscScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -416,8 +495,11 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
       std::pair<unsigned int, unsigned int> edge_nodes;
       elem->nodes_on_edge(ne, edge_nodes);
 
+      const unsigned int slot = edge_table.elem_slot(nelem, ne);
+      const unsigned int edge_index = edge_table.elem_edge[slot];
+
       // the length of this edge
-      const double length = elem->edge_length(ne);
+      const double length = edge_table.length[edge_index];
 
       // fvm_node of node1
       FVM_Node * fvm_n1 = elem->get_fvm_node(edge_nodes.first);
@@ -427,25 +509,30 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
       FVM_NodeData * n1_data = fvm_n1->node_data();  genius_assert(n1_data);            // fvm_node_data of node1
       FVM_NodeData * n2_data = fvm_n2->node_data();  genius_assert(n2_data);            // fvm_node_data of node2
 
-      double partial_area = elem->partial_area_with_edge(ne);        // partial area associated with this edge
-      double partial_volume = elem->partial_volume_with_edge(ne);    // partial volume associated with this edge
+      double partial_area = edge_table.partial_area[slot];        // partial area associated with this edge
+      double partial_volume = edge_table.partial_volume[slot];    // partial volume associated with this edge
       double truncated_partial_area =  partial_area;
       double truncated_partial_volume =  partial_volume;
       if(truncation)
       {
         // use truncated partial area to avoid negative area due to bad mesh elem
-        truncated_partial_area =  this->truncated_partial_area(elem, ne);
-        truncated_partial_volume =  elem->partial_volume_with_edge_truncated(ne);
+        truncated_partial_area =  edge_table.truncated_partial_area[slot];
+        truncated_partial_volume =  edge_table.truncated_partial_volume[slot];
       }
 
-      unsigned int n1_local_offset = fvm_n1->local_offset();
-      unsigned int n2_local_offset = fvm_n2->local_offset();
+      bool inverse = edge_table.elem_edge_inverse[slot];       // find the correct order
+      const unsigned int n1_local_offset = inverse ? edge_table.n2_local_offset[edge_index] : edge_table.n1_local_offset[edge_index];
+      const unsigned int n2_local_offset = inverse ? edge_table.n1_local_offset[edge_index] : edge_table.n2_local_offset[edge_index];
+      const unsigned int n1_global_offset = inverse ? edge_table.n2_global_offset[edge_index] : edge_table.n1_global_offset[edge_index];
+      const unsigned int n2_global_offset = inverse ? edge_table.n1_global_offset[edge_index] : edge_table.n2_global_offset[edge_index];
+      const bool n1_on_processor = inverse ? edge_table.n2_on_processor[edge_index] : edge_table.n1_on_processor[edge_index];
+      const bool n2_on_processor = inverse ? edge_table.n1_on_processor[edge_index] : edge_table.n2_on_processor[edge_index];
 
       // build governing equation of EBM
       {
 
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         PetscScalar V1   =  x[n1_local_offset + node_psi_offset];                // electrostatic potential
         PetscScalar n1   =  x[n1_local_offset + node_n_offset];                  // electron density
@@ -473,8 +560,8 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
         // takes care of the change effective DOS.
         // Ec/Ev should not be used except when its difference between two nodes.
         // The same comment applies to Ec2/Ev2.
-        PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(p1, n1, T1) + kb*T1*log(n1_data->Nc()));
-        PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(p1, n1, T1) - kb*T1*log(n1_data->Nv()) + mt->band->Eg(T1));
+        PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(ctx1, p1, n1, T1) + kb*T1*log(n1_data->Nc()));
+        PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(ctx1, p1, n1, T1) - kb*T1*log(n1_data->Nv()) + mt->band->Eg(ctx1, T1));
         if(get_advanced_model()->Fermi)
         {
           Ec1 = Ec1 - kb*T1*log(gamma_f(fabs(n1)/n1_data->Nc()));
@@ -482,12 +569,12 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
         }
 
         PetscScalar eps1 =  n1_data->eps();                        // eps
-        PetscScalar kap1 =  mt->thermal->HeatConduction(T1);
-        PetscScalar Eg1= mt->band->Eg(T1);
+        PetscScalar kap1 =  mt->thermal->HeatConduction(ctx1, T1);
+        PetscScalar Eg1= mt->band->Eg(ctx1, T1);
 
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         PetscScalar V2   =  x[n2_local_offset + node_psi_offset];                // electrostatic potential
         PetscScalar n2   =  x[n2_local_offset + node_n_offset];                  // electron density
@@ -509,8 +596,8 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
         if(get_advanced_model()->enable_Tp())
           Tp2 = x[n2_local_offset + node_Tp_offset]/p2;
 
-        PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(p2, n2, T2) + kb*T2*log(n2_data->Nc()));
-        PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(p2, n2, T2) - kb*T2*log(n2_data->Nv()) + mt->band->Eg(T2));
+        PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(ctx2, p2, n2, T2) + kb*T2*log(n2_data->Nc()));
+        PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(ctx2, p2, n2, T2) - kb*T2*log(n2_data->Nv()) + mt->band->Eg(ctx2, T2));
         if(get_advanced_model()->Fermi)
         {
           Ec2 = Ec2 - kb*T2*log(gamma_f(fabs(n2)/n2_data->Nc()));
@@ -518,8 +605,8 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
         }
 
         PetscScalar eps2 =  n2_data->eps();                         // eps
-        PetscScalar kap2 =  mt->thermal->HeatConduction(T2);
-        PetscScalar Eg2= mt->band->Eg(T2);
+        PetscScalar kap2 =  mt->thermal->HeatConduction(ctx2, T2);
+        PetscScalar Eg2= mt->band->Eg(ctx2, T2);
 
 
         PetscScalar mun1;  // electron mobility
@@ -540,34 +627,28 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
               Et = (E - dir*(E*dir)).size();
             }
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Ep, Et, Tn1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Ep, Et, Tp1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Ep, Et, Tn1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Ep, Et, Tp1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Ep, Et, Tn2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Ep, Et, Tp2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Ep, Et, Tn2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Ep, Et, Tp2);
           }
           else
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Epn, Etn, Tn1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Epp, Etp, Tp1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Epn, Etn, Tn1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Epp, Etp, Tp1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Epn, Etn, Tn2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Epp, Etp, Tp2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Epn, Etn, Tn2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Epp, Etp, Tp2);
           }
         }
         else
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T1, 0, 0, Tn1);
-          mup1 = mt->mob->HoleMob(p1, n1, T1, 0, 0, Tp1);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, 0, 0, Tn1);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, 0, 0, Tp1);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T2, 0, 0, Tn2);
-          mup2 = mt->mob->HoleMob(p2, n2, T2, 0, 0, Tp2);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, 0, 0, Tn2);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, 0, 0, Tp2);
         }
 
 
@@ -629,26 +710,26 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
 
 
         // ignore thoese ghost nodes (ghost nodes is local but with different processor_id())
-        if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+        if( n1_on_processor )
         {
 
           // poisson's equation
-          iy.push_back( fvm_n1->global_offset() + node_psi_offset );
+          iy.push_back( n1_global_offset + node_psi_offset );
           y.push_back ( eps*(V2 - V1)/length*partial_area );
 
           // continuity equation of electron
-          iy.push_back( fvm_n1->global_offset() + node_n_offset );
+          iy.push_back( n1_global_offset + node_n_offset );
           y.push_back ( Jn*truncated_partial_area );
 
           // continuity equation of hole
-          iy.push_back( fvm_n1->global_offset() + node_p_offset );
+          iy.push_back( n1_global_offset + node_p_offset );
           y.push_back ( - Jp*truncated_partial_area );
 
 
           // heat transport equation if required
           if(get_advanced_model()->enable_Tl())
           {
-            iy.push_back( fvm_n1->global_offset() + node_Tl_offset );
+            iy.push_back( n1_global_offset + node_Tl_offset );
             y.push_back ( kap*(T2 - T1)/length*partial_area + H*truncated_partial_area);
           }
 
@@ -656,7 +737,7 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
           // energy balance equation for electron if required
           if(get_advanced_model()->enable_Tn())
           {
-            iy.push_back( fvm_n1->global_offset() + node_Tn_offset );
+            iy.push_back( n1_global_offset + node_Tn_offset );
             y.push_back ( -Sn*truncated_partial_area + Hn*truncated_partial_area);
           }
 
@@ -664,33 +745,33 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
           // energy balance equation for hole if required
           if(get_advanced_model()->enable_Tp())
           {
-            iy.push_back( fvm_n1->global_offset() + node_Tp_offset );
+            iy.push_back( n1_global_offset + node_Tp_offset );
             y.push_back ( -Sp*truncated_partial_area + Hp*truncated_partial_area);
           }
 
         }
 
         // for node 2.
-        if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+        if( n2_on_processor )
         {
 
           // poisson's equation
-          iy.push_back( fvm_n2->global_offset() + node_psi_offset );
+          iy.push_back( n2_global_offset + node_psi_offset );
           y.push_back ( eps*(V1 - V2)/length*partial_area );
 
           // continuity equation of electron
-          iy.push_back( fvm_n2->global_offset() + node_n_offset );
+          iy.push_back( n2_global_offset + node_n_offset );
           y.push_back ( - Jn*truncated_partial_area );
 
           // continuity equation of hole
-          iy.push_back( fvm_n2->global_offset() + node_p_offset );
+          iy.push_back( n2_global_offset + node_p_offset );
           y.push_back ( Jp*truncated_partial_area );
 
 
           // heat transport equation if required
           if(get_advanced_model()->enable_Tl())
           {
-            iy.push_back( fvm_n2->global_offset() + node_Tl_offset );
+            iy.push_back( n2_global_offset + node_Tl_offset );
             y.push_back ( kap*(T1 - T2)/length*partial_area + H*truncated_partial_area);
           }
 
@@ -698,7 +779,7 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
           // energy balance equation for electron if required
           if(get_advanced_model()->enable_Tn())
           {
-            iy.push_back( fvm_n2->global_offset() + node_Tn_offset );
+            iy.push_back( n2_global_offset + node_Tn_offset );
             y.push_back ( Sn*truncated_partial_area + Hn*truncated_partial_area);
           }
 
@@ -706,7 +787,7 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
           // energy balance equation for hole if required
           if(get_advanced_model()->enable_Tp())
           {
-            iy.push_back( fvm_n2->global_offset() + node_Tp_offset );
+            iy.push_back( n2_global_offset + node_Tp_offset );
             y.push_back ( Sp*truncated_partial_area + Hp*truncated_partial_area);
           }
 
@@ -714,26 +795,26 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
 
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
-          PetscScalar GBTBT1 = mt->band->BB_Tunneling(T1, E.size());
-          PetscScalar GBTBT2 = mt->band->BB_Tunneling(T2, E.size());
+          PetscScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T1, E.size());
+          PetscScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T2, E.size());
 
-          if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+          if( n1_on_processor )
           {
             // continuity equation
-            iy.push_back( fvm_n1->global_offset() + node_n_offset );
+            iy.push_back( n1_global_offset + node_n_offset );
             y.push_back ( 0.5*GBTBT1*truncated_partial_volume );
 
-            iy.push_back( fvm_n1->global_offset() + node_p_offset );
+            iy.push_back( n1_global_offset + node_p_offset );
             y.push_back ( 0.5*GBTBT1*truncated_partial_volume );
           }
 
-          if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+          if( n2_on_processor )
           {
             // continuity equation
-            iy.push_back( fvm_n2->global_offset() + node_n_offset );
+            iy.push_back( n2_global_offset + node_n_offset );
             y.push_back ( 0.5*GBTBT2*truncated_partial_volume );
 
-            iy.push_back( fvm_n2->global_offset() + node_p_offset );
+            iy.push_back( n2_global_offset + node_p_offset );
             y.push_back ( 0.5*GBTBT2*truncated_partial_volume );
           }
         }
@@ -763,24 +844,24 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
               case ModelSpecify::IIForce_EdotJ:
               Epn = std::max(E.dot(Jnv.unit(true)), 0.0);
               Epp = std::max(E.dot(Jpv.unit(true)), 0.0);
-              IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-              IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
               break;
               case ModelSpecify::EVector:
-              IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
               break;
               case ModelSpecify::ESide:
-              IIn = mt->gen->ElecGenRate(T,fabs(Ec2-Ec1)/e/length,Eg);
-              IIp = mt->gen->HoleGenRate(T,fabs(Ev2-Ev1)/e/length,Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,fabs(Ec2-Ec1)/e/length,Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,fabs(Ev2-Ev1)/e/length,Eg);
               break;
               case ModelSpecify::GradQf:
-              IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
               break;
               case ModelSpecify::TempII:
-              IIn = mt->gen->ElecGenRateEBM (Tn,T,Eg);
-              IIp = mt->gen->HoleGenRateEBM (Tp,T,Eg);
+              IIn = mt->gen->ElecGenRateEBM (ctx2, Tn,T,Eg);
+              IIp = mt->gen->HoleGenRateEBM (ctx2, Tp,T,Eg);
               break;
               default:
               {
@@ -791,52 +872,52 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
           GIIn = IIn * fabs(Jn)/e;
           GIIp = IIp * fabs(Jp)/e;
 
-          if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+          if( n1_on_processor )
           {
             // continuity equation
-            iy.push_back( fvm_n1->global_offset() + node_n_offset );
+            iy.push_back( n1_global_offset + node_n_offset );
             y.push_back ( (riin1*GIIn+riip1*GIIp)*truncated_partial_volume );
 
-            iy.push_back( fvm_n1->global_offset() + node_p_offset );
+            iy.push_back( n1_global_offset + node_p_offset );
             y.push_back ( (riin1*GIIn+riip1*GIIp)*truncated_partial_volume );
 
-            n1_data->ImpactIonization() += (riin1*GIIn+riip1*GIIp)*truncated_partial_volume/fvm_n1->volume();
+            node_ii.push_back( std::make_pair(n1_data, (riin1*GIIn+riip1*GIIp)*truncated_partial_volume/fvm_n1->volume()) );
 
             if (get_advanced_model()->enable_Tn())
             {
               Hn = - (Eg+1.5*kb*Tp) * riin1*GIIn + 1.5*kb*Tn * riip1*GIIp;
-              iy.push_back(fvm_n1->global_offset()+node_Tn_offset);
+              iy.push_back(n1_global_offset+node_Tn_offset);
               y.push_back( Hn*truncated_partial_volume );
             }
             if (get_advanced_model()->enable_Tp())
             {
               Hp = - (Eg+1.5*kb*Tn) * riip1*GIIp + 1.5*kb*Tp * riin1*GIIn;
-              iy.push_back(fvm_n1->global_offset()+node_Tp_offset);
+              iy.push_back(n1_global_offset+node_Tp_offset);
               y.push_back( Hp*truncated_partial_volume );
             }
           }
 
-          if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+          if( n2_on_processor )
           {
             // continuity equation
-            iy.push_back( fvm_n2->global_offset() + node_n_offset );
+            iy.push_back( n2_global_offset + node_n_offset );
             y.push_back ( (riin2*GIIn+riip2*GIIp)*truncated_partial_volume );
 
-            iy.push_back( fvm_n2->global_offset() + node_p_offset );
+            iy.push_back( n2_global_offset + node_p_offset );
             y.push_back ( (riin2*GIIn+riip2*GIIp)*truncated_partial_volume );
 
-            n2_data->ImpactIonization() += (riin2*GIIn+riip2*GIIp)*truncated_partial_volume/fvm_n2->volume();
+            node_ii.push_back( std::make_pair(n2_data, (riin2*GIIn+riip2*GIIp)*truncated_partial_volume/fvm_n2->volume()) );
 
             if (get_advanced_model()->enable_Tn())
             {
               Hn = - (Eg+1.5*kb*Tp) * riin2*GIIn + 1.5*kb*Tn * riip2*GIIp;
-              iy.push_back(fvm_n2->global_offset()+node_Tn_offset);
+              iy.push_back(n2_global_offset+node_Tn_offset);
               y.push_back( Hn*truncated_partial_volume );
             }
             if (get_advanced_model()->enable_Tp())
             {
               Hp = - (Eg+1.5*kb*Tn) * riip2*GIIp + 1.5*kb*Tp * riin2*GIIn;
-              iy.push_back(fvm_n2->global_offset()+node_Tp_offset);
+              iy.push_back(n2_global_offset+node_Tp_offset);
               y.push_back( Hp*truncated_partial_volume );
             }
           }
@@ -850,15 +931,35 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
     elem_data->Jp() =  elem->reconstruct_vector(Jp_edge);
 
   }
+}
 
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
 
-  // process node related terms
-  // including \rho of poisson's equation and recombination term of continuation equation
-  const_processor_node_iterator node_it = on_processor_nodes_begin();
-  const_processor_node_iterator node_it_end = on_processor_nodes_end();
+/*---------------------------------------------------------------------
+ * node related terms of on processor nodes [begin, end)
+ */
+void SemiconductorSimulationRegion::EBM3_Function_Node(EBM3_Function_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  // find the node variable offset
+  unsigned int node_psi_offset = ebm_variable_offset(POTENTIAL);
+  unsigned int node_n_offset   = ebm_variable_offset(ELECTRON);
+  unsigned int node_p_offset   = ebm_variable_offset(HOLE);
+  unsigned int node_Tl_offset  = ebm_variable_offset(TEMPERATURE);
+  unsigned int node_Tn_offset  = ebm_variable_offset(E_TEMP);
+  unsigned int node_Tp_offset  = ebm_variable_offset(H_TEMP);
+
+  // set current and joule heating level
+  unsigned int Jn_level = get_advanced_model()->Jn_level();
+  unsigned int Jp_level = get_advanced_model()->Jp_level();
+  unsigned int Hn_level = get_advanced_model()->Hn_level();
+  unsigned int Hp_level = get_advanced_model()->Hp_level();
+
+  const PetscScalar * x = data.x;
+
+  std::vector<PetscInt>    & iy = data.node.index(thread);
+  std::vector<PetscScalar> & y  = data.node.value(thread);
+
+  const_processor_node_iterator node_it = on_processor_nodes_begin() + begin;
+  const_processor_node_iterator node_it_end = on_processor_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     const FVM_Node * fvm_node = *node_it;
@@ -885,7 +986,7 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
       Tp = x[fvm_node->local_offset() + node_Tp_offset]/p;
 
     // map this node and its data to material database
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     // the charge density
     PetscScalar rho = e*(node_data->Net_doping() + p - n)*fvm_node->volume();
@@ -893,10 +994,10 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
     y.push_back( rho );
 
     // the recombination term
-    PetscScalar R_SHR  = mt->band->R_SHR(p,n,T);
-    PetscScalar R_AUG_N = mt->band->R_Auger_N(p,n,T);
-    PetscScalar R_AUG_P = mt->band->R_Auger_P(p,n,T);
-    PetscScalar R_DIR  = mt->band->R_Direct(p,n,T);
+    PetscScalar R_SHR  = mt->band->R_SHR(ctx, p,n,T);
+    PetscScalar R_AUG_N = mt->band->R_Auger_N(ctx, p,n,T);
+    PetscScalar R_AUG_P = mt->band->R_Auger_P(ctx, p,n,T);
+    PetscScalar R_DIR  = mt->band->R_Direct(ctx, p,n,T);
 
     PetscScalar R   = (R_SHR + R_AUG_N + R_AUG_P + R_DIR)*fvm_node->volume();
     // consider carrier generation
@@ -910,9 +1011,9 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
 
     // process heat consume due to R/G and collision
     PetscScalar H=0, Hn=0, Hp=0;
-    PetscScalar Eg = mt->band->Eg(T);
-    PetscScalar tao_en = mt->band->ElecEnergyRelaxTime(Tn, T);
-    PetscScalar tao_ep = mt->band->HoleEnergyRelaxTime(Tp, T);
+    PetscScalar Eg = mt->band->Eg(ctx, T);
+    PetscScalar tao_en = mt->band->ElecEnergyRelaxTime(ctx, Tn, T);
+    PetscScalar tao_ep = mt->band->HoleEnergyRelaxTime(ctx, Tp, T);
 
     // lattice temperature if required
     if(get_advanced_model()->enable_Tl())
@@ -957,11 +1058,11 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
       // consider charge trapping in semiconductor bulk (bulk_flag=true)
 
       // call the Trap MPI to calculate trap occupancy using the local carrier densities and lattice temperature
-      PetscScalar ni = mt->band->nie(p, n, T);
-      mt->trap->Calculate(true,p,n,ni,T);
+      PetscScalar ni = mt->band->nie(ctx, p, n, T);
+      mt->trap->Calculate(ctx, true,p,n,ni,T);
 
       // calculate the contribution of trapped charge to Poisson's equation
-      PetscScalar TrappedC = mt->trap->Charge(true);
+      PetscScalar TrappedC = mt->trap->Charge(ctx, true);
       if (TrappedC !=0)
       {
         iy.push_back(fvm_node->global_offset()+node_psi_offset);
@@ -969,8 +1070,8 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
       }
 
       // calculate the rates of electron and hole capture
-      PetscScalar TrapElec = mt->trap->ElectronTrapRate(true,n,ni,T);
-      PetscScalar TrapHole = mt->trap->HoleTrapRate    (true,p,ni,T);
+      PetscScalar TrapElec = mt->trap->ElectronTrapRate(ctx, true,n,ni,T);
+      PetscScalar TrapHole = mt->trap->HoleTrapRate    (ctx, true,p,ni,T);
 
       iy.push_back(fvm_node->global_offset()+node_n_offset);
       iy.push_back(fvm_node->global_offset()+node_p_offset);
@@ -995,26 +1096,12 @@ void SemiconductorSimulationRegion::EBM3_Function(PetscScalar * x, Vec f, Insert
       {
         PetscScalar EcEi = 0.5*Eg - kb*T*log(node_data->Nc()/node_data->Nv());
         PetscScalar EiEv = 0.5*Eg + kb*T*log(node_data->Nc()/node_data->Nv());
-        H = mt->trap->TrapHeat(true,p,n,ni,Tp,Tn,T,EcEi,EiEv);
+        H = mt->trap->TrapHeat(ctx, true,p,n,ni,Tp,Tn,T,EcEi,EiEv);
         iy.push_back(fvm_node->global_offset()+node_Tl_offset);
         y.push_back( H*fvm_node->volume() );
       }
     }
   }
-
-
-  // add into petsc vector, we should prevent zero length vector add here.
-  if(iy.size())  VecSetValues(f, iy.size(), &iy[0], &y[0], ADD_VALUES);
-
-  // after the first scan, every nodes are updated.
-  // however, boundary condition should be processed later.
-
-  // the last operator is ADD_VALUES
-  add_value_flag = ADD_VALUES;
-
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
 }
 
 
@@ -1052,7 +1139,7 @@ void SemiconductorSimulationRegion::EBM3_Time_Dependent_Function(PetscScalar * x
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     // process \partial t
 
@@ -1080,7 +1167,7 @@ void SemiconductorSimulationRegion::EBM3_Time_Dependent_Function(PetscScalar * x
       if(get_advanced_model()->enable_Tl())
       {
         PetscScalar Tl           =  x[fvm_node->local_offset()+node_Tl_offset];
-        PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(Tl);
+        PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(ctx, Tl);
 
         PetscScalar dTldt_BDF2   = -((2-r)/(1-r)*Tl - 1.0/(r*(1-r))*node_data->T() + (1-r)/r*node_data->T_last())*node_data->density()*HeatCapacity
                                    / (SolverSpecify::dt_last+SolverSpecify::dt) * fvm_node->volume();
@@ -1132,7 +1219,7 @@ void SemiconductorSimulationRegion::EBM3_Time_Dependent_Function(PetscScalar * x
       if(get_advanced_model()->enable_Tl())
       {
         PetscScalar Tl           =  x[fvm_node->local_offset()+node_Tl_offset];
-        PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(Tl);
+        PetscScalar HeatCapacity =  mt->thermal->HeatCapacity(ctx, Tl);
         PetscScalar dTldt_BDF1   = -(Tl - node_data->T())*node_data->density()*HeatCapacity/SolverSpecify::dt*fvm_node->volume();
         iy.push_back(fvm_node->global_offset()+node_Tl_offset);
         y.push_back( dTldt_BDF1 );
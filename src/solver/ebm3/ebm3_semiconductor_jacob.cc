@@ -25,6 +25,8 @@
 #include "semiconductor_region.h"
 #include "solver_specify.h"
 #include "log.h"
+#include "thread_pool.h"
+#include "fvm_thread_assembly.h"
 
 #include "jflux1.h"
 #include "jflux2.h"
@@ -39,11 +41,75 @@ using PhysicalUnit::um;
 using PhysicalUnit::cm;
 
 
+/*---------------------------------------------------------------------
+ * data shared by the threads of EBM3_Jacobian
+ */
+struct SemiconductorSimulationRegion::EBM3_Jacobian_Data
+{
+  EBM3_Jacobian_Data(SparseMatrix<PetscScalar> *jac)
+    : jac(jac)
+  {}
+
+  /// local solution vector
+  PetscScalar *   x;
+  /// highfield mobility is used
+  bool            highfield_mob;
+
+  /// jacobian matrix of each thread
+  FVM_ThreadJacobian  jac;
+};
+
+
 /*---------------------------------------------------------------------
  * build function and its jacobian for EBM3 solver
  * AD is fully used here
  */
 void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar> *jac, InsertMode &add_value_flag)
+{
+  EBM3_Jacobian_Data data(jac);
+
+  data.x             = x;
+  data.highfield_mob = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
+
+  // search all the element in this region.
+  // note, they are all local element, thus must be processed
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, EBM3_Jacobian_Data>
+        cell_loop(this, &SemiconductorSimulationRegion::EBM3_Jacobian_Cell, data);
+    Genius::parallel_for(n_cell(), cell_loop);
+  }
+
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+
+  // process node related terms
+  // including \rho of poisson's equation, recombination term of continuation equation and heat consume due to R/G and collision
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, EBM3_Jacobian_Data>
+        node_loop(this, &SemiconductorSimulationRegion::EBM3_Jacobian_Node, data);
+    Genius::parallel_for(n_on_processor_node(), node_loop);
+  }
+
+  // write thread buffers into jacobian matrix
+  data.jac.flush();
+
+  // boundary condition should be processed later!
+
+  // the last operator is ADD_VALUES
+  add_value_flag = ADD_VALUES;
+
+#if defined(HAVE_FENV_H) && defined(DEBUG)
+  genius_assert( !fetestexcept(FE_INVALID) );
+#endif
+
+}
+
+
+/*---------------------------------------------------------------------
+ * "cell" related terms of elements [begin, end), AD version
+ */
+void SemiconductorSimulationRegion::EBM3_Jacobian_Cell(EBM3_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
 {
   // find the node variable offset
   unsigned int n_node_var      = ebm_n_variables();
@@ -60,14 +126,15 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
   unsigned int Hn_level = get_advanced_model()->Hn_level();
   unsigned int Hp_level = get_advanced_model()->Hp_level();
 
-  bool  highfield_mob   = highfield_mobility() && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM;
+  const PetscScalar * x = data.x;
+  const bool  highfield_mob = data.highfield_mob;
+  SparseMatrix<PetscScalar> * jac = data.jac[thread];
 
-  // search all the element in this region.
-  // note, they are all local element, thus must be processed
+  const FVM_EdgeTable & edge_table = this->edge_table();
 
-  const_element_iterator it = elements_begin();
-  const_element_iterator it_end = elements_end();
-  for(; it!=it_end; ++it)
+  const_element_iterator it = elements_begin() + begin;
+  const_element_iterator it_end = elements_begin() + end;
+  for(unsigned int nelem=begin; it!=it_end; ++it, ++nelem)
   {
     const Elem * elem = *it;
     bool insulator_interface_elem = is_elem_on_insulator_interface(elem);
@@ -209,10 +276,10 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
         VectorValue<AutoDScalar> norm(_norm(0), _norm(1), _norm(2));
 
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         AutoDScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         AutoDScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -267,8 +334,11 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
       std::pair<unsigned int, unsigned int> edge_nodes;
       elem->nodes_on_edge(ne, edge_nodes);
 
+      const unsigned int slot = edge_table.elem_slot(nelem, ne);
+      const unsigned int edge_index = edge_table.elem_edge[slot];
+
       // the length of this edge
-      const double length = elem->edge_length(ne);
+      const double length = edge_table.length[edge_index];
 
       // fvm_node of node1
       const FVM_Node * fvm_n1 = elem->get_fvm_node(edge_nodes.first);
@@ -280,31 +350,36 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
       // fvm_node_data of node2
       const FVM_NodeData * n2_data =  fvm_n2->node_data() ;   genius_assert(n2_data);
 
-      double partial_area = elem->partial_area_with_edge(ne);        // partial area associated with this edge
-      double partial_volume = elem->partial_volume_with_edge(ne);    // partial volume associated with this edge
+      double partial_area = edge_table.partial_area[slot];        // partial area associated with this edge
+      double partial_volume = edge_table.partial_volume[slot];    // partial volume associated with this edge
       double truncated_partial_area =  partial_area;
       double truncated_partial_volume =  partial_volume;
       if(truncation)
       {
         // use truncated partial area to avoid negative area due to bad mesh elem
-        truncated_partial_area =  this->truncated_partial_area(elem, ne);
-        truncated_partial_volume =  elem->partial_volume_with_edge_truncated(ne);
+        truncated_partial_area =  edge_table.truncated_partial_area[slot];
+        truncated_partial_volume =  edge_table.truncated_partial_volume[slot];
       }
 
-      unsigned int n1_local_offset = fvm_n1->local_offset();
-      unsigned int n2_local_offset = fvm_n2->local_offset();
+      bool inverse = edge_table.elem_edge_inverse[slot];       // find the correct order
+      const unsigned int n1_local_offset = inverse ? edge_table.n2_local_offset[edge_index] : edge_table.n1_local_offset[edge_index];
+      const unsigned int n2_local_offset = inverse ? edge_table.n1_local_offset[edge_index] : edge_table.n2_local_offset[edge_index];
+      const unsigned int n1_global_offset = inverse ? edge_table.n2_global_offset[edge_index] : edge_table.n1_global_offset[edge_index];
+      const unsigned int n2_global_offset = inverse ? edge_table.n1_global_offset[edge_index] : edge_table.n2_global_offset[edge_index];
+      const bool n1_on_processor = inverse ? edge_table.n2_on_processor[edge_index] : edge_table.n1_on_processor[edge_index];
+      const bool n2_on_processor = inverse ? edge_table.n1_on_processor[edge_index] : edge_table.n2_on_processor[edge_index];
 
       // the row position of variables in the matrix
       std::vector<PetscInt> row1, row2;
-      for(unsigned int nv=0; nv<n_node_var; ++nv)  row1.push_back( fvm_n1->global_offset()+nv );
-      for(unsigned int nv=0; nv<n_node_var; ++nv)  row2.push_back( fvm_n2->global_offset()+nv );
+      for(unsigned int nv=0; nv<n_node_var; ++nv)  row1.push_back( n1_global_offset+nv );
+      for(unsigned int nv=0; nv<n_node_var; ++nv)  row2.push_back( n2_global_offset+nv );
 
 
       // here we use AD again. Can we hand write it for more efficient?
       {
 
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         AutoDScalar V1 = x[n1_local_offset + node_psi_offset];
         V1.setADValue(n_node_var*edge_nodes.first + node_psi_offset, 1.0);   // electrostatic potential
@@ -342,20 +417,20 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
           Tp1 = p1Tp1/p1;
         }
 
-        AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(p1, n1, T1) + kb*T1*log(n1_data->Nc()));//conduct band energy level
-        AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(p1, n1, T1) - kb*T1*log(n1_data->Nv()) + mt->band->Eg(T1));//valence band energy level
+        AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() - n1_data->dEcStrain() + mt->band->EgNarrowToEc(ctx1, p1, n1, T1) + kb*T1*log(n1_data->Nc()));//conduct band energy level
+        AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - n1_data->dEvStrain() - mt->band->EgNarrowToEv(ctx1, p1, n1, T1) - kb*T1*log(n1_data->Nv()) + mt->band->Eg(ctx1, T1));//valence band energy level
         if(get_advanced_model()->Fermi)
         {
           Ec1 = Ec1 - kb*T1*log(gamma_f(fabs(n1)/n1_data->Nc()));
           Ev1 = Ev1 + kb*T1*log(gamma_f(fabs(p1)/n1_data->Nv()));
         }
         PetscScalar eps1 =  n1_data->eps();                        // eps
-        AutoDScalar kap1 =  mt->thermal->HeatConduction(T1);
-        AutoDScalar Eg1= mt->band->Eg(T1);
+        AutoDScalar kap1 =  mt->thermal->HeatConduction(ctx1, T1);
+        AutoDScalar Eg1= mt->band->Eg(ctx1, T1);
 
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         AutoDScalar V2   =  x[n2_local_offset + node_psi_offset];
         V2.setADValue(n_node_var*edge_nodes.second + node_psi_offset, 1.0);   // electrostatic potential
@@ -393,16 +468,16 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
           Tp2 = p2Tp2/p2;
         }
 
-        AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(p2, n2, T2) + kb*T2*log(n2_data->Nc()));//conduct band energy level
-        AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(p2, n2, T2) - kb*T2*log(n2_data->Nv()) + mt->band->Eg(T2));//valence band energy level
+        AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() - n2_data->dEcStrain() + mt->band->EgNarrowToEc(ctx2, p2, n2, T2) + kb*T2*log(n2_data->Nc()));//conduct band energy level
+        AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - n2_data->dEvStrain() - mt->band->EgNarrowToEv(ctx2, p2, n2, T2) - kb*T2*log(n2_data->Nv()) + mt->band->Eg(ctx2, T2));//valence band energy level
         if(get_advanced_model()->Fermi)
         {
           Ec2 = Ec2 - kb*T2*log(gamma_f(fabs(n2)/n2_data->Nc()));
           Ev2 = Ev2 + kb*T2*log(gamma_f(fabs(p2)/n2_data->Nv()));
         }
         PetscScalar eps2 =  n2_data->eps();                         // eps
-        AutoDScalar kap2 =  mt->thermal->HeatConduction(T2);
-        AutoDScalar Eg2= mt->band->Eg(T2);
+        AutoDScalar kap2 =  mt->thermal->HeatConduction(ctx2, T2);
+        AutoDScalar Eg2= mt->band->Eg(ctx2, T2);
 
 
         AutoDScalar mun1;   // electron mobility for node 1 of the edge
@@ -421,34 +496,28 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
             if(mos_channel_elem)
               Et = (E - (E*dir)*dir).size();
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Ep, Et, Tn1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Ep, Et, Tp1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Ep, Et, Tn1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Ep, Et, Tp1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Ep, Et, Tn2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Ep, Et, Tp2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Ep, Et, Tn2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Ep, Et, Tp2);
           }
           else // ModelSpecify::EJ || ModelSpecify::EQF
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T1, Epn, Etn, Tn1);
-            mup1 = mt->mob->HoleMob(p1, n1, T1, Epp, Etp, Tp1);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, Epn, Etn, Tn1);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, Epp, Etp, Tp1);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T2, Epn, Etn, Tn2);
-            mup2 = mt->mob->HoleMob(p2, n2, T2, Epp, Etp, Tp2);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, Epn, Etn, Tn2);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, Epp, Etp, Tp2);
           }
         }
         else
         {
-          mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-          mun1 = mt->mob->ElecMob(p1, n1, T1, 0, 0, Tn1);
-          mup1 = mt->mob->HoleMob(p1, n1, T1, 0, 0, Tp1);
+          mun1 = mt->mob->ElecMob(ctx1, p1, n1, T1, 0, 0, Tn1);
+          mup1 = mt->mob->HoleMob(ctx1, p1, n1, T1, 0, 0, Tp1);
 
-          mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-          mun2 = mt->mob->ElecMob(p2, n2, T2, 0, 0, Tn2);
-          mup2 = mt->mob->HoleMob(p2, n2, T2, 0, 0, Tp2);
+          mun2 = mt->mob->ElecMob(ctx2, p2, n2, T2, 0, 0, Tn2);
+          mup2 = mt->mob->HoleMob(ctx2, p2, n2, T2, 0, 0, Tp2);
         }
 
         AutoDScalar mun = 0.5*(mun1+mun2);  // the electron mobility at the mid point of the edge, use linear interpolation
@@ -510,7 +579,7 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
 
 
         // ignore thoese ghost nodes (ghost nodes is local but with different processor_id())
-        if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+        if( n1_on_processor )
         {
 
           AutoDScalar poisson = ( eps*(V2 - V1)/length*partial_area );
@@ -547,7 +616,7 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
 
         }
 
-        if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+        if( n2_on_processor )
         {
 
           AutoDScalar poisson = ( eps*(V1 - V2)/length*partial_area );
@@ -585,10 +654,10 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
 
-          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(T1, E.size());
-          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(T2, E.size());
+          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T1, E.size());
+          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T2, E.size());
 
-          if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+          if( n1_on_processor )
           {
             // continuity equation
             AutoDScalar continuity = 0.5*GBTBT1*truncated_partial_volume;
@@ -596,7 +665,7 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
             jac->add_row(  row1[node_p_offset],  cell_col.size(),  &cell_col[0],  continuity.getADValue() );
           }
 
-          if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+          if( n2_on_processor )
           {
             // continuity equation
             AutoDScalar continuity = 0.5*GBTBT2*truncated_partial_volume;
@@ -632,24 +701,24 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
             case ModelSpecify::IIForce_EdotJ:
               Epn = adtl::fmax(E.dot(Jnv.unit(true)), 0.0);
               Epp = adtl::fmax(E.dot(Jpv.unit(true)), 0.0);
-              IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-              IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
               break;
             case ModelSpecify::EVector:
-              IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
               break;
             case ModelSpecify::ESide:
-              IIn = mt->gen->ElecGenRate(T,fabs(Ec2-Ec1)/e/length,Eg);
-              IIp = mt->gen->HoleGenRate(T,fabs(Ev2-Ev1)/e/length,Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,fabs(Ec2-Ec1)/e/length,Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,fabs(Ev2-Ev1)/e/length,Eg);
               break;
             case ModelSpecify::GradQf:
-              IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-              IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+              IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+              IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
               break;
             case ModelSpecify::TempII:
-              IIn = mt->gen->ElecGenRateEBM (Tn,T,Eg);
-              IIp = mt->gen->HoleGenRateEBM (Tp,T,Eg);
+              IIn = mt->gen->ElecGenRateEBM (ctx2, Tn,T,Eg);
+              IIp = mt->gen->HoleGenRateEBM (ctx2, Tp,T,Eg);
               break;
         default:
          {
@@ -660,7 +729,7 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
           GIIn = IIn * fabs(Jn)/e;
           GIIp = IIp * fabs(Jp)/e;
 
-          if( fvm_n1->root_node()->processor_id()==Genius::processor_id() )
+          if( n1_on_processor )
           {
             // continuity equation
             AutoDScalar electron_continuity = (riin1*GIIn+riip1*GIIp)*truncated_partial_volume ;
@@ -682,7 +751,7 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
             }
           }
 
-          if( fvm_n2->root_node()->processor_id()==Genius::processor_id() )
+          if( n2_on_processor )
           {
             // continuity equation of electron
             AutoDScalar electron_continuity = (riin2*GIIn+riip2*GIIp)*truncated_partial_volume ;
@@ -709,13 +778,31 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
     }// end of scan all edges of the cell
 
   }// end of scan all the cell
+}
 
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
 
-  // process node related terms
-  // including \rho of poisson's equation, recombination term of continuation equation and heat consume due to R/G and collision
+/*---------------------------------------------------------------------
+ * node related terms of on processor nodes [begin, end), AD version
+ */
+void SemiconductorSimulationRegion::EBM3_Jacobian_Node(EBM3_Jacobian_Data &data, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  // find the node variable offset
+  unsigned int n_node_var      = ebm_n_variables();
+  unsigned int node_psi_offset = ebm_variable_offset(POTENTIAL);
+  unsigned int node_n_offset   = ebm_variable_offset(ELECTRON);
+  unsigned int node_p_offset   = ebm_variable_offset(HOLE);
+  unsigned int node_Tl_offset  = ebm_variable_offset(TEMPERATURE);
+  unsigned int node_Tn_offset  = ebm_variable_offset(E_TEMP);
+  unsigned int node_Tp_offset  = ebm_variable_offset(H_TEMP);
+
+  // set current and joule heating level
+  unsigned int Jn_level = get_advanced_model()->Jn_level();
+  unsigned int Jp_level = get_advanced_model()->Jp_level();
+  unsigned int Hn_level = get_advanced_model()->Hn_level();
+  unsigned int Hp_level = get_advanced_model()->Hp_level();
+
+  const PetscScalar * x = data.x;
+  SparseMatrix<PetscScalar> * jac = data.jac[thread];
 
   //the indepedent variable number, n_node_var for each node
   adtl::AutoDScalar::numdir = n_node_var;
@@ -723,10 +810,8 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
   //synchronize with material database
   mt->set_ad_num(adtl::AutoDScalar::numdir);
 
-  // process node related terms
-  // including \rho of poisson's equation and recombination term of continuation equation
-  const_processor_node_iterator node_it = on_processor_nodes_begin();
-  const_processor_node_iterator node_it_end = on_processor_nodes_end();
+  const_processor_node_iterator node_it = on_processor_nodes_begin() + begin;
+  const_processor_node_iterator node_it_end = on_processor_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     const FVM_Node * fvm_node = *node_it;
@@ -773,17 +858,17 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
     }
 
     // map this node and its data to material database
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     // the charge density for poisson's equation
     AutoDScalar rho = e*(node_data->Net_doping() + p - n)*fvm_node->volume();
     jac->add_row(  index[node_psi_offset],  n_node_var,  &index[0],  rho.getADValue() );
 
     // the recombination term
-    AutoDScalar R_SHR  = mt->band->R_SHR(p,n,T);
-    AutoDScalar R_AUG_N  = mt->band->R_Auger_N(p,n,T);
-    AutoDScalar R_AUG_P  = mt->band->R_Auger_P(p,n,T);
-    AutoDScalar R_DIR  = mt->band->R_Direct(p,n,T);
+    AutoDScalar R_SHR  = mt->band->R_SHR(ctx, p,n,T);
+    AutoDScalar R_AUG_N  = mt->band->R_Auger_N(ctx, p,n,T);
+    AutoDScalar R_AUG_P  = mt->band->R_Auger_P(ctx, p,n,T);
+    AutoDScalar R_DIR  = mt->band->R_Direct(ctx, p,n,T);
     AutoDScalar R   = (R_SHR + R_AUG_N + R_AUG_P + R_DIR)*fvm_node->volume();
     AutoDScalar G   = 0;
     jac->add_row(  index[node_n_offset],  n_node_var,  &index[0],  (G-R).getADValue() );
@@ -792,9 +877,9 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
 
     // process heat consume due to R/G and collision
     AutoDScalar H=0, Hn=0, Hp=0;
-    AutoDScalar Eg = mt->band->Eg(T);
-    AutoDScalar tao_en = mt->band->ElecEnergyRelaxTime(Tn, T);
-    AutoDScalar tao_ep = mt->band->HoleEnergyRelaxTime(Tp, T);
+    AutoDScalar Eg = mt->band->Eg(ctx, T);
+    AutoDScalar tao_en = mt->band->ElecEnergyRelaxTime(ctx, Tn, T);
+    AutoDScalar tao_ep = mt->band->HoleEnergyRelaxTime(ctx, Tp, T);
 
     // lattice temperature if required
     if(get_advanced_model()->enable_Tl())
@@ -835,19 +920,19 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
       // consider charge trapping in semiconductor bulk (bulk_flag=true)
 
       // call the Trap MPI to calculate trap occupancy using the local carrier densities and lattice temperature
-      AutoDScalar ni = mt->band->nie(p, n, T);
-      mt->trap->Calculate(true,p,n,ni,T);
+      AutoDScalar ni = mt->band->nie(ctx, p, n, T);
+      mt->trap->Calculate(ctx, true,p,n,ni,T);
 
       // calculate the contribution of trapped charge to Poisson's equation
-      AutoDScalar TrappedC = mt->trap->ChargeAD(true);
+      AutoDScalar TrappedC = mt->trap->ChargeAD(ctx, true);
       if (TrappedC !=0)
       {
         jac->add_row(  index[node_psi_offset],  n_node_var,  &index[0],  (TrappedC*fvm_node->volume()).getADValue() );
       }
 
       // calculate the rates of electron and hole capture
-      AutoDScalar TrapElec = mt->trap->ElectronTrapRate(true,n,ni,T);
-      AutoDScalar TrapHole = mt->trap->HoleTrapRate    (true,p,ni,T);
+      AutoDScalar TrapElec = mt->trap->ElectronTrapRate(ctx, true,n,ni,T);
+      AutoDScalar TrapHole = mt->trap->HoleTrapRate    (ctx, true,p,ni,T);
 
       jac->add_row(  index[node_n_offset],  n_node_var,  &index[0],  (-TrapElec*fvm_node->volume()).getADValue() );
       jac->add_row(  index[node_p_offset],  n_node_var,  &index[0],  (-TrapHole*fvm_node->volume()).getADValue() );
@@ -868,23 +953,12 @@ void SemiconductorSimulationRegion::EBM3_Jacobian(PetscScalar * x, SparseMatrix<
       {
         AutoDScalar EcEi = 0.5*Eg - kb*T*log(node_data->Nc()/node_data->Nv());
         AutoDScalar EiEv = 0.5*Eg + kb*T*log(node_data->Nc()/node_data->Nv());
-        H = mt->trap->TrapHeat(true,p,n,ni,Tp,Tn,T,EcEi,EiEv);
+        H = mt->trap->TrapHeat(ctx, true,p,n,ni,Tp,Tn,T,EcEi,EiEv);
         jac->add_row(  index[node_Tl_offset],  n_node_var,  &index[0],  (H*fvm_node->volume()).getADValue() );
       }
     }
 
   }
-
-
-  // boundary condition should be processed later!
-
-  // the last operator is ADD_VALUES
-  add_value_flag = ADD_VALUES;
-
-#if defined(HAVE_FENV_H) && defined(DEBUG)
-  genius_assert( !fetestexcept(FE_INVALID) );
-#endif
-
 }
 
 
@@ -923,7 +997,7 @@ void SemiconductorSimulationRegion::EBM3_Time_Dependent_Jacobian(PetscScalar * x
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
 
     // process \partial t
 
@@ -949,7 +1023,7 @@ void SemiconductorSimulationRegion::EBM3_Time_Dependent_Jacobian(PetscScalar * x
       if(get_advanced_model()->enable_Tl())
       {
         AutoDScalar Tl           =  x[fvm_node->local_offset()+3];   Tl.setADValue(0, 1.0);              // lattice temperature
-        AutoDScalar HeatCapacity =  mt->thermal->HeatCapacity(Tl);
+        AutoDScalar HeatCapacity =  mt->thermal->HeatCapacity(ctx, Tl);
         AutoDScalar dTldt_BDF2   = -((2-r)/(1-r)*Tl - 1.0/(r*(1-r))*node_data->T() + (1-r)/r*node_data->T_last())*node_data->density()*HeatCapacity
                                    / (SolverSpecify::dt_last+SolverSpecify::dt) * fvm_node->volume();
         jac->add( fvm_node->global_offset()+node_Tl_offset,   fvm_node->global_offset()+node_Tl_offset,  dTldt_BDF2.getADValue(0) );
@@ -999,7 +1073,7 @@ void SemiconductorSimulationRegion::EBM3_Time_Dependent_Jacobian(PetscScalar * x
       if(get_advanced_model()->enable_Tl())
       {
         AutoDScalar Tl           =  x[fvm_node->local_offset()+3];   Tl.setADValue(0, 1.0);              // lattice temperature
-        AutoDScalar HeatCapacity =  mt->thermal->HeatCapacity(Tl);
+        AutoDScalar HeatCapacity =  mt->thermal->HeatCapacity(ctx, Tl);
         AutoDScalar dTldt_BDF1   = -(Tl - node_data->T())*node_data->density()*HeatCapacity/SolverSpecify::dt*fvm_node->volume();
         jac->add( fvm_node->global_offset()+node_Tl_offset,   fvm_node->global_offset()+node_Tl_offset,  dTldt_BDF1.getADValue(0) );
       }
@@ -1041,6 +1115,46 @@ void SemiconductorSimulationRegion::EBM3_Time_Dependent_Jacobian(PetscScalar * x
 
 
 void SemiconductorSimulationRegion::EBM3_Update_Solution(PetscScalar *lxx)
+{
+  // update node data of each local node
+  {
+    Genius::MemberThreadLoop<SemiconductorSimulationRegion, PetscScalar *>
+        node_loop(this, &SemiconductorSimulationRegion::EBM3_Update_Solution_Node, lxx);
+    Genius::parallel_for(on_local_nodes_end()-on_local_nodes_begin(), node_loop);
+  }
+
+  // addtional work: compute electrical field for all the cell.
+  // Since this value is only used for reference.
+  // It can be done simply by weighted average of cell's electrical field
+  for(unsigned int n=0; n<n_cell(); ++n)
+  {
+    const Elem * elem = this->get_region_elem(n);
+    FVM_CellData * elem_data = this->get_region_elem_data(n);
+
+    std::vector<PetscScalar> psi_vertex;
+
+    for(unsigned int nd=0; nd<elem->n_nodes(); ++nd)
+    {
+      const FVM_Node * fvm_node = elem->get_fvm_node(nd);
+      const FVM_NodeData * fvm_node_data = fvm_node->node_data();
+      psi_vertex.push_back  ( fvm_node_data->psi() );
+    }
+    // compute the gradient in the cell
+    elem_data->E()  = - elem->gradient(psi_vertex);  // E = - grad(psi)
+  }
+
+
+  // calculate mobility on node
+  Mob_Evaluation();
+
+
+}
+
+
+/*---------------------------------------------------------------------
+ * update node data of local nodes [begin, end)
+ */
+void SemiconductorSimulationRegion::EBM3_Update_Solution_Node(PetscScalar * &lxx, unsigned int , unsigned int begin, unsigned int end)
 {
   unsigned int node_psi_offset = ebm_variable_offset(POTENTIAL);
   unsigned int node_n_offset   = ebm_variable_offset(ELECTRON);
@@ -1049,9 +1163,8 @@ void SemiconductorSimulationRegion::EBM3_Update_Solution(PetscScalar *lxx)
   unsigned int node_Tn_offset  = ebm_variable_offset(E_TEMP);
   unsigned int node_Tp_offset  = ebm_variable_offset(H_TEMP);
 
-
-  local_node_iterator node_it = on_local_nodes_begin();
-  local_node_iterator node_it_end = on_local_nodes_end();
+  local_node_iterator node_it = on_local_nodes_begin() + begin;
+  local_node_iterator node_it_end = on_local_nodes_begin() + end;
   for(; node_it!=node_it_end; ++node_it)
   {
     FVM_Node * fvm_node = *node_it;
@@ -1086,10 +1199,10 @@ void SemiconductorSimulationRegion::EBM3_Update_Solution(PetscScalar *lxx)
 
 
     // update buffered parameters dependent on temperature
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
-    node_data->Eg() = mt->band->Eg(T) - mt->band->EgNarrow(p, n, T);
-    node_data->Ec() = -(e*V + node_data->affinity() + mt->band->EgNarrowToEc(p, n, T));
-    node_data->Ev() = -(e*V + node_data->affinity() - mt->band->EgNarrowToEv(p, n, T) + mt->band->Eg(T));
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
+    node_data->Eg() = mt->band->Eg(ctx, T) - mt->band->EgNarrow(ctx, p, n, T);
+    node_data->Ec() = -(e*V + node_data->affinity() + mt->band->EgNarrowToEc(ctx, p, n, T));
+    node_data->Ev() = -(e*V + node_data->affinity() - mt->band->EgNarrowToEv(ctx, p, n, T) + mt->band->Eg(ctx, T));
 
     if(get_advanced_model()->Fermi)
     {
@@ -1102,13 +1215,13 @@ void SemiconductorSimulationRegion::EBM3_Update_Solution(PetscScalar *lxx)
       node_data->qFp() = node_data->Ev() - log(fabs(p/node_data->Nv()))*kb*T;
     }
 
-    node_data->Nc() = mt->band->Nc(T);
-    node_data->Nv() = mt->band->Nv(T);
+    node_data->Nc() = mt->band->Nc(ctx, T);
+    node_data->Nv() = mt->band->Nv(ctx, T);
 
-    node_data->Recomb() = mt->band->Recomb(p, n, T);
-    node_data->Recomb_Dir() = mt->band->R_Direct(p, n, T);
-    node_data->Recomb_SRH() = mt->band->R_SHR(p, n, T);
-    node_data->Recomb_Auger() = mt->band->R_Auger(p, n, T);
+    node_data->Recomb() = mt->band->Recomb(ctx, p, n, T);
+    node_data->Recomb_Dir() = mt->band->R_Direct(ctx, p, n, T);
+    node_data->Recomb_SRH() = mt->band->R_SHR(ctx, p, n, T);
+    node_data->Recomb_Auger() = mt->band->R_Auger(ctx, p, n, T);
 
 
     // electron temperature if required
@@ -1129,36 +1242,9 @@ void SemiconductorSimulationRegion::EBM3_Update_Solution(PetscScalar *lxx)
     if (get_advanced_model()->Trap)
     {
       // update traps
-      mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);
-      mt->trap->Update(true, p, n, node_data->ni(), T_external());
-      mt->trap->Update(false, p, n, node_data->ni(), T_external());
+      mt->trap->Update(ctx, true, p, n, node_data->ni(), T_external());
+      mt->trap->Update(ctx, false, p, n, node_data->ni(), T_external());
     }
   }
-
-  // addtional work: compute electrical field for all the cell.
-  // Since this value is only used for reference.
-  // It can be done simply by weighted average of cell's electrical field
-  for(unsigned int n=0; n<n_cell(); ++n)
-  {
-    const Elem * elem = this->get_region_elem(n);
-    FVM_CellData * elem_data = this->get_region_elem_data(n);
-
-    std::vector<PetscScalar> psi_vertex;
-
-    for(unsigned int nd=0; nd<elem->n_nodes(); ++nd)
-    {
-      const FVM_Node * fvm_node = elem->get_fvm_node(nd);
-      const FVM_NodeData * fvm_node_data = fvm_node->node_data();
-      psi_vertex.push_back  ( fvm_node_data->psi() );
-    }
-    // compute the gradient in the cell
-    elem_data->E()  = - elem->gradient(psi_vertex);  // E = - grad(psi)
-  }
-
-
-  // calculate mobility on node
-  Mob_Evaluation();
-
-
 }
 
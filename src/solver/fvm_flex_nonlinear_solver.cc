@@ -21,10 +21,12 @@
 
 
 #include <numeric>
+#include <algorithm>
 #include <iomanip>
 
 #include "fvm_flex_nonlinear_solver.h"
 #include "parallel.h"
+#include "klu_solver.h"
 #include "petsc_matrix.h"
 
 #ifdef HAVE_SLEPC
@@ -66,6 +68,7 @@ extern "C"
     // convert void* to FVM_FlexNonlinearSolver*
     FVM_FlexNonlinearSolver * nonlinear_solver = (FVM_FlexNonlinearSolver *)ctx;
 
+    nonlinear_solver->jacobian_reuse_monitor(its, fnorm);
     nonlinear_solver->petsc_snes_convergence_test(its, xnorm, gnorm, fnorm, reason);
 
     return ierr;
@@ -84,6 +87,22 @@ extern "C"
     return ierr;
   }
 
+#if PETSC_VERSION_GE(3,5,0)
+  //---------------------------------------------------------------
+  // these functions are called by PETSc before and after each linear solve, for performance log
+  static PetscErrorCode __genius_petsc_ksp_pre_solve(KSP, Vec, Vec, void *)
+  {
+    START_LOG("KSPSolve()", "FVM_FlexNonlinearSolver");
+    return 0;
+  }
+
+  static PetscErrorCode __genius_petsc_ksp_post_solve(KSP, Vec, Vec, void *)
+  {
+    STOP_LOG("KSPSolve()", "FVM_FlexNonlinearSolver");
+    return 0;
+  }
+#endif
+
   //---------------------------------------------------------------
   // this function is called by PETSc to evaluate the residual at X
   static PetscErrorCode  __genius_petsc_snes_residual (SNES, Vec x, Vec f, void *ctx)
@@ -93,7 +112,7 @@ extern "C"
     // convert void* to FVM_FlexNonlinearSolver*
     FVM_FlexNonlinearSolver * nonlinear_solver = (FVM_FlexNonlinearSolver *)ctx;
 
-    nonlinear_solver->build_petsc_sens_residual(x, f);
+    nonlinear_solver->sens_residual(x, f);
 
     return ierr;
   }
@@ -111,10 +130,10 @@ extern "C"
     // convert void* to FVM_FlexNonlinearSolver*
     FVM_FlexNonlinearSolver * nonlinear_solver = (FVM_FlexNonlinearSolver *)ctx;
 #if PETSC_VERSION_GE(3,5,0)
-    nonlinear_solver->build_petsc_sens_jacobian(x, &jac, &pc);
+    nonlinear_solver->sens_jacobian(x, &jac, &pc);
 #else
-    nonlinear_solver->build_petsc_sens_jacobian(x, jac, pc);
-    *msflag = SAME_NONZERO_PATTERN;
+    // keep the old factorization when Jacobian is reused
+    *msflag = nonlinear_solver->sens_jacobian(x, jac, pc) ? SAME_PRECONDITIONER : SAME_NONZERO_PATTERN;
 #endif
 
 
@@ -170,7 +189,9 @@ extern "C"
  * constructor, setup context
  */
 FVM_FlexNonlinearSolver::FVM_FlexNonlinearSolver(SimulationSystem & system)
-: FVM_FlexPDESolver(system), jacobian_matrix_first_assemble(false), Jac(0)
+: FVM_FlexPDESolver(system), jacobian_matrix_first_assemble(false), Jac(0), _klu(0),
+  _fused_request(false), _fused_jacobian_pending(false), _fused_jacobian_ready(false),
+  _jacobian_valid(false), _jacobian_refresh(false), _jacobian_age(0), _jacobian_dt(0.0), _last_fnorm(0.0)
 {
 
 }
@@ -181,6 +202,38 @@ FVM_FlexNonlinearSolver::FVM_FlexNonlinearSolver(SimulationSystem & system)
  */
 void FVM_FlexNonlinearSolver::setup_nonlinear_data()
 {
+  // the block size of jacobian matrix is the largest node dofs of all the regions
+  node_block_size = 1;
+  if( SolverSpecify::JacobianBlock )
+  {
+    unsigned int bs = 1;
+    for(unsigned int n=0; n<_system.n_regions(); ++n)
+      bs = std::max(bs, this->node_dofs(_system.region(n)));
+
+    if( bs > 1 && block_matrix_supported() )
+      node_block_size = bs;
+    else if( bs > 1 )
+    {
+      MESSAGE<<"Warning: Block jacobian matrix is not supported by the linear solver or preconditioner, use AIJ instead."<<std::endl;
+      RECORD();
+    }
+  }
+
+  // fused assembly is only an optimization, tell the user when it is not used
+  if( SolverSpecify::FusedAssembly )
+  {
+    if( !support_fused_assembly() )
+    {
+      MESSAGE<<"Warning: Fused assembly is not supported by this solver or some regions, evaluate function and jacobian separately."<<std::endl;
+      RECORD();
+    }
+    else if( SolverSpecify::NSLagJacobian != 1 || SolverSpecify::JacobianReuse )
+    {
+      MESSAGE<<"Warning: Fused assembly is not used together with lagged or reused jacobian."<<std::endl;
+      RECORD();
+    }
+  }
+
   // map mesh to PETSC solver
   build_dof_map();
 
@@ -192,6 +245,10 @@ void FVM_FlexNonlinearSolver::setup_nonlinear_data()
   ierr = VecCreateMPI(PETSC_COMM_WORLD, n_local_dofs, n_global_dofs, &x); genius_assert(!ierr);
   ierr = VecCreateMPI(PETSC_COMM_WORLD, n_local_dofs, n_global_dofs, &f); genius_assert(!ierr);
   ierr = VecCreateMPI(PETSC_COMM_WORLD, n_local_dofs, n_global_dofs, &L); genius_assert(!ierr);
+  ierr = VecDuplicate(x, &_fused_x); genius_assert(!ierr);
+
+  // padding dofs are never touched by solvers, they should be zero
+  ierr = VecZeroEntries(x); genius_assert(!ierr);
 
   // set all the components of scale vector L to 1.0
   ierr = VecSet(L, 1.0); genius_assert(!ierr);
@@ -223,6 +280,15 @@ void FVM_FlexNonlinearSolver::setup_nonlinear_data()
 
   // create the jacobian matrix
   Jac = new PetscMatrix<PetscScalar>(n_global_dofs, n_global_dofs, n_local_dofs, n_local_dofs);
+  Jac->freeze_nonzero_pattern(SolverSpecify::JacobianFrozenPattern);
+  if( node_block_size > 1 )
+  {
+    dynamic_cast<PetscMatrix<PetscScalar> *>(Jac)->set_block_size(node_block_size);
+    MESSAGE<<"Jacobian matrix is stored in block format with block size "<<node_block_size
+           <<", "<<padding_dofs.size()<<" padding dofs."<<std::endl;
+    RECORD();
+  }
+  _jacobian_valid = false;
   J = dynamic_cast<PetscMatrix<PetscScalar> *>(Jac)->mat();
 
 
@@ -272,6 +338,12 @@ void FVM_FlexNonlinearSolver::setup_nonlinear_data()
   // set user defined ksy convergence criterion
   ierr = KSPSetConvergenceTest (ksp, __genius_petsc_ksp_convergence_test, this, PETSC_NULL); genius_assert(!ierr);
 
+#if PETSC_VERSION_GE(3,5,0)
+  // log the time of linear solver
+  ierr = KSPSetPreSolve (ksp, __genius_petsc_ksp_pre_solve, this); genius_assert(!ierr);
+  ierr = KSPSetPostSolve (ksp, __genius_petsc_ksp_post_solve, this); genius_assert(!ierr);
+#endif
+
 }
 
 
@@ -403,6 +475,7 @@ void FVM_FlexNonlinearSolver::clear_nonlinear_data()
   ierr = VecDestroy(PetscDestroyObject(x));                 genius_assert(!ierr);
   ierr = VecDestroy(PetscDestroyObject(f));                 genius_assert(!ierr);
   ierr = VecDestroy(PetscDestroyObject(L));                 genius_assert(!ierr);
+  ierr = VecDestroy(PetscDestroyObject(_fused_x));          genius_assert(!ierr);
   ierr = VecDestroy(PetscDestroyObject(lx));                genius_assert(!ierr);
   ierr = VecDestroy(PetscDestroyObject(lf));                genius_assert(!ierr);
   ierr = VecDestroy(PetscDestroyObject(ll));                genius_assert(!ierr);
@@ -412,6 +485,10 @@ void FVM_FlexNonlinearSolver::clear_nonlinear_data()
   ierr = MatDestroy(PetscDestroyObject(J));                 genius_assert(!ierr);
   ierr = SNESDestroy(PetscDestroyObject(snes));             genius_assert(!ierr);
 
+  // KLU solver is referenced by pc, free it after snes
+  delete _klu;
+  _klu = 0;
+
   // clear petsc options
   std::map<std::string, std::string>::const_iterator it = petsc_options.begin();
   for(; it != petsc_options.end(); ++it)
@@ -664,6 +741,21 @@ void FVM_FlexNonlinearSolver::set_petsc_linear_solver_type()
       MESSAGE<< "Using CHEBYSHEV linear solver..."<<std::endl;  RECORD();
       ierr = KSPSetType (ksp, "chebyshev");  genius_assert(!ierr); return;
 
+      case SolverSpecify::KLU:
+      if (Genius::n_processors()>1)
+      {
+        MESSAGE<< "Warning:  KLU can not be used in parallel, use BCGS instead!" << std::endl;
+        RECORD();
+        ierr = KSPSetType (ksp, (char*) KSPBCGSL);  genius_assert(!ierr);
+        ierr = PCSetType (pc, (char*) PCASM);       genius_assert(!ierr);
+        return;
+      }
+      MESSAGE<< "Using KLU linear solver..."<<std::endl;  RECORD();
+      ierr = KSPSetType (ksp, (char*) KSPPREONLY); genius_assert(!ierr);
+      if (!_klu) _klu = new KLUSolver;
+      _klu->attach(pc);
+      return;
+
       case SolverSpecify::LU:
       case SolverSpecify::UMFPACK:
       case SolverSpecify::SuperLU:
@@ -830,6 +922,62 @@ void FVM_FlexNonlinearSolver::set_petsc_linear_solver_type()
 
 
 
+bool FVM_FlexNonlinearSolver::block_matrix_supported() const
+{
+  switch (_linear_solver_type)
+  {
+      // these direct solvers only accept AIJ matrix
+      case SolverSpecify::UMFPACK:
+      case SolverSpecify::SuperLU:
+      case SolverSpecify::PASTIX:
+      case SolverSpecify::SuperLU_DIST:
+      return false;
+
+      // PETSc LU, MUMPS and KLU work on BAIJ, and no preconditioner is involved
+      case SolverSpecify::LU:
+      case SolverSpecify::MUMPS:
+      case SolverSpecify::KLU:
+      return true;
+
+      default: break;
+  }
+
+  switch (_preconditioner_type)
+  {
+      case SolverSpecify::ILU_PRECOND:
+      case SolverSpecify::BOOMERAMG_PRECOND:
+#ifdef PETSC_HAVE_LIBHYPRE
+      return false;
+#else
+      return true;
+#endif
+
+      case SolverSpecify::ILUT_PRECOND:
+#ifdef PETSC_HAVE_SUPERLU
+      return false;
+#else
+      return true;
+#endif
+
+      case SolverSpecify::PARMS_PRECOND:
+#ifdef PETSC_HAVE_PARMS
+      return false;
+#else
+      return true;
+#endif
+
+      case SolverSpecify::CHOLESKY_PRECOND:
+      case SolverSpecify::ICC_PRECOND:
+      case SolverSpecify::SOR_PRECOND:
+      case SolverSpecify::EISENSTAT_PRECOND:
+      return false;
+
+      default: return true;
+  }
+}
+
+
+
 void FVM_FlexNonlinearSolver::set_petsc_preconditioner_type()
 {
   int ierr = 0;
@@ -840,7 +988,8 @@ void FVM_FlexNonlinearSolver::set_petsc_preconditioner_type()
       _linear_solver_type == SolverSpecify::SuperLU ||
       _linear_solver_type == SolverSpecify::MUMPS   ||
       _linear_solver_type == SolverSpecify::PASTIX  ||
-      _linear_solver_type == SolverSpecify::SuperLU_DIST
+      _linear_solver_type == SolverSpecify::SuperLU_DIST ||
+      _linear_solver_type == SolverSpecify::KLU
      )
   {
     return;
@@ -1101,6 +1250,11 @@ void FVM_FlexNonlinearSolver::set_petsc_preconditioner_type()
       }
 
       case SolverSpecify::JACOBI_PRECOND:
+      // point block jacobi inverts the diagonal blocks of block matrix
+      if( node_block_size > 1 )
+      {
+        ierr = PCSetType (pc, (char*) PCPBJACOBI);  genius_assert(!ierr); return;
+      }
       ierr = PCSetType (pc, (char*) PCJACOBI);    genius_assert(!ierr); return;
 
       case SolverSpecify::BLOCK_JACOBI_PRECOND:
@@ -1156,7 +1310,9 @@ void FVM_FlexNonlinearSolver::snes_solve()
   START_LOG("sens_solve()", "FVM_FlexNonlinearSolver");
 
   // do snes solve
+  snes_solve_prepare();
   SNESSolve ( snes, PETSC_NULL, x );
+  snes_solve_finish();
 
   
   STOP_LOG("sens_solve()", "FVM_FlexNonlinearSolver");
@@ -1164,6 +1320,107 @@ void FVM_FlexNonlinearSolver::snes_solve()
 
 
 
+void FVM_FlexNonlinearSolver::sens_residual(Vec x, Vec r)
+{
+  // jacobian is lagged or reused, build it together with every residual is a waste
+  if( !SolverSpecify::FusedAssembly || SolverSpecify::NSLagJacobian != 1 || SolverSpecify::JacobianReuse || !support_fused_assembly() )
+  {
+    build_petsc_sens_residual(x, r);
+    return;
+  }
+
+  _fused_request = true;
+  build_petsc_sens_residual(x, r);
+  _fused_request = false;
+
+  // remember where the region part of jacobian is evaluated
+  VecCopy(x, _fused_x);
+  _fused_jacobian_pending = true;
+}
+
+
+
+bool FVM_FlexNonlinearSolver::sens_jacobian(Vec x, Mat *jac, Mat *pc)
+{
+  // keep the Jacobian as well as its factorization. since J is not touched,
+  // petsc will not rebuild the preconditioner
+  if( SolverSpecify::JacobianReuse && _jacobian_valid && !_jacobian_refresh &&
+      _jacobian_age < SolverSpecify::JacobianReuseMax &&
+      !(SolverSpecify::TimeDependent && SolverSpecify::dt != _jacobian_dt) )
+  {
+    _jacobian_age++;
+    return true;
+  }
+
+  // newton method always ask for the jacobian at the point of last residual,
+  // however, we should check it since line search may be involved
+  if(_fused_jacobian_pending)
+  {
+    PetscBool same;
+    VecEqual(x, _fused_x, &same);
+    _fused_jacobian_ready = (same == PETSC_TRUE);
+  }
+  _fused_jacobian_pending = false;
+
+  _jacobian_timer.start();
+  build_petsc_sens_jacobian(x, jac, pc);
+  // padding dofs of block matrix have unit diagonal, their residual is always zero
+  if( !padding_dofs.empty() )
+  {
+#if PETSC_VERSION_GE(3,2,0)
+    MatZeroRows(J, padding_dofs.size(), &padding_dofs[0], 1.0, PETSC_NULL, PETSC_NULL);
+#else
+    MatZeroRows(J, padding_dofs.size(), &padding_dofs[0], 1.0);
+#endif
+  }
+  _jacobian_timer.stopit();
+  _fused_jacobian_ready = false;
+
+  _jacobian_valid   = true;
+  _jacobian_refresh = false;
+  _jacobian_age     = 0;
+  _jacobian_dt      = SolverSpecify::dt;
+
+  return false;
+}
+
+
+
+void FVM_FlexNonlinearSolver::jacobian_reuse_monitor(PetscInt its, PetscReal fnorm)
+{
+  // Newton step with an old Jacobian does not reduce the residual fast enough
+  if( its > 0 && fnorm > SolverSpecify::JacobianReuseContraction*_last_fnorm )
+    _jacobian_refresh = true;
+  _last_fnorm = fnorm;
+}
+
+
+
+void FVM_FlexNonlinearSolver::snes_solve_prepare()
+{
+  _fused_request = false;
+  _fused_jacobian_pending = false;
+  _fused_jacobian_ready = false;
+}
+
+
+
+void FVM_FlexNonlinearSolver::snes_solve_finish()
+{
+  // the last residual evaluation (usually at the converged solution) left
+  // a partial jacobian in Jac, finish it since Jac is used after solve, i.e. IV trace
+  if(_fused_jacobian_pending)
+    sens_jacobian(_fused_x, &J, &J);
+
+  // do not start next solve with the Jacobian which failed
+  SNESConvergedReason reason;
+  SNESGetConvergedReason(snes, &reason);
+  if( reason < 0 )
+    _jacobian_refresh = true;
+}
+
+
+
 double FVM_FlexNonlinearSolver::condition_number_of_jacobian_matrix()
 {
 #ifdef HAVE_SLEPC
@@ -35,12 +35,18 @@
 void FVM_FlexPDESolver::build_dof_map()
 {
 #ifdef COGENDA_COMMERCIAL_PRODUCT
-    // for commercial version
+    // for commercial version, parallel dof map does not pad node dofs
+    node_block_size = 1;
+    padding_dofs.clear();
     set_parallel_dof_map();
 #else
     // for open source version
     set_serial_dof_map();
 #endif
+
+  // node offsets are known now, build flat edge table for flux kernels
+  for(unsigned int n=0; n<_system.n_regions(); ++n)
+    _system.region(n)->build_edge_table();
 }
 
 
@@ -45,6 +45,7 @@ void FVM_FlexPDESolver::set_serial_dof_map()
 
   // the local index of dof
   n_local_dofs = 0;
+  padding_dofs.clear();
 
   //search for all the regions to build the index of nodal dof
   for(unsigned int n=0; n<_system.n_regions(); ++n)
@@ -61,6 +62,13 @@ void FVM_FlexPDESolver::set_serial_dof_map()
       fvm_node->set_local_offset(n_local_dofs);
       fvm_node->set_global_offset(n_local_dofs);
       n_local_dofs += region_node_dofs;
+
+      // pad the node dofs to a full block for block matrix storage
+      if( region_node_dofs && node_block_size > region_node_dofs )
+      {
+        for(unsigned int i=region_node_dofs; i<node_block_size; ++i)
+          padding_dofs.push_back(n_local_dofs++);
+      }
     }
   }
 
@@ -116,8 +124,24 @@ void FVM_FlexPDESolver::set_serial_dof_map()
   }
 
   unsigned int n_extra_dofs = this->extra_dofs();
+
+  // the total dofs should be a multiple of block size, padding dofs are
+  // put before the extra dofs since extra dofs are always at the end
+  unsigned int n_tail_padding_dofs = 0;
+  if( node_block_size > 1 )
+  {
+    unsigned int n_tail_dofs = (n_global_bc_dofs + n_extra_dofs) % node_block_size;
+    if( n_tail_dofs ) n_tail_padding_dofs = node_block_size - n_tail_dofs;
+  }
+  for(unsigned int i=0; i<n_tail_padding_dofs; ++i)
+  {
+    padding_dofs.push_back(n_global_node_dofs + n_global_bc_dofs + i);
+    local_index_array.push_back(n_global_node_dofs + n_global_bc_dofs + i);
+    global_index_array.push_back(n_global_node_dofs + n_global_bc_dofs + i);
+  }
+
   // all the processor should know this value
-  n_global_dofs = n_global_node_dofs + n_global_bc_dofs + n_extra_dofs;
+  n_global_dofs = n_global_node_dofs + n_global_bc_dofs + n_tail_padding_dofs + n_extra_dofs;
   n_local_dofs  = n_global_dofs;
   for(unsigned int i=0; i<n_extra_dofs; ++i )
   {
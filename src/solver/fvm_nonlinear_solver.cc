@@ -25,6 +25,7 @@
 
 #include "fvm_nonlinear_solver.h"
 #include "parallel.h"
+#include "klu_solver.h"
 
 #ifdef HAVE_SLEPC
 #include "slepceps.h"
@@ -169,7 +170,7 @@ extern "C"
 /*------------------------------------------------------------------
  * constructor, setup context
  */
-FVM_NonlinearSolver::FVM_NonlinearSolver(SimulationSystem & system): FVM_PDESolver(system)
+FVM_NonlinearSolver::FVM_NonlinearSolver(SimulationSystem & system): FVM_PDESolver(system), _klu(0)
 {
 
 }
@@ -447,6 +448,10 @@ void FVM_NonlinearSolver::clear_nonlinear_data()
   ierr = MatDestroy(PetscDestroyObject(J));                 genius_assert(!ierr);
   ierr = SNESDestroy(PetscDestroyObject(snes));             genius_assert(!ierr);
 
+  // KLU solver is referenced by pc, free it after snes
+  delete _klu;
+  _klu = 0;
+
   // clear petsc options
   std::map<std::string, std::string>::const_iterator it = petsc_options.begin();
   for(; it != petsc_options.end(); ++it)
@@ -709,6 +714,21 @@ void FVM_NonlinearSolver::set_petsc_linear_solver_type()
       MESSAGE<< "Using CHEBYSHEV linear solver..."<<std::endl;  RECORD();
       ierr = KSPSetType (ksp, "chebyshev");  genius_assert(!ierr); return;
 
+      case SolverSpecify::KLU:
+      if (Genius::n_processors()>1)
+      {
+        MESSAGE<< "Warning:  KLU can not be used in parallel, use BCGS instead!" << std::endl;
+        RECORD();
+        ierr = KSPSetType (ksp, (char*) KSPBCGSL);  genius_assert(!ierr);
+        ierr = PCSetType (pc, (char*) PCASM);       genius_assert(!ierr);
+        return;
+      }
+      MESSAGE<< "Using KLU linear solver..."<<std::endl;  RECORD();
+      ierr = KSPSetType (ksp, (char*) KSPPREONLY); genius_assert(!ierr);
+      if (!_klu) _klu = new KLUSolver;
+      _klu->attach(pc);
+      return;
+
       case SolverSpecify::LU:
       case SolverSpecify::UMFPACK:
       case SolverSpecify::SuperLU:
@@ -885,7 +905,8 @@ void FVM_NonlinearSolver::set_petsc_preconditioner_type()
       _linear_solver_type == SolverSpecify::SuperLU ||
       _linear_solver_type == SolverSpecify::MUMPS   ||
       _linear_solver_type == SolverSpecify::PASTIX  ||
-      _linear_solver_type == SolverSpecify::SuperLU_DIST
+      _linear_solver_type == SolverSpecify::SuperLU_DIST ||
+      _linear_solver_type == SolverSpecify::KLU
      )
   {
     return;
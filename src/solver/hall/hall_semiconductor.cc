@@ -255,10 +255,10 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
         // stupid code... we can not dot point with VectorValue<PetscScalar> yet.
         VectorValue<PetscScalar> norm(_norm(0), _norm(1), _norm(2));
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         PetscScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         PetscScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -343,7 +343,7 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
       {
 
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         PetscScalar V1   =  x[n1_local_offset+0];                  // electrostatic potential
         PetscScalar n1   =  x[n1_local_offset+1];                  // electron density
@@ -355,8 +355,8 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
         // takes care of the change effective DOS.
         // Ec/Ev should not be used except when its difference between two nodes.
         // The same comment applies to Ec2/Ev2.
-        PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() + kb*T*log(mt->band->nie(p1, n1, T)));
-        PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - kb*T*log(mt->band->nie(p1, n1, T)));
+        PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() + kb*T*log(mt->band->nie(ctx1, p1, n1, T)));
+        PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - kb*T*log(mt->band->nie(ctx1, p1, n1, T)));
         if(get_advanced_model()->Fermi)
         {
           Ec1 = Ec1 - e*Vt*log(gamma_f(fabs(n1)/n1_data->Nc()));
@@ -364,18 +364,18 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
         }
 
         PetscScalar eps1 =  n1_data->eps();                        // eps
-        PetscScalar Eg1  = mt->band->Eg(T);
+        PetscScalar Eg1  = mt->band->Eg(ctx1, T);
 
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         PetscScalar V2   =  x[n2_local_offset+0];                   // electrostatic potential
         PetscScalar n2   =  x[n2_local_offset+1];                   // electron density
         PetscScalar p2   =  x[n2_local_offset+2];                   // hole density
 
-        PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() + kb*T*log(mt->band->nie(p2, n2, T)));
-        PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - kb*T*log(mt->band->nie(p2, n2, T)));
+        PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() + kb*T*log(mt->band->nie(ctx2, p2, n2, T)));
+        PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - kb*T*log(mt->band->nie(ctx2, p2, n2, T)));
         if(get_advanced_model()->Fermi)
         {
           Ec2 = Ec2 - e*Vt*log(gamma_f(fabs(n2)/n2_data->Nc()));
@@ -383,7 +383,7 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
         }
 
         PetscScalar eps2 =  n2_data->eps();                         // eps
-        PetscScalar Eg2  = mt->band->Eg(T);
+        PetscScalar Eg2  = mt->band->Eg(ctx2, T);
 
         PetscScalar mun1;  // electron mobility
         PetscScalar mup1;  // hole mobility
@@ -404,23 +404,19 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
               Et = (E - dir*(E*dir)).size();
             }
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Ep, Et, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Ep, Et, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Ep, Et, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Ep, Et, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Ep, Et, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Ep, Et, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Ep, Et, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Ep, Et, T);
           }
           else// ModelSpecify::EJ || ModelSpecify::EQF
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Etn, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Etp, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Etn, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Etp, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Etn, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Etp, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Etn, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Etp, T);
           }
         }
         else // low field mobility
@@ -487,8 +483,8 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
           VectorValue<PetscScalar> E   = - elem->gradient(psi_vertex);  // E = - grad(psi)
-          PetscScalar GBTBT1 = mt->band->BB_Tunneling(T, E.size());
-          PetscScalar GBTBT2 = mt->band->BB_Tunneling(T, E.size());
+          PetscScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T, E.size());
+          PetscScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T, E.size());
 
           if( fvm_n1->on_processor() )
           {
@@ -537,20 +533,20 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
           case ModelSpecify::IIForce_EdotJ:
             Epn = std::max(E.dot(Jnv.unit()), 0.0);
             Epp = std::max(E.dot(Jpv.unit()), 0.0);
-            IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-            IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
             break;
           case ModelSpecify::EVector:
-            IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
             break;
           case ModelSpecify::ESide:
-            IIn = mt->gen->ElecGenRate(T,fabs(Ec2-Ec1)/e/length,Eg);
-            IIp = mt->gen->HoleGenRate(T,fabs(Ev2-Ev1)/e/length,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,fabs(Ec2-Ec1)/e/length,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,fabs(Ev2-Ev1)/e/length,Eg);
             break;
           case ModelSpecify::GradQf:
-            IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
             break;
           default:
             {
@@ -598,8 +594,8 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
 
     // magnetic field deflection matrix
     TensorValue<PetscScalar> Mn,Mp;
-    build_magnetic_field_matrix(mun_cell*mt->mob->RH_ELEC(), B, Mn);
-    build_magnetic_field_matrix(mup_cell*mt->mob->RH_HOLE(), B, Mp);
+    build_magnetic_field_matrix(mun_cell*mt->mob->RH_ELEC(PMI_Context()), B, Mn);
+    build_magnetic_field_matrix(mup_cell*mt->mob->RH_HOLE(PMI_Context()), B, Mp);
 
     // current vector under magnetic field
     VectorValue<PetscScalar> Mvn = Mn*vn_cell;
@@ -630,24 +626,24 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
       FVM_NodeData * n1_data = fvm_n1->node_data();  assert(n1_data);            // fvm_node_data of node1
       FVM_NodeData * n2_data = fvm_n2->node_data();  assert(n2_data);            // fvm_node_data of node2
 
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+      const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
       PetscScalar V1   =  x[fvm_n1->local_offset()+0];                  // electrostatic potential
       PetscScalar n1   =  x[fvm_n1->local_offset()+1];                  // electron density
       PetscScalar p1   =  x[fvm_n1->local_offset()+2];                  // hole density
-      PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() + kb*T*log(mt->band->nie(p1, n1, T)));
-      PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - kb*T*log(mt->band->nie(p1, n1, T)));
+      PetscScalar Ec1 =  -(e*V1 + n1_data->affinity() + kb*T*log(mt->band->nie(ctx1, p1, n1, T)));
+      PetscScalar Ev1 =  -(e*V1 + n1_data->affinity() - kb*T*log(mt->band->nie(ctx1, p1, n1, T)));
       if(get_advanced_model()->Fermi)
       {
         Ec1 = Ec1 - e*Vt*log(gamma_f(fabs(n1)/n1_data->Nc()));
         Ev1 = Ev1 + e*Vt*log(gamma_f(fabs(p1)/n1_data->Nv()));
       }
 
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+      const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
       PetscScalar V2   =  x[fvm_n2->local_offset()+0];                   // electrostatic potential
       PetscScalar n2   =  x[fvm_n2->local_offset()+1];                   // electron density
       PetscScalar p2   =  x[fvm_n2->local_offset()+2];                   // hole density
-      PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() + kb*T*log(mt->band->nie(p2, n2, T)));
-      PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - kb*T*log(mt->band->nie(p2, n2, T)));
+      PetscScalar Ec2 =  -(e*V2 + n2_data->affinity() + kb*T*log(mt->band->nie(ctx2, p2, n2, T)));
+      PetscScalar Ev2 =  -(e*V2 + n2_data->affinity() - kb*T*log(mt->band->nie(ctx2, p2, n2, T)));
       if(get_advanced_model()->Fermi)
       {
         Ec2 = Ec2 - e*Vt*log(gamma_f(fabs(n2)/n2_data->Nc()));
@@ -662,11 +658,11 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
       {
         // continuity equation of electron
         iy.push_back( fvm_n1->global_offset()+1 );
-        y.push_back ( - (mun_cell*mt->mob->RH_ELEC())*B*dir.cross(nmid*Mvn)*truncated_partial_area );
+        y.push_back ( - (mun_cell*mt->mob->RH_ELEC(ctx2))*B*dir.cross(nmid*Mvn)*truncated_partial_area );
 
         // continuity equation of hole
         iy.push_back( fvm_n1->global_offset()+2 );
-        y.push_back ( - (mup_cell*mt->mob->RH_HOLE())*B*dir.cross(pmid*Mvp)*truncated_partial_area );
+        y.push_back ( - (mup_cell*mt->mob->RH_HOLE(ctx2))*B*dir.cross(pmid*Mvp)*truncated_partial_area );
       }
 
       // for node 2.
@@ -674,11 +670,11 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
       {
         // continuity equation of electron
         iy.push_back( fvm_n2->global_offset()+1);
-        y.push_back ( (mun_cell*mt->mob->RH_ELEC())*B*dir.cross(nmid*Mvn)*truncated_partial_area );
+        y.push_back ( (mun_cell*mt->mob->RH_ELEC(ctx2))*B*dir.cross(nmid*Mvn)*truncated_partial_area );
 
         // continuity equation of hole
         iy.push_back( fvm_n2->global_offset()+2);
-        y.push_back ( (mup_cell*mt->mob->RH_HOLE())*B*dir.cross(pmid*Mvp)*truncated_partial_area );
+        y.push_back ( (mup_cell*mt->mob->RH_HOLE(ctx2))*B*dir.cross(pmid*Mvp)*truncated_partial_area );
       }
     }
 
@@ -708,9 +704,9 @@ void SemiconductorSimulationRegion::HALL_Function(const VectorValue<PetscScalar>
     PetscScalar n   =  x[fvm_node->local_offset()+1];                         // electron density
     PetscScalar p   =  x[fvm_node->local_offset()+2];                         // hole density
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);      // map this node and its data to material database
 
-    PetscScalar R   = - mt->band->Recomb(p, n, T)*fvm_node->volume();         // the recombination term
+    PetscScalar R   = - mt->band->Recomb(ctx, p, n, T)*fvm_node->volume();         // the recombination term
     PetscScalar rho = e*(node_data->Net_doping() + p - n)*fvm_node->volume(); // the charge density
 
     // consider carrier generation
@@ -898,10 +894,10 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
         VectorValue<AutoDScalar> norm(_norm(0), _norm(1), _norm(2));
 
         // effective electric fields in vertical
-        PetscScalar ZETAN = mt->mob->ZETAN();
-        PetscScalar ETAN  = mt->mob->ETAN();
-        PetscScalar ZETAP = mt->mob->ZETAP();
-        PetscScalar ETAP  = mt->mob->ETAP();
+        PetscScalar ZETAN = mt->mob->ZETAN(PMI_Context());
+        PetscScalar ETAN  = mt->mob->ETAN(PMI_Context());
+        PetscScalar ZETAP = mt->mob->ZETAP(PMI_Context());
+        PetscScalar ETAP  = mt->mob->ETAP(PMI_Context());
         AutoDScalar E_eff_v_n = ZETAN*(E*norm) + ETAN*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         AutoDScalar E_eff_v_p = ZETAP*(E*norm) + ETAP*((region_insul->get_eps()/this->get_eps())*E_insul*norm-E*norm);
         // effective electric fields in parallel
@@ -996,32 +992,32 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
       // here we use AD again. Can we hand write it for more efficient?
       {
         //for node 1 of the edge
-        mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+        const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
         AutoDScalar V1   =  x[n1_local_offset+0];       V1.setADValue(3*edge_nodes[0]+0, 1.0);           // electrostatic potential
         AutoDScalar n1   =  x[n1_local_offset+1];       n1.setADValue(3*edge_nodes[0]+1, 1.0);           // electron density
         AutoDScalar p1   =  x[n1_local_offset+2];       p1.setADValue(3*edge_nodes[0]+2, 1.0);           // hole density
 
-        AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() + kb*T*log(mt->band->nie(p1, n1, T)) );
-        AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - kb*T*log(mt->band->nie(p1, n1, T)) );
+        AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() + kb*T*log(mt->band->nie(ctx1, p1, n1, T)) );
+        AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - kb*T*log(mt->band->nie(ctx1, p1, n1, T)) );
         if(get_advanced_model()->Fermi)
         {
           Ec1 = Ec1 - e*Vt*log(gamma_f(fabs(n1)/n1_data->Nc()));
           Ev1 = Ev1 + e*Vt*log(gamma_f(fabs(p1)/n1_data->Nv()));
         }
         PetscScalar eps1 =  n1_data->eps();                        // eps
-        PetscScalar Eg1  = mt->band->Eg(T);
+        PetscScalar Eg1  = mt->band->Eg(ctx1, T);
 
 
         //for node 2 of the edge
-        mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+        const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
         AutoDScalar V2   =  x[n2_local_offset+0];       V2.setADValue(3*edge_nodes[1]+0, 1.0);             // electrostatic potential
         AutoDScalar n2   =  x[n2_local_offset+1];       n2.setADValue(3*edge_nodes[1]+1, 1.0);             // electron density
         AutoDScalar p2   =  x[n2_local_offset+2];       p2.setADValue(3*edge_nodes[1]+2, 1.0);             // hole density
 
-        AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() + kb*T*log(mt->band->nie(p2, n2, T)) );
-        AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - kb*T*log(mt->band->nie(p2, n2, T)) );
+        AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() + kb*T*log(mt->band->nie(ctx2, p2, n2, T)) );
+        AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - kb*T*log(mt->band->nie(ctx2, p2, n2, T)) );
         if(get_advanced_model()->Fermi)
         {
           Ec2 = Ec2 - e*Vt*log(gamma_f(fabs(n2)/n2_data->Nc()));
@@ -1046,23 +1042,19 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
             if(mos_channel_elem)
               Et = (E - (E*dir)*dir).size();
 
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Ep, Et, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Ep, Et, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Ep, Et, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Ep, Et, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Ep, Et, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Ep, Et, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Ep, Et, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Ep, Et, T);
           }
           else // ModelSpecify::EJ || ModelSpecify::EQF
           {
-            mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
-            mun1 = mt->mob->ElecMob(p1, n1, T, Epn, Etn, T);
-            mup1 = mt->mob->HoleMob(p1, n1, T, Epp, Etp, T);
+            mun1 = mt->mob->ElecMob(ctx1, p1, n1, T, Epn, Etn, T);
+            mup1 = mt->mob->HoleMob(ctx1, p1, n1, T, Epp, Etp, T);
 
-            mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
-            mun2 = mt->mob->ElecMob(p2, n2, T, Epn, Etn, T);
-            mup2 = mt->mob->HoleMob(p2, n2, T, Epp, Etp, T);
+            mun2 = mt->mob->ElecMob(ctx2, p2, n2, T, Epn, Etn, T);
+            mup2 = mt->mob->HoleMob(ctx2, p2, n2, T, Epp, Etp, T);
           }
         }
         else // low field mobility
@@ -1079,7 +1071,7 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
 
 
         PetscScalar eps = 0.5*(eps1+eps2);
-        PetscScalar Eg2  = mt->band->Eg(T);
+        PetscScalar Eg2  = mt->band->Eg(ctx2, T);
 
         // S-G current along the edge
         AutoDScalar Jn =  mun*In_dd(Vt,(Ec2-Ec1)/e,n1,n2,length);
@@ -1122,8 +1114,8 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
         if (get_advanced_model()->BandBandTunneling && SolverSpecify::Type!=SolverSpecify::EQUILIBRIUM)
         {
           VectorValue<AutoDScalar> E   = - elem->gradient(psi_vertex);  // E = - grad(psi)
-          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(T, E.size());
-          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(T, E.size());
+          AutoDScalar GBTBT1 = mt->band->BB_Tunneling(ctx1, T, E.size());
+          AutoDScalar GBTBT2 = mt->band->BB_Tunneling(ctx2, T, E.size());
 
           if( fvm_n1->on_processor() )
           {
@@ -1171,20 +1163,20 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
           case ModelSpecify::IIForce_EdotJ:
             Epn = adtl::fmax(E.dot(Jnv.unit()), 0.0);
             Epp = adtl::fmax(E.dot(Jpv.unit()), 0.0);
-            IIn = mt->gen->ElecGenRate(T,Epn,Eg);
-            IIp = mt->gen->HoleGenRate(T,Epp,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Epn,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Epp,Eg);
             break;
           case ModelSpecify::EVector:
-            IIn = mt->gen->ElecGenRate(T,E.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,E.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,E.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,E.size(),Eg);
             break;
           case ModelSpecify::ESide:
-            IIn = mt->gen->ElecGenRate(T,fabs(Ec2-Ec1)/e/length,Eg);
-            IIp = mt->gen->HoleGenRate(T,fabs(Ev2-Ev1)/e/length,Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,fabs(Ec2-Ec1)/e/length,Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,fabs(Ev2-Ev1)/e/length,Eg);
             break;
           case ModelSpecify::GradQf:
-            IIn = mt->gen->ElecGenRate(T,Jnv.size(),Eg);
-            IIp = mt->gen->HoleGenRate(T,Jpv.size(),Eg);
+            IIn = mt->gen->ElecGenRate(ctx2, T,Jnv.size(),Eg);
+            IIp = mt->gen->HoleGenRate(ctx2, T,Jpv.size(),Eg);
             break;
           default:
             {
@@ -1230,8 +1222,8 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
 
     // magnetic field deflection matrix
     TensorValue<AutoDScalar> Mn,Mp;
-    build_magnetic_field_matrix(mun_cell*mt->mob->RH_ELEC(), B, Mn);
-    build_magnetic_field_matrix(mup_cell*mt->mob->RH_HOLE(), B, Mp);
+    build_magnetic_field_matrix(mun_cell*mt->mob->RH_ELEC(PMI_Context()), B, Mn);
+    build_magnetic_field_matrix(mup_cell*mt->mob->RH_HOLE(PMI_Context()), B, Mp);
 
     // current vector under magnetic field
     VectorValue<AutoDScalar> Mvn = Mn*vn_cell;
@@ -1272,14 +1264,14 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
       for(unsigned int i=0; i<3; ++i) row.push_back( fvm_n2->global_offset()+i );
 
       //for node 1 of the edge
-      mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
+      const PMI_Context ctx1 = mt->mapping(fvm_n1->root_node(), n1_data, SolverSpecify::clock);
 
       AutoDScalar V1   =  x[n1_local_offset+0];       V1.setADValue(3*edge_nodes[0]+0, 1.0);           // electrostatic potential
       AutoDScalar n1   =  x[n1_local_offset+1];       n1.setADValue(3*edge_nodes[0]+1, 1.0);           // electron density
       AutoDScalar p1   =  x[n1_local_offset+2];       p1.setADValue(3*edge_nodes[0]+2, 1.0);           // hole density
 
-      AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() + kb*T*log(mt->band->nie(p1, n1, T)) );
-      AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - kb*T*log(mt->band->nie(p1, n1, T)) );
+      AutoDScalar Ec1 =  -(e*V1 + n1_data->affinity() + kb*T*log(mt->band->nie(ctx1, p1, n1, T)) );
+      AutoDScalar Ev1 =  -(e*V1 + n1_data->affinity() - kb*T*log(mt->band->nie(ctx1, p1, n1, T)) );
       if(get_advanced_model()->Fermi)
       {
         Ec1 = Ec1 - e*Vt*log(gamma_f(fabs(n1)/n1_data->Nc()));
@@ -1287,14 +1279,14 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
       }
 
       //for node 2 of the edge
-      mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
+      const PMI_Context ctx2 = mt->mapping(fvm_n2->root_node(), n2_data, SolverSpecify::clock);
 
       AutoDScalar V2   =  x[n2_local_offset+0];       V2.setADValue(3*edge_nodes[1]+0, 1.0);             // electrostatic potential
       AutoDScalar n2   =  x[n2_local_offset+1];       n2.setADValue(3*edge_nodes[1]+1, 1.0);             // electron density
       AutoDScalar p2   =  x[n2_local_offset+2];       p2.setADValue(3*edge_nodes[1]+2, 1.0);             // hole density
 
-      AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() + kb*T*log(mt->band->nie(p2, n2, T)) );
-      AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - kb*T*log(mt->band->nie(p2, n2, T)) );
+      AutoDScalar Ec2 =  -(e*V2 + n2_data->affinity() + kb*T*log(mt->band->nie(ctx2, p2, n2, T)) );
+      AutoDScalar Ev2 =  -(e*V2 + n2_data->affinity() - kb*T*log(mt->band->nie(ctx2, p2, n2, T)) );
       if(get_advanced_model()->Fermi)
       {
         Ec2 = Ec2 - e*Vt*log(gamma_f(fabs(n2)/n2_data->Nc()));
@@ -1307,8 +1299,8 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
       // ignore thoese ghost nodes (ghost nodes is local but with different processor_id())
       if( fvm_n1->on_processor() )
       {
-        AutoDScalar ff2 = - mun_cell*mt->mob->RH_ELEC()*dot(B, cross(dir, nmid*Mvn))*truncated_partial_area;
-        AutoDScalar ff3 = - mup_cell*mt->mob->RH_HOLE()*dot(B, cross(dir, pmid*Mvp))*truncated_partial_area;
+        AutoDScalar ff2 = - mun_cell*mt->mob->RH_ELEC(ctx2)*dot(B, cross(dir, nmid*Mvn))*truncated_partial_area;
+        AutoDScalar ff3 = - mup_cell*mt->mob->RH_HOLE(ctx2)*dot(B, cross(dir, pmid*Mvp))*truncated_partial_area;
         jac->add_row(  row[1],  cell_col.size(),  &cell_col[0],  ff2.getADValue() );
         jac->add_row(  row[2],  cell_col.size(),  &cell_col[0],  ff3.getADValue() );
       }
@@ -1316,8 +1308,8 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
       // for node 2.
       if( fvm_n2->on_processor() )
       {
-        AutoDScalar ff2 = mun_cell*mt->mob->RH_ELEC()*dot(B, cross(dir, nmid*Mvn))*truncated_partial_area;
-        AutoDScalar ff3 = mup_cell*mt->mob->RH_HOLE()*dot(B, cross(dir, pmid*Mvp))*truncated_partial_area;
+        AutoDScalar ff2 = mun_cell*mt->mob->RH_ELEC(ctx2)*dot(B, cross(dir, nmid*Mvn))*truncated_partial_area;
+        AutoDScalar ff3 = mup_cell*mt->mob->RH_HOLE(ctx2)*dot(B, cross(dir, pmid*Mvp))*truncated_partial_area;
         jac->add_row(  row[4],  cell_col.size(),  &cell_col[0],  ff2.getADValue() );
         jac->add_row(  row[5],  cell_col.size(),  &cell_col[0],  ff3.getADValue() );
       }
@@ -1354,9 +1346,9 @@ void SemiconductorSimulationRegion::HALL_Jacobian(const VectorValue<PetscScalar>
     AutoDScalar n   =  x[fvm_node->local_offset()+1];   n.setADValue(1, 1.0);              // electron density
     AutoDScalar p   =  x[fvm_node->local_offset()+2];   p.setADValue(2, 1.0);              // hole density
 
-    mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);                   // map this node and its data to material database
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, SolverSpecify::clock);                   // map this node and its data to material database
 
-    AutoDScalar R   = - mt->band->Recomb(p, n, T)*fvm_node->volume();                      // the recombination term
+    AutoDScalar R   = - mt->band->Recomb(ctx, p, n, T)*fvm_node->volume();                      // the recombination term
     AutoDScalar rho = e*(node_data->Net_doping() + p - n)*fvm_node->volume();              // the charge density
 
     // ADD to Jacobian matrix,
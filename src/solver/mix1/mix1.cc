@@ -738,6 +738,18 @@ void Mix1Solver::error_norm()
 
 
 
+/*------------------------------------------------------------------
+ * test if all the regions can build DDM1 function and jacobian in one pass
+ */
+bool Mix1Solver::support_fused_assembly() const
+{
+  for(unsigned int n=0; n<_system.n_regions(); n++)
+    if( !_system.region(n)->DDM1_Fused_Kernel() ) return false;
+  return true;
+}
+
+
+
 /*------------------------------------------------------------------
  * evaluate the residual of function f at x
  */
@@ -761,10 +773,23 @@ void Mix1Solver::build_petsc_sens_residual(Vec x, Vec r)
   InsertMode add_value_flag = NOT_SET_VALUES;
 
   // evaluate governing equations of DDML1 in all the regions
-  for(unsigned int n=0; n<_system.n_regions(); n++)
+  if(fused_assembly())
   {
-    SimulationRegion * region = _system.region(n);
-    region->DDM1_Function(lxx, r, add_value_flag);
+    // build region part of jacobian at the same time
+    Jac->zero();
+    for(unsigned int n=0; n<_system.n_regions(); n++)
+    {
+      SimulationRegion * region = _system.region(n);
+      region->DDM1_Function_Jacobian(lxx, r, Jac, add_value_flag);
+    }
+  }
+  else
+  {
+    for(unsigned int n=0; n<_system.n_regions(); n++)
+    {
+      SimulationRegion * region = _system.region(n);
+      region->DDM1_Function(lxx, r, add_value_flag);
+    }
   }
 
 #if defined(HAVE_FENV_H) && defined(DEBUG)
@@ -850,17 +875,22 @@ void Mix1Solver::build_petsc_sens_jacobian(Vec x, Mat *, Mat *)
   // get PetscScalar array contains solution from local solution vector lx
   VecGetArray(lx, &lxx);
 
-  Jac->zero();
-
   // flag for indicate ADD_VALUES operator.
   InsertMode add_value_flag = NOT_SET_VALUES;
 
   // evaluate Jacobian matrix of governing equations of DDML1 in all the regions
-  for(unsigned int n=0; n<_system.n_regions(); n++)
+  // region part of jacobian may be built by the last residual evaluation already
+  if(!fused_jacobian_ready())
   {
-    SimulationRegion * region = _system.region(n);
-    region->DDM1_Jacobian(lxx, Jac, add_value_flag);
+    Jac->zero();
+    for(unsigned int n=0; n<_system.n_regions(); n++)
+    {
+      SimulationRegion * region = _system.region(n);
+      region->DDM1_Jacobian(lxx, Jac, add_value_flag);
+    }
   }
+  else
+    add_value_flag = ADD_VALUES;
 
 #if defined(HAVE_FENV_H) && defined(DEBUG)
   genius_assert( !fetestexcept(FE_INVALID) );
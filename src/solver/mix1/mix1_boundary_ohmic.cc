@@ -183,18 +183,18 @@ void OhmicContactBC::Mix_DDM1_Function(PetscScalar * x, Vec f, InsertMode &add_v
             PetscScalar T = T_external();
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-            PetscScalar nie = semi_region->material()->band->nie(p, n, T);
-            PetscScalar Nc  = semi_region->material()->band->Nc(T);
-            PetscScalar Nv  = semi_region->material()->band->Nv(T);
-            PetscScalar Eg  = semi_region->material()->band->Eg(T);
+            PetscScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+            PetscScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+            PetscScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+            PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
 
             //governing equation for Ohmic contact boundary
             if(semi_region->get_advanced_model()->Fermi) //Fermi
             {
-              PetscScalar Ec =  -(e*V + node_data->affinity() + semi_region->material()->band->EgNarrowToEc(p, n, T) + kb*T*log(Nc));
-              PetscScalar Ev =  -(e*V + node_data->affinity() - semi_region->material()->band->EgNarrowToEv(p, n, T) - kb*T*log(Nv) + Eg);
+              PetscScalar Ec =  -(e*V + node_data->affinity() + semi_region->material()->band->EgNarrowToEc(ctx, p, n, T) + kb*T*log(Nc));
+              PetscScalar Ev =  -(e*V + node_data->affinity() - semi_region->material()->band->EgNarrowToEv(ctx, p, n, T) - kb*T*log(Nv) + Eg);
 
               // the quasi-fermi potential equals to electrode Vapp
               PetscScalar phin = Ve;
@@ -531,19 +531,19 @@ void OhmicContactBC::Mix_DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar
 
             PetscScalar T = T_external();
 
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-            AutoDScalar nie = semi_region->material()->band->nie(p, n, T);
-            PetscScalar Nc  = semi_region->material()->band->Nc(T);
-            PetscScalar Nv  = semi_region->material()->band->Nv(T);
-            PetscScalar Eg  = semi_region->material()->band->Eg(T);
+            AutoDScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+            PetscScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+            PetscScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+            PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
 
             //governing equation for Ohmic contact boundary
             AutoDScalar ff1,ff2,ff3;
             if(semi_region->get_advanced_model()->Fermi) //Fermi
             {
-              AutoDScalar Ec =  -(e*V + node_data->affinity() + semi_region->material()->band->EgNarrowToEc(p, n, T) + kb*T*log(Nc));
-              AutoDScalar Ev =  -(e*V + node_data->affinity() - semi_region->material()->band->EgNarrowToEv(p, n, T) - kb*T*log(Nv) + Eg);
+              AutoDScalar Ec =  -(e*V + node_data->affinity() + semi_region->material()->band->EgNarrowToEc(ctx, p, n, T) + kb*T*log(Nc));
+              AutoDScalar Ev =  -(e*V + node_data->affinity() - semi_region->material()->band->EgNarrowToEv(ctx, p, n, T) - kb*T*log(Nv) + Eg);
 
               // the quasi-fermi potential equals to electrode Vapp
               AutoDScalar phin = Ve;
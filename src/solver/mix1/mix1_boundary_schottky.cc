@@ -131,7 +131,7 @@ void SchottkyContactBC::Mix_DDM1_Function(PetscScalar * x, Vec f, InsertMode &ad
             const FVM_NodeData * node_data = fvm_nodes[i]->node_data();
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
             PetscScalar V = x[fvm_nodes[i]->local_offset()+0];  // psi of this node
             PetscScalar n = x[fvm_nodes[i]->local_offset()+1];  // electron density
@@ -139,11 +139,11 @@ void SchottkyContactBC::Mix_DDM1_Function(PetscScalar * x, Vec f, InsertMode &ad
             PetscScalar T = T_external();
 
             //Schotty Barrier Lowerring
-            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
             //Schottky current
             PetscScalar S  = fvm_nodes[i]->outside_boundary_surface_area();
-            PetscScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-            PetscScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+            PetscScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+            PetscScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
             PetscScalar ff = V + Work_Function - deltaVB - Ve;
 
@@ -360,7 +360,7 @@ void SchottkyContactBC::Mix_DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
             const FVM_NodeData * node_data = fvm_nodes[i]->node_data();
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
             //the indepedent variable number, we only need 4 here.
             adtl::AutoDScalar::numdir=4;
@@ -376,12 +376,12 @@ void SchottkyContactBC::Mix_DDM1_Jacobian(PetscScalar * x, SparseMatrix<PetscSca
             AutoDScalar Ve = x[this->local_offset()];             Ve.setADValue(3, 1.0);
 
             //Schotty Barrier Lowerring
-            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+            PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
 
             //Schottky current
             PetscScalar S  = fvm_nodes[i]->outside_boundary_surface_area();
-            AutoDScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-            AutoDScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+            AutoDScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+            AutoDScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
             // schottky boundary condition of poisson's equation
             AutoDScalar ff = V + Work_Function - deltaVB - Ve;
@@ -217,18 +217,18 @@ void OhmicContactBC::MixA_EBM3_Function(PetscScalar * x, Vec f, InsertMode &add_
               T = x[fvm_nodes[i]->local_offset() + node_Tl_offset];
 
             // mapping this node to material library
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-            PetscScalar nie = semi_region->material()->band->nie(p, n, T);
-            PetscScalar Nc  = semi_region->material()->band->Nc(T);
-            PetscScalar Nv  = semi_region->material()->band->Nv(T);
-            PetscScalar Eg  = semi_region->material()->band->Eg(T);
+            PetscScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+            PetscScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+            PetscScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+            PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
 
             //governing equation of psi/n/p for Ohmic contact boundary
             if(semi_region->get_advanced_model()->Fermi) //Fermi
             {
-              PetscScalar Ec =  -(e*V + node_data->affinity() + semi_region->material()->band->EgNarrowToEc(p, n, T) + kb*T*log(Nc));
-              PetscScalar Ev =  -(e*V + node_data->affinity() - semi_region->material()->band->EgNarrowToEv(p, n, T) - kb*T*log(Nv) + Eg);
+              PetscScalar Ec =  -(e*V + node_data->affinity() + semi_region->material()->band->EgNarrowToEc(ctx, p, n, T) + kb*T*log(Nc));
+              PetscScalar Ev =  -(e*V + node_data->affinity() - semi_region->material()->band->EgNarrowToEv(ctx, p, n, T) - kb*T*log(Nv) + Eg);
 
               // the quasi-fermi potential equals to electrode Vapp
               PetscScalar phin = Ve;
@@ -666,20 +666,20 @@ void OhmicContactBC::MixA_EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscScala
             col = row;
             col.push_back(this->global_offset()); // the position of electrode equation
 
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
-            AutoDScalar nie = semi_region->material()->band->nie(p, n, T);
-            AutoDScalar Nc  = semi_region->material()->band->Nc(T);
-            AutoDScalar Nv  = semi_region->material()->band->Nv(T);
-            AutoDScalar Eg  = semi_region->material()->band->Eg(T);
+            AutoDScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
+            AutoDScalar Nc  = semi_region->material()->band->Nc(ctx, T);
+            AutoDScalar Nv  = semi_region->material()->band->Nv(ctx, T);
+            AutoDScalar Eg  = semi_region->material()->band->Eg(ctx, T);
 
 
             //governing equation of pis/n/p for Ohmic contact boundary
             AutoDScalar ff1,ff2,ff3;
             if(semi_region->get_advanced_model()->Fermi) //Fermi
             {
-              AutoDScalar Ec =  -(e*V + node_data->affinity() + semi_region->material()->band->EgNarrowToEc(p, n, T) + kb*T*log(Nc));
-              AutoDScalar Ev =  -(e*V + node_data->affinity() - semi_region->material()->band->EgNarrowToEv(p, n, T) - kb*T*log(Nv) + Eg);
+              AutoDScalar Ec =  -(e*V + node_data->affinity() + semi_region->material()->band->EgNarrowToEc(ctx, p, n, T) + kb*T*log(Nc));
+              AutoDScalar Ev =  -(e*V + node_data->affinity() - semi_region->material()->band->EgNarrowToEv(ctx, p, n, T) - kb*T*log(Nv) + Eg);
 
               // the quasi-fermi potential equals to electrode Vapp
               AutoDScalar phin = Ve;
@@ -175,7 +175,7 @@ void SchottkyContactBC::MixA_EBM3_Function(PetscScalar * x, Vec f, InsertMode &a
           const FVM_NodeData * node_data = fvm_nodes[i]->node_data();
 
           // mapping this node to material library
-          semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+          const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
           PetscScalar V = x[fvm_nodes[i]->local_offset()+node_psi_offset];  // psi of this node
           PetscScalar n = x[fvm_nodes[i]->local_offset()+node_n_offset];  // electron density
@@ -188,11 +188,11 @@ void SchottkyContactBC::MixA_EBM3_Function(PetscScalar * x, Vec f, InsertMode &a
             T = x[fvm_nodes[i]->local_offset() + node_Tl_offset];
 
           //Schotty Barrier Lowerring
-          PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+          PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
           //Schottky current
           PetscScalar S  = fvm_nodes[i]->outside_boundary_surface_area();
-          PetscScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-          PetscScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+          PetscScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+          PetscScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
           PetscScalar ff = V + Work_Function - deltaVB - Ve;
 
@@ -479,7 +479,7 @@ void SchottkyContactBC::MixA_EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscSc
           const FVM_NodeData * node_data = fvm_nodes[i]->node_data();
 
           // mapping this node to material library
-          semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
+          const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, SolverSpecify::clock);
 
           //the indepedent variable number, we only need n_node_var+1 here.
           adtl::AutoDScalar::numdir=n_node_var+1;
@@ -521,12 +521,12 @@ void SchottkyContactBC::MixA_EBM3_Jacobian(PetscScalar * x, SparseMatrix<PetscSc
           AutoDScalar Ve = x[ckt->local_offset_x(spice_node_index)];             Ve.setADValue(n_node_var, 1.0);
 
           //Schotty Barrier Lowerring
-          PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(node_data->eps(), node_data->E().size());
+          PetscScalar deltaVB = semi_region->material()->band->SchottyBarrierLowerring(ctx, node_data->eps(), node_data->E().size());
 
           //Schottky current
           PetscScalar S  = fvm_nodes[i]->outside_boundary_surface_area();
-          AutoDScalar Fn = semi_region->material()->band->SchottyJsn(n, T, Work_Function - node_data->affinity() - deltaVB) * S;
-          AutoDScalar Fp = semi_region->material()->band->SchottyJsp(p, T, Work_Function - node_data->affinity() + deltaVB) * S;
+          AutoDScalar Fn = semi_region->material()->band->SchottyJsn(ctx, n, T, Work_Function - node_data->affinity() - deltaVB) * S;
+          AutoDScalar Fp = semi_region->material()->band->SchottyJsp(ctx, p, T, Work_Function - node_data->affinity() + deltaVB) * S;
 
           // schottky boundary condition of poisson's equation
           AutoDScalar ff = V + Work_Function - deltaVB - Ve;
@@ -182,12 +182,12 @@ void OhmicContactBC::Poissin_Function(PetscScalar * x, Vec f, InsertMode &add_va
             PetscScalar V = x[fvm_nodes[i]->local_offset()];
 
             PetscScalar T = T_external();
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, 0.0);
-            PetscScalar ni  = semi_region->material()->band->ni(T);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, 0.0);
+            PetscScalar ni  = semi_region->material()->band->ni(ctx, T);
 
             PetscScalar Nc  = node_data->Nc();
             PetscScalar Nv  = node_data->Nv();
-            PetscScalar Eg  = semi_region->material()->band->Eg(T);
+            PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
             // intrinsic Fermi potential.
             PetscScalar V_i =  V + node_data->affinity()/e + Eg/(2*e) + kb*T*log(Nc/Nv)/(2*e);
             // electron density
@@ -196,7 +196,7 @@ void OhmicContactBC::Poissin_Function(PetscScalar * x, Vec f, InsertMode &add_va
             PetscScalar p    =  ni*exp(-e/(kb*T)*V_i);
 
             // consider bandgap narrow
-            PetscScalar nie = semi_region->material()->band->nie(p, n, T);
+            PetscScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
 
             //governing equation for Ohmic contact boundary
             PetscScalar ff = V - kb*T/e*asinh(node_data->Net_doping()/(2*nie))
@@ -360,12 +360,12 @@ void OhmicContactBC::Poissin_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
             AutoDScalar V = x[fvm_nodes[i]->local_offset()]; V.setADValue(0,1.0);
 
             PetscScalar T = T_external();
-            semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, 0.0);
-            PetscScalar ni  = semi_region->material()->band->ni(T);
+            const PMI_Context ctx = semi_region->material()->mapping(fvm_nodes[i]->root_node(), node_data, 0.0);
+            PetscScalar ni  = semi_region->material()->band->ni(ctx, T);
 
             PetscScalar Nc  = node_data->Nc();
             PetscScalar Nv  = node_data->Nv();
-            PetscScalar Eg  = semi_region->material()->band->Eg(T);
+            PetscScalar Eg  = semi_region->material()->band->Eg(ctx, T);
 
             // intrinsic Fermi potential.
             AutoDScalar V_i =  V + node_data->affinity()/e + Eg/(2*e) + kb*T*log(Nc/Nv)/(2*e);
@@ -375,7 +375,7 @@ void OhmicContactBC::Poissin_Jacobian(PetscScalar * x, SparseMatrix<PetscScalar>
             AutoDScalar p    =  ni*exp(-e/(kb*T)*V_i);
 
             // consider bandgap narrow
-            AutoDScalar nie = semi_region->material()->band->nie(p, n, T);
+            AutoDScalar nie = semi_region->material()->band->nie(ctx, p, n, T);
 
             //governing equation for Ohmic contact boundary
             AutoDScalar ff = V - kb*T/e*asinh(node_data->Net_doping()/(2*nie))
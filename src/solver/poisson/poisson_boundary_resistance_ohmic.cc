@@ -178,8 +178,8 @@ void IF_Metal_OhmicBC::Poissin_Function ( PetscScalar * x, Vec f, InsertMode &ad
     // process semiconductor region
     {
       const SemiconductorSimulationRegion * semi_region = dynamic_cast<const SemiconductorSimulationRegion *>(_r1);
-      semi_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node_data, 0.0);
-      PetscScalar ni  = semi_region->material()->band->ni(T);
+      const PMI_Context ctx = semi_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node_data, 0.0);
+      PetscScalar ni  = semi_region->material()->band->ni(ctx, T);
 
       PetscScalar Nc  = semiconductor_node_data->Nc();
       PetscScalar Nv  = semiconductor_node_data->Nv();
@@ -302,8 +302,8 @@ void IF_Metal_OhmicBC::Poissin_Jacobian ( PetscScalar * x, SparseMatrix<PetscSca
     {
       AutoDScalar V_semiconductor  = x[semiconductor_node->local_offset() ]; V_semiconductor.setADValue (0, 1.0 );
       const SemiconductorSimulationRegion * semi_region = dynamic_cast<const SemiconductorSimulationRegion *>(_r1);
-      semi_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node_data, 0.0);
-      PetscScalar ni  = semi_region->material()->band->ni(T);
+      const PMI_Context ctx = semi_region->material()->mapping(semiconductor_node->root_node(), semiconductor_node_data, 0.0);
+      PetscScalar ni  = semi_region->material()->band->ni(ctx, T);
 
       PetscScalar Nc  = semiconductor_node_data->Nc();
       PetscScalar Nv  = semiconductor_node_data->Nv();
@@ -383,7 +383,7 @@ void IF_Metal_OhmicBC::Poissin_Update_Solution ( PetscScalar * lxx )
       FVM_NodeData * semiconductor_node_data = semiconductor_node->node_data();
 
       // mapping this node to material library
-      semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+      const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
       PetscScalar affinity = semiconductor_node_data->affinity();
       PetscScalar ni  = semiconductor_region->material()->band->ni ( T );
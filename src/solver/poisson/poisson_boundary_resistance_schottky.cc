@@ -312,12 +312,12 @@ void IF_Metal_SchottkyBC::Poissin_Update_Solution ( PetscScalar * lxx )
       FVM_NodeData * semiconductor_node_data = semiconductor_node->node_data();
 
       // mapping this node to material library
-      semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
+      const PMI_Context ctx = semiconductor_region->material()->mapping ( semiconductor_node->root_node(), semiconductor_node_data, SolverSpecify::clock );
 
-      PetscScalar ni  = semiconductor_region->material()->band->ni ( T );
-      PetscScalar Nc  = semiconductor_region->material()->band->Nc ( T );
-      PetscScalar Nv  = semiconductor_region->material()->band->Nv ( T );
-      PetscScalar Eg  = semiconductor_region->material()->band->Eg ( T );
+      PetscScalar ni  = semiconductor_region->material()->band->ni (ctx, T );
+      PetscScalar Nc  = semiconductor_region->material()->band->Nc (ctx, T );
+      PetscScalar Nv  = semiconductor_region->material()->band->Nv (ctx, T );
+      PetscScalar Eg  = semiconductor_region->material()->band->Eg (ctx, T );
 
       PetscScalar  electron_density;
       PetscScalar  hole_density;
@@ -348,7 +348,7 @@ void IF_Metal_SchottkyBC::Poissin_Update_Solution ( PetscScalar * lxx )
       semiconductor_node_data->p()   =  p;
 
       semiconductor_node_data->Ec() = - ( e*V + semiconductor_node_data->affinity() );
-      semiconductor_node_data->Ev() = - ( e*V + semiconductor_node_data->affinity() + semiconductor_region->material()->band->Eg ( T ) );
+      semiconductor_node_data->Ev() = - ( e*V + semiconductor_node_data->affinity() + semiconductor_region->material()->band->Eg (ctx, T ) );
     }
   }
 }
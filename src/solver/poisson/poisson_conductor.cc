@@ -86,10 +86,12 @@ void ElectrodeSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, InsertM
   iy.reserve(2*n_edge());
   y.reserve(2*n_edge());
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -101,8 +103,8 @@ void ElectrodeSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, InsertM
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       // electrostatic potential, as independent variable
@@ -116,18 +118,18 @@ void ElectrodeSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, InsertM
       PetscScalar eps = 0.5*(eps1+eps2);
 
       // "flux" from node 2 to node 1
-      PetscScalar f =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/fvm_n1->distance(fvm_n2) ;
+      PetscScalar f =  eps*edge_table.cv_area[nedge]*(V2 - V1)/edge_table.length[nedge] ;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
-        iy.push_back(fvm_n1->global_offset());
+        iy.push_back(edge_table.n1_global_offset[nedge]);
         y.push_back(f);
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
-        iy.push_back(fvm_n2->global_offset());
+        iy.push_back(edge_table.n2_global_offset[nedge]);
         y.push_back(-f);
       }
     }
@@ -157,10 +159,12 @@ void ElectrodeSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatrix<P
   mt->set_ad_num(adtl::AutoDScalar::numdir);
 
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -172,13 +176,13 @@ void ElectrodeSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatrix<P
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     // the row/colume position of variables in the matrix
     unsigned int row[2],col[2];
-    row[0] = col[0] = fvm_n1->global_offset();
-    row[1] = col[1] = fvm_n2->global_offset();
+    row[0] = col[0] = edge_table.n1_global_offset[nedge];
+    row[1] = col[1] = edge_table.n2_global_offset[nedge];
 
     // here we use AD, however it is great overkill for such a simple problem.
     {
@@ -192,15 +196,15 @@ void ElectrodeSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatrix<P
 
       PetscScalar eps = 0.5*(eps1+eps2);
 
-      AutoDScalar f =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/fvm_n1->distance(fvm_n2) ;
+      AutoDScalar f =  eps*edge_table.cv_area[nedge]*(V2 - V1)/edge_table.length[nedge] ;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         jac->add_row(row[0], 2, &col[0], f.getADValue());
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         jac->add_row(row[1], 2, &col[0], (-f).getADValue());
       }
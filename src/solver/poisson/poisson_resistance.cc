@@ -94,10 +94,12 @@ void MetalSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, InsertMode
   y.reserve(2*n_edge());
   
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -109,8 +111,8 @@ void MetalSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, InsertMode
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       // electrostatic potential, as independent variable
@@ -121,24 +123,24 @@ void MetalSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, InsertMode
       PetscScalar V2   =  x[n2_local_offset];
       PetscScalar eps2 =  n2_data->eps();
 
-      PetscScalar E    = (V2-V1)/fvm_n1->distance(fvm_n2);
+      PetscScalar E    = (V2-V1)/edge_table.length[nedge];
       PetscScalar eps  = 0.5*(eps1+eps2);
       
-      double S = std::abs(fvm_n1->cv_surface_area(fvm_n2));
+      double S = std::abs(edge_table.cv_area[nedge]);
 
       // "flux" from node 2 to node 1
       PetscScalar f = mt->basic->CurrentDensity(E, T)*S;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
-        iy.push_back(fvm_n1->global_offset());
+        iy.push_back(edge_table.n1_global_offset[nedge]);
         y.push_back(f);
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
-        iy.push_back(fvm_n2->global_offset());
+        iy.push_back(edge_table.n2_global_offset[nedge]);
         y.push_back(-f);
       }
     }
@@ -173,10 +175,12 @@ void MetalSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatrix<Petsc
 
   const PetscScalar T   = T_external();
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -188,13 +192,13 @@ void MetalSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatrix<Petsc
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     // the row/colume position of variables in the matrix
     unsigned int row[2],col[2];
-    row[0] = col[0] = fvm_n1->global_offset();
-    row[1] = col[1] = fvm_n2->global_offset();
+    row[0] = col[0] = edge_table.n1_global_offset[nedge];
+    row[1] = col[1] = edge_table.n2_global_offset[nedge];
 
     // here we use AD, however it is great overkill for such a simple problem.
     {
@@ -206,19 +210,19 @@ void MetalSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatrix<Petsc
       AutoDScalar V2   =  x[n2_local_offset];   V2.setADValue(1,1.0);
       PetscScalar eps2 =  n2_data->eps();
 
-      AutoDScalar E    = (V2-V1)/fvm_n1->distance(fvm_n2);
+      AutoDScalar E    = (V2-V1)/edge_table.length[nedge];
       PetscScalar eps = 0.5*(eps1+eps2);
 
-      double S = std::abs(fvm_n1->cv_surface_area(fvm_n2));
+      double S = std::abs(edge_table.cv_area[nedge]);
       AutoDScalar f = mt->basic->CurrentDensity(E, T)*S;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         jac->add_row(row[0], 2, &col[0], f.getADValue());
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         jac->add_row(row[1], 2, &col[0], (-f).getADValue());
       }
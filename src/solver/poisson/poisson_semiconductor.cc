@@ -55,7 +55,7 @@ void SemiconductorSimulationRegion::Poissin_Fill_Value(Vec x, Vec L)
     const FVM_Node * fvm_node = *node_it;
     const FVM_NodeData * node_data = fvm_node->node_data();
 
-    mt->mapping(fvm_node->root_node(), node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, 0.0);
 
     ix.push_back(fvm_node->global_offset());
     y.push_back(node_data->psi());
@@ -103,10 +103,12 @@ void SemiconductorSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, Ins
 
   // process \nabla operator for all cells
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
   // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -118,8 +120,8 @@ void SemiconductorSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, Ins
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     {
       // electrostatic potential, as independent variable
@@ -133,18 +135,18 @@ void SemiconductorSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, Ins
       PetscScalar eps = 0.5*(eps1+eps2);
 
       // "flux" from node 2 to node 1
-      PetscScalar f =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/fvm_n1->distance(fvm_n2) ;
+      PetscScalar f =  eps*edge_table.cv_area[nedge]*(V2 - V1)/edge_table.length[nedge] ;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
-        iy.push_back(fvm_n1->global_offset());
+        iy.push_back(edge_table.n1_global_offset[nedge]);
         y.push_back(f);
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
-        iy.push_back(fvm_n2->global_offset());
+        iy.push_back(edge_table.n2_global_offset[nedge]);
         y.push_back(-f);
       }
     }
@@ -163,12 +165,12 @@ void SemiconductorSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, Ins
     const FVM_NodeData * fvm_node_data = fvm_node->node_data();
 
     PetscScalar V   =  x[fvm_node->local_offset()];
-    mt->mapping(fvm_node->root_node(), fvm_node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), fvm_node_data, 0.0);
 
     // intrinsic Fermi potential.
     PetscScalar V_i =  V + fvm_node_data->affinity() + fvm_node_data->Eg()/(2*e) + kb*T*log(fvm_node_data->Nc()/fvm_node_data->Nv())/(2*e);
 
-    PetscScalar ni = mt->band->ni(T);
+    PetscScalar ni = mt->band->ni(ctx, T);
     // approx electron density
     PetscScalar n   =  ni*exp( e/(kb*T)*V_i);
     // approx hole density
@@ -182,7 +184,7 @@ void SemiconductorSimulationRegion::Poissin_Function(PetscScalar * x, Vec f, Ins
     // charge density
     PetscScalar doping = fvm_node_data->Net_doping();
     if(get_advanced_model()->IncompleteIonization)
-      doping = mt->band->Nd_II(n, T, get_advanced_model()->Fermi) - mt->band->Na_II(p, T, get_advanced_model()->Fermi);
+      doping = mt->band->Nd_II(ctx, n, T, get_advanced_model()->Fermi) - mt->band->Na_II(ctx, p, T, get_advanced_model()->Fermi);
     PetscScalar rho = e*( doping + p - n)*fvm_node->volume(); // the charge density
 
     iy.push_back(fvm_node->global_offset());                                  // save index in the buffer
@@ -226,10 +228,12 @@ void SemiconductorSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatr
   //synchronize with material database
   mt->set_ad_num(adtl::AutoDScalar::numdir);
 
+  const FVM_EdgeTable & edge_table = this->edge_table();
+
  // search all the edges of this region, do integral over control volume...
   const_edge_iterator it = edges_begin();
   const_edge_iterator it_end = edges_end();
-  for(; it!=it_end; ++it)
+  for(unsigned int nedge=0; it!=it_end; ++it, ++nedge)
   {
     // fvm_node of node1
     const FVM_Node * fvm_n1 = (*it).first;
@@ -241,13 +245,13 @@ void SemiconductorSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatr
     // fvm_node_data of node2
     const FVM_NodeData * n2_data =  fvm_n2->node_data();
 
-    const unsigned int n1_local_offset = fvm_n1->local_offset();
-    const unsigned int n2_local_offset = fvm_n2->local_offset();
+    const unsigned int n1_local_offset = edge_table.n1_local_offset[nedge];
+    const unsigned int n2_local_offset = edge_table.n2_local_offset[nedge];
 
     // the row/colume position of variables in the matrix
     unsigned int row[2],col[2];
-    row[0] = col[0] = fvm_n1->global_offset();
-    row[1] = col[1] = fvm_n2->global_offset();
+    row[0] = col[0] = edge_table.n1_global_offset[nedge];
+    row[1] = col[1] = edge_table.n2_global_offset[nedge];
 
     // here we use AD, however it is great overkill for such a simple problem.
     {
@@ -261,15 +265,15 @@ void SemiconductorSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatr
 
       PetscScalar eps = 0.5*(eps1+eps2);
 
-      AutoDScalar f =  eps*fvm_n1->cv_surface_area(fvm_n2)*(V2 - V1)/fvm_n1->distance(fvm_n2) ;
+      AutoDScalar f =  eps*edge_table.cv_area[nedge]*(V2 - V1)/edge_table.length[nedge] ;
 
       // ignore thoese ghost nodes
-      if( fvm_n1->on_processor() )
+      if( edge_table.n1_on_processor[nedge] )
       {
         jac->add_row(row[0], 2, &col[0], f.getADValue());
       }
 
-      if( fvm_n2->on_processor() )
+      if( edge_table.n2_on_processor[nedge] )
       {
         jac->add_row(row[1], 2, &col[0], (-f).getADValue());
       }
@@ -296,9 +300,9 @@ void SemiconductorSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatr
     const FVM_NodeData * fvm_node_data = fvm_node->node_data();
 
     AutoDScalar V   =  x[fvm_node->local_offset()];  V.setADValue(0, 1.0);
-    mt->mapping(fvm_node->root_node(), fvm_node_data, 0.0);
+    const PMI_Context ctx = mt->mapping(fvm_node->root_node(), fvm_node_data, 0.0);
 
-    PetscScalar ni = mt->band->ni(T);
+    PetscScalar ni = mt->band->ni(ctx, T);
 
     // intrinsic Fermi potential.
     AutoDScalar V_i =  V + fvm_node_data->affinity() + fvm_node_data->Eg()/(2*e) + kb*T*log(fvm_node_data->Nc()/fvm_node_data->Nv())/(2*e);
@@ -317,7 +321,7 @@ void SemiconductorSimulationRegion::Poissin_Jacobian(PetscScalar * x, SparseMatr
     // charge density
     AutoDScalar doping = fvm_node_data->Net_doping();
     if(get_advanced_model()->IncompleteIonization)
-      doping = mt->band->Nd_II(n, T, get_advanced_model()->Fermi) - mt->band->Na_II(p, T, get_advanced_model()->Fermi);
+      doping = mt->band->Nd_II(ctx, n, T, get_advanced_model()->Fermi) - mt->band->Na_II(ctx, p, T, get_advanced_model()->Fermi);
     AutoDScalar rho = e*( doping + p - n)*fvm_node->volume(); // the charge density
 
     jac->add(fvm_node->global_offset(), fvm_node->global_offset(), rho.getADValue(0));  // save value in the buffer
@@ -354,9 +358,9 @@ void SemiconductorSimulationRegion::Poissin_Update_Solution(PetscScalar *lxx)
     //for semiconductor region, also update n and p
     {
       PetscScalar T   = T_external();
-      mt->mapping(fvm_node->root_node(), node_data, 0.0);
+      const PMI_Context ctx = mt->mapping(fvm_node->root_node(), node_data, 0.0);
 
-      PetscScalar ni = mt->band->ni(T);
+      PetscScalar ni = mt->band->ni(ctx, T);
 
       // intrinsic Fermi potential.
       PetscScalar V_i = V
@@ -374,7 +378,7 @@ void SemiconductorSimulationRegion::Poissin_Update_Solution(PetscScalar *lxx)
       node_data->p()   =  p*exp(dEg/(2*kb*T));
 #endif
       //update psi
-      PetscScalar Eg = mt->band->Eg(T);
+      PetscScalar Eg = mt->band->Eg(ctx, T);
       node_data->psi() = V;
       node_data->Eg() = Eg;
       node_data->Ec() = -(e*V + node_data->affinity());
@@ -0,0 +1,175 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+#include <cmath>
+#include <numeric>
+
+#include "light_thread.h"
+#include "light_packet.h"
+
+
+double LightPacket::total_power() const
+{
+  return std::accumulate(_power.begin(), _power.end(), 0.0);
+}
+
+
+void LightPacket::scale_power(double f)
+{
+  for(unsigned int i=0; i<_power.size(); ++i)
+    _power[i] *= f;
+}
+
+
+void LightPacket::advance_to(const Point & p_end, const std::vector<double> &a_band, const std::vector<double> &a_fc,
+                             std::vector<double> &band_loss, std::vector<double> &total_loss)
+{
+  const double length = (_p - p_end).size();
+  _p = p_end;
+
+  const unsigned int n = _power.size();
+  band_loss.resize(n);
+  total_loss.resize(n);
+  for(unsigned int i=0; i<n; ++i)
+  {
+    const double power_start = _power[i];
+    _power[i] *= exp(-(a_band[i]+a_fc[i])*length);
+    total_loss[i] = power_start - _power[i];
+    band_loss[i]  = total_loss[i]*a_band[i]/(a_band[i]+a_fc[i]+1e-30);
+  }
+}
+
+
+double LightPacket::remove_dead()
+{
+  double dead_power = 0.0;
+  unsigned int k=0;
+  for(unsigned int i=0; i<_waves.size(); ++i)
+  {
+    if(_power[i] < LightThread::dead_factor*_init_power[i])
+    {
+      dead_power += _power[i];
+      continue;
+    }
+    _waves[k]      = _waves[i];
+    _wavelength[k] = _wavelength[i];
+    _init_power[k] = _init_power[i];
+    _power[k]      = _power[i];
+    ++k;
+  }
+  _waves.resize(k);
+  _wavelength.resize(k);
+  _init_power.resize(k);
+  _power.resize(k);
+  return dead_power;
+}
+
+
+LightThread * LightPacket::light(unsigned int i) const
+{
+  LightThread * light = new LightThread(_p, _dir, _E_dir, _wavelength[i], _init_power[i], _power[i]);
+  light->hit_elem = hit_elem;
+  light->result   = result;
+  return light;
+}
+
+
+LightPacket * LightPacket::reflection(const Point & in_p, const Point & norm) const
+{
+  Point reflect_dir = (_dir-2*(norm.dot(_dir))*norm).unit();
+  LightPacket * packet = new LightPacket(in_p, reflect_dir, _E_dir);
+  packet->_waves      = _waves;
+  packet->_wavelength = _wavelength;
+  packet->_init_power = _init_power;
+  packet->_power      = _power;
+  return packet;
+}
+
+
+void LightPacket::interface_light_gen_linear_polarized(const Point & in_p, const Point & norm,
+                                                       const std::vector<double> &n1, const std::vector<double> &n2,
+                                                       const ARCoatings *arc, bool inv, double tol,
+                                                       std::vector<LightPacket *> & reflect, std::vector<LightPacket *> & refract) const
+{
+  std::vector<LightThread *> reflect_lights, refract_lights;
+  std::vector<unsigned int>  reflect_waves, refract_waves;
+
+  for(unsigned int i=0; i<_waves.size(); ++i)
+  {
+    LightThread light(_p, _dir, _E_dir, _wavelength[i], _init_power[i], _power[i]);
+    std::pair<LightThread *, LightThread *> ray_pair = light.interface_light_gen_linear_polarized(in_p, norm, n1[i], n2[i], arc, inv);
+    if(ray_pair.first)
+    {
+      reflect_lights.push_back(ray_pair.first);
+      reflect_waves.push_back(_waves[i]);
+    }
+    if(ray_pair.second)
+    {
+      refract_lights.push_back(ray_pair.second);
+      refract_waves.push_back(_waves[i]);
+    }
+  }
+
+  _group(reflect_lights, reflect_waves, tol, reflect);
+  _group(refract_lights, refract_waves, tol, refract);
+}
+
+
+void LightPacket::_group(std::vector<LightThread *> &lights, const std::vector<unsigned int> &waves,
+                         double tol, std::vector<LightPacket *> & packets)
+{
+  const double cos_tol = cos(tol);
+
+  // the first light of each group gives the direction of the packet
+  std::vector<const LightThread *> leads;
+  std::vector<LightPacket *> groups;
+
+  for(unsigned int i=0; i<lights.size(); ++i)
+  {
+    const LightThread * light = lights[i];
+
+    unsigned int g=0;
+    for(; g<leads.size(); ++g)
+    {
+      if( leads[g]->dir().dot(light->dir()) < cos_tol ) continue;
+      const Point & E0 = leads[g]->E_dir();
+      const Point & E1 = light->E_dir();
+      if( std::abs(E0.dot(E1)) < cos_tol*E0.size()*E1.size() ) continue;
+      break;
+    }
+
+    if( g == leads.size() )
+    {
+      leads.push_back(light);
+      groups.push_back( new LightPacket(light->start_point(), light->dir(), light->E_dir()) );
+    }
+
+    groups[g]->add_wave(waves[i], light->wavelength(), light->init_power(), light->power());
+  }
+
+  packets.insert(packets.end(), groups.begin(), groups.end());
+
+  for(unsigned int i=0; i<lights.size(); ++i)
+    delete lights[i];
+  lights.clear();
+}
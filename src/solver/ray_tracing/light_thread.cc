@@ -27,6 +27,7 @@
 #include "light_thread.h"
 #include "anti_reflection_coating.h"
 #include "physical_unit.h"
+#include "thread_pool.h"
 
 using PhysicalUnit::eps0;
 using PhysicalUnit::mu0;
@@ -35,6 +36,53 @@ using PhysicalUnit::mu0;
 double LightThread::dead_factor = 1e-3;
 
 
+namespace
+{
+  /**
+   * free memory block of LightThread
+   */
+  struct FreeLight
+  {
+    FreeLight * next;
+  };
+
+  /**
+   * free list of each thread, the list is limited in length
+   */
+  GENIUS_THREAD_LOCAL FreeLight *  _free_lights = 0;
+  GENIUS_THREAD_LOCAL unsigned int _n_free_lights = 0;
+  const unsigned int _max_free_lights = 4096;
+}
+
+
+void * LightThread::operator new(size_t size)
+{
+  if( size == sizeof(LightThread) && _free_lights )
+  {
+    FreeLight * block = _free_lights;
+    _free_lights = block->next;
+    --_n_free_lights;
+    return block;
+  }
+  return ::operator new(size);
+}
+
+
+void LightThread::operator delete(void * p)
+{
+  if( !p ) return;
+  if( _n_free_lights < _max_free_lights )
+  {
+    FreeLight * block = static_cast<FreeLight *>(p);
+    block->next = _free_lights;
+    _free_lights = block;
+    ++_n_free_lights;
+    return;
+  }
+  ::operator delete(p);
+}
+
+
 std::vector<double> LightThread::advance_to(const Point & p_end, double a_band, double a_tail, double a_fc)
 {
   const double length = (_p - p_end).size();
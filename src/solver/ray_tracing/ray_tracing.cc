@@ -20,6 +20,7 @@
 /********************************************************************************/
 
 #include <stack>
+#include <algorithm>
 #include <iomanip>
 #include <numeric>
 
@@ -31,12 +32,14 @@
 #include "mesh_tools.h"
 #include "field_source.h"
 #include "light_lenses.h"
-#include "object_tree.h"
+#include "elem_bvh.h"
 #include "ray_tracing/light_thread.h"
+#include "ray_tracing/light_packet.h"
 #include "ray_tracing/ray_tracing.h"
 #include "ray_tracing/anti_reflection_coating.h"
 #include "parallel.h"
 #include "expr_evaluate.h"
+#include "thread_pool.h"
 
 #define DEBUG
 
@@ -54,7 +57,7 @@ using PhysicalUnit::W;
 
 
 RayTraceSolver::RayTraceSolver(SimulationSystem & system, const Parser::Card & c)
-  : SolverBase(system), _card(c), surface_elem_tree(0),
+  : SolverBase(system), _card(c), _n_waves(1), _batch_size(1), _batch_tolerance(0.0), surface_elem_tree(0),
    _incident_power(0.0), _pass_power(0.0), _escape_power(0.0), _absorb_power(0.0)
 {
   system.record_active_solver(this->solver_type());
@@ -71,7 +74,8 @@ int RayTraceSolver::create_solver()
   genius_assert(mesh.is_serial());
 
   // do necessary precomputation for fast ray tracing
-  surface_elem_tree = new ObjectTree(mesh, Trees::ELEMENTS_ON_BOUNDARY);
+  surface_elem_tree = new ElemBVH(mesh, Trees::ELEMENTS_ON_BOUNDARY);
+  build_elem_face_planes();
   build_elems_node_map();
   build_elems_edge_map();
   build_boundary_elems_map();
@@ -95,73 +99,102 @@ int RayTraceSolver::solve()
   ExprEvalute * grating_expr_eva = 0;
   if(!_grating_expr.empty()) grating_expr_eva = new ExprEvalute(_grating_expr);
 
-  // for each wavelentgh
-  for(unsigned int n=0; n<_optical_sources.size(); ++n)
+  RayTraceTask task;
+  task.chunk_size = 64;
+  task.scratch.resize(Genius::n_threads());
+
+  // for each spectrum batch, the wavelength in the batch are traced together
+  for(unsigned int n0=0; n0<_optical_sources.size(); n0+=_batch_size)
   {
-    double lamda     = _optical_sources[n].wave_length;
-    double intensity = _optical_sources[n].power;
-    double power     = _dim==2 ? intensity*_wave_plane.min_dist : intensity*_wave_plane.ray_area();
+    const unsigned int n1 = std::min(n0+_batch_size, static_cast<unsigned int>(_optical_sources.size()));
 
-    build_elem_refractive_index(lamda);
+    task.lamdas.clear();
+    task.wave_power.clear();
+    for(unsigned int n=n0; n<n1; ++n)
+    {
+      double intensity = _optical_sources[n].power;
+      task.lamdas.push_back(_optical_sources[n].wave_length);
+      task.wave_power.push_back(_dim==2 ? intensity*_wave_plane.min_dist : intensity*_wave_plane.ray_area());
+    }
 
-    // clear and re-create the array to record energy deposition
-    _band_absorption_energy_in_elem.clear();
-    _band_absorption_energy_in_elem.resize(_system.mesh().n_elem(), 0.0);
+    build_elem_refractive_index(task.lamdas);
 
-    _total_absorption_energy_in_elem.clear();
-    _total_absorption_energy_in_elem.resize(_system.mesh().n_elem(), 0.0);
+    // scratch of energy deposit for each thread
+    const unsigned int n_elem = _system.mesh().n_elem();
+    for(unsigned int t=0; t<task.scratch.size(); ++t)
+    {
+      task.scratch[t].n_waves = _n_waves;
+      task.scratch[t].wave = 0;
+      task.scratch[t].band.assign(n_elem*_n_waves, 0.0);
+      task.scratch[t].total.assign(n_elem*_n_waves, 0.0);
+      task.scratch[t].touched.assign(n_elem, 0);
+    }
 
-    MESSAGE<< "  process light of " /*<< std::setiosflags(std::ios::fixed)*/  << lamda/um << " um";
+    MESSAGE<< "  process light of " /*<< std::setiosflags(std::ios::fixed)*/  << task.lamdas.front()/um;
+    if(_n_waves > 1)
+      MESSAGE<< " - " << task.lamdas.back()/um;
+    MESSAGE<< " um";
     RECORD();
 
-    //process all the rays
+    // the power factor of all the rays, grating expression is evaluated here since it is not thread safe
     unsigned int n_on_processor_rays = _wave_plane.n_on_processor_rays();
-    for(unsigned int k=0; k<n_on_processor_rays; ++k)
+    task.ray_power.assign(n_on_processor_rays, 1.0);
+    if(grating_expr_eva)
     {
-      double ray_power = power;
-      if(grating_expr_eva)
+      for(unsigned int k=0; k<n_on_processor_rays; ++k)
       {
         Point offset = _wave_plane.ray_start_point(k) - _wave_plane.center;
-        ray_power *= grating_expr_eva->eval(offset.x(), offset.y(), offset.z(), 0.0);
+        task.ray_power[k] *= grating_expr_eva->eval(offset.x(), offset.y(), offset.z(), 0.0);
       }
+    }
+    task.chunks.clear();
+    task.chunks.resize( (n_on_processor_rays + task.chunk_size - 1)/task.chunk_size );
 
-      // create ray
-      LightThread * light = new  LightThread(_wave_plane.ray_start_point(k),
-                                             _wave_plane.norm,
-                                             _wave_plane.E_dir,
-                                             lamda,
-                                             ray_power,
-                                             ray_power
-                                            );
-
-      if(!_lenses->empty())
-      {
-        light = (*_lenses) << light;
-        if(!light) continue;
-      }
+    //process all the rays, each thread takes the next chunk not traced yet
+    Genius::MemberThreadLoop<RayTraceSolver, RayTraceTask> loop(this, &RayTraceSolver::trace_rays, task);
+    Genius::parallel_for_dynamic(n_on_processor_rays, loop, task.chunk_size);
 
-      // call function ray_tracing to process a single ray
-      ray_tracing(light);
+    for(unsigned int c=0; c<task.chunks.size(); ++c)
+    {
+      const RayChunkDeposit & chunk = task.chunks[c];
+      _incident_power += chunk.incident;
+      _pass_power     += chunk.pass;
+      _escape_power   += chunk.escape;
+      _absorb_power   += chunk.absorb;
+    }
 
-      //indicator
-      if(k%(1+(n_on_processor_rays)/20)==0) // +1 for prevent divide by zero error
-      {
-        MESSAGE<< ".";
-        RECORD();
-      }
 #if defined(HAVE_FENV_H) && defined(DEBUG)
-      genius_assert( !fetestexcept(FE_INVALID) );
+    genius_assert( !fetestexcept(FE_INVALID) );
 #endif
 
-    }
+    for(unsigned int w=0; w<_n_waves; ++w)
+    {
+      // clear and re-create the array to record energy deposition
+      _band_absorption_energy_in_elem.clear();
+      _band_absorption_energy_in_elem.resize(n_elem, 0.0);
 
+      _total_absorption_energy_in_elem.clear();
+      _total_absorption_energy_in_elem.resize(n_elem, 0.0);
+
+      // reduce the deposit of chunks in order
+      for(unsigned int c=0; c<task.chunks.size(); ++c)
+      {
+        const RayChunkDeposit & chunk = task.chunks[c];
+        for(unsigned int i=0; i<chunk.elems.size(); ++i)
+        {
+          _band_absorption_energy_in_elem[chunk.elems[i]]  += chunk.band[i*_n_waves+w];
+          _total_absorption_energy_in_elem[chunk.elems[i]] += chunk.total[i*_n_waves+w];
+        }
+      }
 
-    // gather energy deposit from all the processors
-    Parallel::sum(_band_absorption_energy_in_elem);
-    Parallel::sum(_total_absorption_energy_in_elem);
+      // gather energy deposit from all the processors
+      Parallel::sum(_band_absorption_energy_in_elem);
+      Parallel::sum(_total_absorption_energy_in_elem);
 
-    // convert energy deposit to carrier optical generation
-    optical_generation(n);
+      // convert energy deposit to carrier optical generation
+      optical_generation(n0+w);
+    }
+    task.chunks.clear();
 
     MESSAGE<< "ok" <<std::endl;
     RECORD();
@@ -190,6 +223,8 @@ int RayTraceSolver::solve()
 int RayTraceSolver::destroy_solver()
 {
   delete surface_elem_tree;
+  _face_planes.clear();
+  _elem_face_plane_begin.clear();
 
   {
     std::map<const Elem *, std::vector<const Elem *>,  lt_edge>::iterator it = _elems_shared_this_edge.begin();
@@ -352,10 +387,14 @@ void RayTraceSolver::create_rays()
   if(_card.is_parameter_exist("ray.grating"))
     _grating_expr = _card.get_string("ray.grating",  "");
 
+  // trace the lights of neighboring wavelength together
+  _batch_size      = std::max(1, _card.get_int("ray.batch", 1));
+  _batch_tolerance = _card.get_real("ray.batch.tol", 0.1)/180.0*3.14159265358979323846;
+
 
 
   //3D mesh
-  if(surface_elem_tree->is_octree())
+  if(surface_elem_tree->dim() == 3)
   {
     // compute all the start point of the ray
     const Point y_axis(0,1,0);
@@ -403,7 +442,7 @@ void RayTraceSolver::create_rays()
   }
 
   //2D mesh
-  if(surface_elem_tree->is_quadtree())
+  if(surface_elem_tree->dim() == 2)
   {
     const Point z_axis(0,0,1);
     Point d = dir.cross(z_axis);
@@ -545,54 +584,73 @@ void RayTraceSolver::parse_spectrum_file(const std::string & filename)
 }
 
 
-void RayTraceSolver::build_elem_refractive_index(double lambda)
+void RayTraceSolver::build_elem_refractive_index(const std::vector<double> & lamdas)
 {
+  _n_waves = lamdas.size();
   _elem_refractive_index.clear();
 
-  std::map<unsigned int, Complex> r_table;
-
   const MeshBase & mesh = _system.mesh();
-  MeshBase::const_element_iterator       el  = mesh.elements_begin();
-  const MeshBase::const_element_iterator end = mesh.elements_end();
-  for (; el != end; ++el)
+
+  for(unsigned int w=0; w<_n_waves; ++w)
   {
-    const Elem * elem = *el;
-    if(!elem->on_processor()) continue;
+    const double lambda = lamdas[w];
 
-    const SimulationRegion * region = _system.region(elem->subdomain_id());
+    std::map<unsigned int, Complex> r_table;
 
-    Complex r_index;
-    for(unsigned int nd = 0; nd < elem->n_nodes(); nd++)
+    MeshBase::const_element_iterator       el  = mesh.elements_begin();
+    const MeshBase::const_element_iterator end = mesh.elements_end();
+    for (; el != end; ++el)
     {
-      const FVM_Node * fvm_node = elem->get_fvm_node(nd);
-      r_index += region->get_optical_refraction(fvm_node, lambda);
-    }
+      const Elem * elem = *el;
+      if(!elem->on_processor()) continue;
 
-    r_index /= elem->n_nodes();
-    r_table.insert( std::make_pair(elem->id(), r_index) );
-  }
+      const SimulationRegion * region = _system.region(elem->subdomain_id());
+
+      Complex r_index;
+      for(unsigned int nd = 0; nd < elem->n_nodes(); nd++)
+      {
+        const FVM_Node * fvm_node = elem->get_fvm_node(nd);
+        r_index += region->get_optical_refraction(fvm_node, lambda);
+      }
 
-  Parallel::allgather(r_table);
+      r_index /= elem->n_nodes();
+      r_table.insert( std::make_pair(elem->id(), r_index) );
+    }
+
+    Parallel::allgather(r_table);
 
+    _elem_refractive_index.resize(r_table.size()*_n_waves);
+    std::map<unsigned int, Complex>::const_iterator it= r_table.begin();
+    for(unsigned int e=0; it != r_table.end(); ++it, ++e)
+      _elem_refractive_index[e*_n_waves+w] = it->second;
+  }
 
-  std::map<unsigned int, Complex>::const_iterator it= r_table.begin();
-  for(; it != r_table.end(); ++it)
-    _elem_refractive_index.push_back(it->second);
+  // free carrier absorption for light packet
+  _elem_free_carrier_absorption.clear();
+  if(_n_waves > 1)
+  {
+    _elem_free_carrier_absorption.resize(mesh.n_elem()*_n_waves, 0.0);
+    MeshBase::const_element_iterator       el  = mesh.elements_begin();
+    const MeshBase::const_element_iterator end = mesh.elements_end();
+    for (; el != end; ++el)
+      for(unsigned int w=0; w<_n_waves; ++w)
+        _elem_free_carrier_absorption[(*el)->id()*_n_waves+w] = get_free_carrier_absorption(*el, lamdas[w]);
+  }
 }
 
 
-double RayTraceSolver::get_refractive_index_re(const Elem *elem) const
+double RayTraceSolver::get_refractive_index_re(const Elem *elem, unsigned int wave) const
 {
   if(elem)
-    return _elem_refractive_index[elem->id()].real();
+    return _elem_refractive_index[elem->id()*_n_waves+wave].real();
   return 1.0;
 }
 
 
-double RayTraceSolver::get_refractive_index_im(const Elem *elem) const
+double RayTraceSolver::get_refractive_index_im(const Elem *elem, unsigned int wave) const
 {
   if(elem)
-    return _elem_refractive_index[elem->id()].imag();
+    return _elem_refractive_index[elem->id()*_n_waves+wave].imag();
   return 0.0;
 }
 
@@ -654,13 +712,45 @@ double RayTraceSolver::get_free_carrier_absorption(const Elem* elem, double wave
   {
     const SemiconductorSimulationRegion * semiconductor_region = dynamic_cast<const SemiconductorSimulationRegion *>(region);
     std::pair<double, double> carrier = _elem_carrier_density.find(elem->id())->second;
-    return semiconductor_region->material()->optical->FreeCarrierAbsorption(wavelength, carrier.first, carrier.second, _system.T_external() );
+    return semiconductor_region->material()->optical->FreeCarrierAbsorption(PMI_Context(), wavelength, carrier.first, carrier.second, _system.T_external() );
   }
   return 0.0;
 }
 
 
 
+void RayTraceSolver::build_elem_face_planes()
+{
+  const MeshBase &mesh = _system.mesh();
+
+  _face_planes.clear();
+  _elem_face_plane_begin.assign(mesh.n_elem()+1, 0);
+
+  // count the faces of each elem
+  MeshBase::const_element_iterator       el  = mesh.elements_begin();
+  const MeshBase::const_element_iterator end = mesh.elements_end();
+  for (; el != end; ++el)
+    _elem_face_plane_begin[(*el)->id()+1] = (*el)->n_sides();
+
+  for(unsigned int n=0; n<mesh.n_elem(); ++n)
+    _elem_face_plane_begin[n+1] += _elem_face_plane_begin[n];
+
+  _face_planes.resize(_elem_face_plane_begin.back());
+
+  for (el = mesh.elements_begin(); el != end; ++el)
+  {
+    const Elem * elem = *el;
+    for (unsigned int s=0; s<elem->n_sides(); s++)
+    {
+      FacePlane & plane = _face_planes[_elem_face_plane_begin[elem->id()] + s];
+      AutoPtr<Elem> side = elem->build_side(s, false);
+      plane.norm   = elem->outside_unit_normal(s);
+      plane.offset = plane.norm.dot(side->point(0));
+    }
+  }
+}
+
+
 void RayTraceSolver::build_elems_node_map()
 {
   MeshTools::build_nodes_to_elem_map(_system.mesh(), _elems_shared_this_node);
@@ -853,16 +943,159 @@ const Elem * RayTraceSolver::ray_hit(const Point &p, const Point &dir, const Ele
 }
 
 
+void RayTraceSolver::ray_walk(const Point &p, const Point &dir, const Elem *elem, unsigned int side, IntersectionResult & result) const
+{
+  const unsigned int begin = _elem_face_plane_begin[elem->id()];
+  const unsigned int end   = _elem_face_plane_begin[elem->id()+1];
+
+  // the nearest and the second nearest face the ray leaves through
+  double t_exit = 1e30, t_next = 1e30;
+  unsigned int exit_side = invalid_uint;
+  for(unsigned int i=begin; i<end; ++i)
+  {
+    if(i-begin == side) continue;
+    const FacePlane & plane = _face_planes[i];
+    double dn = plane.norm.dot(dir);
+    if(dn < 1e-10) continue; //the ray doesn't leave through this face
+    double t = (plane.offset - plane.norm.dot(p))/dn;
+    if(t < t_exit)
+    {
+      t_next = t_exit;
+      t_exit = t;
+      exit_side = i-begin;
+    }
+    else if(t < t_next)
+      t_next = t;
+  }
+
+  // the ray leaves through the interior of a single face
+  bool on_single_face = exit_side != invalid_uint && t_exit > 1e-10 && t_next - t_exit > 1e-8;
+
+  Point q = p + t_exit*dir;
+  for(unsigned int n=0; on_single_face && n<elem->n_vertices(); ++n)
+    if( (elem->point(n) - q).size() < 1e-8 ) on_single_face = false;
+
+  // ray goes through edge/vertex, or runs along a face, do the exact intersection test
+  if(!on_single_face)
+  {
+    result.hit_points.clear();
+    elem->ray_hit(p, dir, result, _dim);
+    return;
+  }
+
+  const PointLocation location = (_dim == 2 ? on_side : on_face);
+
+  result.state = Intersect_Body;
+  result.mark  = 0;
+  result.hit_points.resize(2);
+
+  result.hit_points[0].p = p;
+  result.hit_points[0].t = 0.0;
+  result.hit_points[0].point_location = location;
+  result.hit_points[0].mark = side;
+
+  result.hit_points[1].p = q;
+  result.hit_points[1].t = t_exit;
+  result.hit_points[1].point_location = location;
+  result.hit_points[1].mark = exit_side;
+}
+
+
+
+void RayTraceSolver::trace_rays(RayTraceTask & task, unsigned int thread, unsigned int begin, unsigned int end)
+{
+  EnergyDeposit & deposit = task.scratch[thread];
+
+  for(unsigned int k=begin; k<end; ++k)
+  {
+    // trace the spectrum batch as a light packet
+    if(task.lamdas.size() > 1 && _lenses->empty())
+    {
+      LightPacket * packet = new LightPacket(_wave_plane.ray_start_point(k), _wave_plane.norm, _wave_plane.E_dir);
+      for(unsigned int w=0; w<task.lamdas.size(); ++w)
+      {
+        const double ray_power = task.ray_power[k]*task.wave_power[w];
+        packet->add_wave(w, task.lamdas[w], ray_power, ray_power);
+      }
+
+      deposit.incident += packet->total_power();
+      packet_tracing(packet, deposit);
+      continue;
+    }
+
+    // each wavelength is traced by a single ray
+    for(unsigned int w=0; w<task.lamdas.size(); ++w)
+    {
+      const double ray_power = task.ray_power[k]*task.wave_power[w];
+
+      // create ray
+      LightThread * light = new  LightThread(_wave_plane.ray_start_point(k),
+                                             _wave_plane.norm,
+                                             _wave_plane.E_dir,
+                                             task.lamdas[w],
+                                             ray_power,
+                                             ray_power
+                                            );
+
+      if(!_lenses->empty())
+      {
+        light = (*_lenses) << light;
+        if(!light) continue;
+      }
+
+      // call function ray_tracing to process a single ray
+      deposit.wave = w;
+      deposit.incident += light->power();
+      ray_tracing(light, deposit);
+    }
+  }
+
+  // move the deposit to the chunk, and clear the scratch
+  RayChunkDeposit & chunk = task.chunks[begin/task.chunk_size];
+  std::sort(deposit.elems.begin(), deposit.elems.end());
+  chunk.elems = deposit.elems;
+  const unsigned int n_waves = deposit.n_waves;
+  chunk.band.resize(deposit.elems.size()*n_waves);
+  chunk.total.resize(deposit.elems.size()*n_waves);
+  for(unsigned int i=0; i<deposit.elems.size(); ++i)
+  {
+    const unsigned int e = deposit.elems[i];
+    for(unsigned int w=0; w<n_waves; ++w)
+    {
+      chunk.band[i*n_waves+w]  = deposit.band[e*n_waves+w];
+      chunk.total[i*n_waves+w] = deposit.total[e*n_waves+w];
+      deposit.band[e*n_waves+w]  = 0.0;
+      deposit.total[e*n_waves+w] = 0.0;
+    }
+    deposit.touched[e] = 0;
+  }
+  deposit.elems.clear();
+
+  chunk.incident = deposit.incident;
+  chunk.pass     = deposit.pass;
+  chunk.escape   = deposit.escape;
+  chunk.absorb   = deposit.absorb;
+  deposit.incident = deposit.pass = deposit.escape = deposit.absorb = 0.0;
+
+  //indicator, only main thread can write message
+  const unsigned int n_chunks = task.chunks.size();
+  const unsigned int c = begin/task.chunk_size;
+  if(thread==0 && c%(1+n_chunks/20)==0)
+  {
+    MESSAGE<< ".";
+    RECORD();
+  }
+}
+
+
 
-void RayTraceSolver::ray_tracing(LightThread *ray)
+void RayTraceSolver::ray_tracing(LightThread *ray, EnergyDeposit &deposit)
 {
 
   // use stack to save all the rays (origin and secondary)
   std::stack<LightThread *> ray_stack;
   ray_stack.push(ray);
 
-  _incident_power += ray->power();
-
   while(!ray_stack.empty())
   {
     LightThread * current_ray = ray_stack.top();
@@ -873,20 +1106,18 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
     // the ray doesn't hit any elem yet?
     if(current_ray->hit_elem==NULL)
     {
-      // find the first element this ray hit
-      const Elem * elem = surface_elem_tree->hit(current_ray->start_point(), current_ray->dir());
+      // find the first element this ray hit, and get the intersection result
+      const Elem * elem = surface_elem_tree->hit(current_ray->start_point(), current_ray->dir(), current_ray->result);
 
       // not hit any elem
       if(elem==NULL)
       {
-        _pass_power+=current_ray->power(); delete current_ray; continue;
+        deposit.pass+=current_ray->power(); delete current_ray; continue;
       }
 
       current_ray->hit_elem = elem;
 
       assert(elem->on_boundary());
-      // get the intersection result
-      elem->ray_hit(current_ray->start_point(), current_ray->dir(), current_ray->result, _dim);
 
       // the first intersection point
       assert(current_ray->result.hit_points.size());
@@ -908,7 +1139,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
           unsigned int edge_index = hit_point.mark;
           AutoPtr<Elem> edge = elem->build_edge(edge_index);
           if(_boundary_edge_to_elem_side_map.find(edge.get())==_boundary_edge_to_elem_side_map.end())
-          { _pass_power+=current_ray->power(); delete current_ray; continue;}
+          { deposit.pass+=current_ray->power(); delete current_ray; continue;}
           hit_elems = _boundary_edge_to_elem_side_map.find(edge.get())->second;
           break;
         }
@@ -917,7 +1148,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
           unsigned int vertex_index = hit_point.mark;
           const Node * current_node = elem->get_node(vertex_index);
           if(_boundary_node_to_elem_side_map.find(current_node)==_boundary_node_to_elem_side_map.end())
-          { _pass_power+=current_ray->power(); delete current_ray; continue;}
+          { deposit.pass+=current_ray->power(); delete current_ray; continue;}
           hit_elems = _boundary_node_to_elem_side_map.find(current_node)->second;
           break;
         }
@@ -934,7 +1165,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
         Point norm = boundary_elem->outside_unit_normal(side);
         //the surface norm should has a angle >90 degree to ray dir
         if(norm.dot(current_ray->dir()) > -1e-10)
-        { _pass_power+=current_ray->power(); continue; }
+        { deposit.pass+=current_ray->power(); continue; }
 
         // if reflect surface
         if(is_full_reflect_surface(boundary_elem, side))
@@ -951,21 +1182,21 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
               ray_stack.push(reflect_ray);
             else
             {
-              _escape_power += reflect_ray->power();
+              deposit.escape += reflect_ray->power();
               delete reflect_ray;
             }
           }
           else
           {
-            _escape_power += reflect_ray->power();
+            deposit.escape += reflect_ray->power();
             delete reflect_ray;
           }
           continue;
         }
 
 
-        double n1 = get_refractive_index_re(boundary_elem->neighbor(side));
-        double n2 = get_refractive_index_re(boundary_elem);
+        double n1 = get_refractive_index_re(boundary_elem->neighbor(side), deposit.wave);
+        double n2 = get_refractive_index_re(boundary_elem, deposit.wave);
 
         // if we have a anti reflection coating
         const ARCoatings * arc = is_anti_reflection_coating_surface(boundary_elem, side);
@@ -983,7 +1214,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
             ray_stack.push(refract_ray);
           else
           { // the refract ray has already penetrat through the device?
-            _escape_power += refract_ray->power();
+            deposit.escape += refract_ray->power();
             delete refract_ray;
           }
         }
@@ -1003,13 +1234,13 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
               ray_stack.push(reflect_ray);
             else
             {
-              _escape_power += reflect_ray->power();
+              deposit.escape += reflect_ray->power();
               delete reflect_ray;
             }
           }
           else
           {
-            _escape_power += reflect_ray->power();
+            deposit.escape += reflect_ray->power();
             delete reflect_ray;
           }
         }
@@ -1024,7 +1255,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
     if( current_ray->result.hit_points.size() != 2 )
     {
       // FIXME, should not happen...
-      _pass_power += current_ray->power(); delete current_ray; continue;
+      deposit.pass += current_ray->power(); delete current_ray; continue;
     }
 
     // calculate energy deposit
@@ -1032,32 +1263,29 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
     Hit_Point  end_point = current_ray->result.hit_points[1];
 
 
-    double a_band = 4*3.14159265358979*this->get_refractive_index_im(elem)/current_ray->wavelength();
+    double a_band = 4*3.14159265358979*this->get_refractive_index_im(elem, deposit.wave)/current_ray->wavelength();
     double a_tail = 0.0;
     double a_fc   = this->get_free_carrier_absorption(elem, current_ray->wavelength());
 
     std::vector<double> energy_deposit = current_ray->advance_to(end_point.p, a_band, a_tail, a_fc);
     double total_energy_deposit = std::accumulate(energy_deposit.begin(), energy_deposit.end(), 0.0);
-    _absorb_power+= total_energy_deposit;
+    deposit.absorb+= total_energy_deposit;
 
     switch(current_ray->result.state)
     {
       // all the energy deposited in this elem
     case Intersect_Body :
-      _band_absorption_energy_in_elem[elem->id()] += energy_deposit[0];
-      _total_absorption_energy_in_elem[elem->id()] += total_energy_deposit;
+      deposit.add(elem->id(), energy_deposit[0], total_energy_deposit);
       break;
       // two elem shares the energy deposite
     case On_Face        :
       {
-        _band_absorption_energy_in_elem[elem->id()] += 0.5*energy_deposit[0];
-        _total_absorption_energy_in_elem[elem->id()] += 0.5*total_energy_deposit;
+        deposit.add(elem->id(), 0.5*energy_deposit[0], 0.5*total_energy_deposit);
         unsigned int side = current_ray->result.mark;
         const Elem * neighbor = elem->neighbor(side);
         if(neighbor)
         {
-          _band_absorption_energy_in_elem[neighbor->id()] += 0.5*energy_deposit[0];
-          _total_absorption_energy_in_elem[neighbor->id()] += 0.5*total_energy_deposit;
+          deposit.add(neighbor->id(), 0.5*energy_deposit[0], 0.5*total_energy_deposit);
         }
         break;
       }
@@ -1070,8 +1298,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
         assert(elems.size());
         for(unsigned int n=0; n<elems.size(); ++n)
         {
-          _band_absorption_energy_in_elem[elems[n]->id()] += energy_deposit[0]/elems.size();
-          _total_absorption_energy_in_elem[elems[n]->id()] += total_energy_deposit/elems.size();
+          deposit.add(elems[n]->id(), energy_deposit[0]/elems.size(), total_energy_deposit/elems.size());
         }
         break;
       }
@@ -1081,7 +1308,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
 
 
     if(current_ray->is_dead())
-    { _pass_power += current_ray->power(); delete current_ray; continue; }
+    { deposit.pass += current_ray->power(); delete current_ray; continue; }
 
     // safe guard: when the number of rays in stack exceed 1000, we may fall into endless loop
     // force to exit
@@ -1091,7 +1318,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
       {
         LightThread * current_ray = ray_stack.top();
         ray_stack.pop();
-        _pass_power += current_ray->power();
+        deposit.pass += current_ray->power();
         delete current_ray;
       }
       return;
@@ -1110,19 +1337,19 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
         if(next_elem && next_elem->subdomain_id() == elem->subdomain_id())
         {
           current_ray->hit_elem = next_elem;
-          next_elem->ray_hit(current_ray->start_point(), current_ray->dir(), current_ray->result, _dim);
+          this->ray_walk(current_ray->start_point(), current_ray->dir(), next_elem, next_elem->which_neighbor_am_i(elem), current_ray->result);
           ray_stack.push(current_ray);
         }
         else //we are on material interface
         {
           // if reflect surface
           if(is_surface(elem, side) && is_full_reflect_surface(elem, side))
-          {  _escape_power += current_ray->power(); delete current_ray; continue; }
+          {  deposit.escape += current_ray->power(); delete current_ray; continue; }
 
           Point p = end_point.p;
           Point norm = - elem->outside_unit_normal(side);
-          double n1 = get_refractive_index_re(elem);
-          double n2 = get_refractive_index_re(elem->neighbor(side));
+          double n1 = get_refractive_index_re(elem, deposit.wave);
+          double n2 = get_refractive_index_re(elem->neighbor(side), deposit.wave);
           //generate reflect/refract rays
           std::pair<LightThread *, LightThread *> ray_pair = current_ray->interface_light_gen_linear_polarized(p, norm, n1, n2);
 
@@ -1132,7 +1359,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
           {
             refract_ray->hit_elem = next_elem;
             if(next_elem)
-              next_elem->ray_hit(refract_ray->start_point(), refract_ray->dir(), refract_ray->result, _dim);
+              this->ray_walk(refract_ray->start_point(), refract_ray->dir(), next_elem, next_elem->which_neighbor_am_i(elem), refract_ray->result);
             else
               refract_ray->start_point() = refract_ray->start_point() + 1e-8*refract_ray->dir();
             ray_stack.push(refract_ray);
@@ -1143,7 +1370,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
           if(reflect_ray)
           {
             reflect_ray->hit_elem = elem;
-            elem->ray_hit(reflect_ray->start_point(), reflect_ray->dir(), reflect_ray->result, _dim);
+            this->ray_walk(reflect_ray->start_point(), reflect_ray->dir(), elem, side, reflect_ray->result);
             assert(reflect_ray->result.state!=Missed);
             ray_stack.push(reflect_ray);
           }
@@ -1194,14 +1421,14 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
 
             // if reflect surface
             if(is_surface(boundary_elem, side) && is_full_reflect_surface(boundary_elem, side))
-            { _escape_power += current_ray->power();  continue; }
+            { deposit.escape += current_ray->power();  continue; }
 
             Point norm = boundary_elem->outside_unit_normal(side);
             //the surface norm should has a angle >90 degree to ray dir
-            if(norm.dot(current_ray->dir()) > -1e-10) { _escape_power += current_ray->power();  continue; }
+            if(norm.dot(current_ray->dir()) > -1e-10) { deposit.escape += current_ray->power();  continue; }
 
-            double n1 = get_refractive_index_re(boundary_elem->neighbor(side));
-            double n2 = get_refractive_index_re(boundary_elem);
+            double n1 = get_refractive_index_re(boundary_elem->neighbor(side), deposit.wave);
+            double n2 = get_refractive_index_re(boundary_elem, deposit.wave);
             //generate reflect/refract rays
             std::pair<LightThread *, LightThread *> ray_pair = current_ray->interface_light_gen_linear_polarized(p, norm, n1, n2);
 
@@ -1214,7 +1441,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
                 ray_stack.push(refract_ray);
               else
               {
-                _escape_power += refract_ray->power();
+                deposit.escape += refract_ray->power();
                 delete refract_ray;
               }
             }
@@ -1228,7 +1455,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
                 ray_stack.push(reflect_ray);
               else
               {
-                _escape_power += reflect_ray->power();
+                deposit.escape += reflect_ray->power();
                 delete reflect_ray;
               }
             }
@@ -1269,7 +1496,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
             effective_faces++;
           }
           if(effective_faces ==0)
-          { _escape_power += current_ray->power(); delete current_ray; continue; }
+          { deposit.escape += current_ray->power(); delete current_ray; continue; }
 
           current_ray->power() = current_ray->power()/effective_faces;
 
@@ -1280,14 +1507,14 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
 
             // if reflect surface
             if(is_surface(boundary_elem, side) && is_full_reflect_surface(boundary_elem, side))
-            { _escape_power += current_ray->power(); continue; }
+            { deposit.escape += current_ray->power(); continue; }
 
             Point norm = boundary_elem->outside_unit_normal(side);
             //the surface norm should has a angle >90 degree to ray dir
-            if(norm.dot(current_ray->dir()) > -1e-10) { _escape_power += current_ray->power(); continue; }
+            if(norm.dot(current_ray->dir()) > -1e-10) { deposit.escape += current_ray->power(); continue; }
 
-            double n1 = get_refractive_index_re(boundary_elem->neighbor(side));
-            double n2 = get_refractive_index_re(boundary_elem);
+            double n1 = get_refractive_index_re(boundary_elem->neighbor(side), deposit.wave);
+            double n2 = get_refractive_index_re(boundary_elem, deposit.wave);
             //generate reflect/refract rays
             std::pair<LightThread *, LightThread *> ray_pair = current_ray->interface_light_gen_linear_polarized(p, norm, n1, n2);
 
@@ -1300,7 +1527,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
                 ray_stack.push(refract_ray);
               else
               {
-                _escape_power += refract_ray->power();
+                deposit.escape += refract_ray->power();
                 delete refract_ray;
               }
             }
@@ -1314,7 +1541,7 @@ void RayTraceSolver::ray_tracing(LightThread *ray)
                 ray_stack.push(reflect_ray);
               else
               {
-                _escape_power += reflect_ray->power();
+                deposit.escape += reflect_ray->power();
                 delete reflect_ray;
               }
             }
@@ -0,0 +1,252 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#include <stack>
+
+#include "elem_bvh.h"
+#include "ray_tracing/light_thread.h"
+#include "ray_tracing/light_packet.h"
+#include "ray_tracing/ray_tracing.h"
+#include "ray_tracing/anti_reflection_coating.h"
+
+
+
+void RayTraceSolver::dissolve_packet(LightPacket *packet, EnergyDeposit &deposit)
+{
+  for(unsigned int i=0; i<packet->n_waves(); ++i)
+  {
+    deposit.wave = packet->wave(i);
+    ray_tracing(packet->light(i), deposit);
+  }
+  delete packet;
+}
+
+
+
+void RayTraceSolver::packet_tracing(LightPacket *packet, EnergyDeposit &deposit)
+{
+  // use stack to save all the packets (origin and secondary)
+  std::stack<LightPacket *> packet_stack;
+  packet_stack.push(packet);
+
+  // buffers of each wavelength in packet
+  std::vector<double> a_band, a_fc, band_loss, total_loss, n1, n2;
+  std::vector<LightPacket *> reflect_packets, refract_packets;
+
+  while(!packet_stack.empty())
+  {
+    LightPacket * current = packet_stack.top();
+    packet_stack.pop();
+
+    const unsigned int n_waves = current->n_waves();
+    n1.resize(n_waves);
+    n2.resize(n_waves);
+    reflect_packets.clear();
+    refract_packets.clear();
+
+    // the packet doesn't hit any elem yet?
+    if(current->hit_elem==NULL)
+    {
+      // find the first element this packet hit, and get the intersection result
+      const Elem * elem = surface_elem_tree->hit(current->start_point(), current->dir(), current->result);
+
+      // not hit any elem
+      if(elem==NULL)
+      {
+        deposit.pass += current->total_power(); delete current; continue;
+      }
+
+      // the packet hits the mesh on edge or vertex, trace the lights one by one
+      Hit_Point hit_point = current->result.hit_points[0];
+      if( (hit_point.point_location != on_face && hit_point.point_location != on_side) || !elem->on_boundary(hit_point.mark) )
+      {
+        current->result.hit_points.clear();
+        dissolve_packet(current, deposit);
+        continue;
+      }
+
+      const unsigned int side = hit_point.mark;
+      const Point & p = hit_point.p;
+      Point norm = elem->outside_unit_normal(side);
+      //the surface norm should has a angle >90 degree to ray dir
+      if(norm.dot(current->dir()) > -1e-10)
+      { deposit.pass += current->total_power(); delete current; continue; }
+
+      // if reflect surface
+      if(is_full_reflect_surface(elem, side))
+      {
+        reflect_packets.push_back(current->reflection(p, norm));
+      }
+      else
+      {
+        for(unsigned int i=0; i<n_waves; ++i)
+        {
+          n1[i] = get_refractive_index_re(elem->neighbor(side), current->wave(i));
+          n2[i] = get_refractive_index_re(elem, current->wave(i));
+        }
+
+        // if we have a anti reflection coating
+        const ARCoatings * arc = is_anti_reflection_coating_surface(elem, side);
+        bool inv = (arc && arc->inner_region != elem->subdomain_id());
+
+        //generate reflect/refract packets
+        current->interface_light_gen_linear_polarized(p, norm, n1, n2, arc, inv, _batch_tolerance, reflect_packets, refract_packets);
+      }
+
+      // for refract packets, enter the elem
+      for(unsigned int n=0; n<refract_packets.size(); ++n)
+      {
+        LightPacket * refract = refract_packets[n];
+        refract->hit_elem = elem;
+        this->ray_walk(refract->start_point(), refract->dir(), elem, side, refract->result);
+        if(refract->result.state != Missed)
+          packet_stack.push(refract);
+        else
+        {
+          deposit.escape += refract->total_power();
+          delete refract;
+        }
+      }
+
+      // for reflect packets, they may hit the mesh again
+      for(unsigned int n=0; n<reflect_packets.size(); ++n)
+      {
+        LightPacket * reflect = reflect_packets[n];
+        // shift the reflect packet to prevent it hit this elem again
+        reflect->start_point() = reflect->start_point() + 1e-6*reflect->dir();
+        const Elem *surface_elem = surface_elem_tree->hit(reflect->start_point(), reflect->dir());
+        if(surface_elem && surface_elem!=elem)
+          packet_stack.push(reflect);
+        else
+        {
+          deposit.escape += reflect->total_power();
+          delete reflect;
+        }
+      }
+
+      delete current;
+      continue;
+    }
+
+
+    const Elem * elem = current->hit_elem;
+
+    // the packet goes through edge or vertex, trace the lights one by one
+    if( current->result.state != Intersect_Body || current->result.hit_points.size() != 2 ||
+        (current->result.hit_points[1].point_location != on_face && current->result.hit_points[1].point_location != on_side) )
+    {
+      dissolve_packet(current, deposit);
+      continue;
+    }
+
+    // calculate energy deposit of each wavelength
+    Hit_Point end_point = current->result.hit_points[1];
+
+    a_band.resize(n_waves);
+    a_fc.resize(n_waves);
+    for(unsigned int i=0; i<n_waves; ++i)
+    {
+      const unsigned int w = current->wave(i);
+      a_band[i] = 4*3.14159265358979*this->get_refractive_index_im(elem, w)/current->wavelength(i);
+      a_fc[i]   = _elem_free_carrier_absorption[elem->id()*_n_waves+w];
+    }
+
+    current->advance_to(end_point.p, a_band, a_fc, band_loss, total_loss);
+    for(unsigned int i=0; i<n_waves; ++i)
+    {
+      deposit.add_wave(elem->id(), current->wave(i), band_loss[i], total_loss[i]);
+      deposit.absorb += total_loss[i];
+    }
+
+    deposit.pass += current->remove_dead();
+    if(current->is_dead())
+    { delete current; continue; }
+
+    // safe guard: when the number of packets in stack exceed 1000, we may fall into endless loop
+    // force to exit
+    if(packet_stack.size()>1000)
+    {
+      deposit.pass += current->total_power();
+      delete current;
+      while(!packet_stack.empty())
+      {
+        LightPacket * p = packet_stack.top();
+        packet_stack.pop();
+        deposit.pass += p->total_power();
+        delete p;
+      }
+      return;
+    }
+
+    // find next packet elem intersection
+    current->result.hit_points.clear();
+
+    const unsigned int side = end_point.mark;
+    const Elem * next_elem = elem->neighbor(side);
+    if(next_elem && next_elem->subdomain_id() == elem->subdomain_id())
+    {
+      current->hit_elem = next_elem;
+      this->ray_walk(current->start_point(), current->dir(), next_elem, next_elem->which_neighbor_am_i(elem), current->result);
+      packet_stack.push(current);
+      continue;
+    }
+
+    //we are on material interface
+
+    // if reflect surface
+    if(is_surface(elem, side) && is_full_reflect_surface(elem, side))
+    {  deposit.escape += current->total_power(); delete current; continue; }
+
+    Point norm = - elem->outside_unit_normal(side);
+    for(unsigned int i=0; i<n_waves; ++i)
+    {
+      n1[i] = get_refractive_index_re(elem, current->wave(i));
+      n2[i] = get_refractive_index_re(next_elem, current->wave(i));
+    }
+
+    //generate reflect/refract packets
+    current->interface_light_gen_linear_polarized(end_point.p, norm, n1, n2, 0, false, _batch_tolerance, reflect_packets, refract_packets);
+
+    // for refract packets
+    for(unsigned int n=0; n<refract_packets.size(); ++n)
+    {
+      LightPacket * refract = refract_packets[n];
+      refract->hit_elem = next_elem;
+      if(next_elem)
+        this->ray_walk(refract->start_point(), refract->dir(), next_elem, next_elem->which_neighbor_am_i(elem), refract->result);
+      else
+        refract->start_point() = refract->start_point() + 1e-8*refract->dir();
+      packet_stack.push(refract);
+    }
+
+    // for reflect packets
+    for(unsigned int n=0; n<reflect_packets.size(); ++n)
+    {
+      LightPacket * reflect = reflect_packets[n];
+      reflect->hit_elem = elem;
+      this->ray_walk(reflect->start_point(), reflect->dir(), elem, side, reflect->result);
+      packet_stack.push(reflect);
+    }
+
+    delete current;
+  }
+}
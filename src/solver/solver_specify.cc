@@ -90,6 +90,48 @@ namespace SolverSpecify
    */
   int     NSLagJacobian;
 
+  /**
+   * freeze the nonzero pattern of Jacobian matrix after the first assembly
+   */
+  bool    JacobianFrozenPattern;
+
+  /**
+   * store Jacobian matrix in block (BAIJ) format, node dofs are padded to the largest one
+   */
+  bool    JacobianBlock;
+
+  /**
+   * reuse the Jacobian matrix (and its LU factorization) between Newton steps
+   * and nonlinear solves, until the residual contraction degrades
+   */
+  bool    JacobianReuse;
+
+  /**
+   * the Jacobian is rebuilt when |F_k|/|F_{k-1}| exceeds this ratio
+   */
+  double  JacobianReuseContraction;
+
+  /**
+   * max Newton steps a Jacobian can be reused
+   */
+  int     JacobianReuseMax;
+
+  /**
+   * the number of threads used for region assembly
+   */
+  int     Threads;
+
+  /**
+   * evaluate function and jacobian in one pass at each Newton step
+   */
+  bool    FusedAssembly;
+
+  /**
+   * mixed-mode solver eliminates device dofs by Schur complement,
+   * only the electrode coupled block is solved together with spice circuit
+   */
+  bool    MixSchur;
+
   /**
    * linear solver scheme: LU, BCGS, GMRES ...
    */
@@ -369,6 +411,11 @@ namespace SolverSpecify
    */
   bool      Predict;
 
+  /**
+   * IV trace by pseudo-arc-length continuation instead of adaptive load line
+   */
+  bool      TraceArcLength;
+
   /**
    * relative tol of TS truncate error, used in AutoStep
    */
@@ -425,6 +472,21 @@ namespace SolverSpecify
    */
   int       T_Cycles;
 
+  /**
+   * binary checkpoint file of transient solver state, empty for no checkpoint
+   */
+  std::string Checkpoint;
+
+  /**
+   * write checkpoint every CheckpointSteps accepted time steps
+   */
+  int       CheckpointSteps;
+
+  /**
+   * resume transient simulation from this checkpoint file, empty for a new simulation
+   */
+  std::string Restart;
+
 
   //------------------------------------------------------
   // parameters for DC and TRACE simulation
@@ -460,6 +522,22 @@ namespace SolverSpecify
    */
   double    VStop;
 
+  /**
+   * electrode(s) held at each bias of VFamily in turn, one voltage DC sweep for each bias.
+   * empty for a single DC sweep
+   */
+  std::vector<std::string>    Electrode_VFamily;
+
+  /**
+   * bias values of family electrode(s)
+   */
+  std::vector<double>    VFamily;
+
+  /**
+   * max number of family branches swept concurrently by worker processes, 0 for all the branches
+   */
+  unsigned int    VFamilyWorkers;
+
   /**
    * electrode the current DC sweep will be performanced
    */
@@ -566,6 +644,31 @@ namespace SolverSpecify
    */
   double    Freq;
 
+  /**
+   * assemble the frequency independent part of AC matrix only once for the sweep
+   */
+  bool      ACAssembleOnce;
+
+  /**
+   * AC sweep by Krylov model order reduction
+   */
+  bool      ACMOR;
+
+  /**
+   * relative residual tolerance of the reduced order model
+   */
+  double    ACMORTolerance;
+
+  /**
+   * max dimension of the projection basis
+   */
+  unsigned int ACMORMaxBasis;
+
+  /**
+   * moments matched at each expansion frequency
+   */
+  unsigned int ACMORMoments;
+
 
   //------------------------------------------------------
   // parameters for pseudo time stepping method
@@ -714,6 +817,14 @@ namespace SolverSpecify
     NSLagPCLU         = 1;
     NSLagJacobian     = 1;
 #endif
+    JacobianFrozenPattern = false;
+    JacobianBlock     = false;
+    JacobianReuse     = false;
+    JacobianReuseContraction = 0.3;
+    JacobianReuseMax  = 10;
+    Threads           = 1;
+    FusedAssembly     = false;
+    MixSchur          = false;
 
     out_append        = false;
 
@@ -765,9 +876,13 @@ namespace SolverSpecify
     UIC                       = false;
     tran_op                   = true;
     tran_histroy              = false;
+    Checkpoint                = "";
+    CheckpointSteps           = 10;
+    Restart                   = "";
     AutoStep                  = true;
     RejectStep                = true;
     Predict                   = true;
+    TraceArcLength            = false;
     TS_rtol                   = 1e-3;
     TS_atol                   = 1e-7;
     clock                     = 0.0;
@@ -776,6 +891,7 @@ namespace SolverSpecify
 
     VStepMax          = 1.0;
     IStepMax          = 1.0;
+    VFamilyWorkers    = 1;
 
     Electrode_VScan_Voltage = 0.0;
     Electrode_IScan_Current = 0.0;
@@ -789,6 +905,11 @@ namespace SolverSpecify
     Gmin              = 1e-12;
 
     VAC               = 0.0;
+    ACAssembleOnce    = true;
+    ACMOR             = false;
+    ACMORTolerance    = 1e-4;
+    ACMORMaxBasis     = 60;
+    ACMORMoments      = 2;
 
     OpToSteady        = true;
 
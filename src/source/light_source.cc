@@ -495,8 +495,8 @@ void Light_Source_Xray::update_source()
     const SemiconductorSimulationRegion * semi_region = dynamic_cast<const SemiconductorSimulationRegion *>(region);
 
     Material::MaterialSemiconductor * m = semi_region->material();
-    double density = m->basic->Density(region->T_external());
-    double q = m->band->ParticleQuantumEffect(region->T_external());
+    double density = m->basic->Density(PMI_Context(), region->T_external());
+    double q = m->band->ParticleQuantumEffect(PMI_Context(), region->T_external());
 
     SimulationRegion::const_processor_node_iterator it = region->on_processor_nodes_begin();
     SimulationRegion::const_processor_node_iterator it_end = region->on_processor_nodes_end();
@@ -102,7 +102,7 @@ double Particle_Source::quan_eff(const SimulationRegion * region) const
     case SemiconductorRegion:
     {
       const SemiconductorSimulationRegion * semi_region = dynamic_cast<const SemiconductorSimulationRegion *>(region);
-      return semi_region->material()->band->ParticleQuantumEffect(_system.T_external());
+      return semi_region->material()->band->ParticleQuantumEffect(PMI_Context(), _system.T_external());
     }
     case InsulatorRegion:
     {
@@ -0,0 +1,217 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#include <cstdio>
+
+#include "checkpoint_file.h"
+
+#ifdef WINDOWS
+  #include <io.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+
+CheckpointWriter::CheckpointWriter()
+  : _fp(0), _failed(false)
+{}
+
+
+CheckpointWriter::~CheckpointWriter()
+{
+  if( _fp )
+  {
+    fclose(_fp);
+    std::remove((_filename + ".tmp").c_str());
+  }
+}
+
+
+bool CheckpointWriter::open(const std::string & filename)
+{
+  _filename = filename;
+  _fp = fopen((_filename + ".tmp").c_str(), "wb");
+  _failed = (_fp == 0);
+  return _fp != 0;
+}
+
+
+void CheckpointWriter::write_bytes(const void * data, size_t size)
+{
+  if( !_fp ) return;
+  if( fwrite(data, 1, size, _fp) != size ) _failed = true;
+}
+
+
+bool CheckpointWriter::close()
+{
+  if( !_fp ) return false;
+
+  if( fflush(_fp) != 0 ) _failed = true;
+#ifdef WINDOWS
+  _commit(_fileno(_fp));
+#else
+  fsync(fileno(_fp));
+#endif
+  fclose(_fp);
+  _fp = 0;
+
+  std::string tmp = _filename + ".tmp";
+  if( _failed )
+  {
+    std::remove(tmp.c_str());
+    return false;
+  }
+
+#ifdef WINDOWS
+  // rename does not overwrite existing file on windows
+  std::remove(_filename.c_str());
+#endif
+  return std::rename(tmp.c_str(), _filename.c_str()) == 0;
+}
+
+
+
+
+CheckpointReader::CheckpointReader()
+  : _data(0), _size(0), _pos(0), _failed(false), _mapped(false)
+{}
+
+
+CheckpointReader::~CheckpointReader()
+{
+  this->close();
+}
+
+
+bool CheckpointReader::open(const std::string & filename)
+{
+  this->close();
+
+#ifndef WINDOWS
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if( fd < 0 ) return false;
+
+  struct stat st;
+  if( fstat(fd, &st) == 0 && st.st_size > 0 )
+  {
+    void * addr = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if( addr != MAP_FAILED )
+    {
+      _data = static_cast<const char *>(addr);
+      _size = st.st_size;
+      _mapped = true;
+    }
+  }
+  ::close(fd);
+#else
+  FILE * fp = fopen(filename.c_str(), "rb");
+  if( !fp ) return false;
+
+  fseek(fp, 0, SEEK_END);
+  long size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  if( size > 0 )
+  {
+    char * buffer = new char[size];
+    if( fread(buffer, 1, size, fp) == static_cast<size_t>(size) )
+    {
+      _data = buffer;
+      _size = size;
+    }
+    else
+      delete [] buffer;
+  }
+  fclose(fp);
+#endif
+
+  _pos = 0;
+  _failed = false;
+  return _data != 0;
+}
+
+
+void CheckpointReader::close()
+{
+  if( !_data ) return;
+
+#ifndef WINDOWS
+  if( _mapped )
+    munmap(const_cast<char *>(_data), _size);
+#endif
+  if( !_mapped )
+    delete [] _data;
+
+  _data = 0;
+  _size = 0;
+  _pos = 0;
+  _mapped = false;
+}
+
+
+bool CheckpointReader::section(const char * tag)
+{
+  char buffer[4];
+  read_bytes(buffer, 4);
+  if( !_failed && std::memcmp(buffer, tag, 4) != 0 )
+    _failed = true;
+  return !_failed;
+}
+
+
+void CheckpointReader::read_bytes(void * data, size_t size)
+{
+  if( _failed || !_data || size > _size - _pos )
+  {
+    _failed = true;
+    std::memset(data, 0, size);
+    return;
+  }
+  std::memcpy(data, _data + _pos, size);
+  _pos += size;
+}
+
+
+void CheckpointReader::skip_bytes(size_t size)
+{
+  if( _failed || !_data || size > _size - _pos )
+  {
+    _failed = true;
+    return;
+  }
+  _pos += size;
+}
+
+
+size_t CheckpointReader::read_length(size_t value_size)
+{
+  unsigned long long n = read_value<unsigned long long>();
+  if( _failed || n > (_size - _pos)/value_size )
+  {
+    _failed = true;
+    return 0;
+  }
+  return static_cast<size_t>(n);
+}
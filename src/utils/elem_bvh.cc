@@ -0,0 +1,269 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+
+#include <algorithm>
+#include <limits>
+
+#include "elem.h"
+#include "mesh_base.h"
+#include "elem_bvh.h"
+
+
+namespace
+{
+  /**
+   * compare the center of elems along given axis
+   */
+  struct CenterLess
+  {
+    CenterLess(const std::vector<Point> &centers, unsigned int axis) : _centers(centers), _axis(axis) {}
+
+    bool operator()(unsigned int a, unsigned int b) const
+    { return _centers[a](_axis) < _centers[b](_axis); }
+
+    const std::vector<Point> & _centers;
+    unsigned int _axis;
+  };
+}
+
+
+ElemBVH::ElemBVH(const MeshBase& mesh, Trees::BuildType type, unsigned int leaf_size)
+  : _dim(mesh.mesh_dimension())
+{
+  MeshBase::const_element_iterator       it  = mesh.active_elements_begin();
+  const MeshBase::const_element_iterator end = mesh.active_elements_end();
+  for (; it != end; ++it)
+  {
+    const Elem * elem = *it;
+    if( type == Trees::ELEMENTS_ON_BOUNDARY && !elem->on_boundary() ) continue;
+    if( type == Trees::ELEMENTS_ON_SURFACE && !elem->on_boundary() && !elem->on_interface() ) continue;
+    _elems.push_back(elem);
+  }
+
+  if( _elems.empty() ) return;
+
+  // bounding box and center of each elem
+  std::vector<std::pair<Point, Point> > boxes(_elems.size());
+  std::vector<Point> centers(_elems.size());
+  std::vector<unsigned int> index(_elems.size());
+  for(unsigned int n=0; n<_elems.size(); ++n)
+  {
+    const Elem * elem = _elems[n];
+    Point lower = elem->point(0);
+    Point upper = elem->point(0);
+    for(unsigned int i=1; i<elem->n_nodes(); ++i)
+    {
+      const Point & v = elem->point(i);
+      for(unsigned int k=0; k<3; ++k)
+      {
+        lower(k) = std::min(lower(k), v(k));
+        upper(k) = std::max(upper(k), v(k));
+      }
+    }
+    boxes[n]   = std::make_pair(lower, upper);
+    centers[n] = 0.5*(lower + upper);
+    index[n]   = n;
+  }
+
+  _nodes.reserve(2*_elems.size()/std::max(leaf_size, 1u) + 1);
+  build(0, _elems.size(), std::max(leaf_size, 1u), index, boxes, centers);
+
+  // store elems in the order of leaves
+  std::vector<const Elem *> elems(_elems.size());
+  for(unsigned int n=0; n<index.size(); ++n)
+    elems[n] = _elems[index[n]];
+  _elems.swap(elems);
+}
+
+
+
+void ElemBVH::build(unsigned int begin, unsigned int end, unsigned int leaf_size, std::vector<unsigned int> &index,
+                    const std::vector<std::pair<Point, Point> > &boxes, const std::vector<Point> &centers)
+{
+  const unsigned int node_id = _nodes.size();
+  _nodes.push_back(BVHNode());
+
+  // bounding box of elems and their centers
+  Point lower = boxes[index[begin]].first;
+  Point upper = boxes[index[begin]].second;
+  Point center_lower = centers[index[begin]];
+  Point center_upper = centers[index[begin]];
+  for(unsigned int n=begin+1; n<end; ++n)
+  {
+    const std::pair<Point, Point> & box = boxes[index[n]];
+    const Point & center = centers[index[n]];
+    for(unsigned int k=0; k<3; ++k)
+    {
+      lower(k) = std::min(lower(k), box.first(k));
+      upper(k) = std::max(upper(k), box.second(k));
+      center_lower(k) = std::min(center_lower(k), center(k));
+      center_upper(k) = std::max(center_upper(k), center(k));
+    }
+  }
+
+  // pad the box against round off error
+  const Point pad = (upper - lower)*1e-8 + Point(1e-10, 1e-10, 1e-10);
+  _nodes[node_id].lower = lower - pad;
+  _nodes[node_id].upper = upper + pad;
+
+  // split along the longest extent of centers
+  unsigned int axis = 0;
+  const Point extent = center_upper - center_lower;
+  for(unsigned int k=1; k<3; ++k)
+    if( extent(k) > extent(axis) ) axis = k;
+
+  // leaf
+  if( end - begin <= leaf_size || extent(axis) <= 0.0 )
+  {
+    _nodes[node_id].offset  = begin;
+    _nodes[node_id].n_elems = end - begin;
+    return;
+  }
+
+  // split at median
+  const unsigned int mid = (begin + end)/2;
+  std::nth_element(index.begin()+begin, index.begin()+mid, index.begin()+end, CenterLess(centers, axis));
+
+  build(begin, mid, leaf_size, index, boxes, centers);
+  _nodes[node_id].offset  = _nodes.size();
+  _nodes[node_id].n_elems = 0;
+  build(mid, end, leaf_size, index, boxes, centers);
+}
+
+
+
+bool ElemBVH::hit_box(const BVHNode &node, const Point & p, const Point & d, double t_max, double &t_enter)
+{
+  double t0 = -std::numeric_limits<double>::max();
+  double t1 =  std::numeric_limits<double>::max();
+  for(unsigned int k=0; k<3; ++k)
+  {
+    // ray parallel to the slab
+    if( std::abs(d(k)) < 1e-30 )
+    {
+      if( p(k) < node.lower(k) || p(k) > node.upper(k) ) return false;
+      continue;
+    }
+
+    const double inv = 1.0/d(k);
+    double ta = (node.lower(k) - p(k))*inv;
+    double tb = (node.upper(k) - p(k))*inv;
+    if( ta > tb ) std::swap(ta, tb);
+    t0 = std::max(t0, ta);
+    t1 = std::min(t1, tb);
+    if( t0 > t1 ) return false;
+  }
+
+  // the box is behind the ray or farther than the nearest hit
+  if( t1 < -1e-10 || t0 > t_max ) return false;
+
+  t_enter = t0;
+  return true;
+}
+
+
+
+const Elem * ElemBVH::hit(const Point & p, const Point & d) const
+{
+  IntersectionResult result;
+  return this->hit(p, d, result);
+}
+
+
+
+const Elem * ElemBVH::hit(const Point & p, const Point & d, IntersectionResult &result) const
+{
+  const Elem * hit_elem = NULL;
+  double t_hit = std::numeric_limits<double>::max();
+
+  double t_enter;
+  if( _nodes.empty() || !hit_box(_nodes[0], p, d, t_hit, t_enter) ) return NULL;
+
+  // stack of (node, entry parameter), the depth of the hierarchy is bounded by log2 of elem number
+  std::pair<unsigned int, double> stack[128];
+  unsigned int top = 0;
+  stack[top++] = std::make_pair(0u, t_enter);
+
+  while( top )
+  {
+    const std::pair<unsigned int, double> item = stack[--top];
+    if( item.second > t_hit ) continue;
+
+    const BVHNode & node = _nodes[item.first];
+
+    // test all the elems in leaf
+    if( node.n_elems )
+    {
+      for(unsigned int n=node.offset; n<node.offset+node.n_elems; ++n)
+      {
+        IntersectionResult ret;
+        _elems[n]->ray_hit(p, d, ret, _dim);
+        if( ret.state == Missed || ret.hit_points.empty() ) continue;
+        if( ret.hit_points[0].t < -1e-10 ) continue; //when t<0, it is not ray hit..
+        if( ret.hit_points[0].t < t_hit )
+        {
+          t_hit    = ret.hit_points[0].t;
+          hit_elem = _elems[n];
+          result   = ret;
+        }
+      }
+      continue;
+    }
+
+    // push the far child first, the near child is visited first
+    const unsigned int left  = item.first + 1;
+    const unsigned int right = node.offset;
+    double t_left, t_right;
+    const bool hit_left  = hit_box(_nodes[left],  p, d, t_hit, t_left);
+    const bool hit_right = hit_box(_nodes[right], p, d, t_hit, t_right);
+
+    if( hit_left && hit_right )
+    {
+      if( t_left <= t_right )
+      {
+        stack[top++] = std::make_pair(right, t_right);
+        stack[top++] = std::make_pair(left,  t_left);
+      }
+      else
+      {
+        stack[top++] = std::make_pair(left,  t_left);
+        stack[top++] = std::make_pair(right, t_right);
+      }
+    }
+    else if( hit_left )
+      stack[top++] = std::make_pair(left,  t_left);
+    else if( hit_right )
+      stack[top++] = std::make_pair(right, t_right);
+  }
+
+  return hit_elem;
+}
+
+
+
+bool ElemBVH::hit_boundbox(const Point & p, const Point & d) const
+{
+  double t_enter;
+  return !_nodes.empty() && hit_box(_nodes[0], p, d, std::numeric_limits<double>::max(), t_enter);
+}
+
@@ -0,0 +1,160 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#include "record_stream.h"
+
+#ifdef WINDOWS
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
+
+
+RecordStream::RecordStream()
+  : _fp(0), _offset(0), _patch_offset(-1), _buffer_size(65536), _sync_interval(10.0), _last_sync(0)
+{}
+
+
+RecordStream::~RecordStream()
+{
+  this->close();
+}
+
+
+bool RecordStream::open(const std::string & filename, size_t buffer_size, double sync_interval)
+{
+  this->close();
+
+  _fp = fopen(filename.c_str(), "wb");
+  _buffer.clear();
+  _buffer.reserve(buffer_size);
+  _offset = 0;
+  _patch_offset = -1;
+  _patch.clear();
+  _buffer_size = buffer_size;
+  _sync_interval = sync_interval;
+  time(&_last_sync);
+
+  return _fp != 0;
+}
+
+
+bool RecordStream::resume(const std::string & filename, long offset, size_t buffer_size, double sync_interval)
+{
+  this->close();
+
+  _fp = fopen(filename.c_str(), "r+b");
+  if( !_fp ) return false;
+
+  fseek(_fp, 0, SEEK_END);
+  if( ftell(_fp) < offset )
+  {
+    fclose(_fp);
+    _fp = 0;
+    return false;
+  }
+
+#ifdef WINDOWS
+  _chsize(_fileno(_fp), offset);
+#else
+  if( ftruncate(fileno(_fp), offset) != 0 )
+  {
+    fclose(_fp);
+    _fp = 0;
+    return false;
+  }
+#endif
+  fseek(_fp, 0, SEEK_END);
+
+  _buffer.clear();
+  _buffer.reserve(buffer_size);
+  _offset = offset;
+  _patch_offset = -1;
+  _patch.clear();
+  _buffer_size = buffer_size;
+  _sync_interval = sync_interval;
+  time(&_last_sync);
+
+  return true;
+}
+
+
+void RecordStream::patch(long offset, const std::string & str)
+{
+  _patch_offset = offset;
+  _patch = str;
+}
+
+
+void RecordStream::commit()
+{
+  if( !_fp ) return;
+
+  if( difftime(time(0), _last_sync) >= _sync_interval )
+    this->flush(true);
+  else if( _buffer.size() >= _buffer_size )
+    this->flush(false);
+}
+
+
+void RecordStream::flush(bool sync)
+{
+  if( !_fp ) return;
+
+  if( !_buffer.empty() )
+  {
+    fwrite(_buffer.data(), 1, _buffer.size(), _fp);
+    _offset += _buffer.size();
+    _buffer.clear();
+  }
+
+  // the patched region is written already, overwrite it in place
+  if( _patch_offset >= 0 )
+  {
+    fseek(_fp, _patch_offset, SEEK_SET);
+    fwrite(_patch.data(), 1, _patch.size(), _fp);
+    fseek(_fp, 0, SEEK_END);
+    _patch_offset = -1;
+  }
+
+  fflush(_fp);
+
+  if( sync )
+  {
+#ifdef WINDOWS
+    _commit(_fileno(_fp));
+#else
+    fsync(fileno(_fp));
+#endif
+    time(&_last_sync);
+  }
+}
+
+
+void RecordStream::close()
+{
+  if( !_fp ) return;
+
+  this->flush(true);
+  fclose(_fp);
+  _fp = 0;
+}
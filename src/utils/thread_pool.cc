@@ -0,0 +1,339 @@
+/********************************************************************************/
+/*     888888    888888888   88     888  88888   888      888    88888888       */
+/*   8       8   8           8 8     8     8      8        8    8               */
+/*  8            8           8  8    8     8      8        8    8               */
+/*  8            888888888   8   8   8     8      8        8     8888888        */
+/*  8      8888  8           8    8  8     8      8        8            8       */
+/*   8       8   8           8     8 8     8      8        8            8       */
+/*     888888    888888888  888     88   88888     88888888     88888888        */
+/*                                                                              */
+/*       A Three-Dimensional General Purpose Semiconductor Simulator.           */
+/*                                                                              */
+/*                                                                              */
+/*  Copyright (C) 2007-2008                                                     */
+/*  Cogenda Pte Ltd                                                             */
+/*                                                                              */
+/*  Please contact Cogenda Pte Ltd for license information                      */
+/*                                                                              */
+/*  Author: Gong Ding   gdiso@ustc.edu                                          */
+/*                                                                              */
+/********************************************************************************/
+
+
+#include <vector>
+#include <algorithm>
+
+#include "genius_common.h"
+#include "genius_env.h"
+#include "thread_pool.h"
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+
+namespace
+{
+  /**
+   * number of threads, include the main thread
+   */
+  unsigned int _n_threads = 1;
+
+  /**
+   * index of current thread
+   */
+  GENIUS_THREAD_LOCAL unsigned int _thread_id = 0;
+
+  /**
+   * flag of current thread is running a loop body
+   */
+  GENIUS_THREAD_LOCAL bool _in_parallel = false;
+
+  /**
+   * run the chunk of thread t
+   */
+  void _run_chunk(Genius::ThreadLoopBody * body, unsigned int n, unsigned int t, unsigned int nt)
+  {
+    unsigned int begin = static_cast<unsigned int>( (static_cast<unsigned long long>(n)*t)/nt );
+    unsigned int end   = static_cast<unsigned int>( (static_cast<unsigned long long>(n)*(t+1))/nt );
+    if( begin < end )
+      (*body)(t, begin, end);
+  }
+
+#ifdef HAVE_PTHREAD
+
+  /**
+   * persistent worker threads. the main thread works as thread 0,
+   * worker i works as thread i+1
+   */
+  struct ThreadPool
+  {
+    pthread_mutex_t           mutex;
+    pthread_cond_t            start_cond;
+    pthread_cond_t            done_cond;
+    std::vector<pthread_t>    workers;
+
+    /// increased each time a loop is dispatched
+    unsigned long             generation;
+    /// the number of workers still running current loop
+    unsigned int              pending;
+    /// ask workers to quit
+    bool                      shutdown;
+
+    /// the loop to be executed
+    Genius::ThreadLoopBody *  body;
+    unsigned int              n;
+
+    /// dynamic scheduled loop, the chunk size and the first index not taken yet
+    bool                      dynamic;
+    unsigned int              chunk;
+    unsigned int              next;
+    pthread_mutex_t           chunk_mutex;
+  };
+
+  ThreadPool * _pool = 0;
+
+  /**
+   * run the chunks of dynamic loop until all of them are taken
+   */
+  void _run_dynamic(ThreadPool * pool, Genius::ThreadLoopBody * body, unsigned int n, unsigned int chunk, unsigned int t)
+  {
+    while(true)
+    {
+      pthread_mutex_lock(&pool->chunk_mutex);
+      unsigned int begin = pool->next;
+      if( begin < n )
+        pool->next = (n - begin > chunk) ? begin + chunk : n;
+      unsigned int end = pool->next;
+      pthread_mutex_unlock(&pool->chunk_mutex);
+
+      if( begin >= n ) break;
+      (*body)(t, begin, end);
+    }
+  }
+
+  struct WorkerArg
+  {
+    ThreadPool * pool;
+    unsigned int thread;
+  };
+
+  void * _worker_main(void * arg)
+  {
+    WorkerArg * warg = static_cast<WorkerArg *>(arg);
+    ThreadPool * pool = warg->pool;
+    _thread_id = warg->thread;
+    _in_parallel = true;
+    delete warg;
+
+    pthread_mutex_lock(&pool->mutex);
+    unsigned long my_generation = 0;
+    while(true)
+    {
+      while( pool->generation == my_generation && !pool->shutdown )
+        pthread_cond_wait(&pool->start_cond, &pool->mutex);
+      if( pool->shutdown ) break;
+      my_generation = pool->generation;
+
+      Genius::ThreadLoopBody * body = pool->body;
+      unsigned int n = pool->n;
+      unsigned int nt = pool->workers.size()+1;
+      bool dynamic = pool->dynamic;
+      unsigned int chunk = pool->chunk;
+      pthread_mutex_unlock(&pool->mutex);
+
+      if( dynamic )
+        _run_dynamic(pool, body, n, chunk, _thread_id);
+      else
+        _run_chunk(body, n, _thread_id, nt);
+
+      pthread_mutex_lock(&pool->mutex);
+      if( --pool->pending == 0 )
+        pthread_cond_signal(&pool->done_cond);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return 0;
+  }
+
+  void _stop_pool()
+  {
+    if( !_pool ) return;
+
+    pthread_mutex_lock(&_pool->mutex);
+    _pool->shutdown = true;
+    pthread_cond_broadcast(&_pool->start_cond);
+    pthread_mutex_unlock(&_pool->mutex);
+
+    for(unsigned int i=0; i<_pool->workers.size(); ++i)
+      pthread_join(_pool->workers[i], NULL);
+
+    pthread_cond_destroy(&_pool->start_cond);
+    pthread_cond_destroy(&_pool->done_cond);
+    pthread_mutex_destroy(&_pool->mutex);
+    pthread_mutex_destroy(&_pool->chunk_mutex);
+    delete _pool;
+    _pool = 0;
+  }
+
+  void _start_pool(unsigned int nt)
+  {
+    _pool = new ThreadPool;
+    pthread_mutex_init(&_pool->mutex, NULL);
+    pthread_cond_init(&_pool->start_cond, NULL);
+    pthread_cond_init(&_pool->done_cond, NULL);
+    pthread_mutex_init(&_pool->chunk_mutex, NULL);
+    _pool->generation = 0;
+    _pool->pending = 0;
+    _pool->shutdown = false;
+    _pool->body = 0;
+    _pool->n = 0;
+    _pool->dynamic = false;
+    _pool->chunk = 1;
+    _pool->next = 0;
+
+    // hold the lock so workers see a complete worker list
+    pthread_mutex_lock(&_pool->mutex);
+    for(unsigned int t=1; t<nt; ++t)
+    {
+      WorkerArg * arg = new WorkerArg;
+      arg->pool = _pool;
+      arg->thread = t;
+      pthread_t th;
+      if( pthread_create(&th, NULL, _worker_main, arg) != 0 )
+      {
+        delete arg;
+        break;
+      }
+      _pool->workers.push_back(th);
+    }
+    pthread_mutex_unlock(&_pool->mutex);
+
+    // we may get less threads than required
+    _n_threads = _pool->workers.size()+1;
+  }
+
+#endif
+}
+
+
+
+namespace Genius
+{
+
+  unsigned int n_threads()
+  { return _n_threads; }
+
+
+  unsigned int thread_id()
+  { return _thread_id; }
+
+
+  bool in_parallel_region()
+  { return _in_parallel; }
+
+
+  void set_n_threads(unsigned int n)
+  {
+    genius_assert(!_in_parallel);
+
+    if( n < 1 ) n = 1;
+    if( n > GENIUS_MAX_THREADS ) n = GENIUS_MAX_THREADS;
+
+#ifdef HAVE_PTHREAD
+    if( _pool && _pool->workers.size()+1 == n ) return;
+    _stop_pool();
+    _n_threads = 1;
+    if( n > 1 ) _start_pool(n);
+#endif
+  }
+
+
+  void parallel_for(unsigned int n, ThreadLoopBody & body, unsigned int grain)
+  {
+    if( n == 0 ) return;
+
+#ifdef HAVE_PTHREAD
+    if( _pool && !_in_parallel && n >= grain*_n_threads )
+    {
+      pthread_mutex_lock(&_pool->mutex);
+      _pool->body = &body;
+      _pool->n = n;
+      _pool->dynamic = false;
+      _pool->pending = _pool->workers.size();
+      ++_pool->generation;
+      pthread_cond_broadcast(&_pool->start_cond);
+      pthread_mutex_unlock(&_pool->mutex);
+
+      _in_parallel = true;
+      _run_chunk(&body, n, 0, _n_threads);
+      _in_parallel = false;
+
+      pthread_mutex_lock(&_pool->mutex);
+      while( _pool->pending > 0 )
+        pthread_cond_wait(&_pool->done_cond, &_pool->mutex);
+      pthread_mutex_unlock(&_pool->mutex);
+      return;
+    }
+#endif
+
+    body(_thread_id, 0, n);
+  }
+
+
+  void parallel_for_dynamic(unsigned int n, ThreadLoopBody & body, unsigned int chunk)
+  {
+    if( n == 0 ) return;
+    if( chunk < 1 ) chunk = 1;
+
+#ifdef HAVE_PTHREAD
+    if( _pool && !_in_parallel && n > chunk )
+    {
+      pthread_mutex_lock(&_pool->mutex);
+      _pool->body = &body;
+      _pool->n = n;
+      _pool->dynamic = true;
+      _pool->chunk = chunk;
+      _pool->next = 0;
+      _pool->pending = _pool->workers.size();
+      ++_pool->generation;
+      pthread_cond_broadcast(&_pool->start_cond);
+      pthread_mutex_unlock(&_pool->mutex);
+
+      _in_parallel = true;
+      _run_dynamic(_pool, &body, n, chunk, 0);
+      _in_parallel = false;
+
+      pthread_mutex_lock(&_pool->mutex);
+      while( _pool->pending > 0 )
+        pthread_cond_wait(&_pool->done_cond, &_pool->mutex);
+      pthread_mutex_unlock(&_pool->mutex);
+      return;
+    }
+#endif
+
+    // serial, still call the body chunk by chunk
+    for(unsigned int begin=0; begin<n; begin+=chunk)
+      body(_thread_id, begin, std::min(begin+chunk, n));
+  }
+
+
+  void clean_threads()
+  {
+#ifdef HAVE_PTHREAD
+    _stop_pool();
+#endif
+    _n_threads = 1;
+  }
+
+
+  void reset_threads_after_fork()
+  {
+    genius_assert(!_in_parallel);
+#ifdef HAVE_PTHREAD
+    // the workers do not exist in this process, the pool can not be stopped. leave it
+    _pool = 0;
+#endif
+    _n_threads = 1;
+  }
+
+}